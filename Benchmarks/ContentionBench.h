@@ -0,0 +1,278 @@
+// ======================================================
+// ContentionBench.h — multi-thread sweeps, latency, fairness
+// ======================================================
+//
+// Mutex.cpp, LockGuard.cpp, BinarySemaphore.cpp, ... each print
+//
+//     Thread 1 incremented counter
+//     Final counter: 200000
+//
+// which shows the primitive WORKS, not what it COSTS under load.
+// MicroBench.h times one thread; a lock's cost is about what all
+// the others are doing at the same time.
+//
+// runContention(name, config, op) starts config.threads threads,
+// releases them together and lets each call
+//
+//     op(threadIndex, isRead)
+//
+// in a loop for config.durationMs. isRead is true for a
+// readRatio share of the calls (per-thread random stream, fixed
+// seed). An op that waits for OTHER threads (a turn, a queue
+// item) takes a third argument, `const std::atomic<bool>&
+// stopping`, and must return once it is set — the others may
+// already have stopped. Every call is timed; the result has:
+//
+//   - throughput: completed calls per second, all threads
+//   - latency p50 / p99 / p999 of one call (a log-linear
+//     histogram: 8 sub-buckets per power of two, ≤ 12.5% error;
+//     includes one steady_clock read, ~20 ns) and the exact max
+//   - fairness: Jain's index over per-thread call counts,
+//     (Σx)² / (n·Σx²) — 1.0 when every thread got the same share,
+//     1/n when one thread got everything
+//
+// config.counters = true: every thread also opens PerfCounters.h's
+// default events around its loop; the per-thread samples are
+// summed into result.counters and perOp(event) divides by ops
+// (cycles, cache misses, context switches per call — -1 where
+// the machine does not expose the event).
+//
+// spinWork(units) is the critical-section body: `units` dependent
+// multiply-adds the optimizer cannot remove (~1 ns each).
+//
+// writeJson(out, suite, results) emits one object per result with a
+// fixed schema (see the function), for diffing release to
+// release.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PerfCounters.h"
+
+struct ContentionConfig {
+    int threads = 1;
+    std::uint32_t csWork = 0;             // critical-section length, spinWork units
+    double readRatio = 0;                 // share of calls with isRead == true
+    double durationMs = 100;
+    bool counters = false;                // PerfCounters per thread, summed
+};
+
+struct ContentionResult {
+    std::string name;
+    ContentionConfig config;
+    std::uint64_t ops = 0;
+    double seconds = 0;
+    double opsPerSec = 0;
+    double p50Ns = 0, p99Ns = 0, p999Ns = 0;
+    double maxNs = 0;
+    double jain = 0;
+    std::vector<std::uint64_t> perThreadOps;
+    PerfCounters::Sample counters;                 // all threads; empty unless config.counters
+
+    double perOp(const std::string& event) const {
+        double v = counters.value(event);
+        return v < 0 || ops == 0 ? -1 : v / double(ops);
+    }
+};
+
+// `units` dependent multiply-adds; returns a value to keep
+inline std::uint64_t spinWork(std::uint32_t units) {
+    std::uint64_t x = units;
+    for (std::uint32_t i = 0; i < units; ++i) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        asm volatile("" : "+r"(x));
+    }
+    return x;
+}
+
+// Nanosecond latencies, 8 linear sub-buckets per power of two
+class LatencyHistogram {
+public:
+    static constexpr int kSub = 8;
+    static constexpr int kBuckets = 64 * kSub;
+
+    void record(std::uint64_t ns) {
+        ++counts_[index(ns)];
+        max_ = std::max(max_, ns);
+    }
+
+    void merge(const LatencyHistogram& o) {
+        for (int i = 0; i < kBuckets; ++i) counts_[i] += o.counts_[i];
+        max_ = std::max(max_, o.max_);
+    }
+
+    std::uint64_t max() const { return max_; }
+
+    // Upper edge of the bucket holding quantile q (0..1)
+    double quantile(double q) const {
+        std::uint64_t total = 0;
+        for (std::uint64_t c : counts_) total += c;
+        if (total == 0) return 0;
+        std::uint64_t rank = std::max<std::uint64_t>(1, std::uint64_t(q * double(total) + 0.5));
+        std::uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) return upperEdge(i);
+        }
+        return upperEdge(kBuckets - 1);
+    }
+
+private:
+    static int index(std::uint64_t ns) {
+        if (ns < kSub) return int(ns);
+        int log = std::bit_width(ns) - 1;                       // ns in [2^log, 2^(log+1))
+        int sub = int((ns >> (log - 3)) & (kSub - 1));
+        return (log - 2) * kSub + sub;
+    }
+    static double upperEdge(int i) {
+        if (i < kSub) return double(i);
+        int log = i / kSub + 2, sub = i % kSub;
+        return double((std::uint64_t(kSub + sub + 1) << (log - 3)) - 1);
+    }
+
+    std::uint64_t counts_[kBuckets] = {};
+    std::uint64_t max_ = 0;
+};
+
+// Jain's fairness index of per-thread counts
+inline double jainIndex(const std::vector<std::uint64_t>& xs) {
+    double sum = 0, sq = 0;
+    for (std::uint64_t x : xs) {
+        sum += double(x);
+        sq += double(x) * double(x);
+    }
+    return sq == 0 ? 1.0 : sum * sum / (double(xs.size()) * sq);
+}
+
+template <typename Op>
+ContentionResult runContention(std::string name, const ContentionConfig& cfg, Op&& op) {
+    using clock = std::chrono::steady_clock;
+    struct alignas(64) PerThread {
+        LatencyHistogram hist;
+        std::uint64_t ops = 0;
+        PerfCounters::Sample counters;
+    };
+    std::vector<PerThread> per(cfg.threads);
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false}, stop{false};
+    const std::uint64_t readCut = std::uint64_t(cfg.readRatio * 4294967296.0);
+
+    std::vector<std::thread> threads;
+    threads.reserve(cfg.threads);
+    for (int t = 0; t < cfg.threads; ++t)
+        threads.emplace_back([&, t] {
+            PerThread& me = per[t];
+            std::uint64_t rng = 0x9E3779B97F4A7C15ull * std::uint64_t(t + 1);
+            // Opened before the start line: the syscalls are not measured
+            PerfCounters pmu(cfg.counters ? PerfCounters::defaultEvents() : std::vector<PerfCounters::Event>{});
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            if (cfg.counters) pmu.start();
+            while (!stop.load(std::memory_order_relaxed)) {
+                rng ^= rng << 13;
+                rng ^= rng >> 7;
+                rng ^= rng << 17;
+                const bool isRead = (rng >> 32) < readCut;
+                auto t0 = clock::now();
+                if constexpr (std::is_invocable_v<Op&, int, bool, const std::atomic<bool>&>)
+                    op(t, isRead, std::as_const(stop));
+                else
+                    op(t, isRead);
+                auto t1 = clock::now();
+                me.hist.record(std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+                ++me.ops;
+            }
+            if (cfg.counters) me.counters = pmu.stop();
+        });
+    while (ready.load() < cfg.threads) std::this_thread::yield();
+    auto start = clock::now();
+    go.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(cfg.durationMs));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& th : threads) th.join();
+    double seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+    ContentionResult r;
+    r.name = std::move(name);
+    r.config = cfg;
+    LatencyHistogram all;
+    for (PerThread& p : per) {
+        all.merge(p.hist);
+        r.ops += p.ops;
+        r.perThreadOps.push_back(p.ops);
+        r.counters.merge(p.counters);
+    }
+    r.seconds = seconds;
+    r.opsPerSec = double(r.ops) / seconds;
+    r.p50Ns = all.quantile(0.50);
+    r.p99Ns = all.quantile(0.99);
+    r.p999Ns = all.quantile(0.999);
+    r.maxNs = double(all.max());
+    r.jain = jainIndex(r.perThreadOps);
+    return r;
+}
+
+// Names here are plain identifiers; only " and \ need escaping
+inline std::string jsonString(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+// {"schema": 1, "suite": ..., "hardware_concurrency": n, "results": [
+//   {"primitive", "threads", "cs_work", "read_ratio", "duration_ms",
+//    "ops", "throughput_ops_per_s",
+//    "latency_ns": {"p50", "p99", "p999", "max"}, "fairness_jain",
+//    "per_thread_ops": [...],
+//    "counters_per_op": {"cycles": ..., ...}   (config.counters only,
+//                                              available events only)
+//   }, ...]}
+inline void writeJson(std::ostream& out, const std::string& suite, const std::vector<ContentionResult>& results) {
+    char buf[512];
+    out << "{\"schema\": 1, \"suite\": " << jsonString(suite)
+        << ", \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ", \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const ContentionResult& r = results[i];
+        std::snprintf(buf, sizeof(buf),
+                      "%s\n  {\"primitive\": %s, \"threads\": %d, \"cs_work\": %u, \"read_ratio\": %.3f, "
+                      "\"duration_ms\": %.1f, \"ops\": %llu, \"throughput_ops_per_s\": %.1f, "
+                      "\"latency_ns\": {\"p50\": %.0f, \"p99\": %.0f, \"p999\": %.0f, \"max\": %.0f}, "
+                      "\"fairness_jain\": %.4f, "
+                      "\"per_thread_ops\": [",
+                      i ? "," : "", jsonString(r.name).c_str(), r.config.threads, r.config.csWork, r.config.readRatio,
+                      r.seconds * 1e3, static_cast<unsigned long long>(r.ops), r.opsPerSec, r.p50Ns, r.p99Ns,
+                      r.p999Ns, r.maxNs, r.jain);
+        out << buf;
+        for (std::size_t t = 0; t < r.perThreadOps.size(); ++t)
+            out << (t ? ", " : "") << r.perThreadOps[t];
+        out << "]";
+        if (r.config.counters) {
+            out << ", \"counters_per_op\": {";
+            bool first = true;
+            for (const PerfCounters::Reading& c : r.counters.readings) {
+                if (c.value < 0) continue;
+                std::snprintf(buf, sizeof(buf), "%s%s: %.4f", first ? "" : ", ", jsonString(c.name).c_str(),
+                              r.perOp(c.name));
+                out << buf;
+                first = false;
+            }
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "\n]}\n";
+}
@@ -0,0 +1,214 @@
+// ======================================================
+// LayoutReport.h — sizeof, padding holes and vptr cost per class
+// ======================================================
+//
+// Vtable.cpp explains the hidden vptr in a comment, union.cpp the
+// size of a union; nothing MEASURES a layout. LayoutReport takes a
+// class and the list of its data members and works out the rest:
+//
+//     LayoutReport report;
+//     report.add<GameObject>("GameObject", "Polymorphism/soaGameObjects.cpp",
+//                            {LAYOUT_FIELD(GameObject, x), LAYOUT_FIELD(GameObject, y), ...});
+//     report.print(std::cout);              // table + the classes worth shrinking
+//
+// Per class:
+//   - sizeof, alignof, objects per 64-byte cache line
+//   - vptr bytes: a polymorphic class's bytes before its first
+//     member (the vptr, plus a hole if the member is over-aligned)
+//   - padding HOLES between members and TAIL padding after the last
+//   - "reordered": members sorted by alignment, largest first —
+//     the smallest order the compiler would keep
+//   - "no virtual": the same, without the vptr
+// A class is flagged when either would cut sizeof by `threshold`
+// (default 25%).
+//
+// Why a member list: GCC's -fdump-lang-class prints sizes and
+// vtables but no member offsets, and C++20 has no reflection.
+// LAYOUT_FIELD takes offsetof / sizeof / alignof of each member;
+// add() checks that the members lie inside the object without
+// overlapping (unions excepted), so a list that drifts from the
+// class is caught. Inherited members are listed with the derived
+// class (offsets are from the start of the most-derived object);
+// "reordered" then treats them as one flat list — an upper bound
+// on what moving members between base and derived could save.
+//
+// offsetof on a class with virtual functions is "conditionally
+// supported": GCC and Clang give the real offset, with a warning
+// LAYOUT_FIELD switches off. Private members need the describing
+// code to be a friend.
+//
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct LayoutField {
+    const char* name;
+    std::size_t offset;
+    std::size_t size;
+    std::size_t align;
+};
+
+#if defined(__GNUC__)
+#define LAYOUT_OFFSETOF(T, m)                                                                           \
+    (__extension__({                                                                                    \
+        _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Winvalid-offsetof\"")        \
+        std::size_t layoutOffset_ = offsetof(T, m);                                                     \
+        _Pragma("GCC diagnostic pop") layoutOffset_;                                                    \
+    }))
+#else
+#define LAYOUT_OFFSETOF(T, m) offsetof(T, m)
+#endif
+
+#define LAYOUT_FIELD(T, m)                                                                              \
+    LayoutField {                                                                                       \
+        #m, LAYOUT_OFFSETOF(T, m), sizeof(std::declval<T&>().m), alignof(decltype(std::declval<T&>().m)) \
+    }
+
+class LayoutReport {
+public:
+    struct Hole {
+        std::size_t offset;
+        std::size_t bytes;
+    };
+
+    struct Entry {
+        std::string name, source;
+        std::size_t size = 0, align = 0;
+        bool polymorphic = false, isUnion = false;
+        std::vector<LayoutField> fields;    // by offset
+        std::size_t vptrBytes = 0;          // before the first member
+        std::vector<Hole> holes;            // between members
+        std::size_t tail = 0;               // after the last member
+        std::size_t reordered = 0;          // sizeof with members by alignment
+        std::size_t noVirtual = 0;          // ... and no vptr
+
+        std::size_t padding() const {
+            std::size_t p = tail;
+            for (const Hole& h : holes) p += h.bytes;
+            return p;
+        }
+        std::size_t perLine() const { return 64 / size; }
+        double saving(std::size_t smaller) const { return 1.0 - double(smaller) / double(size); }
+    };
+
+    explicit LayoutReport(double threshold = 0.25) : threshold_(threshold) {}
+
+    // Throws std::logic_error if the member list does not fit T
+    template <typename T>
+    void add(std::string name, std::string source, std::vector<LayoutField> fields) {
+        Entry e;
+        e.name = std::move(name);
+        e.source = std::move(source);
+        e.size = sizeof(T);
+        e.align = alignof(T);
+        e.polymorphic = std::is_polymorphic_v<T>;
+        e.isUnion = std::is_union_v<T>;
+        e.fields = std::move(fields);
+        std::sort(e.fields.begin(), e.fields.end(),
+                  [](const LayoutField& a, const LayoutField& b) { return a.offset < b.offset; });
+        analyse(e);
+        entries_.push_back(std::move(e));
+    }
+
+    const std::vector<Entry>& entries() const { return entries_; }
+
+    bool flagged(const Entry& e) const {
+        return e.saving(e.reordered) >= threshold_ || e.saving(e.noVirtual) >= threshold_;
+    }
+
+    void print(std::ostream& os) const {
+        os << std::left << std::setw(22) << "class" << std::right << std::setw(6) << "size" << std::setw(6) << "align"
+           << std::setw(6) << "vptr" << std::setw(9) << "padding" << std::setw(7) << "/line" << std::setw(11)
+           << "reordered" << std::setw(12) << "no virtual" << "  " << std::endl;
+        for (const Entry& e : entries_) {
+            os << std::left << std::setw(22) << e.name << std::right << std::setw(6) << e.size << std::setw(6)
+               << e.align << std::setw(6) << e.vptrBytes << std::setw(9) << e.padding() << std::setw(7)
+               << e.perLine() << std::setw(11) << cell(e, e.reordered) << std::setw(12)
+               << (e.polymorphic ? cell(e, e.noVirtual) : std::string("-")) << (flagged(e) ? "  ◀" : "")
+               << std::endl;
+        }
+        os << std::endl << "◀ = at least " << int(threshold_ * 100 + 0.5) << "% smaller:" << std::endl;
+        for (const Entry& e : entries_) {
+            if (!flagged(e)) continue;
+            os << "  " << e.name << " (" << e.source << "): " << e.size << " bytes";
+            if (e.saving(e.reordered) >= threshold_)
+                os << "; reorder → " << e.reordered << " (" << percent(e.saving(e.reordered)) << ")";
+            if (e.polymorphic && e.saving(e.noVirtual) >= threshold_)
+                os << "; without virtual → " << e.noVirtual << " (" << percent(e.saving(e.noVirtual))
+                   << ", vptr " << e.vptrBytes << " B)";
+            os << std::endl;
+            for (const Hole& h : e.holes)
+                os << "      hole of " << h.bytes << " B at offset " << h.offset << std::endl;
+            if (e.tail) os << "      tail padding " << e.tail << " B" << std::endl;
+        }
+    }
+
+private:
+    static std::size_t alignUp(std::size_t n, std::size_t a) { return (n + a - 1) / a * a; }
+
+    static std::string percent(double s) {
+        std::ostringstream o;
+        o << int(s * 100 + 0.5) << "%";
+        return o.str();
+    }
+
+    static std::string cell(const Entry& e, std::size_t smaller) {
+        if (smaller == e.size) return "=";
+        std::ostringstream o;
+        o << smaller << " " << percent(e.saving(smaller));
+        return o.str();
+    }
+
+    void analyse(Entry& e) {
+        for (const LayoutField& f : e.fields)
+            if (f.offset + f.size > e.size || f.size == 0 || f.align == 0)
+                throw std::logic_error("LayoutReport: " + e.name + "::" + f.name + " does not fit the object");
+        if (e.isUnion) {                    // members overlap by design; nothing to reorder
+            std::size_t largest = 0;
+            for (const LayoutField& f : e.fields) largest = std::max(largest, f.size);
+            e.tail = e.size - largest;
+            e.reordered = e.noVirtual = e.size;
+            return;
+        }
+        std::size_t at = 0;
+        if (e.polymorphic) {
+            e.vptrBytes = e.fields.empty() ? e.size : e.fields.front().offset;
+            at = e.vptrBytes;
+        }
+        for (const LayoutField& f : e.fields) {
+            if (f.offset < at) throw std::logic_error("LayoutReport: " + e.name + "::" + f.name + " overlaps");
+            if (f.offset > at) e.holes.push_back({at, f.offset - at});
+            at = f.offset + f.size;
+        }
+        e.tail = e.size - at;
+        e.noVirtual = packed(e.fields, 0, 1);
+        e.reordered = e.polymorphic ? packed(e.fields, sizeof(void*), alignof(void*)) : e.noVirtual;
+        e.reordered = std::min(e.reordered, e.size);
+        e.noVirtual = std::min(e.noVirtual, e.size);
+    }
+
+    // Members after `start` bytes, largest alignment first
+    static std::size_t packed(std::vector<LayoutField> fs, std::size_t start, std::size_t align) {
+        std::stable_sort(fs.begin(), fs.end(), [](const LayoutField& a, const LayoutField& b) {
+            return a.align != b.align ? a.align > b.align : a.size > b.size;
+        });
+        std::size_t at = start;
+        for (const LayoutField& f : fs) {
+            at = alignUp(at, f.align) + f.size;
+            align = std::max(align, f.align);
+        }
+        return std::max<std::size_t>(alignUp(at, align), 1);       // an empty class still takes a byte
+    }
+
+    double threshold_;
+    std::vector<Entry> entries_;
+};
@@ -0,0 +1,199 @@
+// ======================================================
+// MicroBench.h — warm-up, repetitions, median/MAD, counters
+// ======================================================
+//
+// Registervariables.cpp:
+//
+//     for (register int n = 0; n < 100000000; n++) { }   // "faster?"
+//
+// An empty loop the optimizer deletes, timed by eye. To claim
+// anything about inline, register or LTO each benchmark needs:
+//
+//   - work the optimizer cannot delete: doNotOptimize(v) makes v
+//     "used" (and forces it to exist in a register or memory),
+//     clobberMemory() makes every store before it observable
+//   - warm-up (caches, branch predictors, CPU frequency)
+//   - enough iterations per sample to dwarf timer overhead
+//     (calibrated to sampleMs)
+//   - several samples, reported as median and MAD (median
+//     absolute deviation): robust to the odd interrupted sample
+//   - event counts per iteration (PerfCounters.h: cycles, IPC,
+//     branch and cache misses) where the machine exposes them
+//
+//     MicroBench bench("Fast");
+//     bench.add("in-class inline", [](std::uint64_t n) {
+//         Fast f;
+//         for (std::uint64_t i = 0; i < n; ++i) { f.SetData(int(i)); doNotOptimize(f); }
+//     });
+//     bench.run();          // prints a table; returns the results
+//
+// A body receives the iteration count and must run its loop
+// that many times. The first benchmark added is the baseline
+// for the "x" column.
+//
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PerfCounters.h"
+
+// Compiler barriers, no instructions emitted (GCC/Clang)
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename T>
+inline void doNotOptimize(T& value) {
+    // A single alternative: GCC 12 can write a stale register back
+    // through a "+r,m" operand (seen under -fsanitize=undefined)
+    if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*))
+        asm volatile("" : "+r"(value) : : "memory");
+    else
+        asm volatile("" : "+m"(value) : : "memory");
+}
+
+inline void clobberMemory() { asm volatile("" : : : "memory"); }
+
+struct BenchOptions {
+    double warmupMs = 50;
+    double sampleMs = 20;                                   // target length of one sample
+    int samples = 15;                                       // >= 1, checked by MicroBench
+    bool counters = true;
+};
+
+struct BenchResult {
+    std::string name;
+    std::uint64_t iterations = 0;                           // per sample
+    double medianNs = 0;                                    // per iteration
+    double madNs = 0;
+    double minNs = 0;
+    PerfCounters::Sample counters;                          // totals over all samples
+    std::uint64_t countedIterations = 0;                    // divide counters by this
+
+    double perIteration(const std::string& event) const {
+        double v = counters.value(event);
+        return v < 0 || countedIterations == 0 ? -1 : v / double(countedIterations);
+    }
+};
+
+class MicroBench {
+public:
+    using Body = std::function<void(std::uint64_t)>;
+
+    explicit MicroBench(std::string suite, BenchOptions options = {})
+        : suite_(std::move(suite)), options_(options) {
+        if (options_.samples < 1) throw std::invalid_argument("MicroBench: samples must be >= 1");
+    }
+
+    MicroBench& add(std::string name, Body body) {
+        benches_.push_back({std::move(name), std::move(body)});
+        return *this;
+    }
+
+    std::vector<BenchResult> run(std::ostream& out = std::cout) {
+        std::vector<BenchResult> results;
+        results.reserve(benches_.size());
+        for (auto& [name, body] : benches_) results.push_back(runOne(name, body));
+        print(out, results);
+        return results;
+    }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    static double elapsedNs(const Body& body, std::uint64_t n) {
+        auto t0 = clock::now();
+        body(n);
+        return std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+    }
+
+    static double median(std::vector<double> v) {
+        std::sort(v.begin(), v.end());
+        std::size_t m = v.size() / 2;
+        return v.size() % 2 ? v[m] : (v[m - 1] + v[m]) / 2;
+    }
+
+    BenchResult runOne(const std::string& name, const Body& body) {
+        // Calibrate: grow n until one run takes a measurable time,
+        // then scale it to the sample length
+        std::uint64_t n = 1;
+        double ns = elapsedNs(body, n);
+        while (ns < options_.sampleMs * 1e5 && n < (std::uint64_t(1) << 40)) {   // sampleMs / 10
+            n *= 8;
+            ns = elapsedNs(body, n);
+        }
+        double perIter = ns / double(n);
+        n = std::max<std::uint64_t>(1, std::uint64_t(options_.sampleMs * 1e6 / std::max(perIter, 1e-3)));
+
+        auto warmEnd = clock::now() + std::chrono::duration<double, std::milli>(options_.warmupMs);
+        while (clock::now() < warmEnd) body(n / 8 + 1);
+
+        PerfCounters pmu(options_.counters ? PerfCounters::defaultEvents() : std::vector<PerfCounters::Event>{});
+        std::vector<double> samples;
+        samples.reserve(options_.samples);
+        pmu.start();
+        for (int s = 0; s < options_.samples; ++s) samples.push_back(elapsedNs(body, n) / double(n));
+        BenchResult r;
+        r.counters = pmu.stop();
+        r.name = name;
+        r.iterations = n;
+        r.countedIterations = n * std::uint64_t(options_.samples);
+        r.medianNs = median(samples);
+        r.minNs = *std::min_element(samples.begin(), samples.end());
+        std::vector<double> dev;
+        dev.reserve(samples.size());
+        for (double x : samples) dev.push_back(std::fabs(x - r.medianNs));
+        r.madNs = median(dev);
+        return r;
+    }
+
+    void print(std::ostream& out, const std::vector<BenchResult>& results) const {
+        bool hw = false, scaled = false;
+        for (const BenchResult& r : results) {
+            hw = hw || r.perIteration("cycles") >= 0;
+            scaled = scaled || r.counters.anyScaled();
+        }
+
+        char line[256];
+        out << "== " << suite_ << " (" << options_.samples << " samples x ~" << options_.sampleMs << " ms, median ± MAD)\n";
+        std::snprintf(line, sizeof(line), "  %-34s %10s %8s %7s", "benchmark", "ns/iter", "±MAD", "x");
+        out << line;
+        if (hw) {
+            std::snprintf(line, sizeof(line), " %9s %9s %7s %9s %10s", "cycles", "instr", "IPC", "br-miss",
+                          "cache-miss");
+            out << line;
+        }
+        out << '\n';
+        double base = results.empty() ? 1 : results.front().medianNs;
+        for (const BenchResult& r : results) {
+            std::snprintf(line, sizeof(line), "  %-34s %10.3f %8.3f %7.2f", r.name.c_str(), r.medianNs, r.madNs,
+                          base > 0 ? r.medianNs / base : 0.0);
+            out << line;
+            if (hw) {
+                double cyc = r.perIteration("cycles"), ins = r.perIteration("instructions");
+                std::snprintf(line, sizeof(line), " %9.2f %9.2f %7.2f %9.4f %10.4f", cyc, ins, cyc > 0 ? ins / cyc : -1.0,
+                              r.perIteration("branch-misses"), r.perIteration("cache-misses"));
+                out << line;
+            }
+            out << '\n';
+        }
+        if (!hw) out << "  (no hardware PMU: cycle/instruction counts unavailable here)\n";
+        if (scaled) out << "  (counters multiplexed: counts scaled by enabled / running time)\n";
+        out.flush();
+    }
+
+    std::string suite_;
+    BenchOptions options_;
+    std::vector<std::pair<std::string, Body>> benches_;
+};
@@ -0,0 +1,376 @@
+// ======================================================
+// PerfCounters.h — hardware/software event counts for a region
+// ======================================================
+//
+// soaGameObjects.cpp opened one perf_event_open counter by hand
+// (cache misses). PerfCounters opens a SET of events for the
+// calling thread and reads them around a region:
+//
+//     PerfCounters pmu;                          // default set below
+//     pmu.start();
+//     run();
+//     PerfCounters::Sample s = pmu.stop();
+//     s.value("instructions");                   // -1 if unavailable
+//
+// Default events: cycles, instructions, branch-misses,
+// cache-misses (hardware) and task-clock, page-faults,
+// context-switches (software). Each event has its own fd, so
+// whatever the machine supports is reported and the rest reads
+// as unavailable (VMs and containers often expose no hardware
+// PMU; perf_event_paranoid > 2 blocks everything).
+//
+// Multiplexing: with more hardware events than PMU registers
+// the kernel time-slices them. Every count is read with
+// TOTAL_TIME_ENABLED / TOTAL_TIME_RUNNING and scaled by
+// enabled / running, so counts stay comparable; `scaled` says
+// whether that happened and `running` which share of the region
+// the event was actually counted. Grouping::Together opens the
+// events as ONE group instead: the kernel schedules a group all
+// or nothing, so ratios (IPC, misses per instruction) come from
+// the same time slices — but a group larger than the PMU never
+// runs and reads as unavailable.
+//
+// Regions and threads:
+// - read() / since(): counts since a snapshot, without stopping —
+//   regions may nest
+// - PerfRegion: the calling thread's counts over a scope, merged
+//   into a PerfTotals under the region's name; each thread uses
+//   its own counters (PerfCounters::forThread(), opened on first
+//   use), so the totals are the sum over every thread that ran it
+// - Sample::merge: add one sample to another (per-thread
+//   aggregation by hand)
+//
+// Counts exclude the kernel and the hypervisor. Linux:
+// perf_event_open. Windows: "cycles" only, from
+// QueryThreadCycleTime (the thread's TSC-rate cycle count,
+// kernel time included); every other event is unavailable.
+// Elsewhere every event is unavailable.
+//
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+class PerfCounters {
+public:
+    struct Event {
+        std::string name;
+        std::uint32_t type;
+        std::uint64_t config;
+    };
+
+    struct Reading {
+        std::string name;
+        double value = -1;                                  // < 0: unavailable
+        bool scaled = false;                                // multiplexed, extrapolated
+        double running = 1;                                 // share of the region actually counted
+    };
+
+    struct Sample {
+        std::vector<Reading> readings;
+        std::uint64_t merged = 0;                           // samples summed into this one
+
+        double value(const std::string& name) const {
+            for (const Reading& r : readings)
+                if (r.name == name) return r.value;
+            return -1;
+        }
+
+        bool anyScaled() const {
+            for (const Reading& r : readings)
+                if (r.value >= 0 && r.scaled) return true;
+            return false;
+        }
+
+        // Counts add up; an event is unavailable only if it is in
+        // both; `running` keeps the worst share
+        void merge(const Sample& o) {
+            merged += o.merged;
+            if (readings.empty()) {
+                readings = o.readings;
+                return;
+            }
+            for (const Reading& x : o.readings) {
+                auto it = std::find_if(readings.begin(), readings.end(),
+                                       [&](const Reading& r) { return r.name == x.name; });
+                if (it == readings.end()) {
+                    readings.push_back(x);
+                    continue;
+                }
+                if (x.value < 0) continue;
+                it->value = (it->value < 0 ? 0 : it->value) + x.value;
+                it->scaled = it->scaled || x.scaled;
+                it->running = std::min(it->running, x.running);
+            }
+        }
+    };
+
+    enum class Grouping { Separate, Together };
+
+    // Raw totals at one point in time (read())
+    struct Snapshot {
+        struct Raw {
+            std::uint64_t value = 0, enabled = 0, running = 0;
+            bool ok = false;
+        };
+        std::vector<Raw> raw;
+    };
+
+    static std::vector<Event> defaultEvents() {
+#if defined(__linux__)
+        return {
+            {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {"cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {"task-clock", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+            {"page-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+            {"context-switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+        };
+#elif defined(_WIN32)
+        return {{"cycles", 0, 0}};
+#else
+        return {};
+#endif
+    }
+
+    explicit PerfCounters(std::vector<Event> events = defaultEvents(), Grouping grouping = Grouping::Separate)
+        : events_(std::move(events)), grouped_(grouping == Grouping::Together) {
+        fds_.assign(events_.size(), -1);
+#if defined(__linux__)
+        for (std::size_t i = 0; i < events_.size(); ++i) {
+            const bool member = grouped_ && leader_ >= 0;
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events_[i].type;
+            attr.config = events_[i].config;
+            attr.disabled = member ? 0 : 1;                 // members follow the leader
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            if (grouped_) attr.read_format |= PERF_FORMAT_GROUP;
+            fds_[i] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, member ? leader_ : -1, 0));
+            if (grouped_ && fds_[i] >= 0) {
+                if (leader_ < 0) leader_ = fds_[i];
+                slot_.push_back(i);                         // position in the group read
+            }
+        }
+#elif defined(_WIN32)
+        for (std::size_t i = 0; i < events_.size(); ++i)
+            if (events_[i].name == "cycles") fds_[i] = 0;
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int fd : fds_)
+            if (fd >= 0) ::close(fd);
+#endif
+    }
+
+    // Any event at all, and any hardware event
+    bool available() const {
+        for (int fd : fds_)
+            if (fd >= 0) return true;
+        return false;
+    }
+    bool hardwareAvailable() const {
+#if defined(__linux__)
+        for (std::size_t i = 0; i < fds_.size(); ++i)
+            if (fds_[i] >= 0 && events_[i].type == PERF_TYPE_HARDWARE) return true;
+#elif defined(_WIN32)
+        return available();
+#endif
+        return false;
+    }
+
+    void start() {
+#if defined(__linux__)
+        control(PERF_EVENT_IOC_RESET);
+        control(PERF_EVENT_IOC_ENABLE);
+#endif
+        base_ = read();
+    }
+
+    Sample stop() {
+#if defined(__linux__)
+        control(PERF_EVENT_IOC_DISABLE);
+#endif
+        return since(base_);
+    }
+
+    // Current totals, counters keep running
+    Snapshot read() const {
+        Snapshot s;
+        s.raw.resize(events_.size());
+#if defined(__linux__)
+        if (grouped_) {
+            if (leader_ < 0) return s;
+            std::vector<std::uint64_t> buf(3 + slot_.size());  // nr, enabled, running, values...
+            const ssize_t want = static_cast<ssize_t>(buf.size() * sizeof(std::uint64_t));
+            if (::read(leader_, buf.data(), buf.size() * sizeof(std::uint64_t)) != want) return s;
+            for (std::size_t k = 0; k < slot_.size() && k < buf[0]; ++k)
+                s.raw[slot_[k]] = {buf[3 + k], buf[1], buf[2], true};
+            return s;
+        }
+        for (std::size_t i = 0; i < events_.size(); ++i) {
+            std::uint64_t buf[3];                           // value, enabled, running
+            if (fds_[i] >= 0 && ::read(fds_[i], buf, sizeof(buf)) == static_cast<ssize_t>(sizeof(buf)))
+                s.raw[i] = {buf[0], buf[1], buf[2], true};
+        }
+#elif defined(_WIN32)
+        ULONG64 cycles = 0;
+        for (std::size_t i = 0; i < events_.size(); ++i)
+            if (fds_[i] >= 0 && ::QueryThreadCycleTime(::GetCurrentThread(), &cycles))
+                s.raw[i] = {cycles, cycles, cycles, true};  // never multiplexed
+#endif
+        return s;
+    }
+
+    // Counts between `before` and now, scaled for multiplexing
+    Sample since(const Snapshot& before) const {
+        const Snapshot now = read();
+        Sample s;
+        s.merged = 1;
+        s.readings.reserve(events_.size());
+        for (std::size_t i = 0; i < events_.size(); ++i) {
+            Reading r;
+            r.name = events_[i].name;
+            const Snapshot::Raw& a = i < before.raw.size() ? before.raw[i] : Snapshot::Raw{};
+            const Snapshot::Raw& b = now.raw[i];
+            if (b.ok) {
+                const std::uint64_t value = b.value - (a.ok ? a.value : 0);
+                const std::uint64_t enabled = b.enabled - (a.ok ? a.enabled : 0);
+                const std::uint64_t running = b.running - (a.ok ? a.running : 0);
+                if (running == 0) {
+                    r.value = enabled == 0 ? 0 : -1;        // enabled but never scheduled
+                    r.running = enabled == 0 ? 1 : 0;
+                } else {
+                    r.scaled = running < enabled;
+                    r.running = r.scaled ? double(running) / double(enabled) : 1.0;
+                    r.value = static_cast<double>(value) / r.running;
+                }
+            }
+            s.readings.push_back(std::move(r));
+        }
+        return s;
+    }
+
+    // The calling thread's default counters, opened and started on
+    // first use and left running (PerfRegion reads them)
+    static PerfCounters& forThread() {
+        thread_local PerfCounters pmu;
+        thread_local bool started = (pmu.start(), true);
+        (void)started;
+        return pmu;
+    }
+
+private:
+#if defined(__linux__)
+    void control(unsigned long request) {
+        if (grouped_) {
+            if (leader_ >= 0) ::ioctl(leader_, request, PERF_IOC_FLAG_GROUP);
+            return;
+        }
+        for (int fd : fds_)
+            if (fd >= 0) ::ioctl(fd, request, 0);
+    }
+#endif
+
+    std::vector<Event> events_;
+    std::vector<int> fds_;
+    bool grouped_;
+    int leader_ = -1;
+    std::vector<std::size_t> slot_;                         // group read position → event
+    Snapshot base_;
+};
+
+// Per-region totals over every thread that ran the region
+class PerfTotals {
+public:
+    void add(const std::string& region, const PerfCounters::Sample& s) {
+        std::lock_guard<std::mutex> lock(m_);
+        regions_[region].merge(s);
+    }
+
+    PerfCounters::Sample get(const std::string& region) const {
+        std::lock_guard<std::mutex> lock(m_);
+        auto it = regions_.find(region);
+        return it == regions_.end() ? PerfCounters::Sample{} : it->second;
+    }
+
+    // One row per region: calls and each event's total per call
+    // ("-" unavailable, "*" multiplexed and scaled)
+    void print(std::ostream& out) const {
+        std::lock_guard<std::mutex> lock(m_);
+        if (regions_.empty()) return;
+        char cell[64];
+        std::snprintf(cell, sizeof(cell), "  %-24s %8s", "region (per call)", "calls");
+        out << cell;
+        for (const PerfCounters::Reading& r : regions_.begin()->second.readings) {
+            std::snprintf(cell, sizeof(cell), " %16s", r.name.c_str());
+            out << cell;
+        }
+        out << '\n';
+        for (const auto& [name, s] : regions_) {
+            std::snprintf(cell, sizeof(cell), "  %-24s %8llu", name.c_str(), (unsigned long long)s.merged);
+            out << cell;
+            for (const PerfCounters::Reading& r : s.readings) {
+                if (r.value < 0)
+                    std::snprintf(cell, sizeof(cell), " %16s", "-");
+                else
+                    std::snprintf(cell, sizeof(cell), " %15.1f%s", r.value / double(s.merged),
+                                  r.scaled ? "*" : " ");
+                out << cell;
+            }
+            out << '\n';
+        }
+        out.flush();
+    }
+
+private:
+    mutable std::mutex m_;
+    std::map<std::string, PerfCounters::Sample> regions_;
+};
+
+// The calling thread's counts over a scope, added to totals[name]
+class PerfRegion {
+public:
+    PerfRegion(PerfTotals& totals, std::string name)
+        : totals_(totals), name_(std::move(name)), pmu_(PerfCounters::forThread()), begin_(pmu_.read()) {}
+
+    PerfRegion(const PerfRegion&) = delete;
+    PerfRegion& operator=(const PerfRegion&) = delete;
+
+    ~PerfRegion() { totals_.add(name_, pmu_.since(begin_)); }
+
+private:
+    PerfTotals& totals_;
+    std::string name_;
+    PerfCounters& pmu_;
+    PerfCounters::Snapshot begin_;
+};
@@ -0,0 +1,299 @@
+#!/usr/bin/env bash
+# ==========================================================
+# build.sh — every documented program, in matched configurations
+# ==========================================================
+#
+# The tree has no build files: each demo carries its own command
+#
+#     // Build:
+#     //   g++ -std=c++20 -O2 -pthread threadCacheAlloc.cpp ThreadCache.cpp -o threadcache
+#
+# and is built by hand in its directory, with whatever flags the
+# reader types. This script turns those lines into targets:
+#
+#   - one target per documented compiler line: every g++ line
+#     under a "// Build:" or "// Build (<note>):" header, named
+#     after the first source — bench_<stem> when it uses the
+#     benchmark harness (MicroBench.h / ContentionBench.h), <stem>
+#     otherwise; a file's second, third, ... line gets _2, _3, ...
+#   - groups: a directory (Concepts, Multithreading, FunctionTemplates,
+#     ... — spaces dropped), or `bench` for every bench_ target
+#   - configurations, identical flags for every target:
+#       o2        the documented line as written
+#       native    -O3 -march=native
+#       lto       native + -flto=auto
+#       pgo       native, built instrumented, trained by running
+#                 the program once, rebuilt with the profile
+#       pgo-lto   pgo + lto
+#     (-O / -march in the documented line are replaced; -pthread,
+#     -mavx2, extra sources are kept)
+#   - every compile gets -DBUILD_SOURCE_DIR="<absolute source
+#     directory>", for programs that read files next to their
+#     sources
+#   - outputs in _build/<config>/<target> (BUILD_DIR to move it);
+#     nothing is written next to the sources, so directory names
+#     with spaces or colons in file names do not matter
+#
+# --run runs each built target (from _build/<config>/run) and
+# keeps its output in _build/<config>/<target>.log; --compare
+# then lines up every MicroBench row ("ns/iter") across the
+# chosen configurations, relative to the first one.
+#
+# Files without a "// Build:" header (the original teaching files:
+# some are notes, not programs) are not targets.
+#
+# Usage (from anywhere):
+#   Benchmarks/build.sh --list
+#   Benchmarks/build.sh                               # all targets, o2
+#   Benchmarks/build.sh --config=o2,lto,pgo bench     # harness targets, 3 configs
+#   Benchmarks/build.sh --config=o2,pgo-lto --run --compare bench_inlineBench
+#   Benchmarks/build.sh -j4 Multithreading
+#   CXX=clang++ Benchmarks/build.sh ...
+#
+set -u
+
+CXX=${CXX:-g++}
+root=$(cd "$(dirname "$0")/.." && pwd)
+out=${BUILD_DIR:-$root/_build}
+
+configs=(o2)
+jobs=1
+run=0
+compare=0
+list=0
+selected=()
+
+usage() {
+    sed -n '/^# Usage/,/^set -u/p' "$0" | sed '$d; s/^# \{0,1\}//'
+    exit 2
+}
+
+for a in "$@"; do
+    case $a in
+        --config=*) IFS=, read -ra configs <<<"${a#--config=}" ;;
+        -j*) jobs=${a#-j} ;;
+        --run) run=1 ;;
+        --compare) compare=1; run=1 ;;
+        --list) list=1 ;;
+        -h|--help) usage ;;
+        -*) echo "unknown option $a" >&2; usage ;;
+        *) selected+=("$a") ;;
+    esac
+done
+
+for c in "${configs[@]}"; do
+    case $c in o2|native|lto|pgo|pgo-lto) ;; *) echo "unknown configuration $c" >&2; exit 2 ;; esac
+done
+
+# ---------------- target discovery ----------------
+
+# The compiler lines under every "// Build:" / "// Build (...):"
+# header of a file, in order
+recipes() {
+    awk '
+        /^\/\/ Build( \(.*\))?:[[:space:]]*$/ { inRecipe = 1; next }
+        inRecipe && /^\/\/[[:space:]]+(g\+\+|\$CXX) / { sub(/^\/\/[[:space:]]*/, ""); print; next }
+        { inRecipe = 0 }' "$1"
+}
+
+names=() dirs=() lines=() groups=()
+while IFS= read -r -d '' f; do
+    bench=0
+    grep -qE '#include "[^"]*(MicroBench|ContentionBench)\.h"' "$f" && bench=1
+    dir=$(dirname "$f")
+    group=$(basename "$dir")
+    k=0
+    while IFS= read -r line; do
+        read -ra toks <<<"$line"
+        stem=
+        for t in "${toks[@]}"; do
+            [[ $t == *.cpp ]] && { stem=${t%.cpp}; break; }
+        done
+        [ -n "$stem" ] || continue              # "g++ ... -DX=0 ..." style notes
+        k=$((k + 1))
+        name=$stem
+        [ $bench = 1 ] && name=bench_$stem
+        [ $k -gt 1 ] && name=${name}_$k
+        names+=("$name")
+        dirs+=("$dir")
+        lines+=("$line")
+        groups+=("${group// /}")
+    done < <(recipes "$f")
+done < <(find "$root" -name '*.cpp' -not -path '*/.git/*' -not -path "$out/*" -print0 | sort -z)
+
+wanted() {
+    local i=$1 s
+    [ ${#selected[@]} -eq 0 ] && return 0
+    for s in "${selected[@]}"; do
+        s=${s// /}
+        s=${s%/}
+        [ "$s" = "${names[i]}" ] || [ "$s" = "${groups[i]}" ] && return 0
+        [ "$s" = bench ] && [[ ${names[i]} == bench_* ]] && return 0
+    done
+    return 1
+}
+
+targets=()
+for i in "${!names[@]}"; do
+    wanted "$i" && targets+=("$i")
+done
+
+if [ "$list" = 1 ]; then
+    for i in "${targets[@]}"; do printf '%-28s %-20s %s\n' "${names[i]}" "${groups[i]}" "${lines[i]}"; done
+    exit 0
+fi
+[ ${#targets[@]} -gt 0 ] || { echo "no targets match: ${selected[*]}" >&2; exit 2; }
+
+# ---------------- building ----------------
+
+# Compiler arguments of target i for a configuration, minus the
+# optimisation flags: "flags" then "sources", one per line
+split_line() {
+    local i=$1 t skip=0
+    read -ra toks <<<"${lines[i]}"
+    flags=() sources=()
+    for t in "${toks[@]:1}"; do
+        if [ $skip = 1 ]; then skip=0; continue; fi
+        case $t in
+            -o) skip=1 ;;
+            *.cpp) sources+=("$t") ;;
+            *) flags+=("$t") ;;
+        esac
+    done
+}
+
+config_flags() {
+    local cfg=$1 f kept=()
+    if [ "$cfg" = o2 ]; then
+        opt=("${flags[@]}")
+        return
+    fi
+    for f in "${flags[@]}"; do
+        case $f in -O*|-march=*) ;; *) kept+=("$f") ;; esac
+    done
+    opt=("${kept[@]}" -O3 -march=native)
+    case $cfg in *lto) opt+=(-flto=auto) ;; esac
+}
+
+# BUILD_SOURCE_DIR: the source directory, absolute, for programs
+# that read files next to their sources (they run from _build)
+compile() {
+    (cd "${dirs[$1]}" && "$CXX" "${opt[@]}" "-DBUILD_SOURCE_DIR=\"${dirs[$1]}\"" "${@:3}" "${sources[@]}" -o "$2")
+}
+
+build_one() {
+    local i=$1 cfg=$2 bin log prof
+    bin=$out/$cfg/${names[i]}
+    log=$out/$cfg/${names[i]}.build.log
+    split_line "$i"
+    config_flags "$cfg"
+    case $cfg in
+        pgo*)
+            prof=$out/$cfg/profiles/${names[i]}
+            rm -rf "$prof"
+            mkdir -p "$prof" "$out/$cfg/run"
+            compile "$i" "$bin" -fprofile-generate="$prof" -fprofile-update=prefer-atomic > "$log" 2>&1 &&
+                (cd "$out/$cfg/run" && timeout 600 "$bin" > /dev/null 2>&1 < /dev/null; true) &&
+                compile "$i" "$bin" -fprofile-use="$prof" -fprofile-partial-training -Wno-missing-profile >> "$log" 2>&1
+            ;;
+        *)
+            compile "$i" "$bin" > "$log" 2>&1
+            ;;
+    esac
+    local rc=$?
+    if [ $rc = 0 ]; then echo "  built  ${names[i]}"; else echo "  FAILED ${names[i]} (see $log)"; fi
+    return $rc
+}
+
+failed=0
+for cfg in "${configs[@]}"; do
+    mkdir -p "$out/$cfg"
+    echo "== $cfg (${#targets[@]} targets, $CXX)"
+    for i in "${targets[@]}"; do
+        while [ "$(jobs -rp | wc -l)" -ge "$jobs" ]; do wait -n; done
+        build_one "$i" "$cfg" &
+    done
+    while [ "$(jobs -rp | wc -l)" -gt 0 ]; do wait -n || failed=1; done
+    wait || failed=1
+done
+for cfg in "${configs[@]}"; do
+    for i in "${targets[@]}"; do [ -x "$out/$cfg/${names[i]}" ] || failed=1; done
+done
+
+# ---------------- running ----------------
+
+if [ "$run" = 1 ]; then
+    for cfg in "${configs[@]}"; do
+        echo "== run $cfg"
+        mkdir -p "$out/$cfg/run"
+        for i in "${targets[@]}"; do
+            bin=$out/$cfg/${names[i]}
+            [ -x "$bin" ] || continue
+            start=$(date +%s%N)
+            (cd "$out/$cfg/run" && timeout 600 "$bin" > "$out/$cfg/${names[i]}.log" 2>&1 < /dev/null)
+            rc=$?
+            ms=$(( ($(date +%s%N) - start) / 1000000 ))
+            [ $rc = 0 ] || failed=1
+            printf '  %-28s exit %-3s %5d.%01d s  %s\n' "${names[i]}" "$rc" $((ms / 1000)) $((ms % 1000 / 100)) \
+                "$(grep -m1 -o 'all checks: [a-zA-Z]*' "$out/$cfg/${names[i]}.log")"
+        done
+    done
+fi
+
+# ---------------- comparing ----------------
+
+# "target<TAB>suite<TAB>row<TAB>ns" for every MicroBench row of a log
+bench_rows() {
+    awk -v target="$2" '
+        /^== / { suite = $0; sub(/^== /, "", suite); sub(/ \([0-9]+ samples.*$/, "", suite); inTable = 1; next }
+        inTable && /^  benchmark / { next }
+        inTable && /^  [^ (]/ {
+            # numeric tail: ns/iter, MAD, x (+ cycles, instr, IPC, br-miss, cache-miss)
+            n = 0
+            for (k = NF; k > 1 && $k ~ /^-?[0-9]+(\.[0-9]+)?$/; --k) ++n
+            if (n < 3) next
+            first = NF - (n >= 8 ? 8 : 3) + 1
+            row = $1
+            for (k = 2; k < first; ++k) row = row " " $k
+            print target "\t" suite "\t" row "\t" $first
+            next
+        }
+        { inTable = 0 }' "$1"
+}
+
+if [ "$compare" = 1 ] && [ ${#configs[@]} -gt 1 ]; then
+    echo "== ns/iter by configuration (change vs ${configs[0]})"
+    tmp=$(mktemp -d)
+    trap 'rm -rf "$tmp"' EXIT
+    for cfg in "${configs[@]}"; do
+        for i in "${targets[@]}"; do
+            log=$out/$cfg/${names[i]}.log
+            [ -f "$log" ] && bench_rows "$log" "${names[i]}"
+        done > "$tmp/$cfg.tsv"
+    done
+    # One column per configuration, rows joined on target + suite + row
+    awk -F'\t' -v configs="${configs[*]}" -v dir="$tmp" '
+        BEGIN {
+            nc = split(configs, cfg, " ")
+            for (c = 2; c <= nc; ++c)
+                while ((getline l < (dir "/" cfg[c] ".tsv")) > 0) {
+                    split(l, f, "\t")
+                    ns[c, f[1] "\t" f[2] "\t" f[3]] = f[4]
+                }
+            printf "  %-36s", ""
+            for (c = 1; c <= nc; ++c) printf " %16s", cfg[c]
+            printf "\n"
+        }
+        {
+            if ($1 "\t" $2 != last) { printf "%s: %s\n", $1, $2; last = $1 "\t" $2 }
+            printf "  %-36s %16s", $3, $4
+            for (c = 2; c <= nc; ++c) {
+                k = c SUBSEP $1 "\t" $2 "\t" $3
+                if (k in ns) printf " %8s (%+4.0f%%)", ns[k], ($4 > 0 ? (ns[k] - $4) * 100 / $4 : 0)
+                else printf " %16s", "-"
+            }
+            printf "\n"
+        }' "$tmp/${configs[0]}.tsv"
+fi
+
+exit $failed
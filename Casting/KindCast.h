@@ -0,0 +1,96 @@
+// ==========================================================
+// KindCast.h — isa<> / dyn_cast<> / cast<> without RTTI
+// ==========================================================
+//
+// dynamic_cast<Car*>(obj) asks the runtime type information:
+// walk the type_info graph of obj's dynamic type looking for
+// Car (and, with some ABIs / shared libraries, compare type
+// names as STRINGS). Correct, but not cheap in a hot loop.
+//
+// LLVM-STYLE KIND IDS (opt-in, per hierarchy):
+// 1. The base class stores a small integer KIND, set by each
+//    constructor and never changed.
+// 2. Kinds are numbered in PRE-ORDER of the class tree, so
+//    every class and all of its descendants form a
+//    CONTIGUOUS range [FirstKind, LastKind]:
+//
+//        GameObject                0
+//        ├── Vehicle               1    Vehicle : [1, 3]
+//        │   ├── Car               2
+//        │   └── Truck             3
+//        └── Building              4    Building: [4, 4]
+//
+// 3. Each class has   static bool classof(const Base*)
+//    → "is this object one of mine?" = ONE range check
+//      (a subtract and an unsigned compare, see inKindRange).
+//
+// API (pointers and references):
+//   isa<Car>(p)            → bool          (p must not be null)
+//   dyn_cast<Car>(p)       → Car* / nullptr
+//   cast<Car>(p)           → Car*, asserts the kind matches
+//   isa_and_nonnull<Car>(p), dyn_cast_or_null<Car>(p)
+//
+// Only the classes you annotate take part; dynamic_cast still
+// works for everything else.
+//
+#pragma once
+
+#include <cassert>
+#include <type_traits>
+
+// first <= k <= last as a single unsigned comparison
+template <typename K>
+constexpr bool inKindRange(K k, K first, K last) {
+    using U = std::make_unsigned_t<std::underlying_type_t<K>>;
+    return (U)((U)k - (U)first) <= (U)((U)last - (U)first);
+}
+
+namespace kind_detail {
+
+template <typename To, typename From>
+using CastResult = std::conditional_t<std::is_const_v<From>, const To, To>;
+
+}  // namespace kind_detail
+
+template <typename To, typename From>
+bool isa(const From* p) {
+    assert(p && "isa<> on a null pointer");
+    if constexpr (std::is_base_of_v<To, From>) {
+        return true;                                  // upcast: always true
+    } else {
+        return To::classof(p);
+    }
+}
+
+template <typename To, typename From>
+    requires(!std::is_pointer_v<From>)
+bool isa(const From& r) {
+    return isa<To>(&r);
+}
+
+template <typename To, typename From>
+bool isa_and_nonnull(const From* p) {
+    return p && isa<To>(p);
+}
+
+template <typename To, typename From>
+kind_detail::CastResult<To, From>* dyn_cast(From* p) {
+    return isa<To>(p) ? static_cast<kind_detail::CastResult<To, From>*>(p) : nullptr;
+}
+
+template <typename To, typename From>
+kind_detail::CastResult<To, From>* dyn_cast_or_null(From* p) {
+    return p && isa<To>(p) ? static_cast<kind_detail::CastResult<To, From>*>(p) : nullptr;
+}
+
+template <typename To, typename From>
+kind_detail::CastResult<To, From>* cast(From* p) {
+    assert(isa<To>(p) && "cast<> to the wrong kind");
+    return static_cast<kind_detail::CastResult<To, From>*>(p);
+}
+
+template <typename To, typename From>
+    requires(!std::is_pointer_v<From>)
+kind_detail::CastResult<To, From>& cast(From& r) {
+    return *cast<To>(&r);
+}
@@ -0,0 +1,529 @@
+// ==========================================================
+// ShardedEntities.h — entities partitioned across nodes, batched binary frames
+// ==========================================================
+//
+// entitymanagerPattern.cpp:
+//
+//     EntityManager manager;
+//     manager.destroy(player);          // `player` is HERE, in this process
+//
+// Once the world does not fit one process, an entity lives on
+// ONE node (its OWNER) and everybody else sends it requests.
+//
+// PLACEMENT — who owns entity `id` holding state `s`:
+//   IdRange: the id's range (id · nodes / entities) — fixed
+//   Spatial: the node whose strip of the world holds s.x — an
+//            entity that moves into another strip MIGRATES
+// HOME — who knows where `id` is: always its id range. The home
+// keeps a directory id → owner for the ids in its range.
+//
+// ROUTING (ShardNode::route):
+//   the owner applies the request; the home forwards it to the
+//   owner in its directory (or drops it: the entity is gone);
+//   anybody else sends it to the home. With IdRange placement home
+//   and owner coincide: one hop, never forwarded.
+//
+// OWNERSHIP HANDOFF (a migrating entity, at the end of step()):
+//   old owner → new owner:  Handoff {id, state}      (new owner owns it on receipt)
+//   old owner → home:       OwnerChanged {id, new}   (unless either is the home)
+//   A destroy likewise tells the home (OwnerChanged {id, dead}).
+//   A request that reaches the old owner after the handoff goes
+//   back to the home, which by then knows the new owner.
+//
+// TICKS (bulk-synchronous): each node makes requests and steps its
+// entities; every message for node j goes into ONE frame for j;
+// exchange() sends every peer its frame and receives one from
+// each (an empty frame marks "nothing this tick"); then deliver()
+// applies them — messages to forward go into the next tick's
+// frames.
+//
+// WIRE FORMAT (host byte order: every node is the same build on
+// little-endian hosts):
+//   frame   [magic 'ENTF' u32][tick u32][messages u32][payload bytes u32] records...
+//   record  [op u8][hops u8][id u64] + payload by op:
+//             Update        dvx f32, dvy f32            18 bytes
+//             Destroy       -                           10 bytes
+//             Handoff       x y vx vy hp f32            30 bytes
+//             OwnerChanged  node i16 (-1: destroyed)    12 bytes
+//
+// TcpMesh: every pair of nodes one TCP connection (TCP_NODELAY);
+// exchange() polls all of them, writing and reading at once, so two
+// nodes sending each other big frames cannot block each other.
+// Another transport (RDMA, shared memory) only has to move frames.
+//
+#pragma once
+
+#include <arpa/inet.h>
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <system_error>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace shard {
+
+static_assert(std::endian::native == std::endian::little, "shard: the wire format is little-endian host order");
+
+enum class Op : std::uint8_t { Update = 1, Destroy, Handoff, OwnerChanged };
+enum class Placement { IdRange, Spatial };
+
+struct EntityState {
+    float x = 0, y = 0, vx = 0, vy = 0, hp = 100;
+};
+
+struct Message {
+    Op op = Op::Update;
+    std::uint8_t hops = 0;
+    std::uint64_t id = 0;
+    float dvx = 0, dvy = 0;                 // Update
+    EntityState state;                      // Handoff
+    std::int16_t node = -1;                 // OwnerChanged
+};
+
+constexpr std::uint32_t kMagic = 0x46544E45;            // "ENTF"
+constexpr std::size_t kHeaderBytes = 16;
+
+inline std::size_t recordBytes(Op op) {
+    switch (op) {
+    case Op::Update: return 18;
+    case Op::Destroy: return 10;
+    case Op::Handoff: return 30;
+    case Op::OwnerChanged: return 12;
+    }
+    return 0;
+}
+
+// Messages for one destination, appended to one frame
+class FrameWriter {
+public:
+    void add(const Message& m) {
+        const std::size_t at = buf_.size();
+        buf_.resize(at + recordBytes(m.op));
+        char* p = buf_.data() + at;
+        p[0] = char(m.op);
+        p[1] = char(m.hops);
+        std::memcpy(p + 2, &m.id, 8);
+        switch (m.op) {
+        case Op::Update:
+            std::memcpy(p + 10, &m.dvx, 4);
+            std::memcpy(p + 14, &m.dvy, 4);
+            break;
+        case Op::Handoff: {
+            const float f[5] = {m.state.x, m.state.y, m.state.vx, m.state.vy, m.state.hp};
+            std::memcpy(p + 10, f, sizeof f);
+            break;
+        }
+        case Op::OwnerChanged: std::memcpy(p + 10, &m.node, 2); break;
+        case Op::Destroy: break;
+        }
+        ++count_;
+    }
+
+    std::uint32_t count() const { return count_; }
+
+    // The frame (header + records); the writer is empty afterwards
+    std::string take(std::uint32_t tick) {
+        std::string frame(kHeaderBytes, '\0');
+        const std::uint32_t h[4] = {kMagic, tick, count_, std::uint32_t(buf_.size())};
+        std::memcpy(frame.data(), h, sizeof h);
+        frame.append(buf_.data(), buf_.size());
+        buf_.clear();
+        count_ = 0;
+        return frame;
+    }
+
+private:
+    std::vector<char> buf_;
+    std::uint32_t count_ = 0;
+};
+
+// f(message) for every record; throws std::runtime_error on a malformed frame
+template <typename F>
+void readFrame(const std::string& frame, F&& f) {
+    std::uint32_t h[4];
+    if (frame.size() < kHeaderBytes) throw std::runtime_error("shard: short frame");
+    std::memcpy(h, frame.data(), sizeof h);
+    if (h[0] != kMagic || kHeaderBytes + h[3] != frame.size()) throw std::runtime_error("shard: bad frame header");
+    const char* p = frame.data() + kHeaderBytes;
+    const char* end = frame.data() + frame.size();
+    for (std::uint32_t i = 0; i < h[2]; ++i) {
+        if (p >= end) throw std::runtime_error("shard: frame shorter than its count");
+        Message m;
+        m.op = Op(std::uint8_t(p[0]));
+        const std::size_t n = recordBytes(m.op);
+        if (n == 0 || p + n > end) throw std::runtime_error("shard: bad record");
+        m.hops = std::uint8_t(p[1]);
+        std::memcpy(&m.id, p + 2, 8);
+        switch (m.op) {
+        case Op::Update:
+            std::memcpy(&m.dvx, p + 10, 4);
+            std::memcpy(&m.dvy, p + 14, 4);
+            break;
+        case Op::Handoff: {
+            float v[5];
+            std::memcpy(v, p + 10, sizeof v);
+            m.state = {v[0], v[1], v[2], v[3], v[4]};
+            break;
+        }
+        case Op::OwnerChanged: std::memcpy(&m.node, p + 10, 2); break;
+        case Op::Destroy: break;
+        }
+        f(m);
+        p += n;
+    }
+}
+
+class ShardNode {
+public:
+    struct Config {
+        int nodes = 1;
+        std::uint64_t entities = 0;             // ids 0 .. entities-1
+        float worldWidth = 1000;                // Spatial: strip k is [k·w/nodes, (k+1)·w/nodes)
+        Placement placement = Placement::IdRange;
+    };
+
+    struct Stats {
+        std::uint64_t updatesApplied = 0, destroysApplied = 0, dropped = 0;
+        std::uint64_t destroyedIdSum = 0;
+        std::uint64_t forwarded = 0;            // received, then sent on
+        std::uint64_t handoffsOut = 0, handoffsIn = 0;
+        std::uint64_t messagesSent = 0, bytesSent = 0, framesSent = 0;
+        std::uint64_t maxHops = 0;
+    };
+
+    // initial(id): every node computes the same starting world and
+    // keeps the entities it owns and the directory of its ids
+    ShardNode(int self, Config cfg, const std::function<EntityState(std::uint64_t)>& initial)
+        : self_(self), cfg_(cfg), out_(std::size_t(cfg.nodes)) {
+        if (cfg.nodes < 1 || self < 0 || self >= cfg.nodes || cfg.entities == 0 || !(cfg.worldWidth > 0))
+            throw std::invalid_argument("ShardNode: bad configuration");
+        for (std::uint64_t id = 0; id < cfg.entities; ++id) {
+            const bool mine = home(id) == self;
+            if (!mine && cfg.placement == Placement::IdRange) continue;
+            const EntityState s = initial(id);
+            const int owner = ownerOf(id, s);
+            if (owner == self) owned_.emplace(id, s);
+            if (mine) dir_.emplace(id, std::int16_t(owner));
+        }
+    }
+
+    int self() const { return self_; }
+    int nodes() const { return cfg_.nodes; }
+
+    int home(std::uint64_t id) const { return int(id * std::uint64_t(cfg_.nodes) / cfg_.entities); }
+    int ownerOf(std::uint64_t id, const EntityState& s) const {
+        if (cfg_.placement == Placement::IdRange) return home(id);
+        const int k = int(s.x / cfg_.worldWidth * float(cfg_.nodes));
+        return std::clamp(k, 0, cfg_.nodes - 1);
+    }
+
+    void requestUpdate(std::uint64_t id, float dvx, float dvy) {
+        Message m;
+        m.op = Op::Update;
+        m.id = id;
+        m.dvx = dvx;
+        m.dvy = dvy;
+        route(m, false);
+    }
+    void requestDestroy(std::uint64_t id) {
+        Message m;
+        m.op = Op::Destroy;
+        m.id = id;
+        route(m, false);
+    }
+
+    // Moves every owned entity (x wraps around the world); hands off
+    // the ones that left this node's strip
+    void step(float dt) {
+        std::vector<std::uint64_t> leaving;
+        for (auto& [id, s] : owned_) {
+            s.x += s.vx * dt;
+            s.y += s.vy * dt;
+            if (s.x >= cfg_.worldWidth) s.x -= cfg_.worldWidth;
+            if (s.x < 0) s.x += cfg_.worldWidth;
+            if (s.x >= cfg_.worldWidth) s.x = 0;            // -tiny + width rounds up to width
+            if (ownerOf(id, s) != self_) leaving.push_back(id);
+        }
+        for (std::uint64_t id : leaving) {
+            auto it = owned_.find(id);
+            const int to = ownerOf(id, it->second);
+            Message h;
+            h.op = Op::Handoff;
+            h.id = id;
+            h.state = it->second;
+            send(to, h);
+            owned_.erase(it);
+            ++stats_.handoffsOut;
+            const int hm = home(id);
+            if (hm == self_)
+                dir_[id] = std::int16_t(to);
+            else if (hm != to)
+                ownerChanged(id, to);
+        }
+    }
+
+    // This tick's frame for every node (an empty one for a node with
+    // nothing to say; none for self)
+    std::vector<std::string> takeFrames(std::uint32_t tick) {
+        std::vector<std::string> frames(out_.size());
+        for (int j = 0; j < cfg_.nodes; ++j) {
+            if (j == self_) continue;
+            frames[j] = out_[j].take(tick);
+            ++stats_.framesSent;
+            stats_.bytesSent += frames[j].size();
+        }
+        return frames;
+    }
+
+    void deliver(const std::string& frame) {
+        readFrame(frame, [&](const Message& m) {
+            stats_.maxHops = std::max<std::uint64_t>(stats_.maxHops, m.hops);
+            switch (m.op) {
+            case Op::Update:
+            case Op::Destroy: route(m, true); break;
+            case Op::Handoff:
+                owned_[m.id] = m.state;
+                ++stats_.handoffsIn;
+                if (home(m.id) == self_) dir_[m.id] = std::int16_t(self_);
+                break;
+            case Op::OwnerChanged:
+                if (m.node < 0)
+                    dir_.erase(m.id);
+                else
+                    dir_[m.id] = m.node;
+                break;
+            }
+        });
+    }
+
+    const Stats& stats() const { return stats_; }
+    std::size_t owned() const { return owned_.size(); }
+    std::size_t directorySize() const { return dir_.size(); }
+    const EntityState* find(std::uint64_t id) const {
+        auto it = owned_.find(id);
+        return it == owned_.end() ? nullptr : &it->second;
+    }
+    std::uint64_t ownedIdSum() const {
+        std::uint64_t s = 0;
+        for (const auto& [id, e] : owned_) s += id;
+        return s;
+    }
+
+private:
+    void route(Message m, bool fromWire) {
+        auto it = owned_.find(m.id);
+        if (it != owned_.end()) {
+            apply(it, m);
+            return;
+        }
+        int dest = home(m.id);
+        if (dest == self_) {
+            auto d = dir_.find(m.id);
+            if (d == dir_.end() || d->second == self_) {         // destroyed (or never existed)
+                ++stats_.dropped;
+                return;
+            }
+            dest = d->second;
+        }
+        if (fromWire) ++stats_.forwarded;
+        m.hops = std::uint8_t(std::min(255, m.hops + 1));
+        send(dest, m);
+    }
+
+    void apply(std::unordered_map<std::uint64_t, EntityState>::iterator it, const Message& m) {
+        if (m.op == Op::Update) {
+            it->second.vx += m.dvx;
+            it->second.vy += m.dvy;
+            ++stats_.updatesApplied;
+            return;
+        }
+        const std::uint64_t id = it->first;
+        owned_.erase(it);
+        ++stats_.destroysApplied;
+        stats_.destroyedIdSum += id;
+        if (home(id) == self_)
+            dir_.erase(id);
+        else
+            ownerChanged(id, -1);
+    }
+
+    void ownerChanged(std::uint64_t id, int node) {
+        Message m;
+        m.op = Op::OwnerChanged;
+        m.id = id;
+        m.node = std::int16_t(node);
+        send(home(id), m);
+    }
+
+    void send(int dest, const Message& m) {
+        out_[dest].add(m);
+        ++stats_.messagesSent;
+    }
+
+    int self_;
+    Config cfg_;
+    std::unordered_map<std::uint64_t, EntityState> owned_;
+    std::unordered_map<std::uint64_t, std::int16_t> dir_;       // ids homed here → owner
+    std::vector<FrameWriter> out_;
+    Stats stats_;
+};
+
+// One TCP connection per pair of nodes on 127.0.0.1
+class TcpMesh {
+public:
+    // Before forking: a listening socket per node (ephemeral ports)
+    static std::vector<int> listenAll(int nodes, std::vector<std::uint16_t>& ports) {
+        std::vector<int> fds;
+        ports.clear();
+        for (int i = 0; i < nodes; ++i) {
+            const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            if (fd < 0) throw std::system_error(errno, std::generic_category(), "socket");
+            sockaddr_in a{};
+            a.sin_family = AF_INET;
+            a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            socklen_t len = sizeof a;
+            if (::bind(fd, reinterpret_cast<sockaddr*>(&a), sizeof a) != 0 || ::listen(fd, nodes) != 0 ||
+                ::getsockname(fd, reinterpret_cast<sockaddr*>(&a), &len) != 0)
+                throw std::system_error(errno, std::generic_category(), "bind/listen");
+            fds.push_back(fd);
+            ports.push_back(ntohs(a.sin_port));
+        }
+        return fds;
+    }
+
+    // Node `self` connects to the lower-numbered nodes and accepts the
+    // higher ones (connect completes on the listen backlog, so the
+    // order cannot deadlock). Closes every listener it is given.
+    TcpMesh(int self, const std::vector<std::uint16_t>& ports, const std::vector<int>& listeners)
+        : self_(self), peers_(ports.size(), -1) {
+        const int n = int(ports.size());
+        for (int j = 0; j < self; ++j) {
+            const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in a{};
+            a.sin_family = AF_INET;
+            a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            a.sin_port = htons(ports[j]);
+            if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&a), sizeof a) != 0)
+                throw std::system_error(errno, std::generic_category(), "connect");
+            const std::uint32_t me = std::uint32_t(self);
+            writeAll(fd, &me, sizeof me);
+            peers_[j] = fd;
+        }
+        for (int k = self + 1; k < n; ++k) {
+            const int fd = ::accept(listeners[self], nullptr, nullptr);
+            if (fd < 0) throw std::system_error(errno, std::generic_category(), "accept");
+            std::uint32_t who = 0;
+            readAll(fd, &who, sizeof who);
+            if (int(who) <= self || int(who) >= n) throw std::runtime_error("TcpMesh: unexpected peer");
+            peers_[who] = fd;
+        }
+        for (int fd : listeners) ::close(fd);
+        for (int fd : peers_) {
+            if (fd < 0) continue;
+            const int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
+        }
+    }
+
+    TcpMesh(const TcpMesh&) = delete;
+    TcpMesh& operator=(const TcpMesh&) = delete;
+    ~TcpMesh() {
+        for (int fd : peers_)
+            if (fd >= 0) ::close(fd);
+    }
+
+    // out[j] to every peer j; in[j] = the frame j sent (in[self] empty)
+    void exchange(const std::vector<std::string>& out, std::vector<std::string>& in) {
+        const std::size_t n = peers_.size();
+        in.assign(n, std::string());
+        std::vector<std::size_t> sent(n, 0), got(n, 0), want(n, kHeaderBytes);
+        std::vector<bool> done(n, false);
+        for (;;) {
+            std::vector<pollfd> pfds;
+            std::vector<int> who;
+            for (std::size_t j = 0; j < n; ++j) {
+                if (int(j) == self_) continue;
+                short ev = 0;
+                if (sent[j] < out[j].size()) ev |= POLLOUT;
+                if (!done[j]) ev |= POLLIN;
+                if (ev) {
+                    pfds.push_back({peers_[j], ev, 0});
+                    who.push_back(int(j));
+                }
+            }
+            if (pfds.empty()) return;
+            if (::poll(pfds.data(), pfds.size(), -1) < 0) {
+                if (errno == EINTR) continue;
+                throw std::system_error(errno, std::generic_category(), "poll");
+            }
+            for (std::size_t k = 0; k < pfds.size(); ++k) {
+                const int j = who[k];
+                if (pfds[k].revents & POLLOUT) {
+                    const ssize_t w = ::send(peers_[j], out[j].data() + sent[j], out[j].size() - sent[j],
+                                             MSG_DONTWAIT | MSG_NOSIGNAL);
+                    if (w > 0) sent[j] += std::size_t(w);
+                    else if (w < 0 && errno != EAGAIN && errno != EINTR)
+                        throw std::system_error(errno, std::generic_category(), "send");
+                }
+                if (pfds[k].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    std::string& f = in[j];
+                    f.resize(want[j]);
+                    const ssize_t r = ::recv(peers_[j], f.data() + got[j], want[j] - got[j], MSG_DONTWAIT);
+                    if (r == 0) throw std::runtime_error("TcpMesh: peer closed");
+                    if (r < 0) {
+                        if (errno != EAGAIN && errno != EINTR)
+                            throw std::system_error(errno, std::generic_category(), "recv");
+                        continue;
+                    }
+                    got[j] += std::size_t(r);
+                    if (got[j] < want[j]) continue;
+                    if (want[j] == kHeaderBytes) {                   // header complete: now the payload
+                        std::uint32_t bytes;
+                        std::memcpy(&bytes, f.data() + 12, 4);
+                        want[j] += bytes;
+                    }
+                    done[j] = got[j] == want[j];
+                }
+            }
+        }
+    }
+
+private:
+    static void writeAll(int fd, const void* p, std::size_t n) {
+        const char* c = static_cast<const char*>(p);
+        while (n) {
+            const ssize_t w = ::write(fd, c, n);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) throw std::system_error(errno, std::generic_category(), "write");
+            c += w;
+            n -= std::size_t(w);
+        }
+    }
+    static void readAll(int fd, void* p, std::size_t n) {
+        char* c = static_cast<char*>(p);
+        while (n) {
+            const ssize_t r = ::read(fd, c, n);
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) throw std::runtime_error("TcpMesh: handshake failed");
+            c += r;
+            n -= std::size_t(r);
+        }
+    }
+
+    int self_;
+    std::vector<int> peers_;
+};
+
+} // namespace shard
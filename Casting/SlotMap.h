@@ -0,0 +1,140 @@
+// ==========================================================
+// SlotMap.h — dense storage addressed by generational handles
+// ==========================================================
+//
+// entitymanagerPattern.cpp "destroys" an entity by setting
+// isAlive = false. The object stays where it is, so every
+// loop over entities keeps skipping more and more corpses.
+//
+// SLOT MAP:
+//
+//   handles  →  slots[]                   dense[]   (the T objects)
+//   {idx,gen}   [ dense | gen ]           [ T T T T ... ]  ← no holes
+//                                          + denseToSlot[]
+//
+// - create()  : take a slot from the FREE LIST (or append),
+//               push the object at the END of dense[]      O(1)
+// - destroy() : SWAP the object with dense.back(), POP it,
+//               patch the moved object's slot, bump the
+//               slot's generation, push slot on free list   O(1)
+// - get(h)    : slot = slots[h.index]; valid only if
+//               slot.generation == h.generation             O(1)
+//
+// GENERATIONS:
+// A destroyed slot gets a new generation, so old handles to
+// it (and handles to whatever reuses the slot later) can be
+// told apart: get() on a stale handle returns nullptr.
+//
+// ITERATION:
+// begin()/end() walk dense[] directly — only live objects,
+// contiguous. ORDER IS NOT STABLE: destroy() moves the last
+// object into the hole.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+struct Handle {
+    std::uint32_t index = ~0u;
+    std::uint32_t generation = 0;
+
+    friend bool operator==(Handle a, Handle b) {
+        return a.index == b.index && a.generation == b.generation;
+    }
+};
+
+template <typename T>
+class SlotMap {
+public:
+    void reserve(std::size_t n) {
+        slots_.reserve(n);
+        dense_.reserve(n);
+        denseToSlot_.reserve(n);
+    }
+
+    template <typename... Args>
+    Handle create(Args&&... args) {
+        std::uint32_t s;
+        if (freeHead_ != kNone) {
+            s = freeHead_;
+            freeHead_ = slots_[s].dense;         // free slots store "next free" in dense
+        } else {
+            s = (std::uint32_t)slots_.size();
+            slots_.push_back({kNone, 0});
+        }
+        slots_[s].dense = (std::uint32_t)dense_.size();
+        dense_.emplace_back(std::forward<Args>(args)...);
+        denseToSlot_.push_back(s);
+        return {s, slots_[s].generation};
+    }
+
+    // false if h was already stale
+    bool destroy(Handle h) {
+        if (!contains(h)) return false;
+        Slot& slot = slots_[h.index];
+        std::uint32_t hole = slot.dense;
+        std::uint32_t last = (std::uint32_t)dense_.size() - 1;
+        if (hole != last) {
+            dense_[hole] = std::move(dense_[last]);
+            denseToSlot_[hole] = denseToSlot_[last];
+            slots_[denseToSlot_[hole]].dense = hole;
+        }
+        dense_.pop_back();
+        denseToSlot_.pop_back();
+
+        ++slot.generation;                       // invalidate every outstanding handle
+        slot.dense = freeHead_;
+        freeHead_ = h.index;
+        return true;
+    }
+
+    bool contains(Handle h) const {
+        // destroy() bumps the generation, so a free slot never matches
+        return h.index < slots_.size() && slots_[h.index].generation == h.generation;
+    }
+
+    T* get(Handle h) { return contains(h) ? &dense_[slots_[h.index].dense] : nullptr; }
+    const T* get(Handle h) const { return contains(h) ? &dense_[slots_[h.index].dense] : nullptr; }
+
+    // Handle of the object currently at dense position i
+    Handle handleAt(std::size_t i) const {
+        std::uint32_t s = denseToSlot_[i];
+        return {s, slots_[s].generation};
+    }
+
+    std::size_t size() const { return dense_.size(); }
+    bool empty() const { return dense_.empty(); }
+    std::size_t capacitySlots() const { return slots_.size(); }
+
+    T* data() { return dense_.data(); }
+    auto begin() { return dense_.begin(); }
+    auto end() { return dense_.end(); }
+    auto begin() const { return dense_.begin(); }
+    auto end() const { return dense_.end(); }
+
+    void clear() {
+        for (std::uint32_t s : denseToSlot_) {
+            ++slots_[s].generation;
+            slots_[s].dense = freeHead_;
+            freeHead_ = s;
+        }
+        dense_.clear();
+        denseToSlot_.clear();
+    }
+
+private:
+    static constexpr std::uint32_t kNone = ~0u;
+
+    struct Slot {
+        std::uint32_t dense;          // live: index into dense_; free: next free slot
+        std::uint32_t generation;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<T> dense_;
+    std::vector<std::uint32_t> denseToSlot_;
+    std::uint32_t freeHead_ = kNone;
+};
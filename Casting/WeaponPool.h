@@ -0,0 +1,177 @@
+// ==========================================================
+// WeaponPool.h — hot flags in bitsets, names interned, free-list slots
+// ==========================================================
+//
+// freindExample.cpp:
+//
+//     class Weapon {
+//         bool isMounted;               // HOT: read by every filter pass
+//         string name;                  // COLD: 32 bytes, read when printed
+//     };
+//
+// A filter over isMounted loads the whole Weapon — the flag and
+// the string next to it share the cache line — and with one `new`
+// per weapon every Weapon is a line of its own. weaponFilter.cpp's
+// Armory already packs the flags; WeaponPool also gives weapons
+// slots that come and go:
+//
+//   HOT   mounted_[]  1 bit per slot   ─┐ 64 slots per word: what
+//         live_[]     1 bit per slot   ─┘ UnmountedWeapons reads
+//   COLD  nameId_[]   per slot → NameTable (each name stored once)
+//         generation_[], nextFree_[]
+//
+// - allocate(name, mounted): a slot from the FREE LIST (or a new
+//   one), its name interned                                  O(1)
+// - free(h): live bit cleared, generation bumped, slot pushed on
+//   the free list                                            O(1)
+// - handles are SlotMap.h's {index, generation}: a handle to a
+//   freed slot is stale (valid() false, name() empty)
+// - UnmountedWeapons (a friend: the flags stay private) scans 64
+//   slots per word, `live & ~mounted`, one step per HIT, into a
+//   caller buffer of indices
+//
+// Interned names live as long as the pool: freeing a weapon does
+// not free its name (names are few and repeat — "Gun", "Missile").
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "SlotMap.h"
+
+// Each distinct string once; ids are dense from 0
+class NameTable {
+public:
+    std::uint32_t intern(std::string_view s) {
+        auto it = ids_.find(s);
+        if (it != ids_.end()) return it->second;
+        const std::uint32_t id = static_cast<std::uint32_t>(names_.size());
+        names_.emplace_back(s);                      // deque: the views into it stay valid
+        ids_.emplace(names_.back(), id);
+        return id;
+    }
+    const std::string& operator[](std::uint32_t id) const { return names_[id]; }
+    std::size_t size() const { return names_.size(); }
+
+private:
+    std::deque<std::string> names_;
+    std::unordered_map<std::string_view, std::uint32_t> ids_;
+};
+
+class WeaponPool {
+public:
+    void reserve(std::size_t n) {
+        mounted_.reserve((n + 63) / 64);
+        live_.reserve((n + 63) / 64);
+        nameId_.reserve(n);
+        generation_.reserve(n);
+        nextFree_.reserve(n);
+    }
+
+    Handle allocate(std::string_view name, bool mounted) {
+        std::uint32_t s;
+        if (freeHead_ != kNone) {
+            s = freeHead_;
+            freeHead_ = nextFree_[s];
+        } else {
+            s = static_cast<std::uint32_t>(nameId_.size());
+            if (s % 64 == 0) {
+                mounted_.push_back(0);
+                live_.push_back(0);
+            }
+            nameId_.push_back(0);
+            generation_.push_back(0);
+            nextFree_.push_back(kNone);
+        }
+        nameId_[s] = names_.intern(name);
+        setBit(live_, s, true);
+        setBit(mounted_, s, mounted);
+        ++live_count_;
+        return {s, generation_[s]};
+    }
+
+    // A stale handle is ignored
+    void free(Handle h) {
+        if (!valid(h)) return;
+        setBit(live_, h.index, false);
+        ++generation_[h.index];
+        nextFree_[h.index] = freeHead_;
+        freeHead_ = h.index;
+        --live_count_;
+    }
+
+    bool valid(Handle h) const {
+        return h.index < generation_.size() && generation_[h.index] == h.generation && bit(live_, h.index);
+    }
+
+    // Empty for a stale handle
+    const std::string& name(Handle h) const {
+        static const std::string none;
+        return valid(h) ? names_[nameId_[h.index]] : none;
+    }
+    void setMounted(Handle h, bool m) {
+        if (valid(h)) setBit(mounted_, h.index, m);
+    }
+
+    // The live weapon in slot `index` (a result of UnmountedWeapons)
+    Handle handleAt(std::uint32_t index) const { return {index, generation_[index]}; }
+    const std::string& nameAt(std::uint32_t index) const { return names_[nameId_[index]]; }
+
+    std::size_t size() const { return live_count_; }
+    std::size_t slots() const { return nameId_.size(); }
+    std::size_t distinctNames() const { return names_.size(); }
+    // Bytes a scan reads
+    std::size_t hotBytes() const { return (mounted_.size() + live_.size()) * sizeof(std::uint64_t); }
+
+    // out needs room for size() indices; returns how many
+    friend std::size_t UnmountedWeapons(const WeaponPool& pool, std::uint32_t* out);
+    // Just how many (a popcount per word)
+    friend std::size_t CountUnmounted(const WeaponPool& pool);
+
+private:
+    static constexpr std::uint32_t kNone = ~0u;
+
+    static bool bit(const std::vector<std::uint64_t>& v, std::uint32_t i) { return v[i / 64] >> (i % 64) & 1; }
+    static void setBit(std::vector<std::uint64_t>& v, std::uint32_t i, bool on) {
+        const std::uint64_t m = std::uint64_t(1) << (i % 64);
+        v[i / 64] = on ? v[i / 64] | m : v[i / 64] & ~m;
+    }
+
+    // hot
+    std::vector<std::uint64_t> mounted_;
+    std::vector<std::uint64_t> live_;
+    // cold
+    std::vector<std::uint32_t> nameId_;
+    std::vector<std::uint32_t> generation_;
+    std::vector<std::uint32_t> nextFree_;
+    NameTable names_;
+    std::uint32_t freeHead_ = kNone;
+    std::size_t live_count_ = 0;
+};
+
+inline std::size_t UnmountedWeapons(const WeaponPool& pool, std::uint32_t* out) {
+    std::size_t count = 0;
+    const std::size_t words = pool.live_.size();
+    const std::uint64_t* live = pool.live_.data();
+    const std::uint64_t* mounted = pool.mounted_.data();
+    for (std::size_t w = 0; w < words; ++w) {
+        std::uint64_t bits = live[w] & ~mounted[w];
+        while (bits) {
+            out[count++] = static_cast<std::uint32_t>(w * 64 + static_cast<unsigned>(__builtin_ctzll(bits)));
+            bits &= bits - 1;
+        }
+    }
+    return count;
+}
+
+inline std::size_t CountUnmounted(const WeaponPool& pool) {
+    std::size_t count = 0;
+    for (std::size_t w = 0; w < pool.live_.size(); ++w)
+        count += static_cast<std::size_t>(__builtin_popcountll(pool.live_[w] & ~pool.mounted_[w]));
+    return count;
+}
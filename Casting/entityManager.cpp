@@ -0,0 +1,203 @@
+// ==========================================================
+// TOPIC: EntityManager on a Slot Map (Generational Handles)
+// ==========================================================
+//
+// entitymanagerPattern.cpp keeps the Manager–Entity pattern
+// (Entity data is private, EntityManager is its friend), but
+// destroy() only flips a flag:
+//
+//     void destroy(Entity& e) { e.isAlive = false; }
+//
+// → dead entities are never removed, ids are never reused,
+//   and every update loop has to test isAlive on ALL of them.
+//
+// Here EntityManager stores entities in a SlotMap (SlotMap.h):
+// - create()   → O(1), reuses freed slots (free list)
+// - destroy(h) → O(1), swap-and-pop keeps live entities DENSE
+// - get(h)     → nullptr for a destroyed entity, even after
+//                its slot was reused (generation mismatch)
+// - update()   → a plain loop over live entities only
+//
+// The benchmark destroys 50% of the entities and creates as
+// many new ones EVERY FRAME, and compares:
+//   1. the flag-only manager (vector<Entity> + isAlive)
+//   2. the slot-map manager
+//
+// Build:
+//   g++ -std=c++20 -O2 entityManager.cpp -o entitymanager
+//
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "SlotMap.h"
+
+using namespace std;
+using namespace std::chrono;
+
+class Entity {
+private:
+    int id;
+    bool isAlive = true;        // only used by the flag-only manager
+    float x = 0, y = 0, vx = 1, vy = 1;
+
+public:
+    explicit Entity(int id) : id(id), vx((float)(id % 7)), vy((float)(id % 5)) {}
+
+    int getId() const { return id; }
+
+    friend class FlagEntityManager;
+    friend class EntityManager;
+};
+
+// ----------------------------------------------------------
+// 1. entitymanagerPattern.cpp, grown into a container
+// ----------------------------------------------------------
+class FlagEntityManager {
+    vector<Entity> entities;
+
+public:
+    size_t create(int id) {
+        entities.emplace_back(id);
+        return entities.size() - 1;
+    }
+    void destroy(size_t i) { entities[i].isAlive = false; }
+    size_t slots() const { return entities.size(); }
+
+    float update(float dt) {
+        float sum = 0;
+        for (Entity& e : entities) {
+            if (!e.isAlive) continue;           // skip the corpses
+            e.x += e.vx * dt;
+            e.y += e.vy * dt;
+            sum += e.x;
+        }
+        return sum;
+    }
+};
+
+// ----------------------------------------------------------
+// 2. Slot-map manager
+// ----------------------------------------------------------
+class EntityManager {
+    SlotMap<Entity> entities;
+
+public:
+    void reserve(size_t n) { entities.reserve(n); }
+    Handle create(int id) { return entities.create(id); }
+    bool destroy(Handle h) { return entities.destroy(h); }
+    Entity* get(Handle h) { return entities.get(h); }
+    size_t size() const { return entities.size(); }
+    size_t slots() const { return entities.capacitySlots(); }
+
+    float update(float dt) {
+        float sum = 0;
+        for (Entity& e : entities) {            // live entities only, contiguous
+            e.x += e.vx * dt;
+            e.y += e.vy * dt;
+            sum += e.x;
+        }
+        return sum;
+    }
+};
+
+// Destroy a random half of `live`, then create as many new ones
+template <typename Mgr, typename H, typename Create>
+void churn(Mgr& m, vector<H>& live, mt19937& rng, int& nextId, Create create) {
+    size_t half = live.size() / 2;
+    for (size_t k = 0; k < half; ++k) {
+        size_t pick = k + rng() % (live.size() - k);
+        swap(live[k], live[pick]);
+        m.destroy(live[k]);
+    }
+    for (size_t k = 0; k < half; ++k) live[k] = create(m, nextId++);
+}
+
+int main() {
+    // ---- Handle semantics ----
+    {
+        EntityManager m;
+        Handle a = m.create(101);
+        Handle b = m.create(102);
+        m.destroy(a);
+        Handle c = m.create(103);               // reuses a's slot
+        cout << "slot reused: " << (c.index == a.index ? "yes" : "no")
+             << ", stale handle → " << (m.get(a) ? "entity" : "nullptr")
+             << ", b → " << m.get(b)->getId() << ", c → " << m.get(c)->getId() << endl;
+    }
+
+    const int entities = 100000;
+    const int frames = 100;
+    const float dt = 0.016f;
+
+    double flagChurnUs = 0, flagUpdateUs = 0, slotChurnUs = 0, slotUpdateUs = 0;
+    float sink = 0;
+    size_t flagSlots = 0, mapSlots = 0;
+
+    // ---- 1. flag-only ----
+    {
+        FlagEntityManager m;
+        vector<size_t> live;
+        int nextId = 0;
+        for (int i = 0; i < entities; ++i) live.push_back(m.create(nextId++));
+        mt19937 rng(9);
+        for (int f = 0; f < frames; ++f) {
+            auto t0 = steady_clock::now();
+            churn(m, live, rng, nextId, [](FlagEntityManager& mm, int id) { return mm.create(id); });
+            auto t1 = steady_clock::now();
+            sink += m.update(dt);
+            auto t2 = steady_clock::now();
+            flagChurnUs += duration<double, micro>(t1 - t0).count();
+            flagUpdateUs += duration<double, micro>(t2 - t1).count();
+        }
+        flagSlots = m.slots();
+    }
+
+    // ---- 2. slot map ----
+    {
+        EntityManager m;
+        m.reserve(entities);
+        vector<Handle> live;
+        int nextId = 0;
+        for (int i = 0; i < entities; ++i) live.push_back(m.create(nextId++));
+        mt19937 rng(9);
+        for (int f = 0; f < frames; ++f) {
+            auto t0 = steady_clock::now();
+            churn(m, live, rng, nextId, [](EntityManager& mm, int id) { return mm.create(id); });
+            auto t1 = steady_clock::now();
+            sink += m.update(dt);
+            auto t2 = steady_clock::now();
+            slotChurnUs += duration<double, micro>(t1 - t0).count();
+            slotUpdateUs += duration<double, micro>(t2 - t1).count();
+        }
+        mapSlots = m.slots();
+    }
+
+    cout << entities << " live entities, 50% churn/frame, " << frames << " frames" << endl;
+    cout << "flag-only : churn " << flagChurnUs / frames << " us, update "
+         << flagUpdateUs / frames << " us/frame, slots after: " << flagSlots << endl;
+    cout << "slot map  : churn " << slotChurnUs / frames << " us, update "
+         << slotUpdateUs / frames << " us/frame, slots after: " << mapSlots << endl;
+    if (sink == 12345.0f) cout << "";
+    return 0;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A flag-only "destroy" leaks: storage and loop cost grow
+//    with every entity EVER created, not with live ones.
+// 2. Swap-and-pop removes from the middle of an array in O(1)
+//    (order is not preserved).
+// 3. Handles = index + generation. The index makes lookup O(1);
+//    the generation detects use-after-destroy.
+// 4. The free list recycles slots, so the slot table stays
+//    as big as the PEAK live count.
+//
+// ⭐ One-Line Interview Answer
+// “A slot map gives entities O(1) create/destroy through a
+// free list and swap-and-pop, keeps them dense for iteration,
+// and uses generational handles so stale references fail
+// safely.”
@@ -0,0 +1,239 @@
+// ==========================================================
+// TOPIC: Batched Friend Filter over a Contiguous Flag Array
+// ==========================================================
+//
+// freindExample.cpp filters weapons like this:
+//
+//     Weapon** UnmountedWeapons(Weapon** list, int* size) {
+//         Weapon** out = new Weapon*[*size];   // allocation per call
+//         for (...) if (!list[n]->isMounted)   // pointer chase per weapon
+//             out[i++] = list[n];
+//         ...
+//     }
+//
+// Run every tick over thousands of weapons, that is one heap
+// allocation + one cache miss per weapon, per tick.
+//
+// ----------------------------------------------------------
+// Armory: the flags live in ONE contiguous byte array
+// ----------------------------------------------------------
+//
+//   names   : ["Gun", "Missile", "Rocket", "Cannon", ...]
+//   mounted : [  1  ,    0     ,    0    ,    1    , ...]   ← private
+//
+// Friend functions still read the PRIVATE flags, but now:
+//
+//   size_t unmountedIndices(const Armory&, uint32_t* out);
+//       writes the indices into a CALLER-PROVIDED buffer
+//       (no allocation), returns how many were written
+//
+//   void unmountedMask(const Armory&, uint64_t* words);
+//       one bit per weapon (bit set = unmounted)
+//
+// Both scan 32 flags at a time with AVX2 (cmpeq + movemask),
+// with a SWAR (8 flags per 64-bit word) fallback elsewhere.
+//
+// Build:
+//   g++ -std=c++20 -O2 -mavx2 weaponFilter.cpp -o weaponfilter
+//
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+using namespace std::chrono;
+
+// ==========================================================
+// 1. ORIGINAL: array of Weapon pointers
+// ==========================================================
+class Weapon {
+private:
+    bool isMounted;
+
+public:
+    string name;
+
+    Weapon(string desc, bool mounted) : isMounted(mounted), name(desc) {}
+
+    friend Weapon** UnmountedWeapons(Weapon**, int*);
+};
+
+Weapon** UnmountedWeapons(Weapon** weaponList, int* size) {
+    Weapon** unMounted = new Weapon*[*size];
+    int i = 0;
+    for (int n = 0; n < *size; n++)
+        if (!weaponList[n]->isMounted) unMounted[i++] = weaponList[n];
+    *size = i;
+    return unMounted;
+}
+
+// ==========================================================
+// 2. ARMORY: contiguous flags, batch friend filters
+// ==========================================================
+class Armory {
+private:
+    vector<uint8_t> mounted;     // ✅ PRIVATE, 1 byte per weapon
+
+public:
+    vector<string> names;
+
+    void add(string name, bool isMounted) {
+        names.push_back(std::move(name));
+        mounted.push_back(isMounted ? 1 : 0);
+    }
+    size_t size() const { return mounted.size(); }
+
+    // Words needed for unmountedMask()
+    size_t maskWords() const { return (size() + 63) / 64; }
+
+    friend size_t unmountedIndices(const Armory&, uint32_t* out);
+    friend void unmountedMask(const Armory&, uint64_t* words);
+};
+
+// 32-bit mask of unmounted weapons in flags[0..32)
+static inline uint32_t unmountedBits32(const uint8_t* flags) {
+#if defined(__AVX2__)
+    __m256i v = _mm256_loadu_si256((const __m256i*)flags);
+    __m256i zero = _mm256_cmpeq_epi8(v, _mm256_setzero_si256());
+    return (uint32_t)_mm256_movemask_epi8(zero);
+#else
+    // SWAR: flags are 0/1, so invert bit 0 of each byte and use a
+    // multiply to gather the 8 low bits into the top byte
+    uint32_t bits = 0;
+    for (int k = 0; k < 4; ++k) {
+        uint64_t w;
+        memcpy(&w, flags + 8 * k, 8);
+        uint64_t lows = ~w & 0x0101010101010101ull;
+        bits |= (uint32_t)((lows * 0x0102040810204080ull) >> 56) << (8 * k);
+    }
+    return bits;
+#endif
+}
+
+// out must have room for a.size() entries (the worst case)
+size_t unmountedIndices(const Armory& a, uint32_t* out) {
+    const uint8_t* f = a.mounted.data();
+    const size_t n = a.mounted.size();
+    size_t count = 0, i = 0;
+    for (; i + 32 <= n; i += 32) {
+        uint32_t bits = unmountedBits32(f + i);
+        while (bits) {                                 // one step per HIT, not per weapon
+            out[count++] = (uint32_t)(i + __builtin_ctz(bits));
+            bits &= bits - 1;
+        }
+    }
+    for (; i < n; ++i)
+        if (!f[i]) out[count++] = (uint32_t)i;
+    return count;
+}
+
+// words must have room for a.maskWords() entries
+void unmountedMask(const Armory& a, uint64_t* words) {
+    const uint8_t* f = a.mounted.data();
+    const size_t n = a.mounted.size();
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64)
+        words[i / 64] = (uint64_t)unmountedBits32(f + i) |
+                        ((uint64_t)unmountedBits32(f + i + 32) << 32);
+    if (i < n) {
+        uint64_t w = 0;
+        for (size_t k = 0; i + k < n; ++k) w |= (uint64_t)(f[i + k] == 0) << k;
+        words[i / 64] = w;
+    }
+}
+
+int main() {
+    // ---- Same output as freindExample.cpp ----
+    Armory demo;
+    demo.add("Gun", true);
+    demo.add("Missile", false);
+    demo.add("Rocket", false);
+    demo.add("Cannon", true);
+
+    uint32_t idx[4];
+    size_t found = unmountedIndices(demo, idx);
+    cout << "Unmounted Weapons:\n";
+    for (size_t k = 0; k < found; ++k) cout << demo.names[idx[k]] << endl;
+
+    // ---- Per-tick benchmark ----
+    const int weapons = 8192;
+    const int ticks = 20000;
+    mt19937 rng(3);
+
+    Armory armory;
+    vector<Weapon*> list;
+    for (int k = 0; k < weapons; ++k) {
+        bool m = rng() % 4 != 0;                       // ~25% unmounted
+        armory.add("W" + to_string(k), m);
+        list.push_back(new Weapon("W" + to_string(k), m));
+    }
+    shuffle(list.begin(), list.end(), rng);            // heap order ≠ array order
+
+    // Buffers allocated ONCE, reused every tick
+    vector<uint32_t> indexBuf(armory.size());
+    vector<uint64_t> maskBuf(armory.maskWords());
+
+    size_t check1 = 0, check2 = 0, check3 = 0;
+
+    auto t0 = steady_clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        int size = weapons;
+        Weapon** r = UnmountedWeapons(list.data(), &size);
+        check1 += (size_t)size;
+        delete[] r;
+    }
+    double legacyUs = duration<double, micro>(steady_clock::now() - t0).count() / ticks;
+
+    t0 = steady_clock::now();
+    for (int t = 0; t < ticks; ++t) check2 += unmountedIndices(armory, indexBuf.data());
+    double indexUs = duration<double, micro>(steady_clock::now() - t0).count() / ticks;
+
+    t0 = steady_clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        unmountedMask(armory, maskBuf.data());
+        for (uint64_t w : maskBuf) check3 += (size_t)__builtin_popcountll(w);
+    }
+    double maskUs = duration<double, micro>(steady_clock::now() - t0).count() / ticks;
+
+    cout << "\n" << weapons << " weapons, " << ticks << " ticks"
+#if defined(__AVX2__)
+         << " (AVX2)"
+#else
+         << " (scalar)"
+#endif
+         << endl;
+    cout << "UnmountedWeapons (new Weapon*[])  : " << legacyUs << " us/tick" << endl;
+    cout << "unmountedIndices (caller buffer)  : " << indexUs << " us/tick" << endl;
+    cout << "unmountedMask    (bitmask)        : " << maskUs << " us/tick" << endl;
+    cout << "same counts: " << (check1 == check2 && check2 == check3 ? "yes" : "NO") << endl;
+
+    for (Weapon* w : list) delete w;
+    return check1 == check2 && check2 == check3 ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. friend is about ACCESS, not layout: the friend filter
+//    can read private flags that are stored contiguously.
+// 2. Let the caller own the output buffer → zero allocations
+//    on the hot path, and no ownership question about the
+//    returned array (the original leaks it).
+// 3. Return INDICES or a BITMASK instead of pointers: small,
+//    contiguous, and usable to index any parallel array.
+// 4. Byte flags in one array can be tested 32 at a time.
+//
+// ⭐ One-Line Interview Answer
+// “Keep the private flags in one contiguous array and let the
+// friend filter write indices into a caller buffer, so each
+// tick is a SIMD scan with no allocation or pointer chasing.”
@@ -0,0 +1,233 @@
+// ==========================================================
+// TOPIC: Hot/Cold Splitting — Scanning Flags, Not Weapons
+// ==========================================================
+//
+// freindExample.cpp:
+//
+//     class Weapon { bool isMounted; string name; ... };   // 40 bytes
+//     if (!weaponList[n]->isMounted) ...                    // per weapon
+//
+// ❌ the 1-byte flag the filter wants sits next to a 32-byte
+//    string it never reads: every weapon scanned costs a 40-byte
+//    slice of a cache line, and with one `new Weapon` each, a
+//    line (and a likely miss) of its own
+//
+// ✅ WeaponPool.h: `mounted` and `live` as bitsets (64 weapons per
+//    word), names interned in a NameTable, slots recycled through
+//    a free list with generational handles; UnmountedWeapons reads
+//    the bitsets only
+//
+// Measured here, for 1K .. `max` weapons (25% unmounted), after
+// churn (10% freed and re-allocated, so the pool reuses slots):
+//   1. ns per weapon for a filter pass, and the scan bandwidth:
+//      bytes the pass has to read (hot bytes) per ns
+//        Weapon* + new per weapon   (the original, shuffled heap)
+//        vector<Weapon>             (same struct, contiguous)
+//        WeaponPool                 (bitsets; and CountUnmounted,
+//                                    the scan without the indices)
+//   2. cache misses per pass (PerfCounters.h; "n/a" where the
+//      machine exposes no hardware counters)
+//   3. results identical; stale handles rejected; names interned
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./weaponpool [max weapons]     (default 1048576, at least 1024)
+//
+// Build:
+//   g++ -std=c++20 -O2 weaponPool.cpp -o weaponpool
+//
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Benchmarks/PerfCounters.h"
+#include "WeaponPool.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ---- freindExample.cpp's Weapon, with a friend for each layout ----
+class Weapon {
+private:
+    bool isMounted;
+
+public:
+    string name;
+
+    Weapon(string desc, bool mounted) : isMounted(mounted), name(desc) {}
+
+    friend size_t unmountedByPointer(Weapon* const* list, size_t n, uint32_t* out);
+    friend size_t unmountedInPlace(const Weapon* list, size_t n, uint32_t* out);
+};
+
+// The original loop, writing into a caller buffer (as in
+// weaponFilter.cpp) so only the layout differs
+size_t unmountedByPointer(Weapon* const* list, size_t n, uint32_t* out) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i)
+        if (!list[i]->isMounted) out[count++] = uint32_t(i);
+    return count;
+}
+
+size_t unmountedInPlace(const Weapon* list, size_t n, uint32_t* out) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i)
+        if (!list[i].isMounted) out[count++] = uint32_t(i);
+    return count;
+}
+
+const char* const kNames[] = {"Gun", "Missile", "Rocket", "Cannon", "Laser", "Railgun", "Mortar", "Flak"};
+
+struct Timing {
+    double nsPerWeapon;
+    double bytesPerNs;
+    double missesPerPass;       // < 0: unavailable
+    size_t found;
+};
+
+template <typename F>
+Timing measure(size_t weapons, size_t hotBytes, F&& pass) {
+    const int passes = int(max<size_t>(3, (64u << 20) / max<size_t>(weapons, 1)));      // ~64M weapons in all
+    size_t found = pass();                                                                // warm
+    PerfCounters pmu({{"cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES}});
+    pmu.start();
+    const auto t0 = steady_clock::now();
+    for (int p = 0; p < passes; ++p) found = pass();
+    const double ns = duration<double, nano>(steady_clock::now() - t0).count();
+    const double misses = pmu.stop().value("cache-misses");
+    return {ns / passes / double(weapons), double(hotBytes) * passes / ns, misses < 0 ? -1 : misses / passes, found};
+}
+
+int main(int argc, char** argv) {
+    const long maxWeapons = argc > 1 ? atol(argv[1]) : 1 << 20;
+    if (maxWeapons < 1024) {
+        cerr << "usage: weaponpool [max weapons >= 1024]" << endl;
+        return 2;
+    }
+    bool ok = true;
+
+    // ---- Same output as freindExample.cpp ----
+    {
+        WeaponPool demo;
+        demo.allocate("Gun", true);
+        demo.allocate("Missile", false);
+        demo.allocate("Rocket", false);
+        demo.allocate("Cannon", true);
+        uint32_t idx[4];
+        const size_t n = UnmountedWeapons(demo, idx);
+        cout << "Unmounted Weapons:\n";
+        for (size_t k = 0; k < n; ++k) cout << demo.nameAt(idx[k]) << endl;
+        ok = ok && n == 2;
+    }
+    cout << endl
+         << "sizeof(Weapon) = " << sizeof(Weapon) << " bytes; WeaponPool reads 2 bits per weapon" << endl
+         << endl;
+
+    cout << left << setw(10) << "weapons" << setw(22) << "layout" << right << setw(10) << "ns/weapon" << setw(14)
+         << "hot bytes" << setw(10) << "GB/s" << setw(14) << "misses/pass" << endl;
+    for (size_t n = 1024; n <= size_t(maxWeapons); n *= 4) {
+        mt19937 rng(static_cast<uint32_t>(n));
+        vector<bool> mounted(n);
+        for (size_t i = 0; i < n; ++i) mounted[i] = rng() % 4 != 0;
+
+        // the original: one new each, in allocation order ≠ list order
+        vector<Weapon*> byPointer(n);
+        vector<uint8_t> flags(n);                                   // list slot i's isMounted
+        {
+            vector<Weapon*> heap;
+            for (size_t i = 0; i < n; ++i) heap.push_back(new Weapon(kNames[i % 8], mounted[i]));
+            vector<size_t> order(n);
+            for (size_t i = 0; i < n; ++i) order[i] = i;
+            shuffle(order.begin(), order.end(), rng);
+            for (size_t i = 0; i < n; ++i) {
+                byPointer[i] = heap[order[i]];                      // list slot i → a random heap spot
+                flags[i] = mounted[order[i]];
+            }
+        }
+        // the same weapons, in list order, for the other two layouts
+        vector<Weapon> inPlace;
+        WeaponPool pool;
+        pool.reserve(n);
+        vector<Handle> handles;
+        inPlace.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            inPlace.emplace_back(byPointer[i]->name, flags[i] != 0);
+            handles.push_back(pool.allocate(byPointer[i]->name, flags[i] != 0));
+        }
+        // churn: free 10% of the pool's weapons and allocate them again
+        // (LIFO free list: each comes back in a slot freed just before)
+        vector<size_t> victims;
+        for (size_t i = 0; i < n / 10; ++i) victims.push_back(rng() % n);
+        sort(victims.begin(), victims.end());
+        victims.erase(unique(victims.begin(), victims.end()), victims.end());
+        for (size_t v : victims) pool.free(handles[v]);
+        for (size_t v : victims) ok = ok && !pool.valid(handles[v]) && pool.name(handles[v]).empty();
+        for (size_t k = victims.size(); k-- > 0;) {
+            const size_t v = victims[k];
+            handles[v] = pool.allocate(byPointer[v]->name, flags[v] != 0);
+            ok = ok && handles[v].index == v;                          // same slot, new generation
+        }
+        ok = ok && pool.slots() == n && pool.size() == n && pool.distinctNames() == 8;
+
+        vector<uint32_t> out(n);
+        const Timing a = measure(n, n * sizeof(Weapon) + n * sizeof(Weapon*),
+                                 [&] { return unmountedByPointer(byPointer.data(), n, out.data()); });
+        vector<uint32_t> want(out.begin(), out.begin() + long(a.found));
+        const Timing b = measure(n, n * sizeof(Weapon),
+                                 [&] { return unmountedInPlace(inPlace.data(), n, out.data()); });
+        const bool sameB = b.found == a.found && equal(want.begin(), want.end(), out.begin());
+        const Timing c = measure(n, pool.hotBytes(), [&] { return UnmountedWeapons(pool, out.data()); });
+        const bool sameC = c.found == a.found && equal(want.begin(), want.end(), out.begin());
+        const Timing d = measure(n, pool.hotBytes(), [&] { return CountUnmounted(pool); });
+        ok = ok && d.found == a.found;
+        ok = ok && sameB && sameC;
+
+        auto row = [&](const char* name, const Timing& t, size_t hot) {
+            cout << left << setw(10) << n << setw(22) << name << right << fixed << setprecision(3) << setw(10)
+                 << t.nsPerWeapon << setw(14) << hot << setprecision(1) << setw(10) << t.bytesPerNs;
+            if (t.missesPerPass < 0) cout << setw(14) << "n/a";
+            else cout << setw(14) << setprecision(0) << t.missesPerPass;
+            cout << endl;
+            cout.unsetf(ios::fixed);
+        };
+        row("Weapon* (new each)", a, n * (sizeof(Weapon) + sizeof(Weapon*)));
+        row("vector<Weapon>", b, n * sizeof(Weapon));
+        row("WeaponPool bitsets", c, pool.hotBytes());
+        row("  CountUnmounted", d, pool.hotBytes());
+        cout << setw(10) << "" << "bitsets vs Weapon*: x" << fixed << setprecision(1) << a.nsPerWeapon / c.nsPerWeapon
+             << endl;
+        cout.unsetf(ios::fixed);
+        for (Weapon* w : byPointer) delete w;
+    }
+
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. A loop pays for every byte on the cache lines it touches,
+//    not for the fields it reads: a bool next to a string costs
+//    the string's share of the line.
+// 2. Split by access: hot fields (scanned every pass) in dense
+//    arrays or bitsets, cold ones (names) elsewhere, joined by
+//    the slot index.
+// 3. A free list makes allocate/free O(1) and keeps the arrays
+//    dense; generations make stale handles detectable.
+// 4. Interning stores each distinct string once: an id per
+//    object instead of 32 bytes.
+//
+// ⭐ One-Line Interview Answer
+// “Move the hot flag out of the object: keep isMounted as a bitset
+// indexed by slot, names interned in a side table, slots recycled by
+// a free list — the filter reads 2 bits per weapon instead of a
+// 40-byte object behind a pointer.”
@@ -0,0 +1,190 @@
+// ==========================================================
+// ActionSink.h — where Person's "is walking" lines go
+// ==========================================================
+//
+// Person.cpp:
+//
+//     void Person::Walk() { cout << "Person is walking." << endl; }
+//
+// Every action is formatted, written AND flushed (endl) on the
+// spot: one write(2) per call. With millions of simulated
+// people that synchronous I/O is the whole hot path.
+//
+// A Person now reports a PersonAction (one byte) to the sink it
+// was constructed with:
+//
+//   - StreamSink   the original behaviour: one line + endl per
+//                  action (ActionSink::console() is the default)
+//   - NullSink     drops everything (pure simulation runs)
+//   - RingSink     keeps the last N actions in memory, plus a
+//                  count per action (inspection, tests)
+//   - BatchedFileSink
+//                  queues actions and writes them with writev():
+//                  one iovec per line pointing at the constant
+//                  text, up to IOV_MAX lines per system call, no
+//                  formatting and no copying
+//
+// Sinks are not thread-safe: one sink per simulation thread.
+//
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include <sys/uio.h>
+
+enum class PersonAction : std::uint8_t { Created, Crawl, Run, Stand, Walk, Destroyed };
+
+inline constexpr std::size_t kPersonActionCount = 6;
+
+// The exact lines Person.cpp used to print, newline included
+inline constexpr std::string_view personActionLine(PersonAction a) {
+    constexpr std::array<std::string_view, kPersonActionCount> lines{
+        "Person created.\n",    "Person is crawling.\n", "Person is running.\n",
+        "Person is standing.\n", "Person is walking.\n",  "Person destroyed.\n",
+    };
+    return lines[static_cast<std::size_t>(a)];
+}
+
+class ActionSink {
+public:
+    virtual void record(PersonAction a) = 0;
+    virtual void flush() {}
+    virtual ~ActionSink() = default;
+
+    // Process-wide default: what Person always did (cout + endl)
+    static ActionSink& console();
+};
+
+class NullSink final : public ActionSink {
+public:
+    void record(PersonAction) override {}
+};
+
+class StreamSink final : public ActionSink {
+public:
+    explicit StreamSink(std::ostream& os) : os_(os) {}
+
+    void record(PersonAction a) override {
+        std::string_view line = personActionLine(a);
+        os_.write(line.data(), static_cast<std::streamsize>(line.size() - 1)) << std::endl;
+    }
+    void flush() override { os_.flush(); }
+
+private:
+    std::ostream& os_;
+};
+
+inline ActionSink& ActionSink::console() {
+    static StreamSink sink(std::cout);
+    return sink;
+}
+
+class RingSink final : public ActionSink {
+public:
+    explicit RingSink(std::size_t capacity) : ring_(capacity == 0 ? 1 : capacity) {}
+
+    void record(PersonAction a) override {
+        ring_[recorded_ % ring_.size()] = a;
+        ++recorded_;
+        ++counts_[static_cast<std::size_t>(a)];
+    }
+
+    std::uint64_t recorded() const { return recorded_; }
+    std::uint64_t count(PersonAction a) const { return counts_[static_cast<std::size_t>(a)]; }
+
+    // The retained actions, oldest first
+    std::vector<PersonAction> recent() const {
+        std::size_t n = recorded_ < ring_.size() ? static_cast<std::size_t>(recorded_) : ring_.size();
+        std::vector<PersonAction> out;
+        out.reserve(n);
+        for (std::uint64_t i = recorded_ - n; i < recorded_; ++i) out.push_back(ring_[i % ring_.size()]);
+        return out;
+    }
+
+private:
+    std::vector<PersonAction> ring_;
+    std::uint64_t recorded_ = 0;
+    std::array<std::uint64_t, kPersonActionCount> counts_{};
+};
+
+// Writes to fd (does not own it). Output is byte-identical to
+// StreamSink's; it just leaves in batches. flush() (and the
+// destructor) write out whatever is queued.
+class BatchedFileSink final : public ActionSink {
+public:
+    explicit BatchedFileSink(int fd, std::size_t batchLines = 4096) : fd_(fd), batch_(batchLines == 0 ? 1 : batchLines) {
+        pending_.reserve(batch_);
+    }
+
+    BatchedFileSink(const BatchedFileSink&) = delete;
+    BatchedFileSink& operator=(const BatchedFileSink&) = delete;
+
+    ~BatchedFileSink() override {
+        try {
+            flush();
+        } catch (const std::system_error&) {
+            // nowhere left to report a failed final write
+        }
+    }
+
+    void record(PersonAction a) override {
+        pending_.push_back(a);
+        if (pending_.size() >= batch_) flush();
+    }
+
+    void flush() override {
+        constexpr std::size_t kMaxIov = IOV_MAX;
+        std::size_t done = 0;
+        iovec iov[kMaxIov];
+        while (done < pending_.size()) {
+            std::size_t n = 0;
+            for (; n < kMaxIov && done + n < pending_.size(); ++n) {
+                std::string_view line = personActionLine(pending_[done + n]);
+                iov[n].iov_base = const_cast<char*>(line.data());
+                iov[n].iov_len = line.size();
+            }
+            writeAll(iov, n);
+            done += n;
+        }
+        pending_.clear();
+    }
+
+    std::uint64_t syscalls() const { return syscalls_; }
+
+private:
+    // writev may stop part-way through an iovec: resume there
+    void writeAll(iovec* iov, std::size_t n) {
+        while (n > 0) {
+            ssize_t w = ::writev(fd_, iov, static_cast<int>(n));
+            ++syscalls_;
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                pending_.clear();
+                throw std::system_error(errno, std::generic_category(), "BatchedFileSink: writev");
+            }
+            std::size_t left = static_cast<std::size_t>(w);
+            while (n > 0 && left >= iov->iov_len) {
+                left -= iov->iov_len;
+                ++iov;
+                --n;
+            }
+            if (n > 0) {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+                iov->iov_len -= left;
+            }
+        }
+    }
+
+    const int fd_;
+    const std::size_t batch_;
+    std::vector<PersonAction> pending_;
+    std::uint64_t syscalls_ = 0;
+};
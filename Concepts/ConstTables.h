@@ -0,0 +1,148 @@
+// ==========================================================
+// ConstTables.h — objects and registries built by the COMPILER
+// ==========================================================
+//
+// convertingConstructor.cpp, memberinialiser.cpp / this.cpp,
+// Encapsulation.cpp, structure.cpp:
+//
+//     Conversion(int value) : a(value) { cout << "..."; }   // prints
+//     MyClass(int val) : x(val) {}                          // not constexpr
+//     class Marker { void setPassmark(int); ... };          // setter only
+//     struct myStruct { int x, y, z; int sum(); };
+//
+// None of these constructors is constexpr, so a global table of
+// them
+//
+//     const Setting kSettings[] = {{1, 25, 5, ...}, ...};
+//
+// is filled by a DYNAMIC initializer before main: code that runs
+// (and dirties pages) at every start, in an order across TUs
+// nobody controls. Here the same types have constexpr
+// constructors:
+//
+//   Conversion c = 25;                      // silent, constexpr
+//   Conversion t(25, Trace::On);            // the original's print,
+//                                           // run-time only
+//   MyClass m(5);   Marker p(40);   myStruct s{10, 20, 40};
+//
+// and ConstRegistry<T, N> turns a std::array of entries (T has
+// `constexpr key() const`), or a generator make(i), into a sorted
+// table with binary-search find(), entirely at compile time:
+//
+//   constinit const ConstRegistry<Setting, 3> kSettings{{{s1, s2, s3}}};
+//   constinit const ConstRegistry<Setting, 100000> kBig{[](std::size_t i) { return settingFor(i); }};
+//   const Setting* s = kSettings.find(42);
+//
+// constinit makes it a compile error if anything would need a
+// dynamic initializer. The result is plain data in .rodata: no
+// code before main, and pages come in from the executable only
+// when touched.
+//
+// - duplicate keys: std::invalid_argument — a compile error when
+//   the registry is built in a constant expression
+// - big tables: every constexpr step counts against the
+//   compiler's limit (GCC: -fconstexpr-ops-limit, 2^25). Build
+//   them with the generator (no array copy) and in key order:
+//   the sort is then one O(n) check. 10^5 entries compile in a
+//   few seconds that way; unsorted input that large needs the
+//   limit raised.
+//
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Whether a constructor reports itself (the originals always did)
+enum class Trace { Off, On };
+
+// convertingConstructor.cpp
+class Conversion {
+private:
+    int a = 0;
+
+public:
+    // Still a converting constructor: Conversion c = 25;
+    constexpr Conversion(int value = 0, Trace trace = Trace::Off) : a(value) {
+        if (trace == Trace::On) std::cout << "Converting constructor called, a = " << a << std::endl;
+    }
+    constexpr int value() const { return a; }
+};
+
+// memberinialiser.cpp / this.cpp
+class MyClass {
+    int x = 0;
+
+public:
+    constexpr MyClass(int val = 0) : x(val) {}
+    constexpr int getX() const { return x; }
+};
+
+// Encapsulation.cpp
+class Marker {
+private:
+    int passmark = 0;
+
+public:
+    constexpr Marker(int mark = 0) : passmark(mark) {}
+    constexpr void setPassmark(int mark) { passmark = mark; }
+    constexpr int getPassmark() const { return passmark; }
+};
+
+// structure.cpp (an aggregate is constexpr-capable already)
+struct myStruct {
+    int x = 0;
+    int y = 0;
+    int z = 0;
+    constexpr int sum() const { return x + y + z; }
+};
+
+template <class T>
+concept Keyed = requires(const T& t) { t.key() < t.key(); };
+
+template <Keyed T, std::size_t N>
+class ConstRegistry {
+public:
+    using key_type = decltype(std::declval<const T&>().key());
+
+    constexpr explicit ConstRegistry(std::array<T, N> entries) : e_(std::move(entries)) { index(); }
+
+    // Entry i = make(i), built in place (no array copy: cheaper
+    // for big tables in constant evaluation)
+    template <class Make>
+        requires std::is_invocable_r_v<T, Make, std::size_t>
+    constexpr explicit ConstRegistry(Make make) {
+        for (std::size_t i = 0; i < N; ++i) e_[i] = make(i);
+        index();
+    }
+
+    // nullptr when absent
+    constexpr const T* find(const key_type& k) const {
+        auto it = std::lower_bound(e_.begin(), e_.end(), k,
+                                   [](const T& x, const key_type& key) { return x.key() < key; });
+        return it != e_.end() && !(k < it->key()) ? &*it : nullptr;
+    }
+
+    static constexpr std::size_t size() { return N; }
+    constexpr const T& operator[](std::size_t i) const { return e_[i]; }
+    constexpr const T* begin() const { return e_.data(); }
+    constexpr const T* end() const { return e_.data() + N; }
+
+private:
+    // Sort by key unless already in order, reject duplicates
+    constexpr void index() {
+        auto byKey = [](const T& x, const T& y) { return x.key() < y.key(); };
+        std::size_t i = 1;
+        while (i < N && byKey(e_[i - 1], e_[i])) ++i;
+        if (i == N) return;
+        std::sort(e_.begin(), e_.end(), byKey);
+        for (i = 1; i < N; ++i)
+            if (!byKey(e_[i - 1], e_[i])) throw std::invalid_argument("ConstRegistry: duplicate key");
+    }
+
+    std::array<T, N> e_{};
+};
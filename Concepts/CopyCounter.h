@@ -0,0 +1,78 @@
+// ==========================================================
+// CopyCounter.h — count copies, moves and elisions
+// ==========================================================
+//
+// Put a CopyCounter member inside any class:
+//
+//     class MyClass {
+//         CopyCounter counter;      // rule of zero: the class's
+//         std::vector<int> data;    // defaulted copy/move ops
+//     };                            // call CopyCounter's ones
+//
+// Then wrap a call site in a CopyProbe to see exactly what it did:
+//
+//     CopyProbe probe("DoSomething(obj)");
+//     obj2.DoSomething(obj1);
+//     probe.report();   // → copies=1 moves=0
+//
+// ELISION: when the compiler constructs an object directly in
+// its final place (RVO / NRVO / guaranteed elision) NEITHER a copy
+// NOR a move runs — a probe showing 0 copies and 0 moves for a
+// by-value return proves the value was elided.
+//
+#pragma once
+
+#include <cstdio>
+
+struct CopyStats {
+    long long constructions = 0;   // default / value constructions
+    long long copies = 0;          // copy constructor
+    long long moves = 0;           // move constructor
+    long long copyAssigns = 0;
+    long long moveAssigns = 0;
+};
+
+class CopyCounter {
+public:
+    static CopyStats& stats() {
+        static CopyStats s;
+        return s;
+    }
+
+    CopyCounter() { ++stats().constructions; }
+    CopyCounter(const CopyCounter&) { ++stats().copies; }
+    CopyCounter(CopyCounter&&) noexcept { ++stats().moves; }
+    CopyCounter& operator=(const CopyCounter&) {
+        ++stats().copyAssigns;
+        return *this;
+    }
+    CopyCounter& operator=(CopyCounter&&) noexcept {
+        ++stats().moveAssigns;
+        return *this;
+    }
+};
+
+// Snapshot of the counters around one call site
+class CopyProbe {
+public:
+    explicit CopyProbe(const char* label) : label_(label), before_(CopyCounter::stats()) {}
+
+    CopyStats delta() const {
+        const CopyStats& now = CopyCounter::stats();
+        return {now.constructions - before_.constructions, now.copies - before_.copies,
+                now.moves - before_.moves, now.copyAssigns - before_.copyAssigns,
+                now.moveAssigns - before_.moveAssigns};
+    }
+
+    void report() const {
+        CopyStats d = delta();
+        std::printf("%-44s copy-ctor=%lld move-ctor=%lld copy-assign=%lld move-assign=%lld%s\n", label_, d.copies,
+                    d.moves, d.copyAssigns, d.moveAssigns,
+                    (d.copies + d.moves + d.copyAssigns + d.moveAssigns) == 0 ? "  (elided/none)"
+                                                                              : "");
+    }
+
+private:
+    const char* label_;
+    CopyStats before_;
+};
@@ -0,0 +1,87 @@
+// ==========================================================
+// CowHandle.h — copy-on-write handle: copies share, writes clone
+// ==========================================================
+//
+// deepCopyExample.cpp:
+//
+//     DeepClass(const DeepClass& c) {
+//         this->value = new Data(c.value->data);   // every copy allocates
+//     }                                             // (and nothing deletes)
+//
+// Most copies are only ever READ, yet each one paid for its own
+// Data. A CowHandle<T> shares ONE immutable payload instead:
+//
+//     CowHandle<Data> a(0);
+//     CowHandle<Data> b = a;        // one atomic increment, no new
+//     b.read().data;                // still a's payload
+//     b.mutate().data = 25;         // shared → clone first, then write
+//     b.mutate().data = 26;         // sole owner now → writes in place
+//
+// - payload = { atomic refcount, T } in ONE allocation
+// - copy: refcount + 1 (relaxed: the source already keeps it alive)
+// - mutate(): if the count is 1 this handle is the ONLY owner —
+//   nobody else can add a reference, so it writes in place; else
+//   it clones T into a fresh payload and drops the shared one
+// - destruction: the last handle (count 1 → 0) deletes it
+//
+// Handles may be copied and destroyed from any thread; one
+// handle must not be mutated while another thread uses that
+// same handle (as for any object).
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+template <typename T>
+class CowHandle {
+    struct Payload {
+        std::atomic<long> refs;
+        T value;
+
+        template <typename... Args>
+        explicit Payload(Args&&... args) : refs(1), value(std::forward<Args>(args)...) {}
+    };
+
+public:
+    template <typename... Args>
+    explicit CowHandle(Args&&... args) : p_(new Payload(std::forward<Args>(args)...)) {}
+
+    CowHandle(const CowHandle& o) noexcept : p_(o.p_) {
+        if (p_) p_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    CowHandle(CowHandle&& o) noexcept : p_(std::exchange(o.p_, nullptr)) {}
+    CowHandle& operator=(CowHandle o) noexcept {      // copy-and-swap covers both
+        std::swap(p_, o.p_);
+        return *this;
+    }
+    ~CowHandle() { release(p_); }
+
+    // Never clones; valid until the next mutate() on this handle
+    const T& read() const { return p_->value; }
+    const T* operator->() const { return &p_->value; }
+
+    // Clones only when the payload is shared
+    T& mutate() {
+        if (p_->refs.load(std::memory_order_acquire) != 1) {
+            Payload* own = new Payload(std::as_const(p_->value));
+            release(std::exchange(p_, own));
+        }
+        return p_->value;
+    }
+
+    bool unique() const { return p_ && p_->refs.load(std::memory_order_acquire) == 1; }
+    long use_count() const { return p_ ? p_->refs.load(std::memory_order_relaxed) : 0; }
+    bool shares_with(const CowHandle& o) const { return p_ == o.p_; }
+
+    // Bytes one payload occupies (what a clone allocates)
+    static constexpr std::size_t payload_bytes = sizeof(Payload);
+
+private:
+    static void release(Payload* p) {
+        if (p && p->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete p;
+    }
+
+    Payload* p_;
+};
@@ -0,0 +1,231 @@
+// ==========================================================
+// EnumReflect.h — compile-time enum names, O(1) both ways
+// ==========================================================
+//
+// enum.cpp shows `enum Color { RED, GREEN, BLUE }` and
+// `enum class State { RUNNING, WAITING, STOPPED }`. Turning them
+// into text and back is usually written by hand:
+//
+//     if (s == "RUNNING") return State::RUNNING;       // chain of
+//     else if (s == "WAITING") ...                     // compares
+//
+//     static const std::map<std::string, State> m{...};   // tree walk
+//                                                         // + heap init
+//
+// EnumReflect derives everything from the enum itself, at
+// compile time:
+//
+//     enumName(State::WAITING)           → "WAITING"       (table index)
+//     enumFromString<State>("STOPPED")   → State::STOPPED  (perfect hash
+//                                                           + one compare)
+//     for (State s : enumValues<State>()) ...              (declared values)
+//     enumCount<State>                   → 3
+//
+// How: __PRETTY_FUNCTION__ of `template <auto V> f()` spells
+// the enumerator ("State::RUNNING"), or a cast ("(State)7") for a
+// value with no name. Every value in EnumRange<E> is probed
+// this way at compile time; the named ones become the tables.
+// All tables are constexpr data — no static initialisation, no
+// allocation.
+//
+// from_string: each name is hashed with a seed found at compile
+// time so that no two names share a slot; a lookup is one hash
+// of the token (length + three sampled bytes when that separates
+// the names, every byte otherwise), one length check and one
+// memcmp.
+//
+// Limits:
+//   - values must lie in EnumRange<E> (default 0..127);
+//     specialise it for others:
+//         template <> struct EnumRange<ErrorCode> { static constexpr int min = 0, max = 511; };
+//   - an unscoped enum without a fixed underlying type
+//     (`enum Color { ... }`) only has the values of its smallest
+//     bit-field (Color: 0..3), and casting anything else to it is
+//     not a constant expression: such enums must specialise
+//     EnumRange with bounds inside that range (a static_assert
+//     says so otherwise)
+//   - aliases (two names, one value) reflect as the first name
+//   - GCC/Clang only (__PRETTY_FUNCTION__ format)
+//
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+template <typename E>
+struct EnumRange {
+    static constexpr int min = 0;
+    static constexpr int max = 127;
+    static constexpr bool isDefault = true;
+};
+
+namespace enum_reflect_detail {
+
+// Enum class, or `enum E : T`: every value of the underlying type
+// is a value of E (list-initialisation from it is allowed)
+template <typename E>
+concept FixedUnderlying = requires { E{std::underlying_type_t<E>{}}; };
+
+template <typename E>
+concept DefaultRange = requires { EnumRange<E>::isDefault; };
+
+template <auto V>
+constexpr std::string_view prettyName() {
+    return __PRETTY_FUNCTION__;
+}
+
+// "... [with auto V = ns::State::RUNNING; ...]" → "RUNNING",
+// "... [with auto V = (State)7; ...]" → ""
+constexpr std::string_view parseName(std::string_view pretty) {
+    std::size_t begin = pretty.find("V = ");
+    if (begin == std::string_view::npos) return {};
+    begin += 4;
+    std::size_t end = pretty.find_first_of(";]", begin);
+    std::string_view full = pretty.substr(begin, end - begin);
+    if (full.empty() || full.front() == '(' || (full.front() >= '0' && full.front() <= '9') || full.front() == '-')
+        return {};
+    std::size_t colon = full.rfind(':');
+    return colon == std::string_view::npos ? full : full.substr(colon + 1);
+}
+
+// The name copied out of the function's string, so the table
+// does not depend on how the compiler stores __PRETTY_FUNCTION__
+template <auto V>
+struct NameOf {
+    static constexpr std::string_view parsed = parseName(prettyName<V>());
+    static constexpr auto storage = [] {
+        std::array<char, parsed.size() + 1> chars{};
+        for (std::size_t i = 0; i < parsed.size(); ++i) chars[i] = parsed[i];
+        return chars;
+    }();
+    static constexpr std::string_view value{storage.data(), parsed.size()};
+};
+
+template <typename E, int Lo, int... I>
+constexpr auto namesByOffset(std::integer_sequence<int, I...>) {
+    return std::array<std::string_view, sizeof...(I)>{NameOf<static_cast<E>(Lo + I)>::value...};
+}
+
+// Quick: length and three sampled bytes, multiplied by a seeded
+// odd constant (no loop over the token). Full: every byte, for
+// name sets whose samples collide.
+constexpr std::uint64_t hashName(std::string_view s, std::uint64_t seed, bool quick) {
+    if (quick) {
+        std::uint64_t key = 0;
+        if (!s.empty()) {
+            key = s.size() | std::uint64_t(static_cast<unsigned char>(s[0])) << 8 |
+                  std::uint64_t(static_cast<unsigned char>(s[s.size() / 2])) << 16 |
+                  std::uint64_t(static_cast<unsigned char>(s[s.size() - 1])) << 24;
+        }
+        return (key * ((seed * 2 + 1) * 0x9E3779B97F4A7C15ull)) >> 32;
+    }
+    std::uint64_t h = seed ^ (s.size() * 0x9E3779B97F4A7C15ull);
+    for (char c : s) h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+    return h ^ (h >> 29);
+}
+
+template <typename E>
+struct EnumInfo {
+    static_assert(std::is_enum_v<E>, "EnumReflect: E must be an enum");
+    static constexpr int lo = EnumRange<E>::min;
+    static constexpr int hi = EnumRange<E>::max;
+    static_assert(lo <= hi && hi - lo < 4096, "EnumReflect: EnumRange too wide");
+    static_assert(FixedUnderlying<E> || !DefaultRange<E>,
+                  "EnumReflect: an enum without a fixed underlying type needs an EnumRange inside its value range");
+
+    static constexpr auto byOffset = namesByOffset<E, lo>(std::make_integer_sequence<int, hi - lo + 1>{});
+
+    static constexpr std::size_t count = [] {
+        std::size_t n = 0;
+        for (std::string_view s : byOffset) n += !s.empty();
+        return n;
+    }();
+
+    static constexpr std::array<E, count> values = [] {
+        std::array<E, count> out{};
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < byOffset.size(); ++i)
+            if (!byOffset[i].empty()) out[n++] = static_cast<E>(lo + static_cast<int>(i));
+        return out;
+    }();
+
+    static constexpr std::array<std::string_view, count> names = [] {
+        std::array<std::string_view, count> out{};
+        std::size_t n = 0;
+        for (std::string_view s : byOffset)
+            if (!s.empty()) out[n++] = s;
+        return out;
+    }();
+
+    // Smallest power-of-two table (>= 2 slots per name) with a
+    // collision-free seed among the first few hundred; the quick
+    // hash if a table up to 32x that size works for it
+    struct Hash {
+        std::size_t size;
+        std::uint64_t seed;
+        bool quick;
+    };
+    static constexpr bool collisionFree(std::size_t size, std::uint64_t seed, bool quick) {
+        for (std::size_t i = 0; i < count; ++i)
+            for (std::size_t j = 0; j < i; ++j)
+                if (((hashName(names[i], seed, quick) ^ hashName(names[j], seed, quick)) & (size - 1)) == 0)
+                    return false;
+        return true;
+    }
+    static constexpr Hash hash = [] {
+        const std::size_t first = std::bit_ceil(count * 2 + 1);
+        for (std::size_t size = first; size <= first * 32; size *= 2)
+            for (std::uint64_t seed = 1; seed <= 256; ++seed)
+                if (collisionFree(size, seed, true)) return Hash{size, seed, true};
+        for (std::size_t size = first;; size *= 2)
+            for (std::uint64_t seed = 1; seed <= 256; ++seed)
+                if (collisionFree(size, seed, false)) return Hash{size, seed, false};
+    }();
+
+    // slot → name index + 1 (0: empty)
+    static constexpr auto slots = [] {
+        std::array<std::uint16_t, hash.size> out{};
+        for (std::size_t i = 0; i < count; ++i)
+            out[hashName(names[i], hash.seed, hash.quick) & (hash.size - 1)] = static_cast<std::uint16_t>(i + 1);
+        return out;
+    }();
+};
+
+}  // namespace enum_reflect_detail
+
+template <typename E>
+inline constexpr std::size_t enumCount = enum_reflect_detail::EnumInfo<E>::count;
+
+// The declared values in ascending order
+template <typename E>
+constexpr const auto& enumValues() {
+    return enum_reflect_detail::EnumInfo<E>::values;
+}
+
+template <typename E>
+constexpr const auto& enumNames() {
+    return enum_reflect_detail::EnumInfo<E>::names;
+}
+
+// "" for a value with no name (or outside EnumRange<E>)
+template <typename E>
+constexpr std::string_view enumName(E v) {
+    using Info = enum_reflect_detail::EnumInfo<E>;
+    long long offset = static_cast<long long>(v) - Info::lo;
+    if (offset < 0 || offset > Info::hi - Info::lo) return {};
+    return Info::byOffset[static_cast<std::size_t>(offset)];
+}
+
+template <typename E>
+constexpr std::optional<E> enumFromString(std::string_view s) {
+    using Info = enum_reflect_detail::EnumInfo<E>;
+    std::uint16_t slot = Info::slots[enum_reflect_detail::hashName(s, Info::hash.seed, Info::hash.quick) & (Info::hash.size - 1)];
+    if (slot == 0 || Info::names[slot - 1] != s) return std::nullopt;
+    return Info::values[slot - 1];
+}
@@ -0,0 +1,157 @@
+// ==========================================================
+// PacketView.h — zero-copy, endian-explicit wire decoding
+// ==========================================================
+//
+// union Packet / union SensorReading (see union.cpp) decode
+// bytes by writing one member and reading another:
+// - reading an inactive union member is UNDEFINED in C++
+// - bit-field order depends on the compiler and ABI
+// - the bytes must first be COPIED into the union
+//
+// PacketView<Layout> reads fields STRAIGHT from the buffer:
+//
+//     span<const byte> wire = ...;          // socket, mmap, ...
+//     PacketView<SensorFrame> v(wire);
+//     uint32_t raw = v.get<SensorFrame::Raw>();
+//     unsigned low = v.get<SensorFrame::Low>();
+//
+// - memcpy into a local + std::bit_cast → well-defined for any
+//   alignment; compilers turn it into one load (+ bswap)
+// - every Field states its ENDIANNESS explicitly
+// - Bits<Field, shift, width> replaces bit-fields portably
+//
+// FrameArray::decodeColumns() turns an array of frames into
+// SoA columns in one pass (one vector per field).
+//
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace wire {
+
+// std::byteswap is C++23; this is the same thing for C++20
+template <typename U>
+constexpr U byteswap(U v) {
+    static_assert(std::is_unsigned_v<U>);
+    if constexpr (sizeof(U) == 1) return v;
+    else if constexpr (sizeof(U) == 2) return (U)__builtin_bswap16(v);
+    else if constexpr (sizeof(U) == 4) return (U)__builtin_bswap32(v);
+    else return (U)__builtin_bswap64(v);
+}
+
+template <std::size_t N> struct UIntOf;
+template <> struct UIntOf<1> { using type = std::uint8_t; };
+template <> struct UIntOf<2> { using type = std::uint16_t; };
+template <> struct UIntOf<4> { using type = std::uint32_t; };
+template <> struct UIntOf<8> { using type = std::uint64_t; };
+
+// Read a T stored at p with byte order E (p may be unaligned)
+template <typename T, std::endian E>
+inline T load(const std::byte* p) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    using U = typename UIntOf<sizeof(T)>::type;
+    U bits;
+    std::memcpy(&bits, p, sizeof(U));
+    if constexpr (E != std::endian::native) bits = byteswap(bits);
+    return std::bit_cast<T>(bits);
+}
+
+// Write a T at p with byte order E (used to build test data)
+template <typename T, std::endian E>
+inline void store(std::byte* p, T value) {
+    using U = typename UIntOf<sizeof(T)>::type;
+    U bits = std::bit_cast<U>(value);
+    if constexpr (E != std::endian::native) bits = byteswap(bits);
+    std::memcpy(p, &bits, sizeof(U));
+}
+
+}  // namespace wire
+
+// A typed field at a fixed byte offset
+template <typename T, std::size_t Offset, std::endian E = std::endian::little>
+struct Field {
+    using value_type = T;
+    static constexpr std::size_t offset = Offset;
+    static constexpr std::size_t end = Offset + sizeof(T);
+    static T read(const std::byte* frame) { return wire::load<T, E>(frame + Offset); }
+};
+
+// Portable replacement for a bit-field inside an integer Field
+template <typename F, unsigned Shift, unsigned Width>
+struct Bits {
+    using value_type = typename F::value_type;
+    static_assert(std::is_unsigned_v<value_type>, "Bits<> needs an unsigned field");
+    static_assert(Shift + Width <= sizeof(value_type) * 8);
+    static constexpr std::size_t end = F::end;
+    static value_type read(const std::byte* frame) {
+        constexpr value_type mask =
+            Width == sizeof(value_type) * 8 ? (value_type)~value_type(0)
+                                            : (value_type)((value_type(1) << Width) - 1);
+        return (value_type)((F::read(frame) >> Shift) & mask);
+    }
+};
+
+// Layout requirements: static constexpr std::size_t size;
+template <typename Layout>
+class PacketView {
+public:
+    explicit PacketView(std::span<const std::byte> bytes) : p_(bytes.data()) {
+        if (bytes.size() < Layout::size) throw std::out_of_range("PacketView: buffer too small");
+    }
+
+    template <typename F>
+    typename F::value_type get() const {
+        static_assert(F::end <= Layout::size, "field lies outside the layout");
+        return F::read(p_);
+    }
+
+    const std::byte* data() const { return p_; }
+
+private:
+    const std::byte* p_;   // NOT owned: the view never copies
+};
+
+// Iterate a buffer of back-to-back frames
+template <typename Layout>
+class FrameArray {
+public:
+    explicit FrameArray(std::span<const std::byte> bytes)
+        : bytes_(bytes), count_(bytes.size() / Layout::size) {}
+
+    std::size_t size() const { return count_; }
+    PacketView<Layout> operator[](std::size_t i) const {
+        return PacketView<Layout>(bytes_.subspan(i * Layout::size, Layout::size));
+    }
+
+    // Decode field F of every frame into one contiguous column
+    template <typename F>
+    void decodeColumn(std::vector<typename F::value_type>& out) const {
+        static_assert(F::end <= Layout::size);
+        out.resize(count_);
+        const std::byte* p = bytes_.data();
+        auto* dst = out.data();
+        for (std::size_t i = 0; i < count_; ++i, p += Layout::size) dst[i] = F::read(p);
+    }
+
+    // Decode several fields in ONE pass over the buffer
+    // (each frame is touched once, all columns written together)
+    template <typename... Fs>
+    void decodeColumns(std::vector<typename Fs::value_type>&... outs) const {
+        static_assert(((Fs::end <= Layout::size) && ...));
+        (outs.resize(count_), ...);
+        const std::byte* p = bytes_.data();
+        for (std::size_t i = 0; i < count_; ++i, p += Layout::size)
+            ((outs[i] = Fs::read(p)), ...);
+    }
+
+private:
+    std::span<const std::byte> bytes_;
+    std::size_t count_;
+};
@@ -1,26 +1,33 @@
 #include "Person.h"
+#include "ActionSink.h"
 
-Person::Person()
+Person::Person() : Person(ActionSink::console())
+{
+}
+Person::Person(ActionSink& sink) : sink(&sink), recordLifecycle(true)
+{
+    this->sink->record(PersonAction::Created);
+}
+Person::Person(ActionSink& sink, Quiet) : sink(&sink), recordLifecycle(false)
 {
-    cout << "Person created." << endl;
 }
 void Person::Crawl()
 {
-    cout << "Person is crawling." << endl;
+    sink->record(PersonAction::Crawl);
 }
 void Person::Run()
 {
-    cout << "Person is running." << endl;
+    sink->record(PersonAction::Run);
 }
 void Person::Stand()        
 {
-    cout << "Person is standing." << endl;
+    sink->record(PersonAction::Stand);
 }
 void Person::Walk()
 {
-    cout << "Person is walking." << endl;
+    sink->record(PersonAction::Walk);
 }
 Person::~Person()
 {
-    cout << "Person destroyed." << endl;
+    if (recordLifecycle) sink->record(PersonAction::Destroyed);
 }
\ No newline at end of file
@@ -1,12 +1,26 @@
-    #include <iostream>
-    using namespace std;
+    #pragma once
+
+    // Forward declaration only: Person.h pulls in no standard headers
+    class ActionSink;
+
+    // Actions go to the sink chosen at construction (default:
+    // cout + endl, as before; see ActionSink.h for the others)
     class Person
     {
     public:
         Person();
+        explicit Person(ActionSink& sink);
         void Crawl();
         void Run();
         void Stand();
         void Walk();
         ~Person();
+
+    private:
+        friend class PersonPool;
+        struct Quiet {};
+        Person(ActionSink& sink, Quiet);   // no Created/Destroyed records
+
+        ActionSink* sink;
+        bool recordLifecycle;
     };
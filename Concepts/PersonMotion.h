@@ -0,0 +1,69 @@
+// ==========================================================
+// PersonMotion.h — which of Person's actions are allowed when
+// ==========================================================
+//
+// Person.h: Crawl(), Stand(), Walk(), Run() — any call, any time.
+// The posture rules, as a StateMachine.h table:
+//
+//                 Crawl      Stand      Walk       Run
+//     Standing    Crawling   Standing   Walking    ·
+//     Crawling    Crawling   Standing   ·          ·
+//     Walking     ·          Standing   Walking    Running
+//     Running     ·          ·          Walking    Running
+//
+//   · = rejected (no standing up mid-sprint, no running from the
+//       floor): the posture stays and no action is performed
+//
+// Agents start Standing (state id 0). motion::perform(person, e)
+// makes the Person call for an accepted event, so its sink
+// records it as before:
+//
+//     PersonMotion::step(states, events, [&](std::size_t i, auto, fsm::EventId e, auto) {
+//         motion::perform(people[i], e);
+//     });
+//
+#pragma once
+
+#include <array>
+#include "Person.h"
+#include "StateMachine.h"
+
+namespace motion {
+
+struct Standing {};
+struct Crawling {};
+struct Walking {};
+struct Running {};
+
+// Person's calls
+struct Crawl {};
+struct Stand {};
+struct Walk {};
+struct Run {};
+
+}  // namespace motion
+
+using PersonMotion = fsm::Machine<
+    fsm::states<motion::Standing, motion::Crawling, motion::Walking, motion::Running>,
+    fsm::events<motion::Crawl, motion::Stand, motion::Walk, motion::Run>,
+    fsm::row<motion::Standing, motion::Crawl, motion::Crawling>,
+    fsm::row<motion::Standing, motion::Stand, motion::Standing>,
+    fsm::row<motion::Standing, motion::Walk, motion::Walking>,
+    fsm::row<motion::Crawling, motion::Crawl, motion::Crawling>,
+    fsm::row<motion::Crawling, motion::Stand, motion::Standing>,
+    fsm::row<motion::Walking, motion::Stand, motion::Standing>,
+    fsm::row<motion::Walking, motion::Walk, motion::Walking>,
+    fsm::row<motion::Walking, motion::Run, motion::Running>,
+    fsm::row<motion::Running, motion::Walk, motion::Walking>,
+    fsm::row<motion::Running, motion::Run, motion::Running>>;
+
+namespace motion {
+
+// Event id → the Person call it stands for
+inline void perform(Person& p, fsm::EventId e) {
+    static constexpr std::array<void (Person::*)(), PersonMotion::event_count> calls{
+        &Person::Crawl, &Person::Stand, &Person::Walk, &Person::Run};
+    (p.*calls[e])();
+}
+
+}  // namespace motion
@@ -0,0 +1,60 @@
+// ==========================================================
+// PersonPch.h — precompiled header for the Person target
+// ==========================================================
+//
+// The Person target: Person.cpp (the library) + main.cpp (the
+// demo). personActions.cpp links the same Person.cpp.
+//
+// Person.h used to start with
+//
+//     #include <iostream>
+//     using namespace std;
+//
+// so every file that mentioned Person parsed all of iostream and
+// inherited the using-directive. Person.h now forward-declares
+// ActionSink and includes nothing (35 preprocessed lines instead
+// of ~45k); only the TUs that really print, or that include
+// ActionSink.h, pay for <iostream>.
+//
+// This header collects those heavy standard headers so they are
+// parsed ONCE per build, not once per TU. Nothing #includes it;
+// it is force-included with -include, so the sources are
+// unchanged and still build without it.
+//
+// Build modes (run in Concepts/):
+//
+//   plain, one object per TU:
+//     g++ -std=c++20 -O2 -c Person.cpp main.cpp && g++ Person.o main.o -o person
+//
+//   with the PCH (flags must match the ones used for the .gch):
+//     g++ -std=c++20 -O2 -x c++-header PersonPch.h -o PersonPch.h.gch
+//     g++ -std=c++20 -O2 -include PersonPch.h -c Person.cpp main.cpp
+//     g++ Person.o main.o -o person
+//     (-Winvalid-pch reports a .gch that could not be used)
+//
+//   unity / jumbo (every TU of the target in one compile):
+//     g++ -std=c++20 -O2 personUnity.cpp -o person
+//
+// Compile time per TU:
+//     TIMEFORMAT="%R s"
+//     for f in Person.cpp main.cpp personActions.cpp; do
+//         echo -n "$f "; time g++ -std=c++20 -O2 -c $f -o /dev/null
+//     done
+//   and -ftime-report on one file shows where that time goes
+//   (the "phase parsing" line is the header cost).
+//
+// Objects are build output: *.o is ignored, not committed.
+//
+// No #pragma once: GCC warns about it in a file compiled as the
+// main input (the .gch step), and standard headers guard
+// themselves.
+//
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <ostream>
+#include <string_view>
+#include <system_error>
+#include <vector>
@@ -0,0 +1,56 @@
+// ==========================================================
+// PersonPool.h — millions of Person agents, one allocation
+// ==========================================================
+//
+// main.cpp:
+//
+//     Person *p = new Person();     // "Person created."   + flush
+//     ...
+//     delete p;                     // "Person destroyed." + flush
+//
+// Per Person: one heap allocation and two synchronous lines
+// just for being born and dying.
+//
+// PersonPool constructs `count` people in ONE contiguous block
+// and destroys them together. Pooled people skip the
+// Created/Destroyed records (the pool's lifetime IS their
+// lifetime); their actions still go to the given sink:
+//
+//     BatchedFileSink sink(fd);
+//     PersonPool people(1'000'000, sink);
+//     for (Person& p : people) p.Walk();
+//
+// The sink must outlive the pool.
+//
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include "ActionSink.h"
+#include "Person.h"
+
+class PersonPool {
+public:
+    explicit PersonPool(std::size_t count, ActionSink& sink = ActionSink::console())
+        : people_(static_cast<Person*>(::operator new(count * sizeof(Person), std::align_val_t(alignof(Person))))),
+          count_(count) {
+        for (std::size_t i = 0; i < count_; ++i) ::new (people_ + i) Person(sink, Person::Quiet{});
+    }
+
+    PersonPool(const PersonPool&) = delete;
+    PersonPool& operator=(const PersonPool&) = delete;
+
+    ~PersonPool() {
+        for (std::size_t i = count_; i-- > 0;) people_[i].~Person();
+        ::operator delete(people_, std::align_val_t(alignof(Person)));
+    }
+
+    std::size_t size() const { return count_; }
+    Person& operator[](std::size_t i) { return people_[i]; }
+    Person* begin() { return people_; }
+    Person* end() { return people_ + count_; }
+
+private:
+    Person* people_;
+    std::size_t count_;
+};
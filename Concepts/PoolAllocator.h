@@ -0,0 +1,169 @@
+// ==========================================================
+// PoolAllocator.h — fixed-size-block pool (free-list slabs)
+// ==========================================================
+//
+// Deep / RuleOfFive (shallowvsdeep.cpp) call new/delete for
+// ONE int on every copy, copy-assignment and destruction.
+// A general-purpose malloc has to handle every size, take
+// locks or per-thread caches, keep headers... for 4 bytes.
+//
+// SLAB POOL:
+// - Size classes: 8, 16, 32, 64, 128, 256 bytes
+// - Each class carves 64 KB slabs into equal blocks
+// - Free blocks form a singly linked FREE LIST
+//   (the "next" pointer lives inside the free block itself)
+// - allocate  = pop the free-list head    → O(1)
+// - deallocate = push onto the free list  → O(1)
+//
+// Free lists are thread_local, so the fast path needs no lock.
+// A block may be freed on a different thread than the one that
+// allocated it (it simply joins that thread's free list).
+// Slabs are kept until program exit and never returned to the OS.
+//
+// Sizes above 256 bytes fall through to ::operator new.
+//
+// POLICIES (what value types are parameterized on):
+//   MallocPolicy → ::operator new / delete
+//   PoolPolicy   → SlabPool
+//   CountingPolicy<P> → P, plus allocation/deallocation counters
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+class SlabPool {
+public:
+    static constexpr std::size_t kClasses = 6;          // 8 .. 256 bytes
+    static constexpr std::size_t kMaxBlock = 8u << (kClasses - 1);
+    static constexpr std::size_t kSlabBytes = 64 * 1024;
+
+    static void* allocate(std::size_t bytes) {
+        if (bytes > kMaxBlock) return ::operator new(bytes);
+        FreeList& fl = local().lists[classOf(bytes)];
+        if (!fl.head) refill(fl, blockSize(classOf(bytes)));
+        Node* n = fl.head;
+        fl.head = n->next;
+        return n;
+    }
+
+    static void deallocate(void* p, std::size_t bytes) {
+        if (!p) return;
+        if (bytes > kMaxBlock) {
+            ::operator delete(p);
+            return;
+        }
+        FreeList& fl = local().lists[classOf(bytes)];
+        Node* n = static_cast<Node*>(p);
+        n->next = fl.head;
+        fl.head = n;
+    }
+
+    static std::size_t slabsAllocated() {
+        std::lock_guard<std::mutex> lg(globalSlabs().m);
+        return globalSlabs().slabs.size();
+    }
+
+private:
+    struct Node {
+        Node* next;
+    };
+    struct FreeList {
+        Node* head = nullptr;
+    };
+    struct ThreadLists {
+        FreeList lists[kClasses];
+    };
+
+    // Owns the raw slab memory for the whole process
+    struct SlabRegistry {
+        std::mutex m;
+        std::vector<std::unique_ptr<unsigned char[]>> slabs;
+    };
+
+    static SlabRegistry& globalSlabs() {
+        static SlabRegistry r;
+        return r;
+    }
+
+    static ThreadLists& local() {
+        thread_local ThreadLists t;
+        return t;
+    }
+
+    static constexpr std::size_t blockSize(std::size_t cls) { return std::size_t(8) << cls; }
+
+    static std::size_t classOf(std::size_t bytes) {
+        std::size_t cls = 0;
+        while (blockSize(cls) < bytes) ++cls;
+        return cls;
+    }
+
+    // Carve a new slab into blocks and thread them onto the list
+    static void refill(FreeList& fl, std::size_t block) {
+        unsigned char* slab;
+        {
+            SlabRegistry& r = globalSlabs();
+            std::lock_guard<std::mutex> lg(r.m);
+            r.slabs.emplace_back(new unsigned char[kSlabBytes]);
+            slab = r.slabs.back().get();
+        }
+        std::size_t count = kSlabBytes / block;
+        for (std::size_t i = count; i-- > 0;) {
+            Node* n = reinterpret_cast<Node*>(slab + i * block);
+            n->next = fl.head;
+            fl.head = n;
+        }
+    }
+};
+
+struct MallocPolicy {
+    static void* allocate(std::size_t bytes) { return ::operator new(bytes); }
+    static void deallocate(void* p, std::size_t) { ::operator delete(p); }
+};
+
+struct PoolPolicy {
+    static void* allocate(std::size_t bytes) { return SlabPool::allocate(bytes); }
+    static void deallocate(void* p, std::size_t bytes) { SlabPool::deallocate(p, bytes); }
+};
+
+// Wraps another policy and counts calls (for benchmarks)
+template <typename Inner = MallocPolicy>
+struct CountingPolicy {
+    static inline std::size_t allocations = 0;
+    static inline std::size_t deallocations = 0;
+
+    static void* allocate(std::size_t bytes) {
+        ++allocations;
+        return Inner::allocate(bytes);
+    }
+    static void deallocate(void* p, std::size_t bytes) {
+        ++deallocations;
+        Inner::deallocate(p, bytes);
+    }
+    static void reset() { allocations = deallocations = 0; }
+};
+
+// new/delete for a single T through an allocation policy
+template <typename T, typename Policy, typename... Args>
+T* policyNew(Args&&... args) {
+    void* mem = Policy::allocate(sizeof(T));
+    try {
+        return ::new (mem) T(std::forward<Args>(args)...);
+    } catch (...) {
+        Policy::deallocate(mem, sizeof(T));
+        throw;
+    }
+}
+
+template <typename Policy, typename T>
+void policyDelete(T* p) {
+    if (!p) return;
+    p->~T();
+    Policy::deallocate(p, sizeof(T));
+}
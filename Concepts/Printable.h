@@ -0,0 +1,99 @@
+// ==========================================================
+// Printable.h — static (CRTP) and dynamic Print, same class
+// ==========================================================
+//
+// interface.cpp:
+//
+//     class IPrintable { virtual void Print() const = 0; };
+//     IPrintable* obj2 = new GameObject(2);
+//     obj2->Print();                        // indirect call
+//
+// Every Print() through IPrintable* is an indirect call the
+// compiler cannot inline, and the object has to live behind a
+// pointer (usually on the heap). A std::vector<GameObject> of
+// ONE type does not need any of that.
+//
+// A class writes its printing ONCE, as a template:
+//
+//     class GameObject : public Printable<GameObject> {
+//     public:
+//         template <typename Out>
+//         void PrintTo(Out& out) const { out << "GameObject ID: " << id; }
+//     };
+//
+// and gets both modes:
+//   - STATIC:  obj.Print(), obj.Print(out), PrintAll(objects, out)
+//              → direct calls on the concrete type, fully inlinable
+//   - DYNAMIC: DynamicPrintable<GameObject> is-an IPrintable
+//              (virtual Print), for mixed collections
+//
+// The PrintableObject concept checks conformance at compile
+// time; a class that misspells PrintTo fails with a one-line
+// "constraints not satisfied" instead of a template backtrace.
+//
+// Out is anything with operator<< for the printed values
+// (std::ostream, a string builder, a checksum sink, ...);
+// IPrintableTo<Out> fixes it for the virtual interface.
+//
+#pragma once
+
+#include <concepts>
+#include <iostream>
+#include <ranges>
+#include <utility>
+
+template <typename T, typename Out = std::ostream>
+concept PrintableObject = requires(const T& t, Out& out) {
+    { t.PrintTo(out) } -> std::same_as<void>;
+};
+
+// ---------------- static interface ----------------
+
+template <typename Derived>
+class Printable {
+public:
+    void Print() const {
+        Print(std::cout);
+        std::cout << '\n';
+    }
+
+    template <typename Out>
+    void Print(Out& out) const {
+        static_assert(PrintableObject<Derived, Out>, "Printable<D>: D must define `void PrintTo(Out&) const`");
+        static_cast<const Derived&>(*this).PrintTo(out);
+    }
+
+protected:
+    Printable() = default;                    // only as a base
+    ~Printable() = default;                   // never deleted through Printable*
+};
+
+// One type, one direct (inlinable) call per element
+template <typename Out, std::ranges::input_range R>
+    requires PrintableObject<std::ranges::range_value_t<R>, Out>
+void PrintAll(const R& objects, Out& out) {
+    for (const auto& o : objects) o.PrintTo(out);
+}
+
+// ---------------- dynamic interface ----------------
+
+template <typename Out>
+class IPrintableTo {
+public:
+    virtual void Print(Out& out) const = 0;
+    virtual ~IPrintableTo() = default;
+};
+
+using IPrintable = IPrintableTo<std::ostream>;
+
+// T with the virtual interface added on top (T itself stays
+// non-virtual, so vector<T> keeps the static mode)
+template <typename T, typename Out = std::ostream>
+    requires PrintableObject<T, Out>
+class DynamicPrintable final : public IPrintableTo<Out>, public T {
+public:
+    template <typename... Args>
+    explicit DynamicPrintable(Args&&... args) : T(std::forward<Args>(args)...) {}
+
+    void Print(Out& out) const override { T::PrintTo(out); }
+};
@@ -0,0 +1,178 @@
+// ==========================================================
+// ResourceTypes.h — quiet Deep / RuleOfFive for experiments
+// ==========================================================
+//
+// Same semantics as Deep and RuleOfFive in shallowvsdeep.cpp
+// (each object OWNS one heap int), but:
+// - no cout in every special member (so they can be measured)
+// - the heap comes from an allocation POLICY (PoolAllocator.h)
+//
+//   using RuleOfFive       = BasicRuleOfFive<MallocPolicy>;
+//   using PooledRuleOfFive = BasicRuleOfFive<PoolPolicy>;
+//
+// All three are trivially relocatable (Relocatable.h): they own
+// their heap block and never point into themselves.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include "PoolAllocator.h"
+#include "../Memory_management/Relocatable.h"
+
+template <typename Alloc = MallocPolicy>
+class BasicDeep {
+public:
+    int* data;
+
+    BasicDeep(int value = 0) : data(policyNew<int, Alloc>(value)) {}
+    BasicDeep(const BasicDeep& other) : data(policyNew<int, Alloc>(*other.data)) {}
+
+    BasicDeep& operator=(const BasicDeep& other) {
+        if (this == &other) return *this;
+        *data = *other.data;          // reuse our block: no free + alloc
+        return *this;
+    }
+
+    ~BasicDeep() { policyDelete<Alloc>(data); }
+};
+
+template <typename Alloc = MallocPolicy>
+class BasicRuleOfFive {
+public:
+    int* data;
+
+    BasicRuleOfFive(int value = 0) : data(policyNew<int, Alloc>(value)) {}
+    BasicRuleOfFive(const BasicRuleOfFive& other) : data(policyNew<int, Alloc>(*other.data)) {}
+
+    BasicRuleOfFive& operator=(const BasicRuleOfFive& other) {
+        if (this == &other) return *this;
+        if (!data) data = policyNew<int, Alloc>(*other.data);   // moved-from
+        else *data = *other.data;
+        return *this;
+    }
+
+    BasicRuleOfFive(BasicRuleOfFive&& other) noexcept : data(other.data) { other.data = nullptr; }
+
+    BasicRuleOfFive& operator=(BasicRuleOfFive&& other) noexcept {
+        if (this == &other) return *this;
+        policyDelete<Alloc>(data);
+        data = other.data;
+        other.data = nullptr;
+        return *this;
+    }
+
+    ~BasicRuleOfFive() { policyDelete<Alloc>(data); }
+
+    int value() const { return data ? *data : 0; }
+};
+
+// ----------------------------------------------------------
+// BasicSboRuleOfFive<N, Alloc>
+// ----------------------------------------------------------
+// Rule-of-Five type that owns a byte payload, with SMALL
+// BUFFER OPTIMIZATION (like std::string):
+// - payload <= N bytes → stored INLINE in the object, no heap
+// - payload  > N bytes → heap block from Alloc
+// Copying or moving an inline payload is a plain memcpy.
+template <std::size_t N, typename Alloc = MallocPolicy>
+class BasicSboRuleOfFive {
+public:
+    static constexpr std::size_t inline_capacity = N;
+
+    BasicSboRuleOfFive() = default;
+
+    BasicSboRuleOfFive(const void* bytes, std::size_t len) { assign(bytes, len); }
+
+    // One int, like RuleOfFive(int value)
+    explicit BasicSboRuleOfFive(int value) { assign(&value, sizeof(value)); }
+
+    BasicSboRuleOfFive(const BasicSboRuleOfFive& other) { assign(other.data(), other.size_); }
+
+    BasicSboRuleOfFive& operator=(const BasicSboRuleOfFive& other) {
+        if (this != &other) {
+            if (!isInline() && other.size_ <= capacity_) {
+                std::memcpy(heap_, other.data(), other.size_);   // reuse our block
+                size_ = other.size_;
+            } else {
+                release();
+                assign(other.data(), other.size_);
+            }
+        }
+        return *this;
+    }
+
+    BasicSboRuleOfFive(BasicSboRuleOfFive&& other) noexcept { steal(other); }
+
+    BasicSboRuleOfFive& operator=(BasicSboRuleOfFive&& other) noexcept {
+        if (this != &other) {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~BasicSboRuleOfFive() { release(); }
+
+    const unsigned char* data() const { return isInline() ? inline_ : heap_; }
+    std::size_t size() const { return size_; }
+    bool isInline() const { return capacity_ == 0; }
+
+    int value() const {
+        int v = 0;
+        std::memcpy(&v, data(), size_ < sizeof(v) ? size_ : sizeof(v));
+        return v;
+    }
+
+private:
+    void assign(const void* bytes, std::size_t len) {
+        if (len <= N) {
+            capacity_ = 0;
+            std::memcpy(inline_, bytes, len);
+        } else {
+            heap_ = static_cast<unsigned char*>(Alloc::allocate(len));
+            capacity_ = len;
+            std::memcpy(heap_, bytes, len);
+        }
+        size_ = len;
+    }
+
+    void steal(BasicSboRuleOfFive& other) noexcept {
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        if (other.isInline()) {
+            std::memcpy(inline_, other.inline_, size_);         // no allocation
+        } else {
+            heap_ = other.heap_;                               // take ownership
+        }
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    void release() {
+        if (!isInline()) Alloc::deallocate(heap_, capacity_);
+        capacity_ = 0;
+        size_ = 0;
+    }
+
+    union {
+        unsigned char inline_[N];
+        unsigned char* heap_;
+    };
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;    // 0 → payload is inline
+};
+
+template <typename Alloc>
+struct is_trivially_relocatable<BasicDeep<Alloc>> : std::true_type {};
+template <typename Alloc>
+struct is_trivially_relocatable<BasicRuleOfFive<Alloc>> : std::true_type {};
+// data() is recomputed from capacity_, never stored
+template <std::size_t N, typename Alloc>
+struct is_trivially_relocatable<BasicSboRuleOfFive<N, Alloc>> : std::true_type {};
+
+using Deep = BasicDeep<MallocPolicy>;
+using RuleOfFive = BasicRuleOfFive<MallocPolicy>;
+using PooledDeep = BasicDeep<PoolPolicy>;
+using PooledRuleOfFive = BasicRuleOfFive<PoolPolicy>;
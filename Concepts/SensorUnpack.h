@@ -0,0 +1,168 @@
+// ==========================================================
+// SensorUnpack.h — bulk low/high byte split of raw sensor words
+// ==========================================================
+//
+// union.cpp's device-driver example:
+//
+//     union SensorReading {
+//         int rawValue;
+//         struct { unsigned low : 8; unsigned high : 8; } bytes;
+//     };
+//     r.rawValue = 0x1234;   r.bytes.low;   r.bytes.high;
+//
+// - one reading at a time, through a union read that C++ does not
+//   define (PacketView.h covers that for single frames)
+// - which bits `low` names is up to the compiler and ABI
+//
+// unpack_readings() splits a whole batch into two byte columns:
+//
+//     unpack_readings(raw, low, high);   // low[i] = raw[i] bits 0..7,
+//                                        // high[i] = raw[i] bits 8..15
+//
+// The bytes are defined by VALUE (shifts), so the result is the
+// same on every compiler and byte order. Kernels:
+//
+//   Scalar  the reference: two shifts per reading
+//   Ssse3   x86: pshufb gathers bytes 0 and 1 of four words per
+//           register, two unpacks merge four registers → 16
+//           lows and 16 highs per iteration; compiled with a
+//           target attribute, so an SSE2-only build still has it
+//   Neon    AArch64 / ARMv7 NEON: vld4q_u8 de-interleaves 16
+//           words in the load (lane 0 = low bytes, lane 1 = high)
+//
+// The SIMD kernels read the words' bytes from memory, so they
+// exist only on little-endian targets; tails (n % 16) use the
+// scalar loop. unpack_readings(raw, low, high) calls the kernel
+// CpuDispatch.h picked for this CPU ("unpack_readings"; forced
+// with CPU_DISPATCH=unpack_readings=scalar); the overload taking
+// an UnpackKernel runs a given one, for verification.
+//
+// low and high must hold at least raw.size() bytes
+// (std::invalid_argument otherwise); inputs and outputs may have
+// any alignment.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "../Function Pointers /CpuDispatch.h"
+
+#if defined(CPU_DISPATCH_X86)
+#include <immintrin.h>
+#elif defined(CPU_DISPATCH_ARM) && defined(__ARM_NEON) && (defined(__AARCH64EL__) || defined(__ARMEL__))
+#define SENSOR_UNPACK_NEON 1
+#include <arm_neon.h>
+#endif
+
+enum class UnpackKernel { Scalar, Ssse3, Neon };
+
+inline const char* unpackKernelName(UnpackKernel k) {
+    switch (k) {
+        case UnpackKernel::Scalar: return "scalar";
+        case UnpackKernel::Ssse3: return "ssse3";
+        case UnpackKernel::Neon: return "neon";
+    }
+    return "?";
+}
+
+namespace sensor_unpack_detail {
+
+using Kernel = void (*)(const std::uint32_t*, std::uint8_t*, std::uint8_t*, std::size_t);
+
+inline void unpackScalar(const std::uint32_t* in, std::uint8_t* low, std::uint8_t* high, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        low[i] = std::uint8_t(in[i]);
+        high[i] = std::uint8_t(in[i] >> 8);
+    }
+}
+
+#if defined(CPU_DISPATCH_X86)
+CPU_DISPATCH_TARGET("ssse3")
+inline void unpackSsse3(const std::uint32_t* in, std::uint8_t* low, std::uint8_t* high, std::size_t n) {
+    // Per word: byte 0 → lanes 0..3, byte 1 → lanes 4..7, rest zero
+    const __m128i split = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(in + i);
+        const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(p + 0), split);   // L0-3  H0-3
+        const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(p + 1), split);   // L4-7  H4-7
+        const __m128i c = _mm_shuffle_epi8(_mm_loadu_si128(p + 2), split);
+        const __m128i d = _mm_shuffle_epi8(_mm_loadu_si128(p + 3), split);
+        const __m128i ab = _mm_unpacklo_epi32(a, b);                         // L0-3 L4-7 H0-3 H4-7
+        const __m128i cd = _mm_unpacklo_epi32(c, d);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(low + i), _mm_unpacklo_epi64(ab, cd));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(high + i), _mm_unpackhi_epi64(ab, cd));
+    }
+    unpackScalar(in + i, low + i, high + i, n - i);
+}
+#endif
+
+#if defined(SENSOR_UNPACK_NEON)
+inline void unpackNeon(const std::uint32_t* in, std::uint8_t* low, std::uint8_t* high, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const uint8x16x4_t v = vld4q_u8(reinterpret_cast<const std::uint8_t*>(in + i));
+        vst1q_u8(low + i, v.val[0]);
+        vst1q_u8(high + i, v.val[1]);
+    }
+    unpackScalar(in + i, low + i, high + i, n - i);
+}
+#endif
+
+inline void checkSizes(std::span<const std::uint32_t> raw, std::span<std::uint8_t> low, std::span<std::uint8_t> high) {
+    if (low.size() < raw.size() || high.size() < raw.size())
+        throw std::invalid_argument("unpack_readings: output shorter than the input (" + std::to_string(raw.size()) +
+                                    " readings)");
+}
+
+inline const DispatchedKernel<Kernel>& unpackDispatch() {
+    static const DispatchedKernel<Kernel> k{"unpack_readings", nullptr, {
+#if defined(CPU_DISPATCH_X86)
+        {"ssse3", {CpuFeature::Ssse3}, unpackSsse3},
+#endif
+#if defined(SENSOR_UNPACK_NEON)
+        {"neon", {CpuFeature::Neon}, unpackNeon},
+#endif
+        {"scalar", {}, unpackScalar},
+    }};
+    return k;
+}
+
+}  // namespace sensor_unpack_detail
+
+// Whether kernel k can run on this CPU
+inline bool unpackKernelSupported(UnpackKernel k) {
+    return sensor_unpack_detail::unpackDispatch().variant(unpackKernelName(k)) != nullptr;
+}
+
+// The kernel unpack_readings(raw, low, high) runs here
+inline UnpackKernel bestUnpackKernel() {
+    const std::string_view chosen = sensor_unpack_detail::unpackDispatch().selected();
+    for (UnpackKernel k : {UnpackKernel::Ssse3, UnpackKernel::Neon})
+        if (chosen == unpackKernelName(k)) return k;
+    return UnpackKernel::Scalar;
+}
+
+// A given kernel; std::invalid_argument if this CPU lacks it
+inline void unpack_readings(std::span<const std::uint32_t> raw, std::span<std::uint8_t> low,
+                            std::span<std::uint8_t> high, UnpackKernel k) {
+    using namespace sensor_unpack_detail;
+    checkSizes(raw, low, high);
+    const Kernel fn = unpackDispatch().variant(unpackKernelName(k));
+    if (!fn)
+        throw std::invalid_argument(std::string("unpack_readings: kernel ") + unpackKernelName(k) +
+                                    " not supported here");
+    fn(raw.data(), low.data(), high.data(), raw.size());
+}
+
+// The kernel chosen for this CPU
+inline void unpack_readings(std::span<const std::uint32_t> raw, std::span<std::uint8_t> low,
+                            std::span<std::uint8_t> high) {
+    using namespace sensor_unpack_detail;
+    checkSizes(raw, low, high);
+    unpackDispatch()(raw.data(), low.data(), high.data(), raw.size());
+}
@@ -0,0 +1,177 @@
+// ==========================================================
+// StateMachine.h — states and events as types, transitions as a constexpr table
+// ==========================================================
+//
+// Person.h gives Crawl(), Stand(), Walk() and Run() as independent
+// calls; whether a call is allowed in the current posture is left
+// to every caller, typically as
+//
+//     if (s == Crawling)      { if (e == Stand) s = Standing; }
+//     else if (s == Standing) { if (e == Crawl) s = Crawling; else if (e == Walk) ... }
+//     else if ...
+//
+// for every agent, every tick: a chain of data-dependent branches
+// the predictor cannot learn when events are random.
+//
+// fsm::Machine declares the same thing as types and lets the
+// compiler turn it into a [state][event] table of bytes:
+//
+//     struct Standing {}; struct Walking {};  ...
+//     struct Walk {};     struct Stand {};    ...
+//
+//     using Motion = fsm::Machine<fsm::states<Standing, Walking>,
+//                                 fsm::events<Walk, Stand>,
+//                                 fsm::row<Standing, Walk, Walking>,
+//                                 fsm::row<Walking, Stand, Standing>>;
+//
+//     static_assert(Motion::next(Motion::state<Standing>, Motion::event<Walk>) == Motion::state<Walking>);
+//     Motion::step(states, events);             // one table load per agent
+//
+// - states and events get dense ids (fsm::StateId / EventId, one
+//   byte each) in declaration order; the first state is id 0
+// - a (state, event) pair without a row is REJECTED: the state
+//   stays, and the event does not count as accepted
+// - a row naming an undeclared type, or a second row for the same
+//   (state, event), is a compile error
+// - each table entry is the next state | 0x80 when accepted, so a
+//   step is a load, a mask and an add — no branch
+//
+// step(states, events) advances a whole batch, SoA style: one
+// column of state ids, one column of this tick's event ids. Event
+// ids must come from Machine::event<E> (they index the table
+// unchecked). The overload with a callback reports every accepted
+// transition, for side effects (PersonMotion.h replays them on a
+// Person).
+//
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace fsm {
+
+using StateId = std::uint8_t;
+using EventId = std::uint8_t;
+
+template <typename... Ts>
+struct states {};
+template <typename... Ts>
+struct events {};
+template <typename From, typename Event, typename To>
+struct row {};
+
+namespace detail {
+
+template <typename T, typename... Ts>
+constexpr std::size_t indexOf() {
+    constexpr bool found[] = {std::is_same_v<T, Ts>..., false};
+    std::size_t i = 0;
+    while (i < sizeof...(Ts) && !found[i]) ++i;
+    return i;
+}
+
+template <typename T, typename List>
+struct Index;
+template <typename T, template <typename...> class L, typename... Ts>
+struct Index<T, L<Ts...>> {
+    static constexpr std::size_t value = indexOf<T, Ts...>();
+    static_assert(value < sizeof...(Ts), "fsm: type is not declared in this machine's states<> / events<>");
+};
+
+template <typename List>
+struct Count;
+template <template <typename...> class L, typename... Ts>
+struct Count<L<Ts...>> {
+    static constexpr std::size_t value = sizeof...(Ts);
+};
+
+struct Edge {
+    std::size_t from, event, to;
+};
+
+}  // namespace detail
+
+template <typename States, typename Events, typename... Rows>
+class Machine;
+
+template <typename... S, typename... E, typename... From, typename... Ev, typename... To>
+class Machine<states<S...>, events<E...>, row<From, Ev, To>...> {
+public:
+    static constexpr std::size_t state_count = sizeof...(S);
+    static constexpr std::size_t event_count = sizeof...(E);
+    static_assert(state_count > 0 && event_count > 0, "fsm: a machine needs at least one state and one event");
+    static_assert(state_count <= 0x80, "fsm: at most 128 states (the high bit of an entry is 'accepted')");
+    static_assert(event_count <= 0x100, "fsm: at most 256 events");
+
+    static constexpr std::uint8_t kAccepted = 0x80;
+    using Table = std::array<std::array<std::uint8_t, event_count>, state_count>;
+
+    template <typename T>
+    static constexpr StateId state = StateId(detail::Index<T, states<S...>>::value);
+    template <typename T>
+    static constexpr EventId event = EventId(detail::Index<T, events<E...>>::value);
+
+    // Built while compiling; a duplicate row throws, i.e. does not compile
+    static constexpr Table table = [] {
+        constexpr detail::Edge edges[] = {
+            {detail::Index<From, states<S...>>::value, detail::Index<Ev, events<E...>>::value,
+             detail::Index<To, states<S...>>::value}...,
+            {0, 0, 0}};
+        Table t{};
+        for (std::size_t s = 0; s < state_count; ++s)
+            for (std::size_t e = 0; e < event_count; ++e) t[s][e] = std::uint8_t(s);   // rejected: stay
+        for (std::size_t i = 0; i < sizeof...(From); ++i) {
+            std::uint8_t& entry = t[edges[i].from][edges[i].event];
+            if (entry & kAccepted) throw std::invalid_argument("fsm: two rows for the same (state, event)");
+            entry = std::uint8_t(edges[i].to | kAccepted);
+        }
+        return t;
+    }();
+
+    static constexpr StateId next(StateId s, EventId e) { return StateId(table[s][e] & ~kAccepted); }
+    static constexpr bool accepts(StateId s, EventId e) { return table[s][e] & kAccepted; }
+
+    // states[i] = next(states[i], events[i]); returns how many
+    // events were accepted
+    static std::size_t step(std::span<StateId> states_, std::span<const EventId> events_) {
+        checkSizes(states_, events_);
+        std::size_t accepted = 0;
+        StateId* s = states_.data();
+        const EventId* e = events_.data();
+        for (std::size_t i = 0, n = states_.size(); i < n; ++i) {
+            const std::uint8_t entry = table[s[i]][e[i]];
+            s[i] = StateId(entry & ~kAccepted);
+            accepted += entry >> 7;
+        }
+        return accepted;
+    }
+
+    // The same, calling onAccepted(i, from, event, to) for every
+    // accepted event
+    template <typename F>
+    static std::size_t step(std::span<StateId> states_, std::span<const EventId> events_, F&& onAccepted) {
+        checkSizes(states_, events_);
+        std::size_t accepted = 0;
+        for (std::size_t i = 0, n = states_.size(); i < n; ++i) {
+            const StateId from = states_[i];
+            const std::uint8_t entry = table[from][events_[i]];
+            states_[i] = StateId(entry & ~kAccepted);
+            if (entry & kAccepted) {
+                ++accepted;
+                onAccepted(i, from, events_[i], states_[i]);
+            }
+        }
+        return accepted;
+    }
+
+private:
+    static void checkSizes(std::span<StateId> s, std::span<const EventId> e) {
+        if (s.size() != e.size()) throw std::invalid_argument("fsm::Machine::step: one event per state");
+    }
+};
+
+}  // namespace fsm
@@ -0,0 +1,219 @@
+// ==========================================================
+// TripleLayout.h — one logical {x, y, z}, three memory layouts
+// ==========================================================
+//
+// structure.cpp:
+//
+//     struct myStruct { int x; int y; int z; int sum() { return x + y + z; } };
+//     myStruct *obj = new myStruct();       // one heap block per triple
+//
+// For big arrays of triples, how the fields sit in memory
+// decides what the CPU can do with them. TripleArray<Layout>
+// stores the same logical Triple three ways:
+//
+//   layout::AoS<A>     x y z | x y z | ...        (array of structs)
+//                      A = element alignment: 4 → 12-byte
+//                      records, 16 → padded to 16 (aligned loads)
+//   layout::SoA        x x x ... | y y y ... | z z z ...
+//   layout::AoSoA<B>   blocks of B: x[B] y[B] z[B] | x[B] y[B] z[B] | ...
+//                      (B = 8: one 256-bit register per field
+//                      per block, and a block is 96 bytes)
+//
+// Every layout offers the same interface:
+//
+//     TripleArray<layout::SoA> a(n);
+//     a.set(i, {10, 20, 40});
+//     Triple t = a.get(i);
+//     a.sum_all(out);              // out[i] = x + y + z for every i
+//
+// sum_all is written per layout as the loop the vectorizer
+// handles best: a unit-stride loop over three columns (SoA,
+// and within each AoSoA block) or a stride-3/4 loop over
+// records (AoS, SIMD via interleaved loads). Build with -O3 (or
+// -O2 -ftree-vectorize -fvect-cost-model=dynamic) and -mavx2
+// when available; -fopt-info-vec lists the loops vectorized.
+//
+// Storage is one allocation aligned to Align bytes (default 64,
+// a cache line); each SoA column starts Align-aligned too.
+// Unused tail slots (SoA/AoSoA padding) are zero.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+
+struct Triple {
+    int x;
+    int y;
+    int z;
+    int sum() const { return x + y + z; }
+};
+
+namespace layout {
+
+template <std::size_t ElementAlign = alignof(int)>
+struct AoS {
+    static_assert(ElementAlign >= alignof(int) && (ElementAlign & (ElementAlign - 1)) == 0,
+                  "layout::AoS: power-of-two alignment >= alignof(int)");
+};
+
+struct SoA {};
+
+template <std::size_t Block = 8>
+struct AoSoA {
+    static_assert(Block > 0, "layout::AoSoA: empty blocks");
+};
+
+}  // namespace layout
+
+namespace triple_layout_detail {
+
+struct AlignedFree {
+    std::size_t align;
+    void operator()(void* p) const { ::operator delete(p, std::align_val_t(align)); }
+};
+
+using Buffer = std::unique_ptr<unsigned char, AlignedFree>;
+
+inline Buffer allocate(std::size_t bytes, std::size_t align) {
+    void* p = ::operator new(bytes == 0 ? align : bytes, std::align_val_t(align));
+    std::memset(p, 0, bytes);
+    return Buffer(static_cast<unsigned char*>(p), AlignedFree{align});
+}
+
+constexpr std::size_t roundUp(std::size_t n, std::size_t to) { return (n + to - 1) / to * to; }
+
+}  // namespace triple_layout_detail
+
+template <typename Layout, std::size_t Align = 64>
+class TripleArray;
+
+// ---------------- AoS ----------------
+
+template <std::size_t ElementAlign, std::size_t Align>
+class TripleArray<layout::AoS<ElementAlign>, Align> {
+public:
+    struct alignas(ElementAlign) Record {
+        int x, y, z;
+    };
+
+    explicit TripleArray(std::size_t n)
+        : n_(n), buf_(triple_layout_detail::allocate(n * sizeof(Record), Align)),
+          data_(reinterpret_cast<Record*>(buf_.get())) {}
+
+    std::size_t size() const { return n_; }
+    std::size_t bytes() const { return n_ * sizeof(Record); }
+
+    Triple get(std::size_t i) const { return {data_[i].x, data_[i].y, data_[i].z}; }
+    void set(std::size_t i, const Triple& t) { data_[i] = {t.x, t.y, t.z}; }
+
+    void sum_all(std::span<int> out) const {
+        if (out.size() < n_) throw std::invalid_argument("TripleArray::sum_all: output shorter than the array");
+        const Record* __restrict r = data_;
+        int* __restrict o = out.data();
+        for (std::size_t i = 0; i < n_; ++i) o[i] = r[i].x + r[i].y + r[i].z;
+    }
+
+private:
+    std::size_t n_;
+    triple_layout_detail::Buffer buf_;
+    Record* data_;
+};
+
+// ---------------- SoA ----------------
+
+template <std::size_t Align>
+class TripleArray<layout::SoA, Align> {
+public:
+    explicit TripleArray(std::size_t n)
+        : n_(n), stride_(triple_layout_detail::roundUp(n, Align / sizeof(int) ? Align / sizeof(int) : 1)),
+          buf_(triple_layout_detail::allocate(3 * stride_ * sizeof(int), Align)),
+          x_(reinterpret_cast<int*>(buf_.get())), y_(x_ + stride_), z_(y_ + stride_) {}
+
+    std::size_t size() const { return n_; }
+    std::size_t bytes() const { return 3 * stride_ * sizeof(int); }
+
+    Triple get(std::size_t i) const { return {x_[i], y_[i], z_[i]}; }
+    void set(std::size_t i, const Triple& t) {
+        x_[i] = t.x;
+        y_[i] = t.y;
+        z_[i] = t.z;
+    }
+
+    // Whole columns, for kernels that only need one field
+    std::span<const int> xs() const { return {x_, n_}; }
+    std::span<const int> ys() const { return {y_, n_}; }
+    std::span<const int> zs() const { return {z_, n_}; }
+
+    void sum_all(std::span<int> out) const {
+        if (out.size() < n_) throw std::invalid_argument("TripleArray::sum_all: output shorter than the array");
+        const int* __restrict x = x_;
+        const int* __restrict y = y_;
+        const int* __restrict z = z_;
+        int* __restrict o = out.data();
+        for (std::size_t i = 0; i < n_; ++i) o[i] = x[i] + y[i] + z[i];
+    }
+
+private:
+    std::size_t n_;
+    std::size_t stride_;                                    // column length incl. padding
+    triple_layout_detail::Buffer buf_;
+    int* x_;
+    int* y_;
+    int* z_;
+};
+
+// ---------------- AoSoA ----------------
+
+template <std::size_t Block, std::size_t Align>
+class TripleArray<layout::AoSoA<Block>, Align> {
+public:
+    // B = 8: 96 bytes, so every chunk starts 32-byte aligned
+    struct Chunk {
+        int x[Block];
+        int y[Block];
+        int z[Block];
+    };
+
+    explicit TripleArray(std::size_t n)
+        : n_(n), chunks_((n + Block - 1) / Block),
+          buf_(triple_layout_detail::allocate(chunks_ * sizeof(Chunk), Align)),
+          data_(reinterpret_cast<Chunk*>(buf_.get())) {}
+
+    std::size_t size() const { return n_; }
+    std::size_t bytes() const { return chunks_ * sizeof(Chunk); }
+
+    Triple get(std::size_t i) const {
+        const Chunk& c = data_[i / Block];
+        std::size_t j = i % Block;
+        return {c.x[j], c.y[j], c.z[j]};
+    }
+    void set(std::size_t i, const Triple& t) {
+        Chunk& c = data_[i / Block];
+        std::size_t j = i % Block;
+        c.x[j] = t.x;
+        c.y[j] = t.y;
+        c.z[j] = t.z;
+    }
+
+    // Whole blocks (fixed-length inner loop), then the partial one
+    void sum_all(std::span<int> out) const {
+        if (out.size() < n_) throw std::invalid_argument("TripleArray::sum_all: output shorter than the array");
+        const Chunk* __restrict c = data_;
+        int* __restrict o = out.data();
+        std::size_t full = n_ / Block;
+        for (std::size_t b = 0; b < full; ++b, o += Block)
+            for (std::size_t j = 0; j < Block; ++j) o[j] = c[b].x[j] + c[b].y[j] + c[b].z[j];
+        for (std::size_t j = 0; j < n_ % Block; ++j) o[j] = c[full].x[j] + c[full].y[j] + c[full].z[j];
+    }
+
+private:
+    std::size_t n_;
+    std::size_t chunks_;
+    triple_layout_detail::Buffer buf_;
+    Chunk* data_;
+};
@@ -0,0 +1,261 @@
+// ==========================================================
+// TOPIC: constinit Tables — Zero Work Before main
+// ==========================================================
+//
+// convertingConstructor.cpp / memberinialiser.cpp / this.cpp /
+// Encapsulation.cpp / structure.cpp: Conversion, MyClass, Marker,
+// myStruct — all with ordinary (non-constexpr) constructors.
+//
+// ❌ a global table of such objects is built by a dynamic
+//    initializer: a loop (or a std::map filled with inserts) that
+//    runs before main in every process, touching every page
+// ❌ one printing constructor in the table prints at startup
+//
+// ✅ ConstTables.h: constexpr constructors (printing only with
+//    Trace::On), and ConstRegistry — a sorted, binary-searched
+//    table built at compile time. `constinit` proves it: the
+//    table is data in .rodata, nothing runs before main.
+//
+// Measured here (10^5 settings, each {id, Conversion, MyClass,
+// Marker, myStruct}):
+//   1. the same table built by dynamic initializers: a std::array
+//      of the original classes, and a std::map registry — time
+//      and page faults before main, taken from markers around them
+//   2. the constinit registry: where it lives (/proc/self/maps),
+//      time and faults the first time it is scanned
+//   3. lookups: every id found in both, the same values
+//
+// Build:
+//   g++ -std=c++20 -O2 constTables.cpp -o consttables
+//
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/resource.h>
+#include "ConstTables.h"
+
+using namespace std;
+using namespace std::chrono;
+
+constexpr size_t kEntries = 100000;
+
+struct Setting {
+    uint32_t id;
+    Conversion value;
+    MyClass limit;
+    Marker passmark;
+    myStruct color;
+    constexpr uint32_t key() const { return id; }
+};
+
+constexpr Setting settingFor(uint32_t i) {
+    const int v = int(i % 1000);
+    return {3 * i + 1, v, MyClass(v * 2), Marker(40 + v % 60), myStruct{v, v + 1, v + 2}};
+}
+
+// ---- compile time ----
+constexpr ConstRegistry<Setting, 4> kSmall{{{settingFor(7), settingFor(2), settingFor(5), settingFor(0)}}};
+static_assert(kSmall[0].id == 1 && kSmall.find(22)->value.value() == 7 && kSmall.find(23) == nullptr);
+static_assert([] {
+    Conversion conv = 25;                                   // implicit conversion, in a constant expression
+    Marker m;
+    m.setPassmark(55);
+    return conv.value() + m.getPassmark() + myStruct{10, 20, 40}.sum() + MyClass(5).getX();
+}() == 25 + 55 + 70 + 5);
+
+// ---- the originals: ordinary constructors ----
+namespace original {
+
+class Conversion {
+    int a;
+
+public:
+    Conversion(int value) : a(value) {}
+    int value() const { return a; }
+};
+class MyClass {
+    int x;
+
+public:
+    MyClass(int val) : x(val) {}
+    int getX() const { return x; }
+};
+class Marker {
+    int passmark;
+
+public:
+    void setPassmark(int mark) { passmark = mark; }
+    int getPassmark() const { return passmark; }
+};
+struct myStruct {
+    int x, y, z;
+};
+
+struct Setting {
+    uint32_t id = 0;
+    Conversion value{0};
+    MyClass limit{0};
+    Marker passmark;
+    myStruct color{};
+};
+
+Setting settingFor(uint32_t i) {
+    const int v = int(i % 1000);
+    Setting s;
+    s.id = 3 * i + 1;
+    s.value = Conversion(v);
+    s.limit = MyClass(v * 2);
+    s.passmark.setPassmark(40 + v % 60);
+    s.color = {v, v + 1, v + 2};
+    return s;
+}
+
+}  // namespace original
+
+struct Mark {
+    steady_clock::time_point t;
+    long faults;
+};
+
+Mark mark() {
+    rusage u{};
+    getrusage(RUSAGE_SELF, &u);
+    return {steady_clock::now(), u.ru_minflt + u.ru_majflt};
+}
+
+// ---- 1. dynamic initialization, in definition order ----
+const Mark gBeforeArray = mark();
+const array<original::Setting, kEntries> gDynamicArray = [] {
+    array<original::Setting, kEntries> a;
+    for (uint32_t i = 0; i < kEntries; ++i) a[i] = original::settingFor(i);
+    return a;
+}();
+const Mark gBeforeMap = mark();
+const map<uint32_t, original::Setting> gDynamicMap = [] {
+    map<uint32_t, original::Setting> m;
+    for (uint32_t i = 0; i < kEntries; ++i) m.emplace(3 * i + 1, original::settingFor(i));
+    return m;
+}();
+const Mark gAfterMap = mark();
+
+// ---- 2. the same table, constant-initialized ----
+// Generated in key order: the registry only checks it (O(n) steps)
+constinit const ConstRegistry<Setting, kEntries> kSettings{[](size_t i) { return settingFor(uint32_t(i)); }};
+
+// The /proc/self/maps line of the mapping holding p
+string mappingOf(const void* p) {
+    ifstream maps("/proc/self/maps");
+    string line;
+    const auto a = reinterpret_cast<uintptr_t>(p);
+    while (getline(maps, line)) {
+        uintptr_t lo = 0, hi = 0;
+        char dash;
+        istringstream in(line);
+        if (in >> hex >> lo >> dash >> hi && a >= lo && a < hi) return line;
+    }
+    return "";
+}
+
+string permissions(const string& mapping) {
+    istringstream in(mapping);
+    string range, perms;
+    in >> range >> perms;
+    return perms;
+}
+
+double ms(steady_clock::time_point a, steady_clock::time_point b) {
+    return duration<double, milli>(b - a).count();
+}
+
+int main() {
+    const Mark atMain = mark();
+    bool ok = true;
+
+    const bool hasMaps = !mappingOf(&kSettings).empty();
+    cout << kEntries << " settings, " << sizeof(Setting) << " bytes each ("
+         << sizeof(kSettings) / 1000 << " KB)" << endl
+         << endl;
+    cout << "before main (dynamic initializers):" << endl;
+    cout << "  std::array of the original classes  " << ms(gBeforeArray.t, gBeforeMap.t) << " ms, "
+         << gBeforeMap.faults - gBeforeArray.faults << " page faults" << endl;
+    cout << "  std::map registry                   " << ms(gBeforeMap.t, gAfterMap.t) << " ms, "
+         << gAfterMap.faults - gBeforeMap.faults << " page faults, " << kEntries << " node allocations" << endl;
+    cout << "  constinit ConstRegistry             nothing runs (checked by the compiler)" << endl;
+    ok = ok && atMain.t >= gAfterMap.t;
+
+    cout << endl << "where the tables live:" << endl;
+    if (hasMaps) {
+        const string ro = mappingOf(&kSettings), rw = mappingOf(&gDynamicArray);
+        cout << "  kSettings      " << permissions(ro) << "  (read-only, from the executable)" << endl;
+        cout << "  gDynamicArray  " << permissions(rw) << "  (writable, zero pages filled at startup)" << endl;
+        ok = ok && permissions(ro).substr(0, 2) == "r-" && permissions(rw).substr(0, 2) == "rw";
+    } else {
+        cout << "  (no /proc/self/maps here)" << endl;
+    }
+
+    // ---- first touch of the constinit table ----
+    const Mark before = mark();
+    long sum = 0;
+    for (const Setting& s : kSettings) sum += s.value.value() + s.passmark.getPassmark();
+    const Mark after = mark();
+    cout << endl << "first full scan of kSettings: " << ms(before.t, after.t) << " ms, "
+         << after.faults - before.faults << " page faults (pages read in on demand), checksum " << sum << endl;
+
+    // ---- 3. lookups agree ----
+    bool same = kSettings.size() == gDynamicMap.size();
+    for (const auto& [id, d] : gDynamicMap) {
+        const Setting* s = kSettings.find(id);
+        same = same && s && s->value.value() == d.value.value() && s->limit.getX() == d.limit.getX() &&
+               s->passmark.getPassmark() == d.passmark.getPassmark() && s->color.sum() == d.color.x + d.color.y +
+               d.color.z;
+    }
+    same = same && kSettings.find(0) == nullptr && kSettings.find(2) == nullptr &&
+           kSettings.find(3 * kEntries + 1) == nullptr;
+    cout << "every id: same setting in the map and the registry: " << (same ? "yes" : "NO") << endl;
+    ok = ok && same;
+
+    // Built at run time, the registry throws instead of failing to compile
+    bool rejected = false;
+    try {
+        ConstRegistry<Setting, 3> dup{{{settingFor(1), settingFor(4), settingFor(1)}}};
+    } catch (const invalid_argument&) {
+        rejected = true;
+    }
+    ok = ok && rejected;
+
+    cout << endl << "Trace::On keeps the original's output, at run time only:" << endl << "  ";
+    Conversion traced(25, Trace::On);
+    ok = ok && traced.value() == 25;
+
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. A global whose initializer is not a constant expression is
+//    initialized by code before main — in every process, in an
+//    order between TUs the language does not fix.
+// 2. constexpr constructors make the same objects usable in
+//    constant expressions; keep side effects (printing) behind a
+//    run-time switch so the quiet path stays constexpr.
+// 3. constinit asks the compiler to PROVE static initialization:
+//    if anything would need a dynamic initializer it is a compile
+//    error, not a silent startup cost.
+// 4. A sorted constexpr array with binary search replaces a
+//    startup-built std::map: no allocations, read-only pages
+//    shared between processes and loaded only when touched.
+//
+// ⭐ One-Line Interview Answer
+// “Give the types constexpr constructors, build the table as a
+// sorted constexpr array and declare it constinit — the compiler
+// bakes it into .rodata, so there is nothing left to run before
+// main.”
@@ -0,0 +1,181 @@
+// ==========================================================
+// TOPIC: Compile-Time Enum Reflection (names, parsing, iteration)
+// ==========================================================
+//
+// enum.cpp: Color, Status, State, Mode — and, in real code, the
+// string conversions written next to them by hand:
+//
+//     if (tok == "GET") return Method::GET;
+//     else if (tok == "POST") ...                      // O(names) compares
+//
+//     std::map<std::string, Method> table{...};        // O(log n) string
+//                                                      // compares, heap init
+//
+// ✅ EnumReflect.h: the names come from the enum itself, tables
+//    are constexpr data, enumFromString = one hash + one memcmp
+//
+// Measured here: parsing 10^7 tokens (HTTP method names) with
+//   1. an if/else chain
+//   2. std::map<string, Method, less<>>
+//   3. std::unordered_map<string_view, Method>
+//   4. enumFromString<Method>
+//   5. the floor: one memcmp per token against the right name
+//
+// Build:
+//   g++ -std=c++20 -O2 enumReflect.cpp -o enumreflect
+//
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "EnumReflect.h"
+
+using namespace std;
+using namespace std::chrono;
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+// -------------------------------------------------------------
+// The enums from enum.cpp
+// -------------------------------------------------------------
+// No fixed underlying type: the probe stays inside each enum's
+// value range (the smallest bit-field holding its enumerators)
+enum Color { RED, GREEN, BLUE };
+template <>
+struct EnumRange<Color> {
+    static constexpr int min = 0;
+    static constexpr int max = 3;
+};
+
+enum ErrorCode { SUCCESS = 0, FILE_NOT_FOUND = 404, SERVER_ERROR = 500 };
+template <>
+struct EnumRange<ErrorCode> {
+    static constexpr int min = 0;
+    static constexpr int max = 511;
+};
+
+enum class State { RUNNING, WAITING, STOPPED };
+enum class Mode : char { AUTO, MANUAL };
+
+enum class Method { GET, HEAD, POST, PUT, DELETE, CONNECT, OPTIONS, TRACE, PATCH };
+
+// Everything below is evaluated by the compiler
+static_assert(enumCount<Color> == 3 && enumCount<State> == 3 && enumCount<Mode> == 2 && enumCount<Method> == 9);
+static_assert(enumName(BLUE) == "BLUE");
+static_assert(enumName(State::WAITING) == "WAITING");
+static_assert(enumName(FILE_NOT_FOUND) == "FILE_NOT_FOUND" && enumName(static_cast<ErrorCode>(403)).empty());
+static_assert(enumFromString<State>("STOPPED") == State::STOPPED);
+static_assert(enumFromString<Mode>("MANUAL") == Mode::MANUAL);
+static_assert(!enumFromString<State>("stopped") && !enumFromString<State>(""));
+static_assert(enumValues<ErrorCode>()[2] == SERVER_ERROR);
+
+__attribute__((noinline)) Method parseChain(string_view t) {
+    if (t == "GET") return Method::GET;
+    else if (t == "HEAD") return Method::HEAD;
+    else if (t == "POST") return Method::POST;
+    else if (t == "PUT") return Method::PUT;
+    else if (t == "DELETE") return Method::DELETE;
+    else if (t == "CONNECT") return Method::CONNECT;
+    else if (t == "OPTIONS") return Method::OPTIONS;
+    else if (t == "TRACE") return Method::TRACE;
+    else return Method::PATCH;
+}
+
+__attribute__((noinline)) Method parseReflect(string_view t) {
+    return enumFromString<Method>(t).value_or(Method::PATCH);
+}
+
+int main() {
+    constexpr int kTokens = 10'000'000;
+
+    cout << "State values:";
+    for (State s : enumValues<State>()) cout << ' ' << enumName(s) << '=' << static_cast<int>(s);
+    cout << "\nErrorCode values:";
+    for (ErrorCode e : enumValues<ErrorCode>()) cout << ' ' << enumName(e) << '=' << e;
+    cout << "\n\n";
+
+    // Token stream, skewed like real traffic (mostly GET/POST)
+    mt19937 rng(7);
+    discrete_distribution<int> pick({50, 5, 25, 5, 3, 1, 2, 1, 8});
+    string text;
+    vector<Method> expected(kTokens);
+    vector<string_view> tokens(kTokens);
+    vector<size_t> offsets(kTokens);
+    for (int i = 0; i < kTokens; ++i) {
+        expected[i] = static_cast<Method>(pick(rng));
+        offsets[i] = text.size();
+        text += enumName(expected[i]);
+        text += ' ';
+    }
+    for (int i = 0; i < kTokens; ++i) tokens[i] = string_view(text.data() + offsets[i], enumName(expected[i]).size());
+
+    map<string, Method, less<>> tree;
+    unordered_map<string_view, Method> hashed;
+    for (Method m : enumValues<Method>()) {
+        tree.emplace(string(enumName(m)), m);
+        hashed.emplace(enumName(m), m);
+    }
+
+    vector<Method> out(kTokens);
+    auto run = [&](auto parse) {
+        double ms = timeMs([&] {
+            for (int i = 0; i < kTokens; ++i) out[i] = parse(tokens[i]);
+        });
+        return pair<double, bool>(ms, out == expected);
+    };
+
+    auto [chainMs, chainOk] = run(parseChain);
+    auto [treeMs, treeOk] = run([&](string_view t) { return tree.find(t)->second; });
+    auto [hashMs, hashOk] = run([&](string_view t) { return hashed.find(t)->second; });
+    auto [reflectMs, reflectOk] = run(parseReflect);
+
+    // Floor: the answer is known, only the confirming memcmp runs
+    size_t equal = 0;
+    double floorMs = timeMs([&] {
+        for (int i = 0; i < kTokens; ++i) {
+            string_view name = enumNames<Method>()[static_cast<size_t>(expected[i])];
+            equal += tokens[i].size() == name.size() && memcmp(tokens[i].data(), name.data(), name.size()) == 0;
+        }
+    });
+
+    auto ns = [&](double ms) { return ms * 1e6 / kTokens; };
+    cout << "Parsing " << kTokens << " method tokens:" << endl;
+    cout << "  if/else chain          " << chainMs << " ms (" << ns(chainMs) << " ns/token)" << endl;
+    cout << "  std::map               " << treeMs << " ms (" << ns(treeMs) << " ns/token)" << endl;
+    cout << "  std::unordered_map     " << hashMs << " ms (" << ns(hashMs) << " ns/token)" << endl;
+    cout << "  enumFromString         " << reflectMs << " ms (" << ns(reflectMs) << " ns/token)" << endl;
+    cout << "  memcmp floor           " << floorMs << " ms (" << ns(floorMs) << " ns/token)" << endl;
+
+    bool ok = chainOk && treeOk && hashOk && reflectOk && equal == size_t(kTokens);
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. C++20 has no enum reflection, but __PRETTY_FUNCTION__ of a
+//    `template <auto V>` function spells the enumerator's name —
+//    enough to build the tables at compile time.
+// 2. constexpr tables are plain data in the binary: no static
+//    init order issues, no heap, usable in static_assert.
+// 3. With a fixed key set, a perfect hash (seed searched at
+//    compile time) needs exactly one string compare per lookup.
+// 4. Declared values form a constexpr array, so iterating an
+//    enum is a range-for.
+//
+// ⭐ One-Line Interview Answer
+// “Generate the enum's name table and a perfect hash at compile
+// time; to_string is an index, from_string is one hash plus one
+// memcmp, with nothing initialised at runtime.”
@@ -0,0 +1,158 @@
+// ==========================================================
+// TOPIC: Move Semantics, Sink Parameters and Copy Elision
+// ==========================================================
+//
+// copyConstructor3.cpp:
+//
+//     void DoSomething(MyClass obj);     // by value → COPY
+//     MyClass ReturnAnObject();          // return by value
+//
+// passingObj.cpp passes Player objects around the same way.
+//
+// When MyClass owns real data (here: a vector of 1000 ints)
+// every one of those copies is a heap allocation + memcpy.
+//
+// ----------------------------------------------------------
+// WHAT THIS FILE ADDS
+// ----------------------------------------------------------
+//
+// 1. MyClass gets MOVE constructor / MOVE assignment
+//    (rule of zero: defaulted, they move the vector)
+// 2. SINK overloads:
+//        Holder::Consume(const MyClass& obj);  // caller keeps it → copy
+//        Holder::Consume(MyClass&& obj);       // caller gives it  → move
+// 3. CopyCounter / CopyProbe (CopyCounter.h) count what each
+//    call site REALLY does, so we can prove zero deep copies
+//
+// Build:
+//   g++ -std=c++20 -O2 moveSemantics.cpp -o moves
+//
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "CopyCounter.h"
+
+using namespace std;
+using namespace std::chrono;
+
+class MyClass {
+public:
+    CopyCounter counter;            // instrument (counts copy/move)
+    vector<int> payload;            // the expensive part
+
+    MyClass() : payload(1000, 1) {}
+
+    // Rule of zero: compiler-generated copy AND move operations.
+    // Written out so it's visible they exist:
+    MyClass(const MyClass&) = default;
+    MyClass(MyClass&&) noexcept = default;
+    MyClass& operator=(const MyClass&) = default;
+    MyClass& operator=(MyClass&&) noexcept = default;
+
+    // Original: by value → copy from lvalues, move from rvalues
+    void DoSomething(MyClass obj) { sink += obj.payload.size(); }
+
+    // Read-only access: no copy at all
+    void Inspect(const MyClass& obj) { sink += obj.payload.size(); }
+
+    // NRVO: obj is built directly in the caller's storage
+    MyClass ReturnAnObject() {
+        MyClass obj;
+        return obj;                 // NOT "return std::move(obj)" (blocks NRVO)
+    }
+
+    // Guaranteed elision (C++17): prvalue returned directly
+    static MyClass Make() { return MyClass(); }
+
+    size_t sink = 0;
+};
+
+// Keeps the object it is given → a SINK
+class Holder {
+public:
+    MyClass stored;
+
+    // Sink overloads: the caller decides copy vs move
+    void Consume(const MyClass& obj) { stored = obj; }
+    void Consume(MyClass&& obj) { stored = std::move(obj); }
+};
+
+// passingObj.cpp's Player, with a by-value sink for the name
+class Player {
+public:
+    CopyCounter counter;
+    string name;
+
+    // Take by value, then MOVE into the member:
+    // lvalue argument → 1 copy, rvalue argument → 0 copies
+    void SetName(string n) { name = std::move(n); }
+};
+
+void Display(const Player& p) { (void)p.name.size(); }   // was Display(Player*)
+
+int main() {
+    MyClass obj1, obj2;
+    Holder holder;
+
+    cout << "---- which call sites copy? ----" << endl;
+    { CopyProbe p("DoSomething(obj1)            [by value]"); obj2.DoSomething(obj1); p.report(); }
+    { CopyProbe p("DoSomething(std::move(tmp))  [by value]"); MyClass tmp; obj2.DoSomething(std::move(tmp)); p.report(); }
+    { CopyProbe p("DoSomething(MyClass())       [prvalue]"); obj2.DoSomething(MyClass()); p.report(); }
+    { CopyProbe p("Inspect(obj1)                [const&]"); obj2.Inspect(obj1); p.report(); }
+    { CopyProbe p("Consume(obj1)                [sink, lvalue]"); holder.Consume(obj1); p.report(); }
+    { CopyProbe p("Consume(std::move(tmp))      [sink, rvalue]"); MyClass tmp; holder.Consume(std::move(tmp)); p.report(); }
+    { CopyProbe p("MyClass r = ReturnAnObject() [NRVO]"); MyClass r = obj2.ReturnAnObject(); p.report(); }
+    { CopyProbe p("MyClass r = MyClass::Make()  [RVO]"); MyClass r = MyClass::Make(); p.report(); }
+    { CopyProbe p("obj3 = obj1                  [copy-assign]"); MyClass obj3; obj3 = obj1; p.report(); }
+    { CopyProbe p("obj3 = ReturnAnObject()      [move-assign]"); MyClass obj3; obj3 = obj2.ReturnAnObject(); p.report(); }
+    { CopyProbe p("vector<MyClass>.push_back(move) x3"); vector<MyClass> v; v.reserve(3);
+      for (int i = 0; i < 3; ++i) { MyClass t; v.push_back(std::move(t)); } p.report(); }
+
+    Player player;
+    string n = "Aman";
+    player.SetName(n);               // 1 string copy (caller keeps n)
+    player.SetName("Ravi");          // 0 copies: temporary is moved
+    Display(player);                 // by const& → no Player copy
+    cout << "player name: " << player.name << endl;
+
+    // ---- hot loop: copy vs move ----
+    const int iters = 200000;
+    auto t0 = steady_clock::now();
+    for (int i = 0; i < iters; ++i) obj2.DoSomething(obj1);           // deep copy each time
+    double copyMs = duration<double, milli>(steady_clock::now() - t0).count();
+
+    CopyProbe hot("hot loop: Inspect(obj1) + move round-trip");
+    t0 = steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+        obj2.Inspect(obj1);                                            // no copy
+        holder.Consume(std::move(obj1));                               // move in
+        obj1 = std::move(holder.stored);                               // move back
+    }
+    double moveMs = duration<double, milli>(steady_clock::now() - t0).count();
+    hot.report();
+
+    cout << "DoSomething(obj1) loop: " << copyMs << " ms,  "
+         << "const& + moves loop: " << moveMs << " ms" << endl;
+    return hot.delta().copies == 0 ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. Pass by const& when you only READ the object.
+// 2. For SINK parameters (you keep a copy) either
+//    - take by value and std::move into place, or
+//    - overload const& (copy) and && (move).
+// 3. Return local objects by value — NRVO / move kicks in.
+//    Writing "return std::move(local)" DISABLES NRVO.
+// 4. Mark move operations noexcept, otherwise vector growth
+//    falls back to copying.
+//
+// ⭐ One-Line Interview Answer
+// “Give resource-owning classes noexcept move operations,
+// take read-only parameters by const&, sink parameters by
+// value or &&, and return by value so the compiler can elide
+// or move instead of deep-copying.”
@@ -0,0 +1,179 @@
+// ==========================================================
+// TOPIC: Batched Person Action Recording instead of cout+endl
+// ==========================================================
+//
+// Person.cpp (before):
+//
+//     Person::Person()    { cout << "Person created." << endl; }
+//     void Person::Walk() { cout << "Person is walking." << endl; }
+//
+// ❌ endl = flush = one write(2) per action
+// ❌ new/delete per person, and two lines just for existing
+//
+// ✅ Person(ActionSink&) (see ActionSink.h): the sink decides —
+//    StreamSink keeps the old behaviour, BatchedFileSink sends
+//    thousands of lines per writev(), RingSink / NullSink keep
+//    them in memory or drop them
+// ✅ PersonPool (see PersonPool.h): one block for all people,
+//    no per-object Created/Destroyed I/O
+//
+// Measured here (kPeople agents, each Crawl/Walk/Stand/Run):
+//   1. new Person + StreamSink(file)       (the original pattern)
+//   2. new Person + BatchedFileSink        (same bytes, batched)
+//   3. PersonPool + BatchedFileSink
+//   4. PersonPool + RingSink / NullSink
+//
+// Build:
+//   g++ -std=c++20 -O2 personActions.cpp Person.cpp -o personactions
+//
+#include <chrono>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include "Person.h"
+#include "PersonPool.h"
+
+using namespace std;
+using namespace std::chrono;
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+static void simulate(Person& p) {
+    p.Crawl();
+    p.Walk();
+    p.Stand();
+    p.Run();
+}
+
+// main.cpp's lifecycle, once per agent
+static void simulateHeap(int people, ActionSink& sink) {
+    for (int i = 0; i < people; ++i) {
+        Person* p = new Person(sink);
+        simulate(*p);
+        delete p;
+    }
+}
+
+static string readFile(const char* path) {
+    ifstream in(path, ios::binary);
+    ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+static int openTruncated(const char* path) {
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) perror(path);
+    return fd;
+}
+
+int main() {
+    constexpr int kPeople = 200'000;
+    const char* streamPath = "/tmp/person_stream.log";
+    const char* batchPath = "/tmp/person_batched.log";
+    const char* poolPath = "/tmp/person_pool.log";
+    bool ok = true;
+
+    // The original demo, unchanged behaviour through the default sink
+    {
+        Person* p = new Person();
+        p->Crawl();
+        p->Walk();
+        p->Stand();
+        p->Run();
+        delete p;
+        cout << endl;
+    }
+
+    double streamMs = timeMs([&] {
+        ofstream out(streamPath, ios::binary | ios::trunc);
+        StreamSink sink(out);
+        simulateHeap(kPeople, sink);
+    });
+
+    uint64_t batchSyscalls = 0;
+    double batchMs = timeMs([&] {
+        int fd = openTruncated(batchPath);
+        {
+            BatchedFileSink sink(fd);
+            simulateHeap(kPeople, sink);
+            sink.flush();
+            batchSyscalls = sink.syscalls();
+        }
+        ::close(fd);
+    });
+
+    double poolMs = timeMs([&] {
+        int fd = openTruncated(poolPath);
+        {
+            BatchedFileSink sink(fd);
+            PersonPool people(kPeople, sink);
+            for (Person& p : people) simulate(p);
+        }
+        ::close(fd);
+    });
+
+    RingSink ring(1024);
+    double ringMs = timeMs([&] {
+        PersonPool people(kPeople, ring);
+        for (Person& p : people) simulate(p);
+    });
+
+    NullSink null;
+    double nullMs = timeMs([&] {
+        PersonPool people(kPeople, null);
+        for (Person& p : people) simulate(p);
+    });
+
+    string streamBytes = readFile(streamPath);
+    string batchBytes = readFile(batchPath);
+    string poolBytes = readFile(poolPath);
+    ok = ok && !streamBytes.empty() && streamBytes == batchBytes;
+    ok = ok && poolBytes.size() == size_t(kPeople) * (personActionLine(PersonAction::Crawl).size() +
+                                                      personActionLine(PersonAction::Walk).size() +
+                                                      personActionLine(PersonAction::Stand).size() +
+                                                      personActionLine(PersonAction::Run).size());
+    ok = ok && ring.recorded() == uint64_t(kPeople) * 4 && ring.count(PersonAction::Created) == 0 &&
+         ring.count(PersonAction::Walk) == uint64_t(kPeople) && ring.recent().size() == 1024 &&
+         ring.recent().back() == PersonAction::Run;
+
+    auto perAction = [&](double ms, int actionsPerPerson) { return ms * 1e6 / (double(kPeople) * actionsPerPerson); };
+    cout << kPeople << " people x Crawl/Walk/Stand/Run:" << endl;
+    cout << "  new + StreamSink (endl)      " << streamMs << " ms (" << perAction(streamMs, 6) << " ns/line, "
+         << kPeople * 6 << " flushes)" << endl;
+    cout << "  new + BatchedFileSink        " << batchMs << " ms (" << perAction(batchMs, 6) << " ns/line, "
+         << batchSyscalls << " writev calls), same bytes: " << (streamBytes == batchBytes ? "yes" : "NO") << endl;
+    cout << "  PersonPool + BatchedFileSink " << poolMs << " ms (" << perAction(poolMs, 4) << " ns/action)" << endl;
+    cout << "  PersonPool + RingSink        " << ringMs << " ms (" << perAction(ringMs, 4) << " ns/action)" << endl;
+    cout << "  PersonPool + NullSink        " << nullMs << " ms (" << perAction(nullMs, 4) << " ns/action)" << endl;
+
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. endl is '\n' PLUS a flush; in a loop it makes every line a
+//    system call.
+// 2. Hiding output behind an interface chosen at construction
+//    (dependency injection) lets the same class log, buffer or
+//    stay silent without touching its methods.
+// 3. writev() gathers many buffers into one system call; for
+//    fixed messages the iovecs point straight at the constants.
+// 4. Bulk construction in one block removes both the per-object
+//    allocation and the per-object side effects of ctor/dtor.
+//
+// ⭐ One-Line Interview Answer
+// “Inject the output sink instead of hard-wiring cout+endl, batch
+// the lines into writev(), and build agents in bulk — the I/O
+// stops being the hot path.”
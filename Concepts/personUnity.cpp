@@ -0,0 +1,15 @@
+// ==========================================================
+// personUnity.cpp — unity (jumbo) build of the Person target
+// ==========================================================
+//
+// One TU for the whole target: headers are parsed once and the
+// compiler sees every function (cross-file inlining without LTO).
+// A change to any file rebuilds all of them, so this is the cold
+// / release build; incremental builds keep the per-TU mode.
+// Build modes are listed in PersonPch.h.
+//
+// Build:
+//   g++ -std=c++20 -O2 personUnity.cpp -o person
+//
+#include "Person.cpp"
+#include "main.cpp"
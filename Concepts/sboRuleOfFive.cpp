@@ -0,0 +1,92 @@
+// ==========================================================
+// TOPIC: Small-Buffer Optimization (SBO) for RuleOfFive
+// ==========================================================
+//
+// RuleOfFive (shallowvsdeep.cpp) owns ONE int, yet every
+// object does "new int" — a heap allocation for 4 bytes.
+//
+// std::string avoids this for short strings: the characters
+// live INSIDE the string object (small buffer) and the heap
+// is only used for long strings.
+//
+// BasicSboRuleOfFive<N> (ResourceTypes.h) does the same:
+//
+//     +----------------------------+
+//     | inline_[N] / heap_ pointer |  ← union
+//     | size_ | capacity_          |  capacity_ == 0 → inline
+//     +----------------------------+
+//
+// - payload <= N bytes → NO allocation, copy/move = memcpy
+// - payload  > N bytes → heap, move = steal the pointer
+//
+// The benchmark counts allocations with CountingPolicy.
+//
+// Build:
+//   g++ -std=c++20 -O2 sboRuleOfFive.cpp -o sbo
+//
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ResourceTypes.h"
+
+using namespace std;
+using namespace std::chrono;
+
+using Counted = CountingPolicy<MallocPolicy>;
+
+template <typename T, typename Make>
+void run(const char* name, int n, Make make) {
+    Counted::reset();
+    auto t0 = steady_clock::now();
+    long long checksum = 0;
+    {
+        vector<T> v;
+        for (int i = 0; i < n; ++i) v.push_back(make(i));   // moves on growth
+        vector<T> copy = v;                                  // n copies
+        vector<T> moved;
+        moved.reserve(n);
+        for (T& x : copy) moved.push_back(std::move(x));     // n moves
+        for (const T& x : moved) checksum += x.value();
+    }
+    double ms = duration<double, milli>(steady_clock::now() - t0).count();
+    cout << name << ": " << ms << " ms, allocations: " << Counted::allocations
+         << ", frees: " << Counted::deallocations << ", checksum " << checksum << endl;
+}
+
+int main() {
+    const int n = 1000000;
+    string big(64, 'x');
+
+    cout << "sizeof(RuleOfFive) = " << sizeof(BasicRuleOfFive<Counted>)
+         << ", sizeof(SboRuleOfFive<16>) = " << sizeof(BasicSboRuleOfFive<16, Counted>) << endl;
+
+    // Small payload: one int
+    run<BasicRuleOfFive<Counted>>("RuleOfFive       int     ", n,
+                                  [](int i) { return BasicRuleOfFive<Counted>(i); });
+    run<BasicSboRuleOfFive<16, Counted>>("SboRuleOfFive<16> int    ", n,
+                                         [](int i) { return BasicSboRuleOfFive<16, Counted>(i); });
+
+    // Large payload: 64 bytes → SBO falls back to the heap
+    run<BasicSboRuleOfFive<16, Counted>>("SboRuleOfFive<16> 64 B   ", n, [&](int i) {
+        big[0] = (char)i;
+        return BasicSboRuleOfFive<16, Counted>(big.data(), big.size());
+    });
+    return 0;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. SBO trades a bigger object for no heap on small payloads.
+// 2. A union of "inline bytes" and "heap pointer" plus a flag
+//    (here capacity_ == 0) is the classic layout.
+// 3. Moving an inline payload must COPY the bytes (there is no
+//    pointer to steal) — cheap because N is small.
+// 4. Pick N from real data: most payloads should fit.
+//
+// ⭐ One-Line Interview Answer
+// “Small-buffer optimization stores small payloads inside the
+// object itself, so they need no heap allocation and copying
+// or moving them is just a memcpy.”
@@ -0,0 +1,156 @@
+// ==========================================================
+// TOPIC: AoS vs SoA vs AoSoA for a Plain Struct
+// ==========================================================
+//
+// structure.cpp:
+//
+//     myStruct *obj = new myStruct();
+//     obj->x = 10; obj->y = 20; obj->z = 40;
+//     cout << obj->sum();
+//
+// ❌ One heap allocation per triple; an array of them is an array
+//    of pointers to scattered 12-byte blocks
+// ❌ sum() one object at a time, never SIMD
+//
+// ✅ TripleArray<Layout> (see TripleLayout.h): the same logical
+//    triple stored AoS, SoA or AoSoA<8>, with a bulk sum_all()
+//
+// Measured here (kCount triples):
+//   1. myStruct* per element, ->sum() in a loop  (the original)
+//   2. sum_all() in each layout                  (streaming, SIMD)
+//   3. get(i) at random indices                  (one triple at a time)
+//   4. bytes used per layout
+//
+// Build:
+//   g++ -std=c++20 -O3 -march=native structLayouts.cpp -o structlayouts
+//   (-fopt-info-vec-optimized shows which sum_all loops vectorized)
+//
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "TripleLayout.h"
+
+using namespace std;
+using namespace std::chrono;
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+struct myStruct {
+    int x;
+    int y;
+    int z;
+    int sum() { return x + y + z; }
+};
+
+constexpr size_t kCount = 1 << 22;        // 4M triples, 48 MB as 12-byte records
+constexpr int kRounds = 10;
+constexpr size_t kRandom = 1 << 22;
+
+struct Row {
+    string name;
+    double streamMs;
+    double randomMs;
+    size_t bytes;
+    bool ok;
+};
+
+template <typename Array>
+Row measure(const string& name, const vector<Triple>& source, const vector<uint32_t>& randomIdx,
+            const vector<int>& expected) {
+    Array a(source.size());
+    for (size_t i = 0; i < source.size(); ++i) a.set(i, source[i]);
+    vector<int> out(source.size());
+
+    double streamMs = timeMs([&] {
+        for (int r = 0; r < kRounds; ++r) a.sum_all(out);
+    }) / kRounds;
+    bool ok = out == expected;
+
+    long long acc = 0;
+    double randomMs = timeMs([&] {
+        for (uint32_t i : randomIdx) acc += a.get(i).sum();
+    });
+    long long want = 0;
+    for (uint32_t i : randomIdx) want += expected[i];
+    return {name, streamMs, randomMs, a.bytes(), ok && acc == want};
+}
+
+int main() {
+    mt19937 rng(11);
+    uniform_int_distribution<int> value(-1000, 1000);
+    vector<Triple> source(kCount);
+    vector<int> expected(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        source[i] = {value(rng), value(rng), value(rng)};
+        expected[i] = source[i].sum();
+    }
+    vector<uint32_t> randomIdx(kRandom);
+    for (auto& i : randomIdx) i = static_cast<uint32_t>(rng() % kCount);
+
+    // The original: one new myStruct per triple, scattered
+    vector<unique_ptr<myStruct>> heap;
+    heap.reserve(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        heap.push_back(make_unique<myStruct>());
+        heap.back()->x = source[i].x;
+        heap.back()->y = source[i].y;
+        heap.back()->z = source[i].z;
+        if (i % 3 == 0) delete new myStruct();        // interleave allocations as a real program would
+    }
+    vector<int> out(kCount);
+    double heapMs = timeMs([&] {
+        for (int r = 0; r < kRounds; ++r)
+            for (size_t i = 0; i < kCount; ++i) out[i] = heap[i]->sum();
+    }) / kRounds;
+    bool heapOk = out == expected;
+
+    vector<Row> rows;
+    rows.push_back(measure<TripleArray<layout::AoS<>>>("AoS (12-byte records)", source, randomIdx, expected));
+    rows.push_back(measure<TripleArray<layout::AoS<16>>>("AoS<16> (padded)", source, randomIdx, expected));
+    rows.push_back(measure<TripleArray<layout::SoA>>("SoA", source, randomIdx, expected));
+    rows.push_back(measure<TripleArray<layout::AoSoA<8>>>("AoSoA<8>", source, randomIdx, expected));
+    rows.push_back(measure<TripleArray<layout::AoSoA<16>>>("AoSoA<16>", source, randomIdx, expected));
+
+    cout << fixed << setprecision(2);
+    cout << kCount << " triples, sum of x+y+z for every element (per pass) and " << kRandom << " random get():\n";
+    cout << "  " << left << setw(24) << "layout" << right << setw(12) << "sum_all ms" << setw(12) << "GB/s in"
+         << setw(14) << "random ms" << setw(10) << "MB" << '\n';
+    cout << "  " << left << setw(24) << "new myStruct each" << right << setw(12) << heapMs << setw(12)
+         << kCount * 12 / heapMs / 1e6 << setw(14) << "-" << setw(10) << "-" << '\n';
+    bool ok = heapOk;
+    for (const Row& r : rows) {
+        cout << "  " << left << setw(24) << r.name << right << setw(12) << r.streamMs << setw(12)
+             << r.bytes / r.streamMs / 1e6 << setw(14) << r.randomMs << setw(10) << r.bytes / 1e6 << '\n';
+        ok = ok && r.ok;
+    }
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. AoS keeps a whole object in one place: best when each
+//    access touches one object at a random position.
+// 2. SoA puts each field in its own array: unit-stride loads, so
+//    bulk kernels vectorize with no shuffling, and a kernel that
+//    reads one field reads only that field's bytes.
+// 3. AoSoA keeps SoA's SIMD-friendly blocks but a whole object
+//    still lives within one block (one or two cache lines).
+// 4. Choosing a layout is choosing for the access pattern — so
+//    keep the logical type separate from its storage.
+//
+// ⭐ One-Line Interview Answer
+// “Store the same struct as AoS, SoA or AoSoA behind one interface
+// and pick per workload: SoA/AoSoA for streaming SIMD kernels,
+// AoS for random whole-object access.”
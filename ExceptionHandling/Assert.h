@@ -0,0 +1,260 @@
+// ======================================================
+// Assert.h — leveled, sampled, per-site assertions
+// ======================================================
+//
+// assertionExaple.cpp:
+//
+//     assert(index >= 0 && index < maxPlayers);
+//
+// assert() is all-or-nothing: on in debug, GONE under NDEBUG.
+// Bounds checks are exactly the ones worth keeping in
+// production if they are cheap enough.
+//
+// MACROS, by cost class:
+//   FAST_ASSERT(cond)         cheap check, kept in production;
+//                             FATAL (handler runs, then abort)
+//   FAST_CHECK(cond)          same check, but the program goes on
+//                             after the handler returns
+//   SAMPLED_ASSERT(N, cond)   checks 1 call in N (N constant)
+//   DEBUG_ASSERT(cond)        expensive check, debug builds only
+//
+// ASSERT_LEVEL (compile time):
+//   0 → everything compiled out (cond is not evaluated)
+//   1 → FAST + SAMPLED          (default with NDEBUG)
+//   2 → all of them             (default without NDEBUG)
+//
+// Every assertion SITE is a constinit static object:
+//   - FAST_ASSERT's hot path is the condition and one
+//     predicted branch, nothing else; all failure handling
+//     lives in a [[gnu::cold]], noinline, [[noreturn]] function
+//   - FAST_CHECK's failure path RETURNS, so in the tightest
+//     loops the compiler may keep a value in memory instead of
+//     a register across it; prefer FAST_ASSERT there
+//   - SAMPLED/DEBUG first read the site state (and the sample
+//     counter), so an off or unsampled call skips the costly
+//     condition. Sampling pays off for EXPENSIVE checks
+//     (scans, invariants), not for a single compare
+//   - sites can be switched off/on by file (and line):
+//       assertions::setEnabled("Game.cpp", 42, false);
+//     an off FAST_CHECK site still evaluates (it is one
+//     compare) but its failures are only counted, not
+//     reported; FAST_ASSERT sites are always on
+//   - failures are counted per site (a FAST site appears in
+//     the dump once it has failed):
+//       assertions::dump(stderr);
+//
+// On failure the installed handler runs. The default one
+// prints the site and aborts, exactly like assert().
+// Production code installs a handler that logs and returns
+// (FAST_ASSERT still aborts after it).
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#ifndef ASSERT_LEVEL
+#ifdef NDEBUG
+#define ASSERT_LEVEL 1
+#else
+#define ASSERT_LEVEL 2
+#endif
+#endif
+
+namespace assertions {
+
+struct Site {
+    const char* file;
+    unsigned line;
+    const char* expr;
+    std::uint32_t sampleEvery;                     // 1 = every call
+
+    // bit 0: registered, bit 1: disabled → 1 means "check it"
+    std::atomic<std::uint8_t> state{0};
+    std::atomic<std::uint32_t> sampleCounter{0};   // approximate under threads
+    std::atomic<std::uint64_t> checks{0};          // sampled sites only
+    std::atomic<std::uint64_t> failures{0};
+    Site* next = nullptr;
+
+    constexpr Site(const char* f, unsigned l, const char* e, std::uint32_t every)
+        : file(f), line(l), expr(e), sampleEvery(every) {}
+};
+
+constexpr std::uint8_t kRegistered = 1;
+constexpr std::uint8_t kDisabled = 2;
+
+using Handler = void (*)(const Site&);
+
+namespace detail {
+
+inline std::atomic<Site*>& head() {
+    static std::atomic<Site*> h{nullptr};
+    return h;
+}
+
+inline void defaultHandler(const Site& s) {
+    std::fprintf(stderr, "Assertion failed: %s, file %s, line %u\n", s.expr, s.file, s.line);
+    std::abort();
+}
+
+inline std::atomic<Handler>& handler() {
+    static std::atomic<Handler> h{&defaultHandler};
+    return h;
+}
+
+struct Rule {
+    const char* file;    // suffix match; must outlive the rule (a literal)
+    unsigned line;       // 0 = every line
+    bool enabled;
+};
+
+struct Rules {
+    std::mutex lock;
+    Rule rules[32];
+    int count = 0;
+};
+
+inline Rules& rules() {
+    static Rules r;
+    return r;
+}
+
+inline bool matches(const Site& s, const Rule& r) {
+    std::size_t fl = std::strlen(r.file), sl = std::strlen(s.file);
+    return sl >= fl && std::strcmp(s.file + sl - fl, r.file) == 0 && (r.line == 0 || r.line == s.line);
+}
+
+inline void apply(Site& s, const Rule& r) {
+    if (!matches(s, r)) return;
+    if (r.enabled) s.state.fetch_and(static_cast<std::uint8_t>(~kDisabled), std::memory_order_relaxed);
+    else s.state.fetch_or(kDisabled, std::memory_order_relaxed);
+}
+
+// Publish the site exactly once and apply the rules set so far
+[[gnu::cold, gnu::noinline]] inline void registerSite(Site& s) {
+    std::lock_guard<std::mutex> g(rules().lock);
+    if (s.state.load(std::memory_order_relaxed) & kRegistered) return;
+    for (int i = 0; i < rules().count; ++i) apply(s, rules().rules[i]);
+    s.next = head().load(std::memory_order_relaxed);
+    s.state.fetch_or(kRegistered, std::memory_order_relaxed);
+    head().store(&s, std::memory_order_release);
+}
+
+// SAMPLED / DEBUG sites: decide BEFORE evaluating the (costly) condition
+template <std::uint32_t Every>
+[[gnu::always_inline]] inline bool shouldCheck(Site& s) {
+    std::uint8_t st = s.state.load(std::memory_order_relaxed);
+    if (st != kRegistered) [[unlikely]] {
+        if (!(st & kRegistered)) registerSite(s);
+        if (s.state.load(std::memory_order_relaxed) & kDisabled) return false;
+    }
+    if constexpr (Every > 1) {
+        // Plain load + store, no locked RMW: a lost increment
+        // under contention only shifts the sample slightly
+        std::uint32_t c = s.sampleCounter.load(std::memory_order_relaxed) + 1;
+        if (c < Every) {
+            s.sampleCounter.store(c, std::memory_order_relaxed);
+            return false;
+        }
+        s.sampleCounter.store(0, std::memory_order_relaxed);
+        s.checks.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+// Every failure ends up here; FAST sites register on their first one
+[[gnu::cold, gnu::noinline]] inline void fail(Site& s) {
+    if (!(s.state.load(std::memory_order_acquire) & kRegistered)) registerSite(s);
+    s.failures.fetch_add(1, std::memory_order_relaxed);
+    if (s.state.load(std::memory_order_relaxed) & kDisabled) return;   // muted
+    handler().load(std::memory_order_acquire)(s);
+}
+
+// FAST_ASSERT: nothing after the failure, so the caller keeps
+// its registers across the check (no spills in hot loops)
+[[noreturn, gnu::cold, gnu::noinline]] inline void failFatal(Site& s) {
+    if (!(s.state.load(std::memory_order_acquire) & kRegistered)) registerSite(s);
+    s.failures.fetch_add(1, std::memory_order_relaxed);
+    handler().load(std::memory_order_acquire)(s);
+    std::abort();
+}
+
+}  // namespace detail
+
+// Returns the previous handler
+inline Handler setHandler(Handler h) {
+    return detail::handler().exchange(h ? h : &detail::defaultHandler, std::memory_order_acq_rel);
+}
+
+// Turns the sites whose file name ends with `file` (and whose
+// line is `line`, unless line == 0) on or off. Applies to sites
+// seen so far AND to sites registering later.
+inline void setEnabled(const char* file, unsigned line, bool enabled) {
+    auto& r = detail::rules();
+    std::lock_guard<std::mutex> g(r.lock);
+    detail::Rule rule{file, line, enabled};
+    if (r.count < 32) r.rules[r.count++] = rule;
+    for (Site* s = detail::head().load(std::memory_order_acquire); s; s = s->next) detail::apply(*s, rule);
+}
+
+// One line per registered site: location, expression, counters
+inline void dump(std::FILE* out) {
+    std::fprintf(out, "%-28s %-40s %10s %10s %s\n", "site", "expression", "checks", "failures", "state");
+    for (Site* s = detail::head().load(std::memory_order_acquire); s; s = s->next) {
+        const char* base = std::strrchr(s->file, '/');
+        char where[64];
+        std::snprintf(where, sizeof where, "%s:%u", base ? base + 1 : s->file, s->line);
+        char checks[24];
+        if (s->sampleEvery > 1)
+            std::snprintf(checks, sizeof checks, "%llu", (unsigned long long)s->checks.load());
+        else
+            std::snprintf(checks, sizeof checks, "every");
+        std::fprintf(out, "%-28s %-40.40s %10s %10llu %s\n", where, s->expr, checks,
+                     (unsigned long long)s->failures.load(),
+                     (s->state.load() & kDisabled) ? "off" : "on");
+    }
+}
+
+}  // namespace assertions
+
+// FAST: the condition alone is the hot path; the site is only touched on failure
+#define ASSERT_FAST_IMPL_(failFn, cond)                                                      \
+    do {                                                                                     \
+        static constinit ::assertions::Site assertSite_{__FILE__, __LINE__, #cond, 1u};      \
+        if (!(cond)) [[unlikely]]                                                            \
+            ::assertions::detail::failFn(assertSite_);                                       \
+    } while (0)
+
+// SAMPLED / DEBUG: site state (and sample counter) first, then the condition
+#define ASSERT_GATED_IMPL_(every, cond)                                                      \
+    do {                                                                                     \
+        static constinit ::assertions::Site assertSite_{__FILE__, __LINE__, #cond, (every)}; \
+        if (::assertions::detail::shouldCheck<(every)>(assertSite_) && !(cond)) [[unlikely]] \
+            ::assertions::detail::fail(assertSite_);                                         \
+    } while (0)
+
+#define ASSERT_OFF_(cond)      \
+    do {                       \
+        (void)sizeof(!(cond)); \
+    } while (0)
+
+#if ASSERT_LEVEL >= 1
+#define FAST_ASSERT(cond) ASSERT_FAST_IMPL_(failFatal, cond)
+#define FAST_CHECK(cond) ASSERT_FAST_IMPL_(fail, cond)
+#define SAMPLED_ASSERT(N, cond) ASSERT_GATED_IMPL_(N, cond)
+#else
+#define FAST_ASSERT(cond) ASSERT_OFF_(cond)
+#define FAST_CHECK(cond) ASSERT_OFF_(cond)
+#define SAMPLED_ASSERT(N, cond) ASSERT_OFF_(cond)
+#endif
+
+#if ASSERT_LEVEL >= 2
+#define DEBUG_ASSERT(cond) ASSERT_GATED_IMPL_(1u, cond)
+#else
+#define DEBUG_ASSERT(cond) ASSERT_OFF_(cond)
+#endif
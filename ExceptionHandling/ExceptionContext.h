@@ -0,0 +1,259 @@
+// ======================================================
+// ExceptionContext.h — throw/rethrow chains without the heap
+// ======================================================
+//
+// Rethrow.cpp / re-throwing.cpp pass an error up through
+// several layers. The usual way to add context on the way:
+//
+//     catch (const GeneralException& e) {
+//         throw GeneralException(string("Controller: ") + e.what());
+//     }
+//
+// Every layer allocates (a new std::string, concatenation,
+// or an exception_ptr for std::throw_with_nested). In a burst
+// of failures on many threads that is allocator contention.
+//
+// ContextException is just a handle (vtable pointer + frame
+// pointer + generation) to a FRAME in a per-thread,
+// preallocated ring (the exception arena). A frame stores
+//   - a format string with {} placeholders (a literal)
+//   - up to 4 arguments (integer / double / const char* literal)
+//   - the source location
+//   - the frame it was thrown because of (its cause)
+// Nothing is formatted at throw time. what() formats the whole
+// chain ONCE, lazily, into the frame's own buffer:
+//
+//     throwContext("read failed (fd {})", fd);
+//     ...
+//     catch (const ContextException& e) {
+//         rethrowWithContext(e, "loading {}", "config");
+//     }
+//     e.what() → "loading config: read failed (fd 3)"
+//
+// Limits:
+// - frames are reused after kFrames throws on the same thread;
+//   an older exception then reports "<expired context>"
+//   instead of reading recycled data (checked with a generation)
+// - a chain belongs to the thread that threw it: call what()
+//   before handing the exception to another thread
+// - string arguments are stored as pointers: pass literals or
+//   strings that outlive the exception
+// - the C++ runtime still allocates its small exception header
+//   for each throw; this removes every allocation ON TOP of it
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <source_location>
+#include <type_traits>
+
+namespace exception_context_detail {
+
+constexpr std::size_t kFrames = 32;      // per thread
+constexpr std::size_t kMaxArgs = 4;
+constexpr std::size_t kTextBytes = 256;  // formatted chain, truncated beyond
+
+struct Arg {
+    enum Kind : std::uint8_t { Int, Uint, Double, Str } kind;
+    union {
+        long long i;
+        unsigned long long u;
+        double d;
+        const char* s;
+    };
+};
+
+template <typename T>
+Arg makeArg(T v) {
+    Arg a{};
+    if constexpr (std::is_floating_point_v<T>) {
+        a.kind = Arg::Double;
+        a.d = static_cast<double>(v);
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        a.kind = Arg::Int;
+        a.i = v;
+    } else if constexpr (std::is_integral_v<T>) {
+        a.kind = Arg::Uint;
+        a.u = v;
+    } else {
+        static_assert(std::is_convertible_v<T, const char*>,
+                      "context arguments: integers, floating point or const char*");
+        a.kind = Arg::Str;
+        a.s = v;
+    }
+    return a;
+}
+
+struct Frame {
+    const char* fmt;
+    Arg args[kMaxArgs];
+    std::uint8_t argc;
+    const char* file;
+    unsigned line;
+    const Frame* cause;
+    std::uint32_t causeGeneration;
+    std::uint32_t generation;
+    mutable bool formatted;
+    mutable char text[kTextBytes];
+};
+
+struct Arena {
+    Frame frames[kFrames];
+    std::uint32_t next = 0;
+    std::uint32_t generation = 0;
+
+    Frame* acquire() {
+        Frame* f = &frames[next];
+        next = (next + 1) % kFrames;
+        f->generation = ++generation;
+        f->formatted = false;
+        return f;
+    }
+};
+
+inline Arena& arena() {
+    thread_local Arena a;
+    return a;
+}
+
+// Bounded writer into a fixed buffer (no allocation, truncates)
+struct Writer {
+    char* out;
+    std::size_t cap;
+    std::size_t len = 0;
+
+    void put(const char* s, std::size_t n) {
+        std::size_t room = cap - 1 - len;
+        if (n > room) n = room;
+        std::memcpy(out + len, s, n);
+        len += n;
+    }
+    void put(const char* s) { put(s, std::strlen(s)); }
+    void put(const Arg& a) {
+        char num[32];
+        int n = 0;
+        switch (a.kind) {
+            case Arg::Int: n = std::snprintf(num, sizeof num, "%lld", a.i); break;
+            case Arg::Uint: n = std::snprintf(num, sizeof num, "%llu", a.u); break;
+            case Arg::Double: n = std::snprintf(num, sizeof num, "%g", a.d); break;
+            case Arg::Str: put(a.s ? a.s : "(null)"); return;
+        }
+        put(num, static_cast<std::size_t>(n > 0 ? n : 0));
+    }
+};
+
+inline void formatOne(Writer& w, const Frame& f) {
+    std::size_t arg = 0;
+    for (const char* p = f.fmt; *p; ++p) {
+        if (p[0] == '{' && p[1] == '}' && arg < f.argc) {
+            w.put(f.args[arg++]);
+            ++p;
+        } else {
+            w.put(p, 1);
+        }
+    }
+}
+
+inline bool alive(const Frame* f, std::uint32_t generation) {
+    return f && f->generation == generation;
+}
+
+}  // namespace exception_context_detail
+
+// A format literal + where it was written (captured implicitly)
+struct ContextFormat {
+    const char* fmt;
+    std::source_location where;
+
+    ContextFormat(const char* f, std::source_location w = std::source_location::current()) noexcept
+        : fmt(f), where(w) {}
+};
+
+class ContextException;
+
+template <typename... A>
+ContextException makeContext(const ContextException* cause, ContextFormat fmt, A... args);
+
+class ContextException : public std::exception {
+public:
+    ContextException(exception_context_detail::Frame* f, std::uint32_t generation) noexcept
+        : frame_(f), generation_(generation) {}
+
+    bool valid() const noexcept { return exception_context_detail::alive(frame_, generation_); }
+
+    // The whole chain, outermost first: "outer: middle: root"
+    const char* what() const noexcept override {
+        using namespace exception_context_detail;
+        if (!valid()) return "<expired context>";
+        if (!frame_->formatted) {
+            Writer w{frame_->text, kTextBytes};
+            const Frame* f = frame_;
+            std::uint32_t gen = generation_;
+            for (bool first = true; f; first = false) {
+                if (!alive(f, gen)) {
+                    w.put(": <expired context>");
+                    break;
+                }
+                if (!first) w.put(": ");
+                formatOne(w, *f);
+                gen = f->causeGeneration;
+                f = f->cause;
+            }
+            frame_->text[w.len] = '\0';
+            frame_->formatted = true;
+        }
+        return frame_->text;
+    }
+
+    // Number of frames in the chain (this one included)
+    std::size_t depth() const noexcept {
+        std::size_t d = 0;
+        const exception_context_detail::Frame* f = frame_;
+        for (std::uint32_t gen = generation_; exception_context_detail::alive(f, gen); f = f->cause) {
+            ++d;
+            gen = f->causeGeneration;
+        }
+        return d;
+    }
+
+    const char* file() const noexcept { return valid() ? frame_->file : ""; }
+    unsigned line() const noexcept { return valid() ? frame_->line : 0; }
+
+private:
+    template <typename... A>
+    friend ContextException makeContext(const ContextException* cause, ContextFormat fmt, A... args);
+
+    exception_context_detail::Frame* frame_;
+    std::uint32_t generation_;
+};
+
+template <typename... A>
+ContextException makeContext(const ContextException* cause, ContextFormat fmt, A... args) {
+    using namespace exception_context_detail;
+    static_assert(sizeof...(A) <= kMaxArgs, "too many context arguments");
+    Frame* f = arena().acquire();
+    f->fmt = fmt.fmt;
+    f->argc = static_cast<std::uint8_t>(sizeof...(A));
+    std::size_t i = 0;
+    ((f->args[i++] = makeArg(args)), ...);
+    f->file = fmt.where.file_name();
+    f->line = fmt.where.line();
+    f->cause = cause && cause->valid() ? cause->frame_ : nullptr;
+    f->causeGeneration = f->cause ? cause->generation_ : 0;
+    return ContextException(f, f->generation);
+}
+
+template <typename... A>
+[[noreturn]] void throwContext(ContextFormat fmt, A... args) {
+    throw makeContext(nullptr, fmt, args...);
+}
+
+// Inside a catch: throw a new frame that points at `cause`
+template <typename... A>
+[[noreturn]] void rethrowWithContext(const ContextException& cause, ContextFormat fmt, A... args) {
+    throw makeContext(&cause, fmt, args...);
+}
@@ -0,0 +1,200 @@
+// ======================================================
+// Result.h — error values instead of throw, one taxonomy
+// ======================================================
+//
+// exceptionHandling.cpp / std:exception.cpp:
+//
+//     if (size < 1) throw InvalidSizeException();
+//     buffer = new char[size];
+//
+// A throw costs MICROSECONDS (allocate the exception, walk the
+// unwind tables, run the catch matching). That is fine when
+// errors are rare; it is not when bad input is common.
+//
+// Result<T, Error> is a small std::expected (C++23) for C++20:
+//   Result<int> r = 42;                       → has_value()
+//   Result<int> r = unexpected(Error{...});   → error()
+//   if (r) use(*r); else log(r.error().what());
+// The error travels back as an ordinary return value: no
+// unwinding, cost comparable to returning a pair.
+//
+// Error taxonomy (mirrors the exception classes in this folder):
+//   Errc::InvalidSize  ← InvalidSizeException / throw 1
+//   Errc::OutOfMemory  ← std::bad_alloc / throw "Out of Memory"
+//   Errc::Io           ← IOException       ("Controller Error")
+//   Errc::General      ← GeneralException
+//   Errc::Custom       ← MyException(data)
+//
+// Result::value() on an error throws ErrorException, so
+// call sites that still want exceptions can keep them.
+//
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+enum class Errc : std::uint8_t { InvalidSize, OutOfMemory, Io, General, Custom };
+
+struct Error {
+    Errc code;
+    int data = 0;            // extra information, like MyException::data
+
+    const char* what() const noexcept {
+        switch (code) {
+            case Errc::InvalidSize: return "Invalid array size! Size must be greater than zero.";
+            case Errc::OutOfMemory: return "Out of Memory";
+            case Errc::Io:          return "Controller Error";
+            case Errc::General:     return "General failure";
+            case Errc::Custom:      return "My exception happened";
+        }
+        return "Unknown error";
+    }
+};
+
+// Thrown by Result::value() when there is no value
+class ErrorException : public std::exception {
+public:
+    explicit ErrorException(Error e) : err(e) {}
+    const char* what() const noexcept override { return err.what(); }
+    const Error& error() const noexcept { return err; }
+
+private:
+    Error err;
+};
+
+template <typename E>
+struct Unexpected {
+    E error;
+};
+
+template <typename E>
+Unexpected<std::decay_t<E>> unexpected(E&& e) {
+    return {std::forward<E>(e)};
+}
+
+template <typename T, typename E = Error>
+class Result {
+    static_assert(!std::is_reference_v<T> && !std::is_void_v<T>, "Result<T>: T must be an object type");
+
+public:
+    Result(const T& v) : hasValue_(true) { ::new (&value_) T(v); }
+    Result(T&& v) noexcept(std::is_nothrow_move_constructible_v<T>) : hasValue_(true) {
+        ::new (&value_) T(std::move(v));
+    }
+    template <typename G>
+    Result(Unexpected<G> u) : hasValue_(false) {
+        ::new (&error_) E(std::move(u.error));
+    }
+
+    Result(const Result& o) : hasValue_(o.hasValue_) {
+        if (hasValue_) ::new (&value_) T(o.value_);
+        else ::new (&error_) E(o.error_);
+    }
+    Result(Result&& o) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                std::is_nothrow_move_constructible_v<E>)
+        : hasValue_(o.hasValue_) {
+        if (hasValue_) ::new (&value_) T(std::move(o.value_));
+        else ::new (&error_) E(std::move(o.error_));
+    }
+    Result& operator=(Result o) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                         std::is_nothrow_move_constructible_v<E>) {
+        if (o.hasValue_) {
+            if (hasValue_) assignOrReplace(value_, std::move(o.value_));
+            else replace(value_, error_, std::move(o.value_));
+        } else {
+            if (hasValue_) replace(error_, value_, std::move(o.error_));
+            else assignOrReplace(error_, std::move(o.error_));
+        }
+        hasValue_ = o.hasValue_;
+        return *this;
+    }
+    ~Result() { destroy(); }
+
+    bool has_value() const noexcept { return hasValue_; }
+    explicit operator bool() const noexcept { return hasValue_; }
+
+    // Unchecked access (like std::expected::operator*)
+    T& operator*() & noexcept { return value_; }
+    const T& operator*() const& noexcept { return value_; }
+    T&& operator*() && noexcept { return std::move(value_); }
+    T* operator->() noexcept { return &value_; }
+    const T* operator->() const noexcept { return &value_; }
+
+    // Checked access: throws on error
+    T& value() & {
+        if (!hasValue_) throwError();
+        return value_;
+    }
+    const T& value() const& {
+        if (!hasValue_) throwError();
+        return value_;
+    }
+    T&& value() && {
+        if (!hasValue_) throwError();
+        return std::move(value_);
+    }
+
+    const E& error() const& noexcept { return error_; }
+
+    template <typename U>
+    T value_or(U&& fallback) const& {
+        return hasValue_ ? value_ : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    // f(T) → Result<U, E>; errors pass through untouched
+    template <typename F>
+    auto and_then(F&& f) && {
+        using R = std::invoke_result_t<F, T&&>;
+        if (hasValue_) return std::forward<F>(f)(std::move(value_));
+        return R(unexpected(std::move(error_)));
+    }
+
+private:
+    [[noreturn]] void throwError() const {
+        if constexpr (std::is_same_v<E, Error>) throw ErrorException(error_);
+        else throw error_;
+    }
+
+    void destroy() noexcept {
+        if (hasValue_) value_.~T();
+        else error_.~E();
+    }
+
+    template <typename U>
+    static void assignOrReplace(U& member, U&& from) {
+        if constexpr (std::is_move_assignable_v<U>) member = std::move(from);
+        else replace(member, member, std::move(from));
+    }
+
+    // Ends `old`'s lifetime and builds `to` from `from`. If that
+    // throws, `old` is back as it was: the Result is never left
+    // without a live member (the destructor would run on it once
+    // more).
+    template <typename New, typename Old>
+    static void replace(New& to, Old& old, New&& from) {
+        if constexpr (std::is_nothrow_move_constructible_v<New>) {
+            old.~Old();
+            ::new (&to) New(std::move(from));
+        } else {
+            static_assert(std::is_nothrow_move_constructible_v<Old>,
+                          "Result<T, E>: T or E must be nothrow move constructible to be assignable");
+            Old saved(std::move(old));
+            old.~Old();
+            try {
+                ::new (&to) New(std::move(from));
+            } catch (...) {
+                ::new (&old) Old(std::move(saved));
+                throw;
+            }
+        }
+    }
+
+    union {
+        T value_;
+        E error_;
+    };
+    bool hasValue_;
+};
@@ -0,0 +1,206 @@
+// ==========================================================
+// TOPIC: Keeping Bounds Checks Alive in Production
+// ==========================================================
+//
+// assertionExaple.cpp guards Game::GetPlayer with
+//
+//     assert(index >= 0 && index < maxPlayers);
+//
+// and NDEBUG removes it from every release build.
+//
+// Assert.h gives the same check in cost classes:
+//   FAST_ASSERT        → stays in production (one compare), fatal
+//   FAST_CHECK         → same, logs and continues
+//   SAMPLED_ASSERT(64) → checks 1 call in 64
+//   DEBUG_ASSERT       → debug builds only
+// with per-site on/off switches, a logging handler instead
+// of abort(), and a per-site failure dump.
+//
+// Measured here (random valid indices):
+// - 10^8 GetPlayer() calls: unchecked vs assert() vs
+//   FAST_ASSERT vs FAST_CHECK on the bounds check
+// - 10^7 calls that also verify a table invariant (a scan):
+//   on every call vs SAMPLED_ASSERT(64)
+//
+// Build (production settings, assert() compiled out):
+//   g++ -std=c++20 -O2 -DNDEBUG assertLevels.cpp -o assertlevels
+// Build (debug settings, assert() active):
+//   g++ -std=c++20 -O2 assertLevels.cpp -o assertlevels
+//
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include "Assert.h"
+
+using namespace std;
+using namespace std::chrono;
+
+class Player {
+public:
+    int score = 1;
+};
+
+class Game {
+private:
+    int maxPlayers;
+    vector<Player> storage;
+    vector<Player*> players;
+
+public:
+    Game(int maxPlayers) : maxPlayers(maxPlayers), storage(maxPlayers), players(maxPlayers) {
+        FAST_CHECK(maxPlayers > 1);
+        for (int i = 0; i < maxPlayers; i++) players[i] = &storage[i];
+    }
+
+    Player* GetPlayerUnchecked(int index) { return players.data()[index]; }
+
+    Player* GetPlayerAssert(int index) {
+        assert(index >= 0 && index < maxPlayers);
+        return players.data()[index];
+    }
+
+    Player* GetPlayer(int index) {
+        FAST_ASSERT(index >= 0 && index < maxPlayers);
+        return players.data()[index];
+    }
+
+    Player* GetPlayerChecked(int index) {
+        FAST_CHECK(index >= 0 && index < maxPlayers);
+        return players.data()[index];
+    }
+
+    // Expensive invariant (scans the table): every call vs 1 in 64
+    bool tableValid() const {
+        bool ok = true;
+        for (int i = 0; i < maxPlayers; i++) ok &= players[i] == &storage[i];
+        return ok;
+    }
+
+    Player* GetPlayerScanAlways(int index) {
+        FAST_ASSERT(index >= 0 && index < maxPlayers);
+        FAST_ASSERT(tableValid());
+        return players.data()[index];
+    }
+
+    Player* GetPlayerScanSampled(int index) {
+        FAST_ASSERT(index >= 0 && index < maxPlayers);
+        SAMPLED_ASSERT(64, tableValid());
+        return players.data()[index];
+    }
+
+    // A bad index must not read out of bounds even when the
+    // handler returns instead of aborting
+    Player* GetPlayerOrNull(int index) {
+        FAST_CHECK(index >= 0 && index < maxPlayers);
+        return index >= 0 && index < maxPlayers ? players[index] : nullptr;
+    }
+};
+
+// Production handler: log and carry on
+static void logAndContinue(const assertions::Site& s) {
+    fprintf(stderr, "[assert] %s:%u: %s\n", s.file, s.line, s.expr);
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+int main() {
+    assertions::setHandler(logAndContinue);
+
+    // ---- The failures from assertionExaple.cpp, logged not fatal ----
+    Game tiny(1);
+    cout << "GetPlayerOrNull(2) → " << (tiny.GetPlayerOrNull(2) ? "player" : "nullptr") << endl;
+
+    // ---- Benchmark ----
+    constexpr int maxPlayers = 64;
+    constexpr long long n = 100'000'000;
+    Game game(maxPlayers);
+    vector<int> idx(1 << 16);
+    uint32_t seed = 99;
+    for (int& i : idx) {
+        seed = seed * 1664525u + 1013904223u;
+        i = static_cast<int>((seed >> 8) % maxPlayers);
+    }
+    const size_t mask = idx.size() - 1;
+
+    // Best of 3 runs: the per-call work is tiny, so noise matters
+    auto run = [&](auto get, long long calls) {
+        long long sum = 0;
+        double best = 1e30;
+        for (int rep = 0; rep < 3; ++rep) {
+            best = min(best, timeMs([&] {
+                long long local = 0;                 // register, even across fail() calls
+                for (long long i = 0; i < calls; ++i) local += get(idx[i & mask])->score;
+                sum = local;
+            }));
+        }
+        return pair<double, long long>(best, sum);
+    };
+
+    auto rNone = run([&](int i) { return game.GetPlayerUnchecked(i); }, n);
+    auto rAssert = run([&](int i) { return game.GetPlayerAssert(i); }, n);
+    auto rFast = run([&](int i) { return game.GetPlayer(i); }, n);
+    auto rCheck = run([&](int i) { return game.GetPlayerChecked(i); }, n);
+    constexpr long long nScan = n / 10;
+    auto rBase = run([&](int i) { return game.GetPlayer(i); }, nScan);
+    auto rAlways = run([&](int i) { return game.GetPlayerScanAlways(i); }, nScan);
+    auto rSampled = run([&](int i) { return game.GetPlayerScanSampled(i); }, nScan);
+
+    auto pct = [](double ms, double base) { return 100.0 * (ms - base) / base; };
+    cout << "\n10^8 GetPlayer() calls, bounds check:" << endl;
+    cout << "unchecked:          " << rNone.first << " ms" << endl;
+#ifdef NDEBUG
+    cout << "assert() (NDEBUG):  " << rAssert.first << " ms  (compiled out)" << endl;
+#else
+    cout << "assert():           " << rAssert.first << " ms  (" << pct(rAssert.first, rNone.first)
+         << "%)" << endl;
+#endif
+    cout << "FAST_ASSERT:        " << rFast.first << " ms  (" << pct(rFast.first, rNone.first) << "%)"
+         << endl;
+    cout << "FAST_CHECK:         " << rCheck.first << " ms  (" << pct(rCheck.first, rNone.first) << "%)"
+         << endl;
+    cout << "\n10^7 calls, plus a 64-entry table-invariant scan:" << endl;
+    cout << "scan every call:    " << rAlways.first << " ms  (" << pct(rAlways.first, rBase.first)
+         << "%)" << endl;
+    cout << "SAMPLED_ASSERT(64): " << rSampled.first << " ms  (" << pct(rSampled.first, rBase.first)
+         << "%)" << endl;
+    bool same = rNone.second == rAssert.second && rNone.second == rFast.second &&
+                rNone.second == rCheck.second &&
+                rBase.second == rAlways.second && rBase.second == rSampled.second;
+    cout << "same results: " << (same ? "yes" : "NO") << "\n" << endl;
+
+    // ---- Per-site switch + counter dump ----
+    assertions::setEnabled("assertLevels.cpp", 0, false);   // whole file off
+    tiny.GetPlayerOrNull(5);                                 // not reported
+    assertions::setEnabled("assertLevels.cpp", 0, true);
+    tiny.GetPlayerOrNull(7);                                 // reported again
+    assertions::dump(stdout);
+    return same ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A bounds check is one compare + one well-predicted
+//    branch; the expensive part of assert() is the failure
+//    code, so move it out of line ([[gnu::cold]], noinline).
+// 2. Classify checks by cost and compile out only the
+//    expensive ones, instead of all-or-nothing NDEBUG.
+// 3. Sampling (1 in N) keeps some coverage for checks too
+//    costly to run on every call.
+// 4. In production, log and count failures instead of
+//    aborting — and still guard the access itself.
+//
+// ⭐ One-Line Interview Answer
+// “Split assertions into cheap, sampled and debug-only
+// classes, keep the cheap ones in production with the failure
+// path outlined as cold code, and count failures per site.”
@@ -0,0 +1,510 @@
+// ==========================================================
+// TOPIC: What an Exception Costs — Depth, Catch Style, Rethrow, noexcept, Threads
+// ==========================================================
+//
+// excep.cpp / ExceptionClass.cpp / moern.cpp / Rethrow.cpp /
+// re-throwing.cpp:
+//
+//     try { throw IOException(); } catch (const IOException& e) { ... }   // "by reference: faster"
+//     catch (const GeneralException& e) { log(e); throw; }                // rethrow
+//
+// ❌ every one of them says a throw is "slow" or a copy is
+//    "expensive" — none says how slow, or of what
+//
+// ✅ measured here, with MicroBench.h / ContentionBench.h:
+//   1. throw → catch latency through 1, 10 and 100 frames (and
+//      100 frames that each run a destructor), against returning
+//      an error code through the same frames
+//   2. catch by value vs by reference: MyException (an int, as in
+//      moern.cpp) and GeneralException (a std::string, as in
+//      Rethrow.cpp) — allocations per catch counted
+//   3. rethrow: caught at the top, through 1 and 10 layers of
+//      catch (...) { throw; }, and 10 layers of `throw e;`
+//   4. noexcept and the path that does NOT throw: the size of a
+//      loop calling an opaque function with a destructor live
+//      across the call (the landing pad is the difference), its
+//      speed, and where noexcept does change run time —
+//      vector growth moving instead of copying (move_if_noexcept)
+//   5. failure storms: throw + catch on 1..8 threads at once;
+//      throughput per thread shows whether the unwinder (FDE
+//      lookup, exception allocation) serialises them
+//
+// On inlining: GCC's inliner does not weigh noexcept. What
+// noexcept removes is the cleanup code (landing pads and the
+// unwind table entries) in CALLERS, which row 4 shows in bytes.
+//
+// On the unwinder lock: libgcc used to find FDEs under a global
+// lock (dl_iterate_phdr); with glibc 2.35+ it uses the lock-free
+// _dl_find_object. Row 5 scales with cores only where that holds
+// (and, on one core, shows only time slicing).
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread exceptionCost.cpp -o exceptioncost
+//
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <elf.h>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../Benchmarks/ContentionBench.h"
+#include "../Benchmarks/MicroBench.h"
+
+using namespace std;
+
+// ---- Count every operator new in the program ----
+static atomic<uint64_t> newCalls{0};
+void* operator new(size_t n) {
+    newCalls.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+// GCC pairs the inlined free() with `new` and warns; they match here
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+#pragma GCC diagnostic pop
+
+// Section 2 catches by value on purpose
+#pragma GCC diagnostic ignored "-Wcatch-value"
+
+// The originals' exception types
+class MyException : public std::exception {
+public:
+    int data;
+    MyException(int d) : data(d) {}
+    const char* what() const noexcept override { return "My exception happened"; }
+};
+
+class GeneralException : public std::exception {
+    string msg;
+
+public:
+    explicit GeneralException(const string& m) : msg(m) {}
+    const char* what() const noexcept override { return msg.c_str(); }
+};
+
+// ----------------------------------------------------------
+// 1. Depth. noipa: no inlining or cloning; the barrier on the
+// result keeps GCC from turning `f(n - 1) + 1` into a loop — every
+// level is a real frame the unwinder has to walk
+// ----------------------------------------------------------
+
+__attribute__((noipa)) int diveThrow(int depth, int code) {
+    if (depth <= 1) throw MyException(code);
+    int r = diveThrow(depth - 1, code);
+    doNotOptimize(r);
+    return r + 1;
+}
+
+struct Guard {
+    int* count;
+    ~Guard() { ++*count; }
+};
+
+__attribute__((noipa)) int diveGuarded(int depth, int code, int& unwound) {
+    Guard g{&unwound};
+    if (depth <= 1) throw MyException(code);
+    int r = diveGuarded(depth - 1, code, unwound);
+    doNotOptimize(r);
+    return r + 1;
+}
+
+// The same trip with an error code instead
+__attribute__((noipa)) int diveReturn(int depth, int code, int& error) {
+    if (depth <= 1) {
+        error = code;
+        return -1;
+    }
+    int r = diveReturn(depth - 1, code, error);
+    if (r < 0) return r;
+    return r + 1;
+}
+
+// ----------------------------------------------------------
+// 3. Rethrow: `layers` functions each intercepting and rethrowing
+// ----------------------------------------------------------
+
+enum class Intercept { None, RethrowSame, ThrowCopy };
+
+long intercepted = 0;                // catch blocks entered on the way up
+
+__attribute__((noipa)) int layered(int layers, Intercept how, int code) {
+    if (layers == 0) return diveThrow(1, code);
+    if (how == Intercept::None) {
+        int r = layered(layers - 1, how, code);
+        doNotOptimize(r);
+        return r + 1;
+    }
+    if (how == Intercept::RethrowSame) {
+        try {
+            return layered(layers - 1, how, code) + 1;
+        } catch (...) {              // Rethrow.cpp: log, then let a caller decide
+            ++intercepted;
+            throw;                   // the same object, no copy
+        }
+    }
+    try {
+        return layered(layers - 1, how, code) + 1;
+    } catch (const MyException& e) {
+        ++intercepted;
+        throw e;                     // a new exception object, copied
+    }
+}
+
+// ----------------------------------------------------------
+// 4. noexcept on the non-throwing path
+// ----------------------------------------------------------
+
+static int guardRuns = 0;
+
+extern "C" __attribute__((noipa)) int opaqueMayThrow(int i) {
+    if (i < 0) throw MyException(i);
+    return i & 7;
+}
+extern "C" __attribute__((noipa)) int opaqueNoexcept(int i) noexcept { return i & 7; }
+
+// A destructor is live across each call: if the callee may throw,
+// the caller needs a landing pad to run it during unwinding
+extern "C" __attribute__((noinline)) long loopMayThrow(int n) {
+    long sum = 0;
+    for (int i = 0; i < n; ++i) {
+        Guard g{&guardRuns};
+        sum += opaqueMayThrow(i);
+    }
+    return sum;
+}
+extern "C" __attribute__((noinline)) long loopNoexcept(int n) {
+    long sum = 0;
+    for (int i = 0; i < n; ++i) {
+        Guard g{&guardRuns};
+        sum += opaqueNoexcept(i);
+    }
+    return sum;
+}
+
+// Size in bytes of a function in this executable's symbol table
+// (0 if the binary is stripped or the name is not there)
+size_t functionBytes(const char* name) {
+    ifstream in("/proc/self/exe", ios::binary);
+    const vector<char> image{istreambuf_iterator<char>(in), istreambuf_iterator<char>()};
+    if (image.size() < sizeof(Elf64_Ehdr) || memcmp(image.data(), ELFMAG, SELFMAG) != 0) return 0;
+    Elf64_Ehdr eh;
+    memcpy(&eh, image.data(), sizeof(eh));
+    if (eh.e_ident[EI_CLASS] != ELFCLASS64 || eh.e_shoff + size_t(eh.e_shnum) * sizeof(Elf64_Shdr) > image.size())
+        return 0;
+    auto section = [&](size_t i) {
+        Elf64_Shdr sh;
+        memcpy(&sh, image.data() + eh.e_shoff + i * sizeof(Elf64_Shdr), sizeof(sh));
+        return sh;
+    };
+    for (size_t i = 0; i < eh.e_shnum; ++i) {
+        const Elf64_Shdr symtab = section(i);
+        if (symtab.sh_type != SHT_SYMTAB || symtab.sh_link >= eh.e_shnum) continue;
+        const Elf64_Shdr strtab = section(symtab.sh_link);
+        if (symtab.sh_offset + symtab.sh_size > image.size() || strtab.sh_offset + strtab.sh_size > image.size())
+            return 0;
+        for (size_t k = 0; k < symtab.sh_size / sizeof(Elf64_Sym); ++k) {
+            Elf64_Sym sym;
+            memcpy(&sym, image.data() + symtab.sh_offset + k * sizeof(Elf64_Sym), sizeof(sym));
+            if (ELF64_ST_TYPE(sym.st_info) != STT_FUNC || sym.st_name >= strtab.sh_size) continue;
+            const char* symName = image.data() + strtab.sh_offset + sym.st_name;
+            if (strncmp(symName, name, strtab.sh_size - sym.st_name) == 0) return sym.st_size;
+        }
+    }
+    return 0;
+}
+
+// Same string payload; only the move constructor's noexcept differs
+template <bool Noexcept>
+struct Payload {
+    static inline uint64_t copies = 0;
+    string text;
+    Payload(int i) : text("payload number " + to_string(i) + ", past the small-string buffer") {}
+    Payload(const Payload& o) : text(o.text) { ++copies; }
+    Payload(Payload&& o) noexcept(Noexcept) : text(std::move(o.text)) {}
+    Payload& operator=(const Payload&) = default;
+    Payload& operator=(Payload&&) = default;
+};
+
+int main() {
+    bool ok = true;
+    long sink = 0;
+
+    // ---- correctness first: every strategy delivers the code, the guards all run ----
+    {
+        for (int depth : {1, 10, 100}) {
+            try {
+                diveThrow(depth, depth);
+                ok = false;
+            } catch (const MyException& e) {
+                ok = ok && e.data == depth;
+            }
+            int error = 0;
+            ok = ok && diveReturn(depth, depth, error) < 0 && error == depth;
+        }
+        int unwound = 0;
+        try {
+            diveGuarded(100, 7, unwound);
+        } catch (const MyException& e) {
+            ok = ok && e.data == 7;
+        }
+        ok = ok && unwound == 100;
+        for (Intercept how : {Intercept::None, Intercept::RethrowSame, Intercept::ThrowCopy}) {
+            intercepted = 0;
+            try {
+                layered(10, how, 42);
+                ok = false;
+            } catch (const MyException& e) {
+                ok = ok && e.data == 42;
+            }
+            ok = ok && intercepted == (how == Intercept::None ? 0 : 10);   // every layer caught and rethrew
+        }
+    }
+
+    // ---- 1. depth ----
+    MicroBench depth("throw → catch through N frames (MyException)");
+    for (int d : {1, 10, 100})
+        depth.add("throw, depth " + to_string(d), [&, d](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                try {
+                    diveThrow(d, int(i));
+                } catch (const MyException& e) {
+                    sink += e.data;
+                }
+            }
+        });
+    depth.add("throw, depth 100, a destructor per frame", [&](uint64_t n) {
+        int unwound = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            try {
+                diveGuarded(100, int(i), unwound);
+            } catch (const MyException& e) {
+                sink += e.data;
+            }
+        }
+        sink += unwound;
+    });
+    for (int d : {1, 100})
+        depth.add("error code, depth " + to_string(d), [&, d](uint64_t n) {
+            int error = 0;
+            for (uint64_t i = 0; i < n; ++i) sink += diveReturn(d, int(i), error);
+            sink += error;
+        });
+    const auto rDepth = depth.run();
+    // Timings are reported, not checked: a loaded machine may reorder them
+    printf("  depth 100 vs depth 1: %.1fx; throw vs error code at depth 1: %.1fx\n\n",
+           rDepth[2].medianNs / rDepth[0].medianNs, rDepth[0].medianNs / rDepth[4].medianNs);
+
+    // ---- 2. catch by value vs by reference ----
+    const string longMessage = "General failure in DoSomething(), past the small-string buffer";
+    uint64_t byValueNews = 0, byRefNews = 0;
+    {
+        const uint64_t before = newCalls.load();
+        try {
+            throw GeneralException(longMessage);
+        } catch (GeneralException e) {
+            sink += long(strlen(e.what()));
+        }
+        byValueNews = newCalls.load() - before;
+        const uint64_t mid = newCalls.load();
+        try {
+            throw GeneralException(longMessage);
+        } catch (const GeneralException& e) {
+            sink += long(strlen(e.what()));
+        }
+        byRefNews = newCalls.load() - mid;
+        ok = ok && byValueNews == byRefNews + 1;                     // the catch's own string copy
+    }
+    MicroBench catching("catch by value vs by reference");
+    catching
+        .add("MyException, by const&",
+             [&](uint64_t n) {
+                 for (uint64_t i = 0; i < n; ++i) {
+                     try {
+                         diveThrow(1, int(i));
+                     } catch (const MyException& e) {
+                         sink += e.data;
+                     }
+                 }
+             })
+        .add("MyException, by value",
+             [&](uint64_t n) {
+                 for (uint64_t i = 0; i < n; ++i) {
+                     try {
+                         diveThrow(1, int(i));
+                     } catch (MyException e) {
+                         sink += e.data;
+                     }
+                 }
+             })
+        .add("GeneralException (string), by const&",
+             [&](uint64_t n) {
+                 for (uint64_t i = 0; i < n; ++i) {
+                     try {
+                         throw GeneralException(longMessage);
+                     } catch (const GeneralException& e) {
+                         sink += e.what()[0];
+                     }
+                 }
+             })
+        .add("GeneralException (string), by value", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                try {
+                    throw GeneralException(longMessage);
+                } catch (GeneralException e) {
+                    sink += e.what()[0];
+                }
+            }
+        });
+    catching.run();
+    cout << "  operator new per throw + catch of GeneralException: by value " << byValueNews << ", by const& "
+         << byRefNews << endl
+         << endl;
+
+    // ---- 3. rethrow ----
+    MicroBench rethrow("rethrow through intercepting layers");
+    rethrow.add("10 layers, caught at the top only", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            try {
+                layered(10, Intercept::None, int(i));
+            } catch (const MyException& e) {
+                sink += e.data;
+            }
+        }
+    });
+    for (int layers : {1, 10})
+        rethrow.add(to_string(layers) + " x catch (...) { throw; }", [&, layers](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                try {
+                    layered(layers, Intercept::RethrowSame, int(i));
+                } catch (const MyException& e) {
+                    sink += e.data;
+                }
+            }
+        });
+    rethrow.add("10 x catch (const E& e) { throw e; }", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            try {
+                layered(10, Intercept::ThrowCopy, int(i));
+            } catch (const MyException& e) {
+                sink += e.data;
+            }
+        }
+    });
+    const auto rRethrow = rethrow.run();
+    // every layer restarts the search
+    printf("  10 x throw; vs caught at the top only: %.1fx\n\n", rRethrow[2].medianNs / rRethrow[0].medianNs);
+
+    // ---- 4. noexcept on the non-throwing path ----
+    // GCC moves landing pads out of line, into <name>.cold
+    auto codeBytes = [](const string& name) {
+        return functionBytes(name.c_str()) + functionBytes((name + ".cold").c_str());
+    };
+    const size_t mayThrowBytes = codeBytes("loopMayThrow"), noexceptBytes = codeBytes("loopNoexcept");
+    MicroBench quiet("non-throwing path, a destructor live across an opaque call");
+    quiet
+        .add("callee may throw (landing pad)",
+             [&](uint64_t n) {
+                 sink += loopMayThrow(int(n & 0x7fffffff));
+             })
+        .add("callee noexcept", [&](uint64_t n) { sink += loopNoexcept(int(n & 0x7fffffff)); });
+    const auto rQuiet = quiet.run();
+    if (mayThrowBytes && noexceptBytes) {
+        cout << "  code size: loopMayThrow " << mayThrowBytes << " bytes, loopNoexcept " << noexceptBytes
+             << " bytes (" << long(mayThrowBytes) - long(noexceptBytes)
+             << " bytes of cleanup path, plus its .gcc_except_table entry)" << endl;
+        ok = ok && noexceptBytes < mayThrowBytes;
+    } else {
+        cout << "  code size: no symbol table in this binary (stripped?)" << endl;
+    }
+    printf("  may throw vs noexcept, run time: %.2fx\n\n", rQuiet[0].medianNs / rQuiet[1].medianNs);
+
+    constexpr int kGrowth = 100000;
+    auto growth = [&](auto tag) {
+        using P = decltype(tag);
+        P::copies = 0;
+        const auto t0 = chrono::steady_clock::now();
+        vector<P> v;
+        for (int i = 0; i < kGrowth; ++i) v.emplace_back(i);
+        doNotOptimize(v);
+        const double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / kGrowth;
+        return make_pair(ns, P::copies);
+    };
+    const auto [nsNoexcept, copiesNoexcept] = growth(Payload<true>(0));
+    const auto [nsMayThrow, copiesMayThrow] = growth(Payload<false>(0));
+    printf("  vector growth, %d string payloads: move noexcept %.1f ns/push (%llu copies), "
+           "move may throw %.1f ns/push (%llu copies)\n\n",
+           kGrowth, nsNoexcept, (unsigned long long)copiesNoexcept, nsMayThrow, (unsigned long long)copiesMayThrow);
+    ok = ok && copiesNoexcept == 0 && copiesMayThrow >= uint64_t(kGrowth) - 1;
+
+    // ---- 5. failure storms ----
+    cout << "== throw + catch (depth 10) on T threads at once, " << thread::hardware_concurrency() << " core(s)"
+         << endl;
+    printf("  %-28s %8s %14s %16s %10s %10s\n", "", "threads", "ops/s", "ops/s per thread", "p50 ns", "p99 ns");
+    vector<long> perThreadSink(8);
+    for (bool throwing : {true, false}) {
+        double single = 0;
+        for (int threads : {1, 2, 4, 8}) {
+            ContentionConfig cfg;
+            cfg.threads = threads;
+            cfg.durationMs = 200;
+            ContentionResult r = runContention(throwing ? "throw + catch" : "error code", cfg, [&](int t, bool) {
+                if (throwing) {
+                    try {
+                        diveThrow(10, t);
+                    } catch (const MyException& e) {
+                        perThreadSink[t] += e.data;
+                    }
+                } else {
+                    int error = 0;
+                    perThreadSink[t] += diveReturn(10, t, error) + error;
+                }
+            });
+            if (threads == 1) single = r.opsPerSec;
+            printf("  %-28s %8d %14.3g %16.3g %10.0f %10.0f\n", threads == 1 ? r.name.c_str() : "", threads,
+                   r.opsPerSec, r.opsPerSec / threads, r.p50Ns, r.p99Ns);
+            ok = ok && r.ops > 0;
+        }
+        (void)single;
+    }
+    for (long s : perThreadSink) sink += s;
+    doNotOptimize(sink);
+
+    cout << endl << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. "Zero-cost" exceptions: the non-throwing path runs no extra
+//    instructions; the cost is table lookups and unwinding when a
+//    throw happens — microseconds, growing with every frame (and
+//    every destructor) between throw and catch.
+// 2. Catch by const&: by value copies the exception object — for
+//    one holding a std::string, an allocation per catch — and
+//    slices derived types.
+// 3. `throw;` rethrows the same object; each intercepting layer
+//    still restarts the search phase, so rethrow chains multiply
+//    the cost. `throw e;` also copies.
+// 4. noexcept lets callers drop their cleanup paths (smaller
+//    code) and lets containers move instead of copy; its big
+//    runtime effect is that second one.
+//
+// ⭐ One-Line Interview Answer
+// “A throw costs microseconds and scales with the frames and
+// destructors it unwinds, the non-throwing path costs nothing, so
+// keep exceptions for rare failures, catch by const&, rethrow with
+// `throw;`, and mark moves noexcept so containers never copy.”
@@ -0,0 +1,146 @@
+// ==========================================================
+// TOPIC: Returning Errors Instead of Throwing (Result<T>)
+// ==========================================================
+//
+// exceptionHandling.cpp and std:exception.cpp validate a
+// user-supplied size before new char[size] by THROWING:
+//
+//     if (size < 1) throw InvalidSizeException();
+//
+// When invalid input is COMMON (a request path fed by users),
+// every bad request pays for a full throw + unwind.
+//
+// Same flow with Result.h:
+//
+//     Result<unique_ptr<char[]>> allocateBuffer(int size) noexcept;
+//
+//     auto buf = allocateBuffer(size);
+//     if (!buf) cout << buf.error().what();
+//
+// Measured here: 1M allocate requests with 0%, 1% and 50%
+// invalid sizes, throwing version vs Result version.
+//
+// Build:
+//   g++ -std=c++20 -O2 expectedBuffer.cpp -o expectedbuffer
+//
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+#include "Result.h"
+
+using namespace std;
+using namespace std::chrono;
+
+constexpr int kMaxBufferSize = 1 << 20;
+
+// ---- Old flow: throws ----
+class InvalidSizeException : public std::exception {
+public:
+    const char* what() const noexcept override {
+        return "Invalid array size! Size must be greater than zero.";
+    }
+};
+
+unique_ptr<char[]> allocateOrThrow(int size) {
+    if (size < 1) throw InvalidSizeException();
+    if (size > kMaxBufferSize) throw bad_alloc();
+    return unique_ptr<char[]>(new char[size]);
+}
+
+// ---- New flow: error is a return value ----
+Result<unique_ptr<char[]>> allocateBuffer(int size) noexcept {
+    if (size < 1) return unexpected(Error{Errc::InvalidSize, size});
+    if (size > kMaxBufferSize) return unexpected(Error{Errc::OutOfMemory, size});
+    unique_ptr<char[]> p(new (nothrow) char[size]);
+    if (!p) return unexpected(Error{Errc::OutOfMemory, size});
+    return p;
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+int main() {
+    // ---- The flow from the original programs ----
+    for (int size : {16, 0, -5, kMaxBufferSize + 1}) {
+        auto buf = allocateBuffer(size);
+        if (buf) cout << "size " << size << ": Memory allocated successfully!" << endl;
+        else cout << "size " << size << ": Exception: " << buf.error().what() << endl;
+    }
+    try {
+        allocateBuffer(0).value();               // still available as an exception
+    } catch (const ErrorException& e) {
+        cout << "value() threw: " << e.what() << " (data " << e.error().data << ")" << endl;
+    }
+
+    // ---- Benchmark ----
+    constexpr int n = 1'000'000;
+    cout << "\n" << n << " allocate requests:" << endl;
+    for (int ratePercent : {0, 1, 50}) {
+        vector<int> sizes(n);
+        uint32_t seed = 2024;
+        for (int& s : sizes) {
+            seed = seed * 1664525u + 1013904223u;
+            s = static_cast<int>((seed >> 8) % 100) < ratePercent ? 0 : 64;
+        }
+
+        long long okThrow = 0, errThrow = 0;
+        double throwMs = timeMs([&] {
+            for (int s : sizes) {
+                try {
+                    auto p = allocateOrThrow(s);
+                    p[0] = 1;
+                    ++okThrow;
+                } catch (const InvalidSizeException&) {
+                    ++errThrow;
+                } catch (const bad_alloc&) {
+                    ++errThrow;
+                }
+            }
+        });
+
+        long long okResult = 0, errResult = 0;
+        double resultMs = timeMs([&] {
+            for (int s : sizes) {
+                auto p = allocateBuffer(s);
+                if (p) {
+                    (*p)[0] = 1;
+                    ++okResult;
+                } else {
+                    ++errResult;
+                }
+            }
+        });
+
+        bool same = okThrow == okResult && errThrow == errResult;
+        cout << ratePercent << "% invalid: throw " << throwMs << " ms, Result " << resultMs
+             << " ms (" << errResult << " errors" << (same ? "" : ", MISMATCH") << ")" << endl;
+        if (!same) return 1;
+    }
+    return 0;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. Exceptions are "zero-cost" only on the happy path; each
+//    throw allocates, unwinds and matches catch blocks.
+// 2. For EXPECTED failures (bad user input) return the error
+//    as a value: Result<T, Error> / std::expected in C++23.
+// 3. One error enum + data replaces a family of exception
+//    classes and keeps the messages in one place.
+// 4. Keep a bridge (value() throws) for code that genuinely
+//    wants exceptions, e.g. truly exceptional conditions.
+//
+// ⭐ One-Line Interview Answer
+// “Throw for rare, exceptional failures, but return common
+// validation errors as values with Result/std::expected so
+// bad input costs a branch instead of a stack unwind.”
@@ -0,0 +1,100 @@
+// ======================================================
+// BoundMethod.h — member-function pointer fixed at compile time
+// ======================================================
+//
+// example.cpp:
+//
+//     int (MyClass::*ptr)(int, int) = &MyClass::Add;
+//     (obj.*ptr)(3, 9);
+//
+// A member pointer held in a VARIABLE is opaque to the
+// optimiser: each call checks "virtual or not?", adjusts
+// `this`, then makes an indirect call. Nothing inlines.
+//
+// bound_method<&MyClass::Add> makes the member pointer a
+// TEMPLATE ARGUMENT instead:
+//
+//     bound_method<&MyClass::Add>::call(obj, 3, 9);   // == obj.Add(3, 9), direct
+//     auto f = bound_method<&MyClass::Add>::on(obj);  // callable object
+//     f(3, 9);
+//     std::thread t(bound_method<&Base::run>::on(b), 5);
+//
+// invoke_all<&C::Fn>(span<C>, args...) calls the member on
+// every object of a contiguous batch. With the call inlined
+// the loop body is plain code, so simple members (getters,
+// updates) auto-vectorise.
+//
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace bound_method_detail {
+
+template <typename M>
+struct Traits;
+
+template <typename R, typename C, typename... Args>
+struct Traits<R (C::*)(Args...)> {
+    using Class = C;
+    using Result = R;
+    using Object = C;
+};
+
+template <typename R, typename C, typename... Args>
+struct Traits<R (C::*)(Args...) const> {
+    using Class = C;
+    using Result = R;
+    using Object = const C;
+};
+
+template <typename R, typename C, typename... Args>
+struct Traits<R (C::*)(Args...) noexcept> : Traits<R (C::*)(Args...)> {};
+
+template <typename R, typename C, typename... Args>
+struct Traits<R (C::*)(Args...) const noexcept> : Traits<R (C::*)(Args...) const> {};
+
+}  // namespace bound_method_detail
+
+template <auto Method>
+struct bound_method {
+    static_assert(std::is_member_function_pointer_v<decltype(Method)>,
+                  "bound_method needs &Class::memberFunction");
+
+    using Traits = bound_method_detail::Traits<decltype(Method)>;
+    using Class = typename Traits::Class;
+    using Object = typename Traits::Object;
+    using Result = typename Traits::Result;
+
+    template <typename... Args>
+    static constexpr Result call(Object& obj, Args&&... args) {
+        return (obj.*Method)(std::forward<Args>(args)...);
+    }
+
+    // Object + compile-time method: one pointer, callable like a function
+    struct Bound {
+        Object* obj;
+
+        template <typename... Args>
+        constexpr Result operator()(Args&&... args) const {
+            return (obj->*Method)(std::forward<Args>(args)...);
+        }
+    };
+
+    static constexpr Bound on(Object& obj) { return Bound{&obj}; }
+};
+
+// obj.Fn(args...) for every obj; returns nothing
+template <auto Method, typename Obj, typename... Args>
+void invoke_all(std::span<Obj> objs, const Args&... args) {
+    for (Obj& o : objs) bound_method<Method>::call(o, args...);
+}
+
+// obj[i].Fn(args...) → out[i]; out.size() must be >= objs.size()
+template <auto Method, typename Obj, typename R, typename... Args>
+void invoke_all(std::span<Obj> objs, std::span<R> out, const Args&... args) {
+    const std::size_t n = objs.size();
+    for (std::size_t i = 0; i < n; ++i) out[i] = bound_method<Method>::call(objs[i], args...);
+}
@@ -0,0 +1,305 @@
+// ======================================================
+// CpuDispatch.h — one runtime CPU-feature dispatch layer for every SIMD kernel
+// ======================================================
+//
+// theory.cpp's selection by pointer:
+//
+//     MathFunc operations[2] = {add, sub};
+//     operations[i](x, y);
+//
+// The same idea, with the index chosen by the CPU. A kernel
+// compiled only for the build's baseline (-O2: SSE2) leaves AVX2
+// and AVX-512 unused on new hosts; one compiled with -mavx2 dies
+// with SIGILL on old ones. Instead every SIMD kernel is built in
+// several variants (GCC/Clang target attributes, no extra flags)
+// and one pointer per kernel is picked by the host:
+//
+//     using Fn = void (*)(const float*, std::size_t);
+//     const DispatchedKernel<Fn>& k = ...;   // usually a function-local static
+//     static const DispatchedKernel<Fn> sum{"sum", "float",
+//         {{"avx2", {CpuFeature::Avx2}, sumAvx2},
+//          {"scalar", {}, sumScalar}}};      // best first; last needs nothing
+//     sum(p, n);                             // indirect call, no per-call test
+//
+// - cpuFeatures(): cpuid (__builtin_cpu_supports, which also
+//   checks that the OS saves the AVX / AVX-512 registers; __cpuid +
+//   _xgetbv on MSVC) or the Linux hwcaps on ARM, detected once
+// - a DispatchedKernel takes the first variant whose features
+//   are all present, when it is constructed: at startup for a
+//   namespace-scope object, on first use (thread-safe static)
+//   for a function-local one
+// - every kernel registers itself; dispatchReport() lists what
+//   each one chose and why
+//
+// FORCING A VARIANT (A/B benchmarks, reproducing a bug seen on
+// an older host) — environment variables, read at selection:
+//
+//   CPU_DISPATCH=scalar                      every kernel that has "scalar"
+//   CPU_DISPATCH=minmax=avx2,unpack_readings=scalar     per kernel
+//   CPU_DISPATCH_DISABLE=avx512f,avx2        pretend the host lacks them
+//
+//   an entry naming a variant the CPU cannot run is ignored with
+//   a warning on stderr (it would die with SIGILL); an unknown
+//   variant or kernel is ignored too
+//
+// Not ifunc: GNU indirect functions would resolve the symbol at
+// load time with no pointer load per call, but they are ELF-only
+// (no MSVC, no macOS) and cannot read the environment safely that
+// early. The pointer is one load from a constant that stays in
+// cache.
+//
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CPU_DISPATCH_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(__arm__) || defined(_M_ARM64)
+#define CPU_DISPATCH_ARM 1
+#if defined(__linux__) && defined(__arm__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+// Compile one function for an instruction set beyond the build's
+// baseline: CPU_DISPATCH_TARGET("avx2") void f(...) { intrinsics }
+#if defined(__GNUC__) || defined(__clang__)
+#define CPU_DISPATCH_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CPU_DISPATCH_TARGET(isa)
+#endif
+
+enum class CpuFeature : unsigned { Sse2, Ssse3, Sse41, Avx, Avx2, Fma, Avx512f, Avx512bw, Neon, Count };
+
+inline const char* cpuFeatureName(CpuFeature f) {
+    static const char* const kNames[] = {"sse2", "ssse3", "sse4.1", "avx", "avx2", "fma", "avx512f", "avx512bw",
+                                         "neon"};
+    return f < CpuFeature::Count ? kNames[unsigned(f)] : "?";
+}
+
+// A set of features as bits
+class CpuFeatureSet {
+public:
+    constexpr CpuFeatureSet() = default;
+    constexpr CpuFeatureSet(std::initializer_list<CpuFeature> features) {
+        for (CpuFeature f : features) bits_ |= bit(f);
+    }
+
+    constexpr bool has(CpuFeature f) const { return (bits_ & bit(f)) != 0; }
+    constexpr bool covers(CpuFeatureSet required) const { return (bits_ & required.bits_) == required.bits_; }
+    constexpr void set(CpuFeature f, bool on) { bits_ = on ? bits_ | bit(f) : bits_ & ~bit(f); }
+
+    std::string describe() const {
+        std::string s;
+        for (unsigned i = 0; i < unsigned(CpuFeature::Count); ++i)
+            if (has(CpuFeature(i))) s += (s.empty() ? "" : " ") + std::string(cpuFeatureName(CpuFeature(i)));
+        return s.empty() ? "(none)" : s;
+    }
+
+private:
+    static constexpr std::uint32_t bit(CpuFeature f) { return std::uint32_t(1) << unsigned(f); }
+    std::uint32_t bits_ = 0;
+};
+
+namespace cpu_dispatch_detail {
+
+inline CpuFeatureSet detect() {
+    CpuFeatureSet s;
+#if defined(CPU_DISPATCH_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+    int r[4];
+    __cpuid(r, 0);
+    const int maxLeaf = r[0];
+    __cpuid(r, 1);
+    const int ecx1 = r[2], edx1 = r[3];
+    const bool osxsave = (ecx1 & (1 << 27)) != 0;
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    const bool osAvx = (xcr0 & 0x6) == 0x6, osAvx512 = (xcr0 & 0xe6) == 0xe6;
+    int ebx7 = 0;
+    if (maxLeaf >= 7) __cpuidex(r, 7, 0), ebx7 = r[1];
+    s.set(CpuFeature::Sse2, (edx1 & (1 << 26)) != 0);
+    s.set(CpuFeature::Ssse3, (ecx1 & (1 << 9)) != 0);
+    s.set(CpuFeature::Sse41, (ecx1 & (1 << 19)) != 0);
+    s.set(CpuFeature::Avx, osAvx && (ecx1 & (1 << 28)) != 0);
+    s.set(CpuFeature::Fma, osAvx && (ecx1 & (1 << 12)) != 0);
+    s.set(CpuFeature::Avx2, osAvx && (ebx7 & (1 << 5)) != 0);
+    s.set(CpuFeature::Avx512f, osAvx512 && (ebx7 & (1 << 16)) != 0);
+    s.set(CpuFeature::Avx512bw, osAvx512 && (ebx7 & (1 << 30)) != 0);
+#else
+    __builtin_cpu_init();
+    s.set(CpuFeature::Sse2, __builtin_cpu_supports("sse2"));
+    s.set(CpuFeature::Ssse3, __builtin_cpu_supports("ssse3"));
+    s.set(CpuFeature::Sse41, __builtin_cpu_supports("sse4.1"));
+    s.set(CpuFeature::Avx, __builtin_cpu_supports("avx"));
+    s.set(CpuFeature::Avx2, __builtin_cpu_supports("avx2"));
+    s.set(CpuFeature::Fma, __builtin_cpu_supports("fma"));
+    s.set(CpuFeature::Avx512f, __builtin_cpu_supports("avx512f"));
+    s.set(CpuFeature::Avx512bw, __builtin_cpu_supports("avx512bw"));
+#endif
+#elif defined(CPU_DISPATCH_ARM)
+#if defined(__aarch64__) || defined(_M_ARM64)
+    s.set(CpuFeature::Neon, true);                    // Advanced SIMD is mandatory on AArch64
+#elif defined(__linux__)
+    s.set(CpuFeature::Neon, (::getauxval(AT_HWCAP) & HWCAP_NEON) != 0);
+#endif
+#endif
+    return s;
+}
+
+// Comma-separated list; items "a=b" or "a"
+inline std::vector<std::pair<std::string, std::string>> parseList(const char* text) {
+    std::vector<std::pair<std::string, std::string>> items;
+    std::string_view rest = text ? text : "";
+    while (!rest.empty()) {
+        const std::size_t comma = rest.find(',');
+        std::string_view item = rest.substr(0, comma);
+        rest = comma == std::string_view::npos ? std::string_view() : rest.substr(comma + 1);
+        while (!item.empty() && item.front() == ' ') item.remove_prefix(1);
+        while (!item.empty() && item.back() == ' ') item.remove_suffix(1);
+        if (item.empty()) continue;
+        const std::size_t eq = item.find('=');
+        if (eq == std::string_view::npos)
+            items.emplace_back(std::string(), std::string(item));
+        else
+            items.emplace_back(std::string(item.substr(0, eq)), std::string(item.substr(eq + 1)));
+    }
+    return items;
+}
+
+struct Registration {
+    std::string kernel, detail, chosen, reason;
+};
+
+inline std::mutex& registryMutex() {
+    static std::mutex m;
+    return m;
+}
+inline std::vector<Registration>& registry() {
+    static std::vector<Registration> r;
+    return r;
+}
+
+}  // namespace cpu_dispatch_detail
+
+// What the hardware (and OS) supports; detected once
+inline const CpuFeatureSet& cpuFeaturesDetected() {
+    static const CpuFeatureSet s = cpu_dispatch_detail::detect();
+    return s;
+}
+
+// What kernels may use: detected minus CPU_DISPATCH_DISABLE
+inline const CpuFeatureSet& cpuFeatures() {
+    static const CpuFeatureSet s = [] {
+        CpuFeatureSet usable = cpuFeaturesDetected();
+        for (const auto& [key, name] : cpu_dispatch_detail::parseList(std::getenv("CPU_DISPATCH_DISABLE")))
+            for (unsigned i = 0; i < unsigned(CpuFeature::Count); ++i)
+                if (key.empty() && name == cpuFeatureName(CpuFeature(i))) usable.set(CpuFeature(i), false);
+        return usable;
+    }();
+    return s;
+}
+
+template <typename Fn>
+class DispatchedKernel {
+public:
+    struct Variant {
+        const char* name;
+        CpuFeatureSet needs;
+        Fn fn;
+    };
+
+    // variants: best first; the last one should require nothing.
+    // detail: what distinguishes instances of one kernel ("float")
+    DispatchedKernel(const char* kernel, const char* detail, std::initializer_list<Variant> variants)
+        : kernel_(kernel), variants_(variants) {
+        std::string reason = "best supported";
+        const Variant* chosen = nullptr;
+        for (const Variant& v : variants_)
+            if (cpuFeatures().covers(v.needs)) {
+                chosen = &v;
+                break;
+            }
+        // CPU_DISPATCH: a per-kernel entry wins over a global one
+        const Variant* forced = nullptr;
+        bool perKernel = false;
+        for (const auto& [key, name] : cpu_dispatch_detail::parseList(std::getenv("CPU_DISPATCH"))) {
+            if (!key.empty() && key != kernel_) continue;
+            if (perKernel && key.empty()) continue;
+            for (const Variant& v : variants_) {
+                if (name != v.name) continue;
+                if (!cpuFeatures().covers(v.needs)) {
+                    std::fprintf(stderr, "CPU_DISPATCH: %s=%s needs %s, not available here; ignored\n", kernel,
+                                 v.name, v.needs.describe().c_str());
+                    break;
+                }
+                forced = &v;
+                perKernel = !key.empty();
+            }
+        }
+        if (forced) chosen = forced, reason = "forced by CPU_DISPATCH";
+        if (!chosen) chosen = &variants_.back(), reason = "no variant matched; last one";
+        fn_ = chosen->fn;
+        name_ = chosen->name;
+        std::lock_guard<std::mutex> lock(cpu_dispatch_detail::registryMutex());
+        cpu_dispatch_detail::registry().push_back({kernel, detail ? detail : "", name_, reason});
+    }
+
+    DispatchedKernel(const DispatchedKernel&) = delete;
+    DispatchedKernel& operator=(const DispatchedKernel&) = delete;
+
+    template <typename... Args>
+    decltype(auto) operator()(Args&&... args) const {
+        return fn_(std::forward<Args>(args)...);
+    }
+
+    Fn get() const { return fn_; }
+    const char* kernel() const { return kernel_; }
+    const char* selected() const { return name_; }
+    const std::vector<Variant>& variants() const { return variants_; }
+
+    // A named variant, if this CPU can run it (nullptr otherwise)
+    Fn variant(std::string_view name) const {
+        for (const Variant& v : variants_)
+            if (name == v.name && cpuFeatures().covers(v.needs)) return v.fn;
+        return nullptr;
+    }
+
+    // The names this CPU can run, best first
+    std::vector<const char*> supported() const {
+        std::vector<const char*> names;
+        for (const Variant& v : variants_)
+            if (cpuFeatures().covers(v.needs)) names.push_back(v.name);
+        return names;
+    }
+
+private:
+    const char* kernel_;
+    std::vector<Variant> variants_;
+    Fn fn_ = nullptr;
+    const char* name_ = "";
+};
+
+// Every kernel selected so far: "kernel <detail>: variant (reason)"
+inline void dispatchReport(std::ostream& out = std::cout) {
+    out << "cpu features: " << cpuFeaturesDetected().describe();
+    if (!cpuFeatures().covers(cpuFeaturesDetected())) out << "   usable: " << cpuFeatures().describe();
+    out << '\n';
+    std::lock_guard<std::mutex> lock(cpu_dispatch_detail::registryMutex());
+    for (const cpu_dispatch_detail::Registration& r : cpu_dispatch_detail::registry())
+        out << "  " << r.kernel << (r.detail.empty() ? "" : " <" + r.detail + ">") << ": " << r.chosen << " ("
+            << r.reason << ")\n";
+}
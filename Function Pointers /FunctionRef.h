@@ -0,0 +1,119 @@
+// ======================================================
+// FunctionRef.h — non-allocating callables for callbacks
+// ======================================================
+//
+// theory.cpp passes callbacks as:
+//   MathFunc (int(*)(int,int))     → no captures possible
+//   std::function<int(int,int)>    → captures OK, but the
+//       target may be heap-allocated and every call goes
+//       through an opaque manager/invoker pair
+//
+// function_ref<R(Args...)>   — NON-OWNING
+//   two pointers: the callable's address + a "thunk" that
+//   knows its type. Never allocates. The callable must outlive
+//   the function_ref (perfect for parameters like
+//   executeCallback(function_ref<int(int,int)> cb, ...)).
+//
+// InplaceFunction<R(Args...), Bytes>  — OWNING, no heap
+//   stores the callable in an inline buffer of Bytes; a
+//   callable that does not fit is a COMPILE error (never a
+//   hidden allocation). Copyable if the callable is.
+//
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Sig>
+class function_ref;
+
+template <typename R, typename... Args>
+class function_ref<R(Args...)> {
+public:
+    // Plain function: store the function pointer itself
+    function_ref(R (*fn)(Args...)) noexcept
+        : obj_(reinterpret_cast<void*>(fn)), call_([](void* o, Args... a) -> R {
+              return reinterpret_cast<R (*)(Args...)>(o)(std::forward<Args>(a)...);
+          }) {}
+
+    // Any other callable (lambda, functor): store its address
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, function_ref> &&
+                                          !std::is_function_v<std::remove_reference_t<F>> &&
+                                          std::is_invocable_r_v<R, F&, Args...>>>
+    function_ref(F&& f) noexcept
+        : obj_(const_cast<void*>(static_cast<const void*>(std::addressof(f)))),
+          call_([](void* o, Args... a) -> R {
+              return std::invoke(*static_cast<std::remove_reference_t<F>*>(o),
+                                 std::forward<Args>(a)...);
+          }) {}
+
+    R operator()(Args... a) const { return call_(obj_, std::forward<Args>(a)...); }
+
+private:
+    void* obj_;
+    R (*call_)(void*, Args...);
+};
+
+template <typename Sig, std::size_t Bytes = 32>
+class InplaceFunction;
+
+template <typename R, typename... Args, std::size_t Bytes>
+class InplaceFunction<R(Args...), Bytes> {
+    struct Ops {
+        R (*call)(void*, Args...);
+        void (*copy)(const void* from, void* to);
+        void (*destroy)(void*) noexcept;
+    };
+
+    template <typename F>
+    static const Ops* opsFor() {
+        static const Ops ops{
+            [](void* o, Args... a) -> R { return std::invoke(*static_cast<F*>(o), std::forward<Args>(a)...); },
+            [](const void* from, void* to) { ::new (to) F(*static_cast<const F*>(from)); },
+            [](void* o) noexcept { static_cast<F*>(o)->~F(); }};
+        return &ops;
+    }
+
+public:
+    InplaceFunction() = default;
+
+    template <typename F, typename D = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<D, InplaceFunction> &&
+                                          std::is_invocable_r_v<R, D&, Args...>>>
+    InplaceFunction(F&& f) {
+        static_assert(sizeof(D) <= Bytes, "callable too big for this InplaceFunction: raise Bytes");
+        static_assert(alignof(D) <= alignof(std::max_align_t), "over-aligned callable");
+        static_assert(std::is_copy_constructible_v<D>, "InplaceFunction needs a copyable callable");
+        ::new (buf_) D(std::forward<F>(f));
+        ops_ = opsFor<D>();
+    }
+
+    InplaceFunction(const InplaceFunction& o) : ops_(o.ops_) {
+        if (ops_) ops_->copy(o.buf_, buf_);
+    }
+    InplaceFunction& operator=(const InplaceFunction& o) {
+        if (this != &o) {
+            reset();
+            if (o.ops_) o.ops_->copy(o.buf_, buf_);
+            ops_ = o.ops_;
+        }
+        return *this;
+    }
+    ~InplaceFunction() { reset(); }
+
+    explicit operator bool() const { return ops_ != nullptr; }
+    R operator()(Args... a) const { return ops_->call(const_cast<unsigned char*>(buf_), std::forward<Args>(a)...); }
+
+private:
+    void reset() noexcept {
+        if (ops_) ops_->destroy(buf_);
+        ops_ = nullptr;
+    }
+
+    const Ops* ops_ = nullptr;
+    alignas(std::max_align_t) unsigned char buf_[Bytes];
+};
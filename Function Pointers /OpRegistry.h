@@ -0,0 +1,69 @@
+// ======================================================
+// OpRegistry.h — constexpr operation table → switch dispatch
+// ======================================================
+//
+// theory.cpp's jump table:
+//
+//     MathFunc operations[2];
+//     operations[0] = add;  operations[1] = sub;
+//     operations[i](x, y);          // indirect call, never inlined
+//
+// OpRegistry<Enum, f0, f1, ...> fixes the table at COMPILE
+// time: the functions are template arguments, so
+//
+//     MathOps::call(Op::Sub, x, y)
+//
+// expands to   switch (op) { case 0: return f0(x, y); case 1: ... }
+// - a DIRECT call per case → every function can be inlined
+// - the compiler may turn the switch into a jump table or
+//   a few compares, whichever is faster
+// - usable in constant expressions when the functions are
+//   constexpr
+//
+// Enum values must be 0, 1, 2 ... in the same order as the
+// functions (checked by Enum::Count when it exists).
+//
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+template <typename Enum, auto... Fns>
+struct OpRegistry {
+    static_assert(std::is_enum_v<Enum>, "OpRegistry is keyed by an enum");
+    static_assert(sizeof...(Fns) > 0 && sizeof...(Fns) <= 16,
+                  "extend the switch in call() for more operations");
+
+    static constexpr std::size_t size = sizeof...(Fns);
+
+    static constexpr bool countMatches() {
+        if constexpr (requires { Enum::Count; })
+            return static_cast<std::size_t>(Enum::Count) == size;
+        else
+            return true;
+    }
+    static_assert(countMatches(), "Enum::Count differs from the number of registered functions");
+
+    template <std::size_t I>
+    static constexpr auto fn = std::get<I>(std::make_tuple(Fns...));
+
+    template <typename... Args>
+    static constexpr decltype(auto) call(Enum op, Args&&... args) {
+        using R = std::common_type_t<std::invoke_result_t<decltype(Fns), Args...>...>;
+        switch (static_cast<std::size_t>(op)) {
+#define OP_REGISTRY_CASE(I) \
+    case I:                 \
+        if constexpr (I < size) return static_cast<R>(fn<I>(std::forward<Args>(args)...)); \
+        [[fallthrough]];
+            OP_REGISTRY_CASE(0) OP_REGISTRY_CASE(1) OP_REGISTRY_CASE(2) OP_REGISTRY_CASE(3)
+            OP_REGISTRY_CASE(4) OP_REGISTRY_CASE(5) OP_REGISTRY_CASE(6) OP_REGISTRY_CASE(7)
+            OP_REGISTRY_CASE(8) OP_REGISTRY_CASE(9) OP_REGISTRY_CASE(10) OP_REGISTRY_CASE(11)
+            OP_REGISTRY_CASE(12) OP_REGISTRY_CASE(13) OP_REGISTRY_CASE(14) OP_REGISTRY_CASE(15)
+#undef OP_REGISTRY_CASE
+            default:
+                __builtin_unreachable();
+        }
+    }
+};
@@ -0,0 +1,137 @@
+// ==========================================================
+// TOPIC: Compile-Time Dispatch Table vs Function Pointers
+// ==========================================================
+//
+// theory.cpp selects behaviour at runtime with:
+//
+//     MathFunc operations[2] = {add, sub};   // jump table
+//     function<int(int,int)> f = ...;       // std::function
+//
+// Both are INDIRECT calls: the compiler cannot see which
+// function runs, so nothing gets inlined, and std::function
+// may put a capturing lambda on the heap.
+//
+// Replacements used here:
+// - OpRegistry<Op, add, sub, mul, ...> (OpRegistry.h)
+//     enum-keyed, constexpr, expands to a switch of DIRECT calls
+// - function_ref<int(int,int)>      (FunctionRef.h)
+//     non-owning callback parameter, never allocates
+// - InplaceFunction<int(int,int)>   (FunctionRef.h)
+//     owning, stores the capture inline, never allocates
+//
+// Benchmark: 10^8 dispatches with a runtime-varying operation
+// through raw pointer, std::function, function_ref and the
+// constexpr table.
+//
+// Build:
+//   g++ -std=c++20 -O2 dispatchTable.cpp -o dispatch
+//
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <vector>
+#include "FunctionRef.h"
+#include "OpRegistry.h"
+
+using namespace std;
+using namespace std::chrono;
+
+constexpr int add(int a, int b) { return a + b; }
+constexpr int sub(int a, int b) { return a - b; }
+constexpr int mul(int a, int b) { return a * b; }
+constexpr int bitXor(int a, int b) { return a ^ b; }
+
+using MathFunc = int (*)(int, int);
+
+enum class Op : uint8_t { Add, Sub, Mul, Xor, Count };
+
+using MathOps = OpRegistry<Op, add, sub, mul, bitXor>;
+
+// The table is usable at compile time
+static_assert(MathOps::call(Op::Add, 10, 5) == 15);
+static_assert(MathOps::call(Op::Mul, 10, 5) == 50);
+
+// Callback parameter: accepts functions, lambdas, stateful lambdas
+void executeCallback(function_ref<int(int, int)> callback, int x, int y) {
+    cout << "Callback result = " << callback(x, y) << endl;
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+int main() {
+    // ---- Same API as theory.cpp, no std::function ----
+    int factor = 3;
+    auto stateful = [factor](int a, int b) { return (a + b) * factor; };
+    executeCallback(add, 20, 10);
+    executeCallback(sub, 20, 10);
+    executeCallback(stateful, 10, 5);
+
+    InplaceFunction<int(int, int)> stored = stateful;   // owns a copy, inline
+    cout << "InplaceFunction = " << stored(10, 5) << endl;
+    cout << "MathOps::call(Op::Sub, 50, 30) = " << MathOps::call(Op::Sub, 50, 30) << endl;
+
+    // ---- Benchmark ----
+    constexpr long long n = 100'000'000;
+    constexpr size_t kPattern = 4096;           // power of two
+    vector<Op> ops(kPattern);
+    uint32_t seed = 12345;
+    for (auto& op : ops) {
+        seed = seed * 1664525u + 1013904223u;
+        op = static_cast<Op>((seed >> 16) % static_cast<unsigned>(Op::Count));
+    }
+
+    MathFunc raw[] = {add, sub, mul, bitXor};
+    function<int(int, int)> stdf[] = {add, sub, mul, bitXor};
+    function_ref<int(int, int)> refs[] = {add, sub, mul, bitXor};
+
+    auto run = [&](auto&& dispatch) {
+        int acc = 0;
+        double ms = timeMs([&] {
+            for (long long i = 0; i < n; ++i) {
+                Op op = ops[i & (kPattern - 1)];
+                acc = dispatch(op, acc, static_cast<int>(i)) & 0xFFFFF;
+            }
+        });
+        return pair<double, int>(ms, acc);
+    };
+
+    auto rRaw = run([&](Op op, int a, int b) { return raw[static_cast<size_t>(op)](a, b); });
+    auto rStd = run([&](Op op, int a, int b) { return stdf[static_cast<size_t>(op)](a, b); });
+    auto rRef = run([&](Op op, int a, int b) { return refs[static_cast<size_t>(op)](a, b); });
+    auto rTab = run([](Op op, int a, int b) { return MathOps::call(op, a, b); });
+
+    cout << "\n10^8 dispatches (random op of 4):" << endl;
+    cout << "raw function pointer: " << rRaw.first << " ms" << endl;
+    cout << "std::function:        " << rStd.first << " ms" << endl;
+    cout << "function_ref:         " << rRef.first << " ms" << endl;
+    cout << "constexpr OpRegistry: " << rTab.first << " ms" << endl;
+    bool same = rRaw.second == rStd.second && rRaw.second == rRef.second &&
+                rRaw.second == rTab.second;
+    cout << "same results: " << (same ? "yes" : "NO") << endl;
+    return same ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A function pointer array is an indirect call the
+//    optimiser cannot see through; a switch over a FIXED set
+//    of functions is a set of direct, inlinable calls.
+// 2. Passing functions as template arguments (auto... Fns)
+//    moves the table to compile time and makes it constexpr.
+// 3. function_ref is the right callback PARAMETER type:
+//    two pointers, no ownership, no allocation.
+// 4. When a callable must be STORED, an inline-buffer
+//    function avoids std::function's possible heap use.
+//
+// ⭐ One-Line Interview Answer
+// “Replace runtime function-pointer tables with an enum-keyed
+// constexpr switch so calls can inline, and pass callbacks as
+// function_ref so nothing is allocated or type-erased twice.”
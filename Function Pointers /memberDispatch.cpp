@@ -0,0 +1,127 @@
+// ==========================================================
+// TOPIC: Pointer-to-Member Calls Bound at Compile Time
+// ==========================================================
+//
+// example.cpp and Multithreading/staticmeberThread.cpp use:
+//
+//     int (MyClass::*ptr)(int, int) = &MyClass::Add;
+//     (obj.*ptr)(3, 9);
+//     std::thread t(&Base::nonStaticRun, &b, 5);
+//
+// In a loop over many objects, a member pointer held in a
+// variable is an indirect call per object (plus the virtual/
+// this-adjustment check), so the loop cannot be optimised.
+//
+// BoundMethod.h puts the member pointer in a template
+// argument → direct call → inlined → vectorisable loop.
+//
+// Measured here: 1M particles, 100 passes of advance(dt) and
+// one pass of energy(), through
+// - a runtime member pointer (obj.*ptr)(dt)
+// - invoke_all<&Particle::advance>(span, dt)
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread memberDispatch.cpp -o memberdispatch
+//
+#include <chrono>
+#include <iostream>
+#include <span>
+#include <thread>
+#include <vector>
+#include "BoundMethod.h"
+
+using namespace std;
+using namespace std::chrono;
+
+class MyClass {
+public:
+    int Add(int a, int b) { return a + b; }
+};
+
+class Base {
+public:
+    void nonStaticRun(int x) {
+        while (x-- > 0) cout << "Non-Static Thread: " << x << endl;
+    }
+};
+
+class Particle {
+public:
+    float x = 0, v = 1;
+
+    void advance(float dt) { x += v * dt; }
+    void reverse(float) { v = -v; }
+    float energy() const { return 0.5f * v * v; }
+};
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+int main() {
+    // ---- Same calls as example.cpp / staticmeberThread.cpp ----
+    MyClass obj;
+    cout << "bound_method<&MyClass::Add>::call(obj, 3, 9) = "
+         << bound_method<&MyClass::Add>::call(obj, 3, 9) << endl;
+
+    Base b;
+    thread t(bound_method<&Base::nonStaticRun>::on(b), 3);
+    t.join();
+
+    // ---- Benchmark ----
+    constexpr size_t n = 1'000'000;
+    constexpr int passes = 100;
+    const float dt = 0.001f;
+
+    vector<Particle> a(n), c(n);
+    for (size_t i = 0; i < n; ++i) a[i].v = c[i].v = 1.0f + static_cast<float>(i % 7);
+
+    // Chosen at runtime, like a user-selected action
+    volatile int pick = 0;
+    void (Particle::*ptr)(float) = pick == 0 ? &Particle::advance : &Particle::reverse;
+
+    double ptrMs = timeMs([&] {
+        for (int p = 0; p < passes; ++p)
+            for (Particle& q : a) (q.*ptr)(dt);
+    });
+    double boundMs = timeMs([&] {
+        for (int p = 0; p < passes; ++p) invoke_all<&Particle::advance>(span<Particle>(c), dt);
+    });
+
+    vector<float> energies(n);
+    invoke_all<&Particle::energy>(span<const Particle>(c), span<float>(energies));
+
+    bool same = true;
+    for (size_t i = 0; i < n; ++i) same = same && a[i].x == c[i].x;
+    double total = 0;
+    for (float e : energies) total += e;
+
+    cout << "\n" << n << " particles x " << passes << " passes of advance(dt):" << endl;
+    cout << "(obj.*ptr)(dt)                : " << ptrMs << " ms" << endl;
+    cout << "invoke_all<&Particle::advance>: " << boundMs << " ms" << endl;
+    cout << "total energy " << total << ", same positions: " << (same ? "yes" : "NO") << endl;
+    return same ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A pointer-to-member is not a plain address: calling it
+//    checks for virtual and adjusts `this` before an indirect
+//    call.
+// 2. `template <auto Method>` turns the member pointer into a
+//    compile-time constant, so (obj.*Method)(...) is an
+//    ordinary direct call the compiler can inline.
+// 3. Inlined member calls over a contiguous span let the
+//    compiler vectorise the loop; indirect ones never do.
+// 4. The bound object (one pointer) still works wherever a
+//    callable is expected, e.g. std::thread.
+//
+// ⭐ One-Line Interview Answer
+// “Make the member pointer a template argument so each call
+// is direct and inlinable, then run it over a span of objects
+// and let the compiler vectorise the loop.”
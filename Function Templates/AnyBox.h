@@ -0,0 +1,205 @@
+// ======================================================
+// AnyBox.h — Box<T> without copies, AnyBox without mallocs
+// ======================================================
+//
+// classTemplate.cpp:
+//
+//     template <typename T> class Box {
+//         T value;
+//         T getValue() { return value; }     // ⚠ COPY every call
+//     };
+//
+// Box<string>::getValue() copies the string (and may allocate)
+// just so the caller can read it.
+//
+// 1. Box<T>::getValue() is REF-QUALIFIED:
+//      const T& getValue() const &   → read, no copy
+//      T&       getValue() &         → modify in place
+//      T        getValue() &&        → temporary box: MOVE out
+//
+// 2. AnyBox<InlineBytes>: ONE type that holds any Box<T>/T
+//    - objects up to InlineBytes (and nothrow-movable) live
+//      INSIDE the AnyBox → vector<AnyBox<>> with ints, floats
+//      and short strings performs no per-element allocation
+//    - bigger objects fall back to the heap
+//    - type erasure via a static table of function pointers
+//      per stored type (destroy / copy / move), no virtual
+//      base class, no RTTI
+//    - get<T>() → T* or nullptr: one pointer compare
+//
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename T>
+class Box {
+private:
+    T value;
+
+public:
+    Box(T v) : value(std::move(v)) {}
+
+    const T& getValue() const& { return value; }
+    T& getValue() & { return value; }
+    T getValue() && { return std::move(value); }
+};
+
+template <typename T>
+constexpr bool isBox = false;
+template <typename T>
+constexpr bool isBox<Box<T>> = true;
+
+template <std::size_t InlineBytes = 32>
+class AnyBox {
+    struct VTable {
+        const void* type;                                   // unique per T
+        void (*destroy)(AnyBox&) noexcept;
+        void (*copy)(const AnyBox& from, AnyBox& to);
+        void (*move)(AnyBox& from, AnyBox& to) noexcept;    // leaves `from` empty
+        bool inlineStored;
+    };
+
+    template <typename T>
+    static constexpr bool fitsInline = sizeof(T) <= InlineBytes &&
+                                       alignof(T) <= alignof(std::max_align_t) &&
+                                       std::is_nothrow_move_constructible_v<T>;
+
+    template <typename T>
+    struct TypeTag {
+        static constexpr char id = 0;
+    };
+
+    template <typename T>
+    static T* ptr(AnyBox& b) {
+        if constexpr (fitsInline<T>) return std::launder(reinterpret_cast<T*>(b.storage_));
+        else return static_cast<T*>(b.heap_);
+    }
+    template <typename T>
+    static const T* ptr(const AnyBox& b) {
+        return ptr<T>(const_cast<AnyBox&>(b));
+    }
+
+    template <typename T>
+    static const VTable* vtableFor() {
+        static const VTable vt{
+            &TypeTag<T>::id,
+            [](AnyBox& b) noexcept {
+                if constexpr (fitsInline<T>) ptr<T>(b)->~T();
+                else delete ptr<T>(b);
+            },
+            [](const AnyBox& from, AnyBox& to) {
+                if constexpr (fitsInline<T>) ::new (to.storage_) T(*ptr<T>(from));
+                else to.heap_ = new T(*ptr<T>(from));
+            },
+            [](AnyBox& from, AnyBox& to) noexcept {
+                if constexpr (fitsInline<T>) {
+                    ::new (to.storage_) T(std::move(*ptr<T>(from)));
+                    ptr<T>(from)->~T();
+                } else {
+                    to.heap_ = from.heap_;                 // steal the pointer
+                }
+            },
+            fitsInline<T>};
+        return &vt;
+    }
+
+public:
+    AnyBox() = default;
+
+    template <typename T, typename D = std::decay_t<T>,
+              typename = std::enable_if_t<!std::is_same_v<D, AnyBox> && !isBox<D>>>
+    AnyBox(T&& value) {
+        emplace<D>(std::forward<T>(value));
+    }
+
+    // AnyBox(Box<T>) stores the T itself
+    template <typename T>
+    AnyBox(const Box<T>& box) {
+        emplace<T>(box.getValue());
+    }
+    template <typename T>
+    AnyBox(Box<T>&& box) {
+        emplace<T>(std::move(box).getValue());
+    }
+
+    AnyBox(const AnyBox& o) {
+        if (o.vt_) {
+            o.vt_->copy(o, *this);
+            vt_ = o.vt_;
+        }
+    }
+    AnyBox(AnyBox&& o) noexcept {
+        if (o.vt_) {
+            o.vt_->move(o, *this);
+            vt_ = o.vt_;
+            o.vt_ = nullptr;
+        }
+    }
+    AnyBox& operator=(const AnyBox& o) {
+        if (this != &o) {
+            AnyBox tmp(o);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+    AnyBox& operator=(AnyBox&& o) noexcept {
+        if (this != &o) {
+            reset();
+            if (o.vt_) {
+                o.vt_->move(o, *this);
+                vt_ = o.vt_;
+                o.vt_ = nullptr;
+            }
+        }
+        return *this;
+    }
+    ~AnyBox() { reset(); }
+
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        reset();
+        if constexpr (fitsInline<T>) {
+            ::new (storage_) T(std::forward<Args>(args)...);
+        } else {
+            heap_ = new T(std::forward<Args>(args)...);
+        }
+        vt_ = vtableFor<T>();
+        return *ptr<T>(*this);
+    }
+
+    void reset() noexcept {
+        if (vt_) {
+            vt_->destroy(*this);
+            vt_ = nullptr;
+        }
+    }
+
+    bool hasValue() const { return vt_ != nullptr; }
+    bool isInline() const { return vt_ && vt_->inlineStored; }
+
+    template <typename T>
+    bool holds() const {
+        return vt_ && vt_->type == &TypeTag<T>::id;
+    }
+
+    template <typename T>
+    T* get() {
+        return holds<T>() ? ptr<T>(*this) : nullptr;
+    }
+    template <typename T>
+    const T* get() const {
+        return holds<T>() ? ptr<T>(*this) : nullptr;
+    }
+
+    static constexpr std::size_t inlineCapacity() { return InlineBytes; }
+
+private:
+    const VTable* vt_ = nullptr;
+    union {
+        alignas(std::max_align_t) unsigned char storage_[InlineBytes];
+        void* heap_;
+    };
+};
@@ -0,0 +1,4 @@
+// The one copy of every specialization Instantiations.h declares
+// extern: link this TU into any program that includes it.
+#define INSTANTIATIONS_DEFINE
+#include "Instantiations.h"
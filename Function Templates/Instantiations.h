@@ -0,0 +1,88 @@
+// ======================================================
+// Instantiations.h — Box / Vector2D / GetMin / GetMax compiled ONCE
+// ======================================================
+//
+// classTemplate.cpp, inline.cpp, template.cpp:
+//
+//     Box<int> intBox(10);            // Box<int> generated HERE
+//     Vector2D<int> v(3, 4);          // Vector2D<int> generated HERE
+//     GetMax(values);                 // GetMax<int> generated HERE
+//
+// A template's code is generated in EVERY translation unit that
+// uses it; the linker then throws all but one copy away. With
+// the headers in many TUs, each TU parses, instantiates,
+// optimizes and emits the same functions again.
+//
+// Including this header instead of AnyBox.h / VectorN.h /
+// MinMax.h declares the common specializations
+//
+//     extern template class Box<int>;                     // "exists elsewhere"
+//
+// so the TU only emits calls; Instantiations.cpp holds the one
+// explicit instantiation of each (link it in):
+//
+//   Box<T>                        int  float  double  std::string
+//   Vector2D<T> = Vector<T, 2>    int  float  double
+//   transform(span / VectorSoA)   int* float  double       (*AoS only)
+//   GetMin / GetMax (span)        int  float  double  std::string
+//   minmax_simd::minmax, min_element, max_element   same four
+//
+// Not in the list, on purpose:
+// - Vector<std::string, 2>: length(), dot() need arithmetic T
+// - two-value GetMin(a, b) / GetMax(a, b): constexpr, so inline —
+//   extern template does not apply to inline functions (and a
+//   one-compare body belongs inlined at the call anyway)
+// - members defined in the class (Box, Vector) stay inlinable:
+//   at -O2 callers still inline them, extern only stops the
+//   out-of-line copies being emitted in every TU
+//
+// Other types (Box<long>, Vector<float, 3>) are still generated
+// implicitly where they are used, as before.
+//
+// One list serves both sides: Instantiations.cpp defines
+// INSTANTIATIONS_DEFINE before including this file, which turns
+// every "extern template" below into "template".
+//
+#pragma once
+
+#include <span>
+#include <string>
+#include "AnyBox.h"
+#include "MinMax.h"
+#include "VectorN.h"
+
+#if defined(INSTANTIATIONS_DEFINE)
+#define INSTANTIATIONS_EXTERN
+#else
+#define INSTANTIATIONS_EXTERN extern
+#endif
+
+INSTANTIATIONS_EXTERN template class Box<int>;
+INSTANTIATIONS_EXTERN template class Box<float>;
+INSTANTIATIONS_EXTERN template class Box<double>;
+INSTANTIATIONS_EXTERN template class Box<std::string>;
+
+INSTANTIATIONS_EXTERN template class Vector<int, 2>;
+INSTANTIATIONS_EXTERN template class Vector<float, 2>;
+INSTANTIATIONS_EXTERN template class Vector<double, 2>;
+
+INSTANTIATIONS_EXTERN template void transform<int, 2>(std::span<Vector<int, 2>>, const Matrix<int, 2>&);
+INSTANTIATIONS_EXTERN template void transform<float, 2>(std::span<Vector<float, 2>>, const Matrix<float, 2>&);
+INSTANTIATIONS_EXTERN template void transform<double, 2>(std::span<Vector<double, 2>>, const Matrix<double, 2>&);
+INSTANTIATIONS_EXTERN template void transform<float, 2>(VectorSoA<float, 2>&, const Matrix<float, 2>&);
+INSTANTIATIONS_EXTERN template void transform<double, 2>(VectorSoA<double, 2>&, const Matrix<double, 2>&);
+
+#define INSTANTIATIONS_RANGE(T)                                                               \
+    INSTANTIATIONS_EXTERN template T GetMin<T>(std::span<const T>);                           \
+    INSTANTIATIONS_EXTERN template T GetMax<T>(std::span<const T>);                           \
+    INSTANTIATIONS_EXTERN template MinMaxPair<T> minmax_simd::minmax<T>(std::span<const T>);  \
+    INSTANTIATIONS_EXTERN template const T* minmax_simd::min_element<T>(std::span<const T>);  \
+    INSTANTIATIONS_EXTERN template const T* minmax_simd::max_element<T>(std::span<const T>);
+
+INSTANTIATIONS_RANGE(int)
+INSTANTIATIONS_RANGE(float)
+INSTANTIATIONS_RANGE(double)
+INSTANTIATIONS_RANGE(std::string)
+
+#undef INSTANTIATIONS_RANGE
+#undef INSTANTIATIONS_EXTERN
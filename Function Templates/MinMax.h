@@ -0,0 +1,268 @@
+// ======================================================
+// MinMax.h — GetMin/GetMax for mixed types and whole ranges
+// ======================================================
+//
+// template.cpp / funcTemplate2.cpp:
+//
+//     template <typename T> T GetMax(T a, T b);
+//     template <typename T, typename U> T GetMin(T a, U b);   // ⚠ returns T
+//
+// GetMin(2, 3.5)   → int 2        fine
+// GetMin(9, 0.5)   → int 0        ⚠ the double 0.5 was truncated
+//
+// TWO-VALUE VERSIONS (here):
+//   return MinMaxResult<T, U>, a type that can hold BOTH:
+//   - usually std::common_type_t<T, U>   (int, double → double)
+//   - signed/unsigned integer mixes → a wider SIGNED type
+//     (int, unsigned → long long), compared with std::cmp_less
+//     so GetMin(-1, 5u) == -1, not 4294967295
+//
+// RANGE VERSIONS   (std::span<const T>):
+//   GetMin(span) / GetMax(span)           → value
+//   minmax_simd::min_element(span)        → pointer to first min
+//   minmax_simd::max_element(span)        → pointer to first max
+//   minmax_simd::minmax(span)             → {min, max} in ONE pass
+//
+// For arithmetic T the reduction is BRANCHLESS and SIMD:
+// GCC/Clang vector extensions (register-wide vectors, 4
+// independent accumulators), one code path for every int/float
+// width, compiled at three widths and picked per host by
+// CpuDispatch.h (kernel "minmax"):
+//   avx512  64 bytes   avx512f + avx512bw
+//   avx2    32 bytes
+//   simd    16 bytes   SSE2 / NEON, the baseline
+//   scalar  the plain loop (also the only path on other compilers)
+// No -mavx2 needed: one binary runs the widest the CPU has.
+//
+// Empty range: min_element/max_element return the end pointer;
+// GetMin/GetMax/minmax must not be called with an empty range.
+// NaN inputs give an unspecified (but non-crashing) result,
+// just like std::min_element.
+//
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "../Function Pointers /CpuDispatch.h"
+
+// --------------------------------------------------
+// Result type for mixed operands
+// --------------------------------------------------
+namespace minmax_detail {
+
+// Integer types std::cmp_less accepts (no bool, no character types)
+template <typename T>
+constexpr bool stdInteger = std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                            !std::is_same_v<T, char> && !std::is_same_v<T, wchar_t> &&
+                            !std::is_same_v<T, char8_t> && !std::is_same_v<T, char16_t> &&
+                            !std::is_same_v<T, char32_t>;
+
+template <typename T, typename U>
+struct Result {
+    using type = std::common_type_t<T, U>;
+};
+
+template <typename T, typename U>
+    requires(stdInteger<T> && stdInteger<U> && std::is_signed_v<T> != std::is_signed_v<U>)
+struct Result<T, U> {
+    // A signed type wide enough for both (64-bit mixes stay common_type)
+    using type = std::conditional_t<(sizeof(T) < 8 && sizeof(U) < 8), long long,
+                                    std::common_type_t<T, U>>;
+};
+
+template <typename T, typename U>
+constexpr bool less(T a, U b) {
+    if constexpr (stdInteger<T> && stdInteger<U>)
+        return std::cmp_less(a, b);
+    else
+        return a < b;
+}
+
+}  // namespace minmax_detail
+
+template <typename T, typename U>
+using MinMaxResult = typename minmax_detail::Result<T, U>::type;
+
+template <typename T, typename U>
+constexpr MinMaxResult<T, U> GetMin(T a, U b) {
+    using R = MinMaxResult<T, U>;
+    return minmax_detail::less(b, a) ? (R)b : (R)a;
+}
+
+template <typename T, typename U>
+constexpr MinMaxResult<T, U> GetMax(T a, U b) {
+    using R = MinMaxResult<T, U>;
+    return minmax_detail::less(a, b) ? (R)b : (R)a;
+}
+
+// --------------------------------------------------
+// Range kernels
+// --------------------------------------------------
+template <typename T>
+struct MinMaxPair {
+    T min;
+    T max;
+};
+
+namespace minmax_detail {
+
+template <typename T>
+constexpr bool vectorizable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+                              !std::is_same_v<T, long double>;
+
+#if defined(__GNUC__)
+template <typename T, std::size_t Bytes>
+using Vec [[gnu::vector_size(Bytes)]] = T;
+#endif
+
+// Want: 1 = min, 2 = max, 3 = both; Bytes: vector width (0 = scalar)
+template <int Want, std::size_t Bytes, typename T>
+[[gnu::always_inline]] inline MinMaxPair<T> reduceWith(const T* p, std::size_t n) {
+    T lo = p[0], hi = p[0];
+    std::size_t i = 0;
+#if defined(__GNUC__)
+    if constexpr (vectorizable<T> && Bytes != 0) {
+        using V = Vec<T, Bytes>;
+        constexpr std::size_t L = Bytes / sizeof(T);
+        if (n >= 4 * L) {
+            V mn[4], mx[4];
+            for (int k = 0; k < 4; ++k) {
+                std::memcpy(&mn[k], p + k * L, sizeof(V));      // unaligned load
+                mx[k] = mn[k];
+            }
+            for (i = 4 * L; i + 4 * L <= n; i += 4 * L) {
+                for (int k = 0; k < 4; ++k) {
+                    V v;
+                    std::memcpy(&v, p + i + k * L, sizeof(V));
+                    if constexpr (Want & 1) mn[k] = v < mn[k] ? v : mn[k];   // lane-wise select
+                    if constexpr (Want & 2) mx[k] = mx[k] < v ? v : mx[k];
+                }
+            }
+            for (int k = 1; k < 4; ++k) {
+                mn[0] = mn[k] < mn[0] ? mn[k] : mn[0];
+                mx[0] = mx[0] < mx[k] ? mx[k] : mx[0];
+            }
+            for (std::size_t k = 0; k < L; ++k) {
+                if constexpr (Want & 1) lo = mn[0][k] < lo ? mn[0][k] : lo;
+                if constexpr (Want & 2) hi = hi < mx[0][k] ? mx[0][k] : hi;
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if constexpr (Want & 1) lo = p[i] < lo ? p[i] : lo;
+        if constexpr (Want & 2) hi = hi < p[i] ? p[i] : hi;
+    }
+    return {lo, hi};
+}
+
+// The variants CpuDispatch.h chooses from
+template <int Want, typename T>
+MinMaxPair<T> reduceScalar(const T* p, std::size_t n) {
+    return reduceWith<Want, 0>(p, n);
+}
+
+template <int Want, typename T>
+MinMaxPair<T> reduceSimd(const T* p, std::size_t n) {
+    return reduceWith<Want, 16>(p, n);
+}
+
+#if defined(CPU_DISPATCH_X86) && defined(__GNUC__)
+template <int Want, typename T>
+CPU_DISPATCH_TARGET("avx2") MinMaxPair<T> reduceAvx2(const T* p, std::size_t n) {
+    return reduceWith<Want, 32>(p, n);
+}
+
+template <int Want, typename T>
+CPU_DISPATCH_TARGET("avx512f,avx512bw") MinMaxPair<T> reduceAvx512(const T* p, std::size_t n) {
+    return reduceWith<Want, 64>(p, n);
+}
+#endif
+
+template <typename T>
+constexpr const char* typeName() {
+    if constexpr (std::is_floating_point_v<T>) return sizeof(T) == 4 ? "float" : "double";
+    else if constexpr (std::is_signed_v<T>)
+        return sizeof(T) == 1 ? "int8" : sizeof(T) == 2 ? "int16" : sizeof(T) == 4 ? "int32" : "int64";
+    else return sizeof(T) == 1 ? "uint8" : sizeof(T) == 2 ? "uint16" : sizeof(T) == 4 ? "uint32" : "uint64";
+}
+
+// One dispatched kernel per (Want, T), selected on first use
+template <int Want, typename T>
+const DispatchedKernel<MinMaxPair<T> (*)(const T*, std::size_t)>& reduceKernel() {
+    static constexpr const char* kWant[] = {"", " min", " max", ""};
+    static const std::string detail = std::string(typeName<T>()) + kWant[Want];
+    static const DispatchedKernel<MinMaxPair<T> (*)(const T*, std::size_t)> k{"minmax", detail.c_str(), {
+#if defined(CPU_DISPATCH_X86) && defined(__GNUC__)
+        {"avx512", {CpuFeature::Avx512f, CpuFeature::Avx512bw}, reduceAvx512<Want, T>},
+        {"avx2", {CpuFeature::Avx2}, reduceAvx2<Want, T>},
+#endif
+#if defined(__GNUC__)
+        {"simd", {}, reduceSimd<Want, T>},
+#endif
+        {"scalar", {}, reduceScalar<Want, T>},
+    }};
+    return k;
+}
+
+template <int Want, typename T>
+MinMaxPair<T> reduce(const T* p, std::size_t n) {
+    if constexpr (vectorizable<T>) return reduceKernel<Want, T>()(p, n);
+    else return reduceWith<Want, 0>(p, n);
+}
+
+}  // namespace minmax_detail
+
+namespace minmax_simd {
+
+template <typename T>
+const T* min_element(std::span<const T> s) {
+    if (s.empty()) return s.data() + s.size();
+    if constexpr (minmax_detail::vectorizable<T>) {
+        T m = minmax_detail::reduce<1>(s.data(), s.size()).min;
+        const T* it = std::find(s.data(), s.data() + s.size(), m);   // first occurrence
+        // Not found: a NaN minimum (NaN != NaN); let std decide
+        return it != s.data() + s.size() ? it : std::min_element(s.data(), s.data() + s.size());
+    } else {
+        return std::min_element(s.data(), s.data() + s.size());
+    }
+}
+
+template <typename T>
+const T* max_element(std::span<const T> s) {
+    if (s.empty()) return s.data() + s.size();
+    if constexpr (minmax_detail::vectorizable<T>) {
+        T m = minmax_detail::reduce<2>(s.data(), s.size()).max;
+        const T* it = std::find(s.data(), s.data() + s.size(), m);
+        return it != s.data() + s.size() ? it : std::max_element(s.data(), s.data() + s.size());
+    } else {
+        return std::max_element(s.data(), s.data() + s.size());
+    }
+}
+
+template <typename T>
+MinMaxPair<T> minmax(std::span<const T> s) {
+    if constexpr (minmax_detail::vectorizable<T>) {
+        return minmax_detail::reduce<3>(s.data(), s.size());
+    } else {
+        auto [lo, hi] = std::minmax_element(s.data(), s.data() + s.size());
+        return {*lo, *hi};
+    }
+}
+
+}  // namespace minmax_simd
+
+template <typename T>
+T GetMin(std::span<const T> s) {
+    return minmax_detail::reduce<1>(s.data(), s.size()).min;
+}
+
+template <typename T>
+T GetMax(std::span<const T> s) {
+    return minmax_detail::reduce<2>(s.data(), s.size()).max;
+}
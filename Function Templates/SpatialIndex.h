@@ -0,0 +1,351 @@
+// ======================================================
+// SpatialIndex.h — uniform hash grid (moving objects), BVH (static ones)
+// ======================================================
+//
+// classTempEx.cpp / union.cpp:
+//
+//     Vector2D<int> v(3, 4);
+//     struct Move { int x, y; };
+//
+// Objects have positions, and "who is near p?" is a loop over
+// every object: O(n) per query, O(n²) for everyone's neighbours.
+//
+// UniformGrid<T> — objects that MOVE:
+//
+//   cell size s: the plane cut into s × s cells, only the cells
+//   that hold something stored (hashed by cell coordinates)
+//
+//     grid.insert(id, p);  grid.move(id, p2);  grid.remove(id);
+//     grid.radius(c, r, out);                 // ids within r of c
+//     grid.box(lo, hi, out);                  // ids in [lo, hi]
+//     grid.radiusBatch(centers, r, out, offsets);
+//
+//   - a cell keeps its ids AND positions side by side: a query
+//     reads the cells its circle or box overlaps, contiguously
+//   - move(): a position update in place while the object stays
+//     in its cell; otherwise a swap-remove from the old cell and
+//     an append to the new one — O(1) either way
+//   - radiusBatch: queries sorted by cell first, so consecutive
+//     queries read the same cells while they are in cache;
+//     results in the callers' order, query q's in
+//     out[offsets[q] .. offsets[q + 1])
+//   - cost: (cells overlapped) + (objects in them); with s about
+//     the query radius that is 9 cells and about k + a constant
+//     objects, independent of n
+//   - ids are small integers (indices into the caller's arrays);
+//     memory is proportional to the largest id. Cells that empty
+//     out are kept for reuse
+//
+// StaticBvh<T> — objects that never move, with EXTENTS (walls,
+// obstacles):
+//
+//   built once from boxes: median split on the longer axis down to
+//   leaves of up to 8 boxes; every node stores the box around its
+//   subtree. Queries descend only into nodes whose box overlaps:
+//
+//     bvh.build(boxes);
+//     bvh.box(lo, hi, out);      bvh.radius(c, r, out);
+//
+//   Node order is depth-first (a node's left child follows it):
+//   the walk reads memory mostly forward.
+//
+// Coordinates: T float, double or an integer type (distances of
+// integer coordinates are squared in 64 bits).
+//
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "VectorN.h"
+
+namespace spatial_detail {
+
+template <typename T>
+using Wide = std::conditional_t<std::is_integral_v<T>, std::int64_t, T>;
+
+template <typename T>
+Wide<T> distanceSquared(const Vector2D<T>& a, const Vector2D<T>& b) {
+    const Wide<T> dx = Wide<T>(a[0]) - Wide<T>(b[0]), dy = Wide<T>(a[1]) - Wide<T>(b[1]);
+    return dx * dx + dy * dy;
+}
+
+} // namespace spatial_detail
+
+template <typename T>
+class UniformGrid {
+public:
+    using Vec = Vector2D<T>;
+
+    // Throws std::invalid_argument unless cellSize > 0
+    explicit UniformGrid(T cellSize) : cell_(double(cellSize)) {
+        if (!(cellSize > T(0))) throw std::invalid_argument("UniformGrid: cell size must be > 0");
+    }
+
+    void reserve(std::size_t ids) { loc_.reserve(ids); }
+
+    // Throws std::logic_error if id is already in the grid
+    void insert(std::uint32_t id, Vec p) {
+        if (id >= loc_.size()) loc_.resize(std::size_t(id) + 1);
+        if (loc_[id].cell != kNone) throw std::logic_error("UniformGrid: id inserted twice");
+        append(id, p, cellIndex(cellOf(p[0]), cellOf(p[1])));
+        ++size_;
+    }
+
+    // True if the object changed cell; an id not in the grid is ignored
+    bool move(std::uint32_t id, Vec p) {
+        if (!contains(id)) return false;
+        Loc& l = loc_[id];
+        const std::int32_t cx = cellOf(p[0]), cy = cellOf(p[1]);
+        Cell& from = cells_[l.cell];
+        if (from.cx == cx && from.cy == cy) {
+            from.pos[l.slot] = p;
+            return false;
+        }
+        const std::uint32_t to = cellIndex(cx, cy);     // may grow cells_: `from` not used after
+        detach(id);
+        append(id, p, to);
+        return true;
+    }
+
+    void remove(std::uint32_t id) {
+        if (!contains(id)) return;
+        detach(id);
+        loc_[id].cell = kNone;
+        --size_;
+    }
+
+    bool contains(std::uint32_t id) const { return id < loc_.size() && loc_[id].cell != kNone; }
+    Vec position(std::uint32_t id) const { return cells_[loc_[id].cell].pos[loc_[id].slot]; }
+    std::size_t size() const { return size_; }
+    std::size_t cells() const { return cells_.size(); }
+
+    // f(id, position) for every object within r of c (inclusive)
+    template <typename F>
+    void forEachInRadius(Vec c, T r, F&& f) const {
+        const auto r2 = spatial_detail::Wide<T>(r) * spatial_detail::Wide<T>(r);
+        forEachCell(cellOf(c[0] - r), cellOf(c[1] - r), cellOf(c[0] + r), cellOf(c[1] + r), [&](const Cell& cell) {
+            for (std::size_t i = 0; i < cell.ids.size(); ++i)
+                if (spatial_detail::distanceSquared(cell.pos[i], c) <= r2) f(cell.ids[i], cell.pos[i]);
+        });
+    }
+
+    // f(id, position) for every object with lo <= p <= hi
+    template <typename F>
+    void forEachInBox(Vec lo, Vec hi, F&& f) const {
+        forEachCell(cellOf(lo[0]), cellOf(lo[1]), cellOf(hi[0]), cellOf(hi[1]), [&](const Cell& cell) {
+            for (std::size_t i = 0; i < cell.ids.size(); ++i) {
+                const Vec& p = cell.pos[i];
+                if (p[0] >= lo[0] && p[0] <= hi[0] && p[1] >= lo[1] && p[1] <= hi[1]) f(cell.ids[i], p);
+            }
+        });
+    }
+
+    // Appended to out
+    void radius(Vec c, T r, std::vector<std::uint32_t>& out) const {
+        forEachInRadius(c, r, [&](std::uint32_t id, const Vec&) { out.push_back(id); });
+    }
+    void box(Vec lo, Vec hi, std::vector<std::uint32_t>& out) const {
+        forEachInBox(lo, hi, [&](std::uint32_t id, const Vec&) { out.push_back(id); });
+    }
+
+    // out and offsets are replaced; offsets has centers.size() + 1 entries
+    void radiusBatch(std::span<const Vec> centers, T r, std::vector<std::uint32_t>& out,
+                     std::vector<std::uint32_t>& offsets) const {
+        const std::size_t q = centers.size();
+        std::vector<std::uint32_t> qi(q);
+        std::iota(qi.begin(), qi.end(), 0u);
+        std::vector<std::uint64_t> keys(q);
+        for (std::size_t i = 0; i < q; ++i) keys[i] = key(cellOf(centers[i][0]), cellOf(centers[i][1]));
+        std::sort(qi.begin(), qi.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return keys[a] != keys[b] ? keys[a] < keys[b] : a < b;
+        });
+        // answered in cell order into a scratch list, then laid out in query order
+        std::vector<std::uint32_t> scratch, begin(q), count(q);
+        for (std::uint32_t i : qi) {
+            begin[i] = std::uint32_t(scratch.size());
+            radius(centers[i], r, scratch);
+            count[i] = std::uint32_t(scratch.size()) - begin[i];
+        }
+        offsets.assign(q + 1, 0);
+        for (std::size_t i = 0; i < q; ++i) offsets[i + 1] = offsets[i] + count[i];
+        out.resize(scratch.size());
+        for (std::size_t i = 0; i < q; ++i)
+            std::copy_n(scratch.begin() + begin[i], count[i], out.begin() + offsets[i]);
+    }
+
+private:
+    static constexpr std::uint32_t kNone = ~0u;
+
+    struct Loc {
+        std::uint32_t cell = kNone, slot = 0;
+    };
+    struct Cell {
+        std::int32_t cx, cy;
+        std::vector<std::uint32_t> ids;
+        std::vector<Vec> pos;
+    };
+
+    std::int32_t cellOf(T v) const {
+        const double c = std::floor(double(v) / cell_);
+        return std::int32_t(std::clamp(c, double(std::numeric_limits<std::int32_t>::min()),
+                                       double(std::numeric_limits<std::int32_t>::max())));
+    }
+    static std::uint64_t key(std::int32_t cx, std::int32_t cy) {
+        return std::uint64_t(std::uint32_t(cx)) << 32 | std::uint32_t(cy);
+    }
+
+    std::uint32_t cellIndex(std::int32_t cx, std::int32_t cy) {
+        auto [it, fresh] = index_.try_emplace(key(cx, cy), std::uint32_t(cells_.size()));
+        if (fresh) cells_.push_back({cx, cy, {}, {}});
+        return it->second;
+    }
+
+    void append(std::uint32_t id, Vec p, std::uint32_t c) {
+        Cell& cell = cells_[c];
+        loc_[id] = {c, std::uint32_t(cell.ids.size())};
+        cell.ids.push_back(id);
+        cell.pos.push_back(p);
+    }
+
+    // Swap-remove from its cell (the last object takes its slot)
+    void detach(std::uint32_t id) {
+        const Loc l = loc_[id];
+        Cell& cell = cells_[l.cell];
+        const std::uint32_t last = cell.ids.back();
+        cell.ids[l.slot] = last;
+        cell.pos[l.slot] = cell.pos.back();
+        loc_[last].slot = l.slot;
+        cell.ids.pop_back();
+        cell.pos.pop_back();
+    }
+
+    // Every stored cell in [x0, x1] × [y0, y1]; a huge range walks the
+    // stored cells instead of the empty ones
+    template <typename F>
+    void forEachCell(std::int32_t x0, std::int32_t y0, std::int32_t x1, std::int32_t y1, F&& f) const {
+        const std::uint64_t span =
+            (std::uint64_t(std::int64_t(x1) - x0) + 1) * (std::uint64_t(std::int64_t(y1) - y0) + 1);
+        if (span > cells_.size()) {
+            for (const Cell& c : cells_)
+                if (c.cx >= x0 && c.cx <= x1 && c.cy >= y0 && c.cy <= y1 && !c.ids.empty()) f(c);
+            return;
+        }
+        for (std::int64_t x = x0; x <= x1; ++x)
+            for (std::int64_t y = y0; y <= y1; ++y) {
+                auto it = index_.find(key(std::int32_t(x), std::int32_t(y)));
+                if (it != index_.end()) f(cells_[it->second]);
+            }
+    }
+
+    double cell_;
+    std::vector<Loc> loc_;                       // by id
+    std::vector<Cell> cells_;
+    std::unordered_map<std::uint64_t, std::uint32_t> index_;
+    std::size_t size_ = 0;
+};
+
+template <typename T>
+class StaticBvh {
+public:
+    using Vec = Vector2D<T>;
+
+    struct Box {
+        Vec lo, hi;
+    };
+
+    // Box i gets id i. Replaces any previous contents
+    void build(std::span<const Box> boxes) {
+        boxes_.assign(boxes.begin(), boxes.end());
+        ids_.resize(boxes_.size());
+        std::iota(ids_.begin(), ids_.end(), 0u);
+        nodes_.clear();
+        if (!boxes_.empty()) split(0, std::uint32_t(ids_.size()));
+    }
+
+    std::size_t size() const { return boxes_.size(); }
+    std::size_t nodes() const { return nodes_.size(); }
+
+    // Boxes overlapping [lo, hi], appended to out
+    void box(Vec lo, Vec hi, std::vector<std::uint32_t>& out) const {
+        walk([&](const Box& b) { return overlaps(b, lo, hi); }, out);
+    }
+    // Boxes within r of c (the box's nearest point), appended to out
+    void radius(Vec c, T r, std::vector<std::uint32_t>& out) const {
+        const auto r2 = spatial_detail::Wide<T>(r) * spatial_detail::Wide<T>(r);
+        walk([&](const Box& b) { return nearest2(b, c) <= r2; }, out);
+    }
+
+private:
+    static constexpr std::uint32_t kLeaf = 8;
+
+    struct Node {
+        Box bounds;
+        std::uint32_t right;                    // inner node: index of the right child (left = this + 1)
+        std::uint32_t first, count;             // leaf: ids_[first .. first + count); count 0 = inner
+    };
+
+    static bool overlaps(const Box& b, const Vec& lo, const Vec& hi) {
+        return b.lo[0] <= hi[0] && b.hi[0] >= lo[0] && b.lo[1] <= hi[1] && b.hi[1] >= lo[1];
+    }
+    static spatial_detail::Wide<T> nearest2(const Box& b, const Vec& c) {
+        const Vec p(std::clamp(c[0], b.lo[0], b.hi[0]), std::clamp(c[1], b.lo[1], b.hi[1]));
+        return spatial_detail::distanceSquared(p, c);
+    }
+
+    std::uint32_t split(std::uint32_t first, std::uint32_t last) {
+        const std::uint32_t self = std::uint32_t(nodes_.size());
+        Box bounds = boxes_[ids_[first]];
+        for (std::uint32_t i = first + 1; i < last; ++i) {
+            const Box& b = boxes_[ids_[i]];
+            bounds.lo = Vec(std::min(bounds.lo[0], b.lo[0]), std::min(bounds.lo[1], b.lo[1]));
+            bounds.hi = Vec(std::max(bounds.hi[0], b.hi[0]), std::max(bounds.hi[1], b.hi[1]));
+        }
+        nodes_.push_back({bounds, 0, first, last - first});
+        if (last - first <= kLeaf) return self;
+        // median of the box centres on the longer axis
+        const int axis = (bounds.hi[0] - bounds.lo[0]) >= (bounds.hi[1] - bounds.lo[1]) ? 0 : 1;
+        const std::uint32_t mid = first + (last - first) / 2;
+        std::nth_element(ids_.begin() + first, ids_.begin() + mid, ids_.begin() + last,
+                         [&](std::uint32_t a, std::uint32_t b) {
+                             return boxes_[a].lo[axis] + boxes_[a].hi[axis] < boxes_[b].lo[axis] + boxes_[b].hi[axis];
+                         });
+        nodes_[self].count = 0;
+        split(first, mid);
+        const std::uint32_t right = split(mid, last);
+        nodes_[self].right = right;
+        return self;
+    }
+
+    template <typename Hit>
+    void walk(Hit&& hit, std::vector<std::uint32_t>& out) const {
+        if (nodes_.empty()) return;
+        std::uint32_t stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top) {
+            const Node& n = nodes_[stack[--top]];
+            if (!hit(n.bounds)) continue;
+            if (n.count) {
+                for (std::uint32_t i = n.first; i < n.first + n.count; ++i)
+                    if (hit(boxes_[ids_[i]])) out.push_back(ids_[i]);
+                continue;
+            }
+            const std::uint32_t self = std::uint32_t(&n - nodes_.data());
+            stack[top++] = n.right;
+            stack[top++] = self + 1;                // left first: it follows in memory
+        }
+    }
+
+    std::vector<Box> boxes_;
+    std::vector<std::uint32_t> ids_;
+    std::vector<Node> nodes_;
+};
@@ -0,0 +1,226 @@
+// ======================================================
+// VectorExpr.h — fused (expression-template) arithmetic on arrays of Vector<T, N>
+// ======================================================
+//
+// classTempEx.cpp's Vector2D<T> is Vector<T, 2> (VectorN.h), with
+// + - * on single vectors. Over whole arrays the eager version
+//
+//     std::vector<Vector2D<float>> r = a + b * s - c;
+//
+// builds the answer one operator at a time:
+//
+//     t1 = b * s        read b,          write t1
+//     t2 = a + t1       read a, t1,      write t2
+//     r  = t2 - c       read t2, c,      write r
+//
+// two temporary arrays, each allocated, written and read back
+// once: 8 array passes through memory for 4 arrays of data.
+//
+// Here the operators only RECORD the expression; assigning it
+// runs one loop that computes r[i] = a[i] + b[i] * s - c[i] per
+// element — 3 reads + 1 write, no temporary array, no allocation:
+//
+//     VectorArray<float, 2> a(n), b(n), c(n), r(n);
+//     r = a + b * s - c;                   // one pass
+//
+//     assign(out, lazy(spanA) * 0.5f + lazy(spanB));   // spans too
+//     VectorArray<float, 2> x = evaluate(a - b);
+//
+// - per element the existing Vector operators run (Ops<T, N>:
+//   SIMD for the specialized sizes); within one element the
+//   "temporaries" are registers
+// - nodes hold operands by value: a VectorArray or span becomes a
+//   pointer + size (VectorRef), so a stored expression is a few
+//   words; VectorArrays it refers to must outlive it
+// - r = r + a * s is fine: element i is read before it is written
+//   and nothing else is read from r
+// - operands of + and - must have the same size
+//   (std::invalid_argument when the expression is built)
+//
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "VectorN.h"
+
+namespace vector_expr {
+
+// Base of every expression node (CRTP tag)
+template <class E>
+struct Expr {};
+
+template <class E>
+concept Node = std::is_base_of_v<Expr<E>, E>;
+
+// Leaf: a contiguous run of vectors
+template <class T, std::size_t N>
+struct VectorRef : Expr<VectorRef<T, N>> {
+    using value_type = Vector<T, N>;
+    using scalar_type = T;
+
+    const Vector<T, N>* data;
+    std::size_t count;
+
+    std::size_t size() const { return count; }
+    const Vector<T, N>& operator[](std::size_t i) const { return data[i]; }
+};
+
+template <class L, class R, class Op>
+struct Binary : Expr<Binary<L, R, Op>> {
+    using value_type = typename L::value_type;
+    using scalar_type = typename L::scalar_type;
+    static_assert(std::is_same_v<value_type, typename R::value_type>, "operands of different Vector<T, N> types");
+
+    L l;
+    R r;
+
+    Binary(const L& left, const R& right) : l(left), r(right) {
+        if (l.size() != r.size())
+            throw std::invalid_argument("vector expression: sizes " + std::to_string(l.size()) + " and " +
+                                        std::to_string(r.size()) + " differ");
+    }
+    std::size_t size() const { return l.size(); }
+    value_type operator[](std::size_t i) const { return Op::apply(l[i], r[i]); }
+};
+
+template <class E>
+struct Scaled : Expr<Scaled<E>> {
+    using value_type = typename E::value_type;
+    using scalar_type = typename E::scalar_type;
+
+    E e;
+    scalar_type s;
+
+    Scaled(const E& expr, scalar_type scale) : e(expr), s(scale) {}
+    std::size_t size() const { return e.size(); }
+    value_type operator[](std::size_t i) const { return e[i] * s; }
+};
+
+struct Plus {
+    template <class V>
+    static V apply(const V& a, const V& b) { return a + b; }
+};
+struct Minus {
+    template <class V>
+    static V apply(const V& a, const V& b) { return a - b; }
+};
+
+}  // namespace vector_expr
+
+// Owning array of vectors; assigning an expression evaluates it
+template <class T, std::size_t N>
+class VectorArray {
+public:
+    using value_type = Vector<T, N>;
+
+    VectorArray() = default;
+    explicit VectorArray(std::size_t n) : v_(n) {}
+
+    template <vector_expr::Node E>
+    VectorArray(const E& e) : v_(e.size()) {
+        assign(e);
+    }
+
+    template <vector_expr::Node E>
+    VectorArray& operator=(const E& e) {
+        if (v_.size() != e.size()) v_.resize(e.size());
+        assign(e);
+        return *this;
+    }
+
+    std::size_t size() const { return v_.size(); }
+    Vector<T, N>& operator[](std::size_t i) { return v_[i]; }
+    const Vector<T, N>& operator[](std::size_t i) const { return v_[i]; }
+    Vector<T, N>* data() { return v_.data(); }
+    const Vector<T, N>* data() const { return v_.data(); }
+    operator std::span<Vector<T, N>>() { return v_; }
+    operator std::span<const Vector<T, N>>() const { return v_; }
+
+    vector_expr::VectorRef<T, N> ref() const { return {{}, v_.data(), v_.size()}; }
+
+private:
+    template <class E>
+    void assign(const E& e) {
+        Vector<T, N>* out = v_.data();
+        const std::size_t n = v_.size();
+        for (std::size_t i = 0; i < n; ++i) out[i] = e[i];        // the one pass
+    }
+
+    std::vector<Vector<T, N>> v_;
+};
+
+namespace vector_expr {
+
+template <class A>
+struct IsArray : std::false_type {};
+template <class T, std::size_t N>
+struct IsArray<VectorArray<T, N>> : std::true_type {};
+
+// What an operator can take: a node or a VectorArray
+template <class A>
+concept Operand = Node<A> || IsArray<A>::value;
+
+// A VectorArray enters an expression as a reference to its data
+template <class A>
+auto term(const A& a) {
+    if constexpr (IsArray<A>::value) return a.ref();
+    else return a;
+}
+
+template <class A>
+using TermOf = decltype(term(std::declval<const A&>()));
+
+}  // namespace vector_expr
+
+// A span as an expression leaf
+template <class T, std::size_t N>
+vector_expr::VectorRef<T, N> lazy(std::span<const Vector<T, N>> s) {
+    return {{}, s.data(), s.size()};
+}
+template <class T, std::size_t N>
+vector_expr::VectorRef<T, N> lazy(std::span<Vector<T, N>> s) {
+    return {{}, s.data(), s.size()};
+}
+
+template <vector_expr::Operand L, vector_expr::Operand R>
+auto operator+(const L& l, const R& r) {
+    using namespace vector_expr;
+    return Binary<TermOf<L>, TermOf<R>, Plus>(term(l), term(r));
+}
+
+template <vector_expr::Operand L, vector_expr::Operand R>
+auto operator-(const L& l, const R& r) {
+    using namespace vector_expr;
+    return Binary<TermOf<L>, TermOf<R>, Minus>(term(l), term(r));
+}
+
+template <vector_expr::Operand E>
+auto operator*(const E& e, typename vector_expr::TermOf<E>::scalar_type s) {
+    using namespace vector_expr;
+    return Scaled<TermOf<E>>(term(e), s);
+}
+
+template <vector_expr::Operand E>
+auto operator*(typename vector_expr::TermOf<E>::scalar_type s, const E& e) {
+    return e * s;
+}
+
+// out[i] = e[i] for every i, one pass; sizes must match
+template <class T, std::size_t N, vector_expr::Node E>
+void assign(std::span<Vector<T, N>> out, const E& e) {
+    if (out.size() != e.size())
+        throw std::invalid_argument("assign: output has " + std::to_string(out.size()) + " vectors, expression " +
+                                    std::to_string(e.size()));
+    for (std::size_t i = 0; i < out.size(); ++i) out[i] = e[i];
+}
+
+// A new array holding the expression's value
+template <vector_expr::Node E>
+auto evaluate(const E& e) {
+    using V = typename E::value_type;
+    return VectorArray<typename E::scalar_type, V::size()>(e);
+}
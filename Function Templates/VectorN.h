@@ -0,0 +1,483 @@
+// ======================================================
+// VectorN.h — Vector<T, N>: Vector2D grown to N dimensions
+// ======================================================
+//
+// classTempEx.cpp / inline.cpp:
+//
+//     template <class T> class Vector2D { T coordinate[2]; ... Display(); };
+//
+// Vector<T, N> keeps the same idea (a contiguous T array, one
+// class per T generated at compile time) and adds the math:
+//
+//   +  -  * (scalar)  dot  lengthSquared  length  lerp
+//   every operation is constexpr
+//
+//   Vector2D<T> is now an alias for Vector<T, 2>
+//
+// SIMD:
+// Arithmetic and dot go through vector_detail::Ops<T, N>.
+// The primary Ops is a plain loop; explicit specializations
+// use intrinsics when the target has them:
+//
+//               N = 2     N = 4     N = 8
+//   float        -        SSE/NEON  AVX
+//   double      SSE2/NEON AVX       AVX (2 × 256 bit)
+//
+// In constant evaluation the plain loop is always used
+// (std::is_constant_evaluated), so constexpr keeps working.
+//
+// BATCH TRANSFORM:
+//   transform(span<Vector<T,N>>, Matrix<T,N>)   AoS, one vector at a time
+//   transform(VectorSoA<T,N>&,   Matrix<T,N>)   SoA: coordinate k of
+//       every vector in its own array → 16 floats / 8 doubles
+//       per AVX-512 instruction (8 / 4 with AVX, 4 / 2 with
+//       SSE2 / NEON), independent of N; the width is chosen at
+//       run time (CpuDispatch.h), not by -mavx
+//   The per-vector Ops above stay compile-time: a call through a
+//   pointer would cost more than one 4-lane add.
+//
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../Function Pointers /CpuDispatch.h"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace vector_detail {
+
+// Natural alignment for the SIMD sizes (≤ 32 bytes, power of two)
+template <typename T, std::size_t N>
+constexpr std::size_t alignFor() {
+    std::size_t bytes = sizeof(T) * N;
+    if (bytes > 32) bytes = 32;
+    return (bytes & (bytes - 1)) == 0 ? bytes : alignof(T);
+}
+
+// --------------------------------------------------
+// Primary: plain loops (also the constexpr path)
+// --------------------------------------------------
+template <typename T, std::size_t N>
+struct Ops {
+    static constexpr bool simd = false;
+    static constexpr void add(const T* a, const T* b, T* r) {
+        for (std::size_t i = 0; i < N; ++i) r[i] = a[i] + b[i];
+    }
+    static constexpr void sub(const T* a, const T* b, T* r) {
+        for (std::size_t i = 0; i < N; ++i) r[i] = a[i] - b[i];
+    }
+    static constexpr void scale(const T* a, T s, T* r) {
+        for (std::size_t i = 0; i < N; ++i) r[i] = a[i] * s;
+    }
+    static constexpr T dot(const T* a, const T* b) {
+        T s{};
+        for (std::size_t i = 0; i < N; ++i) s += a[i] * b[i];
+        return s;
+    }
+};
+
+#if defined(__SSE2__)
+inline float hsum(__m128 v) {
+    __m128 sh = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 s = _mm_add_ps(v, sh);
+    sh = _mm_movehl_ps(sh, s);
+    return _mm_cvtss_f32(_mm_add_ss(s, sh));
+}
+inline double hsum(__m128d v) {
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+template <>
+struct Ops<float, 4> {
+    static constexpr bool simd = true;
+    static void add(const float* a, const float* b, float* r) {
+        _mm_storeu_ps(r, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+    }
+    static void sub(const float* a, const float* b, float* r) {
+        _mm_storeu_ps(r, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+    }
+    static void scale(const float* a, float s, float* r) {
+        _mm_storeu_ps(r, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(s)));
+    }
+    static float dot(const float* a, const float* b) {
+        return hsum(_mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+    }
+};
+
+template <>
+struct Ops<double, 2> {
+    static constexpr bool simd = true;
+    static void add(const double* a, const double* b, double* r) {
+        _mm_storeu_pd(r, _mm_add_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    }
+    static void sub(const double* a, const double* b, double* r) {
+        _mm_storeu_pd(r, _mm_sub_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    }
+    static void scale(const double* a, double s, double* r) {
+        _mm_storeu_pd(r, _mm_mul_pd(_mm_loadu_pd(a), _mm_set1_pd(s)));
+    }
+    static double dot(const double* a, const double* b) {
+        return hsum(_mm_mul_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+    }
+};
+#endif  // __SSE2__
+
+#if defined(__AVX__)
+inline float hsum(__m256 v) {
+    return hsum(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+}
+inline double hsum(__m256d v) {
+    return hsum(_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1)));
+}
+
+template <>
+struct Ops<float, 8> {
+    static constexpr bool simd = true;
+    static void add(const float* a, const float* b, float* r) {
+        _mm256_storeu_ps(r, _mm256_add_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b)));
+    }
+    static void sub(const float* a, const float* b, float* r) {
+        _mm256_storeu_ps(r, _mm256_sub_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b)));
+    }
+    static void scale(const float* a, float s, float* r) {
+        _mm256_storeu_ps(r, _mm256_mul_ps(_mm256_loadu_ps(a), _mm256_set1_ps(s)));
+    }
+    static float dot(const float* a, const float* b) {
+        return hsum(_mm256_mul_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b)));
+    }
+};
+
+template <>
+struct Ops<double, 4> {
+    static constexpr bool simd = true;
+    static void add(const double* a, const double* b, double* r) {
+        _mm256_storeu_pd(r, _mm256_add_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+    }
+    static void sub(const double* a, const double* b, double* r) {
+        _mm256_storeu_pd(r, _mm256_sub_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+    }
+    static void scale(const double* a, double s, double* r) {
+        _mm256_storeu_pd(r, _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_set1_pd(s)));
+    }
+    static double dot(const double* a, const double* b) {
+        return hsum(_mm256_mul_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+    }
+};
+
+template <>
+struct Ops<double, 8> {
+    static constexpr bool simd = true;
+    static void add(const double* a, const double* b, double* r) {
+        Ops<double, 4>::add(a, b, r);
+        Ops<double, 4>::add(a + 4, b + 4, r + 4);
+    }
+    static void sub(const double* a, const double* b, double* r) {
+        Ops<double, 4>::sub(a, b, r);
+        Ops<double, 4>::sub(a + 4, b + 4, r + 4);
+    }
+    static void scale(const double* a, double s, double* r) {
+        Ops<double, 4>::scale(a, s, r);
+        Ops<double, 4>::scale(a + 4, s, r + 4);
+    }
+    static double dot(const double* a, const double* b) {
+        __m256d lo = _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b));
+        __m256d hi = _mm256_mul_pd(_mm256_loadu_pd(a + 4), _mm256_loadu_pd(b + 4));
+        return hsum(_mm256_add_pd(lo, hi));
+    }
+};
+#endif  // __AVX__
+
+#if defined(__ARM_NEON) && !defined(__SSE2__)
+template <>
+struct Ops<float, 4> {
+    static constexpr bool simd = true;
+    static void add(const float* a, const float* b, float* r) { vst1q_f32(r, vaddq_f32(vld1q_f32(a), vld1q_f32(b))); }
+    static void sub(const float* a, const float* b, float* r) { vst1q_f32(r, vsubq_f32(vld1q_f32(a), vld1q_f32(b))); }
+    static void scale(const float* a, float s, float* r) { vst1q_f32(r, vmulq_n_f32(vld1q_f32(a), s)); }
+    static float dot(const float* a, const float* b) { return vaddvq_f32(vmulq_f32(vld1q_f32(a), vld1q_f32(b))); }
+};
+
+template <>
+struct Ops<double, 2> {
+    static constexpr bool simd = true;
+    static void add(const double* a, const double* b, double* r) { vst1q_f64(r, vaddq_f64(vld1q_f64(a), vld1q_f64(b))); }
+    static void sub(const double* a, const double* b, double* r) { vst1q_f64(r, vsubq_f64(vld1q_f64(a), vld1q_f64(b))); }
+    static void scale(const double* a, double s, double* r) { vst1q_f64(r, vmulq_n_f64(vld1q_f64(a), s)); }
+    static double dot(const double* a, const double* b) { return vaddvq_f64(vmulq_f64(vld1q_f64(a), vld1q_f64(b))); }
+};
+#endif  // __ARM_NEON
+
+// constexpr square root (Newton); std::sqrt at run time
+template <typename T>
+constexpr T sqrtConstexpr(T x) {
+    if (x <= T(0)) return T(0);
+    T r = x > T(1) ? x : T(1);
+    for (int i = 0; i < 64; ++i) {
+        T next = (r + x / r) / T(2);
+        if (next >= r) break;
+        r = next;
+    }
+    return r;
+}
+
+}  // namespace vector_detail
+
+template <class T, std::size_t N>
+class alignas(vector_detail::alignFor<T, N>()) Vector {
+    using Ops = vector_detail::Ops<T, N>;
+
+public:
+    T coordinate[N]{};
+
+    constexpr Vector() = default;
+
+    // Vector<float, 3> v(1, 2, 3);  (exactly N values)
+    template <typename... Us>
+        requires(sizeof...(Us) == N && (std::is_convertible_v<Us, T> && ...))
+    constexpr Vector(Us... values) : coordinate{static_cast<T>(values)...} {}
+
+    static constexpr std::size_t size() { return N; }
+    constexpr T& operator[](std::size_t i) { return coordinate[i]; }
+    constexpr const T& operator[](std::size_t i) const { return coordinate[i]; }
+
+    friend constexpr Vector operator+(const Vector& a, const Vector& b) {
+        Vector r;
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < N; ++i) r.coordinate[i] = a.coordinate[i] + b.coordinate[i];
+        } else {
+            Ops::add(a.coordinate, b.coordinate, r.coordinate);
+        }
+        return r;
+    }
+    friend constexpr Vector operator-(const Vector& a, const Vector& b) {
+        Vector r;
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < N; ++i) r.coordinate[i] = a.coordinate[i] - b.coordinate[i];
+        } else {
+            Ops::sub(a.coordinate, b.coordinate, r.coordinate);
+        }
+        return r;
+    }
+    friend constexpr Vector operator*(const Vector& a, T s) {
+        Vector r;
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < N; ++i) r.coordinate[i] = a.coordinate[i] * s;
+        } else {
+            Ops::scale(a.coordinate, s, r.coordinate);
+        }
+        return r;
+    }
+    friend constexpr Vector operator*(T s, const Vector& a) { return a * s; }
+
+    constexpr Vector& operator+=(const Vector& b) { return *this = *this + b; }
+    constexpr Vector& operator-=(const Vector& b) { return *this = *this - b; }
+    constexpr Vector& operator*=(T s) { return *this = *this * s; }
+
+    friend constexpr bool operator==(const Vector& a, const Vector& b) {
+        for (std::size_t i = 0; i < N; ++i)
+            if (a.coordinate[i] != b.coordinate[i]) return false;
+        return true;
+    }
+
+    friend constexpr T dot(const Vector& a, const Vector& b) {
+        if (std::is_constant_evaluated()) {
+            T s{};
+            for (std::size_t i = 0; i < N; ++i) s += a.coordinate[i] * b.coordinate[i];
+            return s;
+        }
+        return Ops::dot(a.coordinate, b.coordinate);
+    }
+
+    constexpr T lengthSquared() const { return dot(*this, *this); }
+
+    constexpr T length() const {
+        if (std::is_constant_evaluated()) return vector_detail::sqrtConstexpr(lengthSquared());
+        return (T)std::sqrt(lengthSquared());
+    }
+
+    // a + (b - a) * t
+    friend constexpr Vector lerp(const Vector& a, const Vector& b, T t) { return a + (b - a) * t; }
+
+    void Display() const {
+        static const char* names = "xyzw";
+        for (std::size_t i = 0; i < N; ++i) {
+            if (i < 4) std::cout << names[i] << ": ";
+            else std::cout << "[" << i << "]: ";
+            std::cout << coordinate[i] << (i + 1 < N ? " " : "\n");
+        }
+    }
+};
+
+template <class T>
+using Vector2D = Vector<T, 2>;
+
+// ======================================================
+// Matrix<T, N>: row-major N×N, r = M · v
+// ======================================================
+template <class T, std::size_t N>
+struct Matrix {
+    T m[N][N]{};
+
+    static constexpr Matrix identity() {
+        Matrix r;
+        for (std::size_t i = 0; i < N; ++i) r.m[i][i] = T(1);
+        return r;
+    }
+
+    constexpr Vector<T, N> operator*(const Vector<T, N>& v) const {
+        Vector<T, N> r;
+        for (std::size_t i = 0; i < N; ++i) {
+            T s{};
+            for (std::size_t j = 0; j < N; ++j) s += m[i][j] * v[j];
+            r[i] = s;
+        }
+        return r;
+    }
+};
+
+// ======================================================
+// SoA storage: coordinate k of every vector in c[k]
+// ======================================================
+template <class T, std::size_t N>
+struct VectorSoA {
+    std::vector<T> c[N];
+
+    std::size_t size() const { return c[0].size(); }
+    void resize(std::size_t n) {
+        for (auto& a : c) a.resize(n);
+    }
+    void set(std::size_t i, const Vector<T, N>& v) {
+        for (std::size_t k = 0; k < N; ++k) c[k][i] = v[k];
+    }
+    Vector<T, N> get(std::size_t i) const {
+        Vector<T, N> v;
+        for (std::size_t k = 0; k < N; ++k) v[k] = c[k][i];
+        return v;
+    }
+};
+
+// In place: v = M · v for every vector (AoS).
+// Written as  v = Σ column_j · v[j]  so the per-vector work is
+// Ops<T, N>::scale/add (SIMD for the specialized sizes).
+template <class T, std::size_t N>
+void transform(std::span<Vector<T, N>> vs, const Matrix<T, N>& M) {
+    Vector<T, N> col[N];
+    for (std::size_t j = 0; j < N; ++j)
+        for (std::size_t i = 0; i < N; ++i) col[j][i] = M.m[i][j];
+    for (Vector<T, N>& v : vs) {
+        Vector<T, N> r = col[0] * v[0];
+        for (std::size_t j = 1; j < N; ++j) r += col[j] * v[j];
+        v = r;
+    }
+}
+
+namespace vector_detail {
+
+#if defined(__GNUC__)
+template <typename T, std::size_t Bytes>
+using Lanes [[gnu::vector_size(Bytes)]] = T;
+#endif
+
+// Vectors [k, n) of s; Bytes: register width (0 = scalar only)
+template <class T, std::size_t N, std::size_t Bytes>
+[[gnu::always_inline]] inline void soaTransformWith(VectorSoA<T, N>& s, const Matrix<T, N>& M) {
+    const std::size_t n = s.size();
+    std::size_t k = 0;
+    T* ptr[N];
+    for (std::size_t j = 0; j < N; ++j) ptr[j] = s.c[j].data();
+#if defined(__GNUC__)
+    if constexpr (Bytes != 0) {
+        // One register of lanes from every coordinate array
+        using R = Lanes<T, Bytes>;
+        constexpr std::size_t lanes = Bytes / sizeof(T);
+        R bm[N][N];
+        for (std::size_t i = 0; i < N; ++i)
+            for (std::size_t j = 0; j < N; ++j) bm[i][j] = R{} + M.m[i][j];   // broadcast
+        for (; k + lanes <= n; k += lanes) {
+            R in[N];
+            for (std::size_t j = 0; j < N; ++j) std::memcpy(&in[j], ptr[j] + k, sizeof(R));
+            for (std::size_t i = 0; i < N; ++i) {
+                R acc = bm[i][0] * in[0];
+                for (std::size_t j = 1; j < N; ++j) acc = acc + bm[i][j] * in[j];
+                std::memcpy(ptr[i] + k, &acc, sizeof(R));
+            }
+        }
+    }
+#endif
+    // Scalar tail (and everything without SIMD)
+    for (; k < n; ++k) {
+        T in[N];
+        for (std::size_t j = 0; j < N; ++j) in[j] = ptr[j][k];
+        for (std::size_t i = 0; i < N; ++i) {
+            T acc = M.m[i][0] * in[0];
+            for (std::size_t j = 1; j < N; ++j) acc += M.m[i][j] * in[j];
+            ptr[i][k] = acc;
+        }
+    }
+}
+
+template <class T, std::size_t N>
+void soaTransformScalar(VectorSoA<T, N>& s, const Matrix<T, N>& M) {
+    soaTransformWith<T, N, 0>(s, M);
+}
+
+template <class T, std::size_t N>
+void soaTransformSimd(VectorSoA<T, N>& s, const Matrix<T, N>& M) {
+    soaTransformWith<T, N, 16>(s, M);
+}
+
+#if defined(CPU_DISPATCH_X86) && defined(__GNUC__)
+template <class T, std::size_t N>
+CPU_DISPATCH_TARGET("avx") void soaTransformAvx(VectorSoA<T, N>& s, const Matrix<T, N>& M) {
+    soaTransformWith<T, N, 32>(s, M);
+}
+
+template <class T, std::size_t N>
+CPU_DISPATCH_TARGET("avx512f") void soaTransformAvx512(VectorSoA<T, N>& s, const Matrix<T, N>& M) {
+    soaTransformWith<T, N, 64>(s, M);
+}
+#endif
+
+template <class T, std::size_t N>
+using SoaTransformFn = void (*)(VectorSoA<T, N>&, const Matrix<T, N>&);
+
+// One dispatched kernel per (T, N), selected on first use
+template <class T, std::size_t N>
+const DispatchedKernel<SoaTransformFn<T, N>>& soaTransformKernel() {
+    static const std::string detail = std::string(std::is_same_v<T, float> ? "float" : "double") + ", " +
+                                      std::to_string(N);
+    static const DispatchedKernel<SoaTransformFn<T, N>> k{"vector_transform", detail.c_str(), {
+#if defined(CPU_DISPATCH_X86) && defined(__GNUC__)
+        {"avx512", {CpuFeature::Avx512f}, soaTransformAvx512<T, N>},
+        {"avx", {CpuFeature::Avx}, soaTransformAvx<T, N>},
+#endif
+#if defined(__GNUC__)
+        {"simd", {}, soaTransformSimd<T, N>},
+#endif
+        {"scalar", {}, soaTransformScalar<T, N>},
+    }};
+    return k;
+}
+
+}  // namespace vector_detail
+
+// In place: v = M · v for every vector (SoA, SIMD across vectors;
+// the width is picked for this CPU: kernel "vector_transform")
+template <class T, std::size_t N>
+void transform(VectorSoA<T, N>& s, const Matrix<T, N>& M) {
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+        vector_detail::soaTransformKernel<T, N>()(s, M);
+    else
+        vector_detail::soaTransformWith<T, N, 0>(s, M);
+}
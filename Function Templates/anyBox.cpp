@@ -0,0 +1,200 @@
+// ==========================================================
+// TOPIC: Box<T> Access Without Copies, AnyBox Without Mallocs
+// ==========================================================
+//
+// classTemplate.cpp's Box<T>::getValue() returns T BY VALUE,
+// so reading a Box<string> copies the string every time.
+// And a "list of mixed boxes" is usually built like this:
+//
+//     vector<unique_ptr<BoxBase>> boxes;   // one new per element
+//
+// AnyBox.h fixes both:
+// - Box<T>::getValue() const& → const T&, && → moves out
+// - AnyBox<32> stores int / float / string INLINE, so
+//   vector<AnyBox<>> costs ZERO allocations per element
+//
+// Measured here (1M mixed values):
+// - heap allocations while building the container
+//   (global operator new is counted)
+// - time to read every value back
+// - getValue() copy vs reference on Box<string>
+//
+// Build:
+//   g++ -std=c++20 -O2 anyBox.cpp -o anybox
+//
+#include <any>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "AnyBox.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ---- Count every heap allocation in the program ----
+static size_t g_allocations = 0;
+void* operator new(size_t n) {
+    ++g_allocations;
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// The original Box, for comparison
+template <typename T>
+class OldBox {
+    T value;
+
+public:
+    OldBox(T v) : value(v) {}
+    T getValue() { return value; }
+};
+
+// ---- Baseline: classic OOP heterogeneous container ----
+struct BoxBase {
+    virtual ~BoxBase() {}
+    virtual double weight() const = 0;
+};
+template <typename T>
+struct VirtualBox : BoxBase {
+    Box<T> box;
+    explicit VirtualBox(T v) : box(std::move(v)) {}
+    double weight() const override {
+        if constexpr (is_same_v<T, string>) return (double)box.getValue().size();
+        else return (double)box.getValue();
+    }
+};
+
+template <typename F>
+double timeMs(F f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+int main() {
+    // ---- Same demo as classTemplate.cpp ----
+    Box<int> intBox(10);
+    Box<float> floatBox(3.14f);
+    Box<string> stringBox("Hello");
+    cout << intBox.getValue() << " " << floatBox.getValue() << " " << stringBox.getValue() << endl;
+    string moved = Box<string>("moved out").getValue();      // && overload: no copy
+    cout << moved << endl;
+
+    const int n = 1000000;
+    const string words[3] = {"Hello", "Box", "template"};    // short → SSO strings
+
+    // ---- Build ----
+    size_t a0 = g_allocations;
+    vector<unique_ptr<BoxBase>> virt;
+    virt.reserve(n);
+    double buildVirt = timeMs([&] {
+        for (int i = 0; i < n; ++i) {
+            switch (i % 3) {
+                case 0: virt.push_back(make_unique<VirtualBox<int>>(i)); break;
+                case 1: virt.push_back(make_unique<VirtualBox<float>>(i * 0.5f)); break;
+                default: virt.push_back(make_unique<VirtualBox<string>>(words[2])); break;
+            }
+        }
+    });
+    size_t allocVirt = g_allocations - a0;
+
+    a0 = g_allocations;
+    vector<any> anys;
+    anys.reserve(n);
+    double buildAny = timeMs([&] {
+        for (int i = 0; i < n; ++i) {
+            switch (i % 3) {
+                case 0: anys.emplace_back(i); break;
+                case 1: anys.emplace_back(i * 0.5f); break;
+                default: anys.emplace_back(words[2]); break;
+            }
+        }
+    });
+    size_t allocAny = g_allocations - a0;
+
+    a0 = g_allocations;
+    vector<AnyBox<>> boxes;
+    boxes.reserve(n);
+    double buildBox = timeMs([&] {
+        for (int i = 0; i < n; ++i) {
+            switch (i % 3) {
+                case 0: boxes.emplace_back(Box<int>(i)); break;
+                case 1: boxes.emplace_back(Box<float>(i * 0.5f)); break;
+                default: boxes.emplace_back(Box<string>(words[2])); break;
+            }
+        }
+    });
+    size_t allocBox = g_allocations - a0;
+
+    // ---- Access ----
+    double sumVirt = 0, sumAny = 0, sumBox = 0;
+    double readVirt = timeMs([&] {
+        for (auto& b : virt) sumVirt += b->weight();
+    });
+    double readAny = timeMs([&] {
+        for (auto& a : anys) {
+            if (auto* i = any_cast<int>(&a)) sumAny += *i;
+            else if (auto* f = any_cast<float>(&a)) sumAny += *f;
+            else sumAny += (double)any_cast<string>(&a)->size();
+        }
+    });
+    double readBox = timeMs([&] {
+        for (auto& b : boxes) {
+            if (auto* i = b.get<int>()) sumBox += *i;
+            else if (auto* f = b.get<float>()) sumBox += *f;
+            else sumBox += (double)b.get<string>()->size();
+        }
+    });
+
+    cout << "\n" << n << " mixed int/float/string values" << endl;
+    cout << "vector<unique_ptr<BoxBase>>: build " << buildVirt << " ms, " << allocVirt
+         << " allocations, read " << readVirt << " ms" << endl;
+    cout << "vector<std::any>           : build " << buildAny << " ms, " << allocAny
+         << " allocations, read " << readAny << " ms" << endl;
+    cout << "vector<AnyBox<32>>         : build " << buildBox << " ms, " << allocBox
+         << " allocations, read " << readBox << " ms" << endl;
+    cout << "inline: " << (boxes[2].isInline() ? "yes" : "no") << ", same sums: "
+         << (sumAny == sumBox && sumVirt == sumBox ? "yes" : "NO") << endl;
+
+    // ---- getValue(): copy vs reference ----
+    string longText(200, 'x');                  // heap-allocated string
+    OldBox<string> oldBox(longText);
+    Box<string> newBox(longText);
+    size_t len = 0;
+    a0 = g_allocations;
+    double copyMs = timeMs([&] { for (int i = 0; i < n; ++i) len += oldBox.getValue().size(); });
+    size_t copyAllocs = g_allocations - a0;
+    a0 = g_allocations;
+    double refMs = timeMs([&] { for (int i = 0; i < n; ++i) len += newBox.getValue().size(); });
+    size_t refAllocs = g_allocations - a0;
+    cout << "OldBox<string>::getValue() x" << n << ": " << copyMs << " ms, " << copyAllocs
+         << " allocations" << endl;
+    cout << "Box<string>::getValue()    x" << n << ": " << refMs << " ms, " << refAllocs
+         << " allocations" << endl;
+    return len == 2u * n * 200 ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. Return members by const& for reading; add a && overload
+//    so temporaries can hand their member over by move.
+// 2. Type erasure = "a pointer to per-type functions" — it
+//    does not require a virtual base class or the heap.
+// 3. Small-buffer optimisation: store small objects inside
+//    the wrapper, fall back to the heap only for big ones.
+// 4. Measure allocations, not just time: each one costs a
+//    malloc, a free and a cache miss later.
+//
+// ⭐ One-Line Interview Answer
+// “Give Box<T> ref-qualified accessors so reads don't copy,
+// and store heterogeneous boxes in a type-erased AnyBox with
+// an inline buffer so a vector of them needs no per-element
+// heap allocation.”
@@ -0,0 +1,394 @@
+// ==========================================================
+// TOPIC: extern template — Instantiate Once, Not in Every TU
+// ==========================================================
+//
+// classTemplate.cpp / inline.cpp / template.cpp:
+//
+//     Box<int> intBox(10);
+//     Vector2D<int> v(3, 4);
+//     GetMax(values);
+//
+// ❌ every translation unit that uses Box<int> generates, optimizes
+//    and emits Box<int> again; the linker keeps one copy and
+//    discards the rest — with the header in hundreds of TUs that
+//    is most of the compile time spent on these templates
+//
+// ✅ Instantiations.h: `extern template` for the common types
+//    (int, float, double, std::string), so a TU only emits calls;
+//    Instantiations.cpp: the one explicit instantiation of each
+//
+// Measured here (this program drives the compiler):
+//   1. generates `tus` translation units that all use Box,
+//      Vector2D, transform and the GetMin/GetMax/minmax ranges for
+//      the four types, plus a main that calls them
+//   2. builds them twice: implicit instantiation (the plain
+//      headers) and extern template (Instantiations.h + .cpp)
+//   3. reports compile time (total; one TU, the incremental
+//      rebuild), object code (.text bytes, bloaty-style table of
+//      the template symbols and their copies) and the linked
+//      program's .text; both programs must print the same result
+//   and, in this program itself, uses the extern specializations
+//   linked from Instantiations.cpp
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./explicitinst [tus] [source dir]
+//
+//   tus        → generated translation units        (default 8)
+//   source dir → where Instantiations.h lives        (default:
+//                BUILD_SOURCE_DIR when compiled with it — build.sh
+//                passes the absolute directory — then the
+//                directory this file was compiled in, then ".")
+//   CXX        → compiler to drive                   (default g++)
+//
+// Build:
+//   g++ -std=c++20 -O2 explicitInstantiation.cpp Instantiations.cpp -o explicitinst
+//
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "Instantiations.h"
+
+using namespace std;
+using namespace std::chrono;
+namespace fs = std::filesystem;
+
+// One generated TU: the same uses in both builds
+const char* kUnit = R"(#if defined(USE_INSTANTIATIONS)
+#include "Instantiations.h"
+#else
+#include "AnyBox.h"
+#include "MinMax.h"
+#include "VectorN.h"
+#endif
+#include <span>
+#include <string>
+#include <vector>
+
+long use_@(int seed) {
+    Box<int> bi(seed);
+    Box<float> bf(seed * 0.5f);
+    Box<double> bd(seed * 0.25);
+    Box<std::string> bs(std::to_string(seed));
+    std::vector<int> vi(64);
+    std::vector<float> vf(64);
+    std::vector<double> vd(64);
+    std::vector<std::string> vs;
+    for (int i = 0; i < 64; ++i) {
+        vi[i] = (i * 37 + seed) % 101 - 50;
+        vf[i] = float(vi[i]) * 0.5f;
+        vd[i] = double(vi[i]) * 0.25;
+        vs.push_back(std::to_string(vi[i]));
+    }
+    Vector2D<int> a(seed, 2), b(1, seed);
+    Vector2D<float> fa(1.5f, float(seed));
+    Vector2D<double> da(double(seed), 4.0);
+    std::vector<Vector2D<float>> pts(16, fa);
+    std::vector<Vector2D<int>> ipts(16, a + b);
+    std::vector<Vector2D<double>> dpts(16, da);
+    Matrix<float, 2> mf = Matrix<float, 2>::identity();
+    Matrix<int, 2> mi = Matrix<int, 2>::identity();
+    Matrix<double, 2> md = Matrix<double, 2>::identity();
+    mf.m[0][1] = 2.0f, mi.m[1][0] = 3, md.m[0][1] = 0.5;
+    transform(std::span<Vector2D<float>>(pts), mf);
+    transform(std::span<Vector2D<int>>(ipts), mi);
+    transform(std::span<Vector2D<double>>(dpts), md);
+    VectorSoA<float, 2> soa;
+    soa.resize(16);
+    for (std::size_t i = 0; i < 16; ++i) soa.set(i, pts[i]);
+    transform(soa, mf);
+    VectorSoA<double, 2> dsoa;
+    dsoa.resize(16);
+    for (std::size_t i = 0; i < 16; ++i) dsoa.set(i, dpts[i]);
+    transform(dsoa, md);
+
+    long r = bi.getValue() + long(bf.getValue()) + long(bd.getValue()) + long(bs.getValue().size());
+    r += GetMin(std::span<const int>(vi)) + GetMax(std::span<const int>(vi));
+    r += long(GetMin(std::span<const float>(vf)) + GetMax(std::span<const float>(vf)));
+    r += long(GetMin(std::span<const double>(vd)) + GetMax(std::span<const double>(vd)));
+    r += long(GetMin(std::span<const std::string>(vs)).size() + GetMax(std::span<const std::string>(vs)).size());
+    r += minmax_simd::minmax(std::span<const int>(vi)).max - *minmax_simd::min_element(std::span<const int>(vi));
+    r += long(*minmax_simd::max_element(std::span<const float>(vf)) + minmax_simd::minmax(
+        std::span<const double>(vd)).min);
+    r += long(minmax_simd::minmax(std::span<const std::string>(vs)).max.size());
+    r += dot(a, b) + long((fa * 2.0f).length()) + long(lerp(da, da * 3.0, 0.5).lengthSquared());
+    r += long(soa.get(15)[0]) + long(dsoa.get(3)[1]) + ipts[5][1] + long(pts[7][0]);
+    return r;
+}
+)";
+
+struct Tools {
+    string cxx;
+    fs::path src;                                           // where Instantiations.h lives
+    fs::path work;
+};
+
+string quoted(const fs::path& p) {
+    string s = "'";
+    for (char ch : p.string()) s += ch == '\'' ? string("'\\''") : string(1, ch);
+    return s + "'";
+}
+
+// Runs a shell command; stdout in `out`, false on failure
+bool run(const string& cmd, string* out = nullptr) {
+    FILE* p = popen((cmd + " 2>&1").c_str(), "r");
+    if (!p) return false;
+    string text;
+    char buf[4096];
+    while (size_t n = fread(buf, 1, sizeof buf, p)) text.append(buf, n);
+    const int status = pclose(p);
+    if (out) *out = text;
+    else if (status != 0) cerr << cmd << "\n" << text;
+    return status == 0;
+}
+
+// Sum of the .text* sections (size -A): every function's code,
+// COMDAT copies included
+long textBytes(const fs::path& file) {
+    string out;
+    if (!run("size -A " + quoted(file), &out)) return -1;
+    istringstream in(out);
+    string line, section;
+    long bytes, total = 0;
+    while (getline(in, line)) {
+        istringstream f(line);
+        if (f >> section >> bytes && section.rfind(".text", 0) == 0) total += bytes;
+    }
+    return total;
+}
+
+struct SymbolCopies {
+    int copies = 0;
+    long bytes = 0;
+};
+
+// Template code defined in the objects, by demangled name:
+// how many objects carry a copy and the bytes of all copies
+map<string, SymbolCopies> templateSymbols(const vector<fs::path>& objects) {
+    map<string, SymbolCopies> syms;
+    for (const fs::path& o : objects) {
+        string out;
+        if (!run("nm -C -S --defined-only " + quoted(o), &out)) continue;
+        istringstream in(out);
+        string line;
+        while (getline(in, line)) {
+            istringstream f(line);
+            string addr, size, type;
+            if (!(f >> addr >> size >> type) || (type != "W" && type != "T" && type != "t")) continue;
+            string name;
+            getline(f, name);
+            name.erase(0, name.find_first_not_of(' '));
+            if (name.find('<') == string::npos || name.rfind("use_", 0) == 0) continue;   // templates only
+            SymbolCopies& s = syms[name];
+            ++s.copies;
+            s.bytes += stol(size, nullptr, 16);
+        }
+    }
+    return syms;
+}
+
+struct Build {
+    string name;
+    vector<double> tuMs;                                    // per generated TU
+    double libraryMs = 0;                                   // Instantiations.cpp, once
+    long objectText = 0;
+    long programText = 0;
+    map<string, SymbolCopies> symbols;
+    string output;
+    bool ok = false;
+};
+
+double timedRun(const string& cmd, bool& ok) {
+    auto t0 = steady_clock::now();
+    ok = run(cmd) && ok;
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+Build build(const Tools& t, int tus, bool useExtern) {
+    Build b;
+    b.name = useExtern ? "extern template" : "implicit";
+    b.ok = true;
+    const fs::path dir = t.work / (useExtern ? "extern" : "implicit");
+    fs::create_directories(dir);
+    const string flags = " -std=c++20 -O2 -I" + quoted(t.src) + (useExtern ? " -DUSE_INSTANTIATIONS" : "");
+    vector<fs::path> objects;
+    ofstream mainSrc(dir / "main.cpp");
+    mainSrc << "#include <cstdio>\n";
+    for (int k = 0; k < tus; ++k) mainSrc << "long use_" << k << "(int);\n";
+    mainSrc << "int main() {\n    long r = 0;\n";
+    for (int k = 0; k < tus; ++k) mainSrc << "    r += use_" << k << "(" << k + 1 << ");\n";
+    mainSrc << "    std::printf(\"%ld\\n\", r);\n}\n";
+    mainSrc.close();
+
+    for (int k = 0; k < tus; ++k) {
+        string unit = kUnit;
+        unit.replace(unit.find('@'), 1, to_string(k));
+        const fs::path cpp = dir / ("use_" + to_string(k) + ".cpp"), obj = dir / ("use_" + to_string(k) + ".o");
+        ofstream(cpp) << unit;
+        b.tuMs.push_back(timedRun(t.cxx + flags + " -c " + quoted(cpp) + " -o " + quoted(obj), b.ok));
+        objects.push_back(obj);
+    }
+    string link = t.cxx + " -std=c++20 -O2 " + quoted(dir / "main.cpp");
+    for (const fs::path& o : objects) link += " " + quoted(o);
+    if (useExtern) {
+        const fs::path lib = dir / "Instantiations.o";
+        b.libraryMs = timedRun(t.cxx + flags + " -c " + quoted(t.src / "Instantiations.cpp") + " -o " + quoted(lib), b.ok);
+        objects.push_back(lib);
+        link += " " + quoted(lib);
+    }
+    const fs::path exe = dir / "program";
+    b.ok = run(link + " -o " + quoted(exe)) && b.ok;
+    for (const fs::path& o : objects) b.objectText += textBytes(o);
+    b.programText = textBytes(exe);
+    b.symbols = templateSymbols(objects);
+    b.ok = b.ok && run(quoted(exe), &b.output);
+    return b;
+}
+
+double sum(const vector<double>& v) {
+    double s = 0;
+    for (double x : v) s += x;
+    return s;
+}
+
+double median(vector<double> v) {
+    sort(v.begin(), v.end());
+    return v.empty() ? 0 : v[v.size() / 2];
+}
+
+// The extern specializations, used (and linked) right here
+bool selfCheck() {
+    Box<string> s("Hello");
+    Vector2D<float> v(3.0f, 4.0f);
+    const vector<int> xs{4, -2, 9, 7};
+    const vector<string> words{"pear", "apple", "fig"};
+    return s.getValue() == "Hello" && v.length() == 5.0f && GetMin(span<const int>(xs)) == -2 &&
+           GetMax(span<const int>(xs)) == 9 && GetMax(span<const string>(words)) == "pear" &&
+           *minmax_simd::min_element(span<const string>(words)) == "apple" && GetMin(2, 3.5) == 2.0;
+}
+
+int main(int argc, char** argv) {
+    const int tus = argc > 1 ? atoi(argv[1]) : 8;
+    if (tus < 1) {
+        cerr << "usage: explicitinst [tus>=1] [source dir]" << endl;
+        return 2;
+    }
+    vector<fs::path> candidates;
+    if (argc > 2) candidates.push_back(argv[2]);
+    else {
+#ifdef BUILD_SOURCE_DIR
+        candidates.push_back(BUILD_SOURCE_DIR);
+#endif
+        candidates.push_back(fs::path(__FILE__).parent_path());
+        candidates.push_back(".");
+    }
+    fs::path src;
+    for (const fs::path& c : candidates)
+        if (fs::exists(c / "Instantiations.h") && fs::exists(c / "Instantiations.cpp")) {
+            src = fs::absolute(c.empty() ? fs::path(".") : c);
+            break;
+        }
+    if (src.empty()) {
+        cerr << "Instantiations.h not found: pass the source directory, explicitinst " << tus << " <dir>" << endl;
+        return 2;
+    }
+
+    bool ok = selfCheck();
+    cout << "extern specializations linked from Instantiations.cpp: " << (ok ? "work" : "BROKEN") << endl;
+
+    Tools t;
+    t.cxx = getenv("CXX") ? getenv("CXX") : "g++";
+    t.src = src;
+    t.work = fs::temp_directory_path() / ("explicitinst." + to_string(getpid()));
+    fs::create_directories(t.work);
+    cout << tus << " generated TUs, each using Box/Vector2D/transform/GetMin/GetMax/minmax for int, float, double,"
+         << " std::string (" << t.cxx << " -O2)" << endl;
+
+    const Build before = build(t, tus, false);
+    const Build after = build(t, tus, true);
+    fs::remove_all(t.work);
+    ok = ok && before.ok && after.ok;
+    if (!before.ok || !after.ok) {
+        cout << "build failed" << endl << "all checks: FAILED" << endl;
+        return 1;
+    }
+
+    // ---- compile time ----
+    cout << endl << fixed << setprecision(0);
+    cout << "  " << left << setw(18) << "" << right << setw(14) << "all TUs ms" << setw(14) << "one TU ms"
+         << setw(16) << "library ms" << setw(16) << "object .text" << setw(16) << "program .text" << endl;
+    for (const Build* b : {&before, &after})
+        cout << "  " << left << setw(18) << b->name << right << setw(14) << sum(b->tuMs) << setw(14)
+             << median(b->tuMs) << setw(16) << (b->libraryMs > 0 ? to_string(lround(b->libraryMs)) : "-")
+             << setw(16) << b->objectText << setw(16) << b->programText << endl;
+    const double perBefore = median(before.tuMs), perAfter = median(after.tuMs);
+    cout << "incremental rebuild of one TU: " << setprecision(2) << perBefore / perAfter << "x faster; at 300 TUs "
+         << setprecision(0) << 300 * perBefore / 1000 << " s → " << (300 * perAfter + after.libraryMs) / 1000
+         << " s" << endl;
+    cout << "object code: " << before.objectText << " → " << after.objectText << " bytes ("
+         << setprecision(1) << 100.0 * double(after.objectText) / double(before.objectText) << "%)" << endl;
+
+    // ---- bloaty-style: template symbols, copies × bytes ----
+    vector<pair<string, SymbolCopies>> rows(before.symbols.begin(), before.symbols.end());
+    sort(rows.begin(), rows.end(), [](const auto& x, const auto& y) { return x.second.bytes > y.second.bytes; });
+    cout << endl << "template code in the objects, largest first (copies, bytes; implicit → extern):" << endl;
+    long beforeTotal = 0, afterTotal = 0;
+    int beforeCopies = 0, afterCopies = 0;
+    for (const auto& [name, s] : before.symbols) beforeTotal += s.bytes, beforeCopies += s.copies;
+    for (const auto& [name, s] : after.symbols) afterTotal += s.bytes, afterCopies += s.copies;
+    for (size_t i = 0; i < rows.size() && i < 10; ++i) {
+        const auto it = after.symbols.find(rows[i].first);
+        const SymbolCopies a = it == after.symbols.end() ? SymbolCopies{} : it->second;
+        string name = rows[i].first;
+        if (name.size() > 64) name = name.substr(0, 61) + "...";
+        cout << "  " << setw(4) << rows[i].second.copies << " × " << setw(8) << rows[i].second.bytes << "  →  "
+             << setw(3) << a.copies << " × " << setw(6) << a.bytes << "   " << name << endl;
+    }
+    cout << "  all: " << beforeCopies << " copies, " << beforeTotal << " bytes  →  " << afterCopies << " copies, "
+         << afterTotal << " bytes" << endl;
+
+    const bool sameOutput = before.output == after.output;
+    cout << endl << "both programs print " << before.output.substr(0, before.output.find('\n')) << ": "
+         << (sameOutput ? "same result" : "DIFFERENT results") << endl;
+    ok = ok && sameOutput && after.objectText < before.objectText && afterCopies < beforeCopies;
+    if (tus >= 4) ok = ok && sum(after.tuMs) + after.libraryMs < sum(before.tuMs);
+
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. Implicit instantiation happens in every TU that uses a
+//    template; the linker folds the duplicate (COMDAT) copies, so
+//    the cost is compile time and object size, not the final
+//    binary.
+// 2. `extern template class Box<int>;` promises the instantiation
+//    exists elsewhere; `template class Box<int>;` in ONE .cpp
+//    provides it. Keep both in one list so they cannot drift.
+// 3. It does not stop inlining: members defined in the class (and
+//    constexpr functions) are still inlined at -O2 — only the
+//    out-of-line copies move to the library TU.
+// 4. It only covers the listed types; anything else is still
+//    instantiated implicitly, so correctness never depends on it.
+//
+// ⭐ One-Line Interview Answer
+// “Declare the common specializations `extern template` in the
+// header and instantiate them explicitly in one .cpp: every other
+// TU stops re-generating the same code, so builds get faster and
+// objects smaller, while other types still instantiate
+// implicitly.”
@@ -0,0 +1,273 @@
+// ======================================================
+// TOPIC: Spatial Indexing — Neighbour Queries without Scanning Everyone
+// ======================================================
+//
+// classTempEx.cpp / union.cpp:
+//
+//     Vector2D<int> v(3, 4);          // objects have positions ...
+//     struct Move { int x, y; };
+//
+//     for (auto& o : objects)         // ... and "who is near p?" is this
+//         if (dist(o, p) <= r) ...
+//
+// ❌ every query reads every object: O(n), 10^6 objects each time
+// ❌ everyone's neighbours, once per frame: n queries × n objects
+//
+// ✅ SpatialIndex.h:
+//    UniformGrid — moving objects hashed into cells about the size
+//    of the query radius; a query reads ~9 cells; a move updates
+//    in place or relinks O(1)
+//    StaticBvh — static boxes (obstacles) in a bounding-volume
+//    hierarchy built once
+//
+// Measured here (`objects` points, uniform in a square sized so a
+// radius-`radius` circle holds ~`k` of them):
+//   1. ns per radius query: linear scan vs grid vs radiusBatch
+//   2. ns per box query: linear scan vs grid
+//   3. ns per move() for a frame of small steps, and how many
+//      objects changed cell
+//   4. StaticBvh over obstacle boxes: ns per box query vs a scan
+//   5. every index answer equals the scan's, before and after the
+//      moves; int coordinates (Move {x, y}) too
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./spatial [objects] [k]
+//
+//   objects → default 1000000
+//   k       → neighbours per query, on average (default 16)
+//
+// Build:
+//   g++ -std=c++20 -O2 spatialQueries.cpp -o spatial
+//
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "SpatialIndex.h"
+
+using namespace std;
+using namespace std::chrono;
+
+using Vec = Vector2D<float>;
+
+template <typename F>
+double nsPer(size_t n, F&& f) {
+    const auto t0 = steady_clock::now();
+    f();
+    return duration<double, nano>(steady_clock::now() - t0).count() / double(n);
+}
+
+vector<uint32_t> scanRadius(const vector<Vec>& pts, Vec c, float r) {
+    vector<uint32_t> out;
+    for (uint32_t i = 0; i < pts.size(); ++i) {
+        const float dx = pts[i][0] - c[0], dy = pts[i][1] - c[1];
+        if (dx * dx + dy * dy <= r * r) out.push_back(i);
+    }
+    return out;
+}
+
+vector<uint32_t> scanBox(const vector<Vec>& pts, Vec lo, Vec hi) {
+    vector<uint32_t> out;
+    for (uint32_t i = 0; i < pts.size(); ++i)
+        if (pts[i][0] >= lo[0] && pts[i][0] <= hi[0] && pts[i][1] >= lo[1] && pts[i][1] <= hi[1]) out.push_back(i);
+    return out;
+}
+
+bool sameSet(vector<uint32_t> a, vector<uint32_t> b) {
+    sort(a.begin(), a.end());
+    sort(b.begin(), b.end());
+    return a == b;
+}
+
+int main(int argc, char** argv) {
+    const long objects = argc > 1 ? atol(argv[1]) : 1000000;
+    const double k = argc > 2 ? atof(argv[2]) : 16;
+    if (objects < 1 || objects > 100000000 || k <= 0) {
+        cerr << "usage: spatial [objects 1..1e8] [k > 0]" << endl;
+        return 2;
+    }
+    const size_t n = size_t(objects);
+    const float radius = 10.0f;
+    // density so that pi r^2 holds k objects
+    const float side = float(sqrt(double(n) * M_PI * radius * radius / k));
+    mt19937 rng(7);
+    uniform_real_distribution<float> coord(0.0f, side);
+    vector<Vec> pts(n);
+    for (Vec& p : pts) p = Vec(coord(rng), coord(rng));
+
+    UniformGrid<float> grid(radius);
+    grid.reserve(n);
+    const double insertNs = nsPer(n, [&] {
+        for (uint32_t i = 0; i < n; ++i) grid.insert(i, pts[i]);
+    });
+    cout << n << " objects in a " << int(side) << " × " << int(side) << " square, radius " << radius << " (~" << k
+         << " neighbours), " << grid.cells() << " cells; insert " << fixed << setprecision(1) << insertNs
+         << " ns/object" << endl
+         << endl;
+
+    bool ok = true;
+    vector<Vec> centers(20000);
+    for (Vec& c : centers) c = Vec(coord(rng), coord(rng));
+    const size_t scanQ = max<size_t>(1, min<size_t>(50, 50000000 / n));
+
+    // ---- 1. radius ----
+    size_t found = 0;
+    vector<vector<uint32_t>> truth(scanQ);
+    const double scanNs = nsPer(scanQ, [&] {
+        for (size_t q = 0; q < scanQ; ++q) truth[q] = scanRadius(pts, centers[q], radius);
+    });
+    vector<uint32_t> out;
+    const double gridNs = nsPer(centers.size(), [&] {
+        for (const Vec& c : centers) {
+            out.clear();
+            grid.radius(c, radius, out);
+            found += out.size();
+        }
+    });
+    vector<uint32_t> batch, offsets;
+    const double batchNs = nsPer(centers.size(), [&] { grid.radiusBatch(centers, radius, batch, offsets); });
+    for (size_t q = 0; q < scanQ; ++q) {
+        out.clear();
+        grid.radius(centers[q], radius, out);
+        ok = ok && sameSet(out, truth[q]) &&
+             sameSet({batch.begin() + offsets[q], batch.begin() + offsets[q + 1]}, truth[q]);
+    }
+    ok = ok && offsets.back() == found;
+    printf("  %-34s %12s %12s %12s\n", "query", "scan", "grid", "grid batch");
+    printf("  %-34s %10.0f ns %10.0f ns %10.0f ns   (%.1f found, %.0fx)\n", "radius", scanNs, gridNs, batchNs,
+           double(found) / double(centers.size()), scanNs / gridNs);
+
+    // ---- 2. box ----
+    const float half = radius;
+    double boxScanNs = nsPer(scanQ, [&] {
+        for (size_t q = 0; q < scanQ; ++q) {
+            const Vec lo(centers[q][0] - half, centers[q][1] - half), hi(centers[q][0] + half, centers[q][1] + half);
+            truth[q] = scanBox(pts, lo, hi);
+        }
+    });
+    const double boxGridNs = nsPer(centers.size(), [&] {
+        for (const Vec& c : centers) {
+            out.clear();
+            grid.box(Vec(c[0] - half, c[1] - half), Vec(c[0] + half, c[1] + half), out);
+        }
+    });
+    for (size_t q = 0; q < scanQ; ++q) {
+        out.clear();
+        grid.box(Vec(centers[q][0] - half, centers[q][1] - half), Vec(centers[q][0] + half, centers[q][1] + half),
+                 out);
+        ok = ok && sameSet(out, truth[q]);
+    }
+    printf("  %-34s %10.0f ns %10.0f ns %12s   (%.0fx)\n", "box 2r × 2r", boxScanNs, boxGridNs, "-",
+           boxScanNs / boxGridNs);
+
+    // ---- 3. a frame of moves ----
+    uniform_real_distribution<float> step(-1.0f, 1.0f);
+    size_t relinked = 0;
+    for (Vec& p : pts) p = Vec(clamp(p[0] + step(rng), 0.0f, side), clamp(p[1] + step(rng), 0.0f, side));
+    const double moveNs = nsPer(n, [&] {
+        for (uint32_t i = 0; i < n; ++i) relinked += grid.move(i, pts[i]);
+    });
+    for (size_t q = 0; q < scanQ; ++q) {
+        out.clear();
+        grid.radius(centers[q], radius, out);
+        ok = ok && sameSet(out, scanRadius(pts, centers[q], radius));
+    }
+    ok = ok && grid.size() == n && grid.position(0)[0] == pts[0][0];
+    printf("\n  move (steps up to 1): %.1f ns/object, %.1f%% changed cell\n", moveNs,
+           100.0 * double(relinked) / double(n));
+
+    // ---- 4. static obstacles ----
+    const size_t obstacles = max<size_t>(1, n / 10);
+    vector<StaticBvh<float>::Box> boxes(obstacles);
+    uniform_real_distribution<float> extent(0.5f, 4.0f);
+    for (auto& b : boxes) {
+        const Vec lo(coord(rng), coord(rng));
+        b = {lo, Vec(lo[0] + extent(rng), lo[1] + extent(rng))};
+    }
+    StaticBvh<float> bvh;
+    const double buildMs = nsPer(1, [&] { bvh.build(boxes); }) / 1e6;
+    auto scanBoxes = [&](Vec lo, Vec hi) {
+        vector<uint32_t> r;
+        for (uint32_t i = 0; i < boxes.size(); ++i)
+            if (boxes[i].lo[0] <= hi[0] && boxes[i].hi[0] >= lo[0] && boxes[i].lo[1] <= hi[1] &&
+                boxes[i].hi[1] >= lo[1])
+                r.push_back(i);
+        return r;
+    };
+    const double bvhScanNs = nsPer(scanQ, [&] {
+        for (size_t q = 0; q < scanQ; ++q)
+            truth[q] = scanBoxes(Vec(centers[q][0] - half, centers[q][1] - half),
+                                 Vec(centers[q][0] + half, centers[q][1] + half));
+    });
+    size_t hits = 0;
+    const double bvhNs = nsPer(centers.size(), [&] {
+        for (const Vec& c : centers) {
+            out.clear();
+            bvh.box(Vec(c[0] - half, c[1] - half), Vec(c[0] + half, c[1] + half), out);
+            hits += out.size();
+        }
+    });
+    for (size_t q = 0; q < scanQ; ++q) {
+        out.clear();
+        bvh.box(Vec(centers[q][0] - half, centers[q][1] - half), Vec(centers[q][0] + half, centers[q][1] + half),
+                out);
+        ok = ok && sameSet(out, truth[q]);
+        out.clear();
+        bvh.radius(centers[q], radius, out);
+        for (uint32_t id : out) {                      // within r of the box's nearest point
+            const Vec p(clamp(centers[q][0], boxes[id].lo[0], boxes[id].hi[0]),
+                        clamp(centers[q][1], boxes[id].lo[1], boxes[id].hi[1]));
+            const float dx = p[0] - centers[q][0], dy = p[1] - centers[q][1];
+            ok = ok && dx * dx + dy * dy <= radius * radius;
+        }
+    }
+    printf("\n  StaticBvh: %zu obstacle boxes, %zu nodes, built in %.1f ms\n", obstacles, bvh.nodes(), buildMs);
+    printf("  %-34s %10.0f ns %10.0f ns   (%.1f found, %.0fx)\n", "box 2r × 2r over obstacles", bvhScanNs, bvhNs,
+           double(hits) / double(centers.size()), bvhScanNs / bvhNs);
+
+    // ---- 5. int coordinates: union.cpp's Move {x, y} ----
+    UniformGrid<int> moves(8);
+    const vector<Vector2D<int>> ip = {{3, 4}, {10, 4}, {-5, -5}, {3, 11}, {100, 100}};
+    for (uint32_t i = 0; i < ip.size(); ++i) moves.insert(i, ip[i]);
+    vector<uint32_t> near;
+    moves.radius({3, 4}, 7, near);
+    ok = ok && sameSet(near, {0, 1, 3});
+    moves.move(4, {4, 4});
+    moves.remove(1);
+    near.clear();
+    moves.radius({3, 4}, 7, near);
+    ok = ok && sameSet(near, {0, 3, 4}) && moves.size() == 4;
+
+    cout.unsetf(ios::fixed);
+    cout << endl << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. A uniform grid with cells about the query radius turns a
+//    neighbour query into "read 9 cells": O(k), not O(n).
+// 2. Hash the cells (only occupied ones exist) and keep ids and
+//    positions together in the cell: the query reads contiguous
+//    memory and never touches the object itself.
+// 3. Moving objects mostly stay in their cell: update in place,
+//    relink only on a crossing — O(1) per move, no rebuild.
+// 4. Static objects with extents suit a tree built once (BVH,
+//    loose quadtree); grids suit many similar-sized moving ones.
+//
+// ⭐ One-Line Interview Answer
+// “Hash moving objects into a uniform grid with cells about the
+// query radius and relink them only when they cross a cell, put
+// static ones in a BVH, and neighbour queries read a few cells
+// instead of every object — O(k) instead of O(n).”
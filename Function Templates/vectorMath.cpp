@@ -0,0 +1,123 @@
+// ==========================================================
+// TOPIC: Vector<T, N> — from Vector2D to Bulk SIMD Math
+// ==========================================================
+//
+// classTempEx.cpp shows Vector2D<T> with T coordinate[2].
+// VectorN.h generalises it to Vector<T, N> (constexpr math,
+// SIMD specializations) plus a batch Matrix transform over
+// SoA storage.
+//
+// This file:
+// 1. Checks at COMPILE TIME that the math is constexpr
+// 2. Transforms 10^7 Vector<float, 4> by a 4x4 matrix:
+//      a. scalar loop, auto-vectorization disabled  (baseline)
+//      b. transform(span<Vector>)                   (AoS)
+//      c. transform(VectorSoA)                      (SoA, SIMD width picked at run time)
+//    and checks that all three agree
+//
+// Build:
+//   g++ -std=c++20 -O2 -mavx2 vectorMath.cpp -o vectormath
+//
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "VectorN.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ---- 1. constexpr ----
+constexpr Vector<double, 3> a3(1.0, 2.0, 2.0);
+static_assert(a3.length() == 3.0);
+static_assert(dot(a3, a3) == 9.0);
+static_assert(lerp(Vector<int, 2>(0, 0), Vector<int, 2>(10, 20), 1) == Vector<int, 2>(10, 20));
+static_assert((Vector2D<int>(3, 4) + Vector2D<int>(1, 1))[1] == 5);
+static_assert(alignof(Vector<float, 4>) == 16 && alignof(Vector<float, 8>) == 32);
+
+// ---- 2a. Baseline: plain scalar loop, one vector at a time ----
+#if defined(__GNUC__) && !defined(__clang__)
+__attribute__((optimize("no-tree-vectorize")))
+#endif
+void transformScalar(vector<Vector<float, 4>>& vs, const Matrix<float, 4>& M) {
+    for (auto& v : vs) {
+        float r[4];
+        for (int i = 0; i < 4; ++i)
+            r[i] = M.m[i][0] * v[0] + M.m[i][1] * v[1] + M.m[i][2] * v[2] + M.m[i][3] * v[3];
+        for (int i = 0; i < 4; ++i) v[i] = r[i];
+    }
+}
+
+template <typename F>
+double timeMs(F f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+int main() {
+    Vector2D<int> v(3, 4);
+    v.Display();                                   // same output as classTempEx.cpp
+    Vector<float, 4> p(1.0f, 2.0f, 3.0f, 4.0f), q(4.0f, 3.0f, 2.0f, 1.0f);
+    cout << "dot(p, q) = " << dot(p, q) << ", |p| = " << p.length() << ", lerp(p, q, 0.5) = ";
+    lerp(p, q, 0.5f).Display();
+
+    const size_t n = 10000000;
+    mt19937 rng(11);
+    uniform_real_distribution<float> d(-1.0f, 1.0f);
+
+    vector<Vector<float, 4>> scalarData(n);
+    for (auto& x : scalarData) x = Vector<float, 4>(d(rng), d(rng), d(rng), 1.0f);
+    vector<Vector<float, 4>> aosData = scalarData;
+    VectorSoA<float, 4> soaData;
+    soaData.resize(n);
+    for (size_t i = 0; i < n; ++i) soaData.set(i, scalarData[i]);
+
+    // rotation about z by 30 degrees + translation
+    Matrix<float, 4> M = Matrix<float, 4>::identity();
+    float c = cos(0.5236f), s = sin(0.5236f);
+    M.m[0][0] = c; M.m[0][1] = -s; M.m[1][0] = s; M.m[1][1] = c;
+    M.m[0][3] = 0.5f; M.m[1][3] = -0.25f;
+
+    const int reps = 5;
+    double scalarMs = timeMs([&] { for (int r = 0; r < reps; ++r) transformScalar(scalarData, M); });
+    double aosMs = timeMs([&] {
+        for (int r = 0; r < reps; ++r) transform(span<Vector<float, 4>>(aosData), M);
+    });
+    double soaMs = timeMs([&] { for (int r = 0; r < reps; ++r) transform(soaData, M); });
+
+    double maxErr = 0;
+    for (size_t i = 0; i < n; i += 997)
+        for (int k = 0; k < 4; ++k) {
+            maxErr = max(maxErr, (double)fabs(scalarData[i][k] - aosData[i][k]));
+            maxErr = max(maxErr, (double)fabs(scalarData[i][k] - soaData.c[k][i]));
+        }
+
+    cout << n << " x Vector<float,4>, " << reps << " transforms each" << endl;
+    cout << "scalar loop (no auto-vectorize): " << scalarMs / reps << " ms" << endl;
+    cout << "transform(span<Vector>)        : " << aosMs / reps << " ms" << endl;
+    cout << "transform(VectorSoA)           : " << soaMs / reps << " ms  (" << scalarMs / soaMs
+         << "x vs scalar)" << endl;
+    cout << "max |difference|: " << maxErr << endl;
+    return maxErr < 1e-3 ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A non-type template parameter (size_t N) turns one
+//    Vector2D into a whole family: Vector<float, 3>, <double, 4>...
+// 2. Explicit (full) specialization lets ONE combination
+//    (float, 4) use intrinsics while the rest use loops.
+// 3. std::is_constant_evaluated() keeps the SAME function
+//    usable at compile time and fast at run time.
+// 4. Bulk math vectorizes best ACROSS vectors (SoA), not
+//    inside one small vector.
+//
+// ⭐ One-Line Interview Answer
+// “Vector<T, N> is a class template with a type and a size
+// parameter; full specializations give float/double SIMD
+// paths, and SoA batches let one instruction process eight
+// vectors at once.”
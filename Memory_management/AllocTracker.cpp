@@ -0,0 +1,476 @@
+// AllocTracker.cpp — replacement global operator new/delete
+// (see AllocTracker.h). Link this file into the program:
+//
+//     g++ -std=c++20 -O2 -fno-omit-frame-pointer app.cpp AllocTracker.cpp -o app
+//
+#include "AllocTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <dlfcn.h>
+#include <pthread.h>
+
+namespace {
+
+constexpr std::uint16_t kLive = 0xA11C;
+constexpr std::uint16_t kFreed = 0xF4EE;
+constexpr std::uint8_t kScalar = 1;
+constexpr std::uint8_t kArray = 2;
+
+// Right before every pointer handed out
+struct Header {
+    std::uint64_t size;
+    std::uint32_t site;                 // 0: not sampled, else site index + 1
+    std::uint8_t kind;                  // kScalar / kArray
+    std::uint8_t offsetLog2;            // user pointer - malloc'd base = 1 << offsetLog2
+    std::uint16_t tag;                  // kLive / kFreed
+};
+static_assert(sizeof(Header) == 16, "AllocTracker: header must keep 16-byte alignment");
+
+// ---------------- configuration ----------------
+
+constexpr unsigned kMaxQuarantine = 1024;
+
+unsigned envUnsigned(const char* name, unsigned fallback) {
+    const char* v = std::getenv(name);
+    if (!v || !*v) return fallback;
+    return static_cast<unsigned>(std::strtoul(v, nullptr, 10));
+}
+
+struct Config {
+    std::atomic<unsigned> sampleEvery{envUnsigned("ALLOC_TRACK_SAMPLE", 64)};
+    unsigned quarantine = std::min(envUnsigned("ALLOC_TRACK_QUARANTINE", 256), kMaxQuarantine);
+    bool reportAtExit = envUnsigned("ALLOC_TRACK_REPORT", 1) != 0;
+};
+
+Config& config() {
+    static Config c;
+    return c;
+}
+
+// ---------------- counters ----------------
+//
+// Each thread owns its counters and is their only writer, so
+// an update is a plain load + store (no locked instruction);
+// stats() sums the registered threads under registryLock.
+// Frees on another thread make a thread's live count negative;
+// the sum is still exact.
+
+struct Counters {
+    std::atomic<std::int64_t> liveBytes{0};
+    std::atomic<std::int64_t> liveBlocks{0};
+    std::atomic<std::int64_t> allocations{0};
+    std::atomic<std::int64_t> sampled{0};
+};
+
+// Exited threads, and threads that found the registry full
+Counters shared;
+std::atomic<std::uint64_t> doubleFrees{0};
+std::atomic<std::uint64_t> mismatchedFrees{0};
+std::atomic<std::uint64_t> invalidFrees{0};
+
+// ---------------- sites ----------------
+
+constexpr int kDepth = 8;
+constexpr std::size_t kMaxSites = 4096;                 // power of two
+
+struct Site {
+    std::atomic<std::uint64_t> hash{0};                 // 0: free slot; published last
+    void* frames[kDepth];
+    int depth;
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> frees{0};
+    std::atomic<std::int64_t> liveBytes{0};
+};
+
+Site sites[kMaxSites];
+std::mutex siteInsert;
+
+std::uint64_t hashFrames(void* const* frames, int depth) {
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    for (int i = 0; i < depth; ++i) h = (h ^ reinterpret_cast<std::uintptr_t>(frames[i])) * 0x100000001b3ull;
+    return h | 1;                                       // never 0
+}
+
+bool sameFrames(const Site& s, void* const* frames, int depth) {
+    return s.depth == depth && std::memcmp(s.frames, frames, sizeof(void*) * depth) == 0;
+}
+
+// Site index + 1, or 0 when the table is full
+std::uint32_t findOrAddSite(void* const* frames, int depth) {
+    std::uint64_t h = hashFrames(frames, depth);
+    for (int pass = 0; pass < 2; ++pass) {
+        std::unique_lock<std::mutex> lk(siteInsert, std::defer_lock);
+        if (pass == 1) lk.lock();                       // insert only under the lock
+        for (std::size_t probe = 0; probe < kMaxSites; ++probe) {
+            std::size_t i = (h + probe) & (kMaxSites - 1);
+            std::uint64_t cur = sites[i].hash.load(std::memory_order_acquire);
+            if (cur == h && sameFrames(sites[i], frames, depth)) return static_cast<std::uint32_t>(i + 1);
+            if (cur == 0) {
+                if (pass == 0) break;
+                std::memcpy(sites[i].frames, frames, sizeof(void*) * depth);
+                sites[i].depth = depth;
+                sites[i].hash.store(h, std::memory_order_release);
+                return static_cast<std::uint32_t>(i + 1);
+            }
+        }
+    }
+    return 0;
+}
+
+// ---------------- per-thread state ----------------
+
+struct ThreadState {
+    enum Mode : std::uint8_t { kUnregistered, kOwn, kShared };
+    Mode mode = kUnregistered;
+    Counters own;
+    unsigned countdown = 0;
+    std::uintptr_t stackLo = 0, stackHi = 0;
+    bool stackKnown = false;
+    void* quarantine[kMaxQuarantine];
+    unsigned qHead = 0, qUsed = 0;
+};
+
+thread_local ThreadState tls;
+
+constexpr std::size_t kMaxThreads = 1024;
+ThreadState* registry[kMaxThreads];
+std::mutex registryLock;
+pthread_key_t exitKey;
+const bool exitKeyCreated = pthread_key_create(&exitKey, [](void*) {
+    // Thread exit: quarantined blocks back to malloc, counts
+    // folded into `shared`, slot released
+    for (unsigned i = 0; i < tls.qUsed; ++i) std::free(tls.quarantine[(tls.qHead + i) % kMaxQuarantine]);
+    tls.qUsed = 0;
+    std::lock_guard<std::mutex> lg(registryLock);
+    for (ThreadState*& slot : registry)
+        if (slot == &tls) slot = nullptr;
+    shared.liveBytes.fetch_add(tls.own.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    shared.liveBlocks.fetch_add(tls.own.liveBlocks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    shared.allocations.fetch_add(tls.own.allocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    shared.sampled.fetch_add(tls.own.sampled.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    tls.mode = ThreadState::kShared;                    // later (TLS destructor) allocations
+}) == 0;
+
+void registerThread() {
+    if (!exitKeyCreated) return;                        // static init not reached yet: retry next time
+    tls.mode = ThreadState::kShared;
+    std::lock_guard<std::mutex> lg(registryLock);
+    for (ThreadState*& slot : registry) {
+        if (!slot) {
+            slot = &tls;
+            tls.mode = ThreadState::kOwn;
+            pthread_setspecific(exitKey, &tls);
+            return;
+        }
+    }
+}
+
+inline void bump(std::atomic<std::int64_t> Counters::*field, std::int64_t delta) {
+    if (tls.mode == ThreadState::kUnregistered) registerThread();
+    if (tls.mode == ThreadState::kOwn) {
+        std::atomic<std::int64_t>& c = tls.own.*field;
+        c.store(c.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    } else {
+        (shared.*field).fetch_add(delta, std::memory_order_relaxed);
+    }
+}
+
+void quarantineOrFree(void* base) {
+    unsigned cap = config().quarantine;
+    if (cap == 0 || tls.mode != ThreadState::kOwn) {   // nothing would flush it at thread exit
+        std::free(base);
+        return;
+    }
+    if (tls.qUsed == cap) {                             // evict the oldest
+        std::free(tls.quarantine[tls.qHead]);
+        tls.qHead = (tls.qHead + 1) % kMaxQuarantine;
+        --tls.qUsed;
+    }
+    tls.quarantine[(tls.qHead + tls.qUsed) % kMaxQuarantine] = base;
+    ++tls.qUsed;
+}
+
+// ---------------- stack capture ----------------
+
+void learnStack() {
+    tls.stackKnown = true;
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0) return;
+    void* addr = nullptr;
+    std::size_t size = 0;
+    if (pthread_attr_getstack(&attr, &addr, &size) == 0) {
+        tls.stackLo = reinterpret_cast<std::uintptr_t>(addr);
+        tls.stackHi = tls.stackLo + size;
+    }
+    pthread_attr_destroy(&attr);
+}
+
+// frame: operator new's frame ([0] saved caller fp, [1] return
+// address). Only addresses inside this thread's stack are read.
+int captureStack(void* frame, void* caller, void** out) {
+    if (!tls.stackKnown) learnStack();
+    out[0] = caller;
+    int n = 1;
+    auto fp = reinterpret_cast<std::uintptr_t>(frame);
+    auto inStack = [](std::uintptr_t p) {
+        return p >= tls.stackLo && p + 2 * sizeof(void*) <= tls.stackHi && p % sizeof(void*) == 0;
+    };
+    if (!inStack(fp)) return n;
+    fp = *reinterpret_cast<std::uintptr_t*>(fp);
+    while (n < kDepth && inStack(fp)) {
+        void* ret = reinterpret_cast<void**>(fp)[1];
+        if (!ret) break;
+        out[n++] = ret;
+        std::uintptr_t next = *reinterpret_cast<std::uintptr_t*>(fp);
+        if (next <= fp) break;                          // frames must move toward the stack base
+        fp = next;
+    }
+    return n;
+}
+
+// ---------------- reporting helpers ----------------
+
+void printFrame(std::FILE* out, int i, void* addr) {
+    Dl_info info;
+    if (dladdr(addr, &info) && info.dli_fname) {
+        const char* module = std::strrchr(info.dli_fname, '/');
+        module = module ? module + 1 : info.dli_fname;
+        std::fprintf(out, "      #%d %p %s+0x%lx %s\n", i, addr, module,
+                     static_cast<unsigned long>(reinterpret_cast<std::uintptr_t>(addr) -
+                                                reinterpret_cast<std::uintptr_t>(info.dli_fbase)),
+                     info.dli_sname ? info.dli_sname : "");
+    } else {
+        std::fprintf(out, "      #%d %p\n", i, addr);
+    }
+}
+
+void reportBadFree(const char* what, void* p, void* caller, const Header* h) {
+    std::fprintf(stderr, "AllocTracker: %s of %p\n", what, p);
+    std::fprintf(stderr, "    freed at:\n");
+    printFrame(stderr, 0, caller);
+    if (h && h->site != 0 && h->site <= kMaxSites) {
+        const Site& s = sites[h->site - 1];
+        std::fprintf(stderr, "    allocated (%llu bytes) at:\n", static_cast<unsigned long long>(h->size));
+        for (int i = 0; i < s.depth; ++i) printFrame(stderr, i, s.frames[i]);
+    }
+}
+
+// ---------------- allocate / free ----------------
+
+void* allocate(std::size_t size, std::size_t align, std::uint8_t kind, bool nothrow, void* frame, void* caller) {
+    std::size_t offset = align <= sizeof(Header) ? sizeof(Header) : align;
+    const bool tooLarge = size > SIZE_MAX - 2 * offset;  // size + header (+ rounding) would wrap
+    void* base;
+    for (;;) {
+        base = tooLarge                  ? nullptr
+               : offset == sizeof(Header) ? std::malloc(size + offset)
+                                          : std::aligned_alloc(offset, (size + 2 * offset - 1) / offset * offset);
+        if (base) break;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            if (nothrow) return nullptr;
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+
+    auto* user = static_cast<unsigned char*>(base) + offset;
+    Header* h = reinterpret_cast<Header*>(user) - 1;
+    h->size = size;
+    h->kind = kind;
+    h->offsetLog2 = static_cast<std::uint8_t>(__builtin_ctzll(offset));
+    h->site = 0;
+
+    bump(&Counters::allocations, 1);
+    bump(&Counters::liveBytes, static_cast<std::int64_t>(size));
+    bump(&Counters::liveBlocks, 1);
+
+    unsigned every = config().sampleEvery.load(std::memory_order_relaxed);
+    if (every != 0 && tls.countdown-- == 0) {
+        tls.countdown = every - 1;
+        void* frames[kDepth];
+        int depth = captureStack(frame, caller, frames);
+        std::uint32_t site = findOrAddSite(frames, depth);
+        if (site != 0) {
+            h->site = site;
+            sites[site - 1].allocations.fetch_add(1, std::memory_order_relaxed);
+            sites[site - 1].liveBytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+            bump(&Counters::sampled, 1);
+        }
+    }
+    h->tag = kLive;
+    return user;
+}
+
+void release(void* p, std::uint8_t kind, void* caller) {
+    if (!p) return;
+    Header* h = static_cast<Header*>(p) - 1;
+    // Plain load/store, not a CAS: two threads freeing the same
+    // block at the same instant may both pass (a race the program
+    // already has); any later delete sees kFreed
+    if (h->tag != kLive) {
+        if (h->tag == kFreed) {
+            doubleFrees.fetch_add(1, std::memory_order_relaxed);
+            reportBadFree("double free", p, caller, h);
+        } else {
+            invalidFrees.fetch_add(1, std::memory_order_relaxed);
+            reportBadFree("free of a pointer not from operator new (or freed long ago)", p, caller, nullptr);
+        }
+        return;                                          // never pass it on to free()
+    }
+    h->tag = kFreed;
+    if (h->kind != kind) {
+        mismatchedFrees.fetch_add(1, std::memory_order_relaxed);
+        reportBadFree(kind == kArray ? "delete[] of a block from new" : "delete of a block from new[]", p, caller, h);
+    }
+
+    bump(&Counters::liveBytes, -static_cast<std::int64_t>(h->size));
+    bump(&Counters::liveBlocks, -1);
+    if (h->site != 0) {
+        sites[h->site - 1].frees.fetch_add(1, std::memory_order_relaxed);
+        sites[h->site - 1].liveBytes.fetch_sub(static_cast<std::int64_t>(h->size), std::memory_order_relaxed);
+    }
+    quarantineOrFree(static_cast<unsigned char*>(p) - (std::size_t(1) << h->offsetLog2));
+}
+
+__attribute__((destructor)) void reportAtExit() {
+    if (config().reportAtExit) AllocTracker::report(stderr);
+}
+
+}  // namespace
+
+// ---------------- public API ----------------
+
+AllocTracker::Stats AllocTracker::stats() {
+    std::int64_t bytes = shared.liveBytes.load(std::memory_order_relaxed);
+    std::int64_t blocks = shared.liveBlocks.load(std::memory_order_relaxed);
+    std::int64_t allocations = shared.allocations.load(std::memory_order_relaxed);
+    std::int64_t sampled = shared.sampled.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lg(registryLock);
+        for (const ThreadState* t : registry) {
+            if (!t) continue;
+            bytes += t->own.liveBytes.load(std::memory_order_relaxed);
+            blocks += t->own.liveBlocks.load(std::memory_order_relaxed);
+            allocations += t->own.allocations.load(std::memory_order_relaxed);
+            sampled += t->own.sampled.load(std::memory_order_relaxed);
+        }
+    }
+    Stats s;
+    s.liveBytes = static_cast<std::uint64_t>(std::max<std::int64_t>(bytes, 0));
+    s.liveBlocks = static_cast<std::uint64_t>(std::max<std::int64_t>(blocks, 0));
+    s.allocations = static_cast<std::uint64_t>(allocations);
+    s.sampled = static_cast<std::uint64_t>(sampled);
+    s.doubleFrees = doubleFrees.load(std::memory_order_relaxed);
+    s.mismatchedFrees = mismatchedFrees.load(std::memory_order_relaxed);
+    s.invalidFrees = invalidFrees.load(std::memory_order_relaxed);
+    return s;
+}
+
+void AllocTracker::report(std::FILE* out, std::size_t maxSites) {
+    Stats s = stats();
+    unsigned every = sampleEvery();
+    std::fprintf(out,
+                 "AllocTracker: %llu bytes live in %llu blocks (%llu allocations, %llu sampled 1/%u); "
+                 "%llu double free, %llu mismatched, %llu invalid\n",
+                 static_cast<unsigned long long>(s.liveBytes), static_cast<unsigned long long>(s.liveBlocks),
+                 static_cast<unsigned long long>(s.allocations), static_cast<unsigned long long>(s.sampled), every,
+                 static_cast<unsigned long long>(s.doubleFrees), static_cast<unsigned long long>(s.mismatchedFrees),
+                 static_cast<unsigned long long>(s.invalidFrees));
+
+    std::uint16_t order[kMaxSites];
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < kMaxSites; ++i)
+        if (sites[i].hash.load(std::memory_order_acquire) != 0 && sites[i].liveBytes.load(std::memory_order_relaxed) > 0)
+            order[n++] = static_cast<std::uint16_t>(i);
+    std::sort(order, order + n, [](std::uint16_t a, std::uint16_t b) {
+        return sites[a].liveBytes.load(std::memory_order_relaxed) > sites[b].liveBytes.load(std::memory_order_relaxed);
+    });
+    for (std::size_t k = 0; k < n && k < maxSites; ++k) {
+        const Site& site = sites[order[k]];
+        std::uint64_t allocs = site.allocations.load(std::memory_order_relaxed);
+        std::uint64_t frees = site.frees.load(std::memory_order_relaxed);
+        long long live = site.liveBytes.load(std::memory_order_relaxed);
+        std::fprintf(out, "  site %zu: %lld sampled bytes live (~%lld estimated), %llu of %llu sampled blocks unfreed\n",
+                     k + 1, live, live * static_cast<long long>(every ? every : 1),
+                     static_cast<unsigned long long>(allocs - frees), static_cast<unsigned long long>(allocs));
+        for (int i = 0; i < site.depth; ++i) printFrame(out, i, site.frames[i]);
+    }
+    if (n > maxSites) std::fprintf(out, "  ... %zu more sites with live bytes\n", n - maxSites);
+    std::fflush(out);
+}
+
+void AllocTracker::setSampleEvery(unsigned n) { config().sampleEvery.store(n, std::memory_order_relaxed); }
+
+unsigned AllocTracker::sampleEvery() { return config().sampleEvery.load(std::memory_order_relaxed); }
+
+// ---------------- the replacements ----------------
+// __builtin_frame_address(0) gives each operator its own frame,
+// the start of the walk; __builtin_return_address(0) is the
+// `new` expression's caller.
+
+#define TRACK_FRAME __builtin_frame_address(0), __builtin_return_address(0)
+
+void* operator new(std::size_t n) { return allocate(n, 0, kScalar, false, TRACK_FRAME); }
+void* operator new[](std::size_t n) { return allocate(n, 0, kArray, false, TRACK_FRAME); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(n, 0, kScalar, true, TRACK_FRAME);
+    } catch (...) {
+        return nullptr;                                 // a throwing new_handler
+    }
+}
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(n, 0, kArray, true, TRACK_FRAME);
+    } catch (...) {
+        return nullptr;
+    }
+}
+void* operator new(std::size_t n, std::align_val_t a) {
+    return allocate(n, static_cast<std::size_t>(a), kScalar, false, TRACK_FRAME);
+}
+void* operator new[](std::size_t n, std::align_val_t a) {
+    return allocate(n, static_cast<std::size_t>(a), kArray, false, TRACK_FRAME);
+}
+void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(n, static_cast<std::size_t>(a), kScalar, true, TRACK_FRAME);
+    } catch (...) {
+        return nullptr;
+    }
+}
+void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(n, static_cast<std::size_t>(a), kArray, true, TRACK_FRAME);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* p) noexcept { release(p, kScalar, __builtin_return_address(0)); }
+void operator delete[](void* p) noexcept { release(p, kArray, __builtin_return_address(0)); }
+void operator delete(void* p, std::size_t) noexcept { release(p, kScalar, __builtin_return_address(0)); }
+void operator delete[](void* p, std::size_t) noexcept { release(p, kArray, __builtin_return_address(0)); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p, kScalar, __builtin_return_address(0)); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p, kArray, __builtin_return_address(0)); }
+void operator delete(void* p, std::align_val_t) noexcept { release(p, kScalar, __builtin_return_address(0)); }
+void operator delete[](void* p, std::align_val_t) noexcept { release(p, kArray, __builtin_return_address(0)); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    release(p, kScalar, __builtin_return_address(0));
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    release(p, kArray, __builtin_return_address(0));
+}
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    release(p, kScalar, __builtin_return_address(0));
+}
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    release(p, kArray, __builtin_return_address(0));
+}
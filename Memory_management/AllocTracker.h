@@ -0,0 +1,66 @@
+// ==========================================================
+// AllocTracker.h — link-in leak and double-free tracking
+// ==========================================================
+//
+// The raw new/delete sites in this tree:
+//
+//     Shallow a(10); Shallow b = a;     // shallowvsdeep.cpp: two deletes
+//     f(new Car());                     // dynamicCast.cpp: never deleted
+//     Game g(4);                        // `players` owned by nobody
+//
+// ASan finds all of these, at 2-3x CPU and memory — too much
+// for a production canary. Linking AllocTracker.cpp replaces
+// the global operator new/delete (every form) with a thin layer
+// on malloc/free:
+//
+//   - EVERY block gets a 16-byte header (size, state, kind):
+//     exact live bytes/blocks, double frees and new/delete[]
+//     mismatches are caught on every block
+//   - freed blocks wait in a small per-thread quarantine before
+//     returning to malloc, so a second delete still finds the
+//     "freed" header instead of someone else's live block
+//   - ONE IN N allocations (default 64) records its call stack
+//     ("site"); the report ranks sites by bytes still live,
+//     scaled by N into an estimate for all allocations
+//
+// Stacks are walked through frame pointers: cheap (a few loads
+// per frame), no unwinder tables, no allocation. The innermost
+// frame (the `new` expression's caller) is always exact; deeper
+// frames need the program built with -fno-omit-frame-pointer,
+// and the walk stops at the first frame that does not chain.
+//
+// Configuration (environment, read at the first allocation):
+//   ALLOC_TRACK_SAMPLE=N       sample one in N (0: no sites)
+//   ALLOC_TRACK_QUARANTINE=K   blocks held per thread (0: none)
+//   ALLOC_TRACK_REPORT=0       no report at exit
+//
+// Not tracked: malloc/free called directly, and memory the C
+// library hands out itself.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+class AllocTracker {
+public:
+    struct Stats {
+        std::uint64_t liveBytes = 0;        // exact, all blocks
+        std::uint64_t liveBlocks = 0;
+        std::uint64_t allocations = 0;      // since start
+        std::uint64_t sampled = 0;          // allocations with a recorded site
+        std::uint64_t doubleFrees = 0;
+        std::uint64_t mismatchedFrees = 0;  // new + delete[] or new[] + delete
+        std::uint64_t invalidFrees = 0;     // pointer never returned by new
+    };
+
+    static Stats stats();
+
+    // Sites ranked by live (unfreed) sampled bytes; the first
+    // maxSites are printed with their frames
+    static void report(std::FILE* out = stderr, std::size_t maxSites = 10);
+
+    static void setSampleEvery(unsigned n);
+    static unsigned sampleEvery();
+};
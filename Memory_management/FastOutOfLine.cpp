@@ -0,0 +1,17 @@
+#include "FastOutOfLine.h"
+
+FastOutOfLine::FastOutOfLine() {
+    data = 0;
+}
+
+void FastOutOfLine::SetData(int value) {
+    data = value;
+}
+
+bool FastOutOfLine::IsEven() {
+    return (data % 2 == 0);
+}
+
+void FastOutOfLine::Increment() {
+    data++;
+}
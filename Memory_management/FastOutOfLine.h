@@ -0,0 +1,22 @@
+// ==========================================================
+// FastOutOfLine.h — inline.cpp's Fast, defined in its own TU
+// ==========================================================
+//
+// Same members as Fast in inline.cpp, but the bodies live in
+// FastOutOfLine.cpp: a caller in another TU sees only the
+// declarations, so without LTO every call is a real call.
+// With -flto the linker sees both TUs and can inline them again
+// (inlineBench.cpp measures both builds).
+//
+#pragma once
+
+class FastOutOfLine {
+private:
+    int data;
+
+public:
+    FastOutOfLine();
+    void SetData(int value);
+    bool IsEven();
+    void Increment();
+};
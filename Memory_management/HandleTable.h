@@ -0,0 +1,149 @@
+// ==========================================================
+// HandleTable.h — generational handles instead of raw pointers
+// ==========================================================
+//
+// DanglingPointerr.txt / assertionExaple.cpp:
+//
+//     Player** players = new Player*[maxPlayers];
+//     Player* opponent = myGame->GetPlayer(1);
+//     delete players[1];                // someone removes the player
+//     opponent->...                     // dangling: undefined behaviour
+//
+// Setting players[1] = nullptr fixes the array, not the copies of
+// the pointer held elsewhere. weak_ptr fixes the copies, at the
+// price of a control block per object and an atomic
+// compare-exchange in every lock().
+//
+// HERE objects live in a HandleTable<T> and are referred to by a
+// Handle<T>: a 32-bit slot index plus a 32-bit generation.
+//
+//     HandleTable<Player> players;
+//     Handle<Player> h = players.create(...);
+//     players.destroy(h);               // slot's generation moves on
+//     players.get(h);                   // nullptr: stale, detected
+//
+// - get(h): one bounds check and one generation compare, O(1);
+//   nullptr for a stale or null handle (at(h) throws instead)
+// - a slot's generation is ODD while occupied, EVEN while free:
+//   destroy and create each add 1, so a handle (always odd)
+//   matches only the very object it was created for
+// - freed slots go on an intrusive free list and are reused
+//   LIFO; a slot whose generation would wrap is retired
+// - storage is chunked, so a T never moves: get()'s pointer
+//   stays valid until that object is destroyed
+//
+// Single-threaded, like the containers it replaces.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template <typename T>
+struct Handle {
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0; // 0: the null handle, never live
+
+    explicit operator bool() const { return generation != 0; }
+    friend bool operator==(Handle a, Handle b) { return a.index == b.index && a.generation == b.generation; }
+};
+
+template <typename T>
+class HandleTable {
+public:
+    HandleTable() = default;
+    HandleTable(const HandleTable&) = delete;
+    HandleTable& operator=(const HandleTable&) = delete;
+
+    ~HandleTable() {
+        for (std::uint32_t i = 0; i < slots_; ++i)
+            if (slot(i).generation & 1) slot(i).object()->~T();
+    }
+
+    template <typename... Args>
+    Handle<T> create(Args&&... args) {
+        const bool reuse = freeHead_ != kNone;
+        std::uint32_t i;
+        if (reuse) {
+            i = freeHead_;
+        } else {
+            if (slots_ == kNone) throw std::length_error("HandleTable::create: table full");
+            if (slots_ / kChunkSlots == chunks_.size()) chunks_.push_back(std::make_unique<Slot[]>(kChunkSlots));
+            i = slots_;
+        }
+        Slot& s = slot(i);
+        ::new (static_cast<void*>(s.storage)) T(std::forward<Args>(args)...);
+        if (reuse)
+            freeHead_ = s.nextFree;                       // only now: construction may throw
+        else
+            ++slots_;
+        ++s.generation;                                   // even -> odd: live
+        ++live_;
+        return Handle<T>{i, s.generation};
+    }
+
+    // false if `h` is stale or null (nothing destroyed then)
+    bool destroy(Handle<T> h) {
+        T* p = get(h);
+        if (!p) return false;
+        p->~T();
+        Slot& s = slot(h.index);
+        ++s.generation;                                   // odd -> even: free
+        --live_;
+        if (s.generation != kRetired) {
+            s.nextFree = freeHead_;
+            freeHead_ = h.index;
+        }
+        return true;
+    }
+
+    // The O(1) validated dereference
+    T* get(Handle<T> h) {
+        if (h.index >= slots_) return nullptr;
+        Slot& s = slot(h.index);
+        return s.generation == h.generation && (h.generation & 1) ? s.object() : nullptr;
+    }
+    const T* get(Handle<T> h) const { return const_cast<HandleTable*>(this)->get(h); }
+
+    T& at(Handle<T> h) {
+        if (T* p = get(h)) return *p;
+        throw std::out_of_range("HandleTable::at: stale or null handle");
+    }
+
+    bool valid(Handle<T> h) const { return get(h) != nullptr; }
+    std::size_t size() const { return live_; }
+
+    // f(handle, object) for every live object, in slot order
+    template <typename F>
+    void for_each(F&& f) {
+        for (std::uint32_t i = 0; i < slots_; ++i) {
+            Slot& s = slot(i);
+            if (s.generation & 1) f(Handle<T>{i, s.generation}, *s.object());
+        }
+    }
+
+private:
+    static constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+    static constexpr std::uint32_t kRetired = 0xFFFFFFFEu; // last even generation: never reused
+    static constexpr std::uint32_t kChunkSlots = 1024;
+    static constexpr std::uint32_t kChunkMask = kChunkSlots - 1;
+
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        std::uint32_t generation = 0;
+        std::uint32_t nextFree = kNone;
+        T* object() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    Slot& slot(std::uint32_t i) { return chunks_[i / kChunkSlots][i & kChunkMask]; }
+
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    std::uint32_t slots_ = 0;                             // slots ever handed out
+    std::uint32_t freeHead_ = kNone;
+    std::size_t live_ = 0;
+};
@@ -0,0 +1,239 @@
+// ==========================================================
+// IntrusivePtr.h — intrusive_ptr<T> and local_shared_ptr<T>
+// ==========================================================
+//
+// shared_unique_pointer.txt:
+//
+//     shared_ptr<GameObject> ptr1 = make_shared<GameObject>();
+//     shared_ptr<GameObject> ptr2 = ptr1;     // use_count() == 2
+//
+// shared_ptr always pays for
+//   - a CONTROL BLOCK beside the object (its own allocation with
+//     shared_ptr<T>(new T); fused into one with make_shared)
+//   - two pointers per shared_ptr (object + control block)
+//   - ATOMIC increments/decrements, even if the objects never
+//     leave the thread that made them
+//   - a weak count, whether or not weak_ptr is ever used
+//
+// TWO LIGHTER OWNERS:
+//
+// 1. intrusive_ptr<T> — the count lives IN the object:
+//
+//        class GameObject : public RefCounted<GameObject, SingleThreadCount> { ... };
+//        intrusive_ptr<GameObject> p = make_intrusive<GameObject>();
+//
+//    one pointer per handle, no control block, and the object
+//    can be re-wrapped from a raw `this` (the count travels
+//    with it). The count policy is chosen per class:
+//      AtomicCount        thread-safe (relaxed add, acq_rel sub)
+//      SingleThreadCount  plain integer: thread-confined objects
+//    Any class providing intrusive_add_ref(T*) and
+//    intrusive_release(T*) (found by ADL) works, not only
+//    RefCounted ones.
+//
+// 2. local_shared_ptr<T> — shared_ptr's shape (any T, no base
+//    class needed) for thread-confined graphs: a non-atomic
+//    count and no weak count; make_local_shared puts block and
+//    object in one allocation.
+//
+// Neither has weak pointers: break cycles by design (parent
+// owns children, children keep raw back-pointers).
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// ----------------------------------------------------------
+// Count policies
+// ----------------------------------------------------------
+struct AtomicCount {
+    std::atomic<long> n{0};
+    void increment() noexcept { n.fetch_add(1, std::memory_order_relaxed); }
+    bool decrement() noexcept { return n.fetch_sub(1, std::memory_order_acq_rel) == 1; }   // true: last
+    long value() const noexcept { return n.load(std::memory_order_relaxed); }
+};
+
+struct SingleThreadCount {
+    long n = 0;
+    void increment() noexcept { ++n; }
+    bool decrement() noexcept { return --n == 0; }
+    long value() const noexcept { return n; }
+};
+
+// Embeds the count; copying an object does NOT copy its count
+template <typename Derived, typename Count = AtomicCount>
+class RefCounted {
+public:
+    long use_count() const noexcept { return count_.value(); }
+
+protected:
+    RefCounted() = default;
+    RefCounted(const RefCounted&) noexcept {}
+    RefCounted& operator=(const RefCounted&) noexcept { return *this; }
+    ~RefCounted() = default;
+
+private:
+    friend void intrusive_add_ref(const Derived* p) noexcept { p->count_.increment(); }
+    friend void intrusive_release(const Derived* p) noexcept {
+        if (p->count_.decrement()) delete p;
+    }
+
+    mutable Count count_;
+};
+
+// ----------------------------------------------------------
+// intrusive_ptr
+// ----------------------------------------------------------
+template <typename T>
+class intrusive_ptr {
+public:
+    intrusive_ptr() noexcept = default;
+    intrusive_ptr(std::nullptr_t) noexcept {}
+    explicit intrusive_ptr(T* p, bool addRef = true) noexcept : p_(p) {
+        if (p_ && addRef) intrusive_add_ref(p_);
+    }
+    intrusive_ptr(const intrusive_ptr& o) noexcept : intrusive_ptr(o.p_) {}
+    intrusive_ptr(intrusive_ptr&& o) noexcept : p_(std::exchange(o.p_, nullptr)) {}
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    intrusive_ptr(const intrusive_ptr<U>& o) noexcept : intrusive_ptr(o.get()) {}
+
+    intrusive_ptr& operator=(intrusive_ptr o) noexcept {
+        std::swap(p_, o.p_);
+        return *this;
+    }
+    ~intrusive_ptr() {
+        if (p_) intrusive_release(p_);
+    }
+
+    void reset() noexcept { intrusive_ptr().swap(*this); }
+    void swap(intrusive_ptr& o) noexcept { std::swap(p_, o.p_); }
+
+    // Gives up ownership without decrementing
+    T* detach() noexcept { return std::exchange(p_, nullptr); }
+
+    T* get() const noexcept { return p_; }
+    T& operator*() const noexcept { return *p_; }
+    T* operator->() const noexcept { return p_; }
+    explicit operator bool() const noexcept { return p_ != nullptr; }
+
+    friend bool operator==(const intrusive_ptr& a, const intrusive_ptr& b) noexcept { return a.p_ == b.p_; }
+
+private:
+    T* p_ = nullptr;
+};
+
+template <typename T, typename... Args>
+intrusive_ptr<T> make_intrusive(Args&&... args) {
+    return intrusive_ptr<T>(new T(std::forward<Args>(args)...));
+}
+
+// ----------------------------------------------------------
+// local_shared_ptr
+// ----------------------------------------------------------
+namespace local_shared_detail {
+
+struct Block {
+    long refs = 1;
+    void (*destroy)(Block*) noexcept;      // object and block, however they were allocated
+};
+
+// make_local_shared: block and object in one allocation
+template <typename T>
+struct Inline : Block {
+    alignas(T) unsigned char storage[sizeof(T)];
+    T* object() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    static void destroyAll(Block* b) noexcept {
+        auto* self = static_cast<Inline*>(b);
+        self->object()->~T();
+        delete self;
+    }
+};
+
+// From a raw `new T`: a separate block, like shared_ptr<T>(new T)
+template <typename T>
+struct Separate : Block {
+    T* p;
+    static void destroyAll(Block* b) noexcept {
+        auto* self = static_cast<Separate*>(b);
+        delete self->p;
+        delete self;
+    }
+};
+
+}  // namespace local_shared_detail
+
+template <typename T>
+class local_shared_ptr {
+public:
+    local_shared_ptr() noexcept = default;
+    local_shared_ptr(std::nullptr_t) noexcept {}
+
+    // Takes ownership of `p` (allocated with new)
+    explicit local_shared_ptr(T* p) {
+        if (!p) return;
+        using S = local_shared_detail::Separate<T>;
+        S* s;
+        try {
+            s = new S;
+        } catch (...) {
+            delete p;
+            throw;
+        }
+        s->destroy = &S::destroyAll;
+        s->p = p;
+        block_ = s;
+        p_ = p;
+    }
+
+    local_shared_ptr(const local_shared_ptr& o) noexcept : p_(o.p_), block_(o.block_) {
+        if (block_) ++block_->refs;
+    }
+    local_shared_ptr(local_shared_ptr&& o) noexcept
+        : p_(std::exchange(o.p_, nullptr)), block_(std::exchange(o.block_, nullptr)) {}
+    local_shared_ptr& operator=(local_shared_ptr o) noexcept {
+        swap(o);
+        return *this;
+    }
+    ~local_shared_ptr() {
+        if (block_ && --block_->refs == 0) block_->destroy(block_);
+    }
+
+    void reset() noexcept { local_shared_ptr().swap(*this); }
+    void swap(local_shared_ptr& o) noexcept {
+        std::swap(p_, o.p_);
+        std::swap(block_, o.block_);
+    }
+
+    T* get() const noexcept { return p_; }
+    T& operator*() const noexcept { return *p_; }
+    T* operator->() const noexcept { return p_; }
+    explicit operator bool() const noexcept { return p_ != nullptr; }
+    long use_count() const noexcept { return block_ ? block_->refs : 0; }
+
+private:
+    template <typename U, typename... Args>
+    friend local_shared_ptr<U> make_local_shared(Args&&... args);
+
+    local_shared_ptr(T* p, local_shared_detail::Block* b) noexcept : p_(p), block_(b) {}
+
+    T* p_ = nullptr;
+    local_shared_detail::Block* block_ = nullptr;
+};
+
+template <typename T, typename... Args>
+local_shared_ptr<T> make_local_shared(Args&&... args) {
+    using I = local_shared_detail::Inline<T>;
+    I* b = new I;
+    try {
+        ::new (static_cast<void*>(b->storage)) T(std::forward<Args>(args)...);
+    } catch (...) {
+        delete b;
+        throw;
+    }
+    b->destroy = &I::destroyAll;
+    return local_shared_ptr<T>(b->object(), b);
+}
@@ -0,0 +1,295 @@
+// ======================================================
+// MappedFile.h — mmap'd read-only views and a read-ahead chunk reader
+// ======================================================
+//
+// arrayObjDynamic.cpp, exceptionHandling.cpp, std:exception.cpp:
+//
+//     cin >> size;                           // one value at a time,
+//     int* arr = new int[size];              // parsed from text
+//
+// Fine for a prompt; for a multi-GB dump every byte is copied
+// from the page cache into a stream buffer, scanned, converted
+// and copied again into the objects. Two ways to skip that:
+//
+// MappedFile: the file's pages ARE the data.
+//
+//     MappedFile f("scene.ent");                     // open + mmap, no reads
+//     std::span<const std::byte> all = f.bytes();
+//     f.advise(MappedFile::Access::Sequential);      // madvise: read ahead, drop behind
+//
+//   - opening costs a few system calls whatever the size; pages
+//     are read on first touch (page faults), served from the page
+//     cache when the file is already there
+//   - Mode::CopyOnWrite: a private mapping, writable; written pages
+//     are copied, the file never changes — load a scene and
+//     simulate it in place
+//   - advise(): Sequential / Random / WillNeed (start reading a
+//     range now) / DontNeed (drop a range already used); ranges
+//     are widened to whole pages
+//
+// ChunkReader: a read() loop for data that is streamed once.
+//
+//     ChunkReader in("sensors.bin", 1 << 20);        // 1 MiB chunks
+//     for (auto chunk = in.next(); !chunk.empty(); chunk = in.next())
+//         consume(chunk);                            // valid until the next call
+//
+//   - one buffer, reused: memory stays at one chunk for any size
+//   - posix_fadvise(SEQUENTIAL) at open and WILLNEED on the next
+//     `readAhead` chunks as it goes, so the disk is already
+//     reading while the caller works on this one; readAhead = 0
+//     turns the kernel's own read-ahead off (FADV_RANDOM)
+//   - dropBehind: DONTNEED on what was consumed, so a pass over a
+//     file larger than RAM does not evict everything else
+//   - chunks are exactly chunkBytes except the last: with
+//     chunkBytes a multiple of the record size no record
+//     straddles two chunks
+//
+// Errors (cannot open, map, read) throw std::system_error with
+// the path. POSIX: mmap / madvise / posix_fadvise. Win32:
+// CreateFileMapping / MapViewOfFile (FILE_MAP_COPY for
+// copy-on-write), PrefetchVirtualMemory for WillNeed, and
+// FILE_FLAG_SEQUENTIAL_SCAN for ChunkReader; the other hints do
+// nothing there.
+//
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class MappedFile {
+public:
+    enum class Mode { ReadOnly, CopyOnWrite };
+    enum class Access { Normal, Sequential, Random, WillNeed, DontNeed };
+
+    // Maps the whole file; throws std::system_error
+    explicit MappedFile(const std::string& path, Mode mode = Mode::ReadOnly) : mode_(mode) {
+#ifdef _WIN32
+        file_ = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) fail(path);
+        LARGE_INTEGER size;
+        if (!::GetFileSizeEx(file_, &size)) fail(path);
+        size_ = std::size_t(size.QuadPart);
+        if (size_ == 0) return;
+        mapping_ = ::CreateFileMappingA(file_, nullptr, mode == Mode::ReadOnly ? PAGE_READONLY : PAGE_WRITECOPY, 0,
+                                        0, nullptr);
+        if (!mapping_) fail(path);
+        data_ = static_cast<std::byte*>(
+            ::MapViewOfFile(mapping_, mode == Mode::ReadOnly ? FILE_MAP_READ : FILE_MAP_COPY, 0, 0, 0));
+        if (!data_) fail(path);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), path);
+        }
+        size_ = std::size_t(st.st_size);
+        if (size_ > 0) {
+            const int prot = mode == Mode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+            void* p = ::mmap(nullptr, size_, prot, MAP_PRIVATE, fd, 0);
+            const int err = errno;
+            ::close(fd);                              // the mapping keeps the file
+            if (p == MAP_FAILED) throw std::system_error(err, std::generic_category(), path);
+            data_ = static_cast<std::byte*>(p);
+        } else {
+            ::close(fd);
+        }
+#endif
+    }
+
+    MappedFile(MappedFile&& o) noexcept { swap(o); }
+    MappedFile& operator=(MappedFile&& o) noexcept {
+        MappedFile(std::move(o)).swap(*this);
+        return *this;
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() { release(); }
+
+    std::size_t size() const { return size_; }
+    Mode mode() const { return mode_; }
+    std::span<const std::byte> bytes() const { return {data_, size_}; }
+
+    // CopyOnWrite only: writes stay in this process
+    std::span<std::byte> writableBytes() {
+        if (mode_ != Mode::CopyOnWrite) throw std::logic_error("MappedFile: read-only mapping");
+        return {data_, size_};
+    }
+
+    // A hint for [offset, offset + length), widened to pages
+    void advise(Access access, std::size_t offset = 0, std::size_t length = SIZE_MAX) const {
+        if (!data_ || offset >= size_) return;
+        length = std::min(length, size_ - offset);
+        const std::size_t page = pageSize();
+        const std::size_t begin = offset / page * page;
+        const std::size_t end = offset + length;
+#ifdef _WIN32
+        if (access == Access::WillNeed) {
+            WIN32_MEMORY_RANGE_ENTRY range{data_ + begin, end - begin};
+            ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+        }
+#else
+        static constexpr int kAdvice[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED, MADV_DONTNEED};
+        ::madvise(data_ + begin, end - begin, kAdvice[int(access)]);
+#endif
+    }
+
+    static std::size_t pageSize() {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        ::GetSystemInfo(&info);
+        return info.dwPageSize;
+#else
+        static const std::size_t page = std::size_t(::sysconf(_SC_PAGESIZE));
+        return page;
+#endif
+    }
+
+private:
+    void release() noexcept {
+#ifdef _WIN32
+        if (data_) ::UnmapViewOfFile(data_);
+        if (mapping_) ::CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) ::CloseHandle(file_);
+#else
+        if (data_) ::munmap(data_, size_);
+#endif
+    }
+
+    void swap(MappedFile& o) noexcept {
+        std::swap(data_, o.data_);
+        std::swap(size_, o.size_);
+        std::swap(mode_, o.mode_);
+#ifdef _WIN32
+        std::swap(file_, o.file_);
+        std::swap(mapping_, o.mapping_);
+#endif
+    }
+
+#ifdef _WIN32
+    // The destructor does not run for a throwing constructor
+    [[noreturn]] void fail(const std::string& path) {
+        const DWORD err = ::GetLastError();
+        release();
+        throw std::system_error(int(err), std::system_category(), path);
+    }
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    Mode mode_ = Mode::ReadOnly;
+};
+
+class ChunkReader {
+public:
+    // readAhead: chunks to request ahead of the one returned
+    // (0: none, and the kernel's own read-ahead off)
+    explicit ChunkReader(const std::string& path, std::size_t chunkBytes = std::size_t(1) << 20,
+                         std::size_t readAhead = 4, bool dropBehind = false)
+        : path_(path), buffer_(std::max<std::size_t>(chunkBytes, 1)), readAhead_(readAhead), dropBehind_(dropBehind) {
+#ifdef _WIN32
+        file_ = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              readAhead ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE)
+            throw std::system_error(int(::GetLastError()), std::system_category(), path);
+#else
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) throw std::system_error(errno, std::generic_category(), path);
+        ::posix_fadvise(fd_, 0, 0, readAhead ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_RANDOM);
+#endif
+    }
+
+    ChunkReader(const ChunkReader&) = delete;
+    ChunkReader& operator=(const ChunkReader&) = delete;
+
+    ~ChunkReader() {
+#ifdef _WIN32
+        ::CloseHandle(file_);
+#else
+        ::close(fd_);
+#endif
+    }
+
+    // The next chunk (empty at end of file); valid until the next call
+    std::span<const std::byte> next() {
+        const std::size_t chunk = buffer_.size();
+#ifndef _WIN32
+        if (dropBehind_ && offset_ > dropped_) {
+            ::posix_fadvise(fd_, off_t(dropped_), off_t(offset_ - dropped_), POSIX_FADV_DONTNEED);
+            dropped_ = offset_;
+        }
+        // `readAhead` chunks requested beyond this one; re-armed
+        // once half of that window is used up
+        if (readAhead_) {
+            const std::uint64_t window = readAhead_ * chunk;
+            if (requested_ < offset_ + chunk + window / 2) {
+                const std::uint64_t from = std::max(requested_, offset_ + chunk);
+                const std::uint64_t to = offset_ + chunk + window;
+                ::posix_fadvise(fd_, off_t(from), off_t(to - from), POSIX_FADV_WILLNEED);
+                requested_ = to;
+            }
+        }
+#endif
+        std::size_t filled = 0;
+        while (filled < chunk) {
+#ifdef _WIN32
+            DWORD got = 0;
+            const DWORD want = DWORD(std::min<std::size_t>(chunk - filled, 1u << 30));
+            if (!::ReadFile(file_, buffer_.data() + filled, want, &got, nullptr))
+                throw std::system_error(int(::GetLastError()), std::system_category(), path_);
+#else
+            const ssize_t got = ::read(fd_, buffer_.data() + filled, chunk - filled);
+            if (got < 0) {
+                if (errno == EINTR) continue;
+                throw std::system_error(errno, std::generic_category(), path_);
+            }
+#endif
+            if (got == 0) break;                      // end of file
+            filled += std::size_t(got);
+        }
+        offset_ += filled;
+        return {buffer_.data(), filled};
+    }
+
+    // Bytes returned so far
+    std::uint64_t offset() const { return offset_; }
+
+private:
+    std::string path_;
+    std::vector<std::byte> buffer_;
+    std::size_t readAhead_;
+    bool dropBehind_;
+    std::uint64_t offset_ = 0;
+    std::uint64_t requested_ = 0;                     // WILLNEED issued up to here
+    std::uint64_t dropped_ = 0;                       // DONTNEED issued up to here
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+#else
+    int fd_ = -1;
+#endif
+};
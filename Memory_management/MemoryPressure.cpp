@@ -0,0 +1,223 @@
+// MemoryPressure.cpp — new_handler, shrinker registry and soft limit
+// (see MemoryPressure.h). Link this file into the program:
+//
+//     g++ -std=c++20 -O2 -pthread app.cpp MemoryPressure.cpp -o app
+//
+#include "MemoryPressure.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace {
+
+struct Entry {
+    int id;
+    std::string name;
+    int priority;
+    MemoryPressure::Shrinker fn;
+    std::uint64_t calls = 0;
+    std::uint64_t reclaimed = 0;
+};
+
+struct State {
+    std::mutex m;                               // registry; serialises the shrinking
+    std::vector<Entry> entries;                 // by priority, then registration
+    int nextId = 1;
+    bool installed = false;
+    std::new_handler previous = nullptr;
+
+    std::atomic<void*> reserve{nullptr};
+    std::atomic<std::size_t> reserveBytes{0};
+    std::atomic<std::size_t> softLimit{0};
+    std::atomic<std::size_t> shrinkStep{0};
+    std::atomic<std::size_t> charged{0};
+    std::atomic<std::uint64_t> epoch{0};        // bumped whenever memory was given back
+
+    std::atomic<std::uint64_t> handlerCalls{0}, shrinkCalls{0}, reclaimedBytes{0}, reserveReleases{0},
+        badAllocs{0}, chargesRefused{0}, replenished{0};
+};
+
+// Never destroyed: the handler may still run during exit
+State& state() {
+    static State* s = new State;
+    return *s;
+}
+
+// The thread is inside a shrinker: no shrinking again
+thread_local bool tInShrinker = false;
+
+void* takeReserve(std::size_t bytes) {
+    void* p = std::malloc(bytes);
+    if (p) std::memset(p, 0, bytes);            // make it resident now, not at the worst moment
+    return p;
+}
+
+// With s.m held
+std::size_t runShrinkers(State& s, std::size_t want) {
+    std::size_t got = 0;
+    tInShrinker = true;
+    for (Entry& e : s.entries) {
+        if (got >= want) break;
+        std::size_t freed = 0;
+        try {
+            freed = e.fn(want - got);
+        } catch (...) {
+            // a shrinker that throws reclaimed nothing
+        }
+        ++e.calls;
+        e.reclaimed += freed;
+        got += freed;
+        s.shrinkCalls.fetch_add(1, std::memory_order_relaxed);
+    }
+    tInShrinker = false;
+    s.reclaimedBytes.fetch_add(got, std::memory_order_relaxed);
+    if (got) s.epoch.fetch_add(1, std::memory_order_release);
+    return got;
+}
+
+void onOutOfMemory() {
+    State& s = state();
+    s.handlerCalls.fetch_add(1, std::memory_order_relaxed);
+    if (!tInShrinker) {
+        const std::uint64_t seen = s.epoch.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lk(s.m);
+        if (s.epoch.load(std::memory_order_acquire) != seen) return;        // reclaimed while we waited
+        if (runShrinkers(s, std::max<std::size_t>(s.shrinkStep.load(std::memory_order_relaxed), 1)) > 0) return;
+    }
+    if (void* r = s.reserve.exchange(nullptr)) {
+        std::free(r);
+        s.reserveReleases.fetch_add(1, std::memory_order_relaxed);
+        s.epoch.fetch_add(1, std::memory_order_release);
+        return;
+    }
+    s.badAllocs.fetch_add(1, std::memory_order_relaxed);
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void MemoryPressure::install(const Options& opt) {
+    State& s = state();
+    std::lock_guard<std::mutex> lg(s.m);
+    void* fresh = nullptr;
+    if (opt.reserveBytes && !(fresh = takeReserve(opt.reserveBytes))) throw std::bad_alloc();
+    if (void* old = s.reserve.exchange(fresh)) std::free(old);
+    s.reserveBytes.store(opt.reserveBytes);
+    s.softLimit.store(opt.softLimit);
+    s.shrinkStep.store(opt.shrinkStep);
+    if (!s.installed) {
+        s.previous = std::set_new_handler(&onOutOfMemory);
+        s.installed = true;
+    }
+}
+
+void MemoryPressure::uninstall() {
+    State& s = state();
+    std::lock_guard<std::mutex> lg(s.m);
+    if (!s.installed) return;
+    std::set_new_handler(s.previous);
+    s.installed = false;
+    if (void* old = s.reserve.exchange(nullptr)) std::free(old);
+    s.reserveBytes.store(0);
+}
+
+int MemoryPressure::addShrinker(std::string name, int priority, Shrinker fn) {
+    State& s = state();
+    std::lock_guard<std::mutex> lg(s.m);
+    const int id = s.nextId++;
+    auto at = std::upper_bound(s.entries.begin(), s.entries.end(), priority,
+                               [](int p, const Entry& e) { return p < e.priority; });
+    s.entries.insert(at, Entry{id, std::move(name), priority, std::move(fn)});
+    return id;
+}
+
+void MemoryPressure::removeShrinker(int id) {
+    State& s = state();
+    std::lock_guard<std::mutex> lg(s.m);
+    s.entries.erase(std::remove_if(s.entries.begin(), s.entries.end(), [id](const Entry& e) { return e.id == id; }),
+                    s.entries.end());
+}
+
+std::size_t MemoryPressure::shrink(std::size_t bytes) {
+    if (tInShrinker || bytes == 0) return 0;
+    State& s = state();
+    std::lock_guard<std::mutex> lg(s.m);
+    return runShrinkers(s, bytes);
+}
+
+bool MemoryPressure::tryCharge(std::size_t bytes) {
+    State& s = state();
+    const std::size_t limit = s.softLimit.load(std::memory_order_relaxed);
+    for (bool shrunk = false;;) {
+        std::size_t cur = s.charged.load(std::memory_order_relaxed);
+        if (limit == 0 || cur + bytes <= limit) {
+            if (s.charged.compare_exchange_weak(cur, cur + bytes, std::memory_order_relaxed)) return true;
+            continue;
+        }
+        if (shrunk || shrink(cur + bytes - limit) == 0) {
+            s.chargesRefused.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        shrunk = true;                          // the shrinkers uncharged what they freed: look again
+    }
+}
+
+void MemoryPressure::charge(std::size_t bytes) noexcept {
+    state().charged.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MemoryPressure::uncharge(std::size_t bytes) noexcept {
+    state().charged.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+std::size_t MemoryPressure::charged() noexcept {
+    return state().charged.load(std::memory_order_relaxed);
+}
+
+// Soft from 7/8 of the limit: callers checking level() back off
+// before their charges start being refused
+MemoryPressure::Level MemoryPressure::level() noexcept {
+    State& s = state();
+    if (s.reserveBytes.load() && !s.reserve.load()) return Level::Emergency;
+    const std::size_t limit = s.softLimit.load(std::memory_order_relaxed);
+    if (limit && s.charged.load(std::memory_order_relaxed) >= limit - limit / 8) return Level::Soft;
+    return Level::Normal;
+}
+
+bool MemoryPressure::replenish() {
+    State& s = state();
+    const std::size_t bytes = s.reserveBytes.load();
+    if (bytes == 0 || s.reserve.load()) return true;
+    void* p = takeReserve(bytes);               // malloc: a failure here does not enter the handler
+    if (!p) return false;
+    void* expected = nullptr;
+    if (!s.reserve.compare_exchange_strong(expected, p)) std::free(p);
+    else s.replenished.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+MemoryPressure::Stats MemoryPressure::stats() {
+    State& s = state();
+    Stats st;
+    st.handlerCalls = s.handlerCalls.load();
+    st.shrinkCalls = s.shrinkCalls.load();
+    st.reclaimedBytes = s.reclaimedBytes.load();
+    st.reserveReleases = s.reserveReleases.load();
+    st.badAllocs = s.badAllocs.load();
+    st.chargesRefused = s.chargesRefused.load();
+    st.replenished = s.replenished.load();
+    return st;
+}
+
+std::vector<MemoryPressure::ShrinkerStats> MemoryPressure::shrinkers() {
+    State& s = state();
+    std::lock_guard<std::mutex> lg(s.m);
+    std::vector<ShrinkerStats> out;
+    for (const Entry& e : s.entries) out.push_back({e.name, e.priority, e.calls, e.reclaimed});
+    return out;
+}
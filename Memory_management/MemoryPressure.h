@@ -0,0 +1,123 @@
+// ==========================================================
+// MemoryPressure.h — emergency reserve, cache shrinkers, soft limit
+// ==========================================================
+//
+// ExceptionHandling/std:exception.cpp:
+//
+//     buffer = new char[size];
+//     ...
+//     catch (const std::bad_alloc& e) { cout << "Memory Allocation Failed: " ... }
+//
+// By the time bad_alloc reaches a catch, the process has nothing
+// left: the pools and caches still hold their memory, and even
+// formatting the error may need a heap it does not have. Link
+// MemoryPressure.cpp and install it once:
+//
+//     MemoryPressure::Options o;
+//     o.reserveBytes = 8 << 20;                 // held back for the way out
+//     o.softLimit = 512 << 20;                  // charged bytes, see tryCharge
+//     MemoryPressure::install(o);
+//     int id = MemoryPressure::addShrinker("response cache", 0, [&](std::size_t want) {
+//         return cache.evictBytes(want);        // bytes actually freed
+//     });
+//
+// WHEN new FAILS, std::set_new_handler calls MemoryPressure's
+// handler, and operator new retries whenever it returns:
+//   1. SHRINK: the shrinkers run, lowest priority value first,
+//      until `shrinkStep` bytes are reclaimed. Freed anything →
+//      return (the allocation retries)
+//   2. RESERVE: nothing left to shrink → free the reserve once
+//      and go to Level::Emergency; the allocation retries in the
+//      reserve's space, and so does the error path after it
+//   3. GIVE UP: reserve gone too → std::bad_alloc, as before
+//
+// SOFT LIMIT (backpressure before the heap runs out): subsystems
+// charge what they keep (tryCharge / uncharge). A charge that
+// would pass `softLimit` first runs the shrinkers for the excess;
+// still over → it is refused (Level::Soft) and the caller sheds
+// work instead of growing: serve without caching, reject the
+// request, slow the producer.
+//
+// - a shrinker gets the bytes wanted and returns the bytes freed.
+//   It runs on whichever thread hit the limit, possibly inside
+//   operator new: it must not wait for a lock held by code that
+//   allocates or charges (try_lock, return 0 when busy)
+// - an allocation failing INSIDE a shrinker skips the shrinkers
+//   (no recursion) and goes straight to the reserve
+// - handler calls from several threads are serialised; a thread
+//   that waited while another reclaimed just retries
+// - replenish() takes the reserve back once memory is available
+//   again (Level::Normal)
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class MemoryPressure {
+public:
+    enum class Level { Normal, Soft, Emergency };
+
+    struct Options {
+        std::size_t reserveBytes = 8 << 20;     // 0: no reserve
+        std::size_t softLimit = 0;              // charged bytes; 0: no limit
+        std::size_t shrinkStep = 4 << 20;       // reclaimed per handler call, at least
+    };
+
+    // Bytes wanted → bytes freed
+    using Shrinker = std::function<std::size_t(std::size_t)>;
+
+    struct Stats {
+        std::uint64_t handlerCalls = 0;         // new_handler invocations
+        std::uint64_t shrinkCalls = 0;          // shrinker invocations (handler + soft limit)
+        std::uint64_t reclaimedBytes = 0;       // returned by the shrinkers
+        std::uint64_t reserveReleases = 0;
+        std::uint64_t badAllocs = 0;            // passed on after the reserve was gone
+        std::uint64_t chargesRefused = 0;       // tryCharge over the soft limit
+        std::uint64_t replenished = 0;
+    };
+
+    struct ShrinkerStats {
+        std::string name;
+        int priority;
+        std::uint64_t calls;
+        std::uint64_t reclaimedBytes;
+    };
+
+    // Allocates (and touches) the reserve, sets the new_handler.
+    // Again: new options, the reserve resized. Throws bad_alloc if
+    // the reserve cannot be had
+    static void install(const Options& opt);
+    // Restores the previous new_handler, frees the reserve
+    static void uninstall();
+
+    // Lower priority values run first (cheap caches before
+    // expensive ones). Returns the id for removeShrinker
+    static int addShrinker(std::string name, int priority, Shrinker fn);
+    static void removeShrinker(int id);
+
+    // Runs the shrinkers for `bytes` now (e.g. on a memory warning)
+    static std::size_t shrink(std::size_t bytes);
+
+    // ---------------- soft limit ----------------
+
+    // Charges `bytes` if that stays within the soft limit, after
+    // shrinking if needed; false: refused, shed the work
+    static bool tryCharge(std::size_t bytes);
+    // Charges regardless (memory that cannot be refused)
+    static void charge(std::size_t bytes) noexcept;
+    static void uncharge(std::size_t bytes) noexcept;
+    static std::size_t charged() noexcept;
+
+    // ---------------- state ----------------
+
+    static Level level() noexcept;
+    // Takes the reserve back; true when held again
+    static bool replenish();
+
+    static Stats stats();
+    static std::vector<ShrinkerStats> shrinkers();
+};
@@ -0,0 +1,83 @@
+// ==========================================================
+// Relocatable.h — "move + destroy" as one memcpy, for types that opt in
+// ==========================================================
+//
+// shallowvsdeep.cpp / deepCopyExample.cpp / ResourceTypes.h:
+//
+//     class RuleOfFive { int* data; ... RuleOfFive(RuleOfFive&&) noexcept; ~RuleOfFive(); };
+//     class Deep       { int* data; ... Deep(const Deep&);                  ~Deep();       };
+//
+// When std::vector<RuleOfFive> reallocates it RELOCATES every
+// element: move-construct at the new address, destroy the old one
+// — two calls per element, plus a check for a null pointer in every
+// destructor. For Deep (no move constructor) it is worse: a COPY,
+// i.e. a new + a delete per element.
+//
+// For these types the result is exactly the old bytes at the new
+// address: the object holds a pointer to memory it owns, never a
+// pointer into itself. Such a type is TRIVIALLY RELOCATABLE —
+// relocating n of them is memcpy(to, from, n * sizeof(T)) and
+// forgetting the old bytes (no destructor runs).
+//
+// The compiler cannot know this (the special members are user
+// code), so types OPT IN:
+//
+//     template <> struct is_trivially_relocatable<MyType> : std::true_type {};
+//
+// Trivially copyable types are relocatable automatically. NOT
+// relocatable: anything pointing into itself — libstdc++'s
+// std::string (its data pointer aims at its own SSO buffer), list
+// heads, objects registered by address somewhere else.
+//
+// The helpers pick memcpy / memmove for relocatable types and
+// move + destroy otherwise:
+//   uninitialized_relocate(first, last, out)   to fresh memory; strong guarantee
+//   relocate_within(first, last, out)          inside one buffer, overlap allowed
+//
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+// Owns a pointer, never points into itself
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+// Relocates [first, last) into uninitialised memory at `out` (no
+// overlap). Afterwards [first, last) holds no objects. If a move
+// (or the copy used when moving may throw) throws, the objects
+// built at `out` are destroyed and [first, last) is untouched
+template <typename T>
+void uninitialized_relocate(T* first, T* last, T* out) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (first != last) std::memcpy(static_cast<void*>(out), first, std::size_t(last - first) * sizeof(T));
+    } else {
+        T* built = out;
+        try {
+            for (T* p = first; p != last; ++p, ++built) ::new (static_cast<void*>(built)) T(std::move_if_noexcept(*p));
+        } catch (...) {
+            std::destroy(out, built);
+            throw;
+        }
+        std::destroy(first, last);
+    }
+}
+
+// Relocates [first, last) to `out` inside the same buffer; the
+// ranges may overlap. Only for relocatable types: the others shift
+// with move assignment (see relocating_vector / small_vector)
+template <typename T>
+void relocate_within(T* first, T* last, T* out) noexcept {
+    static_assert(is_trivially_relocatable_v<T>, "relocate_within: T is not trivially relocatable");
+    if (first != last) std::memmove(static_cast<void*>(out), first, std::size_t(last - first) * sizeof(T));
+}
@@ -0,0 +1,295 @@
+// ==========================================================
+// RelocatingVector.h — a vector that grows, inserts and erases with memcpy
+// ==========================================================
+//
+// std::vector<RuleOfFive>::push_back past capacity, with 10^7
+// elements: 10^7 move constructors, 10^7 destructors, and a fresh
+// block the size of the old one plus half — old and new alive at
+// the same time. insert / erase shift every later element with move
+// assignment, one call each.
+//
+// relocating_vector<T> is the std::vector subset these programs use,
+// with every relocation going through Relocatable.h:
+//
+//   - is_trivially_relocatable_v<T>:
+//       growth   = realloc(): one memcpy at worst; a block glibc
+//                  mmap'd itself (large, fresh) grows in place or
+//                  moves its PAGES (mremap) instead of the bytes
+//       insert   = memmove the tail up, drop the new element in
+//       erase    = destroy the erased, memmove the tail down
+//     no constructor, destructor or assignment runs for the
+//     elements that only change address
+//   - otherwise: exactly std::vector's moves, copies and guarantees
+//     (move_if_noexcept on growth; insert / erase by move
+//     assignment)
+//
+// Growth doubles. A failed growth leaves the vector as it was. As
+// with std::vector, growth, insert and erase invalidate iterators
+// and references (to the moved part).
+//
+//     relocating_vector<RuleOfFive> v;
+//     v.reserve(n);                 // or not: growth is cheap now
+//     v.emplace_back(42);
+//     v.insert(v.begin() + 3, RuleOfFive(7));
+//     v.erase(v.begin());
+//
+// Not thread-safe, like std::vector.
+//
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "Relocatable.h"
+
+template <typename T>
+class relocating_vector {
+    // realloc / malloc align for max_align_t only
+    static constexpr bool kRealloc =
+        is_trivially_relocatable_v<T> && alignof(T) <= alignof(std::max_align_t);
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    relocating_vector() noexcept = default;
+    explicit relocating_vector(std::size_t n) { resize(n); }
+    relocating_vector(std::initializer_list<T> init) {
+        reserve(init.size());
+        std::uninitialized_copy(init.begin(), init.end(), data_);
+        size_ = init.size();
+    }
+
+    relocating_vector(const relocating_vector& other) {
+        reserve(other.size_);
+        std::uninitialized_copy(other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+    relocating_vector(relocating_vector&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {}
+
+    relocating_vector& operator=(const relocating_vector& other) {
+        if (this != &other) {
+            relocating_vector copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    relocating_vector& operator=(relocating_vector&& other) noexcept {
+        if (this != &other) {
+            relocating_vector gone(std::move(other));
+            swap(gone);
+        }
+        return *this;
+    }
+
+    ~relocating_vector() {
+        clear();
+        release(data_, capacity_);
+    }
+
+    void swap(relocating_vector& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    // ---- growth at the end ----
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) return growAndEmplace(std::forward<Args>(args)...);
+        T* p = ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *p;
+    }
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+    void pop_back() { std::destroy_at(data_ + --size_); }
+
+    void reserve(std::size_t n) {
+        if (n > capacity_) reallocate(n);
+    }
+
+    void resize(std::size_t n) {
+        if (n <= size_) {
+            std::destroy(data_ + n, data_ + size_);
+            size_ = n;
+            return;
+        }
+        if (n > capacity_) reallocate(std::max(n, capacity_ * 2));
+        for (; size_ < n; ++size_) ::new (static_cast<void*>(data_ + size_)) T();
+    }
+
+    // Destroys the elements; the buffer is kept
+    void clear() noexcept {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    // ---- insert / erase ----
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const std::size_t i = std::size_t(pos - data_);
+        if (i == size_) return &emplace_back(std::forward<Args>(args)...);
+        if constexpr (is_trivially_relocatable_v<T>) {
+            // Built aside first: `args` may refer to an element that
+            // is about to move. Then dropped in by relocation
+            Scratch s;
+            ::new (s.get()) T(std::forward<Args>(args)...);
+            if (size_ == capacity_) {
+                try {
+                    reallocate(capacity_ * 2);
+                } catch (...) {
+                    std::destroy_at(static_cast<T*>(s.get()));
+                    throw;
+                }
+            }
+            relocate_within(data_ + i, data_ + size_, data_ + i + 1);
+            std::memcpy(static_cast<void*>(data_ + i), s.get(), sizeof(T));
+        } else {
+            T value(std::forward<Args>(args)...);
+            if (size_ == capacity_) reallocate(capacity_ * 2);
+            ::new (static_cast<void*>(data_ + size_)) T(std::move(data_[size_ - 1]));
+            std::move_backward(data_ + i, data_ + size_ - 1, data_ + size_);
+            data_[i] = std::move(value);
+        }
+        ++size_;
+        return data_ + i;
+    }
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        T* f = data_ + (first - data_);
+        T* l = data_ + (last - data_);
+        if (f == l) return f;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::destroy(f, l);
+            relocate_within(l, data_ + size_, f);
+        } else {
+            T* newEnd = std::move(l, data_ + size_, f);
+            std::destroy(newEnd, data_ + size_);
+        }
+        size_ -= std::size_t(l - f);
+        return f;
+    }
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    // ---- access ----
+
+    T& operator[](std::size_t i) { return data_[i]; }
+    const T& operator[](std::size_t i) const { return data_[i]; }
+    T& at(std::size_t i) {
+        if (i >= size_) throw std::out_of_range("relocating_vector::at: index out of range");
+        return data_[i];
+    }
+    const T& at(std::size_t i) const { return const_cast<relocating_vector*>(this)->at(i); }
+    T& front() { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& front() const { return data_[0]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    std::size_t size() const noexcept { return size_; }
+    std::size_t capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    friend bool operator==(const relocating_vector& a, const relocating_vector& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+private:
+    // Raw room for one T, no constructor or destructor
+    struct Scratch {
+        alignas(T) unsigned char bytes[sizeof(T)];
+        void* get() { return bytes; }
+    };
+
+    static void release(T* p, std::size_t capacity) noexcept {
+        if (!p) return;
+        if constexpr (kRealloc) std::free(p);
+        else std::allocator<T>().deallocate(p, capacity);
+    }
+
+    std::size_t grown() const { return capacity_ ? capacity_ * 2 : 4; }
+
+    void reallocate(std::size_t newCapacity) {
+        if constexpr (kRealloc) {
+            void* p = std::realloc(static_cast<void*>(data_), newCapacity * sizeof(T));   // bytes come along
+            if (!p) throw std::bad_alloc();
+            data_ = static_cast<T*>(p);
+        } else {
+            T* fresh = std::allocator<T>().allocate(newCapacity);
+            try {
+                uninitialized_relocate(data_, data_ + size_, fresh);
+            } catch (...) {
+                std::allocator<T>().deallocate(fresh, newCapacity);
+                throw;
+            }
+            release(data_, capacity_);
+            data_ = fresh;
+        }
+        capacity_ = newCapacity;
+    }
+
+    // The new element is built first: `args` may refer to an
+    // element of this vector
+    template <typename... Args>
+    T& growAndEmplace(Args&&... args) {
+        const std::size_t newCapacity = grown();
+        if constexpr (kRealloc) {
+            Scratch s;
+            ::new (s.get()) T(std::forward<Args>(args)...);
+            try {
+                reallocate(newCapacity);
+            } catch (...) {
+                std::destroy_at(static_cast<T*>(s.get()));
+                throw;
+            }
+            std::memcpy(static_cast<void*>(data_ + size_), s.get(), sizeof(T));
+        } else {
+            T* fresh = std::allocator<T>().allocate(newCapacity);
+            try {
+                ::new (static_cast<void*>(fresh + size_)) T(std::forward<Args>(args)...);
+                try {
+                    uninitialized_relocate(data_, data_ + size_, fresh);
+                } catch (...) {
+                    std::destroy_at(fresh + size_);
+                    throw;
+                }
+            } catch (...) {
+                std::allocator<T>().deallocate(fresh, newCapacity);
+                throw;
+            }
+            release(data_, capacity_);
+            data_ = fresh;
+            capacity_ = newCapacity;
+        }
+        return data_[size_++];
+    }
+
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
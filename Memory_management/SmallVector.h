@@ -0,0 +1,359 @@
+// ==========================================================
+// SmallVector.h — up to N elements on the stack, heap past that
+// ==========================================================
+//
+// exceptionHandling.cpp / std:exception.cpp:
+//
+//     buffer = new char[size];          // usually a few dozen bytes
+//     ...
+//     delete[] buffer;
+//
+// ArrayOfDifferentobj.cpp:
+//
+//     objects = new GameObject*[size];  // three pointers
+//
+// statck.txt / heap.txt: the stack is a pointer bump, freed at
+// scope exit; the heap is a malloc call, a free call and a cache
+// miss. These sites pay the heap price for sizes that would fit
+// in a few cache lines of the frame.
+//
+// small_vector<T, N> keeps its first N elements INSIDE the object
+// (so on the stack, for a local) and moves to a heap buffer only
+// when it grows past N:
+//
+//     +---------------------------------+
+//     | data_ | size_ | capacity_       |  data_ == inline_ → inline
+//     | inline_[N * sizeof(T)]          |
+//     +---------------------------------+
+//
+//     small_vector<GameObject*, 3> objects;     // no allocation
+//     inline_buffer<256> buffer;
+//     buffer.resize_for_overwrite(size);       // malloc only if size > 256
+//
+// - the std::vector subset these sites need: push_back /
+//   emplace_back / pop_back, insert / erase, resize, reserve,
+//   clear, [], at(), contiguous iterators, copy and move
+// - growth doubles; elements relocate with move_if_noexcept, so
+//   a failed growth leaves the vector as it was — or with one
+//   memcpy when is_trivially_relocatable_v<T> (Relocatable.h),
+//   which also makes insert / erase and inline moves memmoves
+// - a spilled (heap) vector moves by stealing the pointer; an
+//   inline one moves element by element — iterators and
+//   references do not survive a move, unlike std::vector
+// - resize_for_overwrite(n) leaves new trivial elements
+//   uninitialised, exactly like new char[n]
+// - N defaults so that the whole object is 64 bytes
+//
+// advise_inline_capacity<T>(observed sizes) picks N from a run's
+// sizes: the smallest N that keeps `coverage` of them inline,
+// within a stack budget.
+//
+// Not thread-safe, like std::vector.
+//
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Relocatable.h"
+
+namespace small_vector_detail {
+
+// Elements that fit next to the three header words in 64 bytes
+template <typename T>
+constexpr std::size_t defaultInline() {
+    constexpr std::size_t header = sizeof(void*) + 2 * sizeof(std::size_t);
+    return sizeof(T) < 64 - header ? (64 - header) / sizeof(T) : 1;
+}
+
+}  // namespace small_vector_detail
+
+template <typename T, std::size_t N = small_vector_detail::defaultInline<T>()>
+class small_vector {
+    static_assert(N > 0, "small_vector: N must be at least 1 (use std::vector otherwise)");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr std::size_t inline_capacity = N;
+
+    small_vector() noexcept : data_(inlineData()) {}
+    explicit small_vector(std::size_t n) : small_vector() { resize(n); }
+    small_vector(std::size_t n, const T& value) : small_vector() { resize(n, value); }
+    small_vector(std::initializer_list<T> init) : small_vector() {
+        reserve(init.size());
+        std::uninitialized_copy(init.begin(), init.end(), data_);
+        size_ = init.size();
+    }
+
+    small_vector(const small_vector& other) : small_vector() {
+        reserve(other.size_);
+        std::uninitialized_copy(other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : small_vector() {
+        takeFrom(other);
+    }
+
+    small_vector& operator=(const small_vector& other) {
+        if (this != &other) {
+            small_vector copy(other);
+            clear();
+            takeFrom(copy);
+        }
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    ~small_vector() {
+        clear();
+        freeHeap();
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) return growAndEmplace(std::forward<Args>(args)...);
+        T* p = ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *p;
+    }
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() { std::destroy_at(data_ + --size_); }
+
+    // `args` may refer to an element: the new one is built first
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const std::size_t i = std::size_t(pos - data_);
+        if (i == size_) return &emplace_back(std::forward<Args>(args)...);
+        T value(std::forward<Args>(args)...);
+        if (size_ == capacity_) relocate(grownCapacity(size_ + 1));
+        if constexpr (is_trivially_relocatable_v<T>) {
+            relocate_within(data_ + i, data_ + size_, data_ + i + 1);
+            ::new (static_cast<void*>(data_ + i)) T(std::move(value));
+        } else {
+            ::new (static_cast<void*>(data_ + size_)) T(std::move(data_[size_ - 1]));
+            std::move_backward(data_ + i, data_ + size_ - 1, data_ + size_);
+            data_[i] = std::move(value);
+        }
+        ++size_;
+        return data_ + i;
+    }
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        T* f = data_ + (first - data_);
+        T* l = data_ + (last - data_);
+        if (f == l) return f;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::destroy(f, l);
+            relocate_within(l, data_ + size_, f);
+        } else {
+            std::destroy(std::move(l, data_ + size_, f), data_ + size_);
+        }
+        size_ -= std::size_t(l - f);
+        return f;
+    }
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    // Destroys the elements; a heap buffer is kept
+    void clear() noexcept {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    void reserve(std::size_t n) {
+        if (n > capacity_) relocate(n);
+    }
+
+    void resize(std::size_t n) {
+        resizeWith(n, [](T* p) { ::new (static_cast<void*>(p)) T(); });
+    }
+    void resize(std::size_t n, const T& value) {
+        if (n > capacity_) {                        // value may be an element about to move
+            T copy(value);
+            resizeWith(n, [&](T* p) { ::new (static_cast<void*>(p)) T(copy); });
+            return;
+        }
+        resizeWith(n, [&](T* p) { ::new (static_cast<void*>(p)) T(value); });
+    }
+    // New elements default-initialised: indeterminate for char, like new char[n]
+    void resize_for_overwrite(std::size_t n) {
+        resizeWith(n, [](T* p) { ::new (static_cast<void*>(p)) T; });
+    }
+
+    T& operator[](std::size_t i) { return data_[i]; }
+    const T& operator[](std::size_t i) const { return data_[i]; }
+    T& at(std::size_t i) {
+        if (i >= size_) throw std::out_of_range("small_vector::at: index out of range");
+        return data_[i];
+    }
+    const T& at(std::size_t i) const { return const_cast<small_vector*>(this)->at(i); }
+    T& front() { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& front() const { return data_[0]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    std::size_t size() const noexcept { return size_; }
+    std::size_t capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+    // true while the elements live inside the object
+    bool is_inline() const noexcept { return data_ == inlineData(); }
+
+    friend bool operator==(const small_vector& a, const small_vector& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+private:
+    T* inlineData() noexcept { return reinterpret_cast<T*>(inline_); }
+    const T* inlineData() const noexcept { return reinterpret_cast<const T*>(inline_); }
+
+    static T* allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+
+    void freeHeap() noexcept {
+        if (!is_inline()) std::allocator<T>().deallocate(data_, capacity_);
+    }
+
+    // Moves (or copies, if moving could throw) the elements to
+    // `to`, or memcpys them; on an exception the ones built there
+    // are destroyed
+    void relocateInto(T* to) { uninitialized_relocate(data_, data_ + size_, to); }
+
+    void adopt(T* heap, std::size_t capacity) noexcept {
+        freeHeap();
+        data_ = heap;
+        capacity_ = capacity;
+    }
+
+    void relocate(std::size_t newCapacity) {
+        T* heap = allocate(newCapacity);
+        try {
+            relocateInto(heap);
+        } catch (...) {
+            std::allocator<T>().deallocate(heap, newCapacity);
+            throw;
+        }
+        adopt(heap, newCapacity);
+    }
+
+    std::size_t grownCapacity(std::size_t needed) const {
+        return std::max(needed, capacity_ * 2);
+    }
+
+    // The new element is built first: `args` may refer to an
+    // element of this vector
+    template <typename... Args>
+    T& growAndEmplace(Args&&... args) {
+        const std::size_t newCapacity = grownCapacity(size_ + 1);
+        T* heap = allocate(newCapacity);
+        T* p;
+        try {
+            p = ::new (static_cast<void*>(heap + size_)) T(std::forward<Args>(args)...);
+            try {
+                relocateInto(heap);
+            } catch (...) {
+                std::destroy_at(p);
+                throw;
+            }
+        } catch (...) {
+            std::allocator<T>().deallocate(heap, newCapacity);
+            throw;
+        }
+        adopt(heap, newCapacity);
+        ++size_;
+        return *p;
+    }
+
+    template <typename Construct>
+    void resizeWith(std::size_t n, Construct construct) {
+        if (n <= size_) {
+            std::destroy(data_ + n, data_ + size_);
+            size_ = n;
+            return;
+        }
+        if (n > capacity_) relocate(grownCapacity(n));
+        for (; size_ < n; ++size_) construct(data_ + size_);
+    }
+
+    // Requires an empty *this
+    void takeFrom(small_vector& other) {
+        if (!other.is_inline()) {
+            adopt(other.data_, other.capacity_);
+            size_ = other.size_;
+            other.data_ = other.inlineData();
+            other.capacity_ = N;
+            other.size_ = 0;
+            return;
+        }
+        if constexpr (is_trivially_relocatable_v<T>) {
+            uninitialized_relocate(other.data_, other.data_ + other.size_, data_);   // other.size_ <= N
+            size_ = std::exchange(other.size_, 0);
+            return;
+        }
+        for (; size_ < other.size_; ++size_)                  // other.size_ <= N <= capacity_
+            ::new (static_cast<void*>(data_ + size_)) T(std::move(other.data_[size_]));
+        other.clear();
+    }
+
+    T* data_;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = N;
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+};
+
+// A byte buffer: inline up to N bytes, the new char[size] sites
+template <std::size_t N>
+using inline_buffer = small_vector<char, N>;
+
+// Choosing N from a run's sizes
+struct InlineAdvice {
+    std::size_t capacity = 0;          // suggested N (0: keep these on the heap)
+    double inlineFraction = 0;         // share of the observed sizes that stay inline with it
+    std::size_t objectBytes = 0;       // sizeof(small_vector<T, capacity>), roughly
+};
+
+// Smallest N holding `coverage` of `observed` inline, as long as
+// the inline storage stays within `maxStackBytes`; past that the
+// sizes are too large for the stack and the advice is N = 0
+template <typename T>
+InlineAdvice advise_inline_capacity(std::vector<std::size_t> observed, double coverage = 0.95,
+                                    std::size_t maxStackBytes = 1024) {
+    if (observed.empty()) return {};
+    if (coverage <= 0 || coverage > 1) throw std::invalid_argument("advise_inline_capacity: coverage must be in (0, 1]");
+    std::sort(observed.begin(), observed.end());
+    std::size_t k = static_cast<std::size_t>(coverage * double(observed.size()) + 0.5);
+    k = std::clamp<std::size_t>(k, 1, observed.size());
+    std::size_t n = std::max<std::size_t>(observed[k - 1], 1);
+    if (n * sizeof(T) > maxStackBytes) return {};
+    std::size_t inlineCount = std::upper_bound(observed.begin(), observed.end(), n) - observed.begin();
+    return {n, double(inlineCount) / double(observed.size()),
+            sizeof(void*) + 2 * sizeof(std::size_t) + n * sizeof(T)};
+}
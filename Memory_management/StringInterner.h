@@ -0,0 +1,284 @@
+// ==========================================================
+// StringInterner.h — concurrent string interning, 32-bit symbols
+// ==========================================================
+//
+// The same few names, stored again and again:
+//
+//     Weapon("Missile", false);                 // freindExample.cpp: a string per weapon
+//     Box<string> b("hello");                   // classTemplate.cpp
+//     cout << threadName << ": " << buffer;     // LockGuard.cpp: per log line
+//     cout << typeid(ev).name();                // union.cpp handleEvent
+//
+// A std::string is 32 bytes before its characters (and a heap
+// block after 15 of them); comparing two is a memcmp. Interned,
+// each DISTINCT string is stored once and everyone else holds a
+// Symbol — 4 bytes, compared and hashed as an integer:
+//
+//     StringInterner names;
+//     Symbol s = names.intern("Plasma Rifle Mk 17");   // the same Symbol for the same text
+//     names.view(s);                                    // std::string_view, valid as long as `names`
+//     s == t;                                           // one integer compare
+//
+// LAYOUT:
+//
+//   hash(text) ─┬─ top bits → shard (16)
+//               └─ low bits → slot in that shard's table
+//
+//   shard: open-addressing table of 64-bit slots
+//            [ hash 32 | local index + 1 32 ]     (0 = empty)
+//          entries: local index → the bytes in the shard's ARENA
+//            [ len 32 | chars | \0 ]              (64 KB chunks)
+//
+//   Symbol id = shard << 28 | local index
+//
+// READERS DO NOT LOCK: find() / a hit in intern() probe the table
+// with acquire loads and compare against the published bytes;
+// view() is two loads. A MISS locks its shard, probes again,
+// copies the text into the arena, publishes the entry and then
+// the slot (release), so a reader that sees the slot sees the
+// text. Growing the table (at half full) builds a new one under
+// the lock and publishes it; old tables are kept until the
+// interner is destroyed, because a reader may still be probing
+// one (they add up to less than the current table). A reader on
+// an old table can miss a brand-new string: find() says "absent",
+// intern() then takes the lock and finds it.
+//
+// Strings are never removed. 2^28 strings per shard, each under
+// 4 GB. The id of a Symbol says nothing about the text's order.
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+struct Symbol {
+    std::uint32_t id = ~0u;
+
+    bool valid() const { return id != ~0u; }
+    friend bool operator==(Symbol a, Symbol b) { return a.id == b.id; }
+    friend bool operator!=(Symbol a, Symbol b) { return a.id != b.id; }
+};
+
+template <>
+struct std::hash<Symbol> {
+    std::size_t operator()(Symbol s) const noexcept { return s.id; }
+};
+
+class StringInterner {
+public:
+    static constexpr unsigned kShardBits = 4;
+    static constexpr std::uint32_t kIndexBits = 32 - kShardBits;
+
+    struct Stats {
+        std::size_t strings = 0;
+        std::size_t textBytes = 0;          // the characters, once each
+        std::size_t arenaBytes = 0;         // chunks allocated
+        std::size_t tableBytes = 0;         // current tables + entry blocks
+        std::size_t retiredBytes = 0;       // old tables kept for readers
+    };
+
+    StringInterner() = default;
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    Symbol intern(std::string_view s) {
+        const std::uint64_t h = hash(s);
+        Shard& sh = shards_[h >> (64 - kShardBits)];
+        if (Symbol f = probe(sh, h, s); f.valid()) return f;            // the common case: no lock
+        std::lock_guard<std::mutex> lg(sh.m);
+        if (Symbol f = probe(sh, h, s); f.valid()) return f;            // interned while we waited
+        return insert(sh, h, s);
+    }
+
+    // Without inserting; an invalid Symbol if absent
+    Symbol find(std::string_view s) const {
+        const std::uint64_t h = hash(s);
+        return probe(shards_[h >> (64 - kShardBits)], h, s);
+    }
+
+    // s must come from this interner
+    std::string_view view(Symbol s) const {
+        const char* p = entry(shards_[s.id >> kIndexBits], s.id & kIndexMask);
+        std::uint32_t len;
+        std::memcpy(&len, p, sizeof len);
+        return {p + sizeof len, len};
+    }
+    // NUL-terminated (for printf-style APIs)
+    const char* c_str(Symbol s) const { return entry(shards_[s.id >> kIndexBits], s.id & kIndexMask) + 4; }
+
+    std::size_t size() const {
+        std::size_t n = 0;
+        for (const Shard& sh : shards_) n += sh.count.load(std::memory_order_acquire);
+        return n;
+    }
+
+    Stats stats() const {
+        Stats st;
+        for (Shard& sh : shards_) {
+            std::lock_guard<std::mutex> lg(sh.m);
+            st.strings += sh.count.load();
+            st.textBytes += sh.textBytes;
+            st.arenaBytes += sh.arenaBytes;
+            const Table* t = sh.table.load();
+            st.tableBytes += t ? (t->mask + 1) * sizeof(std::uint64_t) : 0;
+            st.tableBytes += sh.blocks.size() * kBlock * sizeof(const char*);
+            for (const auto& old : sh.retired) st.retiredBytes += (old->mask + 1) * sizeof(std::uint64_t);
+        }
+        return st;
+    }
+
+    static std::uint64_t hash(std::string_view s) {
+        std::uint64_t h = 0x9E3779B97F4A7C15ull ^ s.size();
+        std::size_t i = 0;
+        for (; i + 8 <= s.size(); i += 8) {
+            std::uint64_t w;
+            std::memcpy(&w, s.data() + i, 8);
+            h = (h ^ w) * 0xFF51AFD7ED558CCDull;
+            h ^= h >> 32;
+        }
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, s.data() + i, s.size() - i);
+        h = (h ^ tail) * 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 29;
+        h *= 0xFF51AFD7ED558CCDull;
+        return h ^ (h >> 32);
+    }
+
+private:
+    static constexpr std::uint32_t kIndexMask = (1u << kIndexBits) - 1;
+    static constexpr std::size_t kBlock = 4096;                // entries per block
+    static constexpr std::size_t kMaxBlocks = (std::size_t(1) << kIndexBits) / kBlock;
+    static constexpr std::size_t kChunk = 64 * 1024;
+
+    struct Table {
+        explicit Table(std::size_t slots) : mask(slots - 1), slot(new std::atomic<std::uint64_t>[slots]) {
+            for (std::size_t i = 0; i < slots; ++i) slot[i].store(0, std::memory_order_relaxed);
+        }
+        const std::size_t mask;
+        std::unique_ptr<std::atomic<std::uint64_t>[]> slot;
+    };
+
+    struct Shard {
+        mutable std::mutex m;
+        std::atomic<Table*> table{nullptr};
+        std::atomic<std::uint32_t> count{0};
+        // local index → bytes: fixed blocks, so a published entry never moves
+        std::unique_ptr<std::atomic<const char**>[]> blockDir{new std::atomic<const char**>[kMaxBlocks]()};
+        // all below: under m
+        std::vector<std::unique_ptr<const char*[]>> blocks;
+        std::vector<std::unique_ptr<Table>> retired;
+        std::unique_ptr<Table> current;
+        std::vector<std::unique_ptr<char[]>> chunks;
+        char* cursor = nullptr;
+        std::size_t left = 0;
+        std::size_t textBytes = 0, arenaBytes = 0;
+    };
+
+    static const char* entry(const Shard& sh, std::uint32_t local) {
+        const char** block = sh.blockDir[local / kBlock].load(std::memory_order_acquire);
+        return block[local % kBlock];
+    }
+
+    static bool same(const char* p, std::string_view s) {
+        std::uint32_t len;
+        std::memcpy(&len, p, sizeof len);
+        return len == s.size() && std::memcmp(p + sizeof len, s.data(), len) == 0;
+    }
+
+    static Symbol make(const Shard& sh, const Shard* base, std::uint32_t local) {
+        return {std::uint32_t(&sh - base) << kIndexBits | local};
+    }
+
+    Symbol probe(const Shard& sh, std::uint64_t h, std::string_view s) const {
+        const Table* t = sh.table.load(std::memory_order_acquire);
+        if (!t) return {};
+        const std::uint32_t tag = std::uint32_t(h >> 32);
+        for (std::size_t i = h & t->mask;; i = (i + 1) & t->mask) {
+            const std::uint64_t v = t->slot[i].load(std::memory_order_acquire);
+            if (v == 0) return {};
+            if (std::uint32_t(v >> 32) == tag) {
+                const std::uint32_t local = std::uint32_t(v) - 1;
+                if (same(entry(sh, local), s)) return make(sh, shards_, local);
+            }
+        }
+    }
+
+    // Under sh.m
+    Symbol insert(Shard& sh, std::uint64_t h, std::string_view s) {
+        const std::uint32_t local = sh.count.load(std::memory_order_relaxed);
+        if (local > kIndexMask || s.size() > 0xFFFFFFFFull - 8) throw std::length_error("StringInterner: full");
+        if (!sh.current || (local + 1) * 2 > sh.current->mask + 1) grow(sh);
+
+        // 1. the bytes
+        const std::size_t need = (sizeof(std::uint32_t) + s.size() + 1 + 3) & ~std::size_t(3);
+        char* p;
+        if (need > kChunk / 4) {                                    // big: a block of its own
+            sh.chunks.emplace_back(new char[need]);
+            p = sh.chunks.back().get();
+            sh.arenaBytes += need;
+        } else {
+            if (sh.left < need) {
+                sh.chunks.emplace_back(new char[kChunk]);
+                sh.cursor = sh.chunks.back().get();
+                sh.left = kChunk;
+                sh.arenaBytes += kChunk;
+            }
+            p = sh.cursor;
+            sh.cursor += need;
+            sh.left -= need;
+        }
+        const std::uint32_t len = std::uint32_t(s.size());
+        std::memcpy(p, &len, sizeof len);
+        std::memcpy(p + sizeof len, s.data(), s.size());
+        p[sizeof len + s.size()] = '\0';
+        sh.textBytes += s.size();
+
+        // 2. the entry
+        if (local % kBlock == 0) {
+            sh.blocks.emplace_back(new const char*[kBlock]);
+            sh.blockDir[local / kBlock].store(sh.blocks.back().get(), std::memory_order_release);
+        }
+        sh.blocks[local / kBlock][local % kBlock] = p;
+
+        // 3. the slot: published last (release: entry and bytes first)
+        place(*sh.current, h, local);
+        sh.count.store(local + 1, std::memory_order_release);
+        return make(sh, shards_, local);
+    }
+
+    static void place(Table& t, std::uint64_t h, std::uint32_t local) {
+        std::size_t i = h & t.mask;
+        while (t.slot[i].load(std::memory_order_relaxed) != 0) i = (i + 1) & t.mask;
+        t.slot[i].store(std::uint64_t(std::uint32_t(h >> 32)) << 32 | (local + 1), std::memory_order_release);
+    }
+
+    // Under sh.m: a table twice the size (64 slots at first), filled
+    // from the entries, then published
+    void grow(Shard& sh) {
+        const std::size_t slots = sh.current ? (sh.current->mask + 1) * 2 : 64;
+        auto next = std::make_unique<Table>(slots);
+        const std::uint32_t n = sh.count.load(std::memory_order_relaxed);
+        for (std::uint32_t local = 0; local < n; ++local) place(*next, hashOf(entry(sh, local)), local);
+        sh.table.store(next.get(), std::memory_order_release);
+        if (sh.current) sh.retired.push_back(std::move(sh.current));
+        sh.current = std::move(next);
+    }
+
+    static std::uint64_t hashOf(const char* p) {
+        std::uint32_t len;
+        std::memcpy(&len, p, sizeof len);
+        return hash({p + sizeof len, len});
+    }
+
+    mutable Shard shards_[1u << kShardBits];
+};
@@ -0,0 +1,238 @@
+// ThreadCache.cpp — thread caches, central depot and slabs
+// (see ThreadCache.h). Link this file into the program:
+//
+//     g++ -std=c++20 -O2 -pthread app.cpp ThreadCache.cpp -o app
+//
+#include "ThreadCache.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <pthread.h>
+
+namespace {
+
+constexpr std::size_t kSizes[] = {16,  32,  48,  64,  80,  96,  112, 128, 160, 192,
+                                  224, 256, 320, 384, 448, 512, 640, 768, 896, 1024};
+constexpr std::size_t kClasses = sizeof(kSizes) / sizeof(kSizes[0]);
+constexpr std::size_t kSlabBytes = 64 * 1024;
+constexpr std::size_t kBatchBytes = 8 * 1024;
+
+static_assert(kSizes[kClasses - 1] == ThreadCache::kMaxSmall, "ThreadCache: last class must be kMaxSmall");
+
+// Request size (in 8-byte steps) -> class, built at compile time
+constexpr auto kClassOf = [] {
+    std::array<std::uint8_t, ThreadCache::kMaxSmall / 8 + 1> t{};
+    std::size_t c = 0;
+    for (std::size_t i = 0; i < t.size(); ++i) {
+        while (kSizes[c] < i * 8) ++c;
+        t[i] = static_cast<std::uint8_t>(c);
+    }
+    return t;
+}();
+
+constexpr std::uint32_t batchOf(std::size_t c) {
+    std::size_t b = kBatchBytes / kSizes[c];
+    return static_cast<std::uint32_t>(b < 8 ? 8 : b > 64 ? 64 : b);
+}
+
+// A free block: `next` inside a list, `nextBatch` links whole
+// batches in the depot (hence the 16-byte minimum class)
+struct Node {
+    Node* next;
+    Node* nextBatch;
+};
+
+// Detaches the first `count` blocks of `head` and returns them
+Node* splitFront(Node*& head, std::uint32_t count) {
+    Node* batch = head;
+    Node* last = batch;
+    for (std::uint32_t i = 1; i < count; ++i) last = last->next;
+    head = last->next;
+    last->next = nullptr;
+    return batch;
+}
+
+// ---------------- central depot ----------------
+
+struct Depot {
+    std::mutex m;
+    Node* batches = nullptr;            // full batches, B blocks each
+    Node* loose = nullptr;              // single blocks (partial lists of exited threads)
+    std::uint32_t looseCount = 0;
+    char* carve = nullptr;              // rest of the newest slab
+    char* carveEnd = nullptr;
+};
+
+struct Central {
+    Depot depots[kClasses];
+    std::atomic<std::uint64_t> slabs{0};
+    std::atomic<std::uint64_t> batchesFetched{0};
+    std::atomic<std::uint64_t> batchesReturned{0};
+};
+
+Central& central() {
+    static Central* c = new Central;    // never destroyed: threads may free during exit
+    return *c;
+}
+
+// A chain of exactly `n` blocks: a full batch if there is one,
+// else the loose blocks topped up from the slab
+Node* fetchBatch(std::size_t c, std::uint32_t n) {
+    Depot& d = central().depots[c];
+    std::unique_lock<std::mutex> lk(d.m);
+    Node* head;
+    bool newSlab = false;
+    if (d.batches) {
+        head = d.batches;
+        d.batches = head->nextBatch;
+    } else {
+        const std::size_t size = kSizes[c];
+        std::uint32_t fromLoose = d.looseCount < n ? d.looseCount : n;
+        std::size_t carveBytes = (n - fromLoose) * size;
+        newSlab = carveBytes > std::size_t(d.carveEnd - d.carve);
+        if (newSlab) {                   // a batch never spans slabs; the old tail is dropped
+            void* slab = std::aligned_alloc(kSlabBytes, kSlabBytes);
+            if (!slab) throw std::bad_alloc();
+            d.carve = static_cast<char*>(slab);
+            d.carveEnd = d.carve + kSlabBytes;
+        }
+        head = fromLoose ? splitFront(d.loose, fromLoose) : nullptr;
+        d.looseCount -= fromLoose;
+        for (std::uint32_t i = fromLoose; i < n; ++i) {
+            Node* b = reinterpret_cast<Node*>(d.carve);
+            d.carve += size;
+            b->next = head;
+            head = b;
+        }
+    }
+    lk.unlock();
+    if (newSlab) central().slabs.fetch_add(1, std::memory_order_relaxed);
+    central().batchesFetched.fetch_add(1, std::memory_order_relaxed);
+    return head;
+}
+
+void returnBatch(std::size_t c, Node* batch) {
+    Depot& d = central().depots[c];
+    {
+        std::lock_guard<std::mutex> lg(d.m);
+        batch->nextBatch = d.batches;
+        d.batches = batch;
+    }
+    central().batchesReturned.fetch_add(1, std::memory_order_relaxed);
+}
+
+void returnLoose(std::size_t c, Node* chain, std::uint32_t n) {
+    if (!chain) return;
+    Node* last = chain;
+    while (last->next) last = last->next;
+    Depot& d = central().depots[c];
+    std::lock_guard<std::mutex> lg(d.m);
+    last->next = d.loose;
+    d.loose = chain;
+    d.looseCount += n;
+}
+
+// ---------------- thread caches ----------------
+
+struct FreeList {
+    Node* head = nullptr;
+    std::uint32_t count = 0;
+};
+
+// Trivially destructible, so the fast path has no TLS guard;
+// thread exit is caught with a pthread key instead
+struct Cache {
+    FreeList lists[kClasses];
+    bool registered = false;
+    bool exited = false;                // after exit: frees go straight to the depot
+};
+
+thread_local Cache tls;
+
+void flush(Cache& cache) noexcept {
+    for (std::size_t c = 0; c < kClasses; ++c) {
+        FreeList& fl = cache.lists[c];
+        const std::uint32_t b = batchOf(c);
+        for (; fl.count >= b; fl.count -= b) returnBatch(c, splitFront(fl.head, b));
+        returnLoose(c, fl.head, fl.count);
+        fl.head = nullptr;
+        fl.count = 0;
+    }
+}
+
+pthread_key_t exitKey;
+const bool exitKeyCreated = pthread_key_create(&exitKey, [](void* p) {
+    Cache* cache = static_cast<Cache*>(p);
+    flush(*cache);
+    cache->exited = true;
+}) == 0;
+
+// The list is empty
+void* refill(Cache& cache, std::size_t c) {
+    if (!cache.registered) {
+        cache.registered = true;
+        if (exitKeyCreated) pthread_setspecific(exitKey, &cache);
+    }
+    FreeList& fl = cache.lists[c];
+    fl.head = fetchBatch(c, batchOf(c));
+    fl.count = batchOf(c) - 1;
+    Node* n = fl.head;
+    fl.head = n->next;
+    return n;
+}
+
+}  // namespace
+
+std::size_t ThreadCache::classSize(std::size_t bytes) {
+    return bytes <= kMaxSmall ? kSizes[kClassOf[(bytes + 7) / 8]] : 0;
+}
+
+void* ThreadCache::allocate(std::size_t bytes) {
+    if (bytes > kMaxSmall) {
+        if (void* p = std::malloc(bytes)) return p;
+        throw std::bad_alloc();
+    }
+    const std::size_t c = kClassOf[(bytes + 7) / 8];
+    Cache& cache = tls;
+    FreeList& fl = cache.lists[c];
+    if (Node* n = fl.head) {
+        fl.head = n->next;
+        --fl.count;
+        return n;
+    }
+    return refill(cache, c);
+}
+
+void ThreadCache::deallocate(void* p, std::size_t bytes) noexcept {
+    if (!p) return;
+    if (bytes > kMaxSmall) {
+        std::free(p);
+        return;
+    }
+    const std::size_t c = kClassOf[(bytes + 7) / 8];
+    Node* n = static_cast<Node*>(p);
+    Cache& cache = tls;
+    if (cache.exited) {
+        n->next = nullptr;
+        returnLoose(c, n, 1);
+        return;
+    }
+    FreeList& fl = cache.lists[c];
+    n->next = fl.head;
+    fl.head = n;
+    if (++fl.count > 2 * batchOf(c)) {                 // too many: one batch back to the depot
+        returnBatch(c, splitFront(fl.head, batchOf(c)));
+        fl.count -= batchOf(c);
+    }
+}
+
+void ThreadCache::flushThisThread() noexcept { flush(tls); }
+
+ThreadCache::Stats ThreadCache::stats() {
+    Central& g = central();
+    return {g.slabs.load(std::memory_order_relaxed), g.batchesFetched.load(std::memory_order_relaxed),
+            g.batchesReturned.load(std::memory_order_relaxed)};
+}
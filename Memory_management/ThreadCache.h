@@ -0,0 +1,73 @@
+// ==========================================================
+// ThreadCache.h — thread-caching small-object allocator
+// ==========================================================
+//
+// The new/delete sites in this tree:
+//
+//     f(new Car());                     // dynamicCast.cpp
+//     Vehicle* v = new Car(); delete v; // poly.cpp
+//     value = new Data(c.value->data);  // deepCopyExample.cpp
+//
+// all go to glibc malloc: per-thread arenas and tcache bins, but
+// a 16-byte header per block, and a block freed on another
+// thread goes back through that arena's lock.
+//
+// ThreadCache (link ThreadCache.cpp):
+//
+//   thread cache ──(batch of B blocks)── central depot ── 64 KB slabs
+//
+//   - SIZE CLASSES 16 .. 1024 bytes (21 classes, ≤ 25% waste);
+//     larger requests go to malloc
+//   - each thread keeps a free LIST per class: allocate pops,
+//     deallocate pushes — no lock, no atomic, no header
+//   - an empty list takes ONE BATCH (B = 8..64 blocks, ~8 KB)
+//     from that class's depot under one lock; a list grown past
+//     2B hands a batch back. Frees on another thread simply
+//     fill THAT thread's list, and the overflow batches flow
+//     back to the depot for everyone
+//   - the depot carves new slabs when it has no batch; slabs are
+//     never returned to the OS (like SlabPool)
+//   - a thread's cached blocks go back to the depot when it exits
+//
+// Routing: derive a class from ThreadCached<T> and its (and its
+// subclasses') new / delete / new[] / delete[] use ThreadCache.
+// Deallocation is SIZED (the class-level operator delete gets
+// the size), so nothing has to be looked up per block.
+//
+//     class Car : public ThreadCached<Car> { ... };
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+class ThreadCache {
+public:
+    static constexpr std::size_t kMaxSmall = 1024;
+
+    static void* allocate(std::size_t bytes);
+    static void deallocate(void* p, std::size_t bytes) noexcept;
+
+    // Gives this thread's cached blocks back to the depot
+    static void flushThisThread() noexcept;
+
+    struct Stats {
+        std::uint64_t slabs = 0;              // 64 KB slabs carved so far
+        std::uint64_t batchesFetched = 0;     // depot -> thread caches
+        std::uint64_t batchesReturned = 0;    // thread caches -> depot
+    };
+    static Stats stats();
+
+    // Block size a request of `bytes` is rounded up to (0: not small)
+    static std::size_t classSize(std::size_t bytes);
+};
+
+// Class-level operator new/delete routed to ThreadCache
+template <typename T>
+struct ThreadCached {
+    static void* operator new(std::size_t n) { return ThreadCache::allocate(n); }
+    static void* operator new[](std::size_t n) { return ThreadCache::allocate(n); }
+    static void operator delete(void* p, std::size_t n) noexcept { ThreadCache::deallocate(p, n); }
+    static void operator delete[](void* p, std::size_t n) noexcept { ThreadCache::deallocate(p, n); }
+};
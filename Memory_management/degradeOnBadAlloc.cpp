@@ -0,0 +1,290 @@
+// ==========================================================
+// TOPIC: Shedding Cached Memory Instead of Failing on bad_alloc
+// ==========================================================
+//
+// ExceptionHandling/std:exception.cpp:
+//
+//     buffer = new char[size];
+//     catch (const std::bad_alloc& e) { cout << "Memory Allocation Failed: " ... }
+//
+// ❌ the catch only reports: whatever filled the heap (here a
+//    response cache) still holds it, so the NEXT request fails
+//    the same way — the service is up but serves nothing
+// ❌ the error path itself needs memory (a report string) and
+//    can throw a second bad_alloc from inside the catch
+//
+// ✅ MemoryPressure.h: a new_handler that runs registered cache
+//    shrinkers and retries, then frees an emergency reserve, and
+//    only then lets bad_alloc through; a soft limit on charged
+//    bytes refuses growth early (serve without caching); stats on
+//    what was reclaimed
+//
+// Measured here: a service answers `requests` requests on
+// `threads` threads; each builds a 256 KB response (works on it,
+// then caches it), under an address-space limit (RLIMIT_AS) of the
+// current size + `headroom` MB. Per mode: requests served, failed,
+// error reports that could not be built, and MemoryPressure's
+// counters:
+//   A. catch bad_alloc only               (the original)
+//   B. reserve + the cache as a shrinker  (new_handler)
+//   C. B + a soft limit of headroom / 2   (shrinks early; refuses
+//                                          when the cache is busy)
+//   D. reserve only: Level::Emergency tells the service to drop
+//      its cache and replenish() the reserve
+//
+// No sanitizers: they reserve terabytes of address space.
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./degrade [headroom MB] [requests] [threads]
+//
+//   headroom MB → address space above the start    (default 160)
+//   requests    → per mode, all threads together   (default 2000)
+//   threads     → serving threads                  (default 2)
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread degradeOnBadAlloc.cpp MemoryPressure.cpp -o degrade
+//
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <malloc.h>
+#include <mutex>
+#include <new>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "MemoryPressure.h"
+
+using namespace std;
+
+constexpr size_t kResponse = 256 << 10;
+constexpr size_t kReport = 64 << 10;
+
+// FIFO cache of responses. Nothing is allocated under the lock (a
+// failing allocation there would re-enter evictBytes through the
+// new_handler): nodes are built outside and spliced in, evicted
+// nodes are spliced out and freed after unlocking.
+class ResponseCache {
+public:
+    explicit ResponseCache(bool charged) : charged_(charged) {}
+
+    void put(list<vector<char>>& one) {
+        lock_guard<mutex> lg(m_);
+        entries_.splice(entries_.end(), one);
+        bytes_ += kResponse;
+    }
+
+    size_t evictBytes(size_t want) {
+        list<vector<char>> victims;
+        size_t freed = 0;
+        {
+            unique_lock<mutex> lk(m_, try_to_lock);
+            if (!lk.owns_lock()) return 0;          // busy: another cache may give
+            while (freed < want && !entries_.empty()) {
+                victims.splice(victims.end(), entries_, entries_.begin());
+                freed += kResponse;
+            }
+            bytes_ -= freed;
+        }
+        if (charged_) MemoryPressure::uncharge(freed);
+        return freed;                               // victims freed here
+    }
+
+    void clear() { evictBytes(SIZE_MAX); }
+
+    size_t bytes() {
+        lock_guard<mutex> lg(m_);
+        return bytes_;
+    }
+
+private:
+    mutex m_;
+    list<vector<char>> entries_;
+    size_t bytes_ = 0;
+    const bool charged_;
+};
+
+enum class Mode { CatchOnly, Shrinkers, SoftLimit, ReserveOnly };
+
+struct Result {
+    long served = 0, failed = 0, lostReports = 0, uncached = 0;
+    size_t peakCache = 0;
+    MemoryPressure::Stats st;
+};
+
+// Busy work on the response, so it is really used
+uint64_t checksum(const vector<char>& v) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < v.size(); i += 64) h = (h ^ uint8_t(v[i])) * 1099511628211ull;
+    return h;
+}
+
+Result serve(Mode mode, size_t headroom, long requests, int threads) {
+    ResponseCache cache(mode == Mode::SoftLimit);
+    int shrinkerId = 0;
+    if (mode != Mode::CatchOnly) {
+        MemoryPressure::Options o;
+        o.reserveBytes = 8 << 20;
+        o.softLimit = mode == Mode::SoftLimit ? headroom / 2 : 0;
+        MemoryPressure::install(o);
+        if (mode != Mode::ReserveOnly)
+            shrinkerId = MemoryPressure::addShrinker("response cache", 0, [&](size_t want) {
+                return cache.evictBytes(want);
+            });
+    }
+    const MemoryPressure::Stats before = MemoryPressure::stats();
+
+    atomic<long> next{0}, served{0}, failed{0}, lost{0}, uncached{0};
+    atomic<size_t> peak{0};
+    atomic<uint64_t> sink{0};
+    auto worker = [&] {
+        while (next.fetch_add(1) < requests) {
+            try {
+                if (mode == Mode::ReserveOnly && MemoryPressure::level() == MemoryPressure::Level::Emergency) {
+                    cache.clear();                                  // degrade: give the heap back
+                    MemoryPressure::replenish();
+                }
+                list<vector<char>> one;
+                one.emplace_back(kResponse, char('a' + next.load() % 26));
+                sink.fetch_add(checksum(one.front()), memory_order_relaxed);
+                if (mode != Mode::SoftLimit || MemoryPressure::tryCharge(kResponse)) cache.put(one);
+                else uncached.fetch_add(1);                          // backpressure: serve, do not keep
+                served.fetch_add(1);
+                const size_t b = cache.bytes();
+                for (size_t p = peak.load(); b > p && !peak.compare_exchange_weak(p, b);) {}
+            } catch (const bad_alloc&) {
+                failed.fetch_add(1);
+                try {
+                    string report(kReport, ' ');                     // the error path needs memory too
+                    report.replace(0, 41, "Memory Allocation Failed: std::bad_alloc ");
+                    sink.fetch_add(report.size(), memory_order_relaxed);
+                } catch (const bad_alloc&) {
+                    lost.fetch_add(1);
+                }
+            }
+        }
+    };
+    vector<thread> ts;
+    for (int t = 0; t < threads; ++t) ts.emplace_back(worker);
+    for (auto& t : ts) t.join();
+
+    Result r;
+    r.served = served;
+    r.failed = failed;
+    r.lostReports = lost;
+    r.uncached = uncached;
+    r.peakCache = peak;
+    const MemoryPressure::Stats after = MemoryPressure::stats();
+    r.st.handlerCalls = after.handlerCalls - before.handlerCalls;
+    r.st.reclaimedBytes = after.reclaimedBytes - before.reclaimedBytes;
+    r.st.reserveReleases = after.reserveReleases - before.reserveReleases;
+    r.st.badAllocs = after.badAllocs - before.badAllocs;
+    r.st.chargesRefused = after.chargesRefused - before.chargesRefused;
+    r.st.replenished = after.replenished - before.replenished;
+    if (shrinkerId) MemoryPressure::removeShrinker(shrinkerId);
+    cache.clear();
+    MemoryPressure::uninstall();
+    return r;
+}
+
+size_t addressSpaceBytes() {
+    FILE* f = fopen("/proc/self/statm", "r");
+    unsigned long pages = 0;
+    if (f) {
+        if (fscanf(f, "%lu", &pages) != 1) pages = 0;
+        fclose(f);
+    }
+    return size_t(pages) * size_t(sysconf(_SC_PAGESIZE));
+}
+
+int main(int argc, char** argv) {
+    const long headroomMb = argc > 1 ? atol(argv[1]) : 160;
+    const long requests = argc > 2 ? atol(argv[2]) : 2000;
+    const long threads = argc > 3 ? atol(argv[3]) : 2;
+    if (headroomMb < 48 || requests < 1 || threads < 1 || threads > 16) {
+        cerr << "usage: degrade [headroom MB >= 48] [requests >= 1] [threads 1..16]" << endl;
+        return 2;
+    }
+    const size_t headroom = size_t(headroomMb) << 20;
+    mallopt(M_ARENA_MAX, 1);                        // no 64 MB arena reservation per thread
+
+    // Threads' stacks and the output buffers exist before the limit
+    { thread([] {}).join(); }
+    cout << requests << " requests of " << (kResponse >> 10) << " KB on " << threads << " thread(s), "
+         << headroomMb << " MB of address space to spare" << endl
+         << endl;
+
+    rlimit old{};
+    getrlimit(RLIMIT_AS, &old);
+    rlimit lim = old;
+    lim.rlim_cur = addressSpaceBytes() + headroom + size_t(threads) * (8 << 20);   // + their stacks
+    if (setrlimit(RLIMIT_AS, &lim) != 0) {
+        cerr << "cannot set RLIMIT_AS" << endl;
+        return 1;
+    }
+    const Result a = serve(Mode::CatchOnly, headroom, requests, int(threads));
+    const Result b = serve(Mode::Shrinkers, headroom, requests, int(threads));
+    const Result c = serve(Mode::SoftLimit, headroom, requests, int(threads));
+    const Result d = serve(Mode::ReserveOnly, headroom, requests, int(threads));
+    setrlimit(RLIMIT_AS, &old);
+
+    cout << "  " << left << setw(34) << "mode" << right << setw(8) << "served" << setw(8) << "failed" << setw(11)
+         << "no-report" << setw(10) << "peak MB" << setw(9) << "handler" << setw(13) << "reclaimed MB" << setw(9)
+         << "reserve" << setw(9) << "refused" << endl;
+    auto row = [](const char* name, const Result& r) {
+        cout << "  " << left << setw(34) << name << right << setw(8) << r.served << setw(8) << r.failed << setw(11)
+             << r.lostReports << setw(10) << (r.peakCache >> 20) << setw(9) << r.st.handlerCalls << setw(13)
+             << (r.st.reclaimedBytes >> 20) << setw(9) << r.st.reserveReleases << setw(9) << r.st.chargesRefused
+             << endl;
+    };
+    row("A. catch bad_alloc only", a);
+    row("B. reserve + cache shrinker", b);
+    row("C. B + soft limit (headroom / 2)", c);
+    row("D. reserve only, Emergency → drop", d);
+    cout << endl
+         << "  C: the soft limit reclaimed " << (c.st.reclaimedBytes >> 20) << " MB before any allocation failed, "
+         << c.uncached << " response(s) served uncached" << endl
+         << "  D: the reserve was replenished " << d.st.replenished << " time(s)" << endl;
+
+    if (a.failed == 0) {
+        cout << "the limit was never reached: more requests or less headroom" << endl;
+        return 1;
+    }
+    bool ok = b.served == requests && b.st.handlerCalls > 0 && b.st.reclaimedBytes > 0 && b.st.badAllocs == 0;
+    // the soft limit shrinks (or refuses) before the heap runs out
+    ok = ok && c.served == requests && c.st.handlerCalls == 0 && c.peakCache <= headroom / 2;
+    ok = ok && d.served == requests && d.st.reserveReleases > 0 && d.st.replenished > 0;
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. operator new calls the new_handler in a loop: return after
+//    freeing memory and the allocation retries; throw bad_alloc
+//    (or install no handler) to give up.
+// 2. An emergency reserve turns "out of memory" into a state the
+//    program can see and leave: free it, degrade, take it back.
+// 3. Cache shrinkers run on the failing thread, maybe inside new:
+//    never allocate under the cache's lock, and try_lock in the
+//    shrinker instead of waiting.
+// 4. A soft limit is backpressure: refuse growth while there is
+//    still memory, so the hard failure never comes.
+//
+// ⭐ One-Line Interview Answer
+// “Install a new_handler that first asks the registered caches to
+// shrink, then releases a preallocated reserve, and charge cached
+// bytes against a soft limit that refuses growth early — the
+// service sheds memory and keeps serving instead of dying in a
+// catch for bad_alloc.”
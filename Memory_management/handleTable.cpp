@@ -0,0 +1,164 @@
+// ==========================================================
+// TOPIC: Generational Handles — Stale Access Becomes a Check
+// ==========================================================
+//
+// assertionExaple.cpp / DanglingPointerr.txt:
+//
+//     class Game { Player** players; ... Player* GetPlayer(int index); };
+//     Player* opponent = myGame->GetPlayer(1);
+//     ... players[1] deleted elsewhere ...
+//     opponent->...                     // ❌ undefined behaviour
+//
+// ❌ raw Player*: nothing tells a holder the player is gone
+// ❌ weak_ptr<Player>: safe, but a control block per player and
+//    an atomic compare-exchange (plus a shared_ptr copy and
+//    release) on every lock()
+//
+// ✅ HandleTable.h: Game hands out Handle<Player> (index +
+//    generation); players.get(h) is a bounds check and a
+//    generation compare — a removed player is nullptr, even
+//    after its slot was reused by someone new
+//
+// Measured here: 10^6 random lookups among 10^4 players (10%
+// removed), per lookup —
+//   1. raw Player* (unchecked: what the dangling code does)
+//   2. HandleTable::get(handle)
+//   3. weak_ptr<Player>::lock()
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread handleTable.cpp -o handletable
+//
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Benchmarks/MicroBench.h"
+#include "HandleTable.h"
+
+using namespace std;
+
+class Player {
+public:
+    explicit Player(int score = 0) : score(score) {}
+    int score;
+};
+
+// assertionExaple.cpp's Game, holding handles
+class Game {
+public:
+    Handle<Player> AddPlayer(int score) { return players.create(score); }
+    void RemovePlayer(Handle<Player> h) { players.destroy(h); }
+    Player* GetPlayer(Handle<Player> h) { return players.get(h); }   // nullptr once removed
+
+    HandleTable<Player> players;
+};
+
+int main() {
+    constexpr int kPlayers = 10'000;
+    constexpr int kLookups = 1'000'000;
+    bool ok = true;
+
+    // Stale handles are detected, through slot reuse too
+    {
+        Game game;
+        Handle<Player> a = game.AddPlayer(10);
+        Handle<Player> b = game.AddPlayer(20);
+        ok = ok && game.GetPlayer(a)->score == 10 && game.players.size() == 2;
+        game.RemovePlayer(a);
+        Handle<Player> c = game.AddPlayer(30);                       // reuses a's slot
+        ok = ok && c.index == a.index && game.GetPlayer(a) == nullptr && game.GetPlayer(c)->score == 30;
+        ok = ok && !game.players.destroy(a) && game.GetPlayer(Handle<Player>{}) == nullptr;
+        ok = ok && game.GetPlayer(b)->score == 20;
+        try {
+            game.players.at(a);
+            ok = false;
+        } catch (const out_of_range&) {
+        }
+    }
+
+    // Same players three ways
+    mt19937 rng(7);
+    Game game;
+    vector<Handle<Player>> handles;
+    vector<shared_ptr<Player>> owners;
+    vector<weak_ptr<Player>> weaks;
+    vector<unique_ptr<Player>> rawOwners;
+    vector<Player*> raws;
+    for (int i = 0; i < kPlayers; ++i) {
+        handles.push_back(game.AddPlayer(i));
+        owners.push_back(make_shared<Player>(i));
+        weaks.push_back(owners.back());
+        rawOwners.push_back(make_unique<Player>(i));
+        raws.push_back(rawOwners.back().get());
+    }
+    for (int i = 0; i < kPlayers; i += 10) {                         // 10% leave the game
+        game.RemovePlayer(handles[i]);
+        owners[i].reset();
+    }
+    vector<uint32_t> order(kLookups);
+    for (auto& o : order) o = rng() % kPlayers;
+
+    long handleSum = 0, weakSum = 0;
+    int handleStale = 0, weakStale = 0;
+    for (uint32_t i : order) {
+        if (Player* p = game.GetPlayer(handles[i])) handleSum += p->score; else ++handleStale;
+        if (auto p = weaks[i].lock()) weakSum += p->score; else ++weakStale;
+    }
+    ok = ok && handleSum == weakSum && handleStale == weakStale && handleStale > 0;
+
+    thread([] {}).join();          // a threaded program: shared_ptr uses its atomics from here on
+    MicroBench bench("one lookup among 10^4 players");
+    bench
+        .add("raw Player* (unchecked)",
+             [&](uint64_t n) {
+                 long sum = 0;
+                 for (uint64_t k = 0; k < n; ++k) sum += raws[order[k % kLookups]]->score;
+                 doNotOptimize(sum);
+             })
+        .add("HandleTable::get",
+             [&](uint64_t n) {
+                 long sum = 0;
+                 for (uint64_t k = 0; k < n; ++k)
+                     if (Player* p = game.GetPlayer(handles[order[k % kLookups]])) sum += p->score;
+                 doNotOptimize(sum);
+             })
+        .add("weak_ptr::lock", [&](uint64_t n) {
+            long sum = 0;
+            for (uint64_t k = 0; k < n; ++k)
+                if (auto p = weaks[order[k % kLookups]].lock()) sum += p->score;
+            doNotOptimize(sum);
+        });
+    auto r = bench.run();
+
+    cout << "per lookup: raw " << r[0].medianNs << " ns, handle " << r[1].medianNs << " ns, weak_ptr::lock "
+         << r[2].medianNs << " ns; sizeof: Handle " << sizeof(Handle<Player>) << ", weak_ptr " << sizeof(weak_ptr<Player>)
+         << endl;
+    cout << "handle lookup vs weak_ptr::lock: x" << r[2].medianNs / r[1].medianNs << " (reported, not checked)" << endl;
+
+    ok = ok && sizeof(Handle<Player>) == 8;
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. Nulling the owner's pointer after delete does not reach the
+//    copies of it held elsewhere — they still dangle.
+// 2. A generational handle (index + generation) names one
+//    object: reuse of the slot bumps the generation, so old
+//    handles stop matching.
+// 3. Validation is a compare, not an atomic: cheaper than
+//    weak_ptr::lock(), and 8 bytes instead of 16.
+// 4. The table owns every object; holders keep only handles, so
+//    "who deletes it" has a single answer.
+//
+// ⭐ One-Line Interview Answer
+// “Store objects in a slot table and hand out index+generation
+// handles — a stale handle fails a cheap generation check
+// instead of dereferencing freed memory.”
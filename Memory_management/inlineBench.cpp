@@ -0,0 +1,155 @@
+// ==========================================================
+// TOPIC: Measuring inline, LTO and register Instead of Assuming
+// ==========================================================
+//
+// inline.cpp: Fast::SetData / IsEven / Increment, "inlined"
+// because of where `inline` is written.
+// Registervariables.cpp: `for (register int n ...)`, "faster".
+//
+// Both claims are about code generation, so they are measured
+// here with MicroBench.h (warm-up, calibrated samples, median ±
+// MAD, perf counters when the machine has a PMU):
+//
+// Suite "Fast" — the same loop over four definitions of Fast:
+//   1. in-class bodies (implicitly inline, as inline.cpp)
+//   2. __attribute__((noinline)) in this TU   (a forced call)
+//   3. bodies in FastOutOfLine.cpp            (another TU)
+//   4. the loop with the calls' effect written out by hand
+//      (what complete inlining should reduce to)
+//   Build twice and compare row 3: without -flto it is a call
+//   per method; with -flto it matches row 1.
+//
+// Suite "locals" — a running sum kept in
+//   1. an int local
+//   2. a register int local (ignored by optimizing compilers,
+//      removed in C++17; -Wregister warns)
+//   3. a volatile int local (forced to memory: what `register`
+//      was meant to avoid)
+//
+// Build:
+//   g++ -std=c++20 -O2 inlineBench.cpp FastOutOfLine.cpp -o inlinebench
+//   g++ -std=c++20 -O2 -flto inlineBench.cpp FastOutOfLine.cpp -o inlinebench_lto
+//
+#include <cstdint>
+#include <iostream>
+#include "../Benchmarks/MicroBench.h"
+#include "FastOutOfLine.h"
+
+using namespace std;
+
+// inline.cpp's Fast, unchanged
+class Fast {
+private:
+    int data;
+
+public:
+    Fast() { data = 0; }
+    void SetData(int value) { data = value; }
+    inline bool IsEven();
+    void Increment();
+};
+
+bool Fast::IsEven() {
+    return (data % 2 == 0);
+}
+
+inline void Fast::Increment() {
+    data++;
+}
+
+// The same members, but never inlined
+class FastNoInline {
+private:
+    int data;
+
+public:
+    __attribute__((noinline)) FastNoInline() { data = 0; }
+    __attribute__((noinline)) void SetData(int value) { data = value; }
+    __attribute__((noinline)) bool IsEven() { return data % 2 == 0; }
+    __attribute__((noinline)) void Increment() { data++; }
+};
+
+// One iteration: set, test, maybe increment, then make the
+// object observable so the loop cannot be folded away
+template <typename F>
+void fastLoop(uint64_t n) {
+    F f;
+    for (uint64_t i = 0; i < n; ++i) {
+        f.SetData(static_cast<int>(i));
+        if (f.IsEven()) f.Increment();
+        doNotOptimize(f);
+    }
+}
+
+// The sums are kept observable with a register-only barrier:
+// doNotOptimize takes a reference, and a register variable has
+// no address
+#define KEEP_IN_REGISTER(v) asm volatile("" : "+r"(v))
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wregister"
+static void registerLocal(uint64_t n) {
+    register int sum = 0;
+    for (register uint64_t i = 0; i < n; ++i) {
+        sum += static_cast<int>(i);
+        KEEP_IN_REGISTER(sum);
+    }
+}
+#pragma GCC diagnostic pop
+
+int main() {
+    MicroBench fast("Fast: SetData + IsEven + Increment per iteration");
+    fast.add("in-class (implicit inline)", fastLoop<Fast>)
+        .add("noinline, same TU", fastLoop<FastNoInline>)
+        .add("FastOutOfLine.cpp (see -flto)", fastLoop<FastOutOfLine>)
+        .add("hand-inlined", [](uint64_t n) {
+            int data = 0;
+            for (uint64_t i = 0; i < n; ++i) {
+                data = static_cast<int>(i);
+                if (data % 2 == 0) data++;
+                doNotOptimize(data);
+            }
+        });
+    auto fastResults = fast.run();
+    cout << endl;
+
+    MicroBench locals("locals: running sum per iteration");
+    locals
+        .add("int local",
+             [](uint64_t n) {
+                 int sum = 0;
+                 for (uint64_t i = 0; i < n; ++i) {
+                     sum += static_cast<int>(i);
+                     KEEP_IN_REGISTER(sum);
+                 }
+             })
+        .add("register int local", registerLocal)
+        .add("volatile int local (memory)", [](uint64_t n) {
+            volatile int sum = 0;
+            for (uint64_t i = 0; i < n; ++i) sum = sum + static_cast<int>(i);
+        });
+    auto localResults = locals.run();
+
+    // Sanity: a forced call must not come out faster than inlined code
+    bool ok = fastResults[1].medianNs >= fastResults[0].medianNs * 0.8 && localResults[2].medianNs > 0;
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. `inline` is about the one-definition rule; whether a call
+//    is inlined depends on the optimizer seeing the body.
+// 2. A body in another .cpp is invisible to callers unless the
+//    build uses LTO (-flto), which inlines across TUs at link time.
+// 3. `register` has been a no-op for decades and is removed in
+//    C++17; the optimizer already keeps hot locals in registers.
+// 4. Micro-benchmarks need warm-up, repetition, robust statistics
+//    and optimization barriers, or they measure nothing.
+//
+// ⭐ One-Line Interview Answer
+// “Measure it: with warm-up, median of repeated samples and
+// DoNotOptimize barriers, inline vs call and LTO show real
+// differences, and register shows none.”
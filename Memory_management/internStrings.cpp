@@ -0,0 +1,284 @@
+// ==========================================================
+// TOPIC: Interning Repeated Names — 4-Byte Symbols instead of Strings
+// ==========================================================
+//
+// freindExample.cpp / classTemplate.cpp / LockGuard.cpp:
+//
+//     Weapon("Missile", false);          // std::string name per weapon
+//     Box<string> b("hello");            // a copy per box
+//     cout << threadName << ": " ...     // formatted per log line
+//
+// ❌ 10^7 entities with a few thousand distinct names store 10^7
+//    strings: 32 bytes of std::string each, plus a heap block
+//    for every name longer than 15 characters
+// ❌ comparing or hashing a name walks its characters
+//
+// ✅ StringInterner.h: each distinct name stored once in a sharded
+//    arena; entities hold a 32-bit Symbol (integer compare and
+//    hash); lookups of known names take no lock
+//
+// Measured here (`names` entity names drawn, skewed, from
+// `distinct` names of 16-40 characters):
+//   1. resident memory (RSS, measured in a child process per
+//      layout) to hold every entity's name:
+//        vector<string>                       (Weapon::name)
+//        mutex + unordered_set<string>, vector<const string*>
+//        StringInterner, vector<Symbol>
+//   2. ns per intern with `threads` threads: the mutex set vs
+//      StringInterner; and with every name already interned
+//      (the lock-free read path)
+//   3. ns per element to count one name over all entities:
+//      string == vs Symbol ==
+//   4. every Symbol's text round-trips; equal text, equal Symbol
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./interning [names] [distinct] [threads]
+//
+//   names    → entities                       (default 10000000)
+//   distinct → different names among them    (default 100000)
+//   threads  → for part 2                      (default 4)
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread internStrings.cpp -o interning
+//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_set>
+#include <vector>
+#include "../Benchmarks/MicroBench.h"
+#include "StringInterner.h"
+
+using namespace std;
+using namespace std::chrono;
+
+const char* const kAdjectives[] = {"Plasma", "Rusty", "Heavy", "Light", "Ancient", "Gilded", "Frozen", "Burning"};
+const char* const kNouns[] = {"Rifle", "Missile Launcher", "Crossbow", "Cannon", "Halberd", "Railgun", "Mortar",
+                              "Flamethrower"};
+
+// Distinct names: "<adjective> <noun> Mk <n>" (16-40 characters)
+vector<string> dictionary(size_t distinct) {
+    vector<string> d;
+    d.reserve(distinct);
+    for (size_t k = 0; k < distinct; ++k)
+        d.push_back(string(kAdjectives[k % 8]) + " " + kNouns[k / 8 % 8] + " Mk " + to_string(k / 64 + 1) +
+                    (k % 3 == 0 ? " (Prototype)" : ""));
+    return d;
+}
+
+// Entity i's name: skewed towards the first names (a few are very
+// common, most are rare), the same for every run
+size_t nameOf(size_t i, size_t distinct) {
+    uint64_t x = (i + 1) * 0x9E3779B97F4A7C15ull;
+    x ^= x >> 31;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 29;
+    const double u = double(x >> 11) / double(1ull << 53);
+    return min(distinct - 1, size_t(double(distinct) * u * u * u));
+}
+
+size_t rssBytes() {
+    FILE* f = fopen("/proc/self/statm", "r");
+    unsigned long size = 0, resident = 0;
+    if (f) {
+        if (fscanf(f, "%lu %lu", &size, &resident) != 2) resident = 0;
+        fclose(f);
+    }
+    return size_t(resident) * size_t(sysconf(_SC_PAGESIZE));
+}
+
+// Runs `build` in a child; its RSS growth comes back through a pipe.
+// build() returns rssBytes() taken while its containers are still
+// alive (0 if it failed), after passing them to doNotOptimize:
+// otherwise the compiler may drop allocations nothing reads
+template <typename F>
+long childRss(F&& build) {
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        const size_t before = rssBytes();
+        const size_t after = build();
+        const long grown = after ? long(after - before) : -2;
+        if (write(fds[1], &grown, sizeof grown) != ssize_t(sizeof grown)) _exit(1);
+        _exit(0);
+    }
+    close(fds[1]);
+    long grown = -1;
+    if (read(fds[0], &grown, sizeof grown) != ssize_t(sizeof grown)) grown = -1;
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return grown;
+}
+
+// The usual interner: one lock, node-based set
+class LockedInterner {
+public:
+    const string* intern(const string& s) {
+        lock_guard<mutex> lg(m_);
+        return &*set_.insert(s).first;
+    }
+    size_t size() {
+        lock_guard<mutex> lg(m_);
+        return set_.size();
+    }
+
+private:
+    mutex m_;
+    unordered_set<string> set_;
+};
+
+template <typename F>
+double nsPer(size_t n, F&& f) {
+    const auto t0 = steady_clock::now();
+    f();
+    return duration<double, nano>(steady_clock::now() - t0).count() / double(n);
+}
+
+// `threads` threads, each interning a contiguous part of the stream
+template <typename F>
+double parallelNs(size_t n, int threads, F&& body) {
+    return nsPer(n, [&] {
+        vector<thread> ts;
+        for (int t = 0; t < threads; ++t)
+            ts.emplace_back([&, t] { body(n * size_t(t) / size_t(threads), n * size_t(t + 1) / size_t(threads)); });
+        for (auto& t : ts) t.join();
+    });
+}
+
+int main(int argc, char** argv) {
+    const long names = argc > 1 ? atol(argv[1]) : 10000000;
+    const long distinct = argc > 2 ? atol(argv[2]) : 100000;
+    const long threads = argc > 3 ? atol(argv[3]) : 4;
+    if (names < 1 || distinct < 1 || distinct > names || threads < 1 || threads > 64) {
+        cerr << "usage: interning [names >= 1] [distinct 1..names] [threads 1..64]" << endl;
+        return 2;
+    }
+    const size_t n = size_t(names), d = size_t(distinct);
+    const vector<string> dict = dictionary(d);
+    bool ok = true;
+
+    // ---- 1. memory ----
+    cout << n << " names, " << d << " distinct, " << threads << " thread(s) for part 2" << endl << endl;
+    const long rssStrings = childRss([&] {
+        vector<string> v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i) v.push_back(dict[nameOf(i, d)]);
+        doNotOptimize(v.data());
+        clobberMemory();
+        return v.size() == n ? rssBytes() : 0;
+    });
+    const long rssSet = childRss([&] {
+        LockedInterner in;
+        vector<const string*> v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i) v.push_back(in.intern(dict[nameOf(i, d)]));
+        doNotOptimize(v.data());
+        clobberMemory();
+        return v.size() == n ? rssBytes() : 0;
+    });
+    const long rssSymbols = childRss([&] {
+        StringInterner in;
+        vector<Symbol> v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i) v.push_back(in.intern(dict[nameOf(i, d)]));
+        doNotOptimize(v.data());
+        clobberMemory();
+        return v.size() == n ? rssBytes() : 0;
+    });
+    auto mb = [](long b) { return b < 0 ? string("?") : to_string(b >> 20); };
+    cout << "  " << left << setw(52) << "layout" << right << setw(10) << "RSS MB" << setw(12) << "B / name" << endl;
+    auto memRow = [&](const char* name, long b) {
+        cout << "  " << left << setw(52) << name << right << setw(10) << mb(b) << setw(12) << fixed
+             << setprecision(1) << (b < 0 ? 0.0 : double(b) / double(n)) << endl;
+        cout.unsetf(ios::fixed);
+    };
+    memRow("vector<string>                           (Weapon::name)", rssStrings);
+    memRow("mutex + unordered_set<string>, vector<const string*>", rssSet);
+    memRow("StringInterner, vector<Symbol>", rssSymbols);
+    ok = ok && rssSymbols > 0 && rssStrings > 0 && rssSymbols * 2 < rssStrings;
+
+    // ---- 2. intern throughput; 4. round trip ----
+    StringInterner interner;
+    LockedInterner locked;
+    vector<Symbol> syms(n);
+    const double lockedNs = parallelNs(n, int(threads), [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) locked.intern(dict[nameOf(i, d)]);
+    });
+    const double internNs = parallelNs(n, int(threads), [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) syms[i] = interner.intern(dict[nameOf(i, d)]);
+    });
+    atomic<size_t> wrong{0};
+    const double hitNs = parallelNs(n, int(threads), [&](size_t from, size_t to) {
+        size_t bad = 0;
+        for (size_t i = from; i < to; ++i) bad += interner.intern(dict[nameOf(i, d)]) != syms[i];
+        wrong += bad;
+    });
+    const StringInterner::Stats st = interner.stats();
+    size_t used = 0;
+    for (size_t k = 0; k < d; ++k) used += interner.find(dict[k]).valid();
+    for (size_t i = 0; i < n; i += 97) ok = ok && interner.view(syms[i]) == dict[nameOf(i, d)];
+    ok = ok && wrong == 0 && interner.size() == used && locked.size() == used && st.strings == used;
+    cout << endl
+         << "  intern, " << threads << " thread(s):  mutex + unordered_set " << fixed << setprecision(1) << lockedNs
+         << " ns   StringInterner " << internNs << " ns   (all known: " << hitNs << " ns, no lock)" << endl;
+    cout << "  StringInterner: " << st.strings << " strings, " << (st.textBytes >> 10) << " KB of text in "
+         << (st.arenaBytes >> 10) << " KB of arena, tables " << (st.tableBytes >> 10) << " KB (+ "
+         << (st.retiredBytes >> 10) << " KB retired)" << endl;
+
+    // ---- 3. compare ----
+    const string& probeName = dict[0];
+    const Symbol probeSym = interner.find(probeName);
+    vector<string> strs;
+    const size_t cmpN = min<size_t>(n, 2000000);
+    strs.reserve(cmpN);
+    for (size_t i = 0; i < cmpN; ++i) strs.push_back(dict[nameOf(i, d)]);
+    size_t c1 = 0, c2 = 0;
+    const double strNs = nsPer(cmpN, [&] {
+        for (const string& s : strs) c1 += s == probeName;
+    });
+    const double symNs = nsPer(cmpN, [&] {
+        for (size_t i = 0; i < cmpN; ++i) c2 += syms[i] == probeSym;
+    });
+    ok = ok && c1 == c2;
+    cout << "  count \"" << probeName << "\" (" << c1 << " of " << cmpN << "):  string == " << strNs
+         << " ns   Symbol == " << symNs << " ns" << endl;
+    cout.unsetf(ios::fixed);
+
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. Interning stores each distinct string once and hands out a
+//    small id: equality and hashing become integer operations.
+// 2. An arena keeps the bytes: no per-string heap header, and
+//    pointers into it never move (strings are never freed).
+// 3. Reads without locks: publish the bytes, then the slot with
+//    a release store; readers probe with acquire loads.
+// 4. Sharding by hash splits the write lock; a resized table is
+//    kept alive for readers instead of being freed under them.
+//
+// ⭐ One-Line Interview Answer
+// “Store each distinct name once in a sharded arena-backed table and
+// give objects a 32-bit symbol: 4 bytes instead of a 32-byte string
+// plus its heap block, O(1) compare and hash, and lock-free lookups
+// for names that are already there.”
@@ -0,0 +1,229 @@
+// ==========================================================
+// TOPIC: Thread-Caching Allocation for new/delete-Heavy Code
+// ==========================================================
+//
+// poly.cpp / dynamicCast.cpp:
+//
+//     Vehicle* v = new Car();     // glibc malloc: header, arena,
+//     ...                         // tcache bin; a free on another
+//     delete v;                   // thread goes back to the arena
+//
+// malloc_vs_new.txt stops at "new calls malloc". Here the Car
+// hierarchy is routed to ThreadCache (ThreadCache.h) by one base:
+//
+//     class Vehicle : public ThreadCached<Vehicle> { ... };
+//
+// and every `new Car()` / `delete v` — sized, through the
+// virtual destructor — is a pop / push on this thread's free
+// list, refilled from and spilled to a central depot in batches.
+//
+// Measured here, 4 threads, ns per new + delete pair:
+//   1. SAME-THREAD: each thread allocates 256 cars, frees them
+//   2. CROSS-THREAD: 2 threads allocate, hand the pointers over a
+//      locked queue, 2 other threads delete them
+// for glibc malloc (global operator new) and ThreadCache.
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread threadCacheAlloc.cpp ThreadCache.cpp -o threadcache
+//
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "ThreadCache.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// poly.cpp's Vehicle / Car with some state, twice: on the global
+// heap and routed to ThreadCache
+class Vehicle {
+public:
+    virtual void start() { ++starts; }
+    virtual ~Vehicle() {}
+    long starts = 0;
+};
+class Car : public Vehicle {
+public:
+    void start() override final { starts += 2; }
+    double speed = 0, fuel = 0, mileage = 0;
+};
+
+class CachedVehicle : public ThreadCached<CachedVehicle> {
+public:
+    virtual void start() { ++starts; }
+    virtual ~CachedVehicle() {}
+    long starts = 0;
+};
+class CachedCar : public CachedVehicle {
+public:
+    void start() override final { starts += 2; }
+    double speed = 0, fuel = 0, mileage = 0;
+};
+
+constexpr int kThreads = 4;
+constexpr int kBatch = 256;
+constexpr int kRounds = 2000;                    // per thread: 512,000 new + delete
+
+template <typename F>
+double bestOf3Ns(F&& f) {
+    double best = 1e300;
+    for (int rep = 0; rep < 3; ++rep) {
+        auto t0 = steady_clock::now();
+        f();
+        best = min(best, duration<double, nano>(steady_clock::now() - t0).count());
+    }
+    return best;
+}
+
+template <typename Base, typename Derived>
+double sameThread() {
+    auto work = [] {
+        array<Base*, kBatch> cars;
+        for (int r = 0; r < kRounds; ++r) {
+            for (auto& c : cars) c = new Derived();
+            for (auto* c : cars) c->start();
+            for (auto* c : cars) delete c;
+        }
+    };
+    double ns = bestOf3Ns([&] {
+        vector<thread> ts;
+        for (int t = 0; t < kThreads; ++t) ts.emplace_back(work);
+        for (auto& t : ts) t.join();
+    });
+    return ns / (double(kThreads) * kRounds * kBatch);
+}
+
+// A bounded pointer queue, the same for both allocators
+template <typename Base>
+class Handoff {
+public:
+    void push(const array<Base*, kBatch>& batch) {
+        unique_lock<mutex> lk(m_);
+        notFull_.wait(lk, [&] { return items_.size() + kBatch <= kCapacity; });
+        items_.insert(items_.end(), batch.begin(), batch.end());
+        notEmpty_.notify_one();
+    }
+    // false once every producer is done and the queue is drained
+    bool pop(array<Base*, kBatch>& batch) {
+        unique_lock<mutex> lk(m_);
+        notEmpty_.wait(lk, [&] { return items_.size() >= kBatch || producersLeft_ == 0; });
+        if (items_.size() < kBatch) return false;
+        copy(items_.end() - kBatch, items_.end(), batch.begin());
+        items_.resize(items_.size() - kBatch);
+        notFull_.notify_one();
+        return true;
+    }
+    void producerDone() {
+        lock_guard<mutex> lg(m_);
+        if (--producersLeft_ == 0) notEmpty_.notify_all();
+    }
+    explicit Handoff(int producers) : producersLeft_(producers) { items_.reserve(kCapacity); }
+
+private:
+    static constexpr size_t kCapacity = 64 * kBatch;
+    mutex m_;
+    condition_variable notEmpty_, notFull_;
+    vector<Base*> items_;
+    int producersLeft_;
+};
+
+template <typename Base, typename Derived>
+double crossThread() {
+    double ns = bestOf3Ns([] {
+        Handoff<Base> q(kThreads / 2);
+        vector<thread> ts;
+        for (int t = 0; t < kThreads / 2; ++t)
+            ts.emplace_back([&] {
+                array<Base*, kBatch> cars;
+                for (int r = 0; r < kRounds; ++r) {
+                    for (auto& c : cars) c = new Derived();
+                    q.push(cars);
+                }
+                q.producerDone();
+            });
+        for (int t = 0; t < kThreads / 2; ++t)
+            ts.emplace_back([&] {
+                array<Base*, kBatch> cars;
+                while (q.pop(cars))
+                    for (auto* c : cars) {
+                        c->start();
+                        delete c;
+                    }
+            });
+        for (auto& t : ts) t.join();
+    });
+    return ns / (double(kThreads / 2) * kRounds * kBatch);
+}
+
+int main() {
+    bool ok = true;
+
+    // Routing, sizes and the large-block fallback
+    ok = ok && ThreadCache::classSize(sizeof(CachedCar)) == 48 && ThreadCache::classSize(1025) == 0;
+    {
+        set<void*> seen;
+        vector<CachedVehicle*> cars;
+        for (int i = 0; i < 1000; ++i) {
+            cars.push_back(new CachedCar());
+            ok = ok && seen.insert(cars.back()).second && uintptr_t(cars.back()) % alignof(CachedCar) == 0;
+        }
+        for (auto* c : cars) c->start();
+        for (auto* c : cars) ok = ok && c->starts == 2;
+        for (auto* c : cars) delete c;
+        CachedCar* fleet = new CachedCar[40];                       // > 1024 bytes: malloc path
+        fleet[39].start();
+        ok = ok && fleet[39].starts == 2;
+        delete[] fleet;
+        CachedCar* few = new CachedCar[4];
+        delete[] few;
+    }
+
+    double mallocSame = sameThread<Vehicle, Car>();
+    double cacheSame = sameThread<CachedVehicle, CachedCar>();
+    double mallocCross = crossThread<Vehicle, Car>();
+    ThreadCache::Stats before = ThreadCache::stats();
+    double cacheCross = crossThread<CachedVehicle, CachedCar>();
+    ThreadCache::Stats after = ThreadCache::stats();
+
+    cout << kThreads << " threads on " << thread::hardware_concurrency() << " CPU(s), ns per new + delete of a "
+         << sizeof(Car) << "-byte Car:" << endl;
+    cout << "  same-thread : glibc malloc " << mallocSame << ", ThreadCache " << cacheSame << endl;
+    cout << "  cross-thread: glibc malloc " << mallocCross << ", ThreadCache " << cacheCross
+         << "  (queue handoff included in both)" << endl;
+    cout << "ThreadCache depot: " << after.slabs << " slabs, cross-thread run moved "
+         << after.batchesReturned - before.batchesReturned << " batches back and "
+         << after.batchesFetched - before.batchesFetched << " out" << endl;
+
+    // Cross-thread frees must flow back: the depot is refilled,
+    // not the slab count grown per batch
+    ok = ok && after.batchesReturned > before.batchesReturned && after.slabs < 64;
+    ok = ok && cacheSame < mallocSame;
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A per-thread free list per size class makes new/delete a
+//    pop/push: no lock, no atomic, no per-block header.
+// 2. Lists exchange BATCHES with a central depot, so the lock
+//    is taken once per ~B operations, not per block.
+// 3. Cross-thread frees fill the freeing thread's list; capping
+//    the list and spilling batches is what returns that memory
+//    to the producers.
+// 4. A class-level operator new/delete (via a base class) routes
+//    a whole hierarchy; sized delete means no size lookup.
+//
+// ⭐ One-Line Interview Answer
+// “Give each thread size-class free lists refilled and drained
+// in batches through a central depot — most new/delete calls
+// never touch a lock or an atomic.”
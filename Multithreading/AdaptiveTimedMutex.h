@@ -0,0 +1,175 @@
+// ======================================================
+// AdaptiveTimedMutex.h — Spin-then-park timed lock
+// ======================================================
+//
+// std::timed_mutex::try_lock_for() goes to the KERNEL with a
+// timeout as soon as the lock is busy. For a critical section
+// that lasts ~100ns that is far more expensive than simply
+// waiting for the owner to finish.
+//
+// STRATEGY:
+// 1. try once (uncontended fast path: one CAS)
+// 2. SPIN with exponential backoff (1, 2, 4 ... 64 pauses)
+//    for a budget that LEARNS from recent hold times:
+//        budget ≈ 2 × moving average of hold time
+//    (short holds → spin, long holds → park quickly)
+// 3. PARK in the kernel (Linux futex with timeout; portable
+//    short sleeps elsewhere) until unlock or the deadline
+//
+// STATE (classic futex mutex):
+//   0 = unlocked, 1 = locked, 2 = locked AND someone parked
+//
+// Satisfies TimedLockable: lock, try_lock, try_lock_for,
+// try_lock_until, unlock → works with unique_lock.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ADAPTIVE_PAUSE() _mm_pause()
+#elif defined(__aarch64__)
+#define ADAPTIVE_PAUSE() asm volatile("yield")
+#else
+#define ADAPTIVE_PAUSE() ((void)0)
+#endif
+
+class AdaptiveTimedMutex {
+public:
+    using clock = std::chrono::steady_clock;
+
+    AdaptiveTimedMutex() = default;
+    AdaptiveTimedMutex(const AdaptiveTimedMutex&) = delete;
+    AdaptiveTimedMutex& operator=(const AdaptiveTimedMutex&) = delete;
+
+    bool try_lock() {
+        std::uint32_t expected = 0;
+        if (state_.compare_exchange_strong(expected, 1, std::memory_order_acquire)) {
+            startHold();
+            return true;
+        }
+        return false;
+    }
+
+    void lock() { acquire(clock::time_point::max()); }
+
+    template <class Rep, class Period>
+    bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout) {
+        return try_lock_until(clock::now() + timeout);
+    }
+
+    template <class Clock, class Duration>
+    bool try_lock_until(const std::chrono::time_point<Clock, Duration>& deadline) {
+        if constexpr (std::is_same_v<Clock, clock>) {
+            return acquire(std::chrono::time_point_cast<clock::duration>(deadline));
+        } else {
+            // Foreign clock: convert once to steady_clock
+            return acquire(clock::now() + (deadline - Clock::now()));
+        }
+    }
+
+    void unlock() {
+        if (sampled_) learnHoldTime();
+        if (state_.exchange(0, std::memory_order_release) == 2) wake();
+    }
+
+    // Current learned spin budget (for diagnostics)
+    std::chrono::nanoseconds spinBudget() const {
+        return std::chrono::nanoseconds(spinBudgetNs());
+    }
+
+private:
+    static constexpr std::int64_t kMinSpinNs = 200;
+    static constexpr std::int64_t kMaxSpinNs = 50000;
+
+    std::int64_t spinBudgetNs() const {
+        std::int64_t avg = avgHoldNs_.load(std::memory_order_relaxed);
+        return std::clamp<std::int64_t>(2 * avg, kMinSpinNs, kMaxSpinNs);
+    }
+
+    // Exponential moving average: avg += (sample - avg) / 8
+    void learnHoldTime() {
+        std::int64_t sample = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  clock::now() - holdStart_).count();
+        std::int64_t avg = avgHoldNs_.load(std::memory_order_relaxed);
+        avgHoldNs_.store(avg + (sample - avg) / 8, std::memory_order_relaxed);
+    }
+
+    bool acquire(clock::time_point deadline) {
+        if (try_lock()) return true;
+
+        // ---- Phase 1: bounded, adaptive spinning ----
+        auto spinEnd = clock::now() + std::chrono::nanoseconds(spinBudgetNs());
+        if (spinEnd > deadline) spinEnd = deadline;
+        unsigned backoff = 1;
+        // Spinning on one CPU only delays the owner → skip it
+        static const bool multiCore = std::thread::hardware_concurrency() > 1;
+        if (multiCore) {
+            while (clock::now() < spinEnd) {
+                for (unsigned i = 0; i < backoff; ++i) ADAPTIVE_PAUSE();
+                if (state_.load(std::memory_order_relaxed) == 0 && try_lock()) return true;
+                backoff = std::min(backoff * 2, 64u);
+            }
+        }
+
+        // ---- Phase 2: park until unlock or deadline ----
+        // Announce a waiter by moving the state to 2
+        std::uint32_t s = state_.exchange(2, std::memory_order_acquire);
+        while (s != 0) {
+            auto now = clock::now();
+            if (now >= deadline) return false;   // state may stay 2: harmless extra wake
+            park(deadline - now);
+            s = state_.exchange(2, std::memory_order_acquire);
+        }
+        startHold();
+        return true;
+    }
+
+    // Only every 16th acquisition is timed: keeps clock::now()
+    // off the fast path while still tracking the hold time
+    void startHold() {
+        sampled_ = (++acquisitions_ & 15) == 0;
+        if (sampled_) holdStart_ = clock::now();
+    }
+
+    void park(clock::duration remaining) {
+#if defined(__linux__)
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+        timespec ts;
+        ts.tv_sec = (time_t)(ns / 1000000000);
+        ts.tv_nsec = (long)(ns % 1000000000);
+        // Sleeps only while state_ is still 2; relative timeout
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_), FUTEX_WAIT_PRIVATE, 2, &ts,
+                nullptr, 0);
+#else
+        std::this_thread::sleep_for(std::min<clock::duration>(remaining, std::chrono::microseconds(50)));
+#endif
+    }
+
+    void wake() {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_), FUTEX_WAKE_PRIVATE, 1,
+                nullptr, nullptr, 0);
+#endif
+    }
+
+    std::atomic<std::uint32_t> state_{0};
+    std::atomic<std::int64_t> avgHoldNs_{0};
+    // Written only by the current holder
+    clock::time_point holdStart_{};
+    std::uint32_t acquisitions_ = 0;
+    bool sampled_ = false;
+};
@@ -0,0 +1,760 @@
+// ======================================================
+// AsyncFile.h — completion-based file writes: io_uring (Linux), overlapped + IOCP (Win32)
+// ======================================================
+//
+// AsyncLogger.h's flusher and snapshot::Writer (Polymorphism/
+// Snapshot.h) end in
+//
+//     ::write(fd_, p, left);                 // one system call per batch, and it blocks
+//     std::fwrite(p, 1, n, out);             // the same, behind stdio
+//
+// so the thread that writes waits for the kernel to copy every
+// batch, one call at a time. AsyncFile queues writes and hears
+// about them when they are done:
+//
+//     AsyncFile log("app.log");                       // io_uring on Linux, IOCP on Win32
+//     int b = log.tryAcquireBuffer();                // a registered buffer (or -1: all in flight)
+//     std::size_t n = format(log.bufferData(b), log.bufferBytes());
+//     log.tryAppend(b, n, completion);               // queued; not in the kernel yet
+//     ... more writes ...
+//     log.submit();                                  // ONE system call for all of them
+//     log.reap(true);                                // completion.done(completion, bytes or -errno)
+//
+// BACKENDS:
+//   Linux   io_uring through its raw system calls (no liburing):
+//           writes queued in the submission ring go to the kernel
+//           in one io_uring_enter; reap(true) submits what is
+//           queued and waits in the SAME call. Buffers are
+//           registered once (IORING_REGISTER_BUFFERS) and written
+//           with WRITE_FIXED: no page pinning per write
+//   Win32   overlapped WriteFile on a FILE_FLAG_OVERLAPPED handle,
+//           completions from an I/O completion port in batches
+//           (GetQueuedCompletionStatusEx); the kernel has no
+//           batched submission, so submit() issues one WriteFile
+//           per queued write
+//   other   (or io_uring unavailable, e.g. blocked by seccomp, or
+//           Options::forceBlocking): pwrite in submit(), so the
+//           same code still runs — synchronously
+//
+// - writes are positional: tryAppend assigns the next offset when
+//   the write is QUEUED, so appends land in queue order however
+//   the kernel completes them; tryWriteAt writes anywhere
+//   (snapshot sections)
+// - at most queueDepth writes are queued or in flight; the try*
+//   calls return false beyond that (reap to make room)
+// - a short write is resubmitted for the rest; `done` runs once,
+//   with the full length or the first error
+// - a registered buffer returns to the free list when its write
+//   completes, just before `done` runs
+// - any thread may queue and submit (one mutex); ONE thread at a
+//   time reaps, and `done` runs on it, outside the lock — it may
+//   queue the next write
+//
+// Adapters:
+//   PoolFileWriter  (here)            callbacks on a ThreadPool
+//   LoopFile        (AsyncFileLoop.h) co_await on the EventLoop
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "ThreadPool.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+class AsyncFile {
+public:
+    enum class Backend { IoUring, Overlapped, Blocking };
+
+    struct Options {
+        unsigned queueDepth = 32;           // writes queued or in flight, at most
+        unsigned buffers = 16;              // registered buffers (0: none)
+        std::size_t bufferBytes = 256 * 1024;
+        bool truncate = true;
+        bool forceBlocking = false;         // pwrite backend even where io_uring exists
+    };
+
+    // Embed it in the caller's state. result: bytes written, or
+    // -errno (Win32: -GetLastError())
+    struct Completion {
+        void (*done)(Completion&, long result) = nullptr;
+    };
+
+    struct Stats {
+        std::uint64_t writes = 0;           // completed writes (no-ops not counted)
+        std::uint64_t bytes = 0;
+        std::uint64_t syscalls = 0;         // io_uring_enter / WriteFile + GetQueuedCompletionStatusEx / pwrite
+    };
+
+    // Throws std::system_error if the file cannot be opened
+    explicit AsyncFile(const std::string& path) : AsyncFile(path, Options{}) {}
+
+    AsyncFile(const std::string& path, Options opt) : opt_(opt) {
+        if (opt_.queueDepth == 0) throw std::invalid_argument("AsyncFile: queueDepth must be at least 1");
+        if (opt_.buffers && opt_.bufferBytes == 0) throw std::invalid_argument("AsyncFile: bufferBytes is 0");
+        reqs_.resize(opt_.queueDepth);
+        for (unsigned i = opt_.queueDepth; i-- > 0;) freeSlots_.push_back(i);
+        openFile(path);
+        allocateBuffers();
+        startBackend();
+    }
+
+    AsyncFile(const AsyncFile&) = delete;
+    AsyncFile& operator=(const AsyncFile&) = delete;
+
+    // Waits for every write (their `done` runs here), then closes
+    ~AsyncFile() {
+        while (inFlight() > 0) reap(true);
+        stopBackend();
+        closeFile();
+        freeBuffers();
+    }
+
+    Backend backend() const { return backend_; }
+    bool buffersRegistered() const { return registered_; }
+
+    // ---------------- registered buffers ----------------
+
+    std::size_t bufferBytes() const { return opt_.bufferBytes; }
+    char* bufferData(int b) { return buffers_ + std::size_t(b) * opt_.bufferBytes; }
+
+    // A free buffer's index, or -1 if all are in use
+    int tryAcquireBuffer() {
+        std::lock_guard<std::mutex> lg(m_);
+        if (freeBuffers_.empty()) return -1;
+        int b = freeBuffers_.back();
+        freeBuffers_.pop_back();
+        return b;
+    }
+
+    // Only for a buffer that was not written after all
+    void releaseBuffer(int b) {
+        std::lock_guard<std::mutex> lg(m_);
+        freeBuffers_.push_back(b);
+    }
+
+    // ---------------- queueing (any thread) ----------------
+
+    // len bytes of buffer b at the end of the file
+    bool tryAppend(int b, std::size_t len, Completion& c) {
+        if (len > opt_.bufferBytes) throw std::invalid_argument("AsyncFile: longer than the buffer");
+        return queue(Op::Write, bufferData(b), len, kAppend, b, c);
+    }
+
+    // Any memory, valid until `done` runs
+    bool tryAppend(const void* data, std::size_t len, Completion& c) {
+        return queue(Op::Write, data, len, kAppend, -1, c);
+    }
+    bool tryWriteAt(const void* data, std::size_t len, std::uint64_t offset, Completion& c) {
+        return queue(Op::Write, data, len, offset, -1, c);
+    }
+
+    // Completes without I/O: wakes a thread waiting in reap(true)
+    bool tryNop(Completion& c) { return queue(Op::Nop, nullptr, 0, 0, -1, c); }
+
+    // Everything queued → the kernel
+    void submit() {
+        std::unique_lock<std::mutex> lk(m_);
+        submitLocked(lk);
+    }
+
+    // ---------------- completions (one thread at a time) ----------------
+
+    // Submits what is queued, runs the completions that are ready;
+    // wait: blocks for at least `atLeast` of them (capped at what is
+    // in flight; Win32: at least one). Returns how many completed.
+    std::size_t reap(bool wait, unsigned atLeast = 1) {
+        std::vector<Finished> done;
+        {
+            std::unique_lock<std::mutex> lk(m_);
+            const unsigned inFlight = opt_.queueDepth - unsigned(freeSlots_.size());
+            collect(lk, wait ? std::min(std::max(atLeast, 1u), inFlight) : 0u, done);
+        }
+        for (Finished& f : done) f.c->done(*f.c, f.result);
+        return done.size();
+    }
+
+    // Single-threaded use: until nothing is queued or in flight
+    void drain() {
+        while (inFlight() > 0) reap(true, opt_.queueDepth);
+    }
+
+    // Queued + in the kernel
+    std::size_t inFlight() const {
+        std::lock_guard<std::mutex> lg(m_);
+        return opt_.queueDepth - freeSlots_.size();
+    }
+
+    // The offset the next append gets
+    std::uint64_t appendOffset() const {
+        std::lock_guard<std::mutex> lg(m_);
+        return appendAt_;
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lg(m_);
+        return stats_;
+    }
+
+    // Readable (eventfd counter) whenever completions are posted;
+    // io_uring only, -1 otherwise. Registered on the first call.
+    int completionFd() {
+#ifdef __linux__
+        std::lock_guard<std::mutex> lg(m_);
+        if (backend_ != Backend::IoUring) return -1;
+        if (eventFd_ < 0) {
+            int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (fd < 0) throw std::system_error(errno, std::generic_category(), "AsyncFile: eventfd");
+            if (sysRegister(IORING_REGISTER_EVENTFD, &fd, 1) < 0) {
+                int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), "AsyncFile: IORING_REGISTER_EVENTFD");
+            }
+            eventFd_ = fd;
+        }
+        return eventFd_;
+#else
+        return -1;
+#endif
+    }
+
+private:
+    static constexpr std::uint64_t kAppend = ~std::uint64_t(0);
+    static constexpr std::size_t kMaxChunk = std::size_t(1) << 30;     // per request (Win32 DWORD, Linux 2 GB cap)
+
+    enum class Op { Write, Nop };
+
+    struct Request {
+#ifdef _WIN32
+        OVERLAPPED ov;                      // first: completions point here
+#endif
+        Completion* c = nullptr;
+        Op op = Op::Write;
+        const char* data = nullptr;
+        std::size_t left = 0;               // still to write
+        std::size_t total = 0;
+        std::uint64_t offset = 0;
+        int buffer = -1;
+        long result = 0;                    // Blocking / failed-issue result
+    };
+
+    struct Finished {
+        Completion* c;
+        long result;
+    };
+
+    bool queue(Op op, const void* data, std::size_t len, std::uint64_t offset, int buffer, Completion& c) {
+        if (!c.done) throw std::invalid_argument("AsyncFile: completion without a done function");
+        std::lock_guard<std::mutex> lg(m_);
+        if (freeSlots_.empty()) return false;
+        const unsigned s = freeSlots_.back();
+        freeSlots_.pop_back();
+        Request& r = reqs_[s];
+        r.c = &c;
+        r.op = op;
+        r.data = static_cast<const char*>(data);
+        r.left = r.total = len;
+        r.buffer = buffer;
+        r.result = 0;
+        if (offset == kAppend) {
+            r.offset = appendAt_;
+            appendAt_ += len;
+        } else {
+            r.offset = offset;
+        }
+        queued_.push_back(s);
+        return true;
+    }
+
+    // A write (or part of one) finished with `res`; true when the
+    // request is complete, false if the rest was queued again
+    bool advance(Request& r, long res) {
+        if (r.op == Op::Nop || res < 0 || r.result < 0) return true;
+        if (res == 0 && r.left > 0) {
+            r.result = -EIO;                // no progress: report instead of spinning
+            return true;
+        }
+        std::size_t n = std::min(static_cast<std::size_t>(res), r.left);
+        r.data += n;
+        r.offset += n;
+        r.left -= n;
+        return r.left == 0;
+    }
+
+    void finish(unsigned s, long res, std::vector<Finished>& out) {
+        Request& r = reqs_[s];
+        if (r.op == Op::Write) {
+            if (res >= 0 && r.result == 0) {
+                ++stats_.writes;
+                stats_.bytes += r.total;
+            }
+            if (r.buffer >= 0) freeBuffers_.push_back(r.buffer);
+        }
+        long result = r.result < 0 ? r.result : res < 0 ? res : static_cast<long>(r.total);
+        if (r.op == Op::Nop) result = 0;
+        out.push_back({r.c, result});
+        freeSlots_.push_back(s);
+    }
+
+    // ---------------- files and buffers ----------------
+
+#ifdef _WIN32
+    void openFile(const std::string& path) {
+        file_ = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                            opt_.truncate ? CREATE_ALWAYS : OPEN_ALWAYS,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE)
+            throw std::system_error(int(GetLastError()), std::system_category(), path);
+        LARGE_INTEGER size{};
+        if (!opt_.truncate && GetFileSizeEx(file_, &size)) appendAt_ = std::uint64_t(size.QuadPart);
+    }
+    void closeFile() { CloseHandle(file_); }
+#else
+    void openFile(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (opt_.truncate ? O_TRUNC : 0), 0644);
+        if (fd_ < 0) throw std::system_error(errno, std::generic_category(), path);
+        if (!opt_.truncate) {
+            off_t end = ::lseek(fd_, 0, SEEK_END);
+            if (end > 0) appendAt_ = std::uint64_t(end);
+        }
+    }
+    void closeFile() { ::close(fd_); }
+#endif
+
+    // One page-aligned block, split into `buffers` buffers
+    void allocateBuffers() {
+        if (opt_.buffers == 0) return;
+        const std::size_t bytes = (std::size_t(opt_.buffers) * opt_.bufferBytes + 4095) / 4096 * 4096;
+#ifdef _WIN32
+        buffers_ = static_cast<char*>(_aligned_malloc(bytes, 4096));
+#else
+        buffers_ = static_cast<char*>(std::aligned_alloc(4096, bytes));
+#endif
+        if (!buffers_) throw std::bad_alloc();
+        for (int b = int(opt_.buffers); b-- > 0;) freeBuffers_.push_back(b);
+    }
+    void freeBuffers() {
+#ifdef _WIN32
+        _aligned_free(buffers_);
+#else
+        std::free(buffers_);
+#endif
+    }
+
+    // ---------------- backends ----------------
+
+#ifdef _WIN32
+    void startBackend() {
+        port_ = CreateIoCompletionPort(file_, nullptr, 0, 1);
+        if (!port_) {
+            int err = int(GetLastError());
+            CloseHandle(file_);
+            freeBuffers();
+            throw std::system_error(err, std::system_category(), "AsyncFile: CreateIoCompletionPort");
+        }
+        backend_ = Backend::Overlapped;     // buffers are plain memory: IOCP has no registration
+    }
+    void stopBackend() { CloseHandle(port_); }
+
+    void submitLocked(std::unique_lock<std::mutex>&) {
+        for (unsigned s : queued_) {
+            Request& r = reqs_[s];
+            std::memset(&r.ov, 0, sizeof r.ov);
+            if (r.op == Op::Nop) {
+                PostQueuedCompletionStatus(port_, 0, 0, &r.ov);
+                ++stats_.syscalls;
+                continue;
+            }
+            r.ov.Offset = DWORD(r.offset);
+            r.ov.OffsetHigh = DWORD(r.offset >> 32);
+            const DWORD n = DWORD(std::min(r.left, kMaxChunk));
+            ++stats_.syscalls;
+            // A synchronous success still queues a completion packet
+            if (!WriteFile(file_, r.data, n, nullptr, &r.ov) && GetLastError() != ERROR_IO_PENDING) {
+                r.result = -long(GetLastError());
+                PostQueuedCompletionStatus(port_, 0, 0, &r.ov);
+            }
+        }
+        queued_.clear();
+    }
+
+    void collect(std::unique_lock<std::mutex>& lk, unsigned waitFor, std::vector<Finished>& out) {
+        submitLocked(lk);
+        const bool block = waitFor > 0;
+        lk.unlock();
+        OVERLAPPED_ENTRY entries[64];
+        ULONG n = 0;
+        const BOOL got = GetQueuedCompletionStatusEx(port_, entries, 64, &n, block ? INFINITE : 0, FALSE);
+        lk.lock();
+        ++stats_.syscalls;
+        if (!got) return;
+        for (ULONG i = 0; i < n; ++i) {
+            Request& r = *reinterpret_cast<Request*>(entries[i].lpOverlapped);
+            const unsigned s = unsigned(&r - reqs_.data());
+            long res = long(entries[i].dwNumberOfBytesTransferred);
+            DWORD bytes = 0;
+            if (r.op == Op::Write && r.result == 0 && !GetOverlappedResult(file_, &r.ov, &bytes, FALSE))
+                res = -long(GetLastError());
+            if (advance(r, res)) finish(s, res, out);
+            else queued_.push_back(s);
+        }
+        if (!queued_.empty()) submitLocked(lk);
+    }
+#else
+    // pwrite in submit(): the completions wait in ready_ for reap()
+    void submitBlocking() {
+        for (unsigned s : queued_) {
+            Request& r = reqs_[s];
+            while (r.op == Op::Write && r.left > 0) {
+                const ssize_t w = ::pwrite(fd_, r.data, std::min(r.left, kMaxChunk), off_t(r.offset));
+                ++stats_.syscalls;
+                if (w < 0 && errno == EINTR) continue;
+                if (w <= 0) {
+                    r.result = w < 0 ? -errno : -EIO;
+                    break;
+                }
+                advance(r, long(w));
+            }
+            ready_.push_back(s);
+        }
+        queued_.clear();
+    }
+
+#ifdef __linux__
+    static int sysSetup(unsigned entries, io_uring_params* p) {
+        return int(::syscall(__NR_io_uring_setup, entries, p));
+    }
+    int sysEnter(unsigned toSubmit, unsigned minComplete, unsigned flags) {
+        return int(::syscall(__NR_io_uring_enter, ring_.fd, toSubmit, minComplete, flags, nullptr, 0));
+    }
+    int sysRegister(unsigned op, void* arg, unsigned n) {
+        return int(::syscall(__NR_io_uring_register, ring_.fd, op, arg, n));
+    }
+
+    struct Ring {
+        int fd = -1;
+        void* sq = MAP_FAILED;
+        void* cq = MAP_FAILED;
+        std::size_t sqBytes = 0, cqBytes = 0, sqeBytes = 0;
+        io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        unsigned *sqHead = nullptr, *sqTail = nullptr, *sqArray = nullptr;
+        unsigned *cqHead = nullptr, *cqTail = nullptr;
+        io_uring_cqe* cqes = nullptr;
+        unsigned sqMask = 0, cqMask = 0, sqEntries = 0;
+        unsigned unsubmitted = 0;           // published in the SQ, not yet taken by the kernel
+    };
+
+    void startBackend() {
+        if (opt_.forceBlocking || !setupRing()) {
+            teardownRing();
+            backend_ = Backend::Blocking;
+            return;
+        }
+        backend_ = Backend::IoUring;
+        if (opt_.buffers) {
+            std::vector<iovec> iov(opt_.buffers);
+            for (unsigned b = 0; b < opt_.buffers; ++b) iov[b] = {bufferData(int(b)), opt_.bufferBytes};
+            // May fail (RLIMIT_MEMLOCK): then the buffers are written with plain WRITE
+            registered_ = sysRegister(IORING_REGISTER_BUFFERS, iov.data(), opt_.buffers) == 0;
+        }
+    }
+
+    bool setupRing() {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof p);
+        ring_.fd = sysSetup(opt_.queueDepth, &p);
+        if (ring_.fd < 0) return false;
+        ring_.sqBytes = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        ring_.cqBytes = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) ring_.sqBytes = ring_.cqBytes = std::max(ring_.sqBytes, ring_.cqBytes);
+        ring_.sq = ::mmap(nullptr, ring_.sqBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_.fd,
+                          IORING_OFF_SQ_RING);
+        if (ring_.sq == MAP_FAILED) return false;
+        ring_.cq = single ? ring_.sq
+                          : ::mmap(nullptr, ring_.cqBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                   ring_.fd, IORING_OFF_CQ_RING);
+        if (ring_.cq == MAP_FAILED) return false;
+        ring_.sqeBytes = p.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, ring_.sqeBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_.fd,
+                            IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return false;
+        ring_.sqes = static_cast<io_uring_sqe*>(sqes);
+
+        char* sq = static_cast<char*>(ring_.sq);
+        char* cq = static_cast<char*>(ring_.cq);
+        ring_.sqHead = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+        ring_.sqTail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        ring_.sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        ring_.sqMask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        ring_.sqEntries = p.sq_entries;
+        ring_.cqHead = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        ring_.cqTail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        ring_.cqMask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        ring_.cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    void teardownRing() {
+        if (ring_.sqes != MAP_FAILED) ::munmap(ring_.sqes, ring_.sqeBytes);
+        if (ring_.cq != MAP_FAILED && ring_.cq != ring_.sq) ::munmap(ring_.cq, ring_.cqBytes);
+        if (ring_.sq != MAP_FAILED) ::munmap(ring_.sq, ring_.sqBytes);
+        if (ring_.fd >= 0) ::close(ring_.fd);
+        ring_ = Ring{};
+    }
+
+    void stopBackend() {
+        if (eventFd_ >= 0) ::close(eventFd_);
+        teardownRing();                     // closing the ring drops the buffer registration
+    }
+
+    // Queued requests → SQEs, published with one release store
+    void fillSq() {
+        unsigned tail = *ring_.sqTail;
+        const unsigned head = __atomic_load_n(ring_.sqHead, __ATOMIC_ACQUIRE);
+        std::size_t used = 0;
+        for (; used < queued_.size() && tail - head < ring_.sqEntries; ++used, ++tail) {
+            const unsigned s = queued_[used];
+            const Request& r = reqs_[s];
+            const unsigned idx = tail & ring_.sqMask;
+            io_uring_sqe& e = ring_.sqes[idx];
+            std::memset(&e, 0, sizeof e);
+            e.user_data = s;
+            if (r.op == Op::Nop) {
+                e.opcode = IORING_OP_NOP;
+            } else {
+                e.fd = fd_;
+                e.addr = reinterpret_cast<std::uint64_t>(r.data);
+                e.len = unsigned(std::min(r.left, kMaxChunk));
+                e.off = r.offset;
+                if (registered_ && r.buffer >= 0) {
+                    e.opcode = IORING_OP_WRITE_FIXED;
+                    e.buf_index = static_cast<std::uint16_t>(r.buffer);
+                } else {
+                    e.opcode = IORING_OP_WRITE;
+                }
+            }
+            ring_.sqArray[idx] = idx;
+        }
+        __atomic_store_n(ring_.sqTail, tail, __ATOMIC_RELEASE);
+        ring_.unsubmitted += unsigned(used);
+        queued_.erase(queued_.begin(), queued_.begin() + std::ptrdiff_t(used));
+    }
+
+    // One io_uring_enter: submit, and (minComplete > 0) wait. The
+    // lock is dropped for a wait, so submitters are not held up
+    void enter(std::unique_lock<std::mutex>& lk, unsigned minComplete) {
+        fillSq();
+        const unsigned n = ring_.unsubmitted;
+        if (n == 0 && minComplete == 0) return;
+        if (minComplete) lk.unlock();
+        int r;
+        do r = sysEnter(n, minComplete, minComplete ? IORING_ENTER_GETEVENTS : 0);
+        while (r < 0 && errno == EINTR && minComplete == 0);
+        const int err = errno;
+        if (minComplete) lk.lock();
+        ++stats_.syscalls;
+        if (r >= 0) ring_.unsubmitted -= std::min(unsigned(r), ring_.unsubmitted);
+        else if (err != EINTR && err != EAGAIN && err != EBUSY)
+            throw std::system_error(err, std::generic_category(), "AsyncFile: io_uring_enter");
+    }
+
+    void submitLocked(std::unique_lock<std::mutex>& lk) {
+        if (backend_ == Backend::Blocking) submitBlocking();
+        else enter(lk, 0);
+    }
+
+    unsigned cqReady() const { return __atomic_load_n(ring_.cqTail, __ATOMIC_ACQUIRE) - *ring_.cqHead; }
+
+    void collect(std::unique_lock<std::mutex>& lk, unsigned waitFor, std::vector<Finished>& out) {
+        if (backend_ == Backend::Blocking) {
+            submitBlocking();
+            for (unsigned s : ready_) finish(s, 0, out);
+            ready_.clear();
+            return;
+        }
+        if (waitFor > cqReady()) enter(lk, waitFor);         // the queued ones go in with the wait
+        else submitLocked(lk);
+        for (;;) {
+            unsigned head = *ring_.cqHead;
+            const unsigned tail = __atomic_load_n(ring_.cqTail, __ATOMIC_ACQUIRE);
+            if (head == tail) break;
+            for (; head != tail; ++head) {
+                const io_uring_cqe& e = ring_.cqes[head & ring_.cqMask];
+                const unsigned s = unsigned(e.user_data);
+                if (advance(reqs_[s], long(e.res))) finish(s, long(e.res), out);
+                else queued_.push_back(s);
+            }
+            __atomic_store_n(ring_.cqHead, head, __ATOMIC_RELEASE);
+        }
+        if (!queued_.empty()) submitLocked(lk);      // rests of short writes
+    }
+#else
+    void startBackend() { backend_ = Backend::Blocking; }
+    void stopBackend() {}
+    void submitLocked(std::unique_lock<std::mutex>&) { submitBlocking(); }
+    void collect(std::unique_lock<std::mutex>&, unsigned, std::vector<Finished>& out) {
+        submitBlocking();
+        for (unsigned s : ready_) finish(s, 0, out);
+        ready_.clear();
+    }
+#endif
+#endif
+
+    Options opt_;
+    Backend backend_ = Backend::Blocking;
+    bool registered_ = false;
+    mutable std::mutex m_;
+    std::vector<Request> reqs_;
+    std::vector<unsigned> freeSlots_;
+    std::vector<unsigned> queued_;          // not yet handed to the kernel
+    std::vector<int> freeBuffers_;
+    char* buffers_ = nullptr;
+    std::uint64_t appendAt_ = 0;
+    Stats stats_;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE port_ = nullptr;
+#else
+    int fd_ = -1;
+    std::vector<unsigned> ready_;           // Blocking: done, waiting for reap()
+#ifdef __linux__
+    Ring ring_;
+    int eventFd_ = -1;
+#endif
+#endif
+};
+
+// ======================================================
+// PoolFileWriter — AsyncFile writes with callbacks on a ThreadPool
+// ======================================================
+//
+//     ThreadPool pool;
+//     AsyncFile file("snap.bin");
+//     PoolFileWriter w(file, pool);
+//     w.append(std::move(bytes), [](long r) { ... });        // r on a pool worker
+//     w.writeAt(data, len, offset, [](long r) { ... });      // data valid until then
+//     w.flush();                                             // every write done
+//
+// One reaper thread per writer: it submits what the callers queued
+// and waits in ONE io_uring_enter, so writes queued while others
+// are in flight go to the kernel in a batch, with no system call
+// on the caller's side (a caller only wakes the reaper when it was
+// idle). append / writeAt block while queueDepth writes are
+// pending. Callbacks are posted to the pool, never run on the
+// reaper; flush() waits for the writes, not for their callbacks.
+//
+class PoolFileWriter {
+public:
+    using Callback = std::function<void(long)>;
+
+    PoolFileWriter(AsyncFile& file, ThreadPool& pool) : file_(file), pool_(pool), reaper_([this] { reapLoop(); }) {}
+
+    PoolFileWriter(const PoolFileWriter&) = delete;
+    PoolFileWriter& operator=(const PoolFileWriter&) = delete;
+
+    ~PoolFileWriter() {
+        flush();
+        {
+            std::lock_guard<std::mutex> lg(m_);
+            stop_ = true;
+        }
+        work_.notify_one();
+        reaper_.join();
+    }
+
+    // At the end of the file; the writer keeps `data` until done
+    void append(std::string data, Callback done = {}) {
+        Op* op = new Op(this, std::move(done));
+        op->owned = std::move(data);
+        issue([&] { return file_.tryAppend(op->owned.data(), op->owned.size(), *op); });
+    }
+
+    // data must stay valid until `done` is posted
+    void writeAt(const void* data, std::size_t len, std::uint64_t offset, Callback done = {}) {
+        Op* op = new Op(this, std::move(done));
+        issue([&] { return file_.tryWriteAt(data, len, offset, *op); });
+    }
+
+    // Every write issued before the call has completed
+    void flush() {
+        std::unique_lock<std::mutex> lk(m_);
+        space_.wait(lk, [&] { return pending_ == 0; });
+    }
+
+private:
+    struct Op : AsyncFile::Completion {
+        PoolFileWriter* w;
+        Callback cb;
+        std::string owned;
+        Op(PoolFileWriter* writer, Callback c) : w(writer), cb(std::move(c)) { done = &complete; }
+
+        static void complete(AsyncFile::Completion& c, long result) {
+            Op* op = static_cast<Op*>(&c);
+            PoolFileWriter* w = op->w;
+            if (op->cb) w->pool_.post([cb = std::move(op->cb), result] { cb(result); });
+            delete op;
+            {
+                std::lock_guard<std::mutex> lg(w->m_);
+                --w->pending_;
+            }
+            w->space_.notify_all();
+        }
+    };
+
+    template <typename Try>
+    void issue(Try tryQueue) {
+        std::unique_lock<std::mutex> lk(m_);
+        ++pending_;
+        // A free slot comes back with every completion
+        space_.wait(lk, [&] { return tryQueue(); });
+        lk.unlock();
+        work_.notify_one();
+    }
+
+    void reapLoop() {
+        for (;;) {
+            if (file_.reap(true) > 0) continue;             // submitted the queue, waited, ran callbacks
+            std::unique_lock<std::mutex> lk(m_);
+            if (stop_ && pending_ == 0) return;
+            // Nothing in flight: sleep until a caller queues a write
+            work_.wait(lk, [&] { return stop_ || file_.inFlight() > 0; });
+        }
+    }
+
+    AsyncFile& file_;
+    ThreadPool& pool_;
+    std::mutex m_;
+    std::condition_variable space_, work_;
+    std::size_t pending_ = 0;
+    bool stop_ = false;
+    std::thread reaper_;                                    // last: starts after the rest exists
+};
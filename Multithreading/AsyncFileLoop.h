@@ -0,0 +1,213 @@
+// ======================================================
+// AsyncFileLoop.h — AsyncFile writes as awaitables on EventLoop
+// ======================================================
+//
+// EventLoop.h's ev::write() is a readiness loop: fine for sockets,
+// useless for files — a regular file is always "writable" and the
+// write() then blocks the whole loop while the kernel copies.
+// LoopFile puts AsyncFile's completions on the loop instead:
+//
+//     AsyncFile file("app.log");
+//     LoopFile out(file);
+//     loop.spawn(out.pump());                       // completions → this loop
+//     loop.spawn([&]() -> Task<void> {
+//         int b = co_await out.buffer();            // a free registered buffer
+//         std::size_t n = format(file.bufferData(b), file.bufferBytes());
+//         long r = co_await out.append(b, n);       // bytes or -errno
+//         ...
+//         out.close();                              // the pump ends once idle
+//     }());
+//     loop.run();
+//
+// - writes queued during one turn of the loop are submitted
+//   together at the start of the next turn (one io_uring_enter),
+//   by a small task spawned for that turn
+// - the pump sleeps on the ring's eventfd (completionFd) through
+//   the loop's epoll, runs the completions and resumes the
+//   awaiting coroutines on the loop thread
+// - a write that finds the queue full waits, FIFO, for a slot:
+//   appends keep the order of their co_awaits. buffer() waits the
+//   same way for a registered buffer
+// - with AsyncFile's Blocking backend the write happens in the
+//   submitting task, which resumes the waiters itself
+//
+// Loop thread only. A coroutine must not be destroyed while it is
+// suspended in a write (the kernel still owns its buffer).
+//
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <unistd.h>
+#include "AsyncFile.h"
+#include "EventLoop.h"
+
+class LoopFile {
+public:
+    explicit LoopFile(AsyncFile& file) : file_(file), fd_(file.completionFd()) {}
+
+    LoopFile(const LoopFile&) = delete;
+    LoopFile& operator=(const LoopFile&) = delete;
+
+    class WriteAwaiter : public AsyncFile::Completion {
+    public:
+        enum class Kind { Buffer, Memory, At };
+
+        WriteAwaiter(LoopFile& lf, Kind kind, int buffer, const void* data, std::size_t len, std::uint64_t offset)
+            : lf_(lf), kind_(kind), buffer_(buffer), data_(data), len_(len), offset_(offset) {
+            done = &complete;
+        }
+        WriteAwaiter(const WriteAwaiter&) = delete;
+        WriteAwaiter& operator=(const WriteAwaiter&) = delete;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            h_ = h;
+            lf_.issue(*this);
+        }
+        long await_resume() const noexcept { return result_; }
+
+    private:
+        friend class LoopFile;
+
+        static void complete(AsyncFile::Completion& c, long result) {
+            WriteAwaiter& w = static_cast<WriteAwaiter&>(c);
+            w.result_ = result;
+            w.lf_.resumable_.push_back(w.h_);
+        }
+
+        LoopFile& lf_;
+        Kind kind_;
+        int buffer_;
+        const void* data_;
+        std::size_t len_;
+        std::uint64_t offset_;
+        long result_ = 0;
+        std::coroutine_handle<> h_;
+    };
+
+    class BufferAwaiter {
+    public:
+        explicit BufferAwaiter(LoopFile& lf) : lf_(lf) {}
+
+        bool await_ready() {
+            if (!lf_.bufferWaiters_.empty()) return false;          // no overtaking
+            buffer_ = lf_.file_.tryAcquireBuffer();
+            return buffer_ >= 0;
+        }
+        void await_suspend(std::coroutine_handle<> h) {
+            h_ = h;
+            lf_.bufferWaiters_.push_back(this);
+        }
+        int await_resume() const noexcept { return buffer_; }
+
+    private:
+        friend class LoopFile;
+        LoopFile& lf_;
+        int buffer_ = -1;
+        std::coroutine_handle<> h_;
+    };
+
+    // A registered buffer of the file
+    BufferAwaiter buffer() { return BufferAwaiter(*this); }
+
+    // len bytes of buffer b at the end of the file (b is free again
+    // when the co_await returns)
+    WriteAwaiter append(int b, std::size_t len) { return {*this, WriteAwaiter::Kind::Buffer, b, nullptr, len, 0}; }
+
+    // data must stay valid until the co_await returns
+    WriteAwaiter append(const void* data, std::size_t len) {
+        return {*this, WriteAwaiter::Kind::Memory, -1, data, len, 0};
+    }
+    WriteAwaiter writeAt(const void* data, std::size_t len, std::uint64_t offset) {
+        return {*this, WriteAwaiter::Kind::At, -1, data, len, offset};
+    }
+
+    // Spawn once per LoopFile; ends after close(), when idle
+    Task<void> pump() {
+        for (;;) {
+            deliver();
+            if (fd_ < 0 || (closing_ && idle())) co_return;
+            co_await ev::readable(fd_);
+            std::uint64_t n;
+            ++wakeups_;
+            if (::read(fd_, &n, sizeof n) < 0 && errno != EAGAIN && errno != EINTR) co_return;
+        }
+    }
+
+    // No more writes after this; the pump ends once they are done
+    void close() {
+        closing_ = true;
+        std::uint64_t one = 1;
+        if (fd_ >= 0 && ::write(fd_, &one, sizeof one) < 0) {
+        }
+    }
+
+    // eventfd reads by the pump (system calls besides AsyncFile's)
+    std::uint64_t wakeups() const { return wakeups_; }
+
+private:
+    bool tryQueue(WriteAwaiter& w) {
+        switch (w.kind_) {
+        case WriteAwaiter::Kind::Buffer: return file_.tryAppend(w.buffer_, w.len_, w);
+        case WriteAwaiter::Kind::Memory: return file_.tryAppend(w.data_, w.len_, w);
+        case WriteAwaiter::Kind::At: return file_.tryWriteAt(w.data_, w.len_, w.offset_, w);
+        }
+        return false;
+    }
+
+    void issue(WriteAwaiter& w) {
+        if (blocked_.empty() && tryQueue(w)) requestSubmit();
+        else blocked_.push_back(&w);
+    }
+
+    void requestSubmit() {
+        if (submitScheduled_) return;
+        submitScheduled_ = true;
+        EventLoop::current().spawn(submitter());
+    }
+
+    // Runs once every coroutine resumed this turn has queued its write
+    Task<void> submitter() {
+        co_await ev::yield();
+        submitScheduled_ = false;
+        file_.submit();
+        if (fd_ < 0) deliver();                         // Blocking: already written
+    }
+
+    // Completions → waiters; queue the blocked writes, hand out buffers
+    void deliver() {
+        file_.reap(false);
+        bool queued = false;
+        while (!blocked_.empty() && tryQueue(*blocked_.front())) {
+            blocked_.pop_front();
+            queued = true;
+        }
+        if (queued) requestSubmit();
+        while (!bufferWaiters_.empty()) {
+            const int b = file_.tryAcquireBuffer();
+            if (b < 0) break;
+            BufferAwaiter* w = bufferWaiters_.front();
+            bufferWaiters_.pop_front();
+            w->buffer_ = b;
+            resumable_.push_back(w->h_);
+        }
+        resuming_.swap(resumable_);
+        for (std::coroutine_handle<> h : resuming_) h.resume();     // may queue more (next turn)
+        resuming_.clear();
+    }
+
+    bool idle() const { return file_.inFlight() == 0 && blocked_.empty() && resumable_.empty(); }
+
+    AsyncFile& file_;
+    const int fd_;
+    std::deque<WriteAwaiter*> blocked_;
+    std::deque<BufferAwaiter*> bufferWaiters_;
+    std::vector<std::coroutine_handle<>> resumable_, resuming_;
+    bool submitScheduled_ = false;
+    bool closing_ = false;
+    std::uint64_t wakeups_ = 0;
+};
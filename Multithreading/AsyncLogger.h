@@ -0,0 +1,400 @@
+// ======================================================
+// AsyncLogger.h — per-thread lock-free log rings, one background flusher
+// ======================================================
+//
+// LockGuard.cpp / unique_Lock.cpp:
+//
+//     std::lock_guard<std::mutex> lock(m1);
+//     ++buffer;
+//     cout << threadName << ": " << buffer << endl;   // format + write() + flush
+//
+// The critical section is mostly console I/O: formatting, a
+// system call, and — because of endl — a flush, every line,
+// while every other thread waits for m1.
+//
+// asyncLog("{}: {}", threadName, buffer) instead:
+//   - appends ONE binary record to the calling thread's own
+//     ring buffer (single producer / single consumer, no lock,
+//     no RMW: a memcpy and one release store)
+//   - record = decoder pointer + the raw argument bytes; strings
+//     are copied, numbers stored as-is, NOTHING is formatted
+//   - a background flusher thread drains every ring, formats
+//     ("{}" placeholders), appends '\n' and issues one write()
+//     per batch; no flush per line
+//
+// The format must be a string literal (it is kept by pointer).
+// Arguments: arithmetic types, bool, char, enums, pointers,
+// const char*, std::string, std::string_view.
+//
+// Ordering: lines of one thread keep their order; lines of
+// different threads are NOT merged by time.
+// Full ring (64 KB per thread by default, see the constructor):
+// the record is dropped and counted (dropped()) — the hot path
+// never blocks or allocates after a thread's first call.
+// Latency: the flusher sleeps 1 ms when idle; flush() waits
+// until everything logged before the call has been written.
+//
+// The logger is a function-local static: it drains when static
+// objects are destroyed; logging from later destructors is not
+// allowed.
+//
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <unistd.h>
+
+namespace async_log_detail {
+
+using Decoder = const std::byte* (*)(const char* fmt, const std::byte* args, std::string& out);
+
+// 16 bytes; records are padded to a multiple of this, so a wrap
+// marker (decoder == nullptr) always fits at the end of the ring
+struct alignas(16) Header {
+    Decoder decode;
+    const char* fmt;
+};
+
+constexpr std::size_t kAlign = sizeof(Header);
+constexpr std::size_t roundUp(std::size_t n) { return (n + kAlign - 1) & ~(kAlign - 1); }
+
+// ---------------- argument encoding ----------------
+
+template <typename T>
+constexpr bool isStringLike = std::is_same_v<T, const char*> || std::is_same_v<T, char*> ||
+                              std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+template <typename T>
+constexpr bool isRaw = std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+                       (std::is_pointer_v<T> && !isStringLike<T>);
+
+// String literals and char arrays are stored as const char*
+template <typename T>
+using Stored = std::decay_t<const T>;
+
+template <typename T>
+std::string_view asView(const T& s) {
+    if constexpr (std::is_pointer_v<T>) return s ? std::string_view(s) : std::string_view("(null)");
+    else return std::string_view(s);
+}
+
+template <typename T>
+std::size_t encodedSize(const T& v) {
+    if constexpr (isRaw<T>) return sizeof(T);
+    else return sizeof(std::uint32_t) + asView(v).size();
+}
+
+template <typename T>
+std::byte* encode(std::byte* p, const T& v) {
+    if constexpr (isRaw<T>) {
+        std::memcpy(p, &v, sizeof(T));
+        return p + sizeof(T);
+    } else {
+        std::string_view s = asView(v);
+        std::uint32_t n = static_cast<std::uint32_t>(s.size());
+        std::memcpy(p, &n, sizeof n);
+        std::memcpy(p + sizeof n, s.data(), n);
+        return p + sizeof n + n;
+    }
+}
+
+// ---------------- deferred formatting (flusher thread) ----------------
+
+template <typename T>
+const std::byte* append(const std::byte* p, std::string& out) {
+    if constexpr (isRaw<T>) {
+        T v;
+        std::memcpy(&v, p, sizeof(T));
+        if constexpr (std::is_same_v<T, bool>) {
+            out += v ? "true" : "false";
+        } else if constexpr (std::is_same_v<T, char>) {
+            out += v;
+        } else if constexpr (std::is_enum_v<T>) {
+            append<std::underlying_type_t<T>>(p, out);
+        } else if constexpr (std::is_pointer_v<T>) {
+            char buf[2 + 16];
+            auto r = std::to_chars(buf, buf + sizeof buf, reinterpret_cast<std::uintptr_t>(v), 16);
+            out += "0x";
+            out.append(buf, r.ptr);
+        } else {
+            char buf[64];
+            auto r = std::to_chars(buf, buf + sizeof buf, v);
+            out.append(buf, r.ptr);
+        }
+        return p + sizeof(T);
+    } else {
+        std::uint32_t n;
+        std::memcpy(&n, p, sizeof n);
+        out.append(reinterpret_cast<const char*>(p + sizeof n), n);
+        return p + sizeof n + n;
+    }
+}
+
+// Copies fmt up to the next "{}" ("{{" / "}}" are literal braces)
+inline const char* literal(const char* fmt, std::string& out) {
+    while (*fmt) {
+        if (fmt[0] == '{' && fmt[1] == '}') return fmt + 2;
+        if ((fmt[0] == '{' && fmt[1] == '{') || (fmt[0] == '}' && fmt[1] == '}')) ++fmt;
+        out += *fmt++;
+    }
+    return fmt;
+}
+
+template <typename... Args>
+const std::byte* decode(const char* fmt, const std::byte* p, std::string& out) {
+    ((fmt = literal(fmt, out), p = append<Args>(p, out)), ...);
+    literal(fmt, out);
+    out += '\n';
+    return p;
+}
+
+// ---------------- per-thread ring ----------------
+
+class Ring {
+public:
+    explicit Ring(std::size_t bytes) : cap_(bytes), mask_(bytes - 1), buf_(new std::byte[bytes]) {}
+
+    // Producer: room for n bytes (n a multiple of kAlign), or nullptr
+    std::byte* reserve(std::size_t n) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        std::size_t contiguous = cap_ - (head & mask_);
+        std::size_t need = n <= contiguous ? n : n + contiguous;
+        if (head + need - cachedTail_ > cap_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head + need - cachedTail_ > cap_) return nullptr;
+        }
+        if (n > contiguous) {
+            reinterpret_cast<Header*>(buf_.get() + (head & mask_))->decode = nullptr;   // wrap marker
+            head += contiguous;
+            head_.store(head, std::memory_order_release);
+        }
+        return buf_.get() + (head & mask_);
+    }
+
+    void commit(std::size_t n) {
+        head_.store(head_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    void drop() { dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+    // Consumer: formats everything published so far into out
+    bool drain(std::string& out) {
+        std::size_t head = head_.load(std::memory_order_acquire);
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head) return false;
+        while (tail != head) {
+            const std::byte* rec = buf_.get() + (tail & mask_);
+            Header h;
+            std::memcpy(&h, rec, sizeof h);
+            if (!h.decode) {
+                tail += cap_ - (tail & mask_);
+                continue;
+            }
+            const std::byte* end = h.decode(h.fmt, rec + sizeof(Header), out);
+            tail += roundUp(static_cast<std::size_t>(end - rec));
+        }
+        tail_.store(tail, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const { return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire); }
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    std::atomic<bool> closed{false};                 // owning thread has exited
+
+private:
+    const std::size_t cap_, mask_;
+    std::unique_ptr<std::byte[]> buf_;
+
+    alignas(64) std::atomic<std::size_t> head_{0};   // producer
+    std::size_t cachedTail_ = 0;
+    std::atomic<std::uint64_t> dropped_{0};
+
+    alignas(64) std::atomic<std::size_t> tail_{0};   // consumer
+};
+
+}  // namespace async_log_detail
+
+class AsyncLogger {
+public:
+    static constexpr std::size_t kDefaultRingBytes = 1 << 16;
+
+    // ringBytes: per-thread ring, rounded up to a power of two
+    explicit AsyncLogger(int fd = STDOUT_FILENO, std::size_t ringBytes = kDefaultRingBytes)
+        : fd_(fd), ringBytes_(std::bit_ceil(ringBytes < 1024 ? std::size_t(1024) : ringBytes)),
+          flusher_([this] { flushLoop(); }) {}
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    // Writes everything still queued, then stops the flusher
+    ~AsyncLogger() {
+        stop_.store(true, std::memory_order_relaxed);
+        flusher_.join();
+    }
+
+    static AsyncLogger& instance() {
+        static AsyncLogger logger;
+        return logger;
+    }
+
+    template <std::size_t N, typename... Args>
+    void log(const char (&fmt)[N], const Args&... args) {
+        using namespace async_log_detail;
+        static_assert(((isRaw<Stored<Args>> || isStringLike<Stored<Args>>) && ...),
+                      "asyncLog: unsupported argument type");
+        Ring& ring = localRing();
+        std::size_t n = roundUp(sizeof(Header) + (std::size_t(0) + ... + encodedSize<Stored<Args>>(args)));
+        std::byte* p = n <= ringBytes_ / 2 ? ring.reserve(n) : nullptr;
+        if (!p) [[unlikely]] {
+            ring.drop();
+            return;
+        }
+        Header h{&decode<Stored<Args>...>, fmt};
+        std::memcpy(p, &h, sizeof h);
+        std::byte* q = p + sizeof h;
+        ((q = encode<Stored<Args>>(q, args)), ...);
+        ring.commit(n);
+    }
+
+    // Blocks until everything logged before the call is written
+    void flush() {
+        std::uint64_t seen = passes_.load(std::memory_order_acquire);
+        // The pass running now may have started before our records
+        while (passes_.load(std::memory_order_acquire) < seen + 2) {
+            passes_.wait(passes_.load(std::memory_order_acquire), std::memory_order_acquire);
+        }
+    }
+
+    std::uint64_t dropped() {
+        std::lock_guard<std::mutex> lg(registryLock_);
+        return droppedByExited_ + sumDropped();
+    }
+
+private:
+    using Ring = async_log_detail::Ring;
+
+    struct LocalRings {
+        std::vector<std::pair<std::uint64_t, std::shared_ptr<Ring>>> rings;    // (logger id, ring)
+        ~LocalRings() {
+            for (auto& [id, ring] : rings) ring->closed.store(true, std::memory_order_release);
+        }
+    };
+
+    // The thread's ring for THIS logger; the first call registers it
+    Ring& localRing() {
+        thread_local LocalRings local;
+        if (!local.rings.empty() && local.rings.front().first == id_) [[likely]]
+            return *local.rings.front().second;
+        return findOrRegister(local);
+    }
+
+    Ring& findOrRegister(LocalRings& local) {
+        for (auto& entry : local.rings) {
+            if (entry.first == id_) {
+                std::swap(entry, local.rings.front());      // most recent logger first
+                return *local.rings.front().second;
+            }
+        }
+        auto ring = std::make_shared<Ring>(ringBytes_);
+        {
+            std::lock_guard<std::mutex> lg(registryLock_);
+            rings_.push_back(ring);
+        }
+        local.rings.emplace_back(id_, std::move(ring));
+        std::swap(local.rings.back(), local.rings.front());
+        return *local.rings.front().second;
+    }
+
+    static std::uint64_t nextId() {
+        static std::atomic<std::uint64_t> ids{0};
+        return ids.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    std::uint64_t sumDropped() const {
+        std::uint64_t n = 0;
+        for (auto& r : rings_) n += r->dropped();
+        return n;
+    }
+
+    void flushLoop() {
+        std::string out;
+        std::vector<std::shared_ptr<Ring>> rings;
+        for (;;) {
+            bool stopping = stop_.load(std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lg(registryLock_);
+                rings = rings_;
+            }
+            bool any = false;
+            for (auto& r : rings) any |= r->drain(out);
+            if (!out.empty()) {
+                writeAll(out);
+                out.clear();
+            }
+            reapExited();
+            passes_.fetch_add(1, std::memory_order_release);
+            passes_.notify_all();
+            if (stopping) return;                       // that pass started after stop: all drained
+            if (!any) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    // Rings of exited threads, once empty, are released
+    void reapExited() {
+        std::lock_guard<std::mutex> lg(registryLock_);
+        for (std::size_t i = 0; i < rings_.size();) {
+            Ring& r = *rings_[i];
+            if (r.closed.load(std::memory_order_acquire) && r.empty()) {
+                droppedByExited_ += r.dropped();
+                rings_[i] = std::move(rings_.back());
+                rings_.pop_back();
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    // One blocking write() per batch; AsyncFile.h queues them in
+    // io_uring instead (asyncFileIo.cpp compares the two)
+    void writeAll(const std::string& s) {
+        const char* p = s.data();
+        std::size_t left = s.size();
+        while (left > 0) {
+            ssize_t w = ::write(fd_, p, left);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                return;                                 // nowhere to report it
+            }
+            p += w;
+            left -= static_cast<std::size_t>(w);
+        }
+    }
+
+    const std::uint64_t id_ = nextId();             // never reused, unlike an address
+    const int fd_;
+    const std::size_t ringBytes_;
+    std::atomic<bool> stop_{false};
+    std::atomic<std::uint64_t> passes_{0};
+    std::mutex registryLock_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+    std::uint64_t droppedByExited_ = 0;
+    std::thread flusher_;                               // last: starts after the rest exists
+};
+
+template <std::size_t N, typename... Args>
+void asyncLog(const char (&fmt)[N], const Args&... args) {
+    AsyncLogger::instance().log(fmt, args...);
+}
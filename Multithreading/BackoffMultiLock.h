@@ -0,0 +1,140 @@
+// ======================================================
+// BackoffMultiLock.h — all-or-nothing multi-lock with backoff
+// ======================================================
+//
+// std::try_lock(m1, m2) in a while(1) loop (std::try_lock.cpp)
+// retries IMMEDIATELY after every failure:
+// - the retrying thread burns a whole core
+// - it keeps grabbing m1 just long enough to make the
+//   producers that need m1 fail or sleep
+// - with many producers it may almost never win both locks
+//
+// lockAllWithBackoff(opts, stats, m1, m2, ...):
+// 1. std::try_lock(m1, m2, ...)        → all or none, no deadlock
+// 2. on failure, wait a RANDOM number of pause instructions in
+//    [1, window] and double the window (1, 2, 4 ... maxSpins):
+//    randomised so competing retriers don't collide in lockstep
+// 3. once the window is saturated, also yield the CPU
+// 4. FAIRNESS (optional): after `handoffAfter` consecutive
+//    failures, stop retrying and BLOCK in std::lock(m1, m2, ...),
+//    which queues this thread on the mutex that failed, so the
+//    kernel hands the lock over instead of it being re-won by
+//    whoever happens to spin fastest
+//
+// STATS (optional, shared between threads):
+//   acquisitions, failed attempts, pause spins, handoffs
+//   → spinsPerSuccess(), attemptsPerSuccess()
+//
+// BackoffLock<Ls...> is the RAII form (like std::scoped_lock).
+//
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <tuple>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BACKOFF_PAUSE() _mm_pause()
+#elif defined(__aarch64__)
+#define BACKOFF_PAUSE() asm volatile("yield")
+#else
+#define BACKOFF_PAUSE() ((void)0)
+#endif
+
+struct MultiLockOptions {
+    unsigned minSpins = 4;          // first backoff window (pause instructions)
+    unsigned maxSpins = 1024;       // window cap; after this we also yield
+    unsigned handoffAfter = 64;     // consecutive failures before blocking; 0 = never
+};
+
+struct MultiLockStats {
+    std::atomic<std::uint64_t> acquisitions{0};
+    std::atomic<std::uint64_t> failedAttempts{0};
+    std::atomic<std::uint64_t> spins{0};
+    std::atomic<std::uint64_t> handoffs{0};
+
+    double spinsPerSuccess() const {
+        std::uint64_t n = acquisitions.load();
+        return n ? (double)spins.load() / (double)n : 0.0;
+    }
+    double attemptsPerSuccess() const {
+        std::uint64_t n = acquisitions.load();
+        return n ? (double)(n + failedAttempts.load()) / (double)n : 0.0;
+    }
+};
+
+namespace backoff_detail {
+
+inline std::minstd_rand& rng() {
+    static thread_local std::minstd_rand r(
+        (unsigned)std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    return r;
+}
+
+// Spinning with one CPU only delays the lock holder
+inline bool multiCore() {
+    static const bool mc = std::thread::hardware_concurrency() > 1;
+    return mc;
+}
+
+}  // namespace backoff_detail
+
+// Locks every lockable, or blocks until it can. Never deadlocks.
+template <typename... Ls>
+void lockAllWithBackoff(const MultiLockOptions& opts, MultiLockStats* stats, Ls&... locks) {
+    static_assert(sizeof...(Ls) >= 2, "use lock() for a single lockable");
+    unsigned window = opts.minSpins ? opts.minSpins : 1;
+    std::uint64_t failures = 0, spins = 0;
+
+    while (std::try_lock(locks...) != -1) {
+        ++failures;
+        if (opts.handoffAfter && failures >= opts.handoffAfter) {
+            std::lock(locks...);            // queue on the busy mutex
+            if (stats) {
+                stats->handoffs.fetch_add(1, std::memory_order_relaxed);
+                stats->failedAttempts.fetch_add(failures, std::memory_order_relaxed);
+                stats->spins.fetch_add(spins, std::memory_order_relaxed);
+                stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+        if (backoff_detail::multiCore()) {
+            unsigned n = 1 + backoff_detail::rng()() % window;
+            for (unsigned i = 0; i < n; ++i) BACKOFF_PAUSE();
+            spins += n;
+        }
+        if (window >= opts.maxSpins || !backoff_detail::multiCore())
+            std::this_thread::yield();
+        else
+            window *= 2;
+    }
+    if (stats) {
+        stats->failedAttempts.fetch_add(failures, std::memory_order_relaxed);
+        stats->spins.fetch_add(spins, std::memory_order_relaxed);
+        stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// RAII: acquires in the constructor, unlocks all in the destructor
+template <typename... Ls>
+class BackoffLock {
+public:
+    explicit BackoffLock(Ls&... locks, const MultiLockOptions& opts = {},
+                         MultiLockStats* stats = nullptr)
+        : locks_(locks...) {
+        lockAllWithBackoff(opts, stats, locks...);
+    }
+    ~BackoffLock() {
+        std::apply([](Ls&... l) { (l.unlock(), ...); }, locks_);
+    }
+    BackoffLock(const BackoffLock&) = delete;
+    BackoffLock& operator=(const BackoffLock&) = delete;
+
+private:
+    std::tuple<Ls&...> locks_;
+};
@@ -0,0 +1,81 @@
+// ======================================================
+// CachePadded.h — one cache line per hot shared variable
+// ======================================================
+//
+// std::try_lock.cpp:
+//
+//     int X = 0;
+//     int Y = 0;
+//     std::mutex m1, m2;        // t1: m1 + X,  t2: m2 + Y
+//
+// The linker packs these globals back to back: X and Y share a
+// 64-byte line (with part of m1). t1 and t2 never touch each
+// other's data, yet every ++X invalidates the line in t2's cache
+// and every ++Y in t1's — FALSE SHARING: the hardware moves the
+// line between cores as if the variables were shared.
+//
+// - cache_line_size: std::hardware_destructive_interference_size
+//   where the library has it (64 on x86-64), else 64
+// - cache_padded<T>: T alone on its own line(s) — alignas rounds
+//   sizeof up, so neighbours in an array or struct cannot share
+// - line_guarded<T, Mutex>: a value AND the mutex that protects it
+//   on one line — they are always used together (true sharing is
+//   what you want there), and nothing else is on that line
+//
+//     line_guarded<int> x, y;                 // the fixed X/m1, Y/m2
+//     { std::lock_guard g(x.mutex); ++x.value; }
+//
+// For plain globals, `alignas(cache_line_size)` on the declaration
+// does the same without changing how the variable is used.
+//
+// Intel's adjacent-line prefetcher pulls lines in pairs: for the
+// very hottest data, cache_padded<T, 2 * cache_line_size>.
+//
+// FalseSharingDetector.h finds the variables that need this.
+//
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#if defined(__cpp_lib_hardware_interference_size)
+#if defined(__GNUC__) && !defined(__clang__)
+// The value depends on -mtune; these types are not shared across
+// differently tuned binaries
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+inline constexpr std::size_t cache_line_size = std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+inline constexpr std::size_t cache_line_size = 64;
+#endif
+
+template <typename T, std::size_t Align = cache_line_size>
+struct alignas(Align) cache_padded {
+    static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0, "cache_padded: Align must be a power of two");
+
+    cache_padded() = default;
+    explicit cache_padded(T v) : value(std::move(v)) {}
+    template <typename... Args>
+    explicit cache_padded(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
+
+    T& get() { return value; }
+    const T& get() const { return value; }
+    T& operator*() { return value; }
+    const T& operator*() const { return value; }
+    T* operator->() { return &value; }
+    const T* operator->() const { return &value; }
+
+    T value{};
+};
+
+template <typename T, typename Mutex = std::mutex, std::size_t Align = cache_line_size>
+struct alignas(Align) line_guarded {
+    Mutex mutex;
+    T value{};
+};
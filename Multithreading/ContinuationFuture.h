@@ -0,0 +1,530 @@
+// ======================================================
+// ContinuationFuture.h — Promise/Future with then, when_all, when_any
+// ======================================================
+//
+// std::futureAndPromise.cpp:
+//
+//     std::promise<ull> OddSumPromise;
+//     std::future<ull> OddSumFuture = OddSumPromise.get_future();
+//     std::thread t1(findOdd, std::move(OddSumPromise), Start, end);
+//     ull result = OddSumFuture.get();          // this thread parks
+//
+// The only thing a std::future can do is get() — block until
+// the value exists. Fan out 10^5 tasks and fan in their sums,
+// and the fan-in costs 10^5 parked get() calls (or one thread
+// per future), plus one shared-state allocation per promise.
+//
+// HERE a Future is a place to attach the NEXT step:
+//
+//     Promise<ull> p;
+//     Future<ull> f = p.get_future();
+//     pool.post([p = std::move(p)]() mutable { p.set_value(findOdd(a, b)); });
+//
+//     Future<ull> sq = std::move(f).then([](ull v) { return v % 1000; });   // inline
+//     auto all = when_all(std::move(futures))                                // Future<vector<ull>>
+//                    .then(pool, [](std::vector<ull> v) { return sum(v); });  // on the pool
+//     ull total = std::move(all).get();          // the ONE blocking point, if any
+//
+//   - then(fn) runs fn INLINE: on the thread that fulfils the
+//     promise, or immediately in then() if it already was
+//   - then(pool, fn) posts fn to a ThreadPool; consecutive pool
+//     steps run in the same task
+//   - when_all(vector<Future<T>>) → Future<vector<T>> (in input
+//     order; T default-constructible); when_any → Future<
+//     pair<index, T>> of the first to settle
+//   - an exception thrown by a step (or set_exception, or a
+//     Promise destroyed unfulfilled: broken_promise) skips the
+//     later steps and is rethrown by get()
+//
+// ONE ALLOCATION PER CHAIN: a Promise allocates one State and
+// every then() on that chain REUSES it. then() consumes the
+// Future (call it on an rvalue), so the State can move each
+// step's result into the same value slot (64 bytes inline,
+// bigger values are boxed on the heap) and keep the steps'
+// callables in a 256-byte bump area inside the State (a step
+// that does not fit is heap-allocated). when_all / when_any
+// allocate one State for the joined chain.
+// Not counted: ThreadPool::post allocates its own Task.
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ThreadPool.h"
+
+template <typename T>
+class Future;
+template <typename T>
+class Promise;
+
+namespace future_detail {
+
+struct Unit {};
+template <typename T>
+using Stored = std::conditional_t<std::is_void_v<T>, Unit, T>;
+
+// What a then() step returns: fn(T&&), or fn() after a Future<void>
+template <typename F, typename T>
+struct StepResult {
+    using type = std::invoke_result_t<F, T&&>;
+};
+template <typename F>
+struct StepResult<F, void> {
+    using type = std::invoke_result_t<F>;
+};
+
+constexpr std::size_t kValueBytes = 64;
+constexpr std::size_t kStageBytes = 256;
+
+struct State;
+
+// One continuation; the callable follows it in memory
+struct Stage {
+    void (*run)(Stage*, State*);
+    void (*destroy)(Stage*);
+    Stage* next = nullptr;
+    ThreadPool* pool = nullptr;                     // null: inline
+    bool onHeap = false;
+};
+
+template <typename C>
+struct StageImpl : Stage {
+    C call;
+    explicit StageImpl(C&& c) : call(std::move(c)) {
+        run = [](Stage* st, State* s) { static_cast<StageImpl*>(st)->call(s); };
+        destroy = [](Stage* st) { static_cast<StageImpl*>(st)->~StageImpl(); };
+    }
+};
+
+struct State {
+    std::atomic<std::uint32_t> refs{1};
+    std::mutex m;
+    Stage* head = nullptr;                          // pending steps, in order
+    Stage* tail = nullptr;
+    bool ready = false;                             // the slot holds a value or error
+    bool running = false;                           // a thread is draining the steps
+    std::atomic<bool> settled{false};               // ready, nothing pending or running
+    std::exception_ptr error;
+    void (*destroyValue)(State*) = nullptr;
+    std::size_t stageUsed = 0;
+    alignas(std::max_align_t) std::byte value[kValueBytes];
+    alignas(std::max_align_t) std::byte stages[kStageBytes];
+};
+
+inline void addRef(State* s) { s->refs.fetch_add(1, std::memory_order_relaxed); }
+
+inline void freeStage(Stage* st) {
+    bool heap = st->onHeap;
+    st->destroy(st);
+    if (heap) ::operator delete(static_cast<void*>(st));
+}
+
+inline void release(State* s) {
+    if (s->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    while (Stage* st = s->head) {                   // never ran (no fulfilment possible now)
+        s->head = st->next;
+        freeStage(st);
+    }
+    if (s->destroyValue) s->destroyValue(s);
+    delete s;
+}
+
+// Intrusive reference, for callables that keep a State alive
+class StateRef {
+public:
+    explicit StateRef(State* s) : s_(s) { addRef(s); }
+    static StateRef adopt(State* s) { return StateRef(s, 0); }   // takes over a reference
+    StateRef(StateRef&& o) noexcept : s_(std::exchange(o.s_, nullptr)) {}
+    StateRef(const StateRef&) = delete;
+    StateRef& operator=(const StateRef&) = delete;
+    ~StateRef() {
+        if (s_) release(s_);
+    }
+    State* get() const { return s_; }
+
+private:
+    StateRef(State* s, int) : s_(s) {}
+    State* s_;
+};
+
+// ---- the value slot ----
+template <typename T>
+constexpr bool kInline = sizeof(T) <= kValueBytes && alignof(T) <= alignof(std::max_align_t);
+
+template <typename T>
+T* slot(State* s) {
+    if constexpr (kInline<T>)
+        return std::launder(reinterpret_cast<T*>(s->value));
+    else
+        return *std::launder(reinterpret_cast<T**>(s->value));
+}
+
+template <typename T, typename... Args>
+void put(State* s, Args&&... args) {
+    if constexpr (kInline<T>) {
+        ::new (static_cast<void*>(s->value)) T(std::forward<Args>(args)...);
+        s->destroyValue = [](State* st) { std::destroy_at(slot<T>(st)); };
+    } else {
+        T* box = new T(std::forward<Args>(args)...);
+        ::new (static_cast<void*>(s->value)) T*(box);
+        s->destroyValue = [](State* st) { delete slot<T>(st); };
+    }
+}
+
+template <typename T>
+T take(State* s) {
+    T v = std::move(*slot<T>(s));
+    s->destroyValue(s);
+    s->destroyValue = nullptr;
+    return v;
+}
+
+inline void runStage(State* s, Stage* st) {
+    st->run(st, s);
+    freeStage(st);
+}
+
+// Runs pending steps in order until none is left; the caller has
+// set running. A pool step hands the rest of the drain to a task.
+inline void drain(State* s, ThreadPool* on) {
+    for (;;) {
+        Stage* st;
+        {
+            std::lock_guard<std::mutex> lg(s->m);
+            st = s->head;
+            if (!st) {
+                s->running = false;
+                s->settled.store(true, std::memory_order_release);
+                s->settled.notify_all();
+                return;
+            }
+            s->head = st->next;
+            if (!s->head) s->tail = nullptr;
+        }
+        if (st->pool && st->pool != on) {
+            ThreadPool* pool = st->pool;
+            pool->post([ref = StateRef(s), st, pool]() mutable {
+                runStage(ref.get(), st);
+                drain(ref.get(), pool);
+            });
+            return;                                 // still running, on the pool
+        }
+        runStage(s, st);
+    }
+}
+
+// Called by whoever holds the chain's only Future (or a Promise)
+template <typename C>
+void attach(State* s, ThreadPool* pool, C&& call) {
+    using Impl = StageImpl<std::decay_t<C>>;
+    Stage* st;
+    bool start = false;
+    {
+        std::lock_guard<std::mutex> lg(s->m);
+        std::size_t at = (s->stageUsed + alignof(Impl) - 1) & ~(alignof(Impl) - 1);
+        if (alignof(Impl) <= alignof(std::max_align_t) && at + sizeof(Impl) <= kStageBytes) {
+            st = ::new (static_cast<void*>(s->stages + at)) Impl(std::forward<C>(call));
+            s->stageUsed = at + sizeof(Impl);
+        } else {
+            st = ::new (::operator new(sizeof(Impl))) Impl(std::forward<C>(call));
+            st->onHeap = true;
+        }
+        st->pool = pool;
+        if (s->tail)
+            s->tail->next = st;
+        else
+            s->head = st;
+        s->tail = st;
+        s->settled.store(false, std::memory_order_relaxed);
+        if (s->ready && !s->running) start = s->running = true;
+    }
+    if (start) drain(s, nullptr);
+}
+
+// The slot now holds the chain's first value (or error is set)
+inline void fulfil(State* s) {
+    bool start = false;
+    {
+        std::lock_guard<std::mutex> lg(s->m);
+        s->ready = true;
+        if (s->head) {
+            start = s->running = true;
+        } else {
+            s->settled.store(true, std::memory_order_release);
+            s->settled.notify_all();
+        }
+    }
+    if (start) drain(s, nullptr);
+}
+
+inline void fail(State* s, std::exception_ptr e) {
+    s->error = std::move(e);
+    fulfil(s);
+}
+
+// Future's State, for when_all / when_any
+struct Access {
+    template <typename T>
+    static State* detach(Future<T>& f) {
+        if (!f.s_) throw std::future_error(std::future_errc::no_state);
+        return std::exchange(f.s_, nullptr);
+    }
+    template <typename T>
+    static Future<T> wrap(State* s) {
+        return Future<T>(s);
+    }
+};
+
+}  // namespace future_detail
+
+template <typename T>
+class Future {
+public:
+    using value_type = T;
+
+    Future() = default;
+    Future(Future&& o) noexcept : s_(std::exchange(o.s_, nullptr)) {}
+    Future& operator=(Future&& o) noexcept {
+        if (this != &o) {
+            reset();
+            s_ = std::exchange(o.s_, nullptr);
+        }
+        return *this;
+    }
+    Future(const Future&) = delete;
+    Future& operator=(const Future&) = delete;
+    ~Future() { reset(); }
+
+    bool valid() const { return s_ != nullptr; }
+    bool is_ready() const { return s_ && s_->settled.load(std::memory_order_acquire); }
+
+    template <typename F>
+    auto then(F&& f) && {
+        return std::move(*this).chain(nullptr, std::forward<F>(f));
+    }
+
+    template <typename F>
+    auto then(ThreadPool& pool, F&& f) && {
+        return std::move(*this).chain(&pool, std::forward<F>(f));
+    }
+
+    // Blocks until the chain has settled; rethrows a stored error
+    void wait() const {
+        if (!s_) throw std::future_error(std::future_errc::no_state);
+        while (!s_->settled.load(std::memory_order_acquire)) s_->settled.wait(false, std::memory_order_acquire);
+    }
+
+    T get() && {
+        wait();
+        future_detail::StateRef hold = future_detail::StateRef::adopt(std::exchange(s_, nullptr));
+        future_detail::State* s = hold.get();
+        if (s->error) std::rethrow_exception(s->error);
+        if constexpr (std::is_void_v<T>)
+            future_detail::take<future_detail::Unit>(s);
+        else
+            return future_detail::take<T>(s);
+    }
+
+private:
+    template <typename>
+    friend class Future;
+    template <typename>
+    friend class Promise;
+    friend struct future_detail::Access;
+
+    explicit Future(future_detail::State* s) : s_(s) {}
+
+    void reset() {
+        if (s_) future_detail::release(std::exchange(s_, nullptr));
+    }
+
+    template <typename F>
+    auto chain(ThreadPool* pool, F&& f) && {
+        using namespace future_detail;
+        if (!s_) throw std::future_error(std::future_errc::no_state);
+        using U = typename StepResult<std::decay_t<F>, T>::type;
+        State* s = s_;
+        attach(s, pool, [fn = std::forward<F>(f)](State* st) mutable {
+            if (st->error) return;                  // skip: propagate the error
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    take<Unit>(st);
+                    if constexpr (std::is_void_v<U>) {
+                        fn();
+                        put<Unit>(st);
+                    } else {
+                        put<U>(st, fn());
+                    }
+                } else {
+                    T v = take<T>(st);
+                    if constexpr (std::is_void_v<U>) {
+                        fn(std::move(v));
+                        put<Unit>(st);
+                    } else {
+                        put<U>(st, fn(std::move(v)));
+                    }
+                }
+            } catch (...) {
+                st->error = std::current_exception();
+            }
+        });
+        return Future<U>(std::exchange(s_, nullptr));   // same State, next type
+    }
+
+    future_detail::State* s_ = nullptr;
+};
+
+template <typename T>
+class Promise {
+public:
+    Promise() : s_(new future_detail::State) {}
+    Promise(Promise&& o) noexcept
+        : s_(std::exchange(o.s_, nullptr)), retrieved_(o.retrieved_), satisfied_(o.satisfied_) {}
+    Promise& operator=(Promise&& o) noexcept {
+        if (this != &o) {
+            abandon();
+            s_ = std::exchange(o.s_, nullptr);
+            retrieved_ = o.retrieved_;
+            satisfied_ = o.satisfied_;
+        }
+        return *this;
+    }
+    Promise(const Promise&) = delete;
+    Promise& operator=(const Promise&) = delete;
+    ~Promise() { abandon(); }
+
+    Future<T> get_future() {
+        if (!s_) throw std::future_error(std::future_errc::no_state);
+        if (retrieved_) throw std::future_error(std::future_errc::future_already_retrieved);
+        retrieved_ = true;
+        future_detail::addRef(s_);
+        return Future<T>(s_);
+    }
+
+    template <typename... Args>
+    void set_value(Args&&... args) {
+        claim();
+        future_detail::put<future_detail::Stored<T>>(s_, std::forward<Args>(args)...);
+        future_detail::fulfil(s_);
+    }
+
+    void set_exception(std::exception_ptr e) {
+        claim();
+        future_detail::fail(s_, std::move(e));
+    }
+
+private:
+    void claim() {
+        if (!s_) throw std::future_error(std::future_errc::no_state);
+        if (satisfied_) throw std::future_error(std::future_errc::promise_already_satisfied);
+        satisfied_ = true;
+    }
+
+    void abandon() {
+        if (!s_) return;
+        if (!satisfied_) future_detail::fail(s_, std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+        future_detail::release(std::exchange(s_, nullptr));
+    }
+
+    future_detail::State* s_;
+    bool retrieved_ = false;
+    bool satisfied_ = false;
+};
+
+template <typename T>
+Future<std::decay_t<T>> make_ready_future(T&& value) {
+    Promise<std::decay_t<T>> p;
+    Future<std::decay_t<T>> f = p.get_future();
+    p.set_value(std::forward<T>(value));
+    return f;
+}
+
+// Every input's value, in input order, once all have settled;
+// the first error seen instead, if any input failed
+template <typename T>
+Future<std::vector<T>> when_all(std::vector<Future<T>> inputs) {
+    static_assert(!std::is_void_v<T>, "when_all: Future<void> inputs are not supported");
+    using namespace future_detail;
+    struct Join {
+        std::atomic<std::size_t> remaining;
+        std::vector<T> results;
+        std::mutex errorLock;
+        std::exception_ptr error;
+    };
+    State* out = new State;
+    Future<std::vector<T>> result = Access::wrap<std::vector<T>>(out);
+    if (inputs.empty()) {
+        put<std::vector<T>>(out);
+        fulfil(out);
+        return result;
+    }
+    // Joined chain's first bytes of bump area (nothing is attached yet)
+    static_assert(sizeof(Join) <= kStageBytes && alignof(Join) <= alignof(std::max_align_t));
+    Join* join = ::new (static_cast<void*>(out->stages)) Join{{inputs.size()}, std::vector<T>(inputs.size()), {}, {}};
+    out->stageUsed = sizeof(Join);
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        StateRef in = StateRef::adopt(Access::detach(inputs[i]));
+        attach(in.get(), nullptr, [join, ref = StateRef(out), i](State* st) {
+            if (st->error) {
+                std::lock_guard<std::mutex> lg(join->errorLock);
+                if (!join->error) join->error = st->error;
+            } else {
+                join->results[i] = take<T>(st);
+            }
+            if (join->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+            std::vector<T> values = std::move(join->results);
+            std::exception_ptr error = std::move(join->error);
+            join->~Join();
+            if (error) {
+                fail(ref.get(), std::move(error));
+            } else {
+                put<std::vector<T>>(ref.get(), std::move(values));
+                fulfil(ref.get());
+            }
+        });
+    }
+    return result;
+}
+
+// The first input to settle: its index and value (or its error)
+template <typename T>
+Future<std::pair<std::size_t, T>> when_any(std::vector<Future<T>> inputs) {
+    static_assert(!std::is_void_v<T>, "when_any: Future<void> inputs are not supported");
+    using namespace future_detail;
+    using R = std::pair<std::size_t, T>;
+    if (inputs.empty()) throw std::invalid_argument("when_any: no inputs");
+    struct Race {
+        std::atomic<std::size_t> remaining;
+        std::atomic<bool> decided{false};
+    };
+    State* out = new State;
+    Future<R> result = Access::wrap<R>(out);
+    static_assert(sizeof(Race) <= kStageBytes);
+    Race* race = ::new (static_cast<void*>(out->stages)) Race{{inputs.size()}, {false}};
+    out->stageUsed = sizeof(Race);
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        StateRef in = StateRef::adopt(Access::detach(inputs[i]));
+        attach(in.get(), nullptr, [race, ref = StateRef(out), i](State* st) {
+            if (!race->decided.exchange(true, std::memory_order_acq_rel)) {
+                if (st->error) {
+                    fail(ref.get(), st->error);
+                } else {
+                    put<R>(ref.get(), i, take<T>(st));
+                    fulfil(ref.get());
+                }
+            }
+            // Losers' values stay in their own States and die with them
+            if (race->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) race->~Race();
+        });
+    }
+    return result;
+}
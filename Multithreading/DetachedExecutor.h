@@ -0,0 +1,179 @@
+// ======================================================
+// DetachedExecutor.h — fire-and-forget tasks without detached threads
+// ======================================================
+//
+// Detach.cpp / joinAndDetach.cpp:
+//
+//     thread t1(run, 5);
+//     t1.detach();                        // nobody waits for it
+//     ... main returns → process exits → run() is cut off
+//
+// and every background task pays a whole thread creation.
+//
+// DetachedExecutor keeps the fire-and-forget call shape:
+//
+//     spawn_detached(run, 5);             // returns immediately
+//
+// but runs the task on a PERSISTENT set of workers:
+//   - workers are created once, not per task
+//   - the queue is BOUNDED: when `capacity` tasks are waiting,
+//     spawn_detached() blocks until a worker takes one
+//     (try_spawn_detached() returns false instead) — a runaway
+//     producer cannot grow memory without limit
+//   - SHUTDOWN DRAINS: the destructor (or shutdown()) stops
+//     accepting work, lets the workers finish everything that
+//     was queued, then joins them. The process-wide executor
+//     behind spawn_detached() is a function-local static, so
+//     returning from main() waits for queued tasks instead of
+//     killing them mid-way
+//   - a throwing task cannot reach anyone (no future), so its
+//     exception is caught and counted in failedTasks()
+//
+// Tasks must not rely on objects that die before the executor:
+// the same rule as for a detached thread, but now the executor
+// is the one outliving everything else.
+//
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "ThreadPool.h"
+
+class DetachedExecutor {
+public:
+    using Task = ThreadPool::Task;     // move-only void() callable
+
+    explicit DetachedExecutor(unsigned threads = std::thread::hardware_concurrency(),
+                              std::size_t capacity = 1024)
+        : capacity_(capacity == 0 ? 1 : capacity) {
+        if (threads == 0) threads = 1;
+        for (unsigned i = 0; i < threads; ++i) workers_.emplace_back(&DetachedExecutor::workerLoop, this);
+    }
+
+    DetachedExecutor(const DetachedExecutor&) = delete;
+    DetachedExecutor& operator=(const DetachedExecutor&) = delete;
+
+    ~DetachedExecutor() { shutdown(); }
+
+    // Blocks while the queue is full. false only after shutdown().
+    template <typename F, typename... Args>
+    bool spawn_detached(F&& f, Args&&... args) {
+        std::unique_lock<std::mutex> lk(m_);
+        notFull_.wait(lk, [this] { return stopping_ || queue_.size() < capacity_; });
+        if (stopping_) return false;
+        queue_.push_back(makeTask(std::forward<F>(f), std::forward<Args>(args)...));
+        lk.unlock();
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    // Never blocks: false if the queue is full or shut down
+    template <typename F, typename... Args>
+    bool try_spawn_detached(F&& f, Args&&... args) {
+        std::unique_lock<std::mutex> lk(m_);
+        if (stopping_ || queue_.size() >= capacity_) return false;
+        queue_.push_back(makeTask(std::forward<F>(f), std::forward<Args>(args)...));
+        lk.unlock();
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    // Waits until everything queued so far has run (new submissions
+    // are still accepted meanwhile)
+    void drain() {
+        std::unique_lock<std::mutex> lk(m_);
+        idle_.wait(lk, [this] { return queue_.empty() && running_ == 0; });
+    }
+
+    // Stops accepting work, runs what is queued, joins the workers.
+    // Idempotent, from any number of threads: the first call joins,
+    // concurrent ones wait for it. Must not be called from one of
+    // its own tasks.
+    void shutdown() {
+        std::call_once(shutdownOnce_, [this] {
+            {
+                std::lock_guard<std::mutex> lg(m_);
+                stopping_ = true;
+            }
+            notEmpty_.notify_all();
+            notFull_.notify_all();
+            for (auto& t : workers_) t.join();
+            workers_.clear();
+        });
+    }
+
+    std::size_t size() const { return workers_.size(); }
+    std::size_t capacity() const { return capacity_; }
+
+    std::size_t pending() {
+        std::lock_guard<std::mutex> lg(m_);
+        return queue_.size() + running_;
+    }
+
+    std::size_t failedTasks() {
+        std::lock_guard<std::mutex> lg(m_);
+        return failed_;
+    }
+
+private:
+    template <typename F, typename... Args>
+    static Task makeTask(F&& f, Args&&... args) {
+        return Task([fn = std::forward<F>(f), tup = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+            std::apply(std::move(fn), std::move(tup));
+        });
+    }
+
+    void workerLoop() {
+        std::unique_lock<std::mutex> lk(m_);
+        for (;;) {
+            notEmpty_.wait(lk, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;              // stopping and drained
+            Task t = std::move(queue_.front());
+            queue_.pop_front();
+            ++running_;
+            lk.unlock();
+            notFull_.notify_one();
+
+            bool threw = false;
+            try {
+                t();
+            } catch (...) {
+                threw = true;
+            }
+            t = Task();                              // destroy captures outside the lock
+
+            lk.lock();
+            --running_;
+            if (threw) ++failed_;
+            if (queue_.empty() && running_ == 0) idle_.notify_all();
+        }
+    }
+
+    const std::size_t capacity_;
+    std::mutex m_;
+    std::condition_variable notEmpty_, notFull_, idle_;
+    std::deque<Task> queue_;
+    std::size_t running_ = 0;
+    std::size_t failed_ = 0;
+    bool stopping_ = false;
+    std::once_flag shutdownOnce_;
+    std::vector<std::thread> workers_;
+};
+
+// Process-wide executor: created on first use, drained when
+// static objects are destroyed (after main returns or exit())
+inline DetachedExecutor& backgroundExecutor() {
+    static DetachedExecutor executor;
+    return executor;
+}
+
+template <typename F, typename... Args>
+bool spawn_detached(F&& f, Args&&... args) {
+    return backgroundExecutor().spawn_detached(std::forward<F>(f), std::forward<Args>(args)...);
+}
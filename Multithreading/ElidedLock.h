@@ -0,0 +1,256 @@
+// ======================================================
+// ElidedLock.h — lock elision: a hardware transaction first, the lock after
+// ======================================================
+//
+// Mutex.cpp, MutextryLock.cpp, std::try_lock.cpp:
+//
+//     m.lock();  ++myAmount;  m.unlock();
+//
+// The critical section is one increment; the lock around it is
+// two atomic read-modify-writes on a line every thread writes.
+// When the threads touch DIFFERENT data under the same lock (one
+// lock over a table, X and Y under one mutex) they are serialized
+// for nothing.
+//
+// ElidedLock<Lock> wraps any lock and tries a hardware transaction
+// (Intel RTM, Arm TME) instead of taking it:
+//
+//   lock():   begin a transaction; READ the `held_` flag (it joins
+//             the read set) and abort if someone holds the lock
+//              - commit at unlock(): the section ran "under the
+//                lock" without writing the lock's line
+//              - abort (data conflict, capacity, interrupt, lock
+//                held): retry up to `retries` times, waiting for
+//                the lock to be free if that was the reason; then
+//                take the real lock and set `held_` — which aborts
+//                every transaction that read it
+//   unlock(): commit if in a transaction, else clear `held_` and
+//             unlock
+//   try_lock(): one transaction attempt, else Lock::try_lock()
+//
+// Two threads on disjoint data commit in parallel; on the same
+// counter they conflict, abort and end up on the lock — elision
+// helps only the first kind.
+//
+// WITHOUT HTM (most CPUs since the TSX microcode disables, or
+// `retries` = 0, or ELIDED_LOCK=0 in the environment)
+// lock() is Lock::lock() plus one counter bump: the plain lock.
+// x86 is detected at run time (CPUID.7.EBX.RTM; the functions are
+// compiled with target("rtm"), no -mrtm needed); Arm needs a build
+// with TME (-march=...+tme) and HWCAP2_TME.
+//
+// Inside a transaction the section must not do I/O, system calls
+// or anything else that always aborts: those sections just pay for
+// the attempts before falling back. Stats are per lock, counted in
+// per-thread slots after the transaction ends (a shared counter
+// would be a conflict in every transaction): 4 KB per lock.
+//
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include "CachePadded.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define ELIDED_LOCK_RTM 1
+#elif defined(__ARM_FEATURE_TME)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#define ELIDED_LOCK_TME 1
+#endif
+
+namespace elision {
+
+enum class Abort : int { LockHeld, Conflict, Capacity, Other, kCount };
+
+inline const char* abortName(Abort a) {
+    switch (a) {
+    case Abort::LockHeld: return "lock held";
+    case Abort::Conflict: return "conflict";
+    case Abort::Capacity: return "capacity";
+    default: return "other";
+    }
+}
+
+// One attempt's outcome: started, or why not (and whether retrying can help)
+struct Attempt {
+    bool started = false;
+    Abort reason = Abort::Other;
+    bool mayRetry = false;
+};
+
+constexpr unsigned kLockHeldCode = 0xFF;
+
+#if defined(ELIDED_LOCK_RTM)
+inline bool hardware() {
+    unsigned a, b, c, d;
+    return __get_cpuid_max(0, nullptr) >= 7 && __get_cpuid_count(7, 0, &a, &b, &c, &d) && (b & (1u << 11));
+}
+__attribute__((target("rtm"))) inline Attempt begin() {
+    const unsigned s = _xbegin();
+    if (s == _XBEGIN_STARTED) return {true, Abort::Other, false};
+    if ((s & _XABORT_EXPLICIT) && _XABORT_CODE(s) == kLockHeldCode) return {false, Abort::LockHeld, true};
+    if (s & _XABORT_CONFLICT) return {false, Abort::Conflict, (s & _XABORT_RETRY) != 0};
+    if (s & _XABORT_CAPACITY) return {false, Abort::Capacity, false};
+    return {false, Abort::Other, (s & _XABORT_RETRY) != 0};
+}
+__attribute__((target("rtm"))) inline void commit() { _xend(); }
+__attribute__((target("rtm"))) inline void abortHeld() { _xabort(kLockHeldCode); }
+__attribute__((target("rtm"))) inline bool inTransaction() { return _xtest() != 0; }
+#elif defined(ELIDED_LOCK_TME)
+inline bool hardware() {
+#if defined(HWCAP2_TME)
+    return (getauxval(AT_HWCAP2) & HWCAP2_TME) != 0;
+#else
+    return false;
+#endif
+}
+inline Attempt begin() {
+    const std::uint64_t s = __tstart();
+    if (s == 0) return {true, Abort::Other, false};
+    if ((s & _TMFAILURE_CNCL) && (s & _TMFAILURE_REASON) == kLockHeldCode) return {false, Abort::LockHeld, true};
+    if (s & _TMFAILURE_MEM) return {false, Abort::Conflict, (s & _TMFAILURE_RTRY) != 0};
+    if (s & _TMFAILURE_SIZE) return {false, Abort::Capacity, false};
+    return {false, Abort::Other, (s & _TMFAILURE_RTRY) != 0};
+}
+inline void commit() { __tcommit(); }
+inline void abortHeld() { __tcancel(kLockHeldCode); }
+inline bool inTransaction() { return __ttest() != 0; }
+#else
+inline bool hardware() { return false; }
+inline Attempt begin() { return {}; }
+inline void commit() {}
+inline void abortHeld() {}
+inline bool inTransaction() { return false; }
+#endif
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// HTM present and not switched off with ELIDED_LOCK=0
+inline bool available() {
+    static const bool on = [] {
+        const char* env = std::getenv("ELIDED_LOCK");
+        return hardware() && !(env && env[0] == '0');
+    }();
+    return on;
+}
+
+} // namespace elision
+
+template <typename Lock = std::mutex>
+class ElidedLock {
+public:
+    struct Stats {
+        std::uint64_t acquisitions = 0;              // lock() + successful try_lock()
+        std::uint64_t elided = 0;                    // committed transactions
+        std::uint64_t fallbacks = 0;                 // took the real lock
+        std::array<std::uint64_t, int(elision::Abort::kCount)> aborts{};
+    };
+
+    // retries: transaction attempts before taking the lock (0: never elide)
+    explicit ElidedLock(int retries = 3) : retries_(elision::available() ? retries : 0) {}
+    ElidedLock(const ElidedLock&) = delete;
+    ElidedLock& operator=(const ElidedLock&) = delete;
+
+    void lock() {
+        Slot& s = slot();
+        for (int attempt = 0; attempt < retries_; ++attempt) {
+            const elision::Attempt a = elision::begin();
+            if (a.started) {
+                if (!held_.load(std::memory_order_relaxed)) return;     // elided: held_ is in the read set
+                elision::abortHeld();
+            }
+            bump(s.aborts[int(a.reason)]);
+            if (!a.mayRetry) break;
+            if (a.reason == elision::Abort::LockHeld)
+                while (held_.load(std::memory_order_relaxed)) elision::cpuRelax();
+        }
+        lock_.lock();
+        if (retries_) held_.store(true, std::memory_order_relaxed);     // aborts the elided sections
+        bump(s.acquisitions);
+        bump(s.fallbacks);
+    }
+
+    bool try_lock() {
+        Slot& s = slot();
+        if (retries_) {
+            const elision::Attempt a = elision::begin();
+            if (a.started) {
+                if (!held_.load(std::memory_order_relaxed)) return true;
+                elision::abortHeld();
+            }
+            bump(s.aborts[int(a.reason)]);
+        }
+        if (!lock_.try_lock()) return false;
+        if (retries_) held_.store(true, std::memory_order_relaxed);
+        bump(s.acquisitions);
+        bump(s.fallbacks);
+        return true;
+    }
+
+    void unlock() {
+        if (retries_ && elision::inTransaction() && !held_.load(std::memory_order_relaxed)) {
+            elision::commit();
+            Slot& s = slot();                       // after the commit: not part of the transaction
+            bump(s.acquisitions);
+            bump(s.elided);
+            return;
+        }
+        if (retries_) held_.store(false, std::memory_order_relaxed);
+        lock_.unlock();
+    }
+
+    bool eliding() const { return retries_ > 0; }
+
+    // Sums the per-thread slots; exact once the threads are done
+    Stats stats() const {
+        Stats st;
+        for (const auto& p : slots_) {
+            const Slot& s = *p;
+            st.acquisitions += s.acquisitions.load(std::memory_order_relaxed);
+            st.elided += s.elided.load(std::memory_order_relaxed);
+            st.fallbacks += s.fallbacks.load(std::memory_order_relaxed);
+            for (int r = 0; r < int(elision::Abort::kCount); ++r)
+                st.aborts[r] += s.aborts[r].load(std::memory_order_relaxed);
+        }
+        return st;
+    }
+
+private:
+    static constexpr unsigned kSlots = 64;
+
+    struct Slot {
+        std::atomic<std::uint64_t> acquisitions{0}, elided{0}, fallbacks{0};
+        std::array<std::atomic<std::uint64_t>, int(elision::Abort::kCount)> aborts{};
+    };
+
+    // A plain load + store, not an RMW: the slot is this thread's
+    // unless more than kSlots threads use the lock (then a count
+    // can be lost, never torn)
+    static void bump(std::atomic<std::uint64_t>& c) {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    Slot& slot() {
+        static std::atomic<unsigned> next{0};
+        thread_local const unsigned mine = next.fetch_add(1, std::memory_order_relaxed) % kSlots;
+        return *slots_[mine];
+    }
+
+    // The lock and the flag a transaction reads: one line
+    alignas(cache_line_size) Lock lock_;
+    std::atomic<bool> held_{false};
+    const int retries_;
+    cache_padded<Slot> slots_[kSlots];
+};
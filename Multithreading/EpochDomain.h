@@ -0,0 +1,178 @@
+// ======================================================
+// EpochDomain.h — epoch-based reclamation with plain-load readers
+// ======================================================
+//
+// A writer that swaps a shared pointer cannot `delete` the old
+// object at once: a reader on another core may have loaded the
+// pointer a moment ago and still be reading through it. Epochs
+// tell the writer WHEN nobody can hold the old pointer any more:
+//
+// - a global epoch counter E
+// - a reader pins before touching shared objects: it announces
+//   "I'm reading in epoch E" in ITS OWN record (own cache line),
+//   and clears it when done (Guard)
+// - retire(p) tags p with the current E and puts it on the
+//   calling thread's retire list instead of freeing it
+// - E advances only once every pinned reader has announced the
+//   current E. A reader pinned now started after retirements
+//   tagged E - 2 were unlinked, so those can be freed: after two
+//   advances, nothing retired before them is reachable
+//
+// Read side without a locked instruction: the announcement must be
+// visible before the reader loads the pointer (store → load
+// order, normally a full fence). Here the reader issues only a
+// compiler fence, and the WRITER, before scanning the records,
+// asks the kernel to run a full barrier on every core that runs one
+// of our threads (membarrier, Linux ≥ 4.14). Where membarrier is
+// not available the reader falls back to a seq_cst fence.
+//
+// - retire lists are per thread and freed in batches
+//   (kBatch retirements trigger a collect())
+// - a thread that exits hands its list to the domain (orphans),
+//   it is freed by the next collect() of any thread
+//   (ReclaimRecords.h: the records, orphans and fences shared with
+//   HazardDomain.h)
+// - a reader that stays pinned blocks EVERY advance: garbage is
+//   UNBOUNDED under a stalled reader — keep guards short;
+//   pending() shows the garbage that is waiting. HazardDomain.h
+//   bounds it instead, at a price on every read (Reclaimer.h)
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "CachePadded.h"
+#include "ReclaimRecords.h"
+
+class EpochDomain {
+    struct Record;
+
+public:
+    static constexpr std::size_t kBatch = 64;        // retirements per thread between collects
+
+    EpochDomain() = default;
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    static EpochDomain& global() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    // Pinned for its lifetime; nests (only the outermost counts)
+    class Guard {
+    public:
+        explicit Guard(EpochDomain& d) : record_(d.enter()) {}
+        Guard(Guard&& o) noexcept : record_(std::exchange(o.record_, nullptr)) {}
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard() {
+            if (record_ && --record_->depth == 0) record_->epoch.store(0, std::memory_order_release);
+        }
+
+        // Pinned already: any pointer loaded now stays valid
+        template <typename T>
+        T* protect(const std::atomic<T*>& src) const {
+            return src.load(std::memory_order_acquire);
+        }
+
+    private:
+        Record* record_;
+    };
+
+    Guard pin() { return Guard(*this); }
+
+    // Free `p` (with delete) once no pinned reader can hold it.
+    // Call AFTER p is unreachable for new readers
+    template <typename T>
+    void retire(T* p) {
+        retire(p, [](void* q) { delete static_cast<T*>(q); });
+    }
+
+    void retire(void* p, void (*destroy)(void*)) {
+        Record* r = records_.mine();
+        r->retired.push_back({p, destroy, epoch_.load(std::memory_order_acquire)});
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        if (r->retired.size() >= kBatch) collect();
+    }
+
+    // Advance if possible, then free what the calling thread (and
+    // exited threads) retired long enough ago
+    void collect() {
+        tryAdvance();
+        const std::uint64_t now = epoch_.load(std::memory_order_acquire);
+        freeOlder(records_.mine()->retired, now);
+        records_.withOrphans([&](std::vector<reclaim_detail::Retired>& orphans) { freeOlder(orphans, now); });
+    }
+
+    // Block until every reader pinned now has unpinned, then free
+    // the caller's retired objects: a full grace period. The caller
+    // must not be pinned itself
+    void synchronize() {
+        const std::uint64_t target = epoch_.load(std::memory_order_acquire) + 2;
+        while (epoch_.load(std::memory_order_acquire) < target)
+            if (!tryAdvance()) std::this_thread::yield();
+        collect();
+    }
+
+    std::uint64_t epoch() const { return epoch_.load(std::memory_order_relaxed); }
+
+    // Retired, not yet freed (all threads; a snapshot)
+    std::size_t pending() const { return pending_.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(cache_line_size) Record {
+        std::atomic<std::uint64_t> epoch{0};         // 0: not pinned
+        unsigned depth = 0;                          // owner thread only
+        std::vector<reclaim_detail::Retired> retired;    // owner thread only
+        std::atomic<bool> inUse{true};
+        Record* next = nullptr;
+
+        void reset() {
+            depth = 0;
+            epoch.store(0, std::memory_order_release);
+        }
+    };
+
+    Record* enter() {
+        Record* r = records_.mine();
+        if (r->depth++ == 0) {
+            r->epoch.store(epoch_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            reclaim_detail::lightFence();            // announcement before any shared load
+        }
+        return r;
+    }
+
+    // E → E + 1 once no pinned reader is still in an older epoch
+    bool tryAdvance() {
+        std::uint64_t e = epoch_.load(std::memory_order_acquire);
+        reclaim_detail::heavyFence();                // readers' announcements are visible now
+        for (Record* r = records_.head(); r; r = r->next) {
+            const std::uint64_t seen = r->epoch.load(std::memory_order_acquire);
+            if (seen != 0 && seen != e) return false;
+        }
+        epoch_.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);     // lost: another thread advanced
+        return true;
+    }
+
+    // Objects retired in epoch r are free once the epoch is r + 2
+    void freeOlder(std::vector<reclaim_detail::Retired>& list, std::uint64_t now) {
+        std::size_t kept = 0;
+        for (const reclaim_detail::Retired& x : list) {
+            if (x.epoch + 2 <= now)
+                x.destroy(x.object);
+            else
+                list[kept++] = x;
+        }
+        pending_.fetch_sub(list.size() - kept, std::memory_order_relaxed);
+        list.resize(kept);
+    }
+
+    reclaim_detail::RecordList<Record> records_;
+    alignas(cache_line_size) std::atomic<std::uint64_t> epoch_{1};    // 0 marks "not pinned"
+    alignas(cache_line_size) std::atomic<std::size_t> pending_{0};
+};
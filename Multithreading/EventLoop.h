@@ -0,0 +1,608 @@
+// ======================================================
+// EventLoop.h — single-threaded coroutine event loop (epoll + timing wheel)
+// ======================================================
+//
+// jsVsCpp.cpp:
+//
+//     console.log("A");
+//     setTimeout(() => console.log("B"), 1000);
+//     console.log("C");                        // A, C, B
+//
+// JavaScript gets there with ONE thread and an event loop; the
+// C++ files here only ever answer concurrency with more threads
+// (one per connection = one stack per connection).
+//
+// EventLoop is the JS model in C++20:
+//   - Task<T>: a lazy coroutine; `co_await task` runs it and
+//     returns its value (or rethrows its exception)
+//   - loop.spawn(task): start a top-level task (like calling an
+//     async function without awaiting it); run() returns when
+//     every spawned task has finished — Node's "exit when
+//     nothing is pending"
+//   - awaitables (namespace ev), valid inside a running loop:
+//       co_await ev::sleep_for(100ms)        // setTimeout
+//       co_await ev::yield()                 // setTimeout(0)
+//       n = co_await ev::read(fd, buf, len)  // bytes or -errno
+//       n = co_await ev::write(fd, buf, len) // all of it, or -errno
+//       c = co_await ev::accept(listenFd)    // fd or -errno
+//
+// REACTOR: epoll, edge-triggered. A suspended read registers the
+// fd ONCE; afterwards each wait costs no system call besides the
+// shared epoll_wait. Every fd must be non-blocking
+// (ev::setNonBlocking) and closed through loop.close(fd) so its
+// registration is forgotten. One reader and one writer per fd.
+//
+// TIMERS: TimingWheel.h with 1 ms ticks. Add and cancel are
+// O(1) list splices; the timer node lives inside the awaiting
+// coroutine frame, so sleeping allocates nothing.
+//
+// SHARDING: ShardedEventLoop runs one EventLoop per core, each
+// on its own pinned thread (the "N loops, no shared state"
+// layout of nginx / seastar). Tasks are posted round-robin and
+// stay on their loop; ev::schedule(loop) hops to another loop.
+//
+// Cross-thread entry points: post(), stop(), ev::schedule().
+// Everything else belongs to the loop's own thread.
+//
+// Linux only. The Win32 counterpart would be an IOCP reactor
+// (completion instead of readiness), not provided here.
+//
+#pragma once
+
+#ifndef __linux__
+#error "EventLoop.h needs epoll (Linux)"
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "TimingWheel.h"
+
+class EventLoop;
+
+template <typename T = void>
+class Task;
+
+namespace event_loop_detail {
+
+inline thread_local EventLoop* currentLoop = nullptr;
+
+struct PromiseBase;
+void rootFinished(PromiseBase& p, std::coroutine_handle<> h) noexcept;
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;       // who awaits us; empty for a root
+    std::exception_ptr error;
+
+    // Spawned (root) tasks are linked into their loop
+    EventLoop* loop = nullptr;
+    PromiseBase* prev = nullptr;
+    PromiseBase* next = nullptr;
+    std::coroutine_handle<> self;
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        // Symmetric transfer back to the awaiter; a root frees itself
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+            PromiseBase& p = h.promise();
+            if (p.continuation) return p.continuation;
+            rootFinished(p, h);
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    template <typename U>
+    void return_value(U&& v) {
+        value.emplace(std::forward<U>(v));
+    }
+
+    T result() {
+        if (error) std::rethrow_exception(error);
+        return std::move(*value);
+    }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    void return_void() const noexcept {}
+
+    void result() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+// A sleeping coroutine's timer; lives inside its frame
+struct SleepNode : TimerNode {
+    std::coroutine_handle<> waiter;
+};
+
+}  // namespace event_loop_detail
+
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    struct promise_type : event_loop_detail::Promise<T> {
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+    };
+
+    Task(Task&& o) noexcept : h_(std::exchange(o.h_, {})) {}
+    Task& operator=(Task&&) = delete;
+    ~Task() {
+        if (h_) h_.destroy();
+    }
+
+    // co_await task: start it, resume the caller when it finishes
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        h_.promise().continuation = caller;
+        return h_;
+    }
+    T await_resume() { return h_.promise().result(); }
+
+private:
+    friend class EventLoop;
+    explicit Task(std::coroutine_handle<promise_type> h) : h_(h) {}
+    std::coroutine_handle<promise_type> release() { return std::exchange(h_, {}); }
+
+    std::coroutine_handle<promise_type> h_;
+};
+
+class EventLoop {
+public:
+    using clock = std::chrono::steady_clock;
+
+    // Throws std::system_error if epoll or eventfd cannot be created
+    EventLoop() : origin_(clock::now()) {
+        epfd_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epfd_ < 0) throw std::system_error(errno, std::generic_category(), "epoll_create1");
+        wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = wakeFd_;
+        if (wakeFd_ < 0 || epoll_ctl(epfd_, EPOLL_CTL_ADD, wakeFd_, &ev) != 0) {
+            int err = errno;
+            if (wakeFd_ >= 0) ::close(wakeFd_);
+            ::close(epfd_);
+            throw std::system_error(err, std::generic_category(), "eventfd");
+        }
+    }
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    // Unfinished tasks are destroyed (their awaiters unregister)
+    ~EventLoop() {
+        for (auto& r : remote_)
+            if (r.root) r.h.destroy();
+        while (roots_) {
+            event_loop_detail::PromiseBase* p = roots_;
+            unlinkRoot(*p);
+            p->self.destroy();
+        }
+        ::close(wakeFd_);
+        ::close(epfd_);
+    }
+
+    // The loop running on this thread (only valid inside run()/serve())
+    static EventLoop& current() { return *event_loop_detail::currentLoop; }
+
+    // Loop thread (or before run()): starts t on the next turn
+    void spawn(Task<void> t) {
+        auto h = t.release();
+        adopt(h);
+        ready_.push_back(h);
+    }
+
+    // Any thread
+    void post(Task<void> t) {
+        {
+            std::lock_guard<std::mutex> lg(remoteLock_);
+            remote_.push_back({t.release(), true});
+        }
+        wake();
+    }
+
+    // Runs until every spawned task has finished (or stop())
+    void run() { loop(true); }
+
+    // Runs until stop(), idle or not
+    void serve() { loop(false); }
+
+    // Any thread: run()/serve() return after the current turn
+    void stop() {
+        stop_.store(true, std::memory_order_relaxed);
+        wake();
+    }
+
+    std::size_t tasks() const { return rootCount_; }
+    std::size_t timers() const { return wheel_.size(); }
+
+    // Forgets the fd's registration, then closes it
+    void close(int fd) {
+        if (fd >= 0 && static_cast<std::size_t>(fd) < fds_.size()) fds_[fd] = FdState{};
+        ::close(fd);
+    }
+
+    // ---------------- awaitables (see namespace ev) ----------------
+
+    class SleepAwaiter {
+    public:
+        SleepAwaiter(EventLoop& loop, clock::duration d) : loop_(loop), d_(d) {}
+        SleepAwaiter(const SleepAwaiter&) = delete;
+        SleepAwaiter& operator=(const SleepAwaiter&) = delete;
+        ~SleepAwaiter() {
+            if (node_.linked()) loop_.wheel_.remove(&node_);
+        }
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            if (d_ <= clock::duration::zero()) {
+                loop_.ready_.push_back(h);                      // yield: back of the queue
+                return;
+            }
+            node_.waiter = h;
+            node_.expiry = loop_.tickAt(clock::now() + d_);
+            loop_.wheel_.add(&node_);
+        }
+        void await_resume() const noexcept {}
+
+    private:
+        EventLoop& loop_;
+        clock::duration d_;
+        event_loop_detail::SleepNode node_;
+    };
+
+    class FdAwaiter {
+    public:
+        FdAwaiter(EventLoop& loop, int fd, bool write) : loop_(loop), fd_(fd), write_(write) {}
+        FdAwaiter(const FdAwaiter&) = delete;
+        FdAwaiter& operator=(const FdAwaiter&) = delete;
+        ~FdAwaiter() {
+            if (!h_ || static_cast<std::size_t>(fd_) >= loop_.fds_.size()) return;
+            std::coroutine_handle<>& slot = waiterSlot();
+            if (slot == h_) slot = {};                          // destroyed while waiting
+        }
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> h) {
+            err_ = loop_.watch(fd_);
+            if (err_) return false;
+            h_ = h;
+            waiterSlot() = h;
+            return true;
+        }
+        void await_resume() const {
+            if (err_) throw std::system_error(err_, std::generic_category(), "epoll_ctl");
+        }
+
+    private:
+        std::coroutine_handle<>& waiterSlot() {
+            FdState& s = loop_.fds_[fd_];
+            return write_ ? s.writer : s.reader;
+        }
+
+        EventLoop& loop_;
+        int fd_;
+        bool write_;
+        int err_ = 0;
+        std::coroutine_handle<> h_;
+    };
+
+    // Resumes the awaiting coroutine on THIS loop (any thread)
+    class ScheduleAwaiter {
+    public:
+        explicit ScheduleAwaiter(EventLoop& loop) : loop_(loop) {}
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            {
+                std::lock_guard<std::mutex> lg(loop_.remoteLock_);
+                loop_.remote_.push_back({h, false});
+            }
+            loop_.wake();
+        }
+        void await_resume() const noexcept {}
+
+    private:
+        EventLoop& loop_;
+    };
+
+private:
+    friend void event_loop_detail::rootFinished(event_loop_detail::PromiseBase&, std::coroutine_handle<>) noexcept;
+
+    struct FdState {
+        std::coroutine_handle<> reader;
+        std::coroutine_handle<> writer;
+        bool registered = false;
+    };
+
+    struct Remote {
+        std::coroutine_handle<> h;
+        bool root;                                              // a posted task, not a hop
+    };
+
+    static constexpr int kMaxEvents = 256;
+
+    void loop(bool untilIdle) {
+        EventLoop* outer = std::exchange(event_loop_detail::currentLoop, this);
+        struct Restore {
+            EventLoop* outer;
+            ~Restore() { event_loop_detail::currentLoop = outer; }
+        } restore{outer};
+
+        while (!stop_.load(std::memory_order_relaxed)) {
+            takeRemote();
+            runReady();
+            if (error_) {
+                stop_.store(false, std::memory_order_relaxed);
+                std::rethrow_exception(std::exchange(error_, nullptr));
+            }
+            if (untilIdle && rootCount_ == 0 && ready_.empty() && !remotePending()) break;
+            poll(ready_.empty() ? timeoutMs() : 0);
+            wheel_.advance(ticksNow(), [this](TimerNode* n) {
+                ready_.push_back(static_cast<event_loop_detail::SleepNode*>(n)->waiter);
+            });
+        }
+        stop_.store(false, std::memory_order_relaxed);
+    }
+
+    // One batch per turn: what becomes ready meanwhile waits for
+    // the next turn, after I/O has been polled (no starvation)
+    void runReady() {
+        running_.swap(ready_);
+        for (std::coroutine_handle<> h : running_) h.resume();
+        running_.clear();
+    }
+
+    void takeRemote() {
+        std::lock_guard<std::mutex> lg(remoteLock_);
+        for (const Remote& r : remote_) {
+            if (r.root) adopt(std::coroutine_handle<Task<void>::promise_type>::from_address(r.h.address()));
+            ready_.push_back(r.h);
+        }
+        remote_.clear();
+    }
+
+    bool remotePending() {
+        std::lock_guard<std::mutex> lg(remoteLock_);
+        return !remote_.empty();
+    }
+
+    void poll(int timeout) {
+        epoll_event evs[kMaxEvents];
+        int n = epoll_wait(epfd_, evs, kMaxEvents, timeout);
+        for (int i = 0; i < n; ++i) {
+            int fd = evs[i].data.fd;
+            if (fd == wakeFd_) {
+                std::uint64_t v;
+                if (::read(wakeFd_, &v, sizeof v) < 0) {
+                }
+                continue;
+            }
+            FdState& s = fds_[fd];
+            std::uint32_t e = evs[i].events;
+            if ((e & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) && s.reader)
+                ready_.push_back(std::exchange(s.reader, {}));
+            if ((e & (EPOLLOUT | EPOLLHUP | EPOLLERR)) && s.writer) ready_.push_back(std::exchange(s.writer, {}));
+        }
+    }
+
+    void wake() {
+        std::uint64_t one = 1;
+        if (::write(wakeFd_, &one, sizeof one) < 0) {
+        }
+    }
+
+    // 0 or errno. Registered once, for both directions, edge-triggered
+    int watch(int fd) {
+        if (fd < 0) return EBADF;
+        if (static_cast<std::size_t>(fd) >= fds_.size()) fds_.resize(static_cast<std::size_t>(fd) + 1);
+        FdState& s = fds_[fd];
+        if (s.registered) return 0;
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.fd = fd;
+        if (epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) != 0) return errno;
+        s.registered = true;
+        return 0;
+    }
+
+    std::uint64_t ticksNow() const {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - origin_).count());
+    }
+
+    // First tick at or after t
+    std::uint64_t tickAt(clock::time_point t) const {
+        return static_cast<std::uint64_t>(std::chrono::ceil<std::chrono::milliseconds>(t - origin_).count());
+    }
+
+    int timeoutMs() const {
+        std::optional<std::uint64_t> due = wheel_.nextWake();
+        if (!due) return -1;
+        std::uint64_t now = ticksNow();
+        return *due <= now ? 0 : static_cast<int>(*due - now);
+    }
+
+    void adopt(std::coroutine_handle<Task<void>::promise_type> h) {
+        event_loop_detail::PromiseBase& p = h.promise();
+        p.loop = this;
+        p.self = h;
+        p.prev = nullptr;
+        p.next = roots_;
+        if (roots_) roots_->prev = &p;
+        roots_ = &p;
+        ++rootCount_;
+    }
+
+    void unlinkRoot(event_loop_detail::PromiseBase& p) {
+        if (p.prev) p.prev->next = p.next;
+        else roots_ = p.next;
+        if (p.next) p.next->prev = p.prev;
+        --rootCount_;
+    }
+
+    int epfd_ = -1;
+    int wakeFd_ = -1;
+    clock::time_point origin_;
+    std::atomic<bool> stop_{false};
+
+    std::vector<std::coroutine_handle<>> ready_, running_;
+    TimingWheel wheel_;
+    std::vector<FdState> fds_;                                  // indexed by fd
+
+    event_loop_detail::PromiseBase* roots_ = nullptr;
+    std::size_t rootCount_ = 0;
+    std::exception_ptr error_;                                  // first escaped exception
+
+    std::mutex remoteLock_;
+    std::vector<Remote> remote_;
+};
+
+namespace event_loop_detail {
+
+// A root task ends: unlink, keep its exception for run(), free it
+inline void rootFinished(PromiseBase& p, std::coroutine_handle<> h) noexcept {
+    EventLoop* loop = p.loop;
+    loop->unlinkRoot(p);
+    if (p.error && !loop->error_) loop->error_ = p.error;
+    h.destroy();
+}
+
+}  // namespace event_loop_detail
+
+// N loops on N pinned threads; each task stays on the loop it was posted to
+class ShardedEventLoop {
+public:
+    explicit ShardedEventLoop(unsigned shards = std::thread::hardware_concurrency(), bool pinToCores = true) {
+        if (shards == 0) shards = 1;
+        for (unsigned i = 0; i < shards; ++i) loops_.push_back(std::make_unique<EventLoop>());
+        unsigned cores = std::thread::hardware_concurrency();
+        for (unsigned i = 0; i < shards; ++i) {
+            threads_.emplace_back([this, i, pinToCores, cores] {
+                if (pinToCores && cores > 0) {
+                    cpu_set_t set;
+                    CPU_ZERO(&set);
+                    CPU_SET(i % cores, &set);
+                    pthread_setaffinity_np(pthread_self(), sizeof set, &set);
+                }
+                loops_[i]->serve();
+            });
+        }
+    }
+
+    ShardedEventLoop(const ShardedEventLoop&) = delete;
+    ShardedEventLoop& operator=(const ShardedEventLoop&) = delete;
+    ~ShardedEventLoop() { stop(); }
+
+    std::size_t size() const { return loops_.size(); }
+    EventLoop& shard(std::size_t i) { return *loops_[i]; }
+
+    // Any thread: round-robin over the shards
+    void spawn(Task<void> t) {
+        loops_[next_.fetch_add(1, std::memory_order_relaxed) % loops_.size()]->post(std::move(t));
+    }
+
+    // Stops every loop and joins its thread (unfinished tasks are
+    // destroyed with the loops)
+    void stop() {
+        for (auto& l : loops_) l->stop();
+        for (auto& t : threads_)
+            if (t.joinable()) t.join();
+    }
+
+private:
+    std::vector<std::unique_ptr<EventLoop>> loops_;
+    std::vector<std::thread> threads_;
+    std::atomic<std::size_t> next_{0};
+};
+
+namespace ev {
+
+template <typename Rep, typename Period>
+EventLoop::SleepAwaiter sleep_for(const std::chrono::duration<Rep, Period>& d) {
+    return {EventLoop::current(), std::chrono::ceil<EventLoop::clock::duration>(d)};
+}
+
+inline EventLoop::SleepAwaiter yield() { return {EventLoop::current(), EventLoop::clock::duration::zero()}; }
+
+inline EventLoop::FdAwaiter readable(int fd) { return {EventLoop::current(), fd, false}; }
+inline EventLoop::FdAwaiter writable(int fd) { return {EventLoop::current(), fd, true}; }
+
+// Continue on `loop` (may be another thread's loop)
+inline EventLoop::ScheduleAwaiter schedule(EventLoop& loop) { return EventLoop::ScheduleAwaiter(loop); }
+
+inline bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Bytes read (0 = end of stream) or -errno
+inline Task<ssize_t> read(int fd, void* buf, std::size_t len) {
+    for (;;) {
+        ssize_t r = ::read(fd, buf, len);
+        if (r >= 0) co_return r;
+        if (errno == EINTR) continue;
+        if (errno != EAGAIN && errno != EWOULDBLOCK) co_return -errno;
+        co_await readable(fd);
+    }
+}
+
+// Writes all len bytes: len, or -errno
+inline Task<ssize_t> write(int fd, const void* buf, std::size_t len) {
+    std::size_t done = 0;
+    while (done < len) {
+        ssize_t r = ::write(fd, static_cast<const char*>(buf) + done, len - done);
+        if (r >= 0) {
+            done += static_cast<std::size_t>(r);
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            co_await writable(fd);
+        } else if (errno != EINTR) {
+            co_return -errno;
+        }
+    }
+    co_return static_cast<ssize_t>(done);
+}
+
+// A connected, non-blocking fd, or -errno
+inline Task<int> accept(int listenFd) {
+    for (;;) {
+        int c = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (c >= 0) co_return c;
+        if (errno == EINTR) continue;
+        if (errno != EAGAIN && errno != EWOULDBLOCK) co_return -errno;
+        co_await readable(listenFd);
+    }
+}
+
+}  // namespace ev
@@ -0,0 +1,187 @@
+// ======================================================
+// FairLocks.h — FIFO locks: ticket lock and MCS queue lock
+// ======================================================
+//
+// starvation.txt / LockGuard.cpp:
+//
+//     std::lock_guard<std::mutex> lock(m1);     // in task(), N threads
+//
+// std::mutex promises nothing about WHO gets the lock next. A
+// thread that just unlocked can take it straight back (it is
+// running, the waiters are asleep), so under load one thread may
+// win many times in a row while another waits far longer than
+// everyone else — the long tail.
+//
+// Both locks here hand the lock over in arrival order (FIFO):
+//
+// TicketLock    take a number (next_++), wait until serving_ shows
+//               it; unlock() = ++serving_. Fair and tiny, but every
+//               waiter watches the SAME serving_ line: each unlock
+//               invalidates it in every waiting core's cache
+// McsLock       waiters form a linked queue; each spins on a flag
+//               in its OWN node (own cache line) and unlock() sets
+//               only the successor's flag — one line moves per
+//               handoff, however many threads wait
+//
+// Waiting: spin a little (multi-core only), then sleep in the
+// kernel (std::atomic wait/notify — a futex on Linux). unlock()
+// wakes the next owner only when it actually went to sleep.
+//
+// The price of FIFO is the handoff: the lock goes to a waiter that
+// may have to be woken up first, where std::mutex would let the
+// running thread barge in. fairLock.cpp measures both sides.
+//
+// Both meet the Lockable requirements (lock / try_lock / unlock),
+// so std::lock_guard, std::unique_lock and std::scoped_lock work.
+// McsLock's queue nodes are per thread: a thread may hold up to
+// McsLock::kMaxHeld MCS locks at once, in any order.
+//
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include "CachePadded.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FAIRLOCK_PAUSE() _mm_pause()
+#elif defined(__aarch64__)
+#define FAIRLOCK_PAUSE() asm volatile("yield")
+#else
+#define FAIRLOCK_PAUSE() ((void)0)
+#endif
+
+namespace fairlock_detail {
+
+// Pause instructions before a waiter sleeps; 0 with one CPU, where
+// spinning only delays the thread we wait for
+inline unsigned spinLimit() {
+    static const unsigned limit = std::thread::hardware_concurrency() > 1 ? 2000 : 0;
+    return limit;
+}
+
+}  // namespace fairlock_detail
+
+class TicketLock {
+public:
+    TicketLock() = default;
+    TicketLock(const TicketLock&) = delete;
+    TicketLock& operator=(const TicketLock&) = delete;
+
+    void lock() {
+        const std::uint32_t mine = next_.fetch_add(1, std::memory_order_relaxed);
+        std::uint32_t now = serving_.load(std::memory_order_acquire);
+        for (unsigned spins = 0; now != mine && spins < fairlock_detail::spinLimit(); ++spins) {
+            FAIRLOCK_PAUSE();
+            now = serving_.load(std::memory_order_acquire);
+        }
+        if (now == mine) return;
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        while ((now = serving_.load(std::memory_order_seq_cst)) != mine) serving_.wait(now, std::memory_order_seq_cst);
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool try_lock() {
+        std::uint32_t now = serving_.load(std::memory_order_relaxed);
+        std::uint32_t expected = now;
+        return next_.compare_exchange_strong(expected, now + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() {
+        serving_.fetch_add(1, std::memory_order_seq_cst);
+        // Every sleeper checks its own number: wake them all
+        if (sleepers_.load(std::memory_order_seq_cst) != 0) serving_.notify_all();
+    }
+
+private:
+    alignas(cache_line_size) std::atomic<std::uint32_t> next_{0};
+    alignas(cache_line_size) std::atomic<std::uint32_t> serving_{0};
+    std::atomic<std::uint32_t> sleepers_{0};
+};
+
+class McsLock {
+public:
+    static constexpr int kMaxHeld = 8;               // MCS locks one thread may hold at once
+
+    McsLock() = default;
+    McsLock(const McsLock&) = delete;
+    McsLock& operator=(const McsLock&) = delete;
+
+    void lock() {
+        Node* me = acquireNode();
+        Node* pred = tail_.exchange(me, std::memory_order_acq_rel);
+        if (pred) {
+            pred->next.store(me, std::memory_order_release);
+            waitForGrant(me);
+        }
+        owner_ = me;
+    }
+
+    bool try_lock() {
+        Node* me = acquireNode();
+        Node* expected = nullptr;
+        if (!tail_.compare_exchange_strong(expected, me, std::memory_order_acquire, std::memory_order_relaxed)) {
+            releaseNode(me);
+            return false;
+        }
+        owner_ = me;
+        return true;
+    }
+
+    void unlock() {
+        Node* me = owner_;
+        Node* succ = me->next.load(std::memory_order_acquire);
+        if (!succ) {
+            Node* expected = me;
+            if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed)) {
+                releaseNode(me);
+                return;
+            }
+            // A thread swapped itself in but has not linked yet
+            while (!(succ = me->next.load(std::memory_order_acquire))) FAIRLOCK_PAUSE();
+        }
+        releaseNode(me);
+        if (succ->state.exchange(kGranted, std::memory_order_release) == kSleeping) succ->state.notify_one();
+    }
+
+private:
+    static constexpr std::uint32_t kWaiting = 0, kSleeping = 1, kGranted = 2;
+
+    struct alignas(cache_line_size) Node {
+        std::atomic<Node*> next{nullptr};
+        std::atomic<std::uint32_t> state{kWaiting};
+        bool inUse = false;
+    };
+
+    // Spin on our own node, then sleep on it
+    static void waitForGrant(Node* me) {
+        for (unsigned spins = 0; spins < fairlock_detail::spinLimit(); ++spins) {
+            if (me->state.load(std::memory_order_acquire) == kGranted) return;
+            FAIRLOCK_PAUSE();
+        }
+        std::uint32_t expected = kWaiting;
+        if (!me->state.compare_exchange_strong(expected, kSleeping, std::memory_order_acquire)) return;   // granted
+        while (me->state.load(std::memory_order_acquire) != kGranted) me->state.wait(kSleeping, std::memory_order_acquire);
+    }
+
+    static Node* acquireNode() {
+        thread_local Node nodes[kMaxHeld];
+        for (Node& n : nodes)
+            if (!n.inUse) {
+                n.inUse = true;
+                n.next.store(nullptr, std::memory_order_relaxed);
+                n.state.store(kWaiting, std::memory_order_relaxed);
+                return &n;
+            }
+        throw std::logic_error("McsLock: a thread holds more than kMaxHeld MCS locks");
+    }
+
+    // Only the owning thread reads inUse; the successor has stopped
+    // touching `n` by the time unlock() gets here
+    static void releaseNode(Node* n) { n->inUse = false; }
+
+    alignas(cache_line_size) std::atomic<Node*> tail_{nullptr};
+    Node* owner_ = nullptr;                          // written by the holder only
+};
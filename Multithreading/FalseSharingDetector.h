@@ -0,0 +1,227 @@
+// ======================================================
+// FalseSharingDetector.h — which hot globals share a cache line?
+// ======================================================
+//
+// Mutex.cpp / std::try_lock.cpp / MutextryLock.cpp / threadSync.cpp:
+//
+//     int myAmount = 0;  std::mutex m;
+//     int X = 0, Y = 0;  std::mutex m1, m2;
+//     int counter = 0;   long long bankBalance = 0;
+//
+// Whether two of these share a line is decided by the linker, and
+// whether that HURTS by which threads touch them. The detector
+// answers both for an instrumented build:
+//
+//     auto& fs = FalseSharingDetector::global();
+//     fs.watch("X", X);  fs.watch("m1", m1);  ...    // before the threads
+//     ...
+//     FS_WRITE(X);  ++X;                             // at the hot accesses
+//     ...
+//     fs.report(std::cout);
+//
+// - watch() records a variable's address range; lines are
+//   cache_line_size (CachePadded.h) bytes
+// - FS_WRITE / FS_READ count accesses per variable and per thread
+//   (slot per thread, relaxed atomics). They compile to nothing
+//   unless FALSE_SHARING_DETECT is defined — the instrumented build
+// - sharedLines() / report(): every line holding two or more
+//   watched variables, hottest first, with a verdict:
+//     FALSE SHARING  a variable written by one thread shares
+//                    the line with a variable another thread uses
+//     shared, same threads   only one thread set uses the line
+//                    (e.g. a value next to its own mutex): fine
+//     cold           nobody touched it
+//
+// falseSharingReport.sh does the same without instrumentation:
+// perf c2c (HITM samples) where the PMU allows, else the address
+// overlap of a binary's globals from its symbol table.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "CachePadded.h"
+
+class FalseSharingDetector {
+public:
+    static constexpr int kMaxThreads = 64;           // later threads share the last slot
+
+    struct Variable {
+        std::string name;
+        std::uintptr_t address;
+        std::size_t size;
+        std::uint64_t reads[kMaxThreads];
+        std::uint64_t writes[kMaxThreads];
+    };
+
+    struct SharedLine {
+        std::uintptr_t line;                         // address / cache_line_size
+        std::vector<const Variable*> variables;
+        std::uint64_t accesses = 0;
+        bool falseSharing = false;
+    };
+
+    static FalseSharingDetector& global() {
+        static FalseSharingDetector detector;
+        return detector;
+    }
+
+    // Register before any thread notes an access (not thread-safe)
+    template <typename T>
+    void watch(const char* name, const T& variable) {
+        watch(name, &variable, sizeof(T));
+    }
+
+    void watch(const char* name, const void* address, std::size_t size) {
+        auto v = std::make_unique<Counters>();
+        v->name = name;
+        v->address = reinterpret_cast<std::uintptr_t>(address);
+        v->size = size;
+        vars_.push_back(std::move(v));
+        std::sort(vars_.begin(), vars_.end(), [](const auto& a, const auto& b) { return a->address < b->address; });
+    }
+
+    void noteRead(const void* p) { note(p, false); }
+    void noteWrite(const void* p) { note(p, true); }
+
+    void reset() {
+        for (auto& v : vars_)
+            for (int t = 0; t < kMaxThreads; ++t) {
+                v->readCount[t].store(0, std::memory_order_relaxed);
+                v->writeCount[t].store(0, std::memory_order_relaxed);
+            }
+    }
+
+    // Lines with two or more watched variables, most accessed first
+    std::vector<SharedLine> sharedLines() {
+        snapshot();
+        std::vector<SharedLine> lines;
+        for (const auto& v : vars_) {
+            const std::uintptr_t first = v->address / cache_line_size;
+            const std::uintptr_t last = (v->address + (v->size ? v->size : 1) - 1) / cache_line_size;
+            for (std::uintptr_t l = first; l <= last; ++l) {
+                auto it = std::find_if(lines.begin(), lines.end(), [&](const SharedLine& s) { return s.line == l; });
+                if (it == lines.end()) {
+                    lines.push_back({l, {}, 0, false});
+                    it = lines.end() - 1;
+                }
+                it->variables.push_back(&v->view);
+            }
+        }
+        lines.erase(std::remove_if(lines.begin(), lines.end(), [](const SharedLine& s) { return s.variables.size() < 2; }),
+                    lines.end());
+        for (SharedLine& s : lines) {
+            for (const Variable* v : s.variables)
+                for (int t = 0; t < kMaxThreads; ++t) s.accesses += v->reads[t] + v->writes[t];
+            // a written by thread t, b (another variable) used by thread u != t
+            for (const Variable* a : s.variables)
+                for (const Variable* b : s.variables) {
+                    if (a == b) continue;
+                    for (int t = 0; t < kMaxThreads && !s.falseSharing; ++t) {
+                        if (!a->writes[t]) continue;
+                        for (int u = 0; u < kMaxThreads; ++u)
+                            if (u != t && (b->reads[u] || b->writes[u])) {
+                                s.falseSharing = true;
+                                break;
+                            }
+                    }
+                }
+        }
+        std::stable_sort(lines.begin(), lines.end(),
+                         [](const SharedLine& a, const SharedLine& b) { return a.accesses > b.accesses; });
+        return lines;
+    }
+
+    // Variables on the same line as `name` that other threads use
+    // while `name` is written — the ones to pad apart
+    bool falselyShared(const std::string& name) {
+        for (const SharedLine& s : sharedLines())
+            if (s.falseSharing)
+                for (const Variable* v : s.variables)
+                    if (v->name == name) return true;
+        return false;
+    }
+
+    void report(std::ostream& out) {
+        const std::vector<SharedLine> lines = sharedLines();
+        if (lines.empty()) {
+            out << "  no cache line holds two watched variables\n";
+            return;
+        }
+        char buf[160];
+        for (const SharedLine& s : lines) {
+            std::snprintf(buf, sizeof buf, "  line 0x%llx: %llu accesses, %s\n",
+                          static_cast<unsigned long long>(s.line * cache_line_size),
+                          static_cast<unsigned long long>(s.accesses),
+                          s.falseSharing ? "FALSE SHARING" : s.accesses ? "shared, same threads" : "cold");
+            out << buf;
+            for (const Variable* v : s.variables) {
+                std::uint64_t r = 0, w = 0;
+                std::string threads;
+                for (int t = 0; t < kMaxThreads; ++t) {
+                    r += v->reads[t];
+                    w += v->writes[t];
+                    if (v->reads[t] || v->writes[t]) threads += (threads.empty() ? "" : ",") + std::to_string(t);
+                }
+                std::snprintf(buf, sizeof buf, "    +%-3llu %-16s %4zu B  %10llu writes %10llu reads  threads {%s}\n",
+                              static_cast<unsigned long long>(v->address % cache_line_size), v->name.c_str(), v->size,
+                              static_cast<unsigned long long>(w), static_cast<unsigned long long>(r), threads.c_str());
+                out << buf;
+            }
+        }
+    }
+
+private:
+    struct Counters {
+        std::string name;
+        std::uintptr_t address;
+        std::size_t size;
+        std::atomic<std::uint64_t> readCount[kMaxThreads] = {};
+        std::atomic<std::uint64_t> writeCount[kMaxThreads] = {};
+        Variable view;                               // filled by snapshot()
+    };
+
+    static int threadSlot() {
+        static std::atomic<int> next{0};
+        thread_local const int slot = std::min(next.fetch_add(1, std::memory_order_relaxed), kMaxThreads - 1);
+        return slot;
+    }
+
+    void note(const void* p, bool write) {
+        const std::uintptr_t a = reinterpret_cast<std::uintptr_t>(p);
+        auto it = std::upper_bound(vars_.begin(), vars_.end(), a, [](std::uintptr_t x, const auto& v) { return x < v->address; });
+        if (it == vars_.begin()) return;
+        Counters& v = **(it - 1);
+        if (a >= v.address + std::max<std::size_t>(v.size, 1)) return;
+        (write ? v.writeCount : v.readCount)[threadSlot()].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void snapshot() {
+        for (auto& v : vars_) {
+            v->view.name = v->name;
+            v->view.address = v->address;
+            v->view.size = v->size;
+            for (int t = 0; t < kMaxThreads; ++t) {
+                v->view.reads[t] = v->readCount[t].load(std::memory_order_relaxed);
+                v->view.writes[t] = v->writeCount[t].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Counters>> vars_;
+};
+
+#ifdef FALSE_SHARING_DETECT
+#define FS_WRITE(var) FalseSharingDetector::global().noteWrite(&(var))
+#define FS_READ(var) FalseSharingDetector::global().noteRead(&(var))
+#else
+#define FS_WRITE(var) ((void)0)
+#define FS_READ(var) ((void)0)
+#endif
@@ -0,0 +1,121 @@
+// ======================================================
+// FlatCombiningCounter.h — try_lock that never loses an increment
+// ======================================================
+//
+// MutextryLock.cpp:
+//
+//     if (mtx.try_lock()) {
+//         ++counter;
+//         mtx.unlock();
+//     }                                   // busy → increment LOST
+//
+// The usual fix is lock(): correct, but every busy moment now
+// queues (and on contention sleeps) behind the holder.
+//
+// FlatCombiningCounter keeps try_lock's "never wait" and loses
+// nothing:
+//   - try_lock() succeeds → add directly, then apply everything
+//     other threads left pending (one pass), unlock
+//   - try_lock() fails   → publish the increment in the thread's
+//     own padded slot and return immediately; the current (or
+//     next) lock holder COMBINES it into the total
+//   - value() takes the lock and combines every slot, so it sees
+//     every add() that completed before the call
+//
+// The lock holder only scans the slots when the `pending` hint
+// says someone published; the uncontended path is try_lock +
+// add + unlock, and a publish is one RMW on the thread's own
+// cache line. Threads are mapped to slots round-robin; threads
+// sharing a slot stay correct (fetch_add), just less independent.
+//
+// Increments only: an operation that needs a result back would
+// have to wait for its combiner (classic flat combining), which
+// this counter avoids.
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+template <typename T = long, typename Mutex = std::mutex>
+class FlatCombiningCounter {
+    static_assert(std::is_integral_v<T>, "FlatCombiningCounter: integral T");
+
+public:
+    struct Stats {
+        std::uint64_t direct = 0;        // adds made by the lock holder itself
+        std::uint64_t published = 0;     // adds left in a slot (try_lock failed)
+        std::uint64_t passes = 0;        // combining scans
+    };
+
+    explicit FlatCombiningCounter(std::size_t slots = 64)
+        : slotCount_(slots == 0 ? 1 : slots), slots_(new Slot[slotCount_]) {}
+
+    FlatCombiningCounter(const FlatCombiningCounter&) = delete;
+    FlatCombiningCounter& operator=(const FlatCombiningCounter&) = delete;
+
+    void add(T v = 1) {
+        if (m_.try_lock()) {
+            total_ += v;
+            ++stats_.direct;
+            if (pending_.load(std::memory_order_relaxed) != 0) combine();
+            m_.unlock();
+            return;
+        }
+        Slot& s = slots_[slotIndex()];
+        s.count.store(s.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);   // approximate
+        // Only the add that makes the slot non-zero raises the hint;
+        // later ones land before that slot is cleared
+        if (s.value.fetch_add(v, std::memory_order_seq_cst) == 0) pending_.store(1, std::memory_order_seq_cst);
+    }
+
+    // Exact: includes every add() that returned before this call
+    T value() {
+        std::lock_guard<Mutex> lg(m_);
+        combine();
+        return total_;
+    }
+
+    Stats stats() {
+        std::lock_guard<Mutex> lg(m_);
+        Stats s = stats_;
+        for (std::size_t i = 0; i < slotCount_; ++i) s.published += slots_[i].count.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<T> value{0};
+        std::atomic<std::uint64_t> count{0};                // statistics only (racy if shared)
+    };
+
+    // Clearing the hint BEFORE the scan: a publisher whose slot
+    // add the scan misses raises the hint after it, so the next
+    // holder (or value()) scans again. All seq_cst: the argument
+    // needs one total order (the loads are plain movs on x86).
+    void combine() {
+        pending_.store(0, std::memory_order_seq_cst);
+        ++stats_.passes;
+        for (std::size_t i = 0; i < slotCount_; ++i) {
+            if (slots_[i].value.load(std::memory_order_seq_cst) != 0)
+                total_ += slots_[i].value.exchange(0, std::memory_order_seq_cst);
+        }
+    }
+
+    std::size_t slotIndex() const {
+        static std::atomic<std::size_t> nextThread{0};
+        thread_local const std::size_t thread = nextThread.fetch_add(1, std::memory_order_relaxed);
+        return thread % slotCount_;
+    }
+
+    Mutex m_;
+    T total_ = 0;                                           // guarded by m_
+    Stats stats_;                                           // guarded by m_
+    alignas(64) std::atomic<std::uint32_t> pending_{0};
+    const std::size_t slotCount_;
+    std::unique_ptr<Slot[]> slots_;
+};
@@ -0,0 +1,148 @@
+// ======================================================
+// FreeList.h — lock-free Treiber-stack freelist for recycled messages
+// ======================================================
+//
+// ProducerConsumerproblemUsingThread.cpp / pucerconsumer.cpp pass
+// plain ints. Real producers pass heap MESSAGES:
+//
+//     Message* m = new Message(...);        // producer thread
+//     queue.push(m);
+//     ...
+//     delete queue.pop();                   // consumer thread
+//
+// ❌ every message is one malloc and one CROSS-THREAD free: the
+//    block returns to the producer's arena/tcache from a thread
+//    that does not own it (remote-free lists, arena locks)
+//
+// TaggedFreeList<T> keeps the memory instead:
+// - recycle(p) destroys *p and PUSHES its block on a lock-free
+//   Treiber stack (one CAS on the head)
+// - acquire(args...) POPS a block (one CAS) and constructs T in
+//   it; only an empty list falls through to operator new
+// - steady state (as many blocks as messages in flight): zero
+//   allocator calls; allocations() counts the fresh blocks
+//
+// ABA: a popper reads head = A and A->next = B, then stalls;
+// others pop A, pop B, push A back — head is A again, and a plain
+// CAS(A → B) would install B, which is in use. The head is a
+// TAGGED pointer: 48 address bits + a 16-bit counter bumped by
+// every push and pop, so the stale CAS sees a different tag and
+// fails. One 64-bit CAS, no double-width CAS (no -mcx16 or
+// libatomic); the tag wraps after 65536 changes DURING one
+// stalled pop, which is the accepted risk of the 16-bit form.
+//
+// Blocks are never returned to the allocator while the list
+// lives, so reading a popped block's `next` is always reading
+// valid memory (the other half of why the Treiber pop is safe).
+// The destructor frees the blocks on the list; blocks still held
+// by callers must be recycled before.
+//
+//     TaggedFreeList<Message> pool;
+//     Message* m = pool.acquire(id, payload);  // producer
+//     pool.recycle(m);                         // consumer
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "CachePadded.h"
+
+template <typename T>
+class TaggedFreeList {
+    static_assert(sizeof(void*) == 8, "TaggedFreeList packs a 48-bit address and a 16-bit tag in 64 bits");
+
+public:
+    TaggedFreeList() = default;
+    TaggedFreeList(const TaggedFreeList&) = delete;
+    TaggedFreeList& operator=(const TaggedFreeList&) = delete;
+
+    ~TaggedFreeList() {
+        for (Node* n = address(head_.load()); n;) {
+            Node* next = n->next.load(std::memory_order_relaxed);
+            delete n;
+            n = next;
+        }
+    }
+
+    // Pre-fill with `n` blocks so the first messages do not allocate
+    void reserve(std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) push(fresh());
+    }
+
+    // A block from the list (or a new one), T constructed in it
+    template <typename... Args>
+    T* acquire(Args&&... args) {
+        Node* n = pop();
+        if (!n) n = fresh();
+        try {
+            return ::new (static_cast<void*>(n->storage)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            push(n);
+            throw;
+        }
+    }
+
+    // Destroy *p and return its block; p must come from acquire()
+    void recycle(T* p) {
+        if (!p) return;
+        p->~T();
+        push(reinterpret_cast<Node*>(p));
+    }
+
+    // Blocks taken from operator new so far (each one, once)
+    std::size_t allocations() const { return allocations_.load(std::memory_order_relaxed); }
+
+private:
+    // storage first: a T* is the Node*
+    struct Node {
+        alignas(T) unsigned char storage[sizeof(T)];
+        std::atomic<Node*> next{nullptr};
+    };
+
+    static constexpr int kTagShift = 48;
+    static constexpr std::uint64_t kAddressMask = (std::uint64_t(1) << kTagShift) - 1;
+
+    static Node* address(std::uint64_t tagged) { return reinterpret_cast<Node*>(tagged & kAddressMask); }
+    static std::uint64_t tagged(Node* n, std::uint64_t old) {
+        return reinterpret_cast<std::uint64_t>(n) | (((old >> kTagShift) + 1) << kTagShift);
+    }
+
+    Node* fresh() {
+        Node* n = new Node;
+        if (reinterpret_cast<std::uint64_t>(n) & ~kAddressMask) {
+            delete n;
+            throw std::runtime_error("TaggedFreeList: address above 48 bits, no room for the tag");
+        }
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        return n;
+    }
+
+    void push(Node* n) {
+        std::uint64_t old = head_.load(std::memory_order_relaxed);
+        do {
+            n->next.store(address(old), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(old, tagged(n, old), std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    Node* pop() {
+        std::uint64_t old = head_.load(std::memory_order_acquire);
+        for (;;) {
+            Node* n = address(old);
+            if (!n) return nullptr;
+            // n may be popped and reused meanwhile: `next` is then
+            // stale, and the tag makes the CAS below fail
+            Node* next = n->next.load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(old, tagged(next, old), std::memory_order_acquire,
+                                            std::memory_order_acquire))
+                return n;
+        }
+    }
+
+    alignas(cache_line_size) std::atomic<std::uint64_t> head_{0};
+    std::atomic<std::size_t> allocations_{0};
+};
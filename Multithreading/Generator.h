@@ -0,0 +1,266 @@
+// ======================================================
+// Generator.h — coroutine generators and `|` pipelines, threads only where asked
+// ======================================================
+//
+// pucerconsumer.cpp:
+//
+//     producer: acquire(signal_to_producer); buff[i] = i * i; ...; release(signal_to_consumer)
+//     consumer: acquire(signal_to_consumer); use buff[i];  ...; release(signal_to_producer)
+//
+// Two threads and two semaphores to pass five ints. When both sides
+// are CPU work, the handoff — a wake-up and a context switch per
+// buffer — costs more than the work.
+//
+// Generator<T> is the C++23 std::generator idea for C++20 (GCC 12
+// ships no <generator>): a coroutine that co_yields values, PULLED
+// by whoever iterates it, on the iterating thread. A yield is a
+// function-call-sized resume / suspend; the value is never copied
+// (the iterator points at the yielded object in the coroutine).
+//
+//     Generator<long> squares(long n) {
+//         for (long i = 0; i < n; ++i) co_yield i * i;
+//     }
+//     for (long v : squares(5)) ...                     // 0 1 4 9 16
+//
+// STAGES compose with `|`; each is a generator pulling the previous
+// one, all on one thread:
+//
+//     auto p = squares(n) | gen::transform(f) | gen::filter(pred) | gen::take(k);
+//     for (const auto& v : p) ...
+//
+// A stage is also any callable Generator<T> → Generator<U>.
+//
+// gen::parallel(capacity, batch) marks a boundary where a THREAD
+// is worth it: everything upstream runs on a thread of its own and
+// hands items over through an SpscRing (batched; blocking only when
+// full / empty); downstream stays on the iterating thread.
+// Stopping early (destroying the pipeline) stops the upstream
+// thread at its next item; an exception upstream is rethrown
+// downstream after the items before it.
+//
+// A Generator is move-only, single-pass, iterated once, by one
+// thread at a time. Generators cannot co_await.
+//
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "SpscRing.h"
+
+template <typename T>
+class Generator {
+public:
+    struct promise_type {
+        const T* current = nullptr;                  // the yielded object, inside the coroutine
+        std::exception_ptr error;
+
+        Generator get_return_object() { return Generator(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        // Temporaries live until the end of the co_yield expression,
+        // i.e. until the consumer has resumed us
+        std::suspend_always yield_value(const T& value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+        template <typename U>
+        std::suspend_never await_transform(U&&) = delete;
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        const T& operator*() const { return *h_.promise().current; }
+        const T* operator->() const { return h_.promise().current; }
+        iterator& operator++() {
+            h_.resume();
+            Generator::rethrow(h_);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(std::default_sentinel_t) const { return !h_ || h_.done(); }
+
+    private:
+        friend class Generator;
+        explicit iterator(Handle h) : h_(h) {}
+        Handle h_;
+    };
+
+    Generator(Generator&& o) noexcept : h_(std::exchange(o.h_, {})) {}
+    Generator& operator=(Generator&& o) noexcept {
+        if (this != &o) {
+            if (h_) h_.destroy();
+            h_ = std::exchange(o.h_, {});
+        }
+        return *this;
+    }
+    ~Generator() {
+        if (h_) h_.destroy();
+    }
+
+    // Runs the coroutine to its first co_yield
+    iterator begin() {
+        if (h_) {
+            h_.resume();
+            rethrow(h_);
+        }
+        return iterator(h_);
+    }
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+    explicit Generator(Handle h) : h_(h) {}
+
+    static void rethrow(Handle h) {
+        if (h.done() && h.promise().error) std::rethrow_exception(std::exchange(h.promise().error, {}));
+    }
+
+    Handle h_;
+};
+
+namespace gen {
+
+// --------------------------------------------------
+// Stages
+// --------------------------------------------------
+
+template <typename F>
+struct Transform {
+    F f;
+};
+template <typename F>
+struct Filter {
+    F pred;
+};
+struct Take {
+    std::size_t n;
+};
+struct Parallel {
+    std::size_t capacity;
+    std::size_t batch;
+};
+
+template <typename F>
+Transform<std::decay_t<F>> transform(F&& f) {
+    return {std::forward<F>(f)};
+}
+template <typename F>
+Filter<std::decay_t<F>> filter(F&& pred) {
+    return {std::forward<F>(pred)};
+}
+inline Take take(std::size_t n) { return {n}; }
+// Upstream of this point runs on its own thread
+inline Parallel parallel(std::size_t capacity = 1024, std::size_t batch = SpscRing<int>::kDefaultBatch) {
+    return {capacity, batch};
+}
+
+namespace detail {
+
+template <typename T, typename F, typename U = std::decay_t<std::invoke_result_t<F&, const T&>>>
+Generator<U> transformed(Generator<T> src, F f) {
+    for (const T& v : src) co_yield std::invoke(f, v);
+}
+
+template <typename T, typename F>
+Generator<T> filtered(Generator<T> src, F pred) {
+    for (const T& v : src)
+        if (std::invoke(pred, v)) co_yield v;
+}
+
+template <typename T>
+Generator<T> taken(Generator<T> src, std::size_t n) {
+    if (n == 0) co_return;
+    for (const T& v : src) {
+        co_yield v;
+        if (--n == 0) co_return;                     // do not pull one more than asked
+    }
+}
+
+template <typename T>
+Generator<T> handedOff(Generator<T> src, Parallel how) {
+    // On the heap: coroutine frames do not honour the ring's
+    // cache-line alignment (GCC 12 allocates them 16-byte aligned)
+    auto owned = std::make_unique<SpscRing<std::optional<T>>>(how.capacity, how.batch);
+    SpscRing<std::optional<T>>& ring = *owned;
+    std::exception_ptr error;
+    bool ended = false;
+    std::jthread worker([&](std::stop_token stop) {
+        try {
+            for (const T& v : src) {
+                if (stop.stop_requested()) break;
+                ring.push(v);
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        ring.push(std::nullopt);                     // end of stream (pushes flush when full)
+        ring.flush();
+    });
+    // Destroyed before `worker` joins: when downstream stops early,
+    // stop the worker and drain until its end marker so a full ring
+    // cannot block it
+    struct Drain {
+        std::jthread& worker;
+        SpscRing<std::optional<T>>& ring;
+        bool& ended;
+        ~Drain() {
+            if (ended) return;
+            worker.request_stop();
+            while (ring.pop()) {
+            }
+        }
+    } drain{worker, ring, ended};
+
+    for (;;) {
+        std::optional<T> v = ring.pop();
+        if (!v) break;
+        co_yield *v;
+    }
+    ended = true;
+    worker.join();                                   // `error` is complete after the join
+    if (error) std::rethrow_exception(error);
+}
+
+}  // namespace detail
+
+template <typename T, typename F>
+auto operator|(Generator<T>&& src, Transform<F> t) {
+    return detail::transformed(std::move(src), std::move(t.f));
+}
+template <typename T, typename F>
+Generator<T> operator|(Generator<T>&& src, Filter<F> f) {
+    return detail::filtered(std::move(src), std::move(f.pred));
+}
+template <typename T>
+Generator<T> operator|(Generator<T>&& src, Take t) {
+    return detail::taken(std::move(src), t.n);
+}
+template <typename T>
+Generator<T> operator|(Generator<T>&& src, Parallel p) {
+    return detail::handedOff(std::move(src), p);
+}
+
+}  // namespace gen
+
+// Any callable Generator<T> → Generator<U> is a stage too
+template <typename T, typename Stage>
+    requires std::is_invocable_v<Stage, Generator<T>>
+auto operator|(Generator<T>&& src, Stage&& stage) {
+    return std::invoke(std::forward<Stage>(stage), std::move(src));
+}
@@ -0,0 +1,177 @@
+// ======================================================
+// HazardDomain.h — hazard pointers: reclamation with bounded garbage
+// ======================================================
+//
+// EpochDomain.h frees an object once every reader has moved past
+// the epoch it was retired in — cheap for readers, but ONE stalled
+// reader (preempted, blocked on I/O, stuck in a long guard) stops
+// every advance and garbage grows without limit.
+//
+// Hazard pointers protect single OBJECTS instead of time spans:
+//
+// - a reader publishes the pointer it is about to use in one of
+//   its hazard slots (own record, own cache line), then re-reads
+//   the source: unchanged → the object was not retired before the
+//   hazard became visible, so it stays alive while the slot holds
+//   it (Guard::protect)
+// - retire(p) appends p to the thread's retire list; when the list
+//   reaches the threshold, scan() collects every published hazard
+//   and frees whatever is not among them
+// - threshold = max(kBatch, 2 × hazard slots in use): each scan
+//   frees at least half the list, and at most `slots` entries can
+//   be held back — garbage stays BOUNDED (per thread ≤ threshold),
+//   whatever other threads do, stalled or not
+//
+// The price: one publish (+ compiler fence, the membarrier pair
+// from ReclaimRecords.h) and a re-check per protected pointer —
+// per object read, where an epoch pin covers any number of them.
+//
+//     auto g = domain.pin();
+//     Node* n = g.protect(head);            // safe until g is destroyed
+//
+// Each thread has kSlots hazard slots; every protect() of a live
+// Guard uses one more (nested guards included).
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "CachePadded.h"
+#include "ReclaimRecords.h"
+
+class HazardDomain {
+    struct Record;
+
+public:
+    static constexpr int kSlots = 4;                 // hazard pointers per thread
+    static constexpr std::size_t kBatch = 64;        // minimum retire list before a scan
+
+    HazardDomain() = default;
+    HazardDomain(const HazardDomain&) = delete;
+    HazardDomain& operator=(const HazardDomain&) = delete;
+
+    static HazardDomain& global() {
+        static HazardDomain domain;
+        return domain;
+    }
+
+    // Owns the hazard slots its protect() calls used
+    class Guard {
+    public:
+        explicit Guard(HazardDomain& d) : record_(d.records_.mine()) {}
+        Guard(Guard&& o) noexcept : record_(o.record_), mask_(std::exchange(o.mask_, 0u)) {}
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard() {
+            for (int i = 0; i < kSlots; ++i)
+                if (mask_ & (1u << i)) record_->hazards[i].store(nullptr, std::memory_order_release);
+            record_->used &= ~mask_;
+        }
+
+        // Load `src` and keep the object alive while this guard lives
+        template <typename T>
+        T* protect(const std::atomic<T*>& src) {
+            std::atomic<void*>& slot = record_->hazards[takeSlot()];
+            T* p = src.load(std::memory_order_relaxed);
+            for (;;) {
+                slot.store(const_cast<void*>(static_cast<const void*>(p)), std::memory_order_relaxed);
+                reclaim_detail::lightFence();        // hazard visible before the re-check
+                T* again = src.load(std::memory_order_acquire);
+                if (again == p) return p;
+                p = again;
+            }
+        }
+
+    private:
+        int takeSlot() {
+            for (int i = 0; i < kSlots; ++i)
+                if (!(record_->used & (1u << i))) {
+                    record_->used |= 1u << i;
+                    mask_ |= 1u << i;
+                    return i;
+                }
+            throw std::logic_error("HazardDomain: more than kSlots pointers protected by one thread");
+        }
+
+        Record* record_;
+        unsigned mask_ = 0;
+    };
+
+    Guard pin() { return Guard(*this); }
+
+    // Free `p` (with delete) once no hazard points at it. Call
+    // AFTER p is unreachable for new readers
+    template <typename T>
+    void retire(T* p) {
+        retire(p, [](void* q) { delete static_cast<T*>(q); });
+    }
+
+    void retire(void* p, void (*destroy)(void*)) {
+        Record* r = records_.mine();
+        r->retired.push_back({p, destroy, 0});
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        if (r->retired.size() >= threshold()) collect();
+    }
+
+    // Free the caller's (and exited threads') retired objects that
+    // no hazard protects
+    void collect() {
+        reclaim_detail::heavyFence();                // every published hazard is visible now
+        std::vector<void*> hazards;
+        for (Record* r = records_.head(); r; r = r->next)
+            for (const auto& h : r->hazards)
+                if (void* p = h.load(std::memory_order_acquire)) hazards.push_back(p);
+        std::sort(hazards.begin(), hazards.end());
+        freeUnprotected(records_.mine()->retired, hazards);
+        records_.withOrphans([&](std::vector<reclaim_detail::Retired>& orphans) { freeUnprotected(orphans, hazards); });
+    }
+
+    // Block until everything the caller retired is freed (waits for
+    // the guards protecting it). The caller must not protect any
+    void synchronize() {
+        for (collect(); !records_.mine()->retired.empty(); collect()) std::this_thread::yield();
+    }
+
+    // Retired, not yet freed (all threads; a snapshot)
+    std::size_t pending() const { return pending_.load(std::memory_order_relaxed); }
+
+    // Retire-list length that triggers a scan (grows with threads)
+    std::size_t threshold() const {
+        return std::max(kBatch, 2 * std::size_t(kSlots) * records_.recordCount());
+    }
+
+private:
+    struct alignas(cache_line_size) Record {
+        std::atomic<void*> hazards[kSlots] = {};
+        unsigned used = 0;                           // owner thread only
+        std::vector<reclaim_detail::Retired> retired;    // owner thread only
+        std::atomic<bool> inUse{true};
+        Record* next = nullptr;
+
+        void reset() {
+            used = 0;
+            for (auto& h : hazards) h.store(nullptr, std::memory_order_release);
+        }
+    };
+
+    void freeUnprotected(std::vector<reclaim_detail::Retired>& list, const std::vector<void*>& hazards) {
+        std::size_t kept = 0;
+        for (const reclaim_detail::Retired& x : list) {
+            if (std::binary_search(hazards.begin(), hazards.end(), x.object))
+                list[kept++] = x;
+            else
+                x.destroy(x.object);
+        }
+        pending_.fetch_sub(list.size() - kept, std::memory_order_relaxed);
+        list.resize(kept);
+    }
+
+    reclaim_detail::RecordList<Record> records_;
+    alignas(cache_line_size) std::atomic<std::size_t> pending_{0};
+};
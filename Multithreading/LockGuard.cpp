@@ -89,6 +89,7 @@
 #include <iostream>
 #include <thread>
 #include <mutex>
+#include "Trace.h"
 
 using namespace std;
 
@@ -127,9 +128,15 @@ void task(const char *threadName, int loopFor)
     //
     // Ensures const-correctness
 
+    // Timeline of who waited and who held m1 (Trace.h):
+    //   TRACE_FILE=trace.json ./a.out  → open in ui.perfetto.dev
+    TRACE_THREAD_NAME(threadName);
+    TRACE_SCOPE("task");
+
     // lock_guard is created here
     // Constructor is called → mutex m1 is LOCKED immediately
     std::lock_guard<std::mutex> lock(m1);
+    TRACE_SCOPE("holding m1");
 
     // Critical Section starts
     for (int i = 0; i < loopFor; ++i)
@@ -0,0 +1,190 @@
+// ======================================================
+// LockOrderChecker.h — lockdep-style lock-order checking
+// ======================================================
+//
+// Deadlock.cpp deadlocks because:
+//     thread1: m1 → m2
+//     thread2: m2 → m1
+// Together these two orders form a CYCLE: m1 → m2 → m1.
+//
+// IDEA (like Linux "lockdep"):
+// - Every OrderedMutex is a node in a global graph
+// - When a thread holding A acquires B we record edge A → B
+// - If B → ... → A already exists, the new edge closes a
+//   CYCLE → report it NOW, even if this run never hangs
+//
+// COST:
+// - Each thread keeps a small stack of the locks it holds
+// - Edges a thread has already verified live in a per-thread
+//   cache → after warm-up an acquire is a few hash lookups,
+//   no global lock, no graph search (O(1) amortized)
+// - Only a NEVER-SEEN edge takes the global lock and runs
+//   a depth-first search
+//
+// try_lock() cannot block, so it never creates an edge
+// (that is why std::lock's try-and-back-off is accepted),
+// but a lock taken with try_lock still counts as "held".
+//
+// Compile with -DLOCKDEP_ENABLED=0 to turn OrderedMutex
+// into a plain std::mutex.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#ifndef LOCKDEP_ENABLED
+#define LOCKDEP_ENABLED 1
+#endif
+
+namespace lockdep {
+
+enum class Action { Report, Abort };
+
+class Graph {
+public:
+    static Graph& instance() {
+        static Graph g;
+        return g;
+    }
+
+    std::uint32_t registerLock(const std::string& name) {
+        std::lock_guard<std::mutex> lg(m_);
+        names_.push_back(name);
+        successors_.emplace_back();
+        return (std::uint32_t)names_.size() - 1;
+    }
+
+    // Slow path: called once per (thread, edge) pair
+    void addEdge(std::uint32_t from, std::uint32_t to) {
+        std::lock_guard<std::mutex> lg(m_);
+        auto& succ = successors_[from];
+        if (std::find(succ.begin(), succ.end(), to) != succ.end()) return;
+
+        // Does "to" already reach "from"? Then from → to closes a cycle.
+        std::vector<std::uint32_t> path;
+        std::vector<char> seen(names_.size(), 0);
+        if (reaches(to, from, seen, path)) {
+            ++cycles_;
+            std::fprintf(stderr, "\n*** lockdep: possible DEADLOCK (lock-order inversion) ***\n");
+            std::fprintf(stderr, "  new order : %s -> %s\n", names_[from].c_str(), names_[to].c_str());
+            std::fprintf(stderr, "  existing  : ");
+            for (std::size_t i = 0; i < path.size(); ++i)
+                std::fprintf(stderr, "%s%s", i ? " -> " : "", names_[path[i]].c_str());
+            std::fprintf(stderr, "\n");
+            if (action_ == Action::Abort) std::abort();
+        }
+        succ.push_back(to);   // remember it: each cycle is reported once
+    }
+
+    void setAction(Action a) { action_ = a; }
+    int cyclesReported() {
+        std::lock_guard<std::mutex> lg(m_);
+        return cycles_;
+    }
+
+private:
+    bool reaches(std::uint32_t cur, std::uint32_t target, std::vector<char>& seen,
+                 std::vector<std::uint32_t>& path) {
+        path.push_back(cur);
+        if (cur == target) return true;
+        seen[cur] = 1;
+        for (std::uint32_t next : successors_[cur])
+            if (!seen[next] && reaches(next, target, seen, path)) return true;
+        path.pop_back();
+        return false;
+    }
+
+    std::mutex m_;
+    std::vector<std::string> names_;
+    std::vector<std::vector<std::uint32_t>> successors_;
+    Action action_ = Action::Report;
+    int cycles_ = 0;
+};
+
+// Per-thread bookkeeping
+struct ThreadState {
+    std::vector<std::uint32_t> held;                 // locks held, in order
+    std::unordered_set<std::uint64_t> verified;      // edges already checked
+};
+
+inline ThreadState& threadState() {
+    thread_local ThreadState ts;
+    return ts;
+}
+
+inline void beforeBlockingAcquire(std::uint32_t id) {
+    ThreadState& ts = threadState();
+    for (std::uint32_t h : ts.held) {
+        std::uint64_t key = ((std::uint64_t)h << 32) | id;
+        if (ts.verified.insert(key).second) Graph::instance().addEdge(h, id);
+    }
+}
+
+inline void acquired(std::uint32_t id) { threadState().held.push_back(id); }
+
+inline void released(std::uint32_t id) {
+    auto& held = threadState().held;
+    // Usually the most recent lock → search from the back
+    for (auto it = held.rbegin(); it != held.rend(); ++it)
+        if (*it == id) {
+            held.erase(std::next(it).base());
+            return;
+        }
+}
+
+}  // namespace lockdep
+
+#if LOCKDEP_ENABLED
+
+class OrderedMutex {
+public:
+    explicit OrderedMutex(const char* name)
+        : id_(lockdep::Graph::instance().registerLock(name)) {}
+
+    OrderedMutex(const OrderedMutex&) = delete;
+    OrderedMutex& operator=(const OrderedMutex&) = delete;
+
+    void lock() {
+        lockdep::beforeBlockingAcquire(id_);   // check BEFORE we could hang
+        m_.lock();
+        lockdep::acquired(id_);
+    }
+
+    bool try_lock() {
+        if (!m_.try_lock()) return false;
+        lockdep::acquired(id_);
+        return true;
+    }
+
+    void unlock() {
+        lockdep::released(id_);
+        m_.unlock();
+    }
+
+private:
+    std::mutex m_;
+    std::uint32_t id_;
+};
+
+#else
+
+class OrderedMutex {
+public:
+    explicit OrderedMutex(const char*) {}
+    void lock() { m_.lock(); }
+    bool try_lock() { return m_.try_lock(); }
+    void unlock() { m_.unlock(); }
+
+private:
+    std::mutex m_;
+};
+
+#endif
@@ -0,0 +1,231 @@
+// ======================================================
+// MPMCQueue.h — Bounded lock-free MPMC ring buffer
+// ======================================================
+//
+// A reusable multi-producer / multi-consumer queue that
+// replaces "deque + mutex + condition_variable".
+//
+// DESIGN (Dmitry Vyukov's bounded queue):
+// - Ring size is a POWER OF TWO → index = pos & mask
+// - Every slot carries its own SEQUENCE number
+//     seq == pos       → slot is free for the producer at pos
+//     seq == pos + 1   → slot holds data for the consumer at pos
+// - Producers CAS enqueue_pos, consumers CAS dequeue_pos
+//   → no shared lock, threads only collide on the SAME slot
+//
+// BACKPRESSURE:
+// - The ring is rounded up to a power of two, but the LOGICAL
+//   capacity is kept exactly as requested (e.g. 50), so the
+//   "producer waits when buffer is full" behaviour is unchanged.
+//
+// BLOCKING VARIANTS:
+// - push()/pop() first SPIN on try_push()/try_pop()
+// - Only after the spin budget is used up do they PARK the
+//   thread with std::atomic::wait (C++20)
+// - The other side only calls notify when someone is parked
+//
+// PLACEMENT:
+// - The ring comes from Alloc (default std::allocator), e.g.
+//   NumaQueues.h's NodeAllocator to keep it on one NUMA node
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#define MPMC_CPU_RELAX() _mm_pause()
+#elif defined(__aarch64__)
+#define MPMC_CPU_RELAX() asm volatile("yield")
+#else
+#define MPMC_CPU_RELAX() std::this_thread::yield()
+#endif
+
+template <typename T, typename Alloc = std::allocator<T>>
+class MPMCQueue {
+public:
+    // Spinning only helps when the other side runs on ANOTHER core,
+    // so on a single-CPU machine the default budget is zero
+    explicit MPMCQueue(std::size_t capacity,
+                       unsigned spinBudget = defaultSpinBudget(),
+                       const Alloc& alloc = Alloc())
+        : capacity_(capacity == 0 ? 1 : capacity),
+          mask_(roundUpPow2(capacity_) - 1),
+          cells_(mask_ + 1, CellAlloc(alloc)),
+          spinBudget_(spinBudget) {
+        // Slot i starts "free for the producer at position i"
+        for (std::size_t i = 0; i <= mask_; ++i)
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    std::size_t capacity() const { return capacity_; }
+
+    // --------------------------------------------------
+    // NON-BLOCKING API
+    // --------------------------------------------------
+
+    // Returns false if the queue is FULL (logical capacity reached).
+    // The value is moved (or copied) into the slot only after the
+    // slot is claimed: on false it is untouched, so a retry loop
+    // neither copies it again nor loses it.
+    bool try_push(T&& value) { return tryPush(std::move(value)); }
+    bool try_push(const T& value) { return tryPush(value); }
+
+    // Returns false if the queue is EMPTY
+    bool try_pop(T& out) {
+        std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            std::size_t seq = cell.seq.load(std::memory_order_acquire);
+            std::intptr_t diff = (std::intptr_t)seq - (std::intptr_t)(pos + 1);
+
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1,
+                                                      std::memory_order_relaxed)) {
+                    out = std::move(cell.data);
+                    // Mark slot free for the producer one lap later
+                    cell.seq.store(pos + mask_ + 1, std::memory_order_release);
+                    signal(pushEvents_, pushWaiters_);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // nothing published here yet → empty
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // --------------------------------------------------
+    // BLOCKING API (spin first, park later)
+    // --------------------------------------------------
+
+    void push(T value) {
+        for (unsigned i = 0; i < spinBudget_; ++i) {
+            if (try_push(std::move(value))) return;
+            MPMC_CPU_RELAX();
+        }
+        for (;;) {
+            pushWaiters_.fetch_add(1, std::memory_order_seq_cst);
+            std::uint32_t ev = pushEvents_.load(std::memory_order_seq_cst);
+            if (try_push(std::move(value))) {
+                pushWaiters_.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            pushEvents_.wait(ev, std::memory_order_seq_cst);
+            pushWaiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    T pop() {
+        T out{};
+        for (unsigned i = 0; i < spinBudget_; ++i) {
+            if (try_pop(out)) return out;
+            MPMC_CPU_RELAX();
+        }
+        for (;;) {
+            popWaiters_.fetch_add(1, std::memory_order_seq_cst);
+            std::uint32_t ev = popEvents_.load(std::memory_order_seq_cst);
+            if (try_pop(out)) {
+                popWaiters_.fetch_sub(1, std::memory_order_relaxed);
+                return out;
+            }
+            popEvents_.wait(ev, std::memory_order_seq_cst);
+            popWaiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Approximate number of items (exact only when quiescent)
+    std::size_t size_approx() const {
+        std::size_t e = enqueuePos_.load(std::memory_order_relaxed);
+        std::size_t d = dequeuePos_.load(std::memory_order_relaxed);
+        return e > d ? e - d : 0;
+    }
+
+private:
+    template <typename U>
+    bool tryPush(U&& value) {
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            // Stale dequeuePos can only OVER-estimate occupancy,
+            // so this check never lets the queue exceed capacity_.
+            // Signed, like the sequence check: a stale pos may
+            // already be behind dequeuePos (negative, not full).
+            std::intptr_t used = (std::intptr_t)(pos - dequeuePos_.load(std::memory_order_acquire));
+            if (used >= (std::intptr_t)capacity_)
+                return false;
+
+            Cell& cell = cells_[pos & mask_];
+            std::size_t seq = cell.seq.load(std::memory_order_acquire);
+            std::intptr_t diff = (std::intptr_t)seq - (std::intptr_t)pos;
+
+            if (diff == 0) {
+                // Slot is free → try to claim position pos
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                                                      std::memory_order_relaxed)) {
+                    cell.data = std::forward<U>(value);
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    signal(popEvents_, popWaiters_);
+                    return true;
+                }
+                // CAS failed → pos was reloaded, retry
+            } else if (diff < 0) {
+                return false;   // previous lap not consumed yet → full
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static constexpr std::size_t kCacheLine = 64;
+
+    struct Cell {
+        std::atomic<std::size_t> seq;
+        T data;
+    };
+    using CellAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Cell>;
+
+    static unsigned defaultSpinBudget() {
+        return std::thread::hardware_concurrency() > 1 ? 256u : 0u;
+    }
+
+    static std::size_t roundUpPow2(std::size_t n) {
+        std::size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    // Wake parked threads ONLY if somebody is actually parked
+    static void signal(std::atomic<std::uint32_t>& events,
+                       std::atomic<std::uint32_t>& waiters) {
+        // Full fence: the slot publish above must be visible before
+        // we read the waiter count (Dekker-style store → load ordering)
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_seq_cst) == 0) return;
+        events.fetch_add(1, std::memory_order_seq_cst);
+        events.notify_all();
+    }
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::vector<Cell, CellAlloc> cells_;
+    const unsigned spinBudget_;
+
+    // Each hot index on its own cache line → no false sharing
+    alignas(kCacheLine) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(kCacheLine) std::atomic<std::size_t> dequeuePos_{0};
+    alignas(kCacheLine) std::atomic<std::uint32_t> pushEvents_{0};
+    std::atomic<std::uint32_t> pushWaiters_{0};
+    alignas(kCacheLine) std::atomic<std::uint32_t> popEvents_{0};
+    std::atomic<std::uint32_t> popWaiters_{0};
+};
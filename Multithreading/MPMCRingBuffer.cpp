@@ -0,0 +1,177 @@
+// ======================================================
+// TOPIC: Lock-Free Bounded MPMC Ring Buffer
+// ======================================================
+//
+// PROBLEM WITH ProducerConsumerproblemUsingThread.cpp:
+// - EVERY producer/consumer step takes the ONE global mutex
+// - EVERY push and pop calls cond.notify_one()
+// - With many threads they all queue up on "mu"
+//   → effectively only ONE core does useful work
+//
+// ------------------------------------------------------
+// SOLUTION: MPMCQueue<T> (see MPMCQueue.h)
+// ------------------------------------------------------
+//
+// - Power-of-two ring, one SEQUENCE number per slot
+// - try_push()/try_pop() → never block, return false
+//   when FULL / EMPTY
+// - push()/pop() → spin for a while, then park with
+//   std::atomic::wait (no condition_variable, no mutex)
+// - Logical capacity stays maxBufferSize = 50
+//   → same backpressure as the deque version
+//
+// ------------------------------------------------------
+// BENCHMARK
+// ------------------------------------------------------
+//
+// Both versions move the SAME number of items through a
+// 50-slot buffer with 1/2/4/8 producers and consumers.
+// Consumers stop when they receive a "poison pill" (-1).
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread MPMCRingBuffer.cpp -o ring
+//
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include "MPMCQueue.h"
+
+using namespace std;
+using namespace std::chrono;
+
+const unsigned int maxBufferSize = 50;
+const int itemsPerProducer = 200000;
+
+// ------------------------------------------------------
+// BASELINE: deque + mutex + condition_variable
+// (same logic as ProducerConsumerproblemUsingThread.cpp,
+//  generalised to N producers / N consumers)
+// ------------------------------------------------------
+class LockedBuffer {
+    condition_variable cond;
+    deque<int> buffer;
+    mutex mu;
+
+public:
+    void push(int val) {
+        unique_lock<mutex> locker(mu);
+        cond.wait(locker, [this]() { return buffer.size() < maxBufferSize; });
+        buffer.push_back(val);
+        locker.unlock();
+        cond.notify_one();
+    }
+
+    int pop() {
+        unique_lock<mutex> locker(mu);
+        cond.wait(locker, [this]() { return buffer.size() > 0; });
+        int val = buffer.back();
+        buffer.pop_back();
+        locker.unlock();
+        cond.notify_one();
+        return val;
+    }
+};
+
+// ------------------------------------------------------
+// Generic driver: works with any buffer that has
+// push(int) and int pop()
+// ------------------------------------------------------
+template <typename Buffer>
+double runBenchmark(Buffer& buf, int producers, int consumers, long long& checksum) {
+    atomic<long long> sum{0};
+    vector<thread> prod, cons;
+
+    auto startTime = steady_clock::now();
+
+    for (int c = 0; c < consumers; ++c) {
+        cons.emplace_back([&]() {
+            long long local = 0;
+            while (true) {
+                int v = buf.pop();
+                if (v < 0) break;          // poison pill → stop
+                local += v;
+            }
+            sum.fetch_add(local, memory_order_relaxed);
+        });
+    }
+
+    for (int p = 0; p < producers; ++p) {
+        prod.emplace_back([&]() {
+            for (int val = itemsPerProducer; val > 0; --val)
+                buf.push(val);
+        });
+    }
+
+    for (auto& t : prod) t.join();
+    for (int c = 0; c < consumers; ++c) buf.push(-1);   // one pill per consumer
+    for (auto& t : cons) t.join();
+
+    auto endTime = steady_clock::now();
+    checksum = sum.load();
+    return duration_cast<duration<double, milli>>(endTime - startTime).count();
+}
+
+int main() {
+
+    // --------------------------------------------------
+    // 1. Quick functional demo of the non-blocking API
+    // --------------------------------------------------
+    MPMCQueue<int> q(maxBufferSize);
+    int pushed = 0;
+    while (q.try_push(pushed)) ++pushed;
+    cout << "try_push accepted " << pushed << " items (capacity "
+         << q.capacity() << ")" << endl;
+
+    int v, popped = 0;
+    while (q.try_pop(v)) ++popped;
+    cout << "try_pop returned " << popped << " items" << endl << endl;
+
+    // --------------------------------------------------
+    // 2. Throughput comparison
+    // --------------------------------------------------
+    cout << "threads(P+C)   deque+condvar(ms)   MPMCQueue(ms)   speedup" << endl;
+
+    for (int n : {1, 2, 4, 8}) {
+        long long expected = (long long)n * itemsPerProducer * (itemsPerProducer + 1) / 2;
+        long long sumLocked = 0, sumRing = 0;
+
+        LockedBuffer locked;
+        double tLocked = runBenchmark(locked, n, n, sumLocked);
+
+        MPMCQueue<int> ring(maxBufferSize);
+        double tRing = runBenchmark(ring, n, n, sumRing);
+
+        cout << "  " << n << "+" << n << "\t\t" << tLocked << "\t\t" << tRing
+             << "\t\t" << tLocked / tRing << "x";
+        if (sumLocked != expected || sumRing != expected)
+            cout << "   CHECKSUM MISMATCH!";
+        cout << endl;
+    }
+
+    return 0;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. Lock-free ≠ wait-free: a thread may retry its CAS,
+//    but SOME thread always makes progress.
+// 2. The per-slot sequence number replaces the mutex:
+//    it tells a thread whether the slot is free or full.
+// 3. Acquire/release on "seq" publishes the data safely.
+// 4. Power-of-two size → "& mask" instead of "% size".
+// 5. Head and tail live on DIFFERENT cache lines to avoid
+//    false sharing between producers and consumers.
+// 6. Spin-then-park: short waits never enter the kernel,
+//    long waits don't burn a core.
+//
+// ⭐ One-Line Interview Answer
+// “A bounded MPMC ring buffer uses per-slot sequence numbers
+// and CAS on head/tail indices so producers and consumers
+// coordinate without a shared lock.”
@@ -0,0 +1,355 @@
+// ======================================================
+// NumaQueues.h — NUMA topology, node-local queues, paired placement
+// ======================================================
+//
+// ProducerConsumerproblemUsingThread.cpp / pucerconsumer.cpp:
+//
+//     std::deque<int> buffer;        // globals: their pages land on
+//     int buff[buff_size];           // whichever node touched them first
+//
+// On a 2-socket machine a consumer on the other socket pays a
+// remote access for every item, and the queue's index cache lines
+// bounce across the interconnect.
+//
+// - NumaTopology::discover() reads the nodes, their CPUs and the
+//   distance table from /sys/devices/system/node (one node with
+//   every CPU where there is no such directory, or off Linux).
+//   NumaTopology::emulated(n) lays n nodes over the real CPUs
+//   without any memory binding — to exercise the policy on a
+//   one-node machine
+// - allocateOnNode(bytes, node) maps memory, binds it to the node
+//   (mbind, MPOL_PREFERRED) and faults it in; where binding is
+//   not possible it is ordinary memory. NodeAllocator<T> wraps it
+//   for containers: MPMCQueue<T, NodeAllocator<T>> keeps its ring
+//   on one node
+// - NodeQueues<T>: one MPMCQueue per node, the queue object and its
+//   ring both on that node. Producers push to their node's queue;
+//   a consumer pops its own node's queue and, only when that is
+//   empty, steals from the others, nearest node first
+// - pairThreads(topology, pairs, policy): ThreadConfigs
+//   (../Threads/ThreadConfig.h) for producer k / consumer k.
+//   SameNode keeps each pair on one node (pairs round-robin over
+//   the nodes, a distinct CPU per thread while the node has them);
+//   CrossNode puts the consumer on the next node — the misplacement
+//   it exists to avoid, for measuring
+//
+// Placement is Linux only (syscall() for mbind / move_pages, no
+// libnuma); everywhere else all of this works, on one node.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MPMCQueue.h"
+#include "../Threads/ThreadConfig.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+struct NumaNode {
+    int osNode = -1;                 // kernel node id; -1: emulated, no binding
+    std::vector<int> cpus;
+    std::vector<int> distances;      // to every node, by index (10 = local)
+};
+
+class NumaTopology {
+public:
+    static NumaTopology discover() {
+        NumaTopology t;
+#ifdef __linux__
+        std::string online = numaRead("/sys/devices/system/node/online");
+        for (int id : thread_config_detail::parseCpuList(online.c_str())) {
+            NumaNode n;
+            n.osNode = id;
+            n.cpus = thread_config_detail::nodeCpus(id);
+            char path[64];
+            std::snprintf(path, sizeof path, "/sys/devices/system/node/node%d/distance", id);
+            std::string d = numaRead(path);
+            const char* text = d.c_str();
+            char* end;
+            for (long v = std::strtol(text, &end, 10); end != text; v = std::strtol(text, &end, 10)) {
+                n.distances.push_back(static_cast<int>(v));
+                text = end;
+            }
+            if (!n.cpus.empty()) t.nodes_.push_back(std::move(n));   // memory-only nodes run no threads
+        }
+        t.discovered_ = !t.nodes_.empty();
+        // distances are by kernel id; keep only the rows for nodes kept
+        if (t.discovered_) {
+            for (NumaNode& n : t.nodes_) {
+                std::vector<int> byIndex;
+                for (const NumaNode& m : t.nodes_)
+                    byIndex.push_back(m.osNode < static_cast<int>(n.distances.size()) ? n.distances[m.osNode]
+                                                                                       : (&m == &n ? 10 : 20));
+                n.distances = std::move(byIndex);
+            }
+        }
+#endif
+        if (t.nodes_.empty()) t = emulated(1);
+        return t;
+    }
+
+    // `count` nodes over this machine's CPUs (split evenly; every
+    // node gets them all if there are fewer CPUs than nodes),
+    // distances 10 / 20, no memory binding
+    static NumaTopology emulated(std::size_t count) {
+        NumaTopology t;
+        const int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        count = std::max<std::size_t>(count, 1);
+        for (std::size_t i = 0; i < count; ++i) {
+            NumaNode n;
+            if (hw >= static_cast<int>(count)) {
+                for (int c = static_cast<int>(i * hw / count); c < static_cast<int>((i + 1) * hw / count); ++c)
+                    n.cpus.push_back(c);
+            } else {
+                n.cpus.resize(hw);
+                std::iota(n.cpus.begin(), n.cpus.end(), 0);
+            }
+            for (std::size_t j = 0; j < count; ++j) n.distances.push_back(i == j ? 10 : 20);
+            t.nodes_.push_back(std::move(n));
+        }
+        return t;
+    }
+
+    std::size_t nodeCount() const { return nodes_.size(); }
+    const NumaNode& node(std::size_t i) const { return nodes_.at(i); }
+    const std::vector<NumaNode>& nodes() const { return nodes_; }
+
+    // Read from the kernel (false: emulated or the one-node fallback)
+    bool discovered() const { return discovered_; }
+
+    // Index of the node that owns `cpu`, -1 if none
+    int nodeOfCpu(int cpu) const {
+        for (std::size_t i = 0; i < nodes_.size(); ++i)
+            if (std::find(nodes_[i].cpus.begin(), nodes_[i].cpus.end(), cpu) != nodes_[i].cpus.end())
+                return static_cast<int>(i);
+        return -1;
+    }
+
+    // The other nodes, nearest first (ties by index)
+    std::vector<std::size_t> stealOrder(std::size_t from) const {
+        std::vector<std::size_t> order;
+        for (std::size_t i = 0; i < nodes_.size(); ++i)
+            if (i != from) order.push_back(i);
+        const std::vector<int>& d = nodes_.at(from).distances;
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return (a < d.size() ? d[a] : 20) < (b < d.size() ? d[b] : 20);
+        });
+        return order;
+    }
+
+private:
+    static std::string numaRead(const char* path) {
+        std::string text;
+        if (std::FILE* f = std::fopen(path, "r")) {
+            char buf[512];
+            while (std::fgets(buf, sizeof buf, f)) text += buf;
+            std::fclose(f);
+        }
+        return text;
+    }
+
+    std::vector<NumaNode> nodes_;
+    bool discovered_ = false;
+};
+
+namespace numa_detail {
+
+inline std::size_t pageSize() {
+#ifdef __linux__
+    static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+// mbind(MPOL_PREFERRED) of [p, p + bytes); 0 or errno
+inline int bindToNode(void* p, std::size_t bytes, int osNode) {
+#if defined(__linux__) && defined(SYS_mbind)
+    constexpr int kMpolPreferred = 1;
+    unsigned long mask[16] = {};
+    if (osNode < 0 || osNode >= static_cast<int>(sizeof(mask) * 8)) return EINVAL;
+    mask[osNode / (8 * sizeof(unsigned long))] |= 1UL << (osNode % (8 * sizeof(unsigned long)));
+    if (syscall(SYS_mbind, p, bytes, kMpolPreferred, mask, sizeof(mask) * 8, 0) != 0) return errno;
+    return 0;
+#else
+    (void)p, (void)bytes, (void)osNode;
+    return ENOSYS;
+#endif
+}
+
+}  // namespace numa_detail
+
+// Kernel node holding the page of `p` (it must have been touched);
+// -1 if unknown
+inline int nodeOfAddress(const void* p) {
+#if defined(__linux__) && defined(SYS_move_pages)
+    void* page = reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(p) & ~(numa_detail::pageSize() - 1));
+    int status = -1;
+    if (syscall(SYS_move_pages, 0, 1UL, &page, nullptr, &status, 0) != 0 || status < 0) return -1;
+    return status;
+#else
+    (void)p;
+    return -1;
+#endif
+}
+
+// Whole pages, bound to kernel node `osNode` (-1: no binding) and
+// already faulted in. *bound says whether the binding applied.
+// For large, long-lived buffers: every call is at least a page.
+inline void* allocateOnNode(std::size_t bytes, int osNode, bool* bound = nullptr) {
+    const std::size_t page = numa_detail::pageSize();
+    bytes = (std::max<std::size_t>(bytes, 1) + page - 1) / page * page;
+#ifdef __linux__
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) throw std::bad_alloc();
+    const bool ok = osNode >= 0 && numa_detail::bindToNode(p, bytes, osNode) == 0;
+    // First touch comes after the policy: the pages fault in on the node
+    for (std::size_t at = 0; at < bytes; at += page) static_cast<volatile char*>(p)[at] = 0;
+#else
+    void* p = ::operator new(bytes, std::align_val_t(64));
+    const bool ok = false;
+#endif
+    if (bound) *bound = ok;
+    return p;
+}
+
+inline void freeOnNode(void* p, std::size_t bytes) noexcept {
+    if (!p) return;
+    const std::size_t page = numa_detail::pageSize();
+    bytes = (std::max<std::size_t>(bytes, 1) + page - 1) / page * page;
+#ifdef __linux__
+    munmap(p, bytes);
+#else
+    (void)bytes;
+    ::operator delete(p, std::align_val_t(64));
+#endif
+}
+
+template <typename T>
+struct NodeAllocator {
+    using value_type = T;
+
+    NodeAllocator() = default;
+    explicit NodeAllocator(int node) : osNode(node) {}
+    template <typename U>
+    NodeAllocator(const NodeAllocator<U>& other) : osNode(other.osNode) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(allocateOnNode(n * sizeof(T), osNode)); }
+    void deallocate(T* p, std::size_t n) noexcept { freeOnNode(p, n * sizeof(T)); }
+
+    friend bool operator==(const NodeAllocator& a, const NodeAllocator& b) { return a.osNode == b.osNode; }
+
+    int osNode = -1;
+};
+
+template <typename T>
+class NodeQueues {
+public:
+    using Queue = MPMCQueue<T, NodeAllocator<T>>;
+
+    NodeQueues(const NumaTopology& topology, std::size_t capacityPerNode) {
+        const unsigned spin = std::thread::hardware_concurrency() > 1 ? 256u : 0u;   // as MPMCQueue's default
+        for (std::size_t i = 0; i < topology.nodeCount(); ++i) {
+            const int os = topology.node(i).osNode;
+            bool bound = false;
+            void* mem = allocateOnNode(sizeof(Queue), os, &bound);
+            queues_.push_back(::new (mem) Queue(capacityPerNode, spin, NodeAllocator<T>(os)));
+            bound_.push_back(bound);
+            stealOrder_.push_back(topology.stealOrder(i));
+        }
+        steals_ = std::vector<Counter>(queues_.size());
+    }
+
+    NodeQueues(const NodeQueues&) = delete;
+    NodeQueues& operator=(const NodeQueues&) = delete;
+
+    ~NodeQueues() {
+        for (Queue* q : queues_) {
+            q->~Queue();
+            freeOnNode(q, sizeof(Queue));
+        }
+    }
+
+    std::size_t nodeCount() const { return queues_.size(); }
+    Queue& queue(std::size_t node) { return *queues_.at(node); }
+
+    void push(std::size_t node, T value) { queues_[node]->push(std::move(value)); }
+    // Like MPMCQueue::try_push: on false the value is untouched
+    bool try_push(std::size_t node, T&& value) { return queues_[node]->try_push(std::move(value)); }
+    bool try_push(std::size_t node, const T& value) { return queues_[node]->try_push(value); }
+
+    // `node`'s queue first; if it is empty and `steal`, the other
+    // nodes' queues nearest first. False: nothing anywhere.
+    bool try_pop(std::size_t node, T& out, bool steal = true) {
+        if (queues_[node]->try_pop(out)) return true;
+        if (!steal) return false;
+        for (std::size_t other : stealOrder_[node])
+            if (queues_[other]->try_pop(out)) {
+                steals_[node].n.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        return false;
+    }
+
+    // Items taken from another node's queue by consumers of `node`
+    std::uint64_t steals(std::size_t node) const { return steals_.at(node).n.load(std::memory_order_relaxed); }
+
+    // Whether `node`'s queue memory was bound to it, and where its
+    // page actually is (kernel node, -1 unknown)
+    bool bound(std::size_t node) const { return bound_.at(node); }
+    int residentNode(std::size_t node) const { return nodeOfAddress(queues_.at(node)); }
+
+private:
+    struct alignas(64) Counter {
+        std::atomic<std::uint64_t> n{0};
+    };
+
+    std::vector<Queue*> queues_;
+    std::vector<bool> bound_;
+    std::vector<std::vector<std::size_t>> stealOrder_;
+    std::vector<Counter> steals_;
+};
+
+enum class PairPolicy {
+    SameNode,            // producer k and consumer k on one node
+    CrossNode,           // consumer k on the next node (for comparison)
+};
+
+struct PairPlacement {
+    std::size_t producerNode, consumerNode;      // topology indices
+    ThreadConfig producer, consumer;
+};
+
+// Pair k on node k % nodes; within a node, pair j gets CPUs 2j and
+// 2j+1 of the node's list (wrapping when it runs out)
+inline std::vector<PairPlacement> pairThreads(const NumaTopology& topology, int pairs,
+                                              PairPolicy policy = PairPolicy::SameNode) {
+    std::vector<PairPlacement> out;
+    const std::size_t nodes = topology.nodeCount();
+    auto configFor = [&](std::size_t node, std::size_t slot) {
+        const NumaNode& n = topology.node(node);
+        ThreadConfig cfg;
+        if (!n.cpus.empty()) cfg.cores = {n.cpus[slot % n.cpus.size()]};
+        cfg.numaNode = n.osNode;                      // memory policy too, when real
+        return cfg;
+    };
+    for (int k = 0; k < pairs; ++k) {
+        const std::size_t node = static_cast<std::size_t>(k) % nodes, j = static_cast<std::size_t>(k) / nodes;
+        const std::size_t consumerNode = policy == PairPolicy::SameNode ? node : (node + 1) % nodes;
+        out.push_back({node, consumerNode, configFor(node, 2 * j), configFor(consumerNode, 2 * j + 1)});
+    }
+    return out;
+}
@@ -0,0 +1,201 @@
+// ======================================================
+// OrderedWriter.h — chunks formatted in parallel, written in order
+// ======================================================
+//
+// ThreadSynchronization.cpp (MyPrinter):
+//
+//     cv.wait(lock, [this] { return this_thread::get_id() == thread_ids[allowed_thread]; });
+//     print_chars();                     // under the lock
+//     allowed_thread++; ... cv.notify_all();
+//
+// The ORDER of the output is what forces the turn-taking: chunk k
+// must appear after chunk k - 1, so the thread owning chunk k may
+// not even start until its predecessor printed. One thread works,
+// the others wait, and every turn is a lock handoff plus a wake-up
+// of all threads.
+//
+// Only the WRITE has to be ordered. Chunks are numbered 0, 1, 2 ...;
+// any thread formats chunk k into k's own buffer whenever it likes,
+// and commit(k) hands it to the sequencer:
+//
+//     OrderedWriter out(STDOUT_FILENO, 1024, 64);     // 1024 chunks in flight, 64 per writev
+//     std::string& b = out.buffer(k);                  // waits while k is 1024 ahead
+//     format(b, k);
+//     out.commit(k);
+//     ...
+//     out.flush();                                     // after the last commit
+//
+// SEQUENCER: no extra thread. The output waits for the oldest
+// unwritten chunk; once it and the chunks after it form a run of
+// `batch` committed chunks, the commit that completed the run
+// makes its caller the writer. It writes the whole run with ONE
+// writev (one iovec per chunk, up to IOV_MAX), outside the lock,
+// and goes on while another full run is ready. Other commits only
+// mark their buffer done and return. flush() writes a shorter
+// final run.
+//
+// - a window of W chunks bounds memory: buffer(k) blocks until
+//   chunk k - W has been written. Threads taking their chunks in
+//   increasing order never deadlock (batch is capped at W, and a
+//   full window is a full run)
+// - buffers keep their capacity: no allocation once warm
+// - a failed writev throws std::system_error from that commit;
+//   every later buffer() / commit() / flush() throws as well
+//
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <sys/uio.h>
+
+class OrderedWriter {
+public:
+    // Writes to fd (does not own it)
+    explicit OrderedWriter(int fd, std::size_t window = 1024, std::size_t batch = 64)
+        : fd_(fd), batch_(std::min(batch, window)), slots_(window), ready_(window, false) {
+        if (window == 0 || batch == 0)
+            throw std::invalid_argument("OrderedWriter: window and batch must be at least 1");
+    }
+
+    OrderedWriter(const OrderedWriter&) = delete;
+    OrderedWriter& operator=(const OrderedWriter&) = delete;
+
+    // Writes what is left; every thread must be done with it
+    ~OrderedWriter() {
+        try {
+            flush();
+        } catch (const std::system_error&) {
+            // nowhere left to report a failed final write
+        }
+    }
+
+    // The buffer for chunk `seq`, empty; waits until chunk
+    // seq - window is written. Only one thread may hold a given seq.
+    std::string& buffer(std::uint64_t seq) {
+        std::unique_lock<std::mutex> lk(m_);
+        if (seq < next_) throw std::invalid_argument("OrderedWriter: chunk already written");
+        slotFree_.wait(lk, [&] { return error_ != 0 || seq < next_ + slots_.size(); });
+        check();
+        std::string& b = slots_[seq % slots_.size()];
+        b.clear();
+        return b;
+    }
+
+    // Chunk `seq` is complete. Writes the ready run if this commit
+    // made it `batch` long and nobody is writing.
+    void commit(std::uint64_t seq) {
+        std::unique_lock<std::mutex> lk(m_);
+        check();
+        if (seq < next_ || seq >= next_ + slots_.size() || ready_[seq % slots_.size()])
+            throw std::invalid_argument("OrderedWriter: commit of a chunk not handed out");
+        ready_[seq % slots_.size()] = true;
+        while (run_ < slots_.size() && ready_[(next_ + run_) % slots_.size()]) ++run_;
+        if (writing_ || run_ < batch_) return;
+        writing_ = true;
+        drain(lk, batch_);
+    }
+
+    // Writes the ready run, however short. Once every chunk up to
+    // the last has been committed, all of them are written.
+    void flush() {
+        std::unique_lock<std::mutex> lk(m_);
+        idle_.wait(lk, [&] { return error_ != 0 || !writing_; });
+        check();
+        if (run_ == 0) return;
+        writing_ = true;
+        drain(lk, 1);
+    }
+
+    std::uint64_t written() const {
+        std::lock_guard<std::mutex> lg(m_);
+        return next_;
+    }
+    std::uint64_t syscalls() const {
+        std::lock_guard<std::mutex> lg(m_);
+        return syscalls_;
+    }
+
+private:
+    // Called with writing_ set: write the ready run while it is at
+    // least `minRun` chunks long
+    void drain(std::unique_lock<std::mutex>& lk, std::size_t minRun) {
+        constexpr std::size_t kMaxIov = IOV_MAX;
+        iov_.resize(std::min(kMaxIov, slots_.size()));
+        while (run_ >= minRun) {
+            const std::size_t n = std::min(run_, iov_.size());
+            for (std::size_t i = 0; i < n; ++i) {
+                std::string& b = slots_[(next_ + i) % slots_.size()];
+                iov_[i].iov_base = b.data();
+                iov_[i].iov_len = b.size();
+            }
+            lk.unlock();                    // chunks [next_, next_ + n) are ours until next_ moves
+            std::uint64_t calls = 0;
+            int err = writeAll(iov_.data(), n, calls);
+            lk.lock();
+            syscalls_ += calls;
+            if (err) {
+                error_ = err;
+                writing_ = false;
+                slotFree_.notify_all();
+                idle_.notify_all();
+                check();
+            }
+            for (std::size_t i = 0; i < n; ++i) ready_[(next_ + i) % slots_.size()] = false;
+            next_ += n;
+            run_ -= n;
+            slotFree_.notify_all();
+        }
+        writing_ = false;
+        idle_.notify_all();
+    }
+
+    // writev may stop part-way through an iovec: resume there.
+    // 0, or the errno of the failure
+    int writeAll(iovec* iov, std::size_t n, std::uint64_t& calls) {
+        while (n > 0) {
+            ssize_t w = ::writev(fd_, iov, static_cast<int>(n));
+            ++calls;
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                return errno;
+            }
+            std::size_t left = static_cast<std::size_t>(w);
+            while (n > 0 && left >= iov->iov_len) {
+                left -= iov->iov_len;
+                ++iov;
+                --n;
+            }
+            if (n > 0) {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+                iov->iov_len -= left;
+            }
+        }
+        return 0;
+    }
+
+    void check() const {
+        if (error_) throw std::system_error(error_, std::generic_category(), "OrderedWriter: writev");
+    }
+
+    const int fd_;
+    const std::size_t batch_;
+    mutable std::mutex m_;
+    std::condition_variable slotFree_, idle_;
+    std::vector<std::string> slots_;
+    std::vector<bool> ready_;           // slot committed, not yet written
+    std::vector<iovec> iov_;            // the writer's
+    std::uint64_t next_ = 0;            // first chunk not yet written
+    std::size_t run_ = 0;               // ready chunks from next_ on, without a gap
+    std::uint64_t syscalls_ = 0;
+    bool writing_ = false;
+    int error_ = 0;
+};
@@ -0,0 +1,185 @@
+// ======================================================
+// ParallelForEach.h — A functor over an index range, on persistent workers
+// ======================================================
+//
+// createThread.cpp:
+//
+//     class Base { public: void operator()(int x) { ... } };
+//     std::thread t(Base(), 10);
+//
+// Every std::thread construction type-erases the callable and
+// copies it (and its arguments) into a heap-allocated state,
+// then creates an OS thread. Launch Base over i = 0..N-1 that
+// way and N threads are created, run one call each, and die.
+//
+// HERE:
+//
+//     FunctorWorkers workers;                 // threads created ONCE
+//     workers.for_each(0, n, Base());         // Base()(i) for every i
+//     parallel_for_each_functor(0, n, Base()); // same, shared workers
+//
+// - the functor TYPE reaches the worker loop: for_each<F>
+//   instantiates trampoline<F>, a claim-a-chunk / call-f(i)
+//   loop compiled for F, so F::operator() inlines into it
+//   (and vectorizes, if its body allows). The only indirect
+//   call is one function-pointer call per worker per launch
+// - no std::function, no heap: the job is a few members of
+//   FunctorWorkers, indices are claimed in chunks of `grain`
+//   with one fetch_add each
+// - like std::thread, every participating thread works on its
+//   OWN COPY of the functor (so F must be copy-constructible);
+//   the calling thread participates too
+//
+// An exception thrown by f stops further chunks from being
+// claimed and is rethrown by for_each. Launches on one
+// FunctorWorkers are serialized; f must not launch on the
+// same FunctorWorkers (it would wait for itself).
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class FunctorWorkers {
+public:
+    // `threads` workers besides the caller (default: one per
+    // other core, so the caller makes up the last one)
+    explicit FunctorWorkers(unsigned threads = defaultThreads()) {
+        for (unsigned i = 0; i < threads; ++i) workers_.emplace_back(&FunctorWorkers::workerLoop, this);
+    }
+
+    FunctorWorkers(const FunctorWorkers&) = delete;
+    FunctorWorkers& operator=(const FunctorWorkers&) = delete;
+
+    ~FunctorWorkers() {
+        {
+            std::lock_guard<std::mutex> lg(m_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    std::size_t size() const { return workers_.size() + 1; }   // including the caller
+
+    // f(i) for every i in [first, last); grain = indices per claim
+    // (0: about 8 claims per participant)
+    template <typename F>
+    void for_each(long first, long last, const F& f, long grain = 0) {
+        static_assert(std::is_copy_constructible_v<F>, "for_each: the functor is copied into every participant");
+        if (first >= last) return;
+        std::lock_guard<std::mutex> launch(launchLock_);
+        long span = last - first;
+        if (grain <= 0) grain = std::max<long>(1, span / long(size() * 8));
+
+        run_ = &trampoline<F>;
+        functor_ = &f;
+        next_.store(first, std::memory_order_relaxed);
+        last_ = last;
+        grain_ = grain;
+        error_ = nullptr;
+        stop_.store(false, std::memory_order_relaxed);
+        if (span > grain && !workers_.empty()) {
+            {
+                std::lock_guard<std::mutex> lg(m_);
+                ++generation_;
+                busy_ = workers_.size();
+            }
+            wake_.notify_all();
+        }
+        participate();
+        {
+            std::unique_lock<std::mutex> lk(m_);
+            done_.wait(lk, [this] { return busy_ == 0; });
+        }
+        if (error_) std::rethrow_exception(error_);
+    }
+
+private:
+    static unsigned defaultThreads() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n > 1 ? n - 1 : 0;
+    }
+
+    // The per-functor-type loop: a local copy of F, chunks
+    // claimed until the range runs out
+    template <typename F>
+    static void trampoline(FunctorWorkers& w) {
+        F f(*static_cast<const F*>(w.functor_));
+        const long last = w.last_, grain = w.grain_;
+        for (;;) {
+            long a = w.next_.fetch_add(grain, std::memory_order_relaxed);
+            if (a >= last || w.stop_.load(std::memory_order_relaxed)) return;
+            long b = std::min(last, a + grain);
+            for (long i = a; i < b; ++i) f(i);
+        }
+    }
+
+    void participate() {
+        try {
+            run_(*this);
+        } catch (...) {
+            stop_.store(true, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lg(errorLock_);
+            if (!error_) error_ = std::current_exception();
+        }
+    }
+
+    void workerLoop() {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lk(m_);
+                wake_.wait(lk, [&] { return stopping_ || generation_ != seen; });
+                if (stopping_) return;
+                seen = generation_;
+            }
+            participate();
+            std::lock_guard<std::mutex> lg(m_);
+            if (--busy_ == 0) done_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex launchLock_;
+
+    // The current job (written under launchLock_, published by m_)
+    void (*run_)(FunctorWorkers&) = nullptr;
+    const void* functor_ = nullptr;
+    std::atomic<long> next_{0};
+    long last_ = 0;
+    long grain_ = 1;
+    std::atomic<bool> stop_{false};
+    std::mutex errorLock_;
+    std::exception_ptr error_;
+
+    std::mutex m_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::uint64_t generation_ = 0;
+    std::size_t busy_ = 0;
+    bool stopping_ = false;
+};
+
+namespace foreach_detail {
+
+inline FunctorWorkers& sharedWorkers() {
+    static FunctorWorkers workers;
+    return workers;
+}
+
+}  // namespace foreach_detail
+
+// On one FunctorWorkers shared by every call (like ParallelReduce's pool)
+template <typename F>
+void parallel_for_each_functor(long first, long last, const F& f, long grain = 0) {
+    foreach_detail::sharedWorkers().for_each(first, last, f, grain);
+}
@@ -0,0 +1,197 @@
+// ======================================================
+// PhasedFrameLoop.h — frame steps in phases, lanes synchronized by std::barrier
+// ======================================================
+//
+// Vtable.cpp / soaGameObjects.cpp:
+//
+//     for (auto* m : models) m->Update();      // one thread, every frame
+//
+// An update that reads OTHER objects (neighbours, targets) cannot
+// just be split across threads: object 7 would read object 8
+// while another thread is rewriting it. The usual fix is a lock
+// per object; the frame-step fix is PHASES and a DOUBLE BUFFER:
+//
+//   frame:  read    every lane reads the front state,   writes scratch
+//           ─ barrier ─
+//           compute every lane writes ITS objects' back state
+//           ─ barrier ─
+//           commit  every lane finishes ITS objects in the back state
+//           ─ barrier ─  (completion: onFrameEnd, e.g. swap front/back)
+//
+// Nobody writes what another lane reads in the same phase, so no
+// phase body takes a lock; the barrier between phases is the only
+// synchronization (and the memory fence: what one lane wrote in a
+// phase is visible to every lane in the next).
+//
+//     ThreadPool pool(7);
+//     PhasedFrameLoop loop(pool, 8);           // 8 lanes: the caller + 7 pool tasks
+//     loop.addPhase("read", [&](size_t b, size_t e) { ... });
+//     loop.addPhase("compute", ...);
+//     loop.addPhase("commit", ...);
+//     loop.onFrameEnd([&] { std::swap(front, back); });
+//     loop.run(objects, frames);
+//
+// - lanes: the caller runs lane 0, lanes 1..n-1 are tasks on the
+//   work-stealing ThreadPool (one per lane, for the whole run: a
+//   lane blocked at the barrier holds its worker, so lanes - 1
+//   must not exceed the pool's workers — checked — and the pool
+//   should not be busy with other long tasks)
+// - each lane owns a FIXED contiguous range of [0, objects) for
+//   every phase, split at multiples of 64 (no two lanes write one
+//   cache line of a float array)
+// - onFrameEnd runs once per frame on ONE thread (std::barrier's
+//   completion), while every lane waits
+// - timing from the barrier completions: wall time per phase, and
+//   per lane the time spent waiting at barriers (load imbalance)
+//
+// An exception in a phase body or onFrameEnd: the remaining phase
+// bodies of that frame are skipped, every lane still arrives at
+// every barrier, the run stops at the end of the frame and run()
+// rethrows the first exception.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ThreadPool.h"
+
+class PhasedFrameLoop {
+public:
+    using Body = std::function<void(std::size_t begin, std::size_t end)>;
+
+    struct Stats {
+        std::uint64_t frames = 0;
+        std::vector<std::string> phaseNames;
+        std::vector<double> phaseMs;            // wall time per phase, all frames
+        std::vector<double> laneWaitMs;         // per lane, blocked at barriers
+        double frameEndMs = 0;                  // onFrameEnd
+    };
+
+    // Throws std::invalid_argument unless 1 <= lanes <= pool.size() + 1
+    PhasedFrameLoop(ThreadPool& pool, unsigned lanes) : pool_(pool), lanes_(lanes) {
+        if (lanes == 0 || lanes > pool.size() + 1)
+            throw std::invalid_argument("PhasedFrameLoop: lanes must be 1 .. pool.size() + 1");
+    }
+
+    void addPhase(std::string name, Body body) { phases_.push_back({std::move(name), std::move(body)}); }
+    void onFrameEnd(std::function<void()> f) { frameEnd_ = std::move(f); }
+
+    unsigned lanes() const { return lanes_; }
+
+    // Lane l's objects: [begin, end)
+    std::pair<std::size_t, std::size_t> range(std::size_t objects, unsigned l) const {
+        const std::size_t blocks = (objects + kAlign - 1) / kAlign;
+        const std::size_t b = std::min(objects, blocks * l / lanes_ * kAlign);
+        const std::size_t e = std::min(objects, blocks * (l + 1) / lanes_ * kAlign);
+        return {b, e};
+    }
+
+    void run(std::size_t objects, std::uint64_t frames) {
+        if (phases_.empty() || frames == 0) return;
+        stats_ = Stats{};
+        for (const Phase& p : phases_) stats_.phaseNames.push_back(p.name);
+        stats_.phaseMs.assign(phases_.size(), 0.0);
+        stats_.laneWaitMs.assign(lanes_, 0.0);
+        error_ = nullptr;
+        failed_.store(false, std::memory_order_relaxed);
+        stop_ = false;
+        phase_ = 0;
+
+        // Runs on the last lane to arrive, before any lane is released
+        auto completion = [this]() noexcept {
+            clock::time_point now = clock::now();
+            stats_.phaseMs[phase_] += ms(now - mark_);
+            if (++phase_ == phases_.size()) {
+                phase_ = 0;
+                ++stats_.frames;
+                if (frameEnd_ && !failed_.load(std::memory_order_relaxed)) {
+                    try {
+                        frameEnd_();
+                    } catch (...) {
+                        fail(std::current_exception());
+                    }
+                    const clock::time_point after = clock::now();
+                    stats_.frameEndMs += ms(after - now);
+                    now = after;
+                }
+                stop_ = failed_.load(std::memory_order_relaxed);
+            }
+            mark_ = now;
+        };
+        std::barrier sync(std::ptrdiff_t(lanes_), completion);
+
+        auto lane = [&](unsigned l) {
+            const auto [b, e] = range(objects, l);
+            double waited = 0;
+            // stop_ is written by the completion, read after the barrier
+            for (std::uint64_t f = 0; f < frames && !stop_; ++f)
+                for (const Phase& p : phases_) {
+                    if (!failed_.load(std::memory_order_relaxed)) {
+                        try {
+                            p.body(b, e);
+                        } catch (...) {
+                            fail(std::current_exception());
+                        }
+                    }
+                    const clock::time_point t0 = clock::now();
+                    sync.arrive_and_wait();
+                    waited += ms(clock::now() - t0);
+                }
+            stats_.laneWaitMs[l] = waited;
+        };
+
+        mark_ = clock::now();
+        std::vector<std::future<void>> others;
+        others.reserve(lanes_ - 1);
+        for (unsigned l = 1; l < lanes_; ++l) others.push_back(pool_.submit(lane, l));
+        lane(0);
+        for (auto& f : others) f.get();
+        if (error_) std::rethrow_exception(error_);
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    using clock = std::chrono::steady_clock;
+    static constexpr std::size_t kAlign = 64;
+
+    struct Phase {
+        std::string name;
+        Body body;
+    };
+
+    static double ms(clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); }
+
+    void fail(std::exception_ptr e) {
+        std::lock_guard<std::mutex> lg(errorMutex_);
+        if (!error_) error_ = std::move(e);
+        failed_.store(true, std::memory_order_relaxed);
+    }
+
+    ThreadPool& pool_;
+    const unsigned lanes_;
+    std::vector<Phase> phases_;
+    std::function<void()> frameEnd_;
+
+    // Per run; phase_, mark_ and stop_ only touched in the completion
+    // (and read by lanes after a barrier)
+    Stats stats_;
+    std::size_t phase_ = 0;
+    clock::time_point mark_;
+    bool stop_ = false;
+    std::atomic<bool> failed_{false};
+    std::mutex errorMutex_;
+    std::exception_ptr error_;
+};
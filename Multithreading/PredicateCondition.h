@@ -0,0 +1,215 @@
+// ======================================================
+// PredicateCondition.h — condition variable that wakes only satisfied waiters
+// ======================================================
+//
+// ConditionVariable.cpp:
+//
+//     std::lock_guard<mutex> lg(m);
+//     balance += money;
+//     cv.notify_one();                 // under the lock
+//     ...
+//     cv.wait(ul, [] { return balance != 0; });
+//
+// Three costs once there are many waiters:
+//   - notify under the lock: the woken thread runs straight into
+//     the mutex it needs and goes back to sleep (hurry up and wait)
+//   - waiters want DIFFERENT things (balance >= 500, >= 20, ...);
+//     notify_one may pick one whose condition is still false (and
+//     the eligible one sleeps on: a lost wakeup), so correct code
+//     falls back to notify_all — every waiter wakes, locks, checks
+//   - several notifies in a row wake several times for one change
+//
+// PredicateCondition registers each waiter's PREDICATE with it.
+// A notifier only marks "state changed"; when its Guard unlocks:
+//   - the predicates are evaluated once, under the lock, by the
+//     notifier (no thread is woken just to check)
+//   - notify_one(): the first waiter (FIFO) whose predicate is
+//     true is woken; notify_all(): every such waiter
+//   - the wake-ups happen AFTER the mutex is released
+//   - repeated notifies before the unlock coalesce into one pass,
+//     and a waiter already chosen is never woken twice
+//
+// A woken waiter relocks and re-checks (another thread may have
+// got there first); WaitStats counts how often that was futile.
+//
+// Waiters that CONSUME the state (withdraw money) should pass the
+// baton: notify_one() after consuming, so the next waiter whose
+// condition still holds is woken — one wake-up per served waiter.
+//
+// Usage:
+//     PredicateCondition pc;
+//     {   auto g = pc.lock();                      // deposit
+//         balance += money;
+//         g.notify_one();
+//     }                                            // wake here
+//     {   auto g = pc.lock();                      // withdraw
+//         g.wait([&] { return balance >= want; });
+//         balance -= want;
+//         g.notify_one();                          // baton
+//     }
+//
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <semaphore>
+#include <utility>
+
+struct WaitStats {
+    std::uint64_t notifications = 0;   // notify_one/notify_all calls
+    std::uint64_t passes = 0;          // evaluation rounds: one per unlock with pending notifies
+    std::uint64_t wakeups = 0;         // waiters woken
+    std::uint64_t futile = 0;          // ... whose predicate was false again once relocked
+};
+
+class PredicateCondition {
+    struct Waiter {
+        bool (*check)(void*);
+        void* pred;
+        Waiter* prev = nullptr;
+        Waiter* next = nullptr;
+        Waiter* wakeNext = nullptr;
+        bool linked = false;
+        std::binary_semaphore sem{0};
+    };
+
+    enum Mode { None, One, All };
+
+public:
+    PredicateCondition() = default;
+    PredicateCondition(const PredicateCondition&) = delete;
+    PredicateCondition& operator=(const PredicateCondition&) = delete;
+
+    // The lock, plus the notifications to deliver when it is released
+    class Guard {
+    public:
+        explicit Guard(PredicateCondition& c) : c_(c), lk_(c.m_) {}
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard() { c_.release(lk_, mode_); }
+
+        void notify_one() {
+            ++c_.stats_.notifications;
+            if (mode_ == None) mode_ = One;
+        }
+
+        void notify_all() {
+            ++c_.stats_.notifications;
+            mode_ = All;
+        }
+
+        template <typename Pred>
+        void wait(Pred pred) {
+            if (pred()) return;
+            for (;;) {
+                Waiter w{&call<Pred>, &pred};
+                c_.enqueue(w);
+                c_.release(lk_, std::exchange(mode_, None));
+                w.sem.acquire();
+                lk_.lock();
+                if (c_.woken(pred)) return;
+            }
+        }
+
+        // false: timed out with the predicate still false
+        template <typename Clock, typename Duration, typename Pred>
+        bool wait_until(const std::chrono::time_point<Clock, Duration>& deadline, Pred pred) {
+            if (pred()) return true;
+            for (;;) {
+                Waiter w{&call<Pred>, &pred};
+                c_.enqueue(w);
+                c_.release(lk_, std::exchange(mode_, None));
+                bool signalled = w.sem.try_acquire_until(deadline);
+                lk_.lock();
+                if (!signalled) {
+                    if (w.linked) {
+                        c_.unlink(w);
+                        return pred();
+                    }
+                    // Chosen just as we timed out: the release is on its way
+                    w.sem.acquire();
+                }
+                if (c_.woken(pred)) return true;
+            }
+        }
+
+        template <typename Rep, typename Period, typename Pred>
+        bool wait_for(const std::chrono::duration<Rep, Period>& timeout, Pred pred) {
+            return wait_until(std::chrono::steady_clock::now() + timeout, pred);
+        }
+
+    private:
+        template <typename Pred>
+        static bool call(void* p) {
+            return (*static_cast<Pred*>(p))();
+        }
+
+        PredicateCondition& c_;
+        std::unique_lock<std::mutex> lk_;
+        Mode mode_ = None;
+    };
+
+    Guard lock() { return Guard(*this); }
+
+    WaitStats stats() {
+        std::lock_guard<std::mutex> lg(m_);
+        return stats_;
+    }
+
+private:
+    void enqueue(Waiter& w) {
+        w.prev = tail_;
+        w.next = nullptr;
+        if (tail_) tail_->next = &w;
+        else head_ = &w;
+        tail_ = &w;
+        w.linked = true;
+    }
+
+    void unlink(Waiter& w) {
+        if (w.prev) w.prev->next = w.next;
+        else head_ = w.next;
+        if (w.next) w.next->prev = w.prev;
+        else tail_ = w.prev;
+        w.linked = false;
+    }
+
+    template <typename Pred>
+    bool woken(Pred& pred) {
+        ++stats_.wakeups;
+        if (pred()) return true;
+        ++stats_.futile;
+        return false;
+    }
+
+    // Under the lock: choose waiters. Then unlock, then wake them.
+    void release(std::unique_lock<std::mutex>& lk, Mode mode) {
+        Waiter* wake = nullptr;
+        if (mode != None) {
+            ++stats_.passes;
+            Waiter** last = &wake;
+            for (Waiter* w = head_; w;) {
+                Waiter* next = w->next;
+                if (w->check(w->pred)) {
+                    unlink(*w);
+                    *last = w;
+                    last = &w->wakeNext;
+                    if (mode == One) break;
+                }
+                w = next;
+            }
+        }
+        lk.unlock();
+        while (wake) {
+            Waiter* next = wake->wakeNext;              // read before the waiter may return
+            wake->sem.release();
+            wake = next;
+        }
+    }
+
+    std::mutex m_;
+    Waiter* head_ = nullptr;
+    Waiter* tail_ = nullptr;
+    WaitStats stats_;
+};
@@ -0,0 +1,237 @@
+// ======================================================
+// PriorityScheduler.h — latency classes on top of ThreadPool
+// ======================================================
+//
+// Threads/priority.cpp:
+//
+//     SetThreadPriority(hThread, THREAD_PRIORITY_HIGHEST);
+//
+// raises ONE OS thread. Work that shares a pool has nothing of the
+// kind: ThreadPool runs tasks roughly in submission order, so an
+// interactive request queued behind a few thousand batch chunks
+// waits for all of them. More threads at a higher OS priority
+// would help, at the cost of oversubscribing the cores.
+//
+// PriorityScheduler keeps the pool's threads and orders the WORK:
+//
+//     PriorityScheduler sched;                          // one worker per core
+//     sched.post(TaskClass::Batch, [&] { crunch(chunk); });
+//     auto f = sched.submit(TaskClass::Interactive, handleClick, ev);
+//
+// HOW IT RUNS:
+// - one FIFO queue per class (Interactive, Normal, Batch), under a
+//   single mutex; every entry carries its enqueue time
+// - each post() queues the task, then posts a generic "runner" to
+//   the pool. A runner does not run the task it was posted for but
+//   the most urgent one queued when it starts — so an Interactive
+//   task overtakes every Batch task not yet started. A task that
+//   is already running is never interrupted: chunk batch work
+//   finely and the worst wait is one chunk.
+// - aging: a task of class L competes as if it had been queued
+//   L * agingStep later than it was, and the queue heads run in
+//   that order. So Batch work keeps moving under a steady
+//   Interactive stream: it overtakes every Interactive task queued
+//   more than 2 * agingStep after it, and waits at most that long
+//   plus the work queued ahead of it. `agingStep = max()` turns it
+//   off (strict classes: Batch can starve)
+// - reserved workers (Options::reserved): a second, small pool
+//   whose threads run Interactive tasks only, optionally pinned
+//   and raised via ThreadConfig (`reservedConfig`, e.g. the last
+//   core at ThreadPriority::Highest). Interactive latency then no
+//   longer waits for a running batch chunk to end; the shared pool
+//   gets `threads - reserved` workers, so the machine is not
+//   oversubscribed.
+//
+// Every task runs exactly once: each post() adds one runner to the
+// shared pool (plus one to the reserved pool for Interactive), a
+// runner that finds nothing to do returns at once, and the task is
+// queued before its runner. The destructor runs everything queued.
+//
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "ThreadPool.h"
+#include "../Threads/ThreadConfig.h"
+
+// Most urgent first
+enum class TaskClass : unsigned { Interactive, Normal, Batch };
+
+class PriorityScheduler {
+public:
+    static constexpr std::size_t kClasses = 3;
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        unsigned threads = std::thread::hardware_concurrency();   // total, reserved included
+        Clock::duration agingStep = std::chrono::milliseconds(20);  // Clock::duration::max() → no aging
+        unsigned reserved = 0;                                      // workers for Interactive only
+        ThreadConfig reservedConfig;                                // applied to each reserved worker
+    };
+
+    // Per class, since construction
+    struct ClassStats {
+        std::size_t submitted = 0;
+        std::size_t run = 0;
+        std::size_t aged = 0;                    // started ahead of a more urgent queued task
+        Clock::duration maxWait{};               // longest enqueue → start
+    };
+
+    PriorityScheduler() : PriorityScheduler(Options{}) {}
+
+    explicit PriorityScheduler(Options opt) : opt_(std::move(opt)) {
+        const unsigned total = std::max(opt_.threads, 1u);
+        if (opt_.reserved > total) throw std::invalid_argument("PriorityScheduler: more reserved workers than threads");
+        if (opt_.agingStep <= Clock::duration::zero())
+            throw std::invalid_argument("PriorityScheduler: agingStep must be positive");
+        // The shared pool keeps one worker even if all are reserved
+        // (then the pools share those cores)
+        shared_ = std::make_unique<ThreadPool>(std::max(total - opt_.reserved, 1u));
+        if (opt_.reserved) {
+            reservedPool_ = std::make_unique<ThreadPool>(opt_.reserved);
+            configureReserved();
+        }
+    }
+
+    PriorityScheduler(const PriorityScheduler&) = delete;
+    PriorityScheduler& operator=(const PriorityScheduler&) = delete;
+
+    // Runs everything still queued, then joins both pools
+    ~PriorityScheduler() {
+        reservedPool_.reset();
+        shared_.reset();
+    }
+
+    template <typename F, typename... Args>
+    auto submit(TaskClass c, F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
+        using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+
+        std::packaged_task<R()> task(
+            [fn = std::forward<F>(f), tup = std::make_tuple(std::forward<Args>(args)...)]() mutable -> R {
+                return std::apply(std::move(fn), std::move(tup));
+            });
+        std::future<R> fut = task.get_future();
+        post(c, ThreadPool::Task(std::move(task)));
+        return fut;
+    }
+
+    void post(TaskClass c, ThreadPool::Task task) {
+        const auto level = static_cast<std::size_t>(c);
+        if (level >= kClasses) throw std::invalid_argument("PriorityScheduler: unknown TaskClass");
+        {
+            std::lock_guard<std::mutex> lg(m_);
+            queues_[level].push_back({std::move(task), Clock::now()});
+            ++stats_[level].submitted;
+        }
+        shared_->post([this] { runNext(kClasses); });
+        if (reservedPool_ && c == TaskClass::Interactive) reservedPool_->post([this] { runNext(1); });
+    }
+
+    std::size_t threads() const { return shared_->size() + (reservedPool_ ? reservedPool_->size() : 0); }
+    std::size_t reservedThreads() const { return reservedPool_ ? reservedPool_->size() : 0; }
+
+    // What the reserved workers' ThreadConfig did not apply
+    ThreadConfigStatus reservedStatus() const { return reservedStatus_; }
+
+    ClassStats stats(TaskClass c) const {
+        std::lock_guard<std::mutex> lg(m_);
+        return stats_[static_cast<std::size_t>(c)];
+    }
+
+    std::size_t queued() const {
+        std::lock_guard<std::mutex> lg(m_);
+        std::size_t n = 0;
+        for (const auto& q : queues_) n += q.size();
+        return n;
+    }
+
+private:
+    struct Entry {
+        ThreadPool::Task task;
+        Clock::time_point enqueued;
+    };
+
+    // Run the most urgent task among the first `classes` classes
+    // (1: Interactive only, for reserved workers), if any
+    void runNext(std::size_t classes) {
+        ThreadPool::Task t;
+        {
+            std::lock_guard<std::mutex> lg(m_);
+            const Clock::time_point now = Clock::now();
+            // Smallest virtual arrival: enqueue time + level * agingStep
+            std::size_t best = kClasses, firstNonEmpty = kClasses;
+            Clock::time_point bestDue{};
+            for (std::size_t level = 0; level < classes; ++level) {
+                if (queues_[level].empty()) continue;
+                if (firstNonEmpty == kClasses) firstNonEmpty = level;
+                const Clock::time_point due = virtualArrival(queues_[level].front().enqueued, level);
+                if (best == kClasses || due < bestDue) best = level, bestDue = due;
+            }
+            if (best == kClasses) return;                   // someone else took it
+            Entry e = std::move(queues_[best].front());
+            queues_[best].pop_front();
+            ClassStats& s = stats_[best];
+            ++s.run;
+            if (best != firstNonEmpty) ++s.aged;
+            s.maxWait = std::max(s.maxWait, now - e.enqueued);
+            t = std::move(e.task);
+        }
+        t();
+    }
+
+    // Heads of the queues compete on this; ties go to the more
+    // urgent class. No aging: the class alone decides
+    Clock::time_point virtualArrival(Clock::time_point enqueued, std::size_t level) const {
+        if (opt_.agingStep == Clock::duration::max()) return Clock::time_point{} + Clock::duration(level);
+        return enqueued + opt_.agingStep * static_cast<Clock::rep>(level);
+    }
+
+    // One blocking task per reserved worker, so each applies the
+    // config to itself (one that is waiting cannot take a second).
+    // Shared state: a worker may still be leaving arrive_and_wait()
+    // when the constructor returns
+    void configureReserved() {
+        struct Sync {
+            std::latch arrived;
+            std::mutex m;
+            ThreadConfigStatus status;
+            explicit Sync(std::ptrdiff_t n) : arrived(n) {}
+        };
+        const std::size_t n = reservedPool_->size();
+        auto sync = std::make_shared<Sync>(static_cast<std::ptrdiff_t>(n));
+        for (std::size_t i = 0; i < n; ++i) {
+            reservedPool_->post([sync, cfg = opt_.reservedConfig] {
+                const ThreadConfigStatus st = applyToCurrentThread(cfg);
+                {
+                    std::lock_guard<std::mutex> lg(sync->m);
+                    sync->status.failed |= st.failed;
+                    if (!sync->status.error) sync->status.error = st.error;
+                }
+                sync->arrived.arrive_and_wait();
+            });
+        }
+        sync->arrived.wait();
+        std::lock_guard<std::mutex> lg(sync->m);
+        reservedStatus_ = sync->status;
+    }
+
+    Options opt_;
+    mutable std::mutex m_;
+    std::array<std::deque<Entry>, kClasses> queues_;
+    std::array<ClassStats, kClasses> stats_{};
+    ThreadConfigStatus reservedStatus_;
+    std::unique_ptr<ThreadPool> shared_;
+    std::unique_ptr<ThreadPool> reservedPool_;
+};
@@ -107,6 +107,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <deque>
+#include "Trace.h"              // zones: TRACE_FILE=trace.json TRACE_PERIOD_MS=500 (the consumer never exits)
 std::condition_variable cond;
 std::deque<int> buffer;
 std::mutex mu;
@@ -120,12 +121,14 @@ const unsigned int maxBufferSize = 50;
 // - Stops when val becomes 0
 //
 void producer(int val) {
+    TRACE_THREAD_NAME("producer");
 
     // Produce until val becomes 0
     while (val) {
 
         // unique_lock is REQUIRED with condition_variable
         // because wait() needs to unlock & relock mutex
+        TRACE_SCOPE("produce");
         std::unique_lock<std::mutex> locker(mu);
 
         // WAIT until buffer has space
@@ -134,9 +137,12 @@ void producer(int val) {
         // - Reacquires mutex when notified
         // - Predicate protects against spurious wakeups
         //
-        cond.wait(locker, []() {
-            return buffer.size() < maxBufferSize;
-        });
+        {
+            TRACE_SCOPE("wait space");
+            cond.wait(locker, []() {
+                return buffer.size() < maxBufferSize;
+            });
+        }
 
         // ---- CRITICAL SECTION START ----
         buffer.push_back(val);
@@ -160,9 +166,11 @@ void producer(int val) {
 // - Runs indefinitely
 //
 void consumer() {
+    TRACE_THREAD_NAME("consumer");
 
     while (true) {
 
+        TRACE_SCOPE("consume");
         std::unique_lock<std::mutex> locker(mu);
 
         // WAIT until buffer has data
@@ -170,9 +178,12 @@ void consumer() {
         // - If buffer empty → wait
         // - Mutex is released during wait
         //
-        cond.wait(locker, []() {
-            return buffer.size() > 0;
-        });
+        {
+            TRACE_SCOPE("wait item");
+            cond.wait(locker, []() {
+                return buffer.size() > 0;
+            });
+        }
 
         // ---- CRITICAL SECTION START ----
         int val = buffer.back();
@@ -0,0 +1,329 @@
+// ======================================================
+// ProfiledMutex.h — Contention-profiling mutex wrapper
+// ======================================================
+//
+// A drop-in replacement for std::mutex that answers:
+// - How long did threads WAIT to get the lock?
+// - How long did they HOLD it?
+// - How often did try_lock() FAIL?
+// ...per CALL SITE (file:line), with a report at exit.
+//
+// LOCKABLE:
+// lock() / unlock() / try_lock() have the std::mutex
+// signatures, so std::lock_guard, std::unique_lock,
+// std::scoped_lock, std::lock and std::try_lock all work.
+//
+// CALL SITES:
+// lock()/try_lock() record std::source_location of the
+// caller. When the call comes through std::lock_guard the
+// "caller" is the guard itself, so use
+//     ProfiledMutex::Guard g(m);     // records THIS line
+// when per-line attribution matters. Each mutex tracks its first
+// 8 sites; any further ones are reported together as
+// "(other call sites)".
+//
+// OVERHEAD:
+// - Compile with -DPROFILED_MUTEX=0 → plain std::mutex
+//   forwarding, nothing recorded at all
+// - Otherwise profiling can be switched off at runtime with
+//   ProfiledMutex::setEnabled(false): one relaxed load and
+//   a predictable branch per call
+//
+// Report goes to stderr at exit (set PROFILED_MUTEX_QUIET=1
+// in the environment to suppress it).
+//
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <vector>
+
+#ifndef PROFILED_MUTEX
+#define PROFILED_MUTEX 1
+#endif
+
+namespace mutex_profile {
+
+// log2(nanoseconds) buckets: bucket k covers [2^k, 2^(k+1)) ns
+constexpr int kBuckets = 40;
+
+struct Histogram {
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets{};
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> totalNs{0};
+    std::atomic<std::uint64_t> maxNs{0};
+
+    void record(std::uint64_t ns) {
+        int b = ns == 0 ? 0 : 63 - __builtin_clzll(ns);
+        if (b >= kBuckets) b = kBuckets - 1;
+        buckets[b].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        totalNs.fetch_add(ns, std::memory_order_relaxed);
+        std::uint64_t prev = maxNs.load(std::memory_order_relaxed);
+        while (ns > prev && !maxNs.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {}
+    }
+
+    // Smallest bucket upper bound that covers fraction q of samples
+    std::uint64_t percentileNs(double q) const {
+        std::uint64_t n = count.load(std::memory_order_relaxed);
+        if (n == 0) return 0;
+        std::uint64_t target = (std::uint64_t)(q * (double)n), seen = 0;
+        for (int b = 0; b < kBuckets; ++b) {
+            seen += buckets[b].load(std::memory_order_relaxed);
+            if (seen > target) return 2ull << b;
+        }
+        return 2ull << (kBuckets - 1);
+    }
+};
+
+struct SiteStats {
+    std::string mutexName;
+    const char* file;
+    unsigned line;
+    Histogram wait;
+    Histogram hold;
+    std::atomic<std::uint64_t> tryLockOk{0};
+    std::atomic<std::uint64_t> tryLockFail{0};
+};
+
+// Owns every SiteStats so data survives the mutexes; prints at exit
+class Registry {
+public:
+    static Registry& instance() {
+        static Registry r;
+        return r;
+    }
+
+    SiteStats* create(const std::string& mutexName, const char* file, unsigned line) {
+        std::lock_guard<std::mutex> lg(m_);
+        sites_.push_back(std::make_unique<SiteStats>());
+        SiteStats* s = sites_.back().get();
+        s->mutexName = mutexName;
+        s->file = file;
+        s->line = line;
+        return s;
+    }
+
+    void report(std::FILE* out) {
+        std::lock_guard<std::mutex> lg(m_);
+        std::fprintf(out, "\n===== ProfiledMutex report =====\n");
+        for (auto& s : sites_) {
+            const char* base = std::strrchr(s->file, '/');
+            base = base ? base + 1 : s->file;
+            if (s->line)
+                std::fprintf(out, "[%s] %s:%u\n", s->mutexName.c_str(), base, s->line);
+            else
+                std::fprintf(out, "[%s] %s\n", s->mutexName.c_str(), base);
+            printHist(out, "  wait", s->wait);
+            printHist(out, "  hold", s->hold);
+            std::uint64_t ok = s->tryLockOk.load(), fail = s->tryLockFail.load();
+            if (ok + fail)
+                std::fprintf(out, "  try_lock: %llu ok, %llu failed (%.1f%%)\n",
+                             (unsigned long long)ok, (unsigned long long)fail,
+                             100.0 * (double)fail / (double)(ok + fail));
+        }
+    }
+
+    ~Registry() {
+        const char* quiet = std::getenv("PROFILED_MUTEX_QUIET");
+        if (!(quiet && *quiet == '1') && !sites_.empty()) report(stderr);
+    }
+
+private:
+    static void printHist(std::FILE* out, const char* label, const Histogram& h) {
+        std::uint64_t n = h.count.load();
+        if (n == 0) return;
+        std::fprintf(out, "%s: n=%llu avg=%lluns p50<%lluns p99<%lluns max=%lluns\n", label,
+                     (unsigned long long)n, (unsigned long long)(h.totalNs.load() / n),
+                     (unsigned long long)h.percentileNs(0.50),
+                     (unsigned long long)h.percentileNs(0.99),
+                     (unsigned long long)h.maxNs.load());
+    }
+
+    std::mutex m_;
+    std::vector<std::unique_ptr<SiteStats>> sites_;
+};
+
+inline std::atomic<bool>& enabledFlag() {
+    static std::atomic<bool> flag{true};
+    return flag;
+}
+
+}  // namespace mutex_profile
+
+#if PROFILED_MUTEX
+
+class ProfiledMutex {
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit ProfiledMutex(const char* name = nullptr,
+                           std::source_location decl = std::source_location::current())
+        : name_(name ? name
+                     : std::string(decl.file_name()) + ":" + std::to_string(decl.line())) {
+        // Make sure the registry outlives every static ProfiledMutex
+        mutex_profile::Registry::instance();
+    }
+
+    ProfiledMutex(const ProfiledMutex&) = delete;
+    ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+    static void setEnabled(bool on) { mutex_profile::enabledFlag().store(on); }
+    static bool enabled() { return mutex_profile::enabledFlag().load(std::memory_order_relaxed); }
+
+    void lock(std::source_location site = std::source_location::current()) {
+        if (!enabled()) {
+            m_.lock();
+            holdSite_ = nullptr;
+            return;
+        }
+        SiteStats* s = siteFor(site);
+        // Fast path: uncontended → wait time is zero
+        if (m_.try_lock()) {
+            s->wait.record(0);
+        } else {
+            auto t0 = clock::now();
+            m_.lock();
+            s->wait.record(nanosSince(t0));
+        }
+        startHold(s);
+    }
+
+    bool try_lock(std::source_location site = std::source_location::current()) {
+        if (!enabled()) {
+            bool ok = m_.try_lock();
+            if (ok) holdSite_ = nullptr;
+            return ok;
+        }
+        SiteStats* s = siteFor(site);
+        if (!m_.try_lock()) {
+            s->tryLockFail.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        s->tryLockOk.fetch_add(1, std::memory_order_relaxed);
+        startHold(s);
+        return true;
+    }
+
+    void unlock() {
+        // Only the holder touches holdSite_/holdStart_
+        if (holdSite_) holdSite_->hold.record(nanosSince(holdStart_));
+        m_.unlock();
+    }
+
+    // lock_guard equivalent that records the line it is created on
+    class Guard {
+    public:
+        explicit Guard(ProfiledMutex& m,
+                       std::source_location site = std::source_location::current())
+            : m_(m) { m_.lock(site); }
+        ~Guard() { m_.unlock(); }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        ProfiledMutex& m_;
+    };
+
+private:
+    using SiteStats = mutex_profile::SiteStats;
+    static constexpr int kSiteCache = 8;
+
+    static std::uint64_t nanosSince(clock::time_point t0) {
+        return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   clock::now() - t0).count();
+    }
+
+    void startHold(SiteStats* s) {
+        holdSite_ = s;
+        holdStart_ = clock::now();
+    }
+
+    // Small per-mutex cache: (file pointer, line) → stats.
+    // Lookups are lock-free; inserts take the cache lock once per site.
+    // Sites past the first kSiteCache share one "other call sites"
+    // entry, created once.
+    SiteStats* siteFor(const std::source_location& loc) {
+        int n = siteCount_.load(std::memory_order_acquire);
+        for (int i = 0; i < n; ++i)
+            if (sites_[i].line == loc.line() && sites_[i].file == loc.file_name())
+                return sites_[i].stats;
+        if (n == kSiteCache)
+            if (SiteStats* other = otherSites_.load(std::memory_order_acquire)) return other;
+
+        std::lock_guard<std::mutex> lg(cacheMutex_);
+        n = siteCount_.load(std::memory_order_relaxed);
+        for (int i = 0; i < n; ++i)
+            if (sites_[i].line == loc.line() && sites_[i].file == loc.file_name())
+                return sites_[i].stats;
+        if (n == kSiteCache) {
+            SiteStats* other = otherSites_.load(std::memory_order_relaxed);
+            if (!other) {
+                other = mutex_profile::Registry::instance().create(name_, "(other call sites)", 0);
+                otherSites_.store(other, std::memory_order_release);
+            }
+            return other;
+        }
+        SiteStats* s = mutex_profile::Registry::instance().create(name_, loc.file_name(), loc.line());
+        sites_[n] = {loc.file_name(), loc.line(), s};
+        siteCount_.store(n + 1, std::memory_order_release);
+        return s;
+    }
+
+    struct SiteSlot {
+        const char* file;
+        unsigned line;
+        SiteStats* stats;
+    };
+
+    std::mutex m_;
+    std::string name_;
+    SiteStats* holdSite_ = nullptr;
+    clock::time_point holdStart_{};
+
+    std::mutex cacheMutex_;
+    std::array<SiteSlot, kSiteCache> sites_{};
+    std::atomic<int> siteCount_{0};
+    std::atomic<SiteStats*> otherSites_{nullptr};
+};
+
+#else  // PROFILED_MUTEX == 0 → zero-cost forwarding
+
+class ProfiledMutex {
+public:
+    explicit ProfiledMutex(const char* = nullptr) {}
+    ProfiledMutex(const ProfiledMutex&) = delete;
+    ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+    static void setEnabled(bool) {}
+    static bool enabled() { return false; }
+
+    void lock() { m_.lock(); }
+    bool try_lock() { return m_.try_lock(); }
+    void unlock() { m_.unlock(); }
+
+    class Guard {
+    public:
+        explicit Guard(ProfiledMutex& m) : m_(m) { m_.lock(); }
+        ~Guard() { m_.unlock(); }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        ProfiledMutex& m_;
+    };
+
+private:
+    std::mutex m_;
+};
+
+#endif
@@ -0,0 +1,120 @@
+// ======================================================
+// RcuCell.h — read-copy-update cell for read-mostly shared state
+// ======================================================
+//
+// static.cpp / assertionExaple.cpp / ProducerConsumerproblemUsingThread.cpp:
+//
+//     static int instances;                     // Player::instances
+//     int maxPlayers;                           // Game::maxPlayers
+//     const unsigned int maxBufferSize = 50;
+//
+// Configuration like this is read on every hot path and changed
+// almost never. Today it either cannot change at all (const) or
+// every read takes the mutex a writer would need.
+//
+// RcuCell<T> keeps the value in an IMMUTABLE heap snapshot:
+//
+//     RcuCell<GameConfig> config(GameConfig{64, 4096});
+//
+//     auto cfg = config.read();          // pin + one acquire load
+//     if (index < cfg->maxPlayers) ...   // cfg stays valid until it
+//                                        // goes out of scope
+//
+//     config.update([](GameConfig& c) { c.maxPlayers = 128; });
+//
+// - read(): pins the reclaimer (EpochDomain.h by default — a store
+//   to the thread's own record plus a compiler fence) and loads the
+//   pointer: no lock, no atomic read-modify-write, readers never
+//   write a shared cache line
+// - update(f) / store(v): COPY the current snapshot, modify the
+//   copy, publish it with one release store; the old snapshot is
+//   retired and freed once every reader that could still see it
+//   has unpinned. Writers serialise on a mutex; readers never wait
+//   for them — a hot reconfiguration needs no pause
+// - every snapshot carries a version number (1, 2, ...)
+//
+// A reader keeps the snapshot it got: two reads in a row may see
+// two versions. Read once per operation for a consistent view.
+//
+// RcuCell<T, HazardDomain> bounds the garbage a stalled reader can
+// hold back, at a slightly dearer read (Reclaimer.h).
+//
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "Reclaimer.h"
+
+template <typename T, Reclaimer R = EpochReclaimer>
+class RcuCell {
+    struct Snapshot {
+        T value;
+        std::uint64_t version;
+    };
+
+public:
+    // A pinned reference to one snapshot
+    class ReadGuard {
+    public:
+        const T& operator*() const { return snapshot_->value; }
+        const T* operator->() const { return &snapshot_->value; }
+        const T& get() const { return snapshot_->value; }
+        std::uint64_t version() const { return snapshot_->version; }
+
+    private:
+        friend class RcuCell;
+        ReadGuard(typename R::Guard guard, const Snapshot* s) : guard_(std::move(guard)), snapshot_(s) {}
+
+        typename R::Guard guard_;
+        const Snapshot* snapshot_;
+    };
+
+    explicit RcuCell(T initial, R& domain = R::global())
+        : domain_(domain), current_(new Snapshot{std::move(initial), 1}) {}
+
+    RcuCell(const RcuCell&) = delete;
+    RcuCell& operator=(const RcuCell&) = delete;
+
+    // No reader may hold a ReadGuard any more
+    ~RcuCell() { delete current_.load(std::memory_order_relaxed); }
+
+    ReadGuard read() const {
+        typename R::Guard guard = domain_.pin();
+        const Snapshot* s = guard.protect(current_);  // cannot be freed while guard lives
+        return ReadGuard(std::move(guard), s);
+    }
+
+    // Copy, modify, publish; returns the new version
+    template <typename F>
+    std::uint64_t update(F&& modify) {
+        std::lock_guard<std::mutex> lock(writer_);
+        const Snapshot* old = current_.load(std::memory_order_relaxed);
+        std::unique_ptr<Snapshot> next(new Snapshot{old->value, old->version + 1});
+        std::forward<F>(modify)(next->value);        // throws → nothing published
+        return publish(old, next.release());
+    }
+
+    std::uint64_t store(T value) {
+        std::lock_guard<std::mutex> lock(writer_);
+        const Snapshot* old = current_.load(std::memory_order_relaxed);
+        return publish(old, new Snapshot{std::move(value), old->version + 1});
+    }
+
+    std::uint64_t version() const { return read().version(); }
+
+    R& domain() const { return domain_; }
+
+private:
+    std::uint64_t publish(const Snapshot* old, Snapshot* next) {
+        current_.store(next, std::memory_order_release);
+        domain_.retire(const_cast<Snapshot*>(old));   // unreachable for new readers from here on
+        return next->version;
+    }
+
+    R& domain_;
+    std::atomic<const Snapshot*> current_;
+    std::mutex writer_;
+};
@@ -0,0 +1,206 @@
+// ======================================================
+// ReclaimRecords.h — per-thread records shared by the reclaimers
+// ======================================================
+//
+// EpochDomain.h and HazardDomain.h both keep one RECORD per
+// (thread, domain): what the thread is reading right now (an epoch,
+// or hazard pointers) and what it has retired but not yet freed.
+// This header is the machinery they share:
+//
+// - RecordList<Record>: a lock-free list of cache-line records;
+//   mine() finds the calling thread's record (thread_local cache),
+//   claiming an exited thread's record or linking a new one
+// - when a thread exits, its record is released: the retired list
+//   moves to the domain's ORPHANS (freed by whoever collects next)
+//   and Record::reset() clears what it was reading
+// - domains are tracked by id in a registry, so an exiting thread
+//   only touches domains that still exist
+// - heavyFence() / lightFence(): the asymmetric fence pair — the
+//   rare side (scanning records) pays membarrier(), the hot side
+//   (publishing a read) only a compiler fence
+//
+// A Record type provides:
+//     std::atomic<bool> inUse{true};
+//     Record* next = nullptr;
+//     std::vector<reclaim_detail::Retired> retired;
+//     void reset();
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace reclaim_detail {
+
+struct Retired {
+    void* object;
+    void (*destroy)(void*);
+    std::uint64_t epoch;                             // EpochDomain only
+};
+
+// Process-wide: the kernel remembers the registration per process
+inline bool asymmetricFences() {
+    static const bool available = [] {
+#if defined(__linux__) && defined(SYS_membarrier)
+        return syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+#else
+        return false;
+#endif
+    }();
+    return available;
+}
+
+// Full barrier on every core running a thread of this process
+inline void heavyFence() {
+#if defined(__linux__) && defined(SYS_membarrier)
+    if (asymmetricFences()) {
+        syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+        return;
+    }
+#endif
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+// Reader half of the pair: free when the writer uses membarrier
+inline void lightFence() {
+    if (asymmetricFences())
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    else
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+// Domains alive right now, by id
+inline std::mutex& registryMutex() {
+    static std::mutex m;
+    return m;
+}
+
+inline std::unordered_set<std::uint64_t>& liveDomains() {
+    static std::unordered_set<std::uint64_t> ids;
+    return ids;
+}
+
+template <typename Record>
+class RecordList {
+public:
+    RecordList() : id_(nextId()) {
+        asymmetricFences();
+        std::lock_guard<std::mutex> lock(registryMutex());
+        liveDomains().insert(id_);
+    }
+    RecordList(const RecordList&) = delete;
+    RecordList& operator=(const RecordList&) = delete;
+
+    // Frees everything still retired: no thread may use the domain
+    ~RecordList() {
+        {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            liveDomains().erase(id_);
+        }
+        for (Record* r = head_.load(); r;) {
+            for (const Retired& x : r->retired) x.destroy(x.object);
+            Record* next = r->next;
+            delete r;
+            r = next;
+        }
+        for (const Retired& x : orphans_) x.destroy(x.object);
+    }
+
+    Record* head() const { return head_.load(std::memory_order_acquire); }
+
+    // The calling thread's record. Keyed by id, not address: a new
+    // domain may reuse a dead one's
+    Record* mine() {
+        thread_local Exit exit;
+        thread_local std::uint64_t lastId = 0;
+        thread_local Record* lastRecord = nullptr;
+        if (lastId == id_) return lastRecord;
+        auto it = std::find_if(exit.entries.begin(), exit.entries.end(), [this](const Entry& e) { return e.id == id_; });
+        Record* r = it != exit.entries.end() ? it->record : nullptr;
+        if (!r) {
+            r = claim();
+            exit.entries.push_back({id_, this, r});
+        }
+        lastId = id_;
+        lastRecord = r;
+        return r;
+    }
+
+    // f(orphans) if no other thread is at them right now
+    template <typename F>
+    void withOrphans(F&& f) {
+        std::unique_lock<std::mutex> lock(orphanMutex_, std::try_to_lock);
+        if (lock.owns_lock()) f(orphans_);
+    }
+
+    std::size_t recordCount() const {
+        std::size_t n = 0;
+        for (Record* r = head(); r; r = r->next) ++n;
+        return n;
+    }
+
+private:
+    struct Entry {
+        std::uint64_t id;
+        RecordList* list;
+        Record* record;
+    };
+
+    // Releases the thread's records when it exits
+    struct Exit {
+        std::vector<Entry> entries;
+        ~Exit() {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            for (const Entry& e : entries)
+                if (liveDomains().count(e.id)) e.list->release(e.record);
+        }
+    };
+
+    static std::uint64_t nextId() {
+        static std::atomic<std::uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Reuse an exited thread's record, or link a new one
+    Record* claim() {
+        for (Record* r = head(); r; r = r->next) {
+            bool expected = false;
+            if (!r->inUse.load(std::memory_order_relaxed) &&
+                r->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                return r;
+        }
+        Record* r = new Record;
+        r->next = head_.load(std::memory_order_relaxed);
+        while (!head_.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        return r;
+    }
+
+    void release(Record* r) {
+        if (!r->retired.empty()) {
+            std::lock_guard<std::mutex> lock(orphanMutex_);
+            orphans_.insert(orphans_.end(), r->retired.begin(), r->retired.end());
+            r->retired.clear();
+        }
+        r->reset();
+        r->inUse.store(false, std::memory_order_release);
+    }
+
+    const std::uint64_t id_;
+    std::atomic<Record*> head_{nullptr};
+    std::mutex orphanMutex_;
+    std::vector<Retired> orphans_;
+};
+
+}  // namespace reclaim_detail
@@ -0,0 +1,63 @@
+// ======================================================
+// Reclaimer.h — one policy for safe memory reclamation
+// ======================================================
+//
+// Lock-free structures unlink an object with one atomic store —
+// and then cannot `delete` it, because another thread may have
+// loaded the pointer just before. `delete` and unique_ptr assume
+// one owner; here nobody knows who still holds it.
+//
+// A Reclaimer answers "when is it safe?". Two modes, one shape:
+//
+//                     EpochDomain.h          HazardDomain.h
+//   protects          a time span (pin)      single objects
+//   read cost         pin: 1 store, per      1 store + re-check per
+//                     guard                  protected pointer
+//   stalled reader    garbage UNBOUNDED      garbage BOUNDED
+//                     (no epoch advances)    (≤ threshold / thread)
+//   free latency      2 epoch advances       next scan
+//
+// Both: a per-thread retire list, freed in batches; exited
+// threads' lists become orphans freed by the next collect();
+// readers publish with a compiler fence only, the collecting
+// thread pays membarrier (ReclaimRecords.h).
+//
+// Code written against the concept runs with either:
+//
+//     template <Reclaimer R>
+//     T* Stack<R>::top(typename R::Guard& g) { return g.protect(head_); }
+//
+//     auto g = reclaimer.pin();        // R::Guard, movable
+//     T* p = g.protect(src);           // valid while g lives
+//     reclaimer.retire(old);           // after old is unlinked
+//     reclaimer.collect();             // free what is safe now
+//     reclaimer.synchronize();         // wait until the caller's garbage is gone
+//     reclaimer.pending();             // retired, not yet freed
+//
+// RcuCell.h takes the reclaimer as a template parameter.
+//
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include "EpochDomain.h"
+#include "HazardDomain.h"
+
+template <typename R>
+concept Reclaimer = requires(R& r, int* p, const std::atomic<int*>& src) {
+    typename R::Guard;
+    { r.pin() } -> std::same_as<typename R::Guard>;
+    { std::declval<typename R::Guard&>().protect(src) } -> std::same_as<int*>;
+    r.retire(p);
+    r.collect();
+    r.synchronize();
+    { r.pending() } -> std::convertible_to<std::size_t>;
+    { R::global() } -> std::same_as<R&>;
+};
+
+using EpochReclaimer = EpochDomain;
+using HazardReclaimer = HazardDomain;
+
+static_assert(Reclaimer<EpochReclaimer> && Reclaimer<HazardReclaimer>);
@@ -0,0 +1,177 @@
+// ======================================================
+// ReduceCounter.h — one counter API, concurrency chosen per use site
+// ======================================================
+//
+// staticVarSafe.cpp:
+//
+//     static int s = 0;
+//     void fun() { int count = 100000; while (count--) ++s; }   // ❌ race
+//
+// Counter<Policy> keeps the call site the same for every fix,
+// so each use site picks the policy that suits it:
+//
+//     Counter<ThreadLocalReduce> s;
+//     void fun() {
+//         auto h = s.handle();          // one per thread
+//         int count = 100000;
+//         while (count--) h.add(1);
+//     }                                 // h flushes here
+//     ... join ...
+//     s.value();                        // 200000
+//
+// POLICIES:
+//   AtomicAdd          one std::atomic, fetch_add per add
+//   MutexAdd           one mutex, lock per add
+//   Sharded            ShardedCounter.h: per-thread padded
+//                      leaves, summed on read (readable while
+//                      threads run)
+//   ThreadLocalReduce  each handle accumulates in a plain local;
+//                      at flush it stores its total in its OWN
+//                      slot; value() adds the slots in slot
+//                      order. With handle(threadIndex) that order
+//                      is fixed → bit-identical results run to
+//                      run (matters for floating point T)
+//
+// ThreadLocalReduce trades liveness for speed: value() only
+// sees handles that already flushed (destroyed or flush()ed),
+// so read it after join.
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <type_traits>
+#include "ShardedCounter.h"
+
+struct AtomicAdd {};
+struct MutexAdd {};
+struct Sharded {};
+struct ThreadLocalReduce {};
+
+template <typename Policy, typename T = long long>
+class Counter;
+
+// ---- AtomicAdd ----
+template <typename T>
+class Counter<AtomicAdd, T> {
+public:
+    class Handle {
+    public:
+        explicit Handle(Counter& c) : c_(c) {}
+        void add(T v) { c_.total_.fetch_add(v, std::memory_order_relaxed); }
+        void flush() {}
+
+    private:
+        Counter& c_;
+    };
+
+    Handle handle() { return Handle(*this); }
+    T value() const { return total_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<T> total_{0};
+};
+
+// ---- MutexAdd ----
+template <typename T>
+class Counter<MutexAdd, T> {
+public:
+    class Handle {
+    public:
+        explicit Handle(Counter& c) : c_(c) {}
+        void add(T v) {
+            std::lock_guard<std::mutex> lock(c_.m_);
+            c_.total_ += v;
+        }
+        void flush() {}
+
+    private:
+        Counter& c_;
+    };
+
+    Handle handle() { return Handle(*this); }
+    T value() {
+        std::lock_guard<std::mutex> lock(m_);
+        return total_;
+    }
+
+private:
+    std::mutex m_;
+    T total_ = 0;
+};
+
+// ---- Sharded (integers only: ShardedCounter holds long long) ----
+template <typename T>
+class Counter<Sharded, T> {
+    static_assert(std::is_integral_v<T>, "Sharded policy counts integers");
+
+public:
+    class Handle {
+    public:
+        explicit Handle(Counter& c) : c_(c) {}
+        void add(T v) { c_.shards_.add(static_cast<long long>(v)); }
+        void flush() {}
+
+    private:
+        Counter& c_;
+    };
+
+    Handle handle() { return Handle(*this); }
+    T value() { return static_cast<T>(shards_.read_exact()); }
+
+private:
+    ShardedCounter shards_;
+};
+
+// ---- ThreadLocalReduce ----
+template <typename T>
+class Counter<ThreadLocalReduce, T> {
+public:
+    class Handle {
+    public:
+        explicit Handle(std::atomic<T>* slot) : slot_(slot) {}
+        Handle(Handle&& o) noexcept : slot_(o.slot_), local_(o.local_) { o.slot_ = nullptr; }
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+        ~Handle() { flush(); }
+
+        void add(T v) { local_ += v; }          // plain register/stack add
+
+        // Publish the running total into this handle's slot
+        void flush() {
+            if (slot_) slot_->store(local_, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<T>* slot_;
+        T local_ = 0;
+    };
+
+    // Next free slot (slot order = order in which handles were made)
+    Handle handle() {
+        std::lock_guard<std::mutex> lock(m_);
+        return Handle(&slots_.emplace_back(0));      // deque: addresses stay valid
+    }
+
+    // Fixed slot, e.g. the thread's index: the reduction order then
+    // does not depend on thread scheduling at all. One handle per index.
+    Handle handle(std::size_t index) {
+        std::lock_guard<std::mutex> lock(m_);
+        while (slots_.size() <= index) slots_.emplace_back(0);
+        return Handle(&slots_[index]);
+    }
+
+    // Adds the slots in index order → the same order every call
+    T value() {
+        std::lock_guard<std::mutex> lock(m_);
+        T sum = 0;
+        for (const auto& s : slots_) sum += s.load(std::memory_order_acquire);
+        return sum;
+    }
+
+private:
+    std::mutex m_;
+    std::deque<std::atomic<T>> slots_;
+};
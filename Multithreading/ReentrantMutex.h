@@ -0,0 +1,296 @@
+// ======================================================
+// ReentrantMutex.h — recursive mutex with plain-mutex cost and a depth report
+// ======================================================
+//
+// recursive_mutex.cpp:
+//
+//     std::recursive_mutex m1;
+//     for (int i = 0; i < 5; i++) m1.lock();      // same thread, 5 times
+//
+// std::recursive_mutex keeps the owner id and the count INSIDE
+// the mutex, so every lock() reads and writes the shared line.
+//
+// ReentrantMutex splits the two cases:
+//   - FIRST acquire: one CAS on the lock word, exactly like a
+//     plain futex mutex (0 free, 1 locked, 2 locked + sleepers)
+//   - REENTRY: the calling thread finds the mutex in its OWN
+//     thread_local list of held mutexes (a fixed array) and bumps the depth
+//     there — the mutex's cache line is not touched at all
+//   - unlock() decrements the thread-local depth; only the
+//     last unlock releases the lock word
+//
+// "Do I own it?" never asks the mutex, so there is no owner
+// field to race on. The held list has one entry per distinct
+// ReentrantMutex the thread currently holds (at most kMaxHeld).
+//
+// DEPTH REPORT (built unless NDEBUG; force with
+// -DREENTRANT_MUTEX_DEPTH=0/1): lock() records its call site.
+// At exit, stderr gets one line per site:
+//     acquires, how many were reentries, the deepest nesting
+//     reached while the outermost lock from that site was held
+// A site whose outermost holds never nest is a candidate for a
+// plain std::mutex. Tracking costs a map lookup under a global
+// lock per call: a debug tool. As with ProfiledMutex, std::lock_guard
+// reports ITS line; use ReentrantMutex::Guard for per-line data.
+//
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#ifndef REENTRANT_MUTEX_DEPTH
+#ifdef NDEBUG
+#define REENTRANT_MUTEX_DEPTH 0
+#else
+#define REENTRANT_MUTEX_DEPTH 1
+#endif
+#endif
+
+#if REENTRANT_MUTEX_DEPTH
+#include <map>
+#include <memory>
+#include <mutex>
+#include <source_location>
+#include <utility>
+#endif
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace reentrant_detail {
+
+#if REENTRANT_MUTEX_DEPTH
+
+struct Site {
+    const char* file;
+    unsigned line;
+    std::atomic<std::uint64_t> acquires{0};
+    std::atomic<std::uint64_t> reentries{0};
+    std::atomic<std::uint64_t> outermost{0};           // acquires that took the lock word
+    std::atomic<std::uint64_t> nestedHolds{0};         // ... of which saw a nested lock
+    std::atomic<unsigned> maxDepth{0};
+};
+
+// Owns every Site; prints at exit
+class DepthRegistry {
+public:
+    static DepthRegistry& instance() {
+        static DepthRegistry r;
+        return r;
+    }
+
+    Site* site(const std::source_location& loc) {
+        std::lock_guard<std::mutex> lg(m_);
+        auto& s = sites_[{loc.file_name(), loc.line()}];
+        if (!s) {
+            s = std::make_unique<Site>();
+            s->file = loc.file_name();
+            s->line = loc.line();
+        }
+        return s.get();
+    }
+
+    void report(std::FILE* out) {
+        std::lock_guard<std::mutex> lg(m_);
+        std::fprintf(out, "\n===== ReentrantMutex depth report =====\n");
+        for (auto& [key, s] : sites_) {
+            const char* base = std::strrchr(s->file, '/');
+            base = base ? base + 1 : s->file;
+            std::uint64_t outer = s->outermost.load(), nested = s->nestedHolds.load();
+            std::fprintf(out, "%s:%u: %llu acquires (%llu outermost, %llu reentries)", base, s->line,
+                         (unsigned long long)s->acquires.load(), (unsigned long long)outer,
+                         (unsigned long long)s->reentries.load());
+            if (outer) {
+                unsigned depth = s->maxDepth.load();
+                std::fprintf(out, ", max depth %u", depth > 1 ? depth : 1u);
+                if (nested == 0) std::fprintf(out, "  → never nests: std::mutex would do");
+            }
+            std::fprintf(out, "\n");
+        }
+    }
+
+    ~DepthRegistry() {
+        if (!sites_.empty()) report(stderr);
+    }
+
+private:
+    std::mutex m_;
+    std::map<std::pair<const char*, unsigned>, std::unique_ptr<Site>> sites_;
+};
+
+#endif
+
+struct Held {
+    const void* mutex;
+    unsigned depth;
+#if REENTRANT_MUTEX_DEPTH
+    unsigned maxDepth;
+    Site* outerSite;
+#endif
+};
+
+// Distinct ReentrantMutexes one thread may hold at once (lockdep
+// uses a similar fixed bound); exceeding it aborts
+constexpr int kMaxHeld = 32;
+
+// Trivial type + constinit: no TLS init guard on access
+struct HeldList {
+    Held items[kMaxHeld];
+    int n;
+
+    // Most threads hold zero or one: search from the back
+    Held* find(const void* m) {
+        for (int i = n - 1; i >= 0; --i)
+            if (items[i].mutex == m) return &items[i];
+        return nullptr;
+    }
+
+    void push(const Held& h) {
+        if (n == kMaxHeld) [[unlikely]] {
+            std::fprintf(stderr, "ReentrantMutex: more than %d distinct mutexes held by one thread\n", kMaxHeld);
+            std::abort();
+        }
+        items[n++] = h;
+    }
+
+    // Usually the newest entry: then nothing is copied
+    void erase(Held* h) {
+        if (h != &items[--n]) *h = items[n];            // order does not matter
+    }
+};
+
+inline thread_local constinit HeldList held{};
+
+}  // namespace reentrant_detail
+
+class ReentrantMutex {
+public:
+    ReentrantMutex() = default;
+    ReentrantMutex(const ReentrantMutex&) = delete;
+    ReentrantMutex& operator=(const ReentrantMutex&) = delete;
+
+#if REENTRANT_MUTEX_DEPTH
+    void lock(std::source_location loc = std::source_location::current()) {
+        reentrant_detail::Site* site = reentrant_detail::DepthRegistry::instance().site(loc);
+        site->acquires.fetch_add(1, std::memory_order_relaxed);
+        if (reentrant_detail::Held* h = reentrant_detail::held.find(this)) {
+            reenter(*h, site);
+            return;
+        }
+        acquireWord();
+        site->outermost.fetch_add(1, std::memory_order_relaxed);
+        reentrant_detail::held.push({this, 1, 1, site});
+    }
+
+    bool try_lock(std::source_location loc = std::source_location::current()) {
+        reentrant_detail::Site* site = reentrant_detail::DepthRegistry::instance().site(loc);
+        if (reentrant_detail::Held* h = reentrant_detail::held.find(this)) {
+            site->acquires.fetch_add(1, std::memory_order_relaxed);
+            reenter(*h, site);
+            return true;
+        }
+        if (!tryWord()) return false;
+        site->acquires.fetch_add(1, std::memory_order_relaxed);
+        site->outermost.fetch_add(1, std::memory_order_relaxed);
+        reentrant_detail::held.push({this, 1, 1, site});
+        return true;
+    }
+#else
+    void lock() {
+        if (reentrant_detail::Held* h = reentrant_detail::held.find(this)) {
+            ++h->depth;                                 // thread-local only
+            return;
+        }
+        acquireWord();
+        reentrant_detail::held.push({this, 1});
+    }
+
+    bool try_lock() {
+        if (reentrant_detail::Held* h = reentrant_detail::held.find(this)) {
+            ++h->depth;
+            return true;
+        }
+        if (!tryWord()) return false;
+        reentrant_detail::held.push({this, 1});
+        return true;
+    }
+#endif
+
+    // Precondition (as for std::recursive_mutex): held by this thread
+    void unlock() {
+        reentrant_detail::Held* h = reentrant_detail::held.find(this);
+        if (--h->depth != 0) return;
+#if REENTRANT_MUTEX_DEPTH
+        if (h->maxDepth > 1) h->outerSite->nestedHolds.fetch_add(1, std::memory_order_relaxed);
+#endif
+        reentrant_detail::held.erase(h);
+        if (state_.exchange(0, std::memory_order_release) == 2) wake();
+    }
+
+    // lock_guard equivalent that records the line it is created on
+    class Guard {
+    public:
+#if REENTRANT_MUTEX_DEPTH
+        explicit Guard(ReentrantMutex& m, std::source_location loc = std::source_location::current())
+            : m_(m) {
+            m_.lock(loc);
+        }
+#else
+        explicit Guard(ReentrantMutex& m) : m_(m) { m_.lock(); }
+#endif
+        ~Guard() { m_.unlock(); }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        ReentrantMutex& m_;
+    };
+
+private:
+#if REENTRANT_MUTEX_DEPTH
+    static void reenter(reentrant_detail::Held& h, reentrant_detail::Site* site) {
+        ++h.depth;
+        if (h.depth > h.maxDepth) h.maxDepth = h.depth;
+        site->reentries.fetch_add(1, std::memory_order_relaxed);
+        reentrant_detail::Site* outer = h.outerSite;
+        unsigned prev = outer->maxDepth.load(std::memory_order_relaxed);
+        while (h.depth > prev &&
+               !outer->maxDepth.compare_exchange_weak(prev, h.depth, std::memory_order_relaxed)) {
+        }
+    }
+#endif
+
+    bool tryWord() {
+        std::uint32_t expected = 0;
+        return state_.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void acquireWord() {
+        if (tryWord()) [[likely]] return;
+        // Classic futex mutex slow path: mark "sleepers", sleep while 2
+        while (state_.exchange(2, std::memory_order_acquire) != 0) park();
+    }
+
+    void park() {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_), FUTEX_WAIT_PRIVATE, 2, nullptr, nullptr, 0);
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    void wake() {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+    }
+
+    std::atomic<std::uint32_t> state_{0};
+};
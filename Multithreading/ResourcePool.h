@@ -0,0 +1,303 @@
+// ======================================================
+// ResourcePool.h — N pooled objects behind a counting semaphore, batch-friendly
+// ======================================================
+//
+// BinarySemaphore.cpp signals once with std::binary_semaphore.
+// Gating N pooled objects (DB connections, buffers) is the
+// counting version of the same idea, but std::counting_semaphore
+// stops short of what a hot pool needs:
+//   - acquire() takes ONE permit per atomic operation, so taking
+//     8 connections is 8 RMWs — and two threads each taking 8 of
+//     10 can deadlock holding 5 each
+//   - no pooled objects, only a count
+//   - no metrics
+//
+// ResourcePool<T> keeps the semaphore's permit counter (an
+// atomic int, the same state std::counting_semaphore has) and
+// adds the missing pieces:
+//   - acquire_n(n): ONE CAS takes all n permits or none
+//     (all-or-nothing, so batch takers cannot deadlock)
+//   - release: ONE fetch_add returns the whole batch
+//   - the objects themselves: a free list popped/pushed once
+//     per batch under a short lock
+//   - timed acquire (deadline / timeout) → std::optional
+//   - stats(): in use, peak, waits, timeouts, wait time,
+//     utilization (object-time busy / object-time available;
+//     costs one clock read when a lease starts and one at its end)
+//
+// Uncontended acquire/release never sleeps or notifies; blocked
+// acquirers wait on a condition variable that releasers only
+// touch when someone is actually waiting.
+//
+// A large batch waits for n permits to be free AT ONCE; a stream
+// of single acquires can keep it waiting (no fairness queue).
+//
+// Usage:
+//     ResourcePool<Connection> pool(makeConnections(16));
+//     {
+//         auto c = pool.acquire();                 // Lease
+//         c->query("...");
+//     }                                            // returned
+//     auto batch = pool.acquire_n(4);              // 4 at once
+//     if (auto c = pool.try_acquire_for(5ms)) ...  // or give up
+//
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct PoolStats {
+    std::size_t capacity = 0;
+    std::size_t inUse = 0;
+    std::size_t peakInUse = 0;
+    std::uint64_t acquires = 0;        // objects handed out
+    std::uint64_t waits = 0;           // acquire calls that had to block
+    std::uint64_t timeouts = 0;        // timed acquires that gave up
+    std::chrono::nanoseconds waitTime{0};
+    double utilization = 0;            // 0..1 since construction
+};
+
+template <typename T>
+class ResourcePool {
+public:
+    using clock = std::chrono::steady_clock;
+
+    // One borrowed object; returns it on destruction
+    class Lease {
+    public:
+        Lease(Lease&& o) noexcept
+            : pool_(std::exchange(o.pool_, nullptr)), index_(o.index_), since_(o.since_) {}
+        Lease& operator=(Lease&&) = delete;
+        ~Lease() { release(); }
+
+        T& operator*() const { return pool_->objects_[index_]; }
+        T* operator->() const { return &pool_->objects_[index_]; }
+
+        void release() {
+            if (pool_) std::exchange(pool_, nullptr)->giveBack(&index_, 1, since_);
+        }
+
+    private:
+        friend class ResourcePool;
+        Lease(ResourcePool* p, std::size_t i, clock::time_point t) : pool_(p), index_(i), since_(t) {}
+        ResourcePool* pool_;
+        std::size_t index_;
+        clock::time_point since_;
+    };
+
+    // n borrowed objects; returned together (one atomic op)
+    class Batch {
+    public:
+        Batch(Batch&& o) noexcept
+            : pool_(std::exchange(o.pool_, nullptr)), indices_(std::move(o.indices_)), since_(o.since_) {}
+        Batch& operator=(Batch&&) = delete;
+        ~Batch() { release(); }
+
+        std::size_t size() const { return indices_.size(); }
+        T& operator[](std::size_t i) const { return pool_->objects_[indices_[i]]; }
+
+        template <typename F>
+        void forEach(F&& f) const {
+            for (std::size_t i : indices_) f(pool_->objects_[i]);
+        }
+
+        void release() {
+            if (pool_) std::exchange(pool_, nullptr)->giveBack(indices_.data(), indices_.size(), since_);
+        }
+
+    private:
+        friend class ResourcePool;
+        Batch(ResourcePool* p, std::vector<std::size_t> idx, clock::time_point t)
+            : pool_(p), indices_(std::move(idx)), since_(t) {}
+        ResourcePool* pool_;
+        std::vector<std::size_t> indices_;
+        clock::time_point since_;
+    };
+
+    explicit ResourcePool(std::vector<T> objects)
+        : objects_(std::move(objects)), permits_(static_cast<int>(objects_.size())), created_(clock::now()) {
+        free_.reserve(objects_.size());
+        for (std::size_t i = objects_.size(); i-- > 0;) free_.push_back(i);
+    }
+
+    ResourcePool(const ResourcePool&) = delete;
+    ResourcePool& operator=(const ResourcePool&) = delete;
+
+    std::size_t capacity() const { return objects_.size(); }
+
+    Lease acquire() {
+        waitFor(1, clock::time_point::max());
+        std::size_t i;
+        take(&i, 1);
+        return Lease(this, i, clock::now());
+    }
+
+    template <typename Clock, typename Duration>
+    std::optional<Lease> try_acquire_until(const std::chrono::time_point<Clock, Duration>& deadline) {
+        if (!waitFor(1, toSteady(deadline))) return std::nullopt;
+        std::size_t i;
+        take(&i, 1);
+        return Lease(this, i, clock::now());
+    }
+
+    template <typename Rep, typename Period>
+    std::optional<Lease> try_acquire_for(const std::chrono::duration<Rep, Period>& timeout) {
+        return try_acquire_until(clock::now() + timeout);
+    }
+
+    // All n objects or none; n must not exceed capacity()
+    Batch acquire_n(std::size_t n) {
+        checkBatch(n);
+        waitFor(static_cast<int>(n), clock::time_point::max());
+        return makeBatch(n);
+    }
+
+    template <typename Clock, typename Duration>
+    std::optional<Batch> try_acquire_n_until(std::size_t n,
+                                             const std::chrono::time_point<Clock, Duration>& deadline) {
+        checkBatch(n);
+        if (!waitFor(static_cast<int>(n), toSteady(deadline))) return std::nullopt;
+        return makeBatch(n);
+    }
+
+    template <typename Rep, typename Period>
+    std::optional<Batch> try_acquire_n_for(std::size_t n, const std::chrono::duration<Rep, Period>& timeout) {
+        return try_acquire_n_until(n, clock::now() + timeout);
+    }
+
+    PoolStats stats() const {
+        PoolStats s;
+        s.capacity = objects_.size();
+        int avail = permits_.load(std::memory_order_relaxed);
+        s.inUse = objects_.size() - static_cast<std::size_t>(avail < 0 ? 0 : avail);
+        s.peakInUse = static_cast<std::size_t>(metrics_.peak.load(std::memory_order_relaxed));
+        s.acquires = metrics_.acquires.load(std::memory_order_relaxed);
+        s.waits = metrics_.waits.load(std::memory_order_relaxed);
+        s.timeouts = metrics_.timeouts.load(std::memory_order_relaxed);
+        s.waitTime = std::chrono::nanoseconds(metrics_.waitNs.load(std::memory_order_relaxed));
+        double elapsed = std::chrono::duration<double, std::nano>(clock::now() - created_).count();
+        double busy = static_cast<double>(metrics_.busyNs.load(std::memory_order_relaxed));
+        if (elapsed > 0 && !objects_.empty())
+            s.utilization = busy / (elapsed * static_cast<double>(objects_.size()));
+        return s;
+    }
+
+private:
+    template <typename Clock, typename Duration>
+    static clock::time_point toSteady(const std::chrono::time_point<Clock, Duration>& t) {
+        if constexpr (std::is_same_v<Clock, clock>) return std::chrono::time_point_cast<clock::duration>(t);
+        else return clock::now() + std::chrono::duration_cast<clock::duration>(t - Clock::now());
+    }
+
+    void checkBatch(std::size_t n) const {
+        if (n == 0 || n > objects_.size()) throw std::invalid_argument("ResourcePool: batch size out of range");
+    }
+
+    // One CAS takes n permits, or fails without taking any
+    bool tryPermits(int n) {
+        int avail = permits_.load(std::memory_order_relaxed);
+        while (avail >= n) {
+            if (permits_.compare_exchange_weak(avail, avail - n, std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+                notePeak(static_cast<int>(objects_.size()) - (avail - n));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool waitFor(int n, clock::time_point deadline) {
+        if (tryPermits(n)) [[likely]]
+            return true;
+        metrics_.waits.fetch_add(1, std::memory_order_relaxed);
+        auto t0 = clock::now();
+        std::unique_lock<std::mutex> lk(waitLock_);
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        bool ok = true;
+        while (!tryPermits(n)) {
+            if (deadline == clock::time_point::max()) {
+                cv_.wait(lk);
+            } else if (cv_.wait_until(lk, deadline) == std::cv_status::timeout) {
+                ok = tryPermits(n);
+                break;
+            }
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        lk.unlock();
+        metrics_.waitNs.fetch_add(static_cast<std::uint64_t>((clock::now() - t0).count()),
+                                  std::memory_order_relaxed);
+        if (!ok) metrics_.timeouts.fetch_add(1, std::memory_order_relaxed);
+        return ok;
+    }
+
+    void notePeak(int inUse) {
+        int prev = metrics_.peak.load(std::memory_order_relaxed);
+        while (inUse > prev && !metrics_.peak.compare_exchange_weak(prev, inUse, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Permits are already held: there are at least n free objects
+    void take(std::size_t* out, std::size_t n) {
+        {
+            std::lock_guard<std::mutex> lg(freeLock_);
+            for (std::size_t k = 0; k < n; ++k) {
+                out[k] = free_.back();
+                free_.pop_back();
+            }
+        }
+        metrics_.acquires.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    Batch makeBatch(std::size_t n) {
+        std::vector<std::size_t> idx(n);
+        take(idx.data(), n);
+        return Batch(this, std::move(idx), clock::now());
+    }
+
+    void giveBack(const std::size_t* idx, std::size_t n, clock::time_point since) {
+        metrics_.busyNs.fetch_add(static_cast<std::uint64_t>((clock::now() - since).count()) * n,
+                                  std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lg(freeLock_);
+            for (std::size_t k = 0; k < n; ++k) free_.push_back(idx[k]);
+        }
+        // One RMW for the whole batch; then wake sleepers only if any
+        permits_.fetch_add(static_cast<int>(n), std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lg(waitLock_);      // a waiter is in its check or in wait()
+            cv_.notify_all();
+        }
+    }
+
+    std::vector<T> objects_;
+
+    alignas(64) std::atomic<int> permits_;
+    std::atomic<int> waiters_{0};
+
+    alignas(64) std::mutex freeLock_;
+    std::vector<std::size_t> free_;
+
+    std::mutex waitLock_;
+    std::condition_variable cv_;
+
+    // Metrics live on their own lines, away from the permit counter
+    struct alignas(64) Metrics {
+        std::atomic<int> peak{0};
+        std::atomic<std::uint64_t> acquires{0};
+        std::atomic<std::uint64_t> waits{0};
+        std::atomic<std::uint64_t> timeouts{0};
+        std::atomic<std::uint64_t> waitNs{0};
+        std::atomic<std::uint64_t> busyNs{0};
+    } metrics_;
+
+    clock::time_point created_;
+};
@@ -0,0 +1,126 @@
+// ======================================================
+// SeqLock.h — lock-free readers, versioned snapshots
+// ======================================================
+//
+// consumeXY (std::try_lock.cpp) locks m1 AND m2 just to READ
+// X and Y as a consistent pair. Every read blocks the writers
+// and every reader blocks every other reader.
+//
+// SEQLOCK:
+//   a version counter + the data
+//
+//   writer:  version++  (odd  = "write in progress")
+//            write the data
+//            version++  (even = "stable")
+//
+//   reader:  v1 = version          (retry while odd)
+//            copy the data
+//            v2 = version
+//            v1 == v2 ? → the copy is a consistent snapshot
+//                       : → a writer interfered, retry
+//
+// - readers NEVER write shared memory → no cache-line
+//   ping-pong between readers, reads scale with cores
+// - writers never wait for readers (they may starve readers
+//   only if they write continuously)
+// - writers are serialised among themselves by a small
+//   spin lock on the version's low bit (odd = owned)
+//
+// DATA RACES:
+// The payload is stored as std::atomic<uint64_t> words that
+// are read and written with relaxed ordering, so a reader
+// racing with a writer is well-defined C++ (it just sees
+// words from both versions and retries). Fences order the
+// words against the version counter.
+//
+// T must be trivially copyable.
+//
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock<T> needs a trivially copyable T");
+    static constexpr std::size_t kWords = (sizeof(T) + 7) / 8;
+
+public:
+    SeqLock() : SeqLock(T{}) {}
+    explicit SeqLock(const T& initial) { writeWords(initial); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // Consistent snapshot; never blocks a writer
+    T load() const {
+        unsigned retries;
+        return load(retries);
+    }
+
+    // Same, and reports how many times it had to retry
+    T load(unsigned& retries) const {
+        retries = 0;
+        for (;;) {
+            std::uint64_t v1 = version_.load(std::memory_order_acquire);
+            if ((v1 & 1) == 0) {
+                T out = readWords();
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (version_.load(std::memory_order_relaxed) == v1) return out;
+            }
+            ++retries;
+            if ((retries & 63) == 0) std::this_thread::yield();   // writer preempted
+        }
+    }
+
+    void store(const T& value) {
+        update([&](T& cur) { cur = value; });
+    }
+
+    // Read-modify-write under the writer lock: f(T&)
+    template <typename F>
+    void update(F&& f) {
+        std::uint64_t v = acquireWriter();        // version is now odd
+        std::atomic_thread_fence(std::memory_order_release);
+        T cur = readWords();
+        f(cur);
+        writeWords(cur);
+        version_.store(v + 2, std::memory_order_release);         // even again
+    }
+
+    // Number of completed writes (version / 2)
+    std::uint64_t writes() const { return version_.load(std::memory_order_relaxed) / 2; }
+
+private:
+    // CAS the version from even v to v + 1
+    std::uint64_t acquireWriter() {
+        for (unsigned spins = 0;; ++spins) {
+            std::uint64_t v = version_.load(std::memory_order_relaxed);
+            if ((v & 1) == 0 &&
+                version_.compare_exchange_weak(v, v + 1, std::memory_order_acquire,
+                                               std::memory_order_relaxed))
+                return v;
+            if ((spins & 63) == 63) std::this_thread::yield();
+        }
+    }
+
+    T readWords() const {
+        std::uint64_t buf[kWords];
+        for (std::size_t i = 0; i < kWords; ++i) buf[i] = words_[i].load(std::memory_order_relaxed);
+        T out;
+        std::memcpy(&out, buf, sizeof(T));
+        return out;
+    }
+
+    void writeWords(const T& value) {
+        std::uint64_t buf[kWords] = {};
+        std::memcpy(buf, &value, sizeof(T));
+        for (std::size_t i = 0; i < kWords; ++i) words_[i].store(buf[i], std::memory_order_relaxed);
+    }
+
+    alignas(64) std::atomic<std::uint64_t> version_{0};
+    std::atomic<std::uint64_t> words_[kWords];
+};
@@ -0,0 +1,100 @@
+// ======================================================
+// ShardedCounter.h — Cache-line-padded striped accumulator
+// ======================================================
+//
+// WHY:
+// bankBalance / myAmount / balance are ONE shared variable.
+// - without a lock      → race condition (lost updates)
+// - behind one mutex    → every thread queues on the lock
+// - std::atomic         → correct, but every fetch_add
+//                         bounces the SAME cache line
+//                         between all cores
+//
+// IDEA:
+// Give every thread its OWN shard (own cache line).
+// Writers never touch each other's memory; readers add
+// the shards together.
+//
+// API:
+// - add(v)         → touches only the caller's shard
+// - read_approx()  → sum of shards, no locking
+//                    (may miss adds that are in flight)
+// - read_exact()   → LINEARIZABLE: briefly locks every shard,
+//                    so the sum is a value the counter really
+//                    had at one instant
+//
+// Each shard has a tiny spin lock. The owning thread is
+// normally the only one taking it → uncontended, stays in
+// the owner's cache. Only read_exact() competes for it.
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+class ShardedCounter {
+public:
+    explicit ShardedCounter(std::size_t shards = defaultShards())
+        : shards_(shards == 0 ? 1 : shards) {}
+
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    void add(long long v) {
+        Shard& s = shards_[myShard()];
+        s.lock();
+        // Only lock holders write, so load+store is enough
+        // (read_approx may read concurrently → atomic, relaxed)
+        s.value.store(s.value.load(std::memory_order_relaxed) + v,
+                      std::memory_order_relaxed);
+        s.unlock();
+    }
+
+    long long read_approx() const {
+        long long sum = 0;
+        for (const Shard& s : shards_)
+            sum += s.value.load(std::memory_order_relaxed);
+        return sum;
+    }
+
+    long long read_exact() {
+        // Lock shards in index order (same order for every
+        // reader → readers cannot deadlock each other)
+        for (Shard& s : shards_) s.lock();
+        long long sum = 0;
+        for (Shard& s : shards_) sum += s.value.load(std::memory_order_relaxed);
+        for (Shard& s : shards_) s.unlock();
+        return sum;
+    }
+
+    std::size_t shard_count() const { return shards_.size(); }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<bool> locked{false};
+        std::atomic<long long> value{0};
+
+        void lock() {
+            while (locked.exchange(true, std::memory_order_acquire))
+                while (locked.load(std::memory_order_relaxed))
+                    std::this_thread::yield();
+        }
+        void unlock() { locked.store(false, std::memory_order_release); }
+    };
+
+    static std::size_t defaultShards() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n == 0 ? 8 : 2 * n;
+    }
+
+    // Threads get consecutive shard slots the first time they add
+    std::size_t myShard() {
+        static std::atomic<std::size_t> nextThread{0};
+        thread_local std::size_t slot = nextThread.fetch_add(1, std::memory_order_relaxed);
+        return slot % shards_.size();
+    }
+
+    std::vector<Shard> shards_;
+};
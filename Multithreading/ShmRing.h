@@ -0,0 +1,521 @@
+// ======================================================
+// ShmRing.h — zero-copy message ring between PROCESSES (shared memory + futex)
+// ======================================================
+//
+// ProducerConsumerproblemUsingThread.cpp, pucerconsumer.cpp and
+// SpscRing.h all pass items between THREADS: the buffer lives in
+// one address space. Between processes the usual answer is a pipe
+// or socket — write() copies the message into the kernel, read()
+// copies it out again, and both are system calls.
+//
+// ShmRing maps one segment (shm_open + mmap) into every process
+// that opens the same name:
+//
+//   - one LANE per producer: a byte ring with its own tail
+//     (written by that producer) and head (written by the
+//     consumer) — SPSC per lane, MPSC over the segment with no CAS
+//     on the message path
+//   - ZERO COPY: reserve(n) returns the bytes INSIDE the ring, the
+//     producer builds the message there and commit()s; the
+//     consumer's read() returns a view of the same bytes and
+//     release() gives them back. Nothing is copied by the ring
+//   - records are [u32 size][u32 kind][payload, padded to 8]: a
+//     message never wraps — at the end of the lane a padding
+//     record is written and the message starts at offset 0 — so
+//     the largest message is laneBytes / 2 - 8
+//   - batched publication as in SpscRing.h: tail / head are stored
+//     every `batchBytes` (and always before a side reports empty /
+//     full or sleeps); a producer that pauses should flush()
+//   - futex wake-ups on words in the segment (shared futexes key on
+//     the physical page, so they work across processes): the
+//     consumer sleeps on one doorbell when every lane is empty, a
+//     producer on its lane's word when its lane is full; a side
+//     enters the kernel only to wake a sleeper
+//
+// Order: FIFO per producer; no order between producers.
+//
+// CRASH SAFETY — the only shared state is head, tail and the owner
+// pids, and each is advanced by one release store after the bytes
+// it covers are final:
+//   - a producer that dies mid-message never published it: the
+//     consumer sees exactly the messages it had flushed
+//   - its lane stays readable; a new Producer takes over the lane
+//     of a dead owner (kill(pid, 0) fails) and continues from the
+//     published tail, overwriting the half-written bytes
+//   - a consumer that dies leaves the published head: a new
+//     Consumer takes over and starts there. Messages released but
+//     not yet published are delivered AGAIN — at-least-once across
+//     a consumer crash, exactly-once otherwise
+//   - a record that fails validation (size / kind) means the
+//     segment was corrupted from outside: read() throws
+//     std::runtime_error instead of walking off the lane
+// Ownership is per process (pid); a dead process's zombie counts
+// as alive until it is reaped, and a pid reused by an unrelated
+// process keeps its lane "owned" until that process exits too.
+//
+// Linux: shm_open + futex. (Win32 would use CreateFileMapping and
+// named events, as NamedMutex.h does; not provided here.)
+//
+//     ShmRing ring("frames", 4, 1 << 22);       // create or open: 4 lanes × 4 MB
+//
+//     ShmRing::Producer p(ring);                // in a producer process
+//     std::span<std::byte> b = p.reserve(n);    //   blocks while the lane is full
+//     build(b.data());
+//     p.commit(n);                              //   p.flush() before going idle
+//
+//     ShmRing::Consumer c(ring);                // in the one consumer process
+//     ShmRing::Message m = c.read();            //   blocks while every lane is empty
+//     use(m.bytes);
+//     c.release();
+//
+//     ShmRing::remove("frames");                // when nobody needs it
+//
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SHM_RING_PAUSE() _mm_pause()
+#elif defined(__aarch64__)
+#define SHM_RING_PAUSE() asm volatile("yield")
+#else
+#define SHM_RING_PAUSE() ((void)0)
+#endif
+
+namespace shm_ring_detail {
+
+constexpr std::uint32_t kData = 1;
+constexpr std::uint32_t kPad = 2;
+constexpr std::size_t kHeader = 8;
+constexpr std::size_t kPage = 4096;
+constexpr long kRecheckMs = 50;
+
+struct Record {
+    std::uint32_t size;                              // payload bytes (kData) or the whole record (kPad)
+    std::uint32_t kind;
+};
+static_assert(sizeof(Record) == kHeader);
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free && sizeof(std::atomic<std::uint32_t>) == 4,
+              "futex words must be plain lock-free 32-bit words");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "indices must be lock-free to be shared");
+
+// All-zero is a valid state for every field: a segment fresh from
+// ftruncate needs no initialisation beyond `geometry`
+struct Control {
+    std::atomic<std::uint64_t> geometry;             // lanes and lane size, set by the first opener
+    std::atomic<std::uint32_t> consumer;             // consumer pid, 0 = none
+    alignas(64) std::atomic<std::uint32_t> doorbell; // futex: bumped to wake the consumer
+    std::atomic<std::uint32_t> consumerSleeping;
+};
+
+struct Lane {
+    alignas(64) std::atomic<std::uint32_t> owner;    // producer pid, 0 = free
+    alignas(64) std::atomic<std::uint64_t> tail;     // written by the producer
+    alignas(64) std::atomic<std::uint64_t> head;     // written by the consumer
+    std::atomic<std::uint32_t> headSeq;              // futex: bumped to wake the producer
+    std::atomic<std::uint32_t> producerSleeping;
+};
+
+inline std::size_t roundUp(std::size_t n, std::size_t to) { return (n + to - 1) / to * to; }
+
+inline bool processAlive(std::uint32_t pid) {
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+}
+
+// Shared (non-PRIVATE) futex: every process mapping the page waits
+// on the same queue. Returns after a wake, a changed word or the
+// recheck timeout — callers loop on their own condition
+inline void futexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected) {
+    timespec ts{0, kRecheckMs * 1000000L};
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+inline void futexWake(std::atomic<std::uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+// Store → fence → load against the sleeper's store → load (no lost
+// wake-up); clearing the flag makes it one wake per sleep
+inline void wake(std::atomic<std::uint32_t>& word, std::atomic<std::uint32_t>& sleeping) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed) && sleeping.exchange(0, std::memory_order_relaxed)) {
+        word.fetch_add(1, std::memory_order_release);
+        futexWake(word);
+    }
+}
+
+// Spinning only helps when the other side runs on another core
+inline unsigned spinLimit() {
+    static const unsigned limit = std::thread::hardware_concurrency() > 1 ? 2000u : 0u;
+    return limit;
+}
+
+}  // namespace shm_ring_detail
+
+class ShmRing {
+public:
+    class Producer;
+    class Consumer;
+
+    struct Message {
+        std::span<const std::byte> bytes;            // inside the ring: valid until release()
+        unsigned lane = 0;
+    };
+
+    // Creates the segment or opens the existing one. laneBytes is
+    // rounded up to a power of two (at least a page). Throws
+    // std::invalid_argument if the name exists with another
+    // geometry, std::system_error if the OS refuses
+    ShmRing(const std::string& name, unsigned lanes, std::size_t laneBytes) {
+        using namespace shm_ring_detail;
+        if (lanes == 0 || lanes > 4096) throw std::invalid_argument("ShmRing: lanes must be 1..4096");
+        if (laneBytes == 0 || laneBytes > (std::size_t(1) << 40))
+            throw std::invalid_argument("ShmRing: laneBytes must be 1..2^40");
+        lanes_ = lanes;
+        laneBytes_ = kPage;
+        while (laneBytes_ < laneBytes) laneBytes_ <<= 1;
+        const std::size_t lanesAt = roundUp(sizeof(Control), kPage);
+        const std::size_t dataAt = lanesAt + roundUp(sizeof(Lane) * lanes_, kPage);
+        size_ = dataAt + laneBytes_ * lanes_;
+
+        const std::string path = posixName(name);
+        int fd = shm_open(path.c_str(), O_CREAT | O_RDWR, 0600);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), name);
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || (st.st_size != 0 && std::size_t(st.st_size) != size_)) {
+            const int err = errno;
+            const bool exists = st.st_size != 0;
+            ::close(fd);
+            if (exists) throw std::invalid_argument("ShmRing: " + name + " exists with another geometry");
+            throw std::system_error(err, std::generic_category(), name);
+        }
+        // Same size from every process: growing to it zero-fills
+        if (ftruncate(fd, off_t(size_)) != 0) {
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), name);
+        }
+        void* p = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int err = errno;
+        ::close(fd);                                 // the mapping keeps the segment alive
+        if (p == MAP_FAILED) throw std::system_error(err, std::generic_category(), name);
+        base_ = static_cast<std::byte*>(p);
+        control_ = reinterpret_cast<Control*>(base_);
+        laneHeaders_ = reinterpret_cast<Lane*>(base_ + lanesAt);
+        data_ = base_ + dataAt;
+
+        const std::uint64_t key = (std::uint64_t(lanes_) << 40) | laneBytes_;
+        std::uint64_t seen = 0;
+        if (!control_->geometry.compare_exchange_strong(seen, key, std::memory_order_acq_rel) && seen != key) {
+            munmap(base_, size_);
+            throw std::invalid_argument("ShmRing: " + name + " exists with another geometry");
+        }
+    }
+
+    ShmRing(const ShmRing&) = delete;
+    ShmRing& operator=(const ShmRing&) = delete;
+    ~ShmRing() { munmap(base_, size_); }
+
+    // Deletes the name; processes that have it mapped keep working
+    static void remove(const std::string& name) { shm_unlink(posixName(name).c_str()); }
+
+    unsigned lanes() const { return lanes_; }
+    std::size_t laneBytes() const { return laneBytes_; }
+    std::size_t maxMessage() const { return laneBytes_ / 2 - shm_ring_detail::kHeader; }
+
+    bool consumerAlive() const {
+        const std::uint32_t pid = control_->consumer.load(std::memory_order_acquire);
+        return pid != 0 && shm_ring_detail::processAlive(pid);
+    }
+
+    // Published bytes the consumer has not published back (a snapshot)
+    std::size_t backlog(unsigned lane) const {
+        const shm_ring_detail::Lane& l = laneHeaders_[lane];
+        return std::size_t(l.tail.load(std::memory_order_relaxed) - l.head.load(std::memory_order_relaxed));
+    }
+
+private:
+    using Control = shm_ring_detail::Control;
+    using Lane = shm_ring_detail::Lane;
+    using Record = shm_ring_detail::Record;
+
+    static std::string posixName(const std::string& name) { return name[0] == '/' ? name : "/" + name; }
+
+    std::byte* laneData(unsigned lane) const { return data_ + std::size_t(lane) * laneBytes_; }
+
+    // Takes a free slot, or the slot of a dead process
+    static bool claim(std::atomic<std::uint32_t>& owner, std::uint32_t self, bool& tookOver) {
+        std::uint32_t cur = owner.load(std::memory_order_acquire);
+        if (cur != 0 && (cur == self || shm_ring_detail::processAlive(cur))) return false;
+        tookOver = cur != 0;
+        return owner.compare_exchange_strong(cur, self, std::memory_order_acq_rel);
+    }
+
+    unsigned lanes_ = 0;
+    std::size_t laneBytes_ = 0;
+    std::size_t size_ = 0;
+    std::byte* base_ = nullptr;
+    Control* control_ = nullptr;
+    Lane* laneHeaders_ = nullptr;
+    std::byte* data_ = nullptr;
+};
+
+// --------------------------------------------------
+// PRODUCER: owns one lane. One per process (or per thread)
+// --------------------------------------------------
+class ShmRing::Producer {
+public:
+    // batchBytes = 0: publish every laneBytes / 16. Throws
+    // std::runtime_error if every lane has a live owner
+    explicit Producer(ShmRing& ring, std::size_t batchBytes = 0) : ring_(ring) {
+        const std::uint32_t self = std::uint32_t(getpid());
+        for (unsigned i = 0; i < ring.lanes_; ++i)
+            if (ShmRing::claim(ring.laneHeaders_[i].owner, self, tookOver_)) {
+                lane_ = i;
+                break;
+            }
+        if (lane_ == kNoLane) throw std::runtime_error("ShmRing: every lane has a live producer");
+        Lane& l = ring.laneHeaders_[lane_];
+        tail_ = published_ = l.tail.load(std::memory_order_acquire);
+        cachedHead_ = l.head.load(std::memory_order_acquire);
+        mask_ = ring.laneBytes_ - 1;
+        batch_ = batchBytes ? batchBytes : ring.laneBytes_ / 16;
+        data_ = ring.laneData(lane_);
+    }
+
+    Producer(const Producer&) = delete;
+    Producer& operator=(const Producer&) = delete;
+
+    ~Producer() {
+        flush();
+        ring_.laneHeaders_[lane_].owner.store(0, std::memory_order_release);
+    }
+
+    unsigned lane() const { return lane_; }
+    bool tookOver() const { return tookOver_; }       // the lane's previous owner had died
+
+    // Room for a message of up to `bytes`, inside the ring; data() ==
+    // nullptr if the lane is full. Throws std::invalid_argument
+    // above maxMessage()
+    std::span<std::byte> try_reserve(std::size_t bytes) {
+        using namespace shm_ring_detail;
+        if (bytes > ring_.maxMessage()) throw std::invalid_argument("ShmRing: message larger than maxMessage()");
+        const std::size_t need = kHeader + roundUp(bytes, 8);
+        const std::size_t left = ring_.laneBytes_ - (tail_ & mask_);
+        const std::size_t pad = left < need ? left : 0;
+        if (tail_ + pad + need - cachedHead_ > ring_.laneBytes_) {
+            cachedHead_ = ring_.laneHeaders_[lane_].head.load(std::memory_order_acquire);
+            if (tail_ + pad + need - cachedHead_ > ring_.laneBytes_) {
+                flush();                             // let the consumer drain what is there
+                return {};
+            }
+        }
+        if (pad) {
+            *reinterpret_cast<Record*>(data_ + (tail_ & mask_)) = {std::uint32_t(pad), kPad};
+            tail_ += pad;
+        }
+        reserved_ = bytes;
+        return {data_ + (tail_ & mask_) + kHeader, bytes};
+    }
+
+    // As try_reserve, but waits while the lane is full
+    std::span<std::byte> reserve(std::size_t bytes) {
+        using namespace shm_ring_detail;
+        for (unsigned i = 0; i < spinLimit(); ++i) {
+            std::span<std::byte> s = try_reserve(bytes);
+            if (s.data()) return s;
+            SHM_RING_PAUSE();
+        }
+        Lane& l = ring_.laneHeaders_[lane_];
+        for (;;) {
+            std::span<std::byte> s = try_reserve(bytes);
+            if (s.data()) return s;
+            // Full: sleep until the consumer publishes a new head
+            const std::uint32_t seen = l.headSeq.load(std::memory_order_acquire);
+            l.producerSleeping.store(1, std::memory_order_seq_cst);
+            if (l.head.load(std::memory_order_seq_cst) == cachedHead_) futexWait(l.headSeq, seen);
+            l.producerSleeping.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Finishes the reserved message with its final size (<= reserved)
+    void commit(std::size_t bytes) {
+        using namespace shm_ring_detail;
+        if (bytes > reserved_) throw std::invalid_argument("ShmRing: commit larger than the reservation");
+        *reinterpret_cast<Record*>(data_ + (tail_ & mask_)) = {std::uint32_t(bytes), kData};
+        tail_ += kHeader + roundUp(bytes, 8);
+        reserved_ = 0;
+        if (tail_ - published_ >= batch_) flush();
+    }
+
+    // Publish every message committed so far
+    void flush() {
+        if (published_ == tail_) return;
+        published_ = tail_;
+        ring_.laneHeaders_[lane_].tail.store(tail_, std::memory_order_release);
+        shm_ring_detail::wake(ring_.control_->doorbell, ring_.control_->consumerSleeping);
+    }
+
+private:
+    static constexpr unsigned kNoLane = ~0u;
+
+    ShmRing& ring_;
+    unsigned lane_ = kNoLane;
+    bool tookOver_ = false;
+    std::byte* data_ = nullptr;
+    std::size_t mask_ = 0, batch_ = 0, reserved_ = 0;
+    std::uint64_t tail_ = 0;                         // next record to write
+    std::uint64_t published_ = 0;                    // last value stored to the lane's tail
+    std::uint64_t cachedHead_ = 0;                   // the consumer's head, as last seen
+};
+
+// --------------------------------------------------
+// CONSUMER: one per segment
+// --------------------------------------------------
+class ShmRing::Consumer {
+public:
+    // batchBytes = 0: publish every laneBytes / 16. Throws
+    // std::runtime_error if a live consumer holds the ring
+    explicit Consumer(ShmRing& ring, std::size_t batchBytes = 0) : ring_(ring), lanes_(ring.lanes_) {
+        if (!ShmRing::claim(ring.control_->consumer, std::uint32_t(getpid()), tookOver_))
+            throw std::runtime_error("ShmRing: the ring already has a live consumer");
+        for (unsigned i = 0; i < ring.lanes_; ++i) {
+            LaneState& s = lanes_[i];
+            s.head = s.released = s.cachedTail = ring.laneHeaders_[i].head.load(std::memory_order_acquire);
+        }
+        mask_ = ring.laneBytes_ - 1;
+        batch_ = batchBytes ? batchBytes : ring.laneBytes_ / 16;
+    }
+
+    Consumer(const Consumer&) = delete;
+    Consumer& operator=(const Consumer&) = delete;
+
+    ~Consumer() {
+        for (unsigned i = 0; i < ring_.lanes_; ++i) publish(i);
+        ring_.control_->consumer.store(0, std::memory_order_release);
+    }
+
+    bool tookOver() const { return tookOver_; }       // the previous consumer had died
+
+    // The next message, or false if every lane is empty. The
+    // previous message must have been released
+    bool try_read(Message& out) {
+        if (current_ != kNone) throw std::logic_error("ShmRing: read() before release() of the last message");
+        // Finish what was visible on the last lane read, then move on:
+        // one tail snapshot per lane per turn keeps lanes fair
+        if (take(last_, false, out)) return true;
+        for (unsigned k = 1; k <= ring_.lanes_; ++k) {
+            const unsigned i = (last_ + k) % ring_.lanes_;
+            if (take(i, true, out)) return true;
+        }
+        return false;
+    }
+
+    // As try_read, but waits while every lane is empty
+    Message read() {
+        using namespace shm_ring_detail;
+        Message m;
+        for (unsigned i = 0; i < spinLimit(); ++i) {
+            if (try_read(m)) return m;
+            SHM_RING_PAUSE();
+        }
+        Control& c = *ring_.control_;
+        for (;;) {
+            if (try_read(m)) return m;
+            // Empty: sleep until a producer publishes a new tail
+            const std::uint32_t seen = c.doorbell.load(std::memory_order_acquire);
+            c.consumerSleeping.store(1, std::memory_order_seq_cst);
+            bool empty = true;
+            for (unsigned i = 0; i < ring_.lanes_ && empty; ++i)
+                empty = ring_.laneHeaders_[i].tail.load(std::memory_order_seq_cst) == lanes_[i].head;
+            if (empty) futexWait(c.doorbell, seen);
+            c.consumerSleeping.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Gives the last message's bytes back to its producer
+    void release() {
+        if (current_ == kNone) throw std::logic_error("ShmRing: release() without a message");
+        LaneState& s = lanes_[current_];
+        s.head += advance_;
+        if (s.head - s.released >= batch_) publish(current_);
+        current_ = kNone;
+    }
+
+private:
+    static constexpr unsigned kNone = ~0u;
+
+    struct LaneState {
+        std::uint64_t head = 0;                      // next record to read
+        std::uint64_t released = 0;                  // last value stored to the lane's head
+        std::uint64_t cachedTail = 0;                // the producer's tail, as last seen
+    };
+
+    bool take(unsigned i, bool reload, Message& out) {
+        using namespace shm_ring_detail;
+        LaneState& s = lanes_[i];
+        const std::byte* data = ring_.laneData(i);
+        for (;;) {
+            if (s.head == s.cachedTail) {
+                if (!reload) return false;
+                s.cachedTail = ring_.laneHeaders_[i].tail.load(std::memory_order_acquire);
+                if (s.head == s.cachedTail) {
+                    publish(i);                      // give the producer all the room
+                    return false;
+                }
+            }
+            const std::size_t off = s.head & mask_;
+            Record r;
+            std::memcpy(&r, data + off, sizeof r);
+            const std::size_t left = ring_.laneBytes_ - off;
+            if (r.kind == kPad && r.size >= kHeader && r.size == left) {
+                s.head += r.size;
+                continue;
+            }
+            if (r.kind != kData || r.size > ring_.maxMessage() || kHeader + r.size > left ||
+                s.cachedTail - s.head < kHeader + roundUp(r.size, 8))
+                throw std::runtime_error("ShmRing: corrupt record in lane " + std::to_string(i));
+            out.bytes = {data + off + kHeader, r.size};
+            out.lane = i;
+            current_ = last_ = i;
+            advance_ = kHeader + roundUp(r.size, 8);
+            return true;
+        }
+    }
+
+    void publish(unsigned i) {
+        LaneState& s = lanes_[i];
+        if (s.released == s.head) return;
+        s.released = s.head;
+        Lane& l = ring_.laneHeaders_[i];
+        l.head.store(s.head, std::memory_order_release);
+        shm_ring_detail::wake(l.headSeq, l.producerSleeping);
+    }
+
+    ShmRing& ring_;
+    std::vector<LaneState> lanes_;
+    bool tookOver_ = false;
+    std::size_t mask_ = 0, batch_ = 0, advance_ = 0;
+    unsigned current_ = kNone;                       // lane of the unreleased message
+    unsigned last_ = 0;
+};
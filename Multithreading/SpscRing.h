@@ -0,0 +1,213 @@
+// ======================================================
+// SpscRing.h — wait-free single-producer / single-consumer ring
+// ======================================================
+//
+// ProducerConsumerproblemUsingThread.cpp starts ONE producer and
+// ONE consumer, and still pays for the general case on every item:
+// lock, predicate, push, unlock, notify — and both threads fight
+// over the mutex and the deque's cache lines.
+//
+// With exactly one thread on each side nothing needs a lock or a
+// read-modify-write:
+// - the producer alone writes tail_, the consumer alone writes
+//   head_; each is published with ONE release store
+// - each side keeps a CACHED copy of the other side's index and
+//   reloads it only when the ring looks full (producer) or empty
+//   (consumer) — the other side's line is touched once per lap,
+//   not once per item
+// - BATCHED publication: an index is published every `batch`
+//   items (and always before the side would report full / empty
+//   or go to sleep), so the counterpart's cache line is written
+//   once per batch
+// - tail_, head_, the producer's locals, the consumer's locals
+//   and each sleep flag on separate cache lines: no shared line
+//   is written per item
+//
+// try_push / try_pop are wait-free (no loops, no CAS). push / pop
+// block only when the ring is full / empty: spin a little (not
+// with one CPU), then std::atomic::wait on the other side's index;
+// the publisher calls notify only when the sleep flag is up, and
+// once per sleep.
+//
+// Items pushed and not yet published stay invisible until the
+// batch fills, the ring fills or flush() — a producer that pauses
+// should flush(). batch = 1 publishes every item.
+//
+//     SpscRing<int> ring(1024);             // rounded up to a power of two
+//     ring.push(42);                        // producer thread only
+//     ring.flush();                         //   before it goes idle
+//     int v = ring.pop();                   // consumer thread only
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "CachePadded.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SPSC_PAUSE() _mm_pause()
+#elif defined(__aarch64__)
+#define SPSC_PAUSE() asm volatile("yield")
+#else
+#define SPSC_PAUSE() ((void)0)
+#endif
+
+template <typename T>
+class SpscRing {
+public:
+    static constexpr std::size_t kDefaultBatch = 32;
+
+    explicit SpscRing(std::size_t capacity, std::size_t batch = kDefaultBatch)
+        : mask_(roundUpPow2(capacity) - 1),
+          batch_(batch == 0 ? 1 : std::min(batch, mask_ + 1)),
+          slots_(mask_ + 1) {
+        if (capacity == 0) throw std::invalid_argument("SpscRing: capacity must be > 0");
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+    // --------------------------------------------------
+    // PRODUCER (one thread)
+    // --------------------------------------------------
+
+    // False if the ring is full
+    bool try_push(T value) {
+        Producer& p = producer_;
+        if (p.tail - p.cachedHead > mask_) {
+            p.cachedHead = head_.load(std::memory_order_acquire);
+            if (p.tail - p.cachedHead > mask_) {
+                flush();                             // let the consumer drain what is there
+                return false;
+            }
+        }
+        slots_[p.tail & mask_] = std::move(value);
+        if (++p.tail - p.published >= batch_) flush();
+        return true;
+    }
+
+    void push(T value) {
+        for (unsigned i = 0; i < spinLimit(); ++i) {
+            if (try_push(value)) return;
+            SPSC_PAUSE();
+        }
+        while (!try_push(value)) {
+            // Full: sleep until the consumer publishes a new head
+            const std::size_t seen = producer_.cachedHead;
+            sleepingProducer_->store(true, std::memory_order_seq_cst);
+            if (head_.load(std::memory_order_seq_cst) == seen) head_.wait(seen, std::memory_order_relaxed);
+            sleepingProducer_->store(false, std::memory_order_relaxed);
+        }
+    }
+
+    // Publish every item pushed so far
+    void flush() {
+        Producer& p = producer_;
+        if (p.published == p.tail) return;
+        p.published = p.tail;
+        tail_.store(p.tail, std::memory_order_release);
+        wake(tail_, *sleepingConsumer_);
+    }
+
+    // --------------------------------------------------
+    // CONSUMER (one thread)
+    // --------------------------------------------------
+
+    // False if no published item is left
+    bool try_pop(T& out) {
+        Consumer& c = consumer_;
+        if (c.head == c.cachedTail) {
+            c.cachedTail = tail_.load(std::memory_order_acquire);
+            if (c.head == c.cachedTail) {
+                release();                           // give the producer all the room
+                return false;
+            }
+        }
+        out = std::move(slots_[c.head & mask_]);
+        if (++c.head - c.released >= batch_) release();
+        return true;
+    }
+
+    T pop() {
+        T out{};
+        for (unsigned i = 0; i < spinLimit(); ++i) {
+            if (try_pop(out)) return out;
+            SPSC_PAUSE();
+        }
+        while (!try_pop(out)) {
+            // Empty: sleep until the producer publishes a new tail
+            const std::size_t seen = consumer_.cachedTail;
+            sleepingConsumer_->store(true, std::memory_order_seq_cst);
+            if (tail_.load(std::memory_order_seq_cst) == seen) tail_.wait(seen, std::memory_order_relaxed);
+            sleepingConsumer_->store(false, std::memory_order_relaxed);
+        }
+        return out;
+    }
+
+    // Published items not yet released by the consumer (a snapshot)
+    std::size_t size_approx() const {
+        return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Producer {
+        std::size_t tail = 0;                        // next slot to write
+        std::size_t published = 0;                   // last value stored to tail_
+        std::size_t cachedHead = 0;                  // consumer's head, as last seen
+    };
+    struct Consumer {
+        std::size_t head = 0;
+        std::size_t released = 0;
+        std::size_t cachedTail = 0;
+    };
+
+    static std::size_t roundUpPow2(std::size_t n) {
+        std::size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    // Spinning only helps when the other side runs on another core
+    static unsigned spinLimit() {
+        static const unsigned limit = std::thread::hardware_concurrency() > 1 ? 1000u : 0u;
+        return limit;
+    }
+
+    // Store → fence → load against the sleeper's store → load: one of
+    // the two sees the other (no lost wake-up). Clearing the flag
+    // makes it one notify per sleep, not one per publication until
+    // the sleeper gets to run
+    static void wake(std::atomic<std::size_t>& index, std::atomic<bool>& sleeping) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed) && sleeping.exchange(false, std::memory_order_relaxed))
+            index.notify_one();
+    }
+
+    void release() {
+        Consumer& c = consumer_;
+        if (c.released == c.head) return;
+        c.released = c.head;
+        head_.store(c.head, std::memory_order_release);
+        wake(head_, *sleepingProducer_);
+    }
+
+    const std::size_t mask_;
+    const std::size_t batch_;
+    std::vector<T> slots_;
+
+    alignas(cache_line_size) std::atomic<std::size_t> tail_{0};     // written by the producer
+    alignas(cache_line_size) std::atomic<std::size_t> head_{0};     // written by the consumer
+    alignas(cache_line_size) Producer producer_;
+    alignas(cache_line_size) Consumer consumer_;
+    cache_padded<std::atomic<bool>> sleepingProducer_;    // value-initialised: false
+    cache_padded<std::atomic<bool>> sleepingConsumer_;
+};
@@ -0,0 +1,142 @@
+// ======================================================
+// StopWait.h — blocking waits that a std::stop_token can interrupt
+// ======================================================
+//
+// pucerconsumer.cpp, ProducerConsumerproblemUsingThread.cpp,
+// Threads/priority.cpp:
+//
+//     while (1) { signal_to_producer.acquire(); ... }      // semaphore
+//     while (true) { cond.wait(locker, [] { return buffer.size() > 0; }); ... }
+//     while (true) { cout << "Running thread...\n"; Sleep(500); }
+//
+// Nothing can end these loops: a flag checked once per iteration
+// is only seen after the current wait returns — never, for a
+// consumer of an empty queue; up to 500 ms for the sleeper. So
+// shutdown means a kill, or a timed wait polled in a loop
+// (latency = the poll period, wake-ups while idle).
+//
+// std::jthread hands its function a std::stop_token and calls
+// request_stop() + join() in its destructor. Here every wait
+// takes that token and returns as soon as stop is requested —
+// the stop callback notifies the waiter, no polling:
+//
+//   StopSemaphore<Max>   counting semaphore
+//       acquire(st) → false if stopped before a permit came
+//   StopQueue<T>         bounded FIFO (mutex + 2 condition_variable_any)
+//       push(st, v) → false if stopped while full
+//       pop(st)     → std::nullopt once stopped and empty
+//   sleepFor(st, d)      → false if stopped before d elapsed
+//
+//   std::jthread consumer([&](std::stop_token st) {
+//       while (auto v = queue.pop(st)) use(*v);
+//   });
+//   ...
+//   consumer.request_stop();         // pop returns nullopt now
+//
+// Stop interrupts WAITING only: pop still hands out queued items
+// (a consumer drains what it can take without blocking), acquire
+// still takes a free permit.
+//
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+#include <utility>
+
+template <std::ptrdiff_t Max = 1>
+class StopSemaphore {
+public:
+    explicit StopSemaphore(std::ptrdiff_t initial = 0) : count_(initial) {
+        if (initial < 0 || initial > Max) throw std::invalid_argument("StopSemaphore: initial count out of range");
+    }
+    StopSemaphore(const StopSemaphore&) = delete;
+    StopSemaphore& operator=(const StopSemaphore&) = delete;
+
+    // true: took a permit; false: stop requested first
+    bool acquire(std::stop_token st) {
+        std::unique_lock lock(m_);
+        if (!cv_.wait(lock, st, [&] { return count_ > 0; })) return false;
+        --count_;
+        return true;
+    }
+
+    bool try_acquire() {
+        std::lock_guard lock(m_);
+        if (count_ == 0) return false;
+        --count_;
+        return true;
+    }
+
+    void release(std::ptrdiff_t n = 1) {
+        {
+            std::lock_guard lock(m_);
+            if (n < 0 || count_ + n > Max) throw std::invalid_argument("StopSemaphore: release past the maximum");
+            count_ += n;
+        }
+        if (n == 1) cv_.notify_one();
+        else cv_.notify_all();
+    }
+
+private:
+    std::mutex m_;
+    std::condition_variable_any cv_;
+    std::ptrdiff_t count_;
+};
+
+template <typename T>
+class StopQueue {
+public:
+    explicit StopQueue(std::size_t capacity) : capacity_(capacity) {
+        if (capacity == 0) throw std::invalid_argument("StopQueue: capacity must be at least 1");
+    }
+    StopQueue(const StopQueue&) = delete;
+    StopQueue& operator=(const StopQueue&) = delete;
+
+    // Waits for space; false (v dropped) if stop came first
+    bool push(std::stop_token st, T v) {
+        std::unique_lock lock(m_);
+        if (!notFull_.wait(lock, st, [&] { return q_.size() < capacity_; })) return false;
+        q_.push_back(std::move(v));
+        lock.unlock();
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    // Waits for an item; std::nullopt once stopped with nothing queued
+    std::optional<T> pop(std::stop_token st) {
+        std::unique_lock lock(m_);
+        if (!notEmpty_.wait(lock, st, [&] { return !q_.empty(); })) return std::nullopt;
+        T v = std::move(q_.front());
+        q_.pop_front();
+        lock.unlock();
+        notFull_.notify_one();
+        return v;
+    }
+
+    std::size_t size() const {
+        std::lock_guard lock(m_);
+        return q_.size();
+    }
+
+private:
+    const std::size_t capacity_;
+    mutable std::mutex m_;
+    std::condition_variable_any notFull_, notEmpty_;
+    std::deque<T> q_;
+};
+
+// Sleeps d unless stop is requested; true if the whole d elapsed
+template <class Rep, class Period>
+bool sleepFor(std::stop_token st, std::chrono::duration<Rep, Period> d) {
+    std::mutex m;
+    std::condition_variable_any cv;
+    std::unique_lock lock(m);
+    cv.wait_for(lock, st, d, [] { return false; });         // only the stop callback or the timeout ends it
+    return !st.stop_requested();
+}
@@ -0,0 +1,178 @@
+// ======================================================
+// StripedRWLock.h — reader-writer lock, one reader count per stripe
+// ======================================================
+//
+// Mutex.cpp / LockGuard.cpp / unique_Lock.cpp lock EVERY access
+// exclusively, and consumeXY() (std::try_lock.cpp) only READS
+// X and Y. std::shared_mutex lets readers in together — but every
+// lock_shared() still increments ONE reader count: with many
+// cores the readers fight over its cache line as hard as over a
+// mutex.
+//
+// StripedRWLock spreads the reader count:
+// - stripes: one counter per stripe, each on its own cache line
+//   (cache_padded, CachePadded.h). A thread always uses the same
+//   stripe (thread slot % stripes, like ShardedCounter), so readers
+//   on different stripes share no line at all
+// - lock_shared():  ++own stripe, then check "no writer"
+// - lock():         claim the writer flag, then wait until EVERY
+//                   stripe is zero — writers pay O(stripes), which
+//                   is the right trade when reads dominate
+//
+// Both sides publish first and check second (seq_cst), so a reader
+// and a writer arriving together cannot both get in: at least one
+// sees the other and backs off.
+//
+// Preference (starvation.txt: a ready thread that never gets the
+// resource):
+//   Writers (default)  a waiting writer stops NEW readers; the
+//                      current ones drain and the writer goes next.
+//                      A steady stream of readers cannot starve it
+//   Readers            a writer goes only when no reader holds the
+//                      lock; overlapping readers can starve writers
+//                      forever (the classic first readers-writers
+//                      solution) — highest read throughput.
+//                      glibc's std::shared_mutex behaves like this
+//                      (stripedRWLock.cpp, section 2)
+//
+// Meets the SharedMutex requirements: use it with
+// std::shared_lock / std::unique_lock / std::lock_guard. As with
+// std::shared_mutex, unlock_shared() must run on the thread that
+// called lock_shared() (the stripe is the thread's).
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "CachePadded.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RWLOCK_PAUSE() _mm_pause()
+#elif defined(__aarch64__)
+#define RWLOCK_PAUSE() asm volatile("yield")
+#else
+#define RWLOCK_PAUSE() ((void)0)
+#endif
+
+enum class RWPreference { Writers, Readers };
+
+namespace rwlock_detail {
+
+// Spin a little, then give the CPU away. Spinning with one CPU
+// only delays the thread we wait for
+inline void relax(unsigned& spins) {
+    static const bool multiCore = std::thread::hardware_concurrency() > 1;
+    if (multiCore && spins < 64) {
+        for (unsigned i = 0; i <= spins; ++i) RWLOCK_PAUSE();
+        ++spins;
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+}  // namespace rwlock_detail
+
+class StripedRWLock {
+public:
+    explicit StripedRWLock(RWPreference preference = RWPreference::Writers, std::size_t stripes = defaultStripes())
+        : preference_(preference), stripes_(stripes == 0 ? 1 : stripes) {}
+
+    StripedRWLock(const StripedRWLock&) = delete;
+    StripedRWLock& operator=(const StripedRWLock&) = delete;
+
+    // ---------------- readers ----------------
+
+    void lock_shared() {
+        std::atomic<std::int32_t>& mine = *stripes_[myStripe()];
+        for (unsigned spins = 0;;) {
+            while (blocksReaders()) rwlock_detail::relax(spins);
+            mine.fetch_add(1, std::memory_order_seq_cst);
+            if (!writer_.load(std::memory_order_seq_cst)) return;
+            mine.fetch_sub(1, std::memory_order_release);      // a writer got in first
+        }
+    }
+
+    bool try_lock_shared() {
+        if (blocksReaders()) return false;
+        std::atomic<std::int32_t>& mine = *stripes_[myStripe()];
+        mine.fetch_add(1, std::memory_order_seq_cst);
+        if (!writer_.load(std::memory_order_seq_cst)) return true;
+        mine.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    void unlock_shared() { stripes_[myStripe()]->fetch_sub(1, std::memory_order_release); }
+
+    // ---------------- writers ----------------
+
+    void lock() {
+        if (preference_ == RWPreference::Writers) {
+            waitingWriters_.fetch_add(1, std::memory_order_seq_cst);
+            for (unsigned spins = 0; !claimWriter();) rwlock_detail::relax(spins);
+            waitingWriters_.fetch_sub(1, std::memory_order_relaxed);
+            for (unsigned spins = 0; readersPresent();) rwlock_detail::relax(spins);
+            return;
+        }
+        // Readers first: only go when nobody reads, and give way
+        // again if a reader slipped in meanwhile
+        for (unsigned spins = 0;;) {
+            while (readersPresent() || writer_.load(std::memory_order_relaxed)) rwlock_detail::relax(spins);
+            if (!claimWriter()) continue;
+            if (!readersPresent()) return;
+            writer_.store(false, std::memory_order_release);
+        }
+    }
+
+    bool try_lock() {
+        if (readersPresent() || !claimWriter()) return false;
+        if (!readersPresent()) return true;
+        writer_.store(false, std::memory_order_release);
+        return false;
+    }
+
+    void unlock() { writer_.store(false, std::memory_order_release); }
+
+    RWPreference preference() const { return preference_; }
+    std::size_t stripe_count() const { return stripes_.size(); }
+
+private:
+    using Stripe = cache_padded<std::atomic<std::int32_t>>;
+
+    static std::size_t defaultStripes() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n == 0 ? 8 : n;
+    }
+
+    // Threads get consecutive stripe slots the first time they read
+    std::size_t myStripe() const {
+        static std::atomic<std::size_t> nextThread{0};
+        thread_local const std::size_t slot = nextThread.fetch_add(1, std::memory_order_relaxed);
+        return slot % stripes_.size();
+    }
+
+    bool blocksReaders() const {
+        return writer_.load(std::memory_order_relaxed) ||
+               (preference_ == RWPreference::Writers && waitingWriters_.load(std::memory_order_relaxed) > 0);
+    }
+
+    bool claimWriter() {
+        bool expected = false;
+        return !writer_.load(std::memory_order_relaxed) &&
+               writer_.compare_exchange_strong(expected, true, std::memory_order_seq_cst);
+    }
+
+    bool readersPresent() const {
+        for (const Stripe& s : stripes_)
+            if (s->load(std::memory_order_seq_cst) != 0) return true;
+        return false;
+    }
+
+    const RWPreference preference_;
+    std::vector<Stripe> stripes_;
+    alignas(cache_line_size) std::atomic<bool> writer_{false};       // held or draining readers
+    alignas(cache_line_size) std::atomic<std::int32_t> waitingWriters_{0};
+};
@@ -0,0 +1,309 @@
+// ======================================================
+// TaskGraph.h — Reusable DAG of tasks, run with work stealing
+// ======================================================
+//
+// std::async.cpp launches ONE find_odd, and the only choice is
+// WHEN it runs: std::launch::async (a new thread now) or
+// std::launch::deferred (on the thread that calls get()).
+// Real work is a graph — partitions that are independent,
+// then steps that need their results:
+//
+//     TaskGraph g;
+//     auto a = g.add("odd[0]", [&] { part[0] = find_odd(0, m); });
+//     auto b = g.add("odd[1]", [&] { part[1] = find_odd(m + 1, e); });
+//     auto s = g.add("sum",    [&] { total = part[0] + part[1]; });
+//     g.precede(a, s);
+//     g.precede(b, s);
+//
+//     g.run(pool);                  // a, b in parallel; s the moment both end
+//     g.run(pool);                  // again: nothing rebuilt, nothing allocated per node
+//     g.criticalPath();             // the longest chain of the last run
+//
+// HOW run() EXECUTES:
+// - every node has a count of unfinished predecessors; the
+//   nodes at zero form the ready queue (topological order is
+//   never materialised per run — it falls out of the counts)
+// - each participant (the caller plus one helper task per pool
+//   worker) owns a ready deque: it pops its own at the BACK,
+//   steals from others at the FRONT, like ThreadPool itself
+// - finishing a node decrements its successors; the ones that
+//   hit zero go on the finisher's own deque, so a dependent
+//   starts right away on a cache-warm thread
+// - an idle participant sleeps on an atomic epoch bumped by
+//   every push, and run() returns once all nodes are done and
+//   every helper has left
+//
+// REUSE: add() / precede() allocate; the first run() checks the
+// graph for cycles (std::invalid_argument) and sizes the
+// per-run state. Later runs only reset it — no allocation per
+// node, only ThreadPool::post's Task for each helper.
+//
+// If a node throws, the nodes not yet started are skipped and
+// run() rethrows the first exception once the graph drained.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ThreadPool.h"
+
+class TaskGraph {
+public:
+    using NodeId = std::size_t;
+
+    // The longest dependency chain of the last run, by measured
+    // node durations; work / length is the most any number of
+    // cores could have sped the graph up
+    struct CriticalPath {
+        std::vector<NodeId> nodes;         // first to last
+        std::chrono::nanoseconds length{0};
+        std::chrono::nanoseconds work{0}; // sum over every node
+        std::chrono::nanoseconds wall{0}; // run() start to last node's end
+        double parallelism() const { return length.count() ? double(work.count()) / double(length.count()) : 0.0; }
+    };
+
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    NodeId add(std::string name, ThreadPool::Task fn) {
+        if (running_) throw std::logic_error("TaskGraph::add: graph is running");
+        nodes_.push_back(Node{std::move(name), std::move(fn), {}, 0});
+        prepared_ = false;
+        return nodes_.size() - 1;
+    }
+
+    // `before` must finish before `after` starts
+    void precede(NodeId before, NodeId after) {
+        if (running_) throw std::logic_error("TaskGraph::precede: graph is running");
+        if (before >= nodes_.size() || after >= nodes_.size())
+            throw std::invalid_argument("TaskGraph::precede: unknown node");
+        if (before == after) throw std::invalid_argument("TaskGraph::precede: node depends on itself");
+        nodes_[before].successors.push_back(after);
+        ++nodes_[after].predecessors;
+        prepared_ = false;
+    }
+
+    std::size_t size() const { return nodes_.size(); }
+    const std::string& name(NodeId id) const { return nodes_.at(id).name; }
+
+    // Runs every node once; blocks until the whole graph is done.
+    // The calling thread executes nodes too.
+    void run(ThreadPool& pool) {
+        if (running_) throw std::logic_error("TaskGraph::run: already running");
+        prepare(pool.size() + 1);
+        if (nodes_.empty()) return;
+        running_ = true;
+
+        remaining_.store(nodes_.size(), std::memory_order_relaxed);
+        failed_.store(false, std::memory_order_relaxed);
+        error_ = nullptr;
+        for (std::size_t q = 0; q < participants_; ++q) queues_[q].head = queues_[q].tail = 0;
+        for (NodeId i = 0; i < nodes_.size(); ++i)
+            pending_[i].store(nodes_[i].predecessors, std::memory_order_relaxed);
+        std::size_t q = 0;
+        for (NodeId root : roots_) push(q++ % participants_, root);   // spread the roots
+        origin_ = Clock::now();
+
+        std::size_t helpers = participants_ - 1;
+        helpersLeft_ = helpers;
+        for (std::size_t h = 1; h <= helpers; ++h)
+            pool.post([this, h] {
+                participate(h);
+                std::lock_guard<std::mutex> lg(exitLock_);   // last touch of `this`
+                if (--helpersLeft_ == 0) exitCv_.notify_all();
+            });
+        participate(0);
+
+        // Helpers still queued behind other work hold `this`:
+        // help the pool until they have all left
+        {
+            std::unique_lock<std::mutex> lk(exitLock_);
+            while (helpersLeft_ != 0) {
+                lk.unlock();
+                bool helped = pool.runPendingTask();
+                lk.lock();
+                if (!helped) exitCv_.wait_for(lk, std::chrono::milliseconds(1), [this] { return helpersLeft_ == 0; });
+            }
+        }
+        running_ = false;
+        if (error_) std::rethrow_exception(error_);
+    }
+
+    // Measured over the last run(); allocates the result
+    CriticalPath criticalPath() const {
+        CriticalPath out;
+        if (nodes_.empty() || !prepared_) return out;
+        std::vector<std::int64_t> best(nodes_.size());
+        std::vector<NodeId> parent(nodes_.size(), nodes_.size());
+        std::int64_t end = 0;
+        for (NodeId i = 0; i < nodes_.size(); ++i) {
+            best[i] = duration(i);
+            out.work += std::chrono::nanoseconds(duration(i));
+            end = std::max(end, endNs_[i]);
+        }
+        NodeId last = order_.front();
+        for (NodeId i : order_) {               // topological: every predecessor is final
+            for (NodeId s : nodes_[i].successors)
+                if (best[i] + duration(s) > best[s]) {
+                    best[s] = best[i] + duration(s);
+                    parent[s] = i;
+                }
+            if (best[i] > best[last]) last = i;
+        }
+        out.length = std::chrono::nanoseconds(best[last]);
+        out.wall = std::chrono::nanoseconds(end);
+        for (NodeId i = last; i != nodes_.size(); i = parent[i]) out.nodes.push_back(i);
+        std::reverse(out.nodes.begin(), out.nodes.end());
+        return out;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Node {
+        std::string name;
+        ThreadPool::Task fn;
+        std::vector<NodeId> successors;
+        std::size_t predecessors;
+    };
+
+    // A participant's ready nodes: a ring with room for every
+    // node, since each node is pushed exactly once per run
+    struct ReadyQueue {
+        std::mutex m;
+        std::vector<NodeId> ring;
+        std::size_t head = 0; // front: thieves
+        std::size_t tail = 0; // back: owner
+    };
+
+    // Cycle check, roots, topological order and per-run buffers;
+    // only when the graph (or the participant count) changed
+    void prepare(std::size_t participants) {
+        if (prepared_ && participants == participants_) return;
+        const std::size_t n = nodes_.size();
+        order_.clear();
+        roots_.clear();
+        std::vector<std::size_t> indegree(n);
+        for (NodeId i = 0; i < n; ++i) {
+            indegree[i] = nodes_[i].predecessors;
+            if (indegree[i] == 0) {
+                roots_.push_back(i);
+                order_.push_back(i);
+            }
+        }
+        for (std::size_t k = 0; k < order_.size(); ++k)
+            for (NodeId s : nodes_[order_[k]].successors)
+                if (--indegree[s] == 0) order_.push_back(s);
+        if (order_.size() != n) throw std::invalid_argument("TaskGraph::run: the dependencies form a cycle");
+
+        pending_ = std::make_unique<std::atomic<std::size_t>[]>(n);
+        startNs_.assign(n, 0);
+        endNs_.assign(n, 0);
+        queues_ = std::make_unique<ReadyQueue[]>(participants);
+        for (std::size_t q = 0; q < participants; ++q) queues_[q].ring.assign(n, 0);
+        participants_ = participants;
+        prepared_ = true;
+    }
+
+    void push(std::size_t q, NodeId id) {
+        {
+            std::lock_guard<std::mutex> lg(queues_[q].m);
+            ReadyQueue& rq = queues_[q];
+            rq.ring[rq.tail++ % rq.ring.size()] = id;
+        }
+        epoch_.fetch_add(1, std::memory_order_release);
+        epoch_.notify_one();
+    }
+
+    bool popLocal(std::size_t q, NodeId& out) {
+        std::lock_guard<std::mutex> lg(queues_[q].m);
+        ReadyQueue& rq = queues_[q];
+        if (rq.head == rq.tail) return false;
+        out = rq.ring[--rq.tail % rq.ring.size()];        // LIFO for the owner
+        return true;
+    }
+
+    bool steal(std::size_t self, NodeId& out) {
+        for (std::size_t k = 1; k < participants_; ++k) {
+            ReadyQueue& rq = queues_[(self + k) % participants_];
+            std::unique_lock<std::mutex> lk(rq.m, std::try_to_lock);
+            if (!lk.owns_lock() || rq.head == rq.tail) continue;
+            out = rq.ring[rq.head++ % rq.ring.size()];    // FIFO for thieves
+            return true;
+        }
+        return false;
+    }
+
+    void participate(std::size_t self) {
+        for (;;) {
+            std::uint64_t seen = epoch_.load(std::memory_order_acquire);
+            NodeId id;
+            if (popLocal(self, id) || steal(self, id)) {
+                execute(self, id);
+                continue;
+            }
+            if (remaining_.load(std::memory_order_acquire) == 0) return;
+            epoch_.wait(seen, std::memory_order_acquire);   // woken by a push or the last node
+        }
+    }
+
+    void execute(std::size_t self, NodeId id) {
+        startNs_[id] = sinceOrigin();
+        if (!failed_.load(std::memory_order_relaxed)) {
+            try {
+                nodes_[id].fn();
+            } catch (...) {
+                std::lock_guard<std::mutex> lg(errorLock_);
+                if (!error_) error_ = std::current_exception();
+                failed_.store(true, std::memory_order_relaxed);
+            }
+        }
+        endNs_[id] = sinceOrigin();
+        for (NodeId s : nodes_[id].successors)
+            if (pending_[s].fetch_sub(1, std::memory_order_acq_rel) == 1) push(self, s);
+        if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            epoch_.fetch_add(1, std::memory_order_release);
+            epoch_.notify_all();                           // everyone out
+        }
+    }
+
+    std::int64_t sinceOrigin() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin_).count();
+    }
+    std::int64_t duration(NodeId i) const { return endNs_[i] - startNs_[i]; }
+
+    std::vector<Node> nodes_;
+    std::vector<NodeId> roots_;
+    std::vector<NodeId> order_;
+    bool prepared_ = false;
+    bool running_ = false;
+
+    // Per-run state, sized by prepare()
+    std::unique_ptr<std::atomic<std::size_t>[]> pending_;
+    std::unique_ptr<ReadyQueue[]> queues_;
+    std::size_t participants_ = 0;
+    std::vector<std::int64_t> startNs_;
+    std::vector<std::int64_t> endNs_;
+    Clock::time_point origin_;
+
+    std::atomic<std::size_t> remaining_{0};
+    std::mutex exitLock_;
+    std::condition_variable exitCv_;
+    std::size_t helpersLeft_ = 0;
+    std::atomic<std::uint64_t> epoch_{0};
+    std::atomic<bool> failed_{false};
+    std::mutex errorLock_;
+    std::exception_ptr error_;
+};
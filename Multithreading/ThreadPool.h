@@ -0,0 +1,194 @@
+// ======================================================
+// ThreadPool.h — Work-stealing thread pool
+// ======================================================
+//
+// WHY:
+// std::async(std::launch::async, ...) creates a NEW OS thread
+// for every call. Thousands of short tasks → thousands of
+// thread creations, and no upper bound on live threads.
+//
+// DESIGN:
+// - A FIXED number of worker threads (default: one per core)
+// - Every worker owns its OWN deque of tasks
+//     * the owner pushes/pops at the BACK  (LIFO, cache-warm)
+//     * thieves steal from the FRONT       (FIFO, oldest work)
+// - An idle worker picks a RANDOM victim and steals from it
+// - submit() returns std::future<R>, exactly like std::async
+//
+// Tasks submitted from inside a worker go to that worker's
+// own deque; tasks submitted from outside are spread
+// round-robin over all workers.
+//
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class ThreadPool {
+public:
+    // --------------------------------------------------
+    // Task: move-only, type-erased "void()" callable
+    // (std::function needs copyable targets, and
+    //  std::packaged_task is move-only)
+    // --------------------------------------------------
+    class Task {
+        struct Base {
+            virtual ~Base() = default;
+            virtual void run() = 0;
+        };
+        template <typename F>
+        struct Impl : Base {
+            F f;
+            explicit Impl(F&& fn) : f(std::move(fn)) {}
+            void run() override { f(); }
+        };
+        std::unique_ptr<Base> impl;
+
+    public:
+        Task() = default;
+        template <typename F,
+                  typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+        Task(F&& f) : impl(new Impl<std::decay_t<F>>(std::forward<F>(f))) {}
+        explicit operator bool() const { return impl != nullptr; }
+        void operator()() { impl->run(); }
+    };
+
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency())
+        : queues_(threads == 0 ? 1 : threads) {
+        for (unsigned i = 0; i < queues_.size(); ++i)
+            workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Finishes every queued task, then joins the workers
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lg(sleepMutex_);
+            stopping_ = true;
+        }
+        sleepCv_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    std::size_t size() const { return workers_.size(); }
+
+    // Same shape as std::async(f, args...) → std::future<R>
+    template <typename F, typename... Args>
+    auto submit(F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
+        using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+
+        std::packaged_task<R()> task(
+            [fn = std::forward<F>(f),
+             tup = std::make_tuple(std::forward<Args>(args)...)]() mutable -> R {
+                return std::apply(std::move(fn), std::move(tup));
+            });
+        std::future<R> fut = task.get_future();
+        post(Task(std::move(task)));
+        return fut;
+    }
+
+    // Fire-and-forget submission (no future)
+    void post(Task task) {
+        std::size_t q = (currentPool_ == this)
+                            ? currentIndex_
+                            : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        {
+            std::lock_guard<std::mutex> lg(queues_[q].m);
+            queues_[q].tasks.push_back(std::move(task));
+        }
+        pending_.fetch_add(1, std::memory_order_release);
+        {
+            // Empty critical section: pairs with the predicate check
+            // in workerLoop so the wakeup can never be lost
+            std::lock_guard<std::mutex> lg(sleepMutex_);
+        }
+        sleepCv_.notify_one();
+    }
+
+    // Run ONE queued task on the calling thread, if any.
+    // Lets a task that waits on other pool futures "help"
+    // instead of blocking a worker.
+    bool runPendingTask() {
+        std::size_t self = (currentPool_ == this) ? currentIndex_ : 0;
+        Task t;
+        if (!popLocal(self, t) && !steal(self, t)) return false;
+        t();
+        return true;
+    }
+
+private:
+    struct WorkQueue {
+        std::mutex m;
+        std::deque<Task> tasks;
+    };
+
+    bool popLocal(std::size_t i, Task& out) {
+        std::lock_guard<std::mutex> lg(queues_[i].m);
+        if (queues_[i].tasks.empty()) return false;
+        out = std::move(queues_[i].tasks.back());     // LIFO for the owner
+        queues_[i].tasks.pop_back();
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool steal(std::size_t self, Task& out) {
+        static thread_local std::minstd_rand rng(std::random_device{}());
+        std::size_t n = queues_.size();
+        std::size_t start = rng() % n;                // random victim first
+        for (std::size_t k = 0; k < n; ++k) {
+            std::size_t v = (start + k) % n;
+            if (v == self) continue;
+            std::unique_lock<std::mutex> lk(queues_[v].m, std::try_to_lock);
+            if (!lk.owns_lock() || queues_[v].tasks.empty()) continue;
+            out = std::move(queues_[v].tasks.front()); // FIFO for thieves
+            queues_[v].tasks.pop_front();
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(std::size_t index) {
+        currentPool_ = this;
+        currentIndex_ = index;
+        for (;;) {
+            Task t;
+            if (popLocal(index, t) || steal(index, t)) {
+                t();
+                continue;
+            }
+            std::unique_lock<std::mutex> lk(sleepMutex_);
+            sleepCv_.wait(lk, [this] {
+                return stopping_ || pending_.load(std::memory_order_acquire) > 0;
+            });
+            if (stopping_ && pending_.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+
+    std::vector<WorkQueue> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> nextQueue_{0};
+    std::atomic<long> pending_{0};
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    bool stopping_ = false;
+
+    static inline thread_local ThreadPool* currentPool_ = nullptr;
+    static inline thread_local std::size_t currentIndex_ = 0;
+};
@@ -6,6 +6,7 @@
 #include <condition_variable>
 #include <thread>
 #include <chrono>
+#include "Trace.h"
 
 using namespace std;
 
@@ -120,9 +121,14 @@ public:
              Wait until this thread is the allowed thread.
              Condition variable ensures ordered execution.
             */
-            cv.wait(lock, [this] {
-                return std::this_thread::get_id() == thread_ids[allowed_thread];
-            });
+            {
+                // Zones on a timeline (Trace.h); this loop never exits, so
+                // TRACE_FILE=trace.json TRACE_PERIOD_MS=500 rewrites the file
+                TRACE_SCOPE("wait turn");
+                cv.wait(lock, [this] {
+                    return std::this_thread::get_id() == thread_ids[allowed_thread];
+                });
+            }
 
             // Print characters
             print_chars();
@@ -148,6 +154,7 @@ public:
      Prints a chunk of the string starting from next_char.
     */
     void print_chars() {
+        TRACE_SCOPE("print_chars");
 
         // Print logical thread ID
         cout << "ThreadId "
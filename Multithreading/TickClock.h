@@ -0,0 +1,69 @@
+// ======================================================
+// TickClock.h — cheap timestamps: steady_clock or the TSC
+// ======================================================
+//
+// Tracing code takes a timestamp per item or per scope, so the
+// clock read IS the overhead. Two sources, one shape:
+//
+//   SteadyStamp   std::chrono::steady_clock (clock_gettime via
+//                 the vDSO), ~20 ns, portable
+//   TscStamp      rdtsc, a few ns; ticks → ns calibrated once
+//                 against steady_clock; steady_clock where there
+//                 is no TSC (non-x86)
+//
+// Both: static now() → raw ticks, static nsPerTick().
+// Differences of now() are meaningful; the absolute values are not.
+//
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TICKCLOCK_HAVE_TSC 1
+#else
+#define TICKCLOCK_HAVE_TSC 0
+#endif
+
+struct SteadyStamp {
+    static constexpr const char* name = "steady_clock";
+    static std::uint64_t now() {
+        return std::uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+    static double nsPerTick() {
+        using period = std::chrono::steady_clock::period;
+        return 1e9 * double(period::num) / double(period::den);
+    }
+};
+
+// Assumes an invariant TSC (constant rate, synchronised across
+// cores), as on every x86 of the last decade
+struct TscStamp {
+    static constexpr const char* name = TICKCLOCK_HAVE_TSC ? "rdtsc" : "steady_clock (no TSC)";
+    static std::uint64_t now() {
+#if TICKCLOCK_HAVE_TSC
+        return __rdtsc();
+#else
+        return SteadyStamp::now();
+#endif
+    }
+    // Measured once: TSC ticks over ~10 ms of steady_clock
+    static double nsPerTick() {
+#if TICKCLOCK_HAVE_TSC
+        static const double ns = [] {
+            using namespace std::chrono;
+            const auto t0 = steady_clock::now();
+            const std::uint64_t c0 = __rdtsc();
+            while (steady_clock::now() - t0 < milliseconds(10)) {
+            }
+            const auto t1 = steady_clock::now();
+            const std::uint64_t c1 = __rdtsc();
+            return double(duration_cast<nanoseconds>(t1 - t0).count()) / double(c1 - c0);
+        }();
+        return ns;
+#else
+        return SteadyStamp::nsPerTick();
+#endif
+    }
+};
@@ -0,0 +1,198 @@
+// ======================================================
+// TimerService.h — one timing-wheel thread instead of one sleeping thread per timer
+// ======================================================
+//
+// std::try_lock.cpp, pucerconsumer.cpp, BinarySemaphore.cpp,
+// Threads/priority.cpp:
+//
+//     std::this_thread::sleep_for(std::chrono::milliseconds(200));
+//     doNextStep();
+//
+// Every pending "do this later" occupies a whole thread (stack,
+// kernel task) that does nothing but sleep.
+//
+// TimerService keeps the pending callbacks in a TimingWheel.h
+// wheel driven by ONE thread and runs each callback, when due,
+// on a ThreadPool:
+//
+//     TimerService timers(pool);
+//     auto id = timers.schedule_after(200ms, [] { doNextStep(); });
+//     timers.cancel(id);                     // O(1), if not fired yet
+//
+//   - schedule / cancel: O(1) (a free-listed record + a list
+//     splice) under one short lock
+//   - a pending timer costs one record plus its callback
+//     (tens of bytes), so a million timers cost memory, not threads
+//   - the driver sleeps until the next due tick; a schedule()
+//     only wakes it when the new timer is the earliest
+//   - resolution: one tick (1 ms by default); callbacks fire at
+//     or after their time, never early
+//
+// Ids are (generation << 32 | slot): a stale id (fired or
+// cancelled, slot reused) is recognised and cancel() returns false.
+//
+// The pool must outlive the service. Destroying the service
+// drops timers that have not fired.
+//
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "ThreadPool.h"
+#include "TimingWheel.h"
+
+class TimerService {
+public:
+    using clock = std::chrono::steady_clock;
+    using Task = ThreadPool::Task;
+    using TimerId = std::uint64_t;                      // 0 is never a valid id
+
+    explicit TimerService(ThreadPool& pool, clock::duration tick = std::chrono::milliseconds(1))
+        : pool_(pool), tick_(tick > clock::duration::zero() ? tick : clock::duration(1)), origin_(clock::now()),
+          driver_([this] { driverLoop(); }) {}
+
+    TimerService(const TimerService&) = delete;
+    TimerService& operator=(const TimerService&) = delete;
+
+    ~TimerService() {
+        {
+            std::lock_guard<std::mutex> lg(m_);
+            stop_ = true;
+        }
+        cv_.notify_one();
+        driver_.join();
+    }
+
+    template <typename Rep, typename Period, typename F>
+    TimerId schedule_after(const std::chrono::duration<Rep, Period>& delay, F&& f) {
+        return schedule_at(clock::now() + std::chrono::ceil<clock::duration>(delay), std::forward<F>(f));
+    }
+
+    template <typename F>
+    TimerId schedule_at(clock::time_point when, F&& f) {
+        Task task([fn = std::forward<F>(f)]() mutable { fn(); });
+        std::uint64_t expiry = tickAt(when);
+        bool wake;
+        TimerId id;
+        {
+            std::lock_guard<std::mutex> lg(m_);
+            std::uint32_t index = allocate();
+            Record& r = records_[index];
+            r.task = std::move(task);
+            r.expiry = expiry;
+            wheel_.add(&r);
+            id = (std::uint64_t(r.generation) << 32) | (index + 1);
+            wake = r.expiry < plannedWake_;
+            if (wake) plannedWake_ = r.expiry;
+        }
+        if (wake) cv_.notify_one();
+        return id;
+    }
+
+    // true: the timer was pending and will not run
+    bool cancel(TimerId id) {
+        std::uint32_t index = static_cast<std::uint32_t>(id & 0xffffffffu) - 1;
+        std::uint32_t generation = static_cast<std::uint32_t>(id >> 32);
+        Task dropped;                                   // destroyed outside the lock
+        {
+            std::lock_guard<std::mutex> lg(m_);
+            if (index >= records_.size()) return false;
+            Record& r = records_[index];
+            if (r.generation != generation || !r.linked()) return false;
+            wheel_.remove(&r);
+            dropped = std::move(r.task);
+            recycle(index);
+        }
+        return true;
+    }
+
+    std::size_t pending() {
+        std::lock_guard<std::mutex> lg(m_);
+        return wheel_.size();
+    }
+
+private:
+    static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+    struct Record : TimerNode {
+        Task task;
+        std::uint32_t generation = 0;
+        std::uint32_t nextFree = kNone;
+        std::uint32_t index = 0;
+    };
+
+    std::uint32_t allocate() {
+        if (freeHead_ != kNone) {
+            std::uint32_t i = freeHead_;
+            freeHead_ = records_[i].nextFree;
+            return i;
+        }
+        records_.emplace_back();                        // deque: existing records never move
+        records_.back().index = static_cast<std::uint32_t>(records_.size() - 1);
+        return records_.back().index;
+    }
+
+    // A new generation makes ids that pointed here stale
+    void recycle(std::uint32_t index) {
+        Record& r = records_[index];
+        ++r.generation;
+        r.nextFree = freeHead_;
+        freeHead_ = index;
+    }
+
+    std::uint64_t ticksNow() const { return static_cast<std::uint64_t>((clock::now() - origin_) / tick_); }
+
+    // First tick at or after t
+    std::uint64_t tickAt(clock::time_point t) const {
+        if (t <= origin_) return 0;
+        auto d = t - origin_;
+        return static_cast<std::uint64_t>((d + tick_ - clock::duration(1)) / tick_);
+    }
+
+    void driverLoop() {
+        std::vector<Task> due;
+        std::unique_lock<std::mutex> lk(m_);
+        while (!stop_) {
+            wheel_.advance(ticksNow(), [&](TimerNode* n) {
+                Record& r = *static_cast<Record*>(n);
+                due.push_back(std::move(r.task));
+                recycle(r.index);
+            });
+            if (!due.empty()) {
+                plannedWake_ = 0;                       // awake: schedule() need not notify
+                lk.unlock();
+                for (Task& t : due) pool_.post(std::move(t));
+                due.clear();
+                lk.lock();
+                continue;
+            }
+            std::optional<std::uint64_t> next = wheel_.nextWake();
+            plannedWake_ = next ? *next : std::numeric_limits<std::uint64_t>::max();
+            if (next) cv_.wait_until(lk, origin_ + tick_ * static_cast<clock::rep>(*next));
+            else cv_.wait(lk);
+        }
+    }
+
+    ThreadPool& pool_;
+    const clock::duration tick_;
+    const clock::time_point origin_;
+
+    std::mutex m_;
+    std::condition_variable cv_;
+    TimingWheel wheel_;
+    std::deque<Record> records_;
+    std::uint32_t freeHead_ = kNone;
+    std::uint64_t plannedWake_ = std::numeric_limits<std::uint64_t>::max();
+    bool stop_ = false;
+
+    std::thread driver_;                                // last: starts after the rest exists
+};
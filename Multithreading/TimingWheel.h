@@ -0,0 +1,140 @@
+// ======================================================
+// TimingWheel.h — hierarchical timing wheel, O(1) add / cancel
+// ======================================================
+//
+// Hashed and hierarchical timing wheel (Varghese & Lauck; the
+// layout of the Linux kernel's classic timer wheel):
+//   - time is counted in TICKS (the owner decides how long one is)
+//   - 4 levels x 64 slots: level 0 holds the next 64 ticks, level
+//     1 the next 64*64, ... (2^24 ticks in total; timers further
+//     out sit in the last slot and are re-placed when it comes up)
+//   - add / remove: splice into / out of a doubly linked slot list
+//   - advance(to, fire): per tick, expire level-0 slot; every 64
+//     ticks, re-place ("cascade") one slot of the level above
+//
+// The wheel allocates nothing: TimerNode lives inside the timer
+// owner (a coroutine frame in EventLoop.h, a pooled record in
+// TimerService.h). Not thread-safe; its owner serialises access.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+// Intrusive: embed (or derive from) it in whatever owns the timer
+struct TimerNode {
+    TimerNode* prev = nullptr;
+    TimerNode* next = nullptr;
+    std::uint64_t expiry = 0;                   // absolute tick
+
+    bool linked() const { return prev != nullptr; }
+};
+
+class TimingWheel {
+public:
+    static constexpr int kBits = 6;
+    static constexpr std::uint64_t kSlots = 1u << kBits;
+    static constexpr std::uint64_t kMask = kSlots - 1;
+    static constexpr int kLevels = 4;
+    static constexpr std::uint64_t kSpan = std::uint64_t(1) << (kBits * kLevels);
+
+    TimingWheel() {
+        for (auto& level : slots_)
+            for (TimerNode& head : level) head.prev = head.next = &head;
+    }
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    std::uint64_t now() const { return now_; }
+    std::size_t size() const { return count_; }
+
+    void add(TimerNode* n) {
+        if (n->expiry <= now_) n->expiry = now_ + 1;          // due: next tick
+        place(n);
+        ++count_;
+    }
+
+    void remove(TimerNode* n) {
+        unlink(n);
+        --count_;
+    }
+
+    // Moves the wheel to tick `to`, calling fire(node) for every
+    // expired timer (already unlinked)
+    template <typename F>
+    void advance(std::uint64_t to, F&& fire) {
+        if (count_ == 0) {
+            if (to > now_) now_ = to;
+            return;
+        }
+        while (now_ < to) {
+            ++now_;
+            if ((now_ & kMask) == 0) {
+                // Level l is due when every lower index wrapped to 0
+                for (int l = 1; l < kLevels; ++l) {
+                    std::uint64_t idx = (now_ >> (kBits * l)) & kMask;
+                    cascade(slots_[l][idx]);
+                    if (idx != 0) break;
+                }
+            }
+            TimerNode& head = slots_[0][now_ & kMask];
+            while (head.next != &head) {
+                TimerNode* n = head.next;
+                unlink(n);
+                --count_;
+                fire(n);
+            }
+            if (count_ == 0) {
+                if (to > now_) now_ = to;
+                return;
+            }
+        }
+    }
+
+    // Tick by which the loop must wake up again (a lower bound on
+    // the next expiry, exact when it is within 64 ticks); nullopt
+    // when there are no timers
+    std::optional<std::uint64_t> nextWake() const {
+        if (count_ == 0) return std::nullopt;
+        for (std::uint64_t i = 1; i < kSlots; ++i) {
+            const TimerNode& head = slots_[0][(now_ + i) & kMask];
+            if (head.next != &head) return now_ + i;
+        }
+        return now_ + kSlots - (now_ & kMask);                 // next cascade
+    }
+
+private:
+    void place(TimerNode* n) {
+        std::uint64_t delta = n->expiry - now_;
+        std::uint64_t at = delta < kSpan ? n->expiry : now_ + kSpan - 1;   // far timers re-cascade
+        int level = 0;
+        while (level + 1 < kLevels && (at - now_) >= (std::uint64_t(1) << (kBits * (level + 1)))) ++level;
+        TimerNode& head = slots_[level][(at >> (kBits * level)) & kMask];
+        n->prev = head.prev;
+        n->next = &head;
+        head.prev->next = n;
+        head.prev = n;
+    }
+
+    static void unlink(TimerNode* n) {
+        n->prev->next = n->next;
+        n->next->prev = n->prev;
+        n->prev = n->next = nullptr;
+    }
+
+    void cascade(TimerNode& head) {
+        TimerNode* n = head.next;
+        head.prev = head.next = &head;
+        while (n != &head) {
+            TimerNode* next = n->next;
+            place(n);
+            n = next;
+        }
+    }
+
+    TimerNode slots_[kLevels][kSlots];
+    std::uint64_t now_ = 0;
+    std::size_t count_ = 0;
+};
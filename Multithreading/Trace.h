@@ -0,0 +1,273 @@
+// ======================================================
+// Trace.h — scoped trace zones in per-thread rings, Chrome-trace export
+// ======================================================
+//
+// The examples show what happened with cout lines — one thread's
+// view, in whatever order the console got them, and the printing
+// itself changes the timing. A TIMELINE shows who ran, who
+// waited and for how long:
+//
+//     void task(const char* name, int n) {
+//         TRACE_THREAD_NAME(name);
+//         TRACE_SCOPE("task");                  // one zone: begin → end
+//         ...
+//     }
+//     trace::exportChromeJson("trace.json");    // chrome://tracing, ui.perfetto.dev
+//
+// - a zone is ONE event {name, begin, end} written when it closes
+//   into the calling thread's own ring: no lock, no RMW, no
+//   allocation after the thread's first event; begin/end are TSC
+//   reads (TickClock.h) — about 10 ns per zone
+// - names must be string literals (kept by pointer)
+// - rings hold the last TRACE_RING_EVENTS events per thread (older
+//   ones are overwritten) and outlive their threads
+// - exportChromeJson() may run while threads are tracing: every
+//   event field is a relaxed atomic, and events overwritten during
+//   the copy are dropped, never torn
+// - TRACE_FILE=path in the environment: written at exit; with
+//   TRACE_PERIOD_MS=n as well, rewritten every n ms (for programs
+//   that never exit — the file holds the latest snapshot)
+//
+// OVERHEAD:
+// - compile with -DTRACE_ENABLED=0 → the macros expand to nothing
+//   (exportChromeJson writes an empty trace)
+// - otherwise trace::setEnabled(false) at runtime: one relaxed
+//   load and a predictable branch per zone
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TickClock.h"
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+#ifndef TRACE_RING_EVENTS
+#define TRACE_RING_EVENTS (1u << 14)                 // per thread, power of two (24 bytes each)
+#endif
+
+namespace trace {
+
+using Clock = TscStamp;
+
+struct Event {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<std::uint64_t> begin{0};
+    std::atomic<std::uint64_t> end{0};               // == begin: an instant
+};
+
+// One per thread; written by that thread only
+struct Ring {
+    static constexpr std::uint32_t kEvents = TRACE_RING_EVENTS;
+    static_assert((kEvents & (kEvents - 1)) == 0, "TRACE_RING_EVENTS must be a power of two");
+
+    std::unique_ptr<Event[]> events{new Event[kEvents]};
+    std::atomic<std::uint64_t> written{0};           // events ever written
+    std::atomic<const char*> threadName{nullptr};
+    std::uint32_t tid = 0;
+
+    void add(const char* name, std::uint64_t begin, std::uint64_t end) {
+        const std::uint64_t n = written.load(std::memory_order_relaxed);
+        Event& e = events[n & (kEvents - 1)];
+        // Orders `written` = n (stored by the previous add) before the
+        // overwrite: an exporter that sees any new field sees written ≥ n
+        std::atomic_thread_fence(std::memory_order_release);
+        e.name.store(name, std::memory_order_relaxed);
+        e.begin.store(begin, std::memory_order_relaxed);
+        e.end.store(end, std::memory_order_relaxed);
+        written.store(n + 1, std::memory_order_release);
+    }
+};
+
+inline std::atomic<bool>& enabledFlag() {
+    static std::atomic<bool> on{true};
+    return on;
+}
+inline void setEnabled(bool on) { enabledFlag().store(on, std::memory_order_relaxed); }
+inline bool enabled() { return enabledFlag().load(std::memory_order_relaxed); }
+
+// Owns every ring; exports at exit when TRACE_FILE is set
+class Registry {
+public:
+    static Registry& instance() {
+        static Registry r;
+        return r;
+    }
+
+    Ring* add() {
+        auto ring = std::make_unique<Ring>();
+        std::lock_guard<std::mutex> lock(m_);
+        ring->tid = std::uint32_t(rings_.size() + 1);
+        rings_.push_back(std::move(ring));
+        return rings_.back().get();
+    }
+
+    // Chrome trace-event JSON ("X" complete events, "i" instants,
+    // "M" thread names); false if the file cannot be written
+    bool exportChromeJson(const std::string& path) {
+        std::vector<Ring*> rings;
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            for (auto& r : rings_) rings.push_back(r.get());
+        }
+        std::string tmp = path + ".tmp";
+        std::FILE* f = std::fopen(tmp.c_str(), "w");
+        if (!f) return false;
+        const double usPerTick = Clock::nsPerTick() / 1000.0;
+        std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", f);
+        bool first = true;
+        auto sep = [&] {
+            if (!first) std::fputs(",\n", f);
+            first = false;
+        };
+        for (Ring* r : rings) {
+            sep();
+            const char* tn = r->threadName.load(std::memory_order_relaxed);
+            std::fprintf(f, "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"", r->tid);
+            if (tn)
+                writeEscaped(f, tn);
+            else
+                std::fprintf(f, "thread %u", r->tid);
+            std::fputs("\"}}", f);
+
+            const std::uint64_t end = r->written.load(std::memory_order_acquire);
+            // The oldest slot may be mid-overwrite: one fewer than the ring holds
+            const std::uint64_t begin = end >= Ring::kEvents ? end - Ring::kEvents + 1 : 0;
+            for (std::uint64_t i = begin; i < end; ++i) {
+                const Event& e = r->events[i & (Ring::kEvents - 1)];
+                const char* name = e.name.load(std::memory_order_relaxed);
+                const std::uint64_t b = e.begin.load(std::memory_order_relaxed);
+                const std::uint64_t d = e.end.load(std::memory_order_relaxed);
+                // Overwritten (or being overwritten) while we copied it:
+                // drop, do not tear (the seqlock read pattern)
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (r->written.load(std::memory_order_relaxed) - i >= Ring::kEvents) continue;
+                if (!name || b < origin_) continue;
+                sep();
+                std::fputs("{\"name\":\"", f);
+                writeEscaped(f, name);
+                const double ts = double(b - origin_) * usPerTick;
+                if (d > b)
+                    std::fprintf(f, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", r->tid, ts,
+                                 double(d - b) * usPerTick);
+                else
+                    std::fprintf(f, "\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", r->tid, ts);
+            }
+        }
+        std::fputs("\n]}\n", f);
+        const bool ok = std::fclose(f) == 0;
+        return ok && std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+    // Events currently held in all rings (for tests and reports)
+    std::uint64_t eventCount() {
+        std::lock_guard<std::mutex> lock(m_);
+        std::uint64_t n = 0;
+        for (auto& r : rings_) n += std::min<std::uint64_t>(r->written.load(), Ring::kEvents);
+        return n;
+    }
+
+private:
+    Registry() : origin_(Clock::now()) {
+        Clock::nsPerTick();                          // calibrate now, not in the first export
+        if (const char* p = std::getenv("TRACE_FILE")) {
+            file_ = p;
+            if (const char* ms = std::getenv("TRACE_PERIOD_MS"); ms && std::atoi(ms) > 0)
+                writer_ = std::thread([this, period = std::chrono::milliseconds(std::atoi(ms))] {
+                    std::unique_lock<std::mutex> lock(stopMutex_);
+                    while (!stopCv_.wait_for(lock, period, [&] { return stop_; })) exportChromeJson(file_);
+                });
+        }
+    }
+
+    ~Registry() {
+        if (writer_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(stopMutex_);
+                stop_ = true;
+            }
+            stopCv_.notify_one();
+            writer_.join();
+        }
+        if (!file_.empty() && !exportChromeJson(file_)) std::fprintf(stderr, "trace: cannot write %s\n", file_.c_str());
+    }
+
+    static void writeEscaped(std::FILE* f, const char* s) {
+        for (; *s; ++s) {
+            const unsigned char c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\')
+                std::fprintf(f, "\\%c", c);
+            else if (c < 0x20)
+                std::fprintf(f, "\\u%04x", c);
+            else
+                std::fputc(c, f);
+        }
+    }
+
+    const std::uint64_t origin_;
+    std::mutex m_;
+    std::vector<std::unique_ptr<Ring>> rings_;
+    std::string file_;
+    std::mutex stopMutex_;
+    std::condition_variable stopCv_;
+    bool stop_ = false;
+    std::thread writer_;
+};
+
+// The calling thread's ring (created on its first event)
+inline Ring& local() {
+    thread_local Ring* ring = Registry::instance().add();
+    return *ring;
+}
+
+class Zone {
+public:
+    explicit Zone(const char* name) : name_(name), begin_(enabled() ? Clock::now() : 0) {}
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+    ~Zone() {
+        if (begin_) local().add(name_, begin_, Clock::now());
+    }
+
+private:
+    const char* name_;
+    std::uint64_t begin_;
+};
+
+inline void instant(const char* name) {
+    if (!enabled()) return;
+    const std::uint64_t t = Clock::now();
+    local().add(name, t, t);
+}
+
+// Shown as the thread's row label (literal or otherwise long-lived)
+inline void nameThread(const char* name) { local().threadName.store(name, std::memory_order_relaxed); }
+
+inline bool exportChromeJson(const std::string& path) { return Registry::instance().exportChromeJson(path); }
+
+}  // namespace trace
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#if TRACE_ENABLED
+#define TRACE_SCOPE(name) ::trace::Zone TRACE_CONCAT(traceZone_, __LINE__)(name)
+#define TRACE_INSTANT(name) ::trace::instant(name)
+#define TRACE_THREAD_NAME(name) ::trace::nameThread(name)
+#else
+#define TRACE_SCOPE(name) ((void)sizeof(name))      // unevaluated: no code, no unused warnings
+#define TRACE_INSTANT(name) ((void)sizeof(name))
+#define TRACE_THREAD_NAME(name) ((void)sizeof(name))
+#endif
@@ -0,0 +1,261 @@
+// ======================================================
+// TracedBuffer.h — bounded producer/consumer buffer with residence-time tracing
+// ======================================================
+//
+// ProducerConsumerproblemUsingThread.cpp:
+//
+//     buffer.push_back(val);                 // producer
+//     int val = buffer.back();               // consumer: the NEWEST item
+//     buffer.pop_back();
+//
+// Nothing says how long an item waited in the buffer, and the
+// consumer pops from the back — LIFO: a burst's first items sit
+// under everything pushed after them, so the average looks fine
+// and the tail (p99, max) is set by whoever got buried.
+//
+// TracedBuffer<T> is the same mutex + condition_variable bounded
+// buffer, plus:
+// - PopOrder::Fifo / PopOrder::Lifo, switchable at runtime
+// - per-item timestamps stored next to the payload
+//   (Stamped<T>), taken at push and compared at pop; the clock is
+//   a template parameter: SteadyStamp or TscStamp (TickClock.h)
+// - tracing on/off per buffer: off skips both clock reads
+// - residence times in a ResidenceHistogram (HDR-style: 32
+//   linear sub-buckets per power of two, every value within 1/32
+//   of its bucket edge), a running WINDOW and a lifetime total
+// - takeWindow(): stats since the last call (the periodic dump),
+//   stats(): since construction; both include depth and peak depth
+// - PeriodicReport: calls a function every interval on its own
+//   thread — e.g. print takeWindow() every second
+//
+//     TracedBuffer<Job> buffer(maxBufferSize, PopOrder::Fifo);
+//     PeriodicReport dump(1s, [&] { std::cout << format(buffer.takeWindow()) << '\n'; });
+//     buffer.push(job);                      // producer
+//     Job j = buffer.pop();                  // consumer
+//
+// Recording happens under the buffer's mutex (the pop holds it
+// anyway): one clock read and one counter increment per item.
+//
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include "TickClock.h"
+
+enum class PopOrder { Fifo, Lifo };
+
+template <typename T>
+struct Stamped {
+    T value;
+    std::uint64_t stamp;                             // Stamp::now() at push, 0 untraced
+};
+
+// ---------------- histogram ----------------
+
+// Nanoseconds, log-linear: values below 32 exact, above that 32
+// sub-buckets per power of two (relative error ≤ 1/32)
+class ResidenceHistogram {
+public:
+    static constexpr int kSubBits = 5;
+    static constexpr int kSub = 1 << kSubBits;
+    static constexpr int kBuckets = (64 - kSubBits + 1) * kSub;
+
+    void record(std::uint64_t ns) {
+        ++counts_[index(ns)];
+        ++total_;
+        max_ = std::max(max_, ns);
+    }
+
+    void reset() { *this = ResidenceHistogram(); }
+
+    std::uint64_t count() const { return total_; }
+    std::uint64_t max() const { return max_; }
+
+    // Upper edge of the bucket holding quantile q (0..1), capped at max
+    double quantile(double q) const {
+        if (total_ == 0) return 0;
+        const std::uint64_t rank = std::max<std::uint64_t>(1, std::uint64_t(q * double(total_) + 0.5));
+        std::uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) return std::min(upperEdge(i), double(max_));
+        }
+        return double(max_);
+    }
+
+private:
+    static int index(std::uint64_t ns) {
+        if (ns < std::uint64_t(kSub)) return int(ns);
+        const int log = std::bit_width(ns) - 1;      // ns in [2^log, 2^(log+1))
+        const int sub = int((ns >> (log - kSubBits)) & (kSub - 1));
+        return (log - kSubBits + 1) * kSub + sub;
+    }
+    static double upperEdge(int i) {
+        if (i < kSub) return double(i);
+        const int log = i / kSub + kSubBits - 1, sub = i % kSub;
+        return double(((std::uint64_t(kSub + sub + 1)) << (log - kSubBits)) - 1);
+    }
+
+    std::uint64_t counts_[kBuckets] = {};
+    std::uint64_t total_ = 0;
+    std::uint64_t max_ = 0;
+};
+
+struct ResidenceStats {
+    std::uint64_t items = 0;                         // popped in the period
+    double p50Ns = 0, p90Ns = 0, p99Ns = 0, p999Ns = 0, maxNs = 0;
+    std::size_t depth = 0;                           // items in the buffer now
+    std::size_t peakDepth = 0;                       // in the period
+};
+
+inline ResidenceStats summarize(const ResidenceHistogram& h, std::size_t depth, std::size_t peakDepth) {
+    ResidenceStats s;
+    s.items = h.count();
+    s.p50Ns = h.quantile(0.50);
+    s.p90Ns = h.quantile(0.90);
+    s.p99Ns = h.quantile(0.99);
+    s.p999Ns = h.quantile(0.999);
+    s.maxNs = double(h.max());
+    s.depth = depth;
+    s.peakDepth = peakDepth;
+    return s;
+}
+
+// One line: "items 1234  residence p50 1.2 µs  p99 ...  depth 3/50"
+inline std::string format(const ResidenceStats& s) {
+    auto us = [](double ns) { return ns / 1000.0; };
+    char line[200];
+    std::snprintf(line, sizeof line,
+                  "items %llu  residence µs p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f  depth %zu (peak %zu)",
+                  (unsigned long long)s.items, us(s.p50Ns), us(s.p90Ns), us(s.p99Ns), us(s.p999Ns), us(s.maxNs),
+                  s.depth, s.peakDepth);
+    return line;
+}
+
+// ---------------- the buffer ----------------
+
+template <typename T, typename Stamp = SteadyStamp>
+class TracedBuffer {
+public:
+    explicit TracedBuffer(std::size_t maxSize, PopOrder order = PopOrder::Fifo, bool tracing = true)
+        : maxSize_(maxSize == 0 ? 1 : maxSize), order_(order), tracing_(tracing), nsPerTick_(Stamp::nsPerTick()) {}
+
+    TracedBuffer(const TracedBuffer&) = delete;
+    TracedBuffer& operator=(const TracedBuffer&) = delete;
+
+    // Blocks while the buffer is full
+    void push(T value) {
+        std::unique_lock<std::mutex> lock(m_);
+        notFull_.wait(lock, [&] { return buffer_.size() < maxSize_; });
+        buffer_.push_back({std::move(value), tracing_ ? Stamp::now() : 0});
+        windowPeak_ = std::max(windowPeak_, buffer_.size());
+        totalPeak_ = std::max(totalPeak_, buffer_.size());
+        lock.unlock();
+        notEmpty_.notify_one();
+    }
+
+    // Blocks while the buffer is empty; front or back by the order
+    T pop() {
+        std::unique_lock<std::mutex> lock(m_);
+        notEmpty_.wait(lock, [&] { return !buffer_.empty(); });
+        Stamped<T> item = order_ == PopOrder::Fifo ? std::move(buffer_.front()) : std::move(buffer_.back());
+        if (order_ == PopOrder::Fifo)
+            buffer_.pop_front();
+        else
+            buffer_.pop_back();
+        if (item.stamp != 0) {
+            const std::uint64_t now = Stamp::now();
+            const std::uint64_t ns = now > item.stamp ? std::uint64_t(double(now - item.stamp) * nsPerTick_) : 0;
+            window_.record(ns);
+            total_.record(ns);
+        }
+        lock.unlock();
+        notFull_.notify_one();
+        return std::move(item.value);
+    }
+
+    void setOrder(PopOrder order) {
+        std::lock_guard<std::mutex> lock(m_);
+        order_ = order;
+    }
+
+    // Items pushed while tracing is off are not recorded
+    void setTracing(bool on) {
+        std::lock_guard<std::mutex> lock(m_);
+        tracing_ = on;
+    }
+
+    // Since the last takeWindow(), then start a new window
+    ResidenceStats takeWindow() {
+        std::lock_guard<std::mutex> lock(m_);
+        ResidenceStats s = summarize(window_, buffer_.size(), windowPeak_);
+        window_.reset();
+        windowPeak_ = buffer_.size();
+        return s;
+    }
+
+    // Since construction
+    ResidenceStats stats() const {
+        std::lock_guard<std::mutex> lock(m_);
+        return summarize(total_, buffer_.size(), totalPeak_);
+    }
+
+    std::size_t maxSize() const { return maxSize_; }
+
+private:
+    const std::size_t maxSize_;
+    PopOrder order_;
+    bool tracing_;
+    const double nsPerTick_;
+
+    mutable std::mutex m_;
+    std::condition_variable notFull_, notEmpty_;
+    std::deque<Stamped<T>> buffer_;
+    ResidenceHistogram window_, total_;
+    std::size_t windowPeak_ = 0, totalPeak_ = 0;
+};
+
+// ---------------- periodic dump ----------------
+
+// Calls report() every `every` on its own thread until destroyed
+class PeriodicReport {
+public:
+    template <typename F>
+    PeriodicReport(std::chrono::milliseconds every, F report)
+        : thread_([this, every, report = std::move(report)]() mutable {
+              std::unique_lock<std::mutex> lock(m_);
+              while (!cv_.wait_for(lock, every, [&] { return stop_; })) {
+                  lock.unlock();
+                  report();
+                  lock.lock();
+              }
+          }) {}
+
+    PeriodicReport(const PeriodicReport&) = delete;
+    PeriodicReport& operator=(const PeriodicReport&) = delete;
+
+    ~PeriodicReport() {
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            stop_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+
+private:
+    std::mutex m_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::thread thread_;                             // last: starts after the members it uses
+};
@@ -0,0 +1,110 @@
+// =====================================================
+// TOPIC: Catching Deadlocks Early with Lock-Order Checking
+// =====================================================
+//
+// A deadlock only HAPPENS when the timing is unlucky, but
+// the BUG (inconsistent lock order) is there every run.
+//
+// OrderedMutex (see LockOrderChecker.h) records the order
+// in which each thread takes locks and reports an inversion
+// the FIRST time it is seen — even if the threads never
+// actually collide.
+//
+// Scenarios:
+// 1. Deadlock.cpp pattern (m1→m2 and m2→m1), run one after
+//    the other so the program never hangs → still reported
+// 2. std::Lock.cpp pattern (std::lock(m1, m2)) → clean
+// 3. Three-lock cycle A→B, B→C, C→A → reported
+// 4. Steady-state cost of lock() after warm-up
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread deadlockDetector.cpp -o lockdep
+//
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include "LockOrderChecker.h"
+
+using namespace std;
+using namespace std::chrono;
+
+OrderedMutex m1("m1");
+OrderedMutex m2("m2");
+
+void thread1() {
+    m1.lock();
+    m2.lock();
+    cout << "Critical Section of Thread 1" << endl;
+    m2.unlock();
+    m1.unlock();
+}
+
+void thread2() {
+    m2.lock();
+    m1.lock();          // ← inversion reported here
+    cout << "Critical Section of Thread 2" << endl;
+    m1.unlock();
+    m2.unlock();
+}
+
+int main() {
+    // 1. Serialized: can never hang, but the bug is caught
+    thread t1(thread1);
+    t1.join();
+    thread t2(thread2);
+    t2.join();
+
+    // 2. std::lock avoids deadlock with try-and-back-off
+    OrderedMutex x("x"), y("y");
+    thread a([&]() { std::lock(x, y); x.unlock(); y.unlock(); });
+    thread b([&]() { std::lock(y, x); y.unlock(); x.unlock(); });
+    a.join();
+    b.join();
+    cout << "std::lock pattern: no new reports expected" << endl;
+
+    // 3. Longer cycle spread over three threads
+    OrderedMutex A("A"), B("B"), C("C");
+    auto ordered = [](OrderedMutex& first, OrderedMutex& second) {
+        scoped_lock<OrderedMutex> l1(first);
+        lock_guard<OrderedMutex> l2(second);
+    };
+    thread(ordered, ref(A), ref(B)).join();
+    thread(ordered, ref(B), ref(C)).join();
+    thread(ordered, ref(C), ref(A)).join();   // ← closes A→B→C→A
+
+    // 4. After warm-up every edge is in the per-thread cache
+    OrderedMutex outer("outer"), inner("inner");
+    const int iters = 1000000;
+    std::mutex p1, p2;
+    auto t0 = steady_clock::now();
+    for (int i = 0; i < iters; ++i) { lock_guard<std::mutex> g1(p1); lock_guard<std::mutex> g2(p2); }
+    double plainNs = duration<double, nano>(steady_clock::now() - t0).count() / iters;
+    t0 = steady_clock::now();
+    for (int i = 0; i < iters; ++i) { lock_guard<OrderedMutex> g1(outer); lock_guard<OrderedMutex> g2(inner); }
+    double checkedNs = duration<double, nano>(steady_clock::now() - t0).count() / iters;
+
+    cout << "cycles reported: " << lockdep::Graph::instance().cyclesReported() << " (expected 2)" << endl;
+    cout << "nested lock pair: std::mutex " << plainNs << " ns, OrderedMutex " << checkedNs
+         << " ns" << endl;
+    return lockdep::Graph::instance().cyclesReported() == 2 ? 0 : 1;
+}
+
+// -----------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// -----------------------------------------------------
+//
+// 1. Deadlock needs: mutual exclusion, hold-and-wait,
+//    no preemption, CIRCULAR WAIT. Lock ordering breaks
+//    the circular wait.
+// 2. A lock-order graph turns "rare hang" into a
+//    deterministic report: any cycle = potential deadlock.
+// 3. try_lock never waits → it cannot be part of a
+//    circular wait, so it adds no edge.
+// 4. Cache verified edges per thread → cheap enough to
+//    leave on in canary builds.
+//
+// ⭐ One-Line Interview Answer
+// “Record every 'holding A, taking B' edge in a graph and
+// flag the first edge that closes a cycle — that is a
+// deadlock waiting to happen.”
@@ -0,0 +1,128 @@
+// ==========================================================
+// TOPIC: Fire-and-Forget Without detach() — A Draining Executor
+// ==========================================================
+//
+// Detach.cpp:
+//
+//     thread t1(run, 5);
+//     t1.detach();
+//     ...                     // main returns → ALL threads stop
+//
+// Two problems:
+// - the work is lost if the process exits first (which is
+//   why Detach.cpp ends its task with sleep_for(5s))
+// - every background task creates and destroys an OS thread
+//
+// DetachedExecutor.h: spawn_detached(run, 5) queues the task on
+// persistent workers; the executor drains its queue when static
+// objects are destroyed, so returning from main() is safe.
+//
+// Measured here:
+// 1. lost work: a child process starts 100 background tasks
+//    (20 ms each) and exits immediately — how many finished?
+//    raw thread::detach vs spawn_detached
+// 2. cost: 20000 tiny fire-and-forget tasks,
+//    thread(...).detach() per task vs spawn_detached
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread detachedExecutor.cpp -o detached
+//
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include "DetachedExecutor.h"
+
+using namespace std;
+using namespace std::chrono;
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+// Detach.cpp's run(), counting instead of printing
+void run(atomic<int>* done, int count) {
+    while (count-- > 0) this_thread::sleep_for(milliseconds(4));
+    done->fetch_add(1);
+}
+
+// Child process: start `tasks` background tasks, then exit() at once
+// (exit runs static destructors, like returning from main)
+template <typename Start>
+int finishedAfterExit(int tasks, Start start) {
+    auto* done = static_cast<atomic<int>*>(
+        mmap(nullptr, sizeof(atomic<int>), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    new (done) atomic<int>(0);
+    if (pid_t k = fork(); k == 0) {
+        for (int i = 0; i < tasks; ++i) start(done);
+        exit(0);
+    } else {
+        waitpid(k, nullptr, 0);
+    }
+    int n = done->load();
+    munmap(done, sizeof(atomic<int>));
+    return n;
+}
+
+int main() {
+    // ---- 1. Does the work survive main() returning? ----
+    constexpr int kTasks = 100;
+    int rawDone = finishedAfterExit(kTasks, [](atomic<int>* d) { thread(run, d, 5).detach(); });
+    int execDone = finishedAfterExit(kTasks, [](atomic<int>* d) { spawn_detached(run, d, 5); });
+    cout << "tasks finished when the process exits right after starting " << kTasks << ":" << endl;
+    cout << "  thread::detach:  " << rawDone << endl;
+    cout << "  spawn_detached:  " << execDone << "   (executor drained its queue at exit)" << endl;
+
+    // ---- 2. Per-task cost ----
+    constexpr int kTiny = 20000;
+    atomic<long long> sum{0};
+    auto tiny = [&](int i) { sum.fetch_add(i, memory_order_relaxed); };
+
+    double detachMs = timeMs([&] {
+        for (int i = 0; i < kTiny; ++i) thread(tiny, i).detach();
+        while (sum.load() != static_cast<long long>(kTiny) * (kTiny - 1) / 2) this_thread::yield();
+    });
+    sum = 0;
+    DetachedExecutor exec(thread::hardware_concurrency(), 256);
+    double execMs = timeMs([&] {
+        for (int i = 0; i < kTiny; ++i) exec.spawn_detached(tiny, i);
+        exec.drain();
+    });
+    bool exact = sum.load() == static_cast<long long>(kTiny) * (kTiny - 1) / 2;
+    exec.spawn_detached([] { throw runtime_error("lost?"); });
+    exec.drain();
+
+    cout << kTiny << " tiny fire-and-forget tasks:" << endl;
+    cout << "  thread(...).detach(): " << detachMs << " ms" << endl;
+    cout << "  spawn_detached:       " << execMs << " ms (" << exec.size() << " workers, queue bound "
+         << exec.capacity() << ", sum " << (exact ? "exact" : "WRONG") << ")" << endl;
+    cout << "  throwing task counted: " << exec.failedTasks() << endl;
+    return execDone == kTasks && exact && exec.failedTasks() == 1 ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. detach() gives up the only handle to a thread: nobody can
+//    wait for it, and process exit kills it mid-task.
+// 2. A thread per fire-and-forget task costs a creation and a
+//    teardown each time; a persistent worker set pays it once.
+// 3. Bound the queue so producers get back-pressure instead of
+//    unbounded memory growth.
+// 4. Owning the workers lets shutdown DRAIN: stop accepting,
+//    finish the queue, join — no teardown race.
+//
+// ⭐ One-Line Interview Answer
+// “Don't detach threads for background work — submit it to an
+// executor that owns its workers, bounds its queue and drains
+// on shutdown, so tasks are cheap and never silently lost.”
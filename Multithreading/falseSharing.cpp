@@ -0,0 +1,243 @@
+// ======================================================
+// TOPIC: False Sharing Between Independently Locked Globals
+// ======================================================
+//
+// std::try_lock.cpp:
+//
+//     int X = 0;
+//     int Y = 0;
+//     std::mutex m1, m2;        // t1: m1 + X,  t2: m2 + Y
+//
+// ❌ t1 and t2 share no data, but X, Y and part of m1 sit on ONE
+//    64-byte line: each ++X / m1.lock() invalidates t2's copy of
+//    the line and each ++Y / m2.lock() invalidates t1's
+// ❌ nothing in the source shows it — the linker picked the layout
+//
+// ✅ FalseSharingDetector.h: watch the globals, count accesses per
+//    thread (FS_WRITE / FS_READ), report the lines where one
+//    thread's writes meet another thread's accesses
+// ✅ CachePadded.h: line_guarded<int> keeps X WITH m1 on one line
+//    and away from Y / m2; alignas(cache_line_size) on the plain
+//    globals does the same without changing their use
+//
+// Measured here (ns per increment, two threads):
+//   1. X, Y, m1, m2 adjacent            (the original layout)
+//   2. line_guarded<int> x, y          (value + own mutex per line)
+//   3. adjacent atomic<int> counters   (no mutex: worst case)
+//   4. cache_padded<atomic<int>> counters
+//
+// False sharing needs two cores: with a single CPU the threads
+// take turns and rows 1/2 and 3/4 differ by noise only.
+//
+// -DFALSE_SHARING_DETECT is the instrumented build: without it
+// FS_WRITE is empty and section 1 reports no accesses.
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread -DFALSE_SHARING_DETECT falseSharing.cpp -o falsesharing
+//
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "CachePadded.h"
+#include "FalseSharingDetector.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// The original globals, as std::try_lock.cpp declares them
+int X = 0;
+int Y = 0;
+std::mutex m1, m2;
+
+// The fixed layout
+line_guarded<int> x, y;
+
+static_assert(alignof(cache_padded<int>) == cache_line_size && sizeof(cache_padded<int>) == cache_line_size);
+static_assert(sizeof(cache_padded<char[100]>) == 2 * cache_line_size);
+static_assert(sizeof(line_guarded<int>) % cache_line_size == 0);
+static_assert(alignof(cache_padded<int, 2 * cache_line_size>) == 2 * cache_line_size);
+
+const int detectIterations = 20000;
+const int benchIterations = 2000000;
+
+bool sameLine(const void* a, size_t aSize, const void* b, size_t bSize) {
+    const uintptr_t pa = reinterpret_cast<uintptr_t>(a), pb = reinterpret_cast<uintptr_t>(b);
+    return pa / cache_line_size <= (pb + bSize - 1) / cache_line_size &&
+           pb / cache_line_size <= (pa + aSize - 1) / cache_line_size;
+}
+
+void incrementXY(int& XorY, std::mutex& m) {
+    for (int i = 0; i < detectIterations; ++i) {
+        FS_WRITE(m);
+        m.lock();
+        FS_WRITE(XorY);
+        ++XorY;
+        FS_WRITE(m);
+        m.unlock();
+    }
+}
+
+void incrementGuarded(line_guarded<int>& g) {
+    for (int i = 0; i < detectIterations; ++i) {
+        FS_WRITE(g.mutex);
+        lock_guard<std::mutex> lock(g.mutex);
+        FS_WRITE(g.value);
+        ++g.value;
+    }
+}
+
+// work(0) and work(1) on two threads; ns per increment
+template <typename Work>
+double timePair(Work work) {
+    auto t0 = steady_clock::now();
+    thread t1(work, 0), t2(work, 1);
+    t1.join();
+    t2.join();
+    return duration<double, nano>(steady_clock::now() - t0).count() / (2.0 * benchIterations);
+}
+
+struct Adjacent {                                    // the original: both pairs on one or two lines
+    std::mutex m1, m2;
+    int X = 0, Y = 0;
+};
+
+int main() {
+    bool ok = true;
+    auto& fs = FalseSharingDetector::global();
+
+    // --------------------------------------------------
+    // 1. Detection: the original globals vs line_guarded
+    // --------------------------------------------------
+    fs.watch("X", X);
+    fs.watch("Y", Y);
+    fs.watch("m1", m1);
+    fs.watch("m2", m2);
+    fs.watch("x.value", x.value);
+    fs.watch("x.mutex", x.mutex);
+    fs.watch("y.value", y.value);
+    fs.watch("y.mutex", y.mutex);
+
+    {
+        thread t1(incrementXY, ref(X), ref(m1));
+        thread t2(incrementXY, ref(Y), ref(m2));
+        thread t3(incrementGuarded, ref(x));
+        thread t4(incrementGuarded, ref(y));
+        t1.join();
+        t2.join();
+        t3.join();
+        t4.join();
+    }
+    ok = ok && X == detectIterations && Y == detectIterations && x.value == detectIterations && y.value == detectIterations;
+
+    cout << "cache line: " << cache_line_size << " B" << endl;
+    cout << "watched variables sharing a line:" << endl;
+    fs.report(cout);
+
+#ifdef FALSE_SHARING_DETECT
+    // X is flagged exactly when the linker put it on a line with
+    // t2's data (Y or m2); the guarded pairs never are
+    const bool xExposed = sameLine(&X, sizeof X, &Y, sizeof Y) || sameLine(&X, sizeof X, &m2, sizeof m2) ||
+                          sameLine(&m1, sizeof m1, &Y, sizeof Y) || sameLine(&m1, sizeof m1, &m2, sizeof m2);
+    cout << "X/m1 " << (xExposed ? "share" : "do not share") << " a line with Y/m2 in this binary" << endl;
+    ok = ok && fs.falselyShared("X") == (sameLine(&X, sizeof X, &Y, sizeof Y) || sameLine(&X, sizeof X, &m2, sizeof m2));
+    ok = ok && (fs.falselyShared("X") || fs.falselyShared("m1")) == xExposed;
+    ok = ok && !fs.falselyShared("x.value") && !fs.falselyShared("x.mutex");
+    ok = ok && !fs.falselyShared("y.value") && !fs.falselyShared("y.mutex");
+    // x's value and mutex do share their line — with each other, used by one thread
+    ok = ok && sameLine(&x.value, sizeof x.value, &x.mutex, sizeof x.mutex);
+    ok = ok && !sameLine(&x, sizeof x, &y, sizeof y);
+#else
+    cout << "(built without -DFALSE_SHARING_DETECT: no accesses counted)" << endl;
+#endif
+
+    // The detector itself: one writer per variable, both on one line
+    {
+        FalseSharingDetector d;
+        struct alignas(cache_line_size) { int a = 0, b = 0; } pair;
+        cache_padded<int> pa, pb;
+        d.watch("a", pair.a);
+        d.watch("b", pair.b);
+        d.watch("pa", pa);
+        d.watch("pb", pb);
+        thread ta([&] { d.noteWrite(&pair.a); d.noteWrite(&pa); });
+        ta.join();
+        thread tb([&] { d.noteWrite(&pair.b); d.noteWrite(&pb.value); });
+        tb.join();
+        ok = ok && d.falselyShared("a") && d.falselyShared("b") && !d.falselyShared("pa") && !d.falselyShared("pb");
+        ok = ok && d.sharedLines().size() == 1 && d.sharedLines()[0].variables.size() == 2;
+        d.reset();
+        ok = ok && !d.falselyShared("a");            // counts gone: the line is "cold"
+        ostringstream text;
+        d.report(text);
+        ok = ok && text.str().find("cold") != string::npos;
+    }
+
+    // --------------------------------------------------
+    // 2. Cost: adjacent vs one line per thread
+    // --------------------------------------------------
+    Adjacent adjacent;
+    line_guarded<int> guarded[2];
+    alignas(8) atomic<int> plain[2] = {0, 0};          // always one line
+    cache_padded<atomic<int>> padded[2];
+    ok = ok && !sameLine(&guarded[0], sizeof guarded[0], &guarded[1], sizeof guarded[1]);
+    ok = ok && sameLine(&plain[0], sizeof plain[0], &plain[1], sizeof plain[1]);
+
+    const double adjacentNs = timePair([&](int t) {
+        std::mutex& m = t ? adjacent.m2 : adjacent.m1;
+        int& v = t ? adjacent.Y : adjacent.X;
+        for (int i = 0; i < benchIterations; ++i) {
+            lock_guard<std::mutex> lock(m);
+            ++v;
+        }
+    });
+    const double guardedNs = timePair([&](int t) {
+        for (int i = 0; i < benchIterations; ++i) {
+            lock_guard<std::mutex> lock(guarded[t].mutex);
+            ++guarded[t].value;
+        }
+    });
+    const double plainNs = timePair([&](int t) {
+        for (int i = 0; i < benchIterations; ++i) plain[t].fetch_add(1, memory_order_relaxed);
+    });
+    const double paddedNs = timePair([&](int t) {
+        for (int i = 0; i < benchIterations; ++i) padded[t]->fetch_add(1, memory_order_relaxed);
+    });
+    ok = ok && adjacent.X == benchIterations && adjacent.Y == benchIterations;
+    ok = ok && guarded[0].value == benchIterations && guarded[1].value == benchIterations;
+    ok = ok && plain[0] == benchIterations && plain[1] == benchIterations;
+    ok = ok && *padded[0] == benchIterations && *padded[1] == benchIterations;
+
+    cout << endl << "ns per increment, 2 threads (" << thread::hardware_concurrency() << " CPUs):" << endl;
+    cout << "  1. X, Y, m1, m2 adjacent       " << adjacentNs << endl;
+    cout << "  2. line_guarded<int> x, y      " << guardedNs << "   (" << adjacentNs / guardedNs << "x)" << endl;
+    cout << "  3. adjacent atomic<int>        " << plainNs << endl;
+    cout << "  4. cache_padded<atomic<int>>   " << paddedNs << "   (" << plainNs / paddedNs << "x)" << endl;
+    if (thread::hardware_concurrency() < 2) cout << "  (one CPU: no second cache to bounce the line to)" << endl;
+
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. Caches keep coherence per LINE (64 B on x86-64), not per
+//    variable: two threads writing neighbours fight over one line.
+// 2. Globals, struct members and array elements are packed back
+//    to back — independent data under independent mutexes is the
+//    classic victim.
+// 3. Fix with alignas(std::hardware_destructive_interference_size)
+//    or a padded wrapper; keep a value and ITS mutex together.
+// 4. Find it with perf c2c (HITM loads) or per-thread access
+//    counts per line — the source alone does not show it.
+//
+// ⭐ One-Line Interview Answer
+// “False sharing is two threads writing different variables on the
+// same cache line; give each thread's hot data its own line with
+// alignas(hardware_destructive_interference_size).”
@@ -0,0 +1,106 @@
+#!/usr/bin/env bash
+# ==========================================================
+# falseSharingReport.sh — globals that share a cache line
+# ==========================================================
+#
+# Two ways to find false sharing without touching the source
+# (FalseSharingDetector.h is the instrumented way):
+#
+#   static   every global of a program from its symbol table
+#            (nm: address + size), grouped by cache line; lines
+#            holding two or more of them are listed. Whether they
+#            HURT depends on which threads write them — for
+#            X / Y behind m1 / m2 (std::try_lock.cpp) they do.
+#   --perf   perf c2c: samples loads that hit a line Modified in
+#            another core's cache (HITM) and lists the hottest
+#            such lines with their symbols and offsets. Needs a
+#            PMU (not in most VMs / containers); without one the
+#            static listing is printed instead.
+#
+# Usage (from this directory):
+#   ./falseSharingReport.sh                       # the four original demos
+#   ./falseSharingReport.sh Mutex.cpp ./a.out     # sources (built here) or binaries
+#   ./falseSharingReport.sh --perf ./prog args... # HITM sampling of one run
+#   LINE=128 ./falseSharingReport.sh ...          # adjacent-line prefetch pairs
+#
+set -u
+
+CXX=${CXX:-g++}
+LINE=${LINE:-64}
+here=$(cd "$(dirname "$0")" && pwd)
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+# Program globals (data / bss) of binary $1: "address size name",
+# runtime and library symbols left out
+globals() {
+    nm -S -C -t d --defined-only "$1" 2>/dev/null |
+        awk 'NF >= 4 && $3 ~ /^[bBdD]$/ {
+                 name = $4; for (i = 5; i <= NF; ++i) name = name " " $i
+                 if (name ~ /@/ || name ~ /^_/ || name ~ /^completed\./ || name ~ /^std::/) next
+                 print $1 + 0, $2 + 0, name
+             }' | sort -n
+}
+
+# Lines of $LINE bytes holding two or more globals
+static_report() {
+    local bin=$1 label=$2
+    echo "-- $label"
+    globals "$bin" | awk -v L="$LINE" '
+        {
+            addr = $1; size = $2; name = $3; for (i = 4; i <= NF; ++i) name = name " " $i
+            first = int(addr / L); last = int((addr + (size > 0 ? size : 1) - 1) / L)
+            for (l = first; l <= last; ++l) {
+                if (!(l in count)) order[++n] = l
+                at = addr < l * L ? "..." : sprintf("+%d", addr - l * L)     # "...": starts on an earlier line
+                entry[l] = entry[l] sprintf("      %-4s %-20s %5d B\n", at, name, size)
+                ++count[l]
+            }
+        }
+        END {
+            shared = 0
+            for (k = 1; k <= n; ++k) {
+                l = order[k]
+                if (count[l] < 2) continue
+                printf "   line 0x%x: %d globals\n%s", l * L, count[l], entry[l]
+                ++shared
+            }
+            if (!shared) print "   no line holds two program globals"
+        }'
+}
+
+target_binary() {
+    local src=$1 bin
+    case $src in
+        *.cpp)
+            bin=$tmp/$(basename "$src" .cpp | tr -c 'A-Za-z0-9_\n' _)
+            (cd "$(dirname "$src")" && "$CXX" -std=c++20 -O2 -pthread "$(basename "$src")" -o "$bin") 2> "$bin.log" ||
+                { echo "-- $src: does not build (see the compiler output below)" >&2; cat "$bin.log" >&2; return 1; }
+            echo "$bin" ;;
+        *) echo "$src" ;;
+    esac
+}
+
+if [ "${1:-}" = --perf ]; then
+    shift
+    [ $# -gt 0 ] || { echo "usage: $0 --perf ./prog [args...]" >&2; exit 2; }
+    echo "== perf c2c, cache line $LINE B"
+    if command -v perf > /dev/null && perf c2c record -o "$tmp/c2c.data" -- "$@" > "$tmp/run.log" 2> "$tmp/perf.log"; then
+        perf c2c report -i "$tmp/c2c.data" --stdio --full-symbols 2> /dev/null |
+            sed -n '/Shared Data Cache Line Table/,/^$/p; /Shared Cache Line Distribution Pareto/,/^$/p' | head -80
+    else
+        echo "   perf c2c unavailable here ($(head -1 "$tmp/perf.log" 2> /dev/null || echo 'no perf')); static listing:"
+    fi
+    static_report "$1" "$1 (globals by cache line)"
+    exit 0
+fi
+
+if [ $# -eq 0 ]; then
+    set -- "$here/std::try_lock.cpp" "$here/Mutex.cpp" "$here/MutextryLock.cpp" "$here/threadSync.cpp"
+fi
+
+echo "== globals sharing a $LINE-byte line"
+for f in "$@"; do
+    bin=$(target_binary "$f") || continue
+    static_report "$bin" "$(basename "$f")"
+done
@@ -0,0 +1,124 @@
+// ==========================================================
+// TOPIC: try_lock Without Lost Increments — Flat Combining
+// ==========================================================
+//
+// MutextryLock.cpp increments only when try_lock() succeeds:
+//
+//     if (mtx.try_lock()) { ++counter; mtx.unlock(); }
+//
+// so every collision silently drops an increment.
+//
+// FlatCombiningCounter.h: a thread that fails try_lock leaves
+// its increment in its own slot; the lock holder adds all
+// pending slots before unlocking.
+//
+// Measured here: T threads x 1000000 increments (T = 2, 4, 8):
+// - try_lock only (the original; increments lost)
+// - lock() per increment
+// - std::atomic<long>::fetch_add
+// - FlatCombiningCounter::add
+// ns per increment, final value, and how many increments were
+// combined for another thread.
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread flatCombiningCounter.cpp -o flatcombining
+//
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FlatCombiningCounter.h"
+
+using namespace std;
+using namespace std::chrono;
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+constexpr int kPerThread = 1'000'000;
+
+template <typename Body>
+double runThreads(int threads, Body body) {
+    return timeMs([&] {
+        vector<thread> ts;
+        for (int t = 0; t < threads; ++t)
+            ts.emplace_back([&] {
+                for (int i = 0; i < kPerThread; ++i) body();
+            });
+        for (auto& th : ts) th.join();
+    });
+}
+
+void row(const string& name, double ms, int threads, long value) {
+    long expected = long(threads) * kPerThread;
+    cout << "  " << left << setw(24) << name << right << fixed << setprecision(1) << setw(7)
+         << ms * 1e6 / expected << " ns/inc   value " << setw(9) << value;
+    if (value != expected) cout << "  (" << expected - value << " lost)";
+    cout << endl;
+}
+
+int main() {
+    bool ok = true;
+    cout << thread::hardware_concurrency() << " hardware threads" << endl;
+    for (int threads : {2, 4, 8}) {
+        cout << threads << " threads x " << kPerThread << " increments:" << endl;
+
+        std::mutex mtx;
+        long counter = 0;
+        double ms = runThreads(threads, [&] {
+            if (mtx.try_lock()) {
+                ++counter;
+                mtx.unlock();
+            }
+        });
+        row("try_lock only", ms, threads, counter);
+
+        counter = 0;
+        ms = runThreads(threads, [&] {
+            lock_guard<std::mutex> lg(mtx);
+            ++counter;
+        });
+        row("lock()", ms, threads, counter);
+
+        atomic<long> atomicCounter{0};
+        ms = runThreads(threads, [&] { atomicCounter.fetch_add(1, memory_order_relaxed); });
+        row("atomic fetch_add", ms, threads, atomicCounter.load());
+
+        FlatCombiningCounter<long> fc;
+        ms = runThreads(threads, [&] { fc.add(1); });
+        long v = fc.value();
+        row("FlatCombiningCounter", ms, threads, v);
+        auto s = fc.stats();
+        cout << "      " << s.published << " increments published for combining, " << s.passes
+             << " combining passes" << endl;
+        ok = ok && v == long(threads) * kPerThread;
+    }
+    cout << "FlatCombiningCounter lost nothing: " << (ok ? "yes" : "NO") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. try_lock() alone turns contention into lost updates.
+// 2. lock() is correct but makes every colliding thread wait
+//    (and possibly sleep) for the holder.
+// 3. Flat combining: losers publish their operation, the lock
+//    holder applies all published operations in one pass.
+// 4. The lock's cache line moves once per pass instead of once
+//    per operation; losers only touch their own slot.
+//
+// ⭐ One-Line Interview Answer
+// “Instead of dropping or waiting, a thread that fails try_lock
+// publishes its increment in its own slot and the lock holder
+// combines all pending increments before unlocking — nothing is
+// lost and nobody blocks.”
@@ -0,0 +1,178 @@
+// =====================================================
+// TOPIC: Launching a Functor Over N Indices — Threads vs Workers
+// =====================================================
+//
+// createThread.cpp:
+//
+//     class Base { public: void operator()(int x) { ... } };
+//     std::thread t(Base(), 10);
+//     t.join();
+//
+// Doing that for i = 0..N-1 means N thread creations, each
+// copying Base and its argument into a heap-allocated,
+// type-erased state.
+//
+// ✅ ParallelForEach.h: persistent workers, and the functor
+//    TYPE goes all the way to the worker loop (trampoline<F>),
+//    so Base::operator() inlines there — no std::function, no
+//    heap per launch
+//
+// Measured here:
+//   A. 256 calls of Base(i) (a find_odd slice each):
+//        1. std::thread(Base(out), i) per index, then join all
+//        2. parallel_for_each_functor(0, 256, Base(out))
+//   B. 2^20 calls of a one-line functor:
+//        3. FunctorWorkers::for_each with the functor itself
+//        4. the same, through std::function<void(long)>
+//           (one indirect call per index, nothing inlined)
+// and operator new calls per launch.
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread functorLauncher.cpp -o functorlauncher
+//
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../Benchmarks/MicroBench.h"
+#include "ParallelForEach.h"
+
+using namespace std;
+typedef long int ull;
+
+static atomic<uint64_t> newCalls{0};
+
+void* operator new(size_t n) {
+    newCalls.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+// GCC pairs the inlined free() with `new` and warns; they match here
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+#pragma GCC diagnostic pop
+
+// createThread.cpp's functor, with a result slot instead of cout
+class Base {
+public:
+    explicit Base(ull* out) : out_(out) {}
+    void operator()(long x) {
+        ull oddSum = 0;
+        for (ull i = x * 1000; i < (x + 1) * 1000; ++i)
+            if (i % 2 != 0) oddSum += i;
+        out_[x] = oddSum;
+    }
+
+private:
+    ull* out_;
+};
+
+// Small enough that call overhead is the whole cost
+struct Scale {
+    ull* out;
+    void operator()(long i) const { out[i] = i * 3 + 1; }
+};
+
+int main() {
+    constexpr long kCalls = 256;
+    constexpr long kSmall = 1 << 20;
+    vector<ull> out(kCalls), small(kSmall);
+    FunctorWorkers workers;
+
+    bool ok = true;
+    parallel_for_each_functor(0, kCalls, Base(out.data()));
+    for (long x = 0; x < kCalls; ++x) ok = ok && out[x] == 1000 * (1000 * x + 500) / 2;   // 500 odds, mean 1000x+500
+    workers.for_each(0, kSmall, Scale{small.data()});
+    ok = ok && small[12345] == 12345 * 3 + 1 && small[kSmall - 1] == (kSmall - 1) * 3 + 1;
+    try {
+        workers.for_each(0, 1000, [](long i) {
+            if (i == 500) throw runtime_error("index 500");
+        });
+        ok = false;
+    } catch (const runtime_error&) {
+    }
+
+    uint64_t n0 = newCalls.load();
+    parallel_for_each_functor(0, kCalls, Base(out.data()));
+    workers.for_each(0, kSmall, Scale{small.data()});
+    uint64_t launcherNews = newCalls.load() - n0;
+
+    n0 = newCalls.load();
+    {
+        vector<thread> threads;
+        threads.reserve(kCalls);
+        for (long i = 0; i < kCalls; ++i) threads.emplace_back(Base(out.data()), i);
+        for (auto& t : threads) t.join();
+    }
+    double threadNews = double(newCalls.load() - n0) / kCalls;
+
+    BenchOptions opts;
+    opts.samples = 9;
+    MicroBench batch("256 x Base(i), one launch per iteration", opts);
+    batch
+        .add("std::thread(Base(out), i) x 256",
+             [&](uint64_t n) {
+                 vector<thread> threads;
+                 threads.reserve(kCalls);
+                 for (uint64_t r = 0; r < n; ++r) {
+                     for (long i = 0; i < kCalls; ++i) threads.emplace_back(Base(out.data()), i);
+                     for (auto& t : threads) t.join();
+                     threads.clear();
+                 }
+             })
+        .add("parallel_for_each_functor", [&](uint64_t n) {
+            for (uint64_t r = 0; r < n; ++r) parallel_for_each_functor(0, kCalls, Base(out.data()));
+            clobberMemory();
+        });
+    auto rb = batch.run();
+
+    function<void(long)> erased = Scale{small.data()};
+    MicroBench calls("2^20 x one-line functor, one launch per iteration", opts);
+    calls
+        .add("for_each(Scale) — inlined",
+             [&](uint64_t n) {
+                 for (uint64_t r = 0; r < n; ++r) workers.for_each(0, kSmall, Scale{small.data()});
+                 clobberMemory();
+             })
+        .add("for_each(std::function)", [&](uint64_t n) {
+            for (uint64_t r = 0; r < n; ++r) workers.for_each(0, kSmall, erased);
+            clobberMemory();
+        });
+    auto rc = calls.run();
+
+    cout << workers.size() << " participants; operator new: std::thread " << threadNews
+         << " per thread, launcher " << launcherNews << " for two launches" << endl;
+    cout << "per index: std::thread " << rb[0].medianNs / kCalls << " ns, launcher " << rb[1].medianNs / kCalls
+         << " ns; inlined " << rc[0].medianNs / kSmall << " ns, std::function " << rc[1].medianNs / kSmall << " ns"
+         << endl;
+
+    ok = ok && launcherNews == 0;
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. std::thread type-erases and heap-copies its callable, and
+//    creating the OS thread costs far more than a short task.
+// 2. Persistent workers pay thread creation once; a launch is
+//    a wake-up and a shared index counter.
+// 3. Passing the functor as a template parameter keeps its type,
+//    so operator() inlines into the loop; std::function costs one
+//    indirect, non-inlinable call per element.
+// 4. Claiming indices in chunks (one fetch_add per grain) keeps
+//    the shared counter off the hot path.
+//
+// ⭐ One-Line Interview Answer
+// “Create the threads once and hand them the functor as a
+// template parameter — its operator() inlines into the worker
+// loop instead of going through a type-erased thread state.”
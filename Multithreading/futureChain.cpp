@@ -0,0 +1,201 @@
+// =====================================================
+// TOPIC: Fan-Out / Fan-In Without Parking on get()
+// =====================================================
+//
+// std::futureAndPromise.cpp, scaled to a pipeline:
+//
+//     for each of N chunks:
+//         std::promise<ull> p;  futures.push_back(p.get_future());
+//         pool.post(findOdd(std::move(p), a, b));
+//     for (auto& f : futures) total += f.get();        // N blocking waits
+//
+// ❌ the consuming thread parks on a get() per task
+// ❌ nothing can run "when it is done" except a thread that waits
+//
+// ✅ ContinuationFuture.h:
+//
+//     futures.push_back(p.get_future().then([](ull s) { return s; }));
+//     auto total = when_all(std::move(futures))
+//                      .then(pool, [](vector<ull> v) { return accumulate(...); });
+//     std::move(total).get();                          // ONE wait, or none
+//
+// Measured here: 10^5 findOdd tasks on a ThreadPool, fanned in
+//   1. std::promise + get() per task
+//   2. Promise + then + when_all + then(pool), one get()
+// reporting time, get() calls that had to block, and operator
+// new calls per task (counted by replacing operator new in this
+// file; both include ThreadPool::post's own Task allocation).
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread futureChain.cpp -o futurechain
+//
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ContinuationFuture.h"
+#include "ThreadPool.h"
+
+using namespace std;
+using namespace std::chrono;
+typedef long int ull;
+
+static atomic<uint64_t> newCalls{0};
+
+void* operator new(size_t n) {
+    newCalls.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// std::futureAndPromise.cpp's loop, returning instead of set_value
+ull findOdd(ull start, ull end) {
+    ull oddSum = 0;
+    for (ull i = start; i <= end; ++i)
+        if (i & 1) oddSum += i;
+    return oddSum;
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+// then / when_any / errors / broken_promise / pool hops
+bool semanticsHold(ThreadPool& pool) {
+    bool ok = true;
+
+    Promise<int> p;
+    Future<string> chained = p.get_future().then([](int v) { return v * 2; }).then([](int v) { return to_string(v); });
+    p.set_value(21);                                        // runs both steps here, inline
+    ok = ok && chained.is_ready() && std::move(chained).get() == "42";
+
+    // Already fulfilled: then() runs the step immediately
+    ok = ok && make_ready_future(5).then([](int v) { return v + 1; }).get() == 6;
+
+    Promise<int> err;
+    Future<int> failing = err.get_future().then([](int) -> int { throw runtime_error("step"); }).then([](int v) {
+        return v + 1;                                       // skipped
+    });
+    err.set_value(1);
+    try {
+        std::move(failing).get();
+        ok = false;
+    } catch (const runtime_error& e) {
+        ok = ok && string(e.what()) == "step";
+    }
+
+    Future<int> orphan;
+    {
+        Promise<int> dropped;
+        orphan = dropped.get_future();
+    }
+    try {
+        std::move(orphan).get();
+        ok = false;
+    } catch (const future_error& e) {
+        ok = ok && e.code() == future_errc::broken_promise;
+    }
+
+    vector<Promise<int>> racers(3);
+    vector<Future<int>> entrants;
+    for (auto& r : racers) entrants.push_back(r.get_future());
+    auto first = when_any(std::move(entrants));
+    racers[2].set_value(7);
+    racers[0].set_value(1);
+    racers[1].set_value(2);
+    auto [index, value] = std::move(first).get();
+    ok = ok && index == 2 && value == 7;
+
+    Promise<int> hop;
+    auto onPool = hop.get_future().then(pool, [](int v) { return v * 10; }).then(pool, [](int v) { return v + 1; });
+    hop.set_value(4);
+    ok = ok && std::move(onPool).get() == 41;
+    return ok;
+}
+
+int main() {
+    constexpr int kTasks = 100'000;
+    constexpr ull kChunk = 2'000;
+    ThreadPool pool;
+
+    bool ok = semanticsHold(pool);
+
+    // ---- 1. std::promise, get() per future ----
+    ull stdSum = 0;
+    int stdBlocked = 0;
+    uint64_t n0 = newCalls.load();
+    double stdMs = timeMs([&] {
+        vector<future<ull>> futures;
+        futures.reserve(kTasks);
+        for (int i = 0; i < kTasks; ++i) {
+            promise<ull> p;
+            futures.push_back(p.get_future());
+            pool.post([p = std::move(p), i]() mutable { p.set_value(findOdd(i * kChunk, (i + 1) * kChunk - 1)); });
+        }
+        for (auto& f : futures) {
+            if (f.wait_for(seconds(0)) != future_status::ready) ++stdBlocked;
+            stdSum += f.get();
+        }
+    });
+    double stdAllocs = double(newCalls.load() - n0) / kTasks;
+
+    // ---- 2. continuations, one get() ----
+    ull chainSum = 0;
+    int chainBlocked = 0;
+    n0 = newCalls.load();
+    double chainMs = timeMs([&] {
+        vector<Future<ull>> futures;
+        futures.reserve(kTasks);
+        for (int i = 0; i < kTasks; ++i) {
+            Promise<ull> p;
+            futures.push_back(p.get_future().then([](ull s) { return s; }));   // a step per task, same State
+            pool.post([p = std::move(p), i]() mutable { p.set_value(findOdd(i * kChunk, (i + 1) * kChunk - 1)); });
+        }
+        Future<ull> total = when_all(std::move(futures)).then(pool, [](vector<ull> sums) {
+            return accumulate(sums.begin(), sums.end(), ull(0));
+        });
+        if (!total.is_ready()) ++chainBlocked;
+        chainSum = std::move(total).get();
+    });
+    double chainAllocs = double(newCalls.load() - n0) / kTasks;
+
+    cout << kTasks << " tasks, " << pool.size() << " workers" << endl;
+    cout << "std::promise + get() each  : " << stdMs << " ms, blocking get() calls " << stdBlocked
+         << ", operator new per task " << stdAllocs << "  (oddSum " << stdSum << ")" << endl;
+    cout << "then + when_all + one get(): " << chainMs << " ms, blocking get() calls " << chainBlocked
+         << ", operator new per task " << chainAllocs << "  (oddSum " << chainSum << ")" << endl;
+
+    ok = ok && stdSum == chainSum && chainBlocked <= 1 && chainAllocs <= stdAllocs;
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. std::future only offers get(): consuming a result means a
+//    thread waits for it.
+// 2. A continuation (then) runs when the value arrives — on the
+//    fulfilling thread or a pool — so no thread parks.
+// 3. when_all / when_any join many futures with a counter or a
+//    flag in ONE joined state.
+// 4. Consuming the future on then() lets the whole chain reuse
+//    one shared state instead of allocating one per step.
+//
+// ⭐ One-Line Interview Answer
+// “Attach the next step with then() and join fan-outs with
+// when_all — results flow through continuations and the only
+// get() is at the very end.”
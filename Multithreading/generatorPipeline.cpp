@@ -0,0 +1,218 @@
+// ==========================================================
+// TOPIC: Coroutine Pipelines — Pull Stages on One Thread vs Thread Handoff
+// ==========================================================
+//
+// pucerconsumer.cpp:
+//
+//     producer thread: signal_to_producer.acquire();
+//                      for (i...) buff[i] = i * i;
+//                      signal_to_consumer.release();
+//     consumer thread: signal_to_consumer.acquire(); use buff; signal_to_producer.release();
+//
+// ❌ the producer's work is a multiply; passing five results to
+//    the other thread costs two semaphore operations, a wake-up and
+//    a context switch — the handoff IS the program
+// ❌ adding a stage means adding a thread and another pair of
+//    semaphores
+//
+// ✅ Generator.h: the producer is a coroutine that co_yields; the
+//    consumer pulls it on the SAME thread (resume / suspend, no
+//    kernel); stages compose with `|`; gen::parallel() puts a
+//    thread (and an SpscRing) only at the boundaries marked for it
+//
+// The work, for every row: v = i * i, then v % 1000003, keep even
+// values, sum them.
+//   1. plain loop (the ceiling: no stages at all)
+//   2. semaphores: pucerconsumer.cpp's two threads and 5-int buffer
+//   3. generator → transform → filter → sum, one thread
+//   4. the same with gen::parallel() after the generator: the
+//      squares on a second thread, SpscRing in between
+// items/s, and every row's sum equals the plain loop's. Then: an
+// early stop (gen::take) across a parallel boundary, and an
+// exception thrown upstream of it arriving downstream.
+//
+// Row 4 gains only with two cores; row 2 loses least with one (its
+// threads never run side by side anyway).
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./pipeline [items] [semaphore items]
+//
+//   items           → rows 1, 3, 4 (default 50000000)
+//   semaphore items → row 2, which is far slower (default 1000000)
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread generatorPipeline.cpp -o pipeline
+//
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <semaphore>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "Generator.h"
+#include "../Benchmarks/MicroBench.h"
+
+using namespace std;
+using namespace std::chrono;
+
+const uint64_t kMod = 1000003;
+
+Generator<uint64_t> squares(uint64_t n) {
+    for (uint64_t i = 0; i < n; ++i) co_yield i * i;
+}
+
+auto pipeline(Generator<uint64_t>&& src) {
+    return std::move(src) | gen::transform([](uint64_t v) { return v % kMod; }) |
+           gen::filter([](uint64_t v) { return (v & 1) == 0; });
+}
+
+template <typename F>
+double itemsPerSec(uint64_t n, uint64_t& sum, F&& f) {
+    const auto t0 = steady_clock::now();
+    sum = f();
+    doNotOptimize(sum);
+    return double(n) / duration<double>(steady_clock::now() - t0).count();
+}
+
+uint64_t plainLoop(uint64_t n) {
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+        const uint64_t v = i * i % kMod;
+        if ((v & 1) == 0) sum += v;
+    }
+    return sum;
+}
+
+// pucerconsumer.cpp's shape: a 5-int buffer passed back and forth
+uint64_t semaphores(uint64_t n) {
+    constexpr uint64_t kBuff = 5;
+    uint64_t buff[kBuff];
+    uint64_t filled = 0;
+    binary_semaphore toProducer{1}, toConsumer{0};
+    thread producer([&] {
+        for (uint64_t base = 0; base < n; base += kBuff) {
+            toProducer.acquire();
+            filled = min(kBuff, n - base);
+            for (uint64_t i = 0; i < filled; ++i) buff[i] = (base + i) * (base + i);
+            toConsumer.release();
+        }
+    });
+    uint64_t sum = 0;
+    for (uint64_t base = 0; base < n; base += kBuff) {
+        toConsumer.acquire();
+        for (uint64_t i = 0; i < filled; ++i) {
+            const uint64_t v = buff[i] % kMod;
+            if ((v & 1) == 0) sum += v;
+        }
+        toProducer.release();
+    }
+    producer.join();
+    return sum;
+}
+
+uint64_t sumOf(Generator<uint64_t>&& g) {
+    uint64_t sum = 0;
+    for (uint64_t v : g) sum += v;
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    const long items = argc > 1 ? atol(argv[1]) : 50000000;
+    const long semItems = argc > 2 ? atol(argv[2]) : 1000000;
+    if (items < 1 || semItems < 1) {
+        cerr << "usage: pipeline [items >= 1] [semaphore items >= 1]" << endl;
+        return 2;
+    }
+    const uint64_t n = uint64_t(items), ns = uint64_t(semItems);
+    cout << n << " items (semaphore row: " << ns << "), " << thread::hardware_concurrency() << " core(s)" << endl
+         << endl;
+
+    bool ok = true;
+    uint64_t ref = 0, refSem = 0, sum = 0;
+    const double plain = itemsPerSec(n, ref, [&] { return plainLoop(n); });
+    refSem = plainLoop(ns);
+    printf("  %-44s %14s %10s\n", "", "items/s", "vs plain");
+    printf("  %-44s %14.3g %9.2fx\n", "1. plain loop", plain, 1.0);
+
+    const double sem = itemsPerSec(ns, sum, [&] { return semaphores(ns); });
+    ok = ok && sum == refSem;
+    printf("  %-44s %14.3g %9.3fx\n", "2. two threads + semaphores (5-item buffer)", sem, sem / plain);
+
+    const double oneThread = itemsPerSec(n, sum, [&] { return sumOf(pipeline(squares(n))); });
+    ok = ok && sum == ref;
+    printf("  %-44s %14.3g %9.2fx\n", "3. generator | transform | filter", oneThread, oneThread / plain);
+
+    const double par = itemsPerSec(n, sum, [&] { return sumOf(pipeline(squares(n) | gen::parallel())); });
+    ok = ok && sum == ref;
+    printf("  %-44s %14.3g %9.2fx\n", "4. generator | parallel | transform | filter", par, par / plain);
+    printf("\n  generator vs semaphores: %.0fx the items/s\n", oneThread / sem);
+
+    // ---- early stop across a parallel boundary: no hang, exact prefix ----
+    {
+        vector<uint64_t> first;
+        for (uint64_t v : squares(uint64_t(1) << 40) | gen::parallel(64, 8) | gen::take(1000)) first.push_back(v);
+        ok = ok && first.size() == 1000 && first[999] == 999 * 999;
+    }
+    // ---- an exception upstream arrives downstream, after the items before it ----
+    {
+        auto failing = [](uint64_t n) -> Generator<uint64_t> {
+            for (uint64_t i = 0; i < n; ++i) {
+                if (i == 500) throw runtime_error("upstream failed");
+                co_yield i;
+            }
+        };
+        uint64_t seen = 0;
+        bool caught = false;
+        try {
+            for (uint64_t v : failing(1000) | gen::parallel(16, 4)) ok = ok && v == seen++;
+        } catch (const runtime_error&) {
+            caught = true;
+        }
+        ok = ok && caught && seen == 500;
+    }
+    // ---- a user stage: any Generator<T> → Generator<U> callable ----
+    {
+        auto pairs = [](Generator<uint64_t> g) -> Generator<uint64_t> {
+            uint64_t prev = 0;
+            bool odd = false;
+            for (uint64_t v : g) {
+                if (odd) co_yield prev + v;
+                prev = v;
+                odd = !odd;
+            }
+        };
+        ok = ok && sumOf(squares(4) | pairs) == 0 + 1 + 4 + 9;
+    }
+
+    cout << endl << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A generator is a coroutine that suspends at every co_yield;
+//    the consumer resumes it to get the next value — a call and a
+//    return, on one thread, no kernel.
+// 2. Pull pipelines compose: each stage iterates the previous one,
+//    so `src | map | filter` is nested loops written as stages —
+//    no buffers, no queues, no locks.
+// 3. Threads between stages pay a handoff per item (or per batch);
+//    worth it only when both sides have real work and their own
+//    cores — so mark those boundaries explicitly.
+// 4. A cross-thread boundary must handle early stop (drain and
+//    stop the producer) and errors (carry the exception across).
+//
+// ⭐ One-Line Interview Answer
+// “Write producers as coroutine generators that the consumer pulls
+// on its own thread, chain stages with `|`, and put a thread and a
+// ring only at the boundaries worth parallelising — a CPU-bound
+// pipeline then costs a resume per item instead of a context switch
+// per buffer.”
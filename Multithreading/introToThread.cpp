@@ -26,6 +26,7 @@
 #include <thread>
 #include <chrono>
 #include <algorithm>
+#include "Trace.h"     // TRACE_FILE=trace.json ./a.out: both loops on a timeline
 using namespace std;
 using namespace std::chrono;
 typedef unsigned long long ull;
@@ -33,11 +34,13 @@ ull OddSum = 0, EvenSum = 0;
 
 void findEven(ull start, ull end)
 {
+    TRACE_SCOPE("findEven");
     for (ull i = start; i <= end; ++i)
         if ((i & 1) == 0) EvenSum += i;
 }
 void findOdd(ull start, ull end)
 {
+    TRACE_SCOPE("findOdd");
     for (ull i = start; i <= end; ++i)
         if ((i & 1) != 0) OddSum += i;
 }
@@ -0,0 +1,291 @@
+// ======================================================
+// TOPIC: Recycling Messages Between Producers and Consumers
+// ======================================================
+//
+// ProducerConsumerproblemUsingThread.cpp / pucerconsumer.cpp:
+//
+//     buffer.push_back(val);                // an int, by value
+//
+// With real messages the producer allocates and the consumer frees:
+//
+//     queue.push(new Message(id, ...));     // producer
+//     delete queue.pop();                   // consumer
+//
+// ❌ one malloc + one cross-thread free per message; the freed
+//    block goes back to an allocator cache the consumer does not
+//    own
+// ❌ a mutex-protected freelist removes the allocator, but every
+//    message now takes the lock twice
+//
+// ✅ TaggedFreeList<Message> (FreeList.h): consumers recycle() a
+//    used message onto a lock-free Treiber stack, producers
+//    acquire() from it — one CAS each, ABA-safe through a tagged
+//    head, and no allocator call once enough messages exist
+//
+// Measured here, P producers → MPMCQueue<Message*> → C consumers:
+//   1. ns per message: new/delete, mutex + vector freelist,
+//      TaggedFreeList
+//   2. operator new calls made by the worker threads (counted by
+//      replacing the global operator new), total and after warm-up
+//   3. ABA stress: threads pop/push a list of a few blocks (one
+//      per thread at most) as fast as they can; a block handed to
+//      two threads at once would show
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./freelist [messages] [producers] [consumers]
+//
+//   messages   → messages per producer        (default 200000)
+//   producers  → producer threads             (default 2)
+//   consumers  → consumer threads             (default 2)
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread messageFreeList.cpp -o freelist
+//
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FreeList.h"
+#include "MPMCQueue.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ---- Count operator new on threads that opted in ----
+static atomic<long long> g_allocations{0};
+static thread_local bool t_counting = false;
+void* operator new(size_t n) {
+    if (t_counting) g_allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+// Out of line: inlined, GCC pairs free() with the builtin new and warns
+[[gnu::noinline]] void operator delete(void* p) noexcept { free(p); }
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept { free(p); }
+
+const size_t kQueueCapacity = 1024;
+
+struct Message {
+    uint64_t id;
+    uint64_t check;
+    char payload[240];
+
+    Message(uint64_t i) : id(i), check(i * 0x9E3779B97F4A7C15ull) { payload[0] = char(i); }
+    bool whole() const { return check == id * 0x9E3779B97F4A7C15ull && payload[0] == char(id); }
+};
+
+struct NewDelete {
+    static constexpr const char* name = "new / delete";
+    Message* make(uint64_t id) { return new Message(id); }
+    void drop(Message* m) { delete m; }
+};
+
+struct LockedFreeList {
+    static constexpr const char* name = "mutex + vector";
+    mutex m;
+    vector<Message*> free;
+
+    ~LockedFreeList() {
+        for (Message* p : free) ::operator delete(p);
+    }
+    Message* make(uint64_t id) {
+        void* p = nullptr;
+        {
+            lock_guard<mutex> g(m);
+            if (!free.empty()) {
+                p = free.back();
+                free.pop_back();
+            }
+        }
+        if (!p) p = ::operator new(sizeof(Message));
+        return ::new (p) Message(id);
+    }
+    void drop(Message* p) {
+        p->~Message();
+        lock_guard<mutex> g(m);
+        free.push_back(p);
+    }
+};
+
+struct Tagged {
+    static constexpr const char* name = "TaggedFreeList";
+    TaggedFreeList<Message> list;
+    Message* make(uint64_t id) { return list.acquire(id); }
+    void drop(Message* m) { list.recycle(m); }
+};
+
+struct RunResult {
+    double nsPerMessage = 0;
+    long long allocations = 0;       // by the workers, whole run
+    long long steadyAllocations = 0; // by the workers, after warm-up
+    bool ok = true;
+};
+
+// Producers send `messages` each; consumers stop on a null message
+template <typename Policy>
+RunResult run(Policy& policy, uint64_t messages, int producers, int consumers) {
+    MPMCQueue<Message*> queue(kQueueCapacity);
+    atomic<int> warm{0};
+    atomic<long long> atWarm{-1};
+    atomic<uint64_t> received{0}, bad{0};
+    const long long before = g_allocations.load();
+    // Warm-up: once every producer has sent more than the queue holds,
+    // every message in flight has been allocated at least once
+    const uint64_t warmAfter = min<uint64_t>(messages / 2, 4 * kQueueCapacity);
+
+    auto start = steady_clock::now();
+    vector<thread> threads;
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&, p] {
+            t_counting = true;
+            for (uint64_t i = 0; i < messages; ++i) {
+                if (i == warmAfter && warm.fetch_add(1) + 1 == producers) atWarm = g_allocations.load();
+                queue.push(policy.make(uint64_t(p) * messages + i));
+            }
+        });
+    for (int c = 0; c < consumers; ++c)
+        threads.emplace_back([&] {
+            t_counting = true;
+            uint64_t n = 0;
+            while (Message* m = queue.pop()) {
+                if (!m->whole()) bad.fetch_add(1, memory_order_relaxed);
+                policy.drop(m);
+                ++n;
+            }
+            received += n;
+        });
+    for (int p = 0; p < producers; ++p) threads[p].join();
+    for (int c = 0; c < consumers; ++c) queue.push(nullptr);
+    for (size_t t = producers; t < threads.size(); ++t) threads[t].join();
+    const double ns = duration<double, nano>(steady_clock::now() - start).count();
+
+    RunResult r;
+    const uint64_t total = messages * uint64_t(producers);
+    r.nsPerMessage = ns / double(total);
+    r.allocations = g_allocations.load() - before;
+    r.steadyAllocations = atWarm >= 0 ? g_allocations.load() - atWarm.load() : r.allocations;
+    r.ok = received == total && bad == 0;
+    return r;
+}
+
+// Every thread loops acquire → stamp → check stamp → recycle on a
+// list of a few blocks; a stale CAS that ABA let through would hand one
+// block to two threads, and the second stamp would overwrite the first
+bool abaStress(int threads, uint64_t rounds, uint64_t& collisions, size_t& blocks) {
+    struct Block {
+        atomic<int> holder{-1};
+        uint64_t spare = 0;
+    };
+    TaggedFreeList<Block> list;
+    list.reserve(4);
+    atomic<uint64_t> clashes{0};
+    vector<thread> ts;
+    for (int t = 0; t < threads; ++t)
+        ts.emplace_back([&, t] {
+            for (uint64_t i = 0; i < rounds; ++i) {
+                Block* b = list.acquire();
+                int expected = -1;
+                if (!b->holder.compare_exchange_strong(expected, t)) clashes.fetch_add(1, memory_order_relaxed);
+                b->spare = i;
+                if (i % 64 == 0) this_thread::yield();   // invite preemption while holding it
+                if (b->holder.exchange(-1) != t) clashes.fetch_add(1, memory_order_relaxed);
+                list.recycle(b);
+            }
+        });
+    for (auto& t : ts) t.join();
+    collisions = clashes.load();
+    blocks = list.allocations();
+    return collisions == 0 && blocks <= size_t(max(4, threads));
+}
+
+int main(int argc, char** argv) {
+    const long long messagesArg = argc > 1 ? atoll(argv[1]) : 200000;
+    const int producers = argc > 2 ? atoi(argv[2]) : 2;
+    const int consumers = argc > 3 ? atoi(argv[3]) : 2;
+    if (messagesArg < 2 || producers < 1 || consumers < 1) {
+        cerr << "usage: freelist [messages >= 2] [producers >= 1] [consumers >= 1]" << endl;
+        return 2;
+    }
+    const uint64_t messages = uint64_t(messagesArg);
+    bool ok = true;
+
+    // --------------------------------------------------
+    // 1–2. Time per message, allocator calls
+    // --------------------------------------------------
+    cout << producers << " producers -> MPMCQueue(" << kQueueCapacity << ") -> " << consumers << " consumers, "
+         << messages << " messages each, " << sizeof(Message) << "-byte messages (" << thread::hardware_concurrency()
+         << " CPUs)" << endl;
+    printf("  %-18s %10s %10s %18s %18s\n", "recycling", "ns/msg", "vs new", "operator new", "after warm-up");
+
+    NewDelete plain;
+    const RunResult base = run(plain, messages, producers, consumers);
+    LockedFreeList locked;
+    const RunResult withLock = run(locked, messages, producers, consumers);
+    Tagged tagged;
+    const RunResult lockFree = run(tagged, messages, producers, consumers);
+
+    auto row = [&](const char* name, const RunResult& r) {
+        printf("  %-18s %10.1f %9.2fx %18lld %18lld\n", name, r.nsPerMessage, r.nsPerMessage / base.nsPerMessage,
+               r.allocations, r.steadyAllocations);
+    };
+    row(NewDelete::name, base);
+    row(LockedFreeList::name, withLock);
+    row(Tagged::name, lockFree);
+
+    // new/delete allocates every message; the lock-free list only the
+    // ones in flight at the busiest moment (≤ queue + threads), none
+    // after warm-up
+    const long long bound = (long long)(kQueueCapacity + producers + consumers + 1);
+    ok = ok && base.ok && withLock.ok && lockFree.ok;
+    ok = ok && base.allocations >= (long long)(messages * producers);
+    ok = ok && lockFree.allocations == (long long)tagged.list.allocations() && lockFree.allocations <= bound;
+    ok = ok && lockFree.steadyAllocations == 0;
+    cout << "  TaggedFreeList holds " << tagged.list.allocations() << " messages (bound " << bound
+         << ": queue + one per thread)" << endl;
+
+    // --------------------------------------------------
+    // 3. ABA stress
+    // --------------------------------------------------
+    {
+        const int threads = 8;
+        const uint64_t rounds = 200000;
+        uint64_t collisions = 0;
+        size_t blocks = 0;
+        const bool clean = abaStress(threads, rounds, collisions, blocks);
+        cout << endl
+             << "ABA stress: " << threads << " threads x " << rounds << " acquire/recycle, " << blocks
+             << " blocks, blocks handed out twice: " << collisions << endl;
+        ok = ok && clean;
+    }
+
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. Producer allocates, consumer frees: every message is a
+//    cross-thread free — recycle the memory instead.
+// 2. Treiber stack: push and pop are one CAS on the head; the
+//    node's own memory holds the `next` link.
+// 3. ABA: the head can come back to the same address with a
+//    different next — tag the head so a stale CAS fails.
+// 4. Never free a node while the list is live: a popper may still
+//    read its `next`.
+//
+// ⭐ One-Line Interview Answer
+// “Keep used messages on a lock-free Treiber-stack freelist with a
+// tagged head against ABA — consumers push, producers pop, and in
+// steady state nobody calls the allocator.”
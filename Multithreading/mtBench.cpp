@@ -0,0 +1,521 @@
+// ==========================================================
+// TOPIC: One Benchmark Suite for Every Multithreading Primitive
+// ==========================================================
+//
+// Mutex.cpp, LockGuard.cpp, unique_Lock.cpp, timed_mutex.cpp,
+// recursive_mutex.cpp, BinarySemaphore.cpp, ConditionVariable.cpp,
+// std::async.cpp, ... each demonstrate one primitive:
+//
+//     for (int i = 0; i < 100000; ++i) { mtx.lock(); ++counter; mtx.unlock(); }
+//     cout << "Final counter: " << counter << endl;
+//
+// ❌ a print, not a measurement: no throughput, no tail latency,
+//    no idea whether one thread got all the turns
+// ❌ one fixed load: contention, critical-section length and the
+//    read/write mix change which primitive wins
+//
+// ✅ mt_bench: every primitive through the same harness
+//    (../Benchmarks/ContentionBench.h), swept over
+//      --threads   thread counts
+//      --cs        critical-section lengths (spinWork units, ~1 ns)
+//      --reads     read ratios (reader/writer primitives only)
+//    reporting throughput, p50/p99/p999 latency per operation and
+//    Jain's fairness index, as JSON (stdout or --json=FILE) and as
+//    a table on stderr. Lock-protected counters are checked
+//    against the operation counts.
+//    --counters adds PerfCounters.h events per operation, summed
+//    over the threads (cycles, cache misses, context switches —
+//    what the hardware exposes) to both.
+//
+// Usage:
+//   ./mt_bench [--threads=1,2,4] [--cs=0,100] [--reads=0.5,0.9]
+//              [--ms=50] [--filter=mutex] [--json=mt_bench.json] [--counters]
+//   ./mt_bench --list                   # primitives and their demos
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread mtBench.cpp -o mt_bench
+//
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <semaphore>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Benchmarks/ContentionBench.h"
+#include "../Benchmarks/MicroBench.h"
+#include "AdaptiveTimedMutex.h"
+#include "FairLocks.h"
+#include "FlatCombiningCounter.h"
+#include "MPMCQueue.h"
+#include "ReentrantMutex.h"
+#include "SeqLock.h"
+#include "ShardedCounter.h"
+#include "StripedRWLock.h"
+
+using namespace std;
+using namespace std::chrono_literals;
+
+// ---------------- the primitives ----------------
+
+// One primitive: runs one configuration; `checked` is false if
+// its own invariant (a protected counter) does not hold afterwards
+struct Primitive {
+    string name;
+    string source;                    // the demo it comes from
+    bool readWrite;                   // sweeps --reads
+    function<ContentionResult(const ContentionConfig&, bool& checked)> run;
+};
+
+// A lock-protected plain counter: with correct mutual exclusion it
+// ends equal to the number of operations
+struct Guarded {
+    long counter = 0;
+    uint64_t sink = 0;
+    void work(uint32_t cs) {
+        sink += spinWork(cs);
+        ++counter;
+    }
+};
+
+template <typename Lock, typename Acquire, typename Release>
+Primitive lockPrimitive(string name, string source, Acquire acquire, Release release) {
+    return {name, source, false, [=](const ContentionConfig& cfg, bool& checked) {
+                Lock lock;
+                Guarded g;
+                ContentionResult r = runContention(name, cfg, [&](int, bool) {
+                    acquire(lock);
+                    g.work(cfg.csWork);
+                    release(lock);
+                });
+                checked = uint64_t(g.counter) == r.ops;
+                return r;
+            }};
+}
+
+// A binary_semaphore has no default constructor; start it "unlocked"
+struct SemaphoreLock {
+    binary_semaphore s{1};
+};
+
+// Reader/writer state: a writer keeps a == b; a reader checks it
+struct Pair {
+    long a = 0, b = 0;
+};
+
+vector<Primitive> primitives() {
+    vector<Primitive> ps;
+
+    ps.push_back({"std::atomic fetch_add (no lock)", "staticVarSafe.cpp", false,
+                  [](const ContentionConfig& cfg, bool& checked) {
+                      atomic<long> counter{0};
+                      ContentionResult r = runContention("std::atomic fetch_add (no lock)", cfg, [&](int, bool) {
+                          doNotOptimize(spinWork(cfg.csWork));
+                          counter.fetch_add(1, memory_order_relaxed);
+                      });
+                      checked = uint64_t(counter.load()) == r.ops;
+                      return r;
+                  }});
+
+    ps.push_back(lockPrimitive<mutex>("std::mutex lock/unlock", "Mutex.cpp", [](mutex& m) { m.lock(); },
+                                      [](mutex& m) { m.unlock(); }));
+
+    ps.push_back({"std::lock_guard<std::mutex>", "LockGuard.cpp", false,
+                  [](const ContentionConfig& cfg, bool& checked) {
+                      mutex m;
+                      Guarded g;
+                      ContentionResult r = runContention("std::lock_guard<std::mutex>", cfg, [&](int, bool) {
+                          lock_guard<mutex> lg(m);
+                          g.work(cfg.csWork);
+                      });
+                      checked = uint64_t(g.counter) == r.ops;
+                      return r;
+                  }});
+
+    ps.push_back({"std::unique_lock<std::mutex>", "unique_Lock.cpp", false,
+                  [](const ContentionConfig& cfg, bool& checked) {
+                      mutex m;
+                      Guarded g;
+                      ContentionResult r = runContention("std::unique_lock<std::mutex>", cfg, [&](int, bool) {
+                          unique_lock<mutex> ul(m);
+                          g.work(cfg.csWork);
+                      });
+                      checked = uint64_t(g.counter) == r.ops;
+                      return r;
+                  }});
+
+    ps.push_back(lockPrimitive<mutex>(
+        "try_lock + yield loop", "MutextryLock.cpp",
+        [](mutex& m) {
+            while (!m.try_lock()) this_thread::yield();
+        },
+        [](mutex& m) { m.unlock(); }));
+
+    ps.push_back(lockPrimitive<timed_mutex>(
+        "std::timed_mutex try_lock_for(1ms)", "timed_mutex.cpp",
+        [](timed_mutex& m) {
+            while (!m.try_lock_for(1ms)) {
+            }
+        },
+        [](timed_mutex& m) { m.unlock(); }));
+
+    ps.push_back(lockPrimitive<AdaptiveTimedMutex>(
+        "AdaptiveTimedMutex try_lock_for(1ms)", "adaptiveTimedMutex.cpp",
+        [](AdaptiveTimedMutex& m) {
+            while (!m.try_lock_for(1ms)) {
+            }
+        },
+        [](AdaptiveTimedMutex& m) { m.unlock(); }));
+
+    ps.push_back(lockPrimitive<recursive_mutex>(
+        "std::recursive_mutex, depth 2", "recursive_mutex.cpp",
+        [](recursive_mutex& m) {
+            m.lock();
+            m.lock();
+        },
+        [](recursive_mutex& m) {
+            m.unlock();
+            m.unlock();
+        }));
+
+    ps.push_back(lockPrimitive<ReentrantMutex>(
+        "ReentrantMutex, depth 2", "reentrantMutex.cpp",
+        [](ReentrantMutex& m) {
+            m.lock();
+            m.lock();
+        },
+        [](ReentrantMutex& m) {
+            m.unlock();
+            m.unlock();
+        }));
+
+    ps.push_back(lockPrimitive<TicketLock>("TicketLock lock/unlock", "fairLock.cpp", [](TicketLock& m) { m.lock(); },
+                                           [](TicketLock& m) { m.unlock(); }));
+    ps.push_back(lockPrimitive<McsLock>("McsLock lock/unlock", "fairLock.cpp", [](McsLock& m) { m.lock(); },
+                                        [](McsLock& m) { m.unlock(); }));
+
+    ps.push_back({"std::lock(m1, m2)", "std::Lock.cpp", false, [](const ContentionConfig& cfg, bool& checked) {
+                      mutex m1, m2;
+                      Guarded g;
+                      ContentionResult r = runContention("std::lock(m1, m2)", cfg, [&](int t, bool) {
+                          if (t & 1) lock(m2, m1);            // opposite orders: no deadlock with std::lock
+                          else lock(m1, m2);
+                          g.work(cfg.csWork);
+                          m1.unlock();
+                          m2.unlock();
+                      });
+                      checked = uint64_t(g.counter) == r.ops;
+                      return r;
+                  }});
+
+    ps.push_back(lockPrimitive<SemaphoreLock>(
+        "std::binary_semaphore as a lock", "BinarySemaphore.cpp", [](SemaphoreLock& l) { l.s.acquire(); },
+        [](SemaphoreLock& l) { l.s.release(); }));
+
+    ps.push_back({"condition_variable turn passing", "ConditionVariable.cpp", false,
+                  [](const ContentionConfig& cfg, bool& checked) {
+                      mutex m;
+                      condition_variable cv;
+                      int turn = 0;
+                      Guarded g;
+                      ContentionResult r = runContention(
+                          "condition_variable turn passing", cfg, [&](int t, bool, const atomic<bool>& stopping) {
+                              unique_lock<mutex> lk(m);
+                              while (turn != t)
+                                  if (cv.wait_for(lk, 1ms) == cv_status::timeout && stopping.load()) return;
+                              g.work(cfg.csWork);
+                              turn = (turn + 1) % cfg.threads;
+                              cv.notify_all();
+                          });
+                      checked = uint64_t(g.counter) + cfg.threads >= r.ops && uint64_t(g.counter) <= r.ops;
+                      return r;
+                  }});
+
+    ps.push_back({"mutex + condition_variable queue, push+pop", "ProducerConsumerproblemUsingThread.cpp", false,
+                  [](const ContentionConfig& cfg, bool& checked) {
+                      mutex m;
+                      condition_variable notEmpty;
+                      deque<long> q;
+                      long popped = 0;
+                      ContentionResult r =
+                          runContention("mutex + condition_variable queue, push+pop", cfg, [&](int t, bool) {
+                              {
+                                  lock_guard<mutex> lg(m);
+                                  q.push_back(t);
+                              }
+                              notEmpty.notify_one();
+                              doNotOptimize(spinWork(cfg.csWork));
+                              unique_lock<mutex> lk(m);
+                              notEmpty.wait(lk, [&] { return !q.empty(); });   // own item is there at least
+                              q.pop_front();
+                              ++popped;
+                          });
+                      checked = uint64_t(popped) == r.ops && q.empty();
+                      return r;
+                  }});
+
+    ps.push_back({"MPMCQueue push+pop", "MPMCRingBuffer.cpp", false, [](const ContentionConfig& cfg, bool& checked) {
+                      MPMCQueue<long> q(1024);
+                      atomic<long> popped{0};
+                      ContentionResult r = runContention("MPMCQueue push+pop", cfg, [&](int t, bool) {
+                          q.push(t);
+                          doNotOptimize(spinWork(cfg.csWork));
+                          doNotOptimize(q.pop());
+                          popped.fetch_add(1, memory_order_relaxed);
+                      });
+                      checked = uint64_t(popped.load()) == r.ops && q.size_approx() == 0;
+                      return r;
+                  }});
+
+    ps.push_back({"ShardedCounter add", "shardedCounter.cpp", false, [](const ContentionConfig& cfg, bool& checked) {
+                      ShardedCounter c;
+                      ContentionResult r = runContention("ShardedCounter add", cfg, [&](int, bool) {
+                          doNotOptimize(spinWork(cfg.csWork));
+                          c.add(1);
+                      });
+                      checked = uint64_t(c.read_exact()) == r.ops;
+                      return r;
+                  }});
+
+    ps.push_back({"FlatCombiningCounter add", "flatCombiningCounter.cpp", false,
+                  [](const ContentionConfig& cfg, bool& checked) {
+                      FlatCombiningCounter<long> c;
+                      ContentionResult r = runContention("FlatCombiningCounter add", cfg, [&](int, bool) {
+                          doNotOptimize(spinWork(cfg.csWork));
+                          c.add(1);
+                      });
+                      checked = uint64_t(c.value()) == r.ops;
+                      return r;
+                  }});
+
+    ps.push_back({"std::shared_mutex read/write", "comparisons.txt", true,
+                  [](const ContentionConfig& cfg, bool& checked) {
+                      shared_mutex m;
+                      Pair p;
+                      atomic<long> torn{0};
+                      uint64_t sink = 0;
+                      ContentionResult r = runContention("std::shared_mutex read/write", cfg, [&](int, bool isRead) {
+                          if (isRead) {
+                              shared_lock<shared_mutex> sl(m);
+                              doNotOptimize(spinWork(cfg.csWork));
+                              if (p.a != p.b) torn.fetch_add(1, memory_order_relaxed);
+                          } else {
+                              unique_lock<shared_mutex> ul(m);
+                              ++p.a;
+                              sink += spinWork(cfg.csWork);
+                              ++p.b;
+                          }
+                      });
+                      doNotOptimize(sink);
+                      checked = torn.load() == 0;
+                      return r;
+                  }});
+
+    for (RWPreference pref : {RWPreference::Writers, RWPreference::Readers}) {
+        const string name = string("StripedRWLock read/write, ") +
+                            (pref == RWPreference::Writers ? "writers first" : "readers first");
+        ps.push_back({name, "stripedRWLock.cpp", true, [name, pref](const ContentionConfig& cfg, bool& checked) {
+                          StripedRWLock m(pref);
+                          Pair p;
+                          atomic<long> torn{0};
+                          uint64_t sink = 0;
+                          ContentionResult r = runContention(name, cfg, [&](int, bool isRead) {
+                              if (isRead) {
+                                  shared_lock<StripedRWLock> sl(m);
+                                  doNotOptimize(spinWork(cfg.csWork));
+                                  if (p.a != p.b) torn.fetch_add(1, memory_order_relaxed);
+                              } else {
+                                  unique_lock<StripedRWLock> ul(m);
+                                  ++p.a;
+                                  sink += spinWork(cfg.csWork);
+                                  ++p.b;
+                              }
+                          });
+                          doNotOptimize(sink);
+                          checked = torn.load() == 0;
+                          return r;
+                      }});
+    }
+
+    ps.push_back({"SeqLock<Pair> load/store", "seqlockSnapshot.cpp", true,
+                  [](const ContentionConfig& cfg, bool& checked) {
+                      SeqLock<Pair> s;
+                      mutex writers;                           // SeqLock takes one writer at a time
+                      atomic<long> torn{0};
+                      ContentionResult r = runContention("SeqLock<Pair> load/store", cfg, [&](int, bool isRead) {
+                          if (isRead) {
+                              Pair p = s.load();
+                              doNotOptimize(spinWork(cfg.csWork));
+                              if (p.a != p.b) torn.fetch_add(1, memory_order_relaxed);
+                          } else {
+                              lock_guard<mutex> lg(writers);
+                              s.update([&](Pair& p) {
+                                  ++p.a;
+                                  doNotOptimize(spinWork(cfg.csWork));
+                                  ++p.b;
+                              });
+                          }
+                      });
+                      checked = torn.load() == 0;
+                      return r;
+                  }});
+
+    ps.push_back({"std::async(launch::async).get()", "std::async.cpp", false,
+                  [](const ContentionConfig& cfg, bool& checked) {
+                      atomic<long> ran{0};
+                      ContentionResult r = runContention("std::async(launch::async).get()", cfg, [&](int, bool) {
+                          async(launch::async, [&] {
+                              doNotOptimize(spinWork(cfg.csWork));
+                              ran.fetch_add(1, memory_order_relaxed);
+                          }).get();
+                      });
+                      checked = uint64_t(ran.load()) == r.ops;
+                      return r;
+                  }});
+
+    ps.push_back({"promise/future set_value + get", "std::futureAndPromise.cpp", false,
+                  [](const ContentionConfig& cfg, bool& checked) {
+                      atomic<long> got{0};
+                      ContentionResult r = runContention("promise/future set_value + get", cfg, [&](int t, bool) {
+                          promise<long> p;
+                          future<long> f = p.get_future();
+                          p.set_value(long(spinWork(cfg.csWork) & 1) + t);
+                          got.fetch_add(f.get() >= t, memory_order_relaxed);
+                      });
+                      checked = uint64_t(got.load()) == r.ops;
+                      return r;
+                  }});
+
+    return ps;
+}
+
+// ---------------- command line ----------------
+
+template <typename T>
+vector<T> parseList(const string& s) {
+    vector<T> out;
+    stringstream ss(s);
+    string item;
+    while (getline(ss, item, ',')) {
+        T v{};
+        stringstream(item) >> v;
+        out.push_back(v);
+    }
+    return out;
+}
+
+struct Options {
+    vector<int> threads = {1, 2, 4};
+    vector<uint32_t> cs = {0, 100};
+    vector<double> reads = {0.5, 0.9};
+    double ms = 50;
+    string filter;
+    string json;
+    bool list = false;
+    bool counters = false;
+};
+
+Options parse(int argc, char** argv) {
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        auto value = [&](const char* key) -> const char* {
+            size_t n = strlen(key);
+            return a.compare(0, n, key) == 0 ? a.c_str() + n : nullptr;
+        };
+        if (const char* v = value("--threads=")) o.threads = parseList<int>(v);
+        else if (const char* v = value("--cs=")) o.cs = parseList<uint32_t>(v);
+        else if (const char* v = value("--reads=")) o.reads = parseList<double>(v);
+        else if (const char* v = value("--ms=")) o.ms = atof(v);
+        else if (const char* v = value("--filter=")) o.filter = v;
+        else if (const char* v = value("--json=")) o.json = v;
+        else if (a == "--list") o.list = true;
+        else if (a == "--counters") o.counters = true;
+        else {
+            cerr << "unknown argument " << a << "\nusage: mt_bench [--threads=1,2,4] [--cs=0,100] [--reads=0.5,0.9]"
+                 << " [--ms=50] [--filter=substr] [--json=FILE] [--counters] [--list]" << endl;
+            exit(2);
+        }
+    }
+    for (int t : o.threads)
+        if (t < 1) {
+            cerr << "--threads: every count must be >= 1" << endl;
+            exit(2);
+        }
+    return o;
+}
+
+int main(int argc, char** argv) {
+    Options opt = parse(argc, argv);
+    if (opt.list) {
+        for (const Primitive& p : primitives()) cout << p.name << "  (" << p.source << ")" << endl;
+        return 0;
+    }
+    vector<ContentionResult> results;
+    bool ok = true;
+
+    fprintf(stderr, "%-42s %3s %5s %5s %12s %8s %8s %9s %6s", "primitive", "thr", "cs", "reads", "ops/s", "p50 ns",
+            "p99 ns", "p999 ns", "jain");
+    if (opt.counters) fprintf(stderr, " %9s %10s %9s", "cyc/op", "c-miss/op", "ctxsw/op");
+    fprintf(stderr, "\n");
+    for (const Primitive& p : primitives()) {
+        if (!opt.filter.empty() && p.name.find(opt.filter) == string::npos) continue;
+        vector<double> reads = p.readWrite ? opt.reads : vector<double>{0};
+        for (int threads : opt.threads)
+            for (uint32_t cs : opt.cs)
+                for (double rr : reads) {
+                    ContentionConfig cfg{threads, cs, rr, opt.ms, opt.counters};
+                    bool checked = true;
+                    ContentionResult r = p.run(cfg, checked);
+                    fprintf(stderr, "%-42s %3d %5u %5.2f %12.0f %8.0f %8.0f %9.0f %6.3f", r.name.c_str(), threads, cs,
+                            rr, r.opsPerSec, r.p50Ns, r.p99Ns, r.p999Ns, r.jain);
+                    if (opt.counters)                // -1: not exposed here
+                        fprintf(stderr, " %9.1f %10.4f %9.4f", r.perOp("cycles"), r.perOp("cache-misses"),
+                                r.perOp("context-switches"));
+                    fprintf(stderr, "%s\n", checked ? "" : "  CHECK FAILED");
+                    ok = ok && checked && r.ops > 0;
+                    results.push_back(move(r));
+                }
+    }
+
+    if (opt.json.empty()) {
+        writeJson(cout, "mt_bench", results);
+    } else {
+        ofstream out(opt.json);
+        writeJson(out, "mt_bench", results);
+        ok = ok && bool(out);
+    }
+    fprintf(stderr, "all checks: %s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A lock's cost depends on the load: thread count, how long
+//    it is held and the read/write mix — measure a sweep, not a
+//    single point.
+// 2. Averages hide the tail: report p99/p999 per operation; a
+//    lock that is fast on average can still park some callers.
+// 3. Throughput without fairness is misleading: Jain's index
+//    shows when one thread (often the last holder) gets
+//    nearly every turn.
+// 4. Machine-readable output (JSON) is what makes a benchmark a
+//    regression test, release to release.
+//
+// ⭐ One-Line Interview Answer
+// “Benchmark synchronization under a contention sweep and
+// report throughput, tail latency and fairness together —
+// any one of them alone picks the wrong primitive.”
@@ -0,0 +1,174 @@
+// ======================================================
+// TOPIC: N-Buffered Producer–Consumer Pipeline (C++20)
+// ======================================================
+//
+// PROBLEM WITH pucerconsumer.cpp:
+// - ONE buffer is handed back and forth with two binary
+//   semaphores → producer and consumer NEVER run together
+// - Every element does "cout << flush" and a sleep
+//   → the time is spent in I/O, not in real work
+//
+// ------------------------------------------------------
+// SOLUTION: DOUBLE (or N) BUFFERING
+// ------------------------------------------------------
+//
+//   producer:  fill buf[0]  fill buf[1]  fill buf[0] ...
+//   consumer:              drain buf[0] drain buf[1] ...
+//
+// - While the consumer drains buffer k, the producer is
+//   already filling buffer k+1
+// - Two COUNTING semaphores replace the binary pair:
+//     emptySlots → how many buffers the producer may fill
+//     fullSlots  → how many buffers the consumer may drain
+// - buffers == 1 is exactly the old ping-pong behaviour
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./pipeline [buff_size] [buffers] [rounds] [work_us]
+//
+//   buff_size → elements per buffer      (default 5)
+//   buffers   → number of buffers (N)    (default 2)
+//   rounds    → buffers to push through  (default 40)
+//   work_us   → simulated work per element, microseconds
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread pipelineBuffers.cpp -o pipeline
+//
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+// Upper bound for the counting semaphores (number of buffers)
+const int maxBuffers = 64;
+
+struct StageStats {
+    long long elements = 0;
+    double busySeconds = 0;     // time spent doing real work
+};
+
+class Pipeline {
+    int buff_size;
+    int buffers;
+    vector<vector<int>> buff;           // buff[k][i]
+
+    counting_semaphore<maxBuffers> emptySlots;
+    counting_semaphore<maxBuffers> fullSlots{0};
+
+public:
+    Pipeline(int size, int count)
+        : buff_size(size), buffers(count),
+          buff(count, vector<int>(size)), emptySlots(count) {}
+
+    /*
+     Producer:
+     Waits for a FREE buffer, fills it, hands it over.
+    */
+    void producer(int rounds, int work_us, StageStats& stats) {
+        for (int r = 0; r < rounds; ++r) {
+            int k = r % buffers;
+            emptySlots.acquire();
+
+            auto t0 = steady_clock::now();
+            for (int i = 0; i < buff_size; ++i)
+                buff[k][i] = i * i;             // Produce data
+            // Simulated production cost for the whole batch
+            this_thread::sleep_for(microseconds((long long)work_us * buff_size));
+            stats.busySeconds += duration<double>(steady_clock::now() - t0).count();
+            stats.elements += buff_size;
+
+            fullSlots.release();                // buffer k is ready
+        }
+    }
+
+    /*
+     Consumer:
+     Waits for a FULL buffer, drains it, gives it back.
+    */
+    void consumer(int rounds, int work_us, StageStats& stats, long long& checksum) {
+        for (int r = 0; r < rounds; ++r) {
+            int k = r % buffers;
+            fullSlots.acquire();
+
+            auto t0 = steady_clock::now();
+            for (int i = buff_size - 1; i >= 0; --i) {
+                checksum += buff[k][i];
+                buff[k][i] = 0;                 // Consume data
+            }
+            this_thread::sleep_for(microseconds((long long)work_us * buff_size));
+            stats.busySeconds += duration<double>(steady_clock::now() - t0).count();
+            stats.elements += buff_size;
+
+            emptySlots.release();               // buffer k is free again
+        }
+    }
+};
+
+double runPipeline(int buff_size, int buffers, int rounds, int work_us) {
+    Pipeline p(buff_size, buffers);
+    StageStats prodStats, consStats;
+    long long checksum = 0;
+
+    auto start = steady_clock::now();
+    thread producer_thread(&Pipeline::producer, &p, rounds, work_us, ref(prodStats));
+    thread consumer_thread(&Pipeline::consumer, &p, rounds, work_us,
+                           ref(consStats), ref(checksum));
+    producer_thread.join();
+    consumer_thread.join();
+    double wall = duration<double>(steady_clock::now() - start).count();
+
+    // Throughput counters: per stage (busy time) and end-to-end (wall time)
+    cout << "buffers=" << buffers << "  buff_size=" << buff_size << endl;
+    cout << "  producer : " << prodStats.elements / prodStats.busySeconds << " elem/s (busy)" << endl;
+    cout << "  consumer : " << consStats.elements / consStats.busySeconds << " elem/s (busy)" << endl;
+    cout << "  pipeline : " << consStats.elements / wall << " elem/s (wall "
+         << wall * 1000 << " ms, checksum " << checksum << ")" << endl;
+    return wall;
+}
+
+int main(int argc, char* argv[]) {
+    int buff_size = argc > 1 ? atoi(argv[1]) : 5;
+    int buffers   = argc > 2 ? atoi(argv[2]) : 2;
+    int rounds    = argc > 3 ? atoi(argv[3]) : 40;
+    int work_us   = argc > 4 ? atoi(argv[4]) : 1000;
+
+    if (buff_size <= 0 || buffers <= 0 || buffers > maxBuffers || rounds <= 0 || work_us < 0) {
+        cerr << "usage: pipeline [buff_size>0] [1<=buffers<=" << maxBuffers
+             << "] [rounds>0] [work_us>=0]" << endl;
+        return 1;
+    }
+
+    // Baseline: single buffer = strict ping-pong (pucerconsumer.cpp)
+    cout << "--- ping-pong (1 buffer) ---" << endl;
+    double single = runPipeline(buff_size, 1, rounds, work_us);
+
+    cout << "--- pipelined (" << buffers << " buffers) ---" << endl;
+    double multi = runPipeline(buff_size, buffers, rounds, work_us);
+
+    cout << "overlap speedup: " << single / multi << "x" << endl;
+    return 0;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. Binary semaphores force STRICT ALTERNATION.
+// 2. Counting semaphores with N buffers allow OVERLAP:
+//    the best case speedup approaches 2x for two equal stages.
+// 3. Per-element cout/flush destroys throughput — batch work,
+//    report counters at the end.
+// 4. Each buffer is owned by exactly ONE side at a time,
+//    so no mutex is needed around buff[k].
+//
+// ⭐ One-Line Interview Answer
+// “Double buffering lets the producer fill the next buffer
+// while the consumer drains the current one, turning a
+// ping-pong handoff into a real pipeline.”
@@ -0,0 +1,184 @@
+// ==========================================================
+// TOPIC: Waking Only the Waiters That Can Proceed — 1000 Withdrawers
+// ==========================================================
+//
+// ConditionVariable.cpp has one withdrawer waiting for
+// "balance != 0" and one depositor calling notify_one() under
+// the lock. With 1000 withdrawers that each need a different
+// amount, notify_one() can wake the wrong one (its amount is
+// not covered, the covered one keeps sleeping), so the correct
+// std::condition_variable version must notify_all(): every
+// deposit wakes every withdrawer just to re-check.
+//
+// PredicateCondition.h evaluates the waiters' predicates for
+// them, under the lock, and wakes only those whose condition
+// holds — after the lock is released.
+//
+// Measured here: 1000 withdrawer threads want 1..100 each;
+// one depositor pays in 50 at a time, ~every 50 µs, until all
+// are served:
+// - std::condition_variable + notify_all() under the lock
+// - PredicateCondition + notify_one() (withdrawers pass the baton)
+// reporting wall time, process CPU time, wake-ups, futile ones.
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread predicateCondition.cpp -o predcond
+//
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+#include "PredicateCondition.h"
+
+using namespace std;
+using namespace std::chrono;
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+double cpuMs() {
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+    return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1e3 + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e3;
+}
+
+constexpr int kWithdrawers = 1000;
+constexpr long kDeposit = 50;
+
+long want(int i) { return 1 + i % 100; }
+
+long totalWanted() {
+    long sum = 0;
+    for (int i = 0; i < kWithdrawers; ++i) sum += want(i);
+    return sum;
+}
+
+struct Result {
+    double wallMs, cpuMs;
+    unsigned long long wakeups, futile;
+    bool ok;
+};
+
+void report(const char* name, const Result& r) {
+    cout << "  " << left << setw(36) << name << right << fixed << setprecision(0) << setw(6) << r.wallMs
+         << " ms wall " << setw(6) << r.cpuMs << " ms CPU " << setw(9) << r.wakeups << " wake-ups " << setw(9)
+         << r.futile << " futile" << (r.ok ? "" : "  ✘ balance wrong") << endl;
+}
+
+// Deposits everything once all withdrawers are asleep
+template <typename Deposit, typename Waiting>
+void depositor(Deposit deposit, Waiting waiting) {
+    while (waiting() < kWithdrawers) this_thread::yield();
+    for (long left = totalWanted(); left > 0; left -= kDeposit) {
+        deposit(min(left, kDeposit));
+        this_thread::sleep_for(50us);
+    }
+}
+
+Result runStdCv() {
+    mutex m;
+    condition_variable cv;
+    long balance = 0;
+    int waiting = 0;
+    atomic<unsigned long long> wakeups{0}, futile{0};
+    double cpu0 = cpuMs();
+    double wall = timeMs([&] {
+        vector<thread> ts;
+        for (int i = 0; i < kWithdrawers; ++i)
+            ts.emplace_back([&, amount = want(i)] {
+                unique_lock<mutex> ul(m);
+                ++waiting;
+                bool first = true;
+                cv.wait(ul, [&] {
+                    if (!first) {
+                        ++wakeups;
+                        if (balance < amount) ++futile;
+                    }
+                    first = false;
+                    return balance >= amount;
+                });
+                balance -= amount;
+            });
+        depositor(
+            [&](long money) {
+                lock_guard<mutex> lg(m);
+                balance += money;
+                cv.notify_all();                     // notify_one could wake the wrong waiter
+            },
+            [&] {
+                lock_guard<mutex> lg(m);
+                return waiting;
+            });
+        for (auto& t : ts) t.join();
+    });
+    return {wall, cpuMs() - cpu0, wakeups.load(), futile.load(), balance == 0};
+}
+
+Result runPredicate() {
+    PredicateCondition pc;
+    long balance = 0;
+    int waiting = 0;
+    double cpu0 = cpuMs();
+    double wall = timeMs([&] {
+        vector<thread> ts;
+        for (int i = 0; i < kWithdrawers; ++i)
+            ts.emplace_back([&, amount = want(i)] {
+                auto g = pc.lock();
+                ++waiting;
+                g.wait([&] { return balance >= amount; });
+                balance -= amount;
+                g.notify_one();                      // baton: the next one that is covered
+            });
+        depositor(
+            [&](long money) {
+                auto g = pc.lock();
+                balance += money;
+                g.notify_one();
+            },
+            [&] {
+                auto g = pc.lock();
+                return waiting;
+            });
+        for (auto& t : ts) t.join();
+    });
+    WaitStats s = pc.stats();
+    return {wall, cpuMs() - cpu0, s.wakeups, s.futile, balance == 0};
+}
+
+int main() {
+    cout << kWithdrawers << " withdrawers (1..100 each), deposits of " << kDeposit << " until "
+         << totalWanted() << " is paid (" << thread::hardware_concurrency() << " hardware threads):" << endl;
+    Result cv = runStdCv();
+    report("condition_variable + notify_all", cv);
+    Result pc = runPredicate();
+    report("PredicateCondition + notify_one", pc);
+    return cv.ok && pc.ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. notify_one() is only correct when every waiter waits for
+//    the same condition; mixed predicates force notify_all().
+// 2. notify_all() with N waiters costs N wake-ups, N lock
+//    acquisitions and N predicate checks per state change.
+// 3. If the notifier evaluates the waiters' predicates under
+//    the lock, only waiters that can proceed are woken.
+// 4. Waking after the unlock avoids the woken thread blocking
+//    straight away on the mutex its waker still holds.
+//
+// ⭐ One-Line Interview Answer
+// “Register each waiter's predicate with the condition, let the
+// notifier evaluate them under the lock and wake only the
+// satisfied ones after unlocking — no thundering herd and no
+// wrong-waiter wake-ups.”
@@ -0,0 +1,190 @@
+// ======================================================
+// TOPIC: Queue Residence Time — Buffer Depth and Pop Order vs p99
+// ======================================================
+//
+// ProducerConsumerproblemUsingThread.cpp:
+//
+//     const unsigned int maxBufferSize = 50;
+//     int val = buffer.back();              // LIFO
+//
+// ❌ no number says how long an item waits between push_back and
+//    pop_back, so maxBufferSize is a guess
+// ❌ popping from the back serves the newest item first: under
+//    load the oldest ones are buried and the tail explodes
+//
+// ✅ TracedBuffer.h: the same bounded buffer with a timestamp per
+//    item, a residence-time histogram, FIFO/LIFO switch and a
+//    periodic stats dump (PeriodicReport)
+//
+// Measured here (one producer pushing as fast as it can, one
+// consumer spending ~1 µs per item — the buffer runs full, which
+// is when depth matters):
+//   1. maxBufferSize 5 / 50 / 500 × FIFO / LIFO: items/s and
+//      residence p50 / p99 / p99.9 / max
+//   2. the periodic dump: one line per 100 ms window
+//   3. tracing cost per push + pop pair, one thread: off,
+//      steady_clock, rdtsc
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./queuelat [items] [work_ns]
+//
+//   items    → items per configuration       (default 100000)
+//   work_ns  → consumer work per item         (default 1000)
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread queueLatency.cpp -o queuelat
+//
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include "../Benchmarks/MicroBench.h"
+#include "TracedBuffer.h"
+
+using namespace std;
+using namespace std::chrono;
+
+void work(nanoseconds d) {
+    const auto until = steady_clock::now() + d;
+    while (steady_clock::now() < until) {
+    }
+}
+
+struct Row {
+    double itemsPerSec = 0;
+    ResidenceStats stats;
+    uint64_t sum = 0;
+};
+
+template <typename Buffer>
+Row pump(Buffer& buffer, uint64_t items, nanoseconds perItem) {
+    uint64_t sum = 0;
+    auto start = steady_clock::now();
+    thread consumer([&] {
+        for (uint64_t i = 0; i < items; ++i) {
+            sum += buffer.pop();
+            work(perItem);
+        }
+    });
+    for (uint64_t i = 0; i < items; ++i) buffer.push(i);
+    consumer.join();
+    Row r;
+    r.itemsPerSec = double(items) / duration<double>(steady_clock::now() - start).count();
+    r.stats = buffer.stats();
+    r.sum = sum;
+    return r;
+}
+
+int main(int argc, char** argv) {
+    const long long itemsArg = argc > 1 ? atoll(argv[1]) : 100000;
+    const long long workNs = argc > 2 ? atoll(argv[2]) : 1000;
+    if (itemsArg < 1000 || workNs < 0) {
+        cerr << "usage: queuelat [items >= 1000] [work_ns >= 0]" << endl;
+        return 2;
+    }
+    const uint64_t items = uint64_t(itemsArg);
+    const nanoseconds perItem(workNs);
+    const uint64_t expectedSum = items * (items - 1) / 2;
+    bool ok = true;
+
+    // --------------------------------------------------
+    // 1. Depth × order
+    // --------------------------------------------------
+    cout << "1. " << items << " items, consumer work " << workNs << " ns/item (" << thread::hardware_concurrency()
+         << " CPUs); residence in µs" << endl;
+    printf("  %-6s %-5s %10s %9s %9s %9s %11s\n", "depth", "order", "items/s", "p50", "p99", "p99.9", "max");
+    double fifoP50[3] = {}, fifoMax50 = 0, lifoMax50 = 0;
+    const size_t depths[] = {5, 50, 500};
+    for (int d = 0; d < 3; ++d)
+        for (PopOrder order : {PopOrder::Fifo, PopOrder::Lifo}) {
+            TracedBuffer<uint64_t> buffer(depths[d], order);
+            const Row r = pump(buffer, items, perItem);
+            const bool fifo = order == PopOrder::Fifo;
+            printf("  %-6zu %-5s %10.0f %9.1f %9.1f %9.1f %11.1f\n", depths[d], fifo ? "FIFO" : "LIFO", r.itemsPerSec,
+                   r.stats.p50Ns / 1e3, r.stats.p99Ns / 1e3, r.stats.p999Ns / 1e3, r.stats.maxNs / 1e3);
+            ok = ok && r.sum == expectedSum && r.stats.items == items && r.stats.peakDepth <= depths[d];
+            if (fifo) fifoP50[d] = r.stats.p50Ns;
+            if (depths[d] == 50) (fifo ? fifoMax50 : lifoMax50) = r.stats.maxNs;
+        }
+    // FIFO: an item waits behind everything already queued — a deeper
+    // buffer only adds waiting. LIFO buries the early items
+    ok = ok && fifoP50[0] < fifoP50[1] && fifoP50[1] < fifoP50[2];
+    ok = ok && lifoMax50 > fifoMax50;
+
+    // --------------------------------------------------
+    // 2. Periodic dump
+    // --------------------------------------------------
+    cout << endl << "2. depth 50, FIFO, a window every 100 ms:" << endl;
+    {
+        TracedBuffer<uint64_t> buffer(50, PopOrder::Fifo);
+        uint64_t windows = 0;
+        Row r;
+        {
+            PeriodicReport dump(milliseconds(100), [&] {
+                cout << "  " << format(buffer.takeWindow()) << endl;
+                ++windows;
+            });
+            r = pump(buffer, items * 3, perItem);
+            this_thread::sleep_for(milliseconds(120));    // the last window, then stop
+        }
+        ok = ok && r.sum == items * 3 * (items * 3 - 1) / 2 && windows >= 1;
+    }
+
+    // --------------------------------------------------
+    // 3. Tracing cost
+    // --------------------------------------------------
+    cout << endl << "3. tracing cost (TSC: " << TscStamp::nsPerTick() << " ns/tick)" << endl;
+    {
+        TracedBuffer<uint64_t> off(64, PopOrder::Fifo, false);
+        TracedBuffer<uint64_t, SteadyStamp> steady(64);
+        TracedBuffer<uint64_t, TscStamp> tsc(64);
+        MicroBench bench("push + pop, one thread");
+        bench.add("tracing off", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                off.push(i);
+                doNotOptimize(off.pop());
+            }
+        });
+        bench.add(string("timestamps: ") + SteadyStamp::name, [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                steady.push(i);
+                doNotOptimize(steady.pop());
+            }
+        });
+        bench.add(string("timestamps: ") + TscStamp::name, [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                tsc.push(i);
+                doNotOptimize(tsc.pop());
+            }
+        });
+        bench.run();
+        ok = ok && off.stats().items == 0 && steady.stats().items > 0 && tsc.stats().items > 0;
+    }
+
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. Stamp each item at push and measure at pop: residence time is
+//    the latency the queue adds, and its tail is what users feel.
+// 2. Record into a log-linear (HDR) histogram: constant memory,
+//    bounded relative error, percentiles on demand.
+// 3. A full FIFO adds depth × service time — past the point that
+//    absorbs bursts, a deeper buffer only adds latency.
+// 4. LIFO lowers the median and wrecks the tail: early items stay
+//    buried until the load stops.
+//
+// ⭐ One-Line Interview Answer
+// “Timestamp items in and out of the queue, keep the residence
+// times in an HDR histogram and dump percentiles periodically —
+// then pick the buffer depth and FIFO order from the p99, not
+// from a guess.”
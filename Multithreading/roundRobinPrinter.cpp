@@ -0,0 +1,165 @@
+// =====================================================
+// TOPIC: Round-Robin Printing with barrier + per-thread handoff
+// =====================================================
+//
+// PROBLEMS IN ThreadSynchronization.cpp (MyPrinter):
+//
+// 1. waitforallthreadinit() BUSY-WAITS on
+//        thread_count == thread_ids.size()
+//    → burns a core, and reads the vector while run()
+//      is still push_back()-ing into it (data race)
+//
+// 2. getCurrentThreadId() walks thread_ids LINEARLY every
+//    time a thread prints → O(threads) per turn
+//
+// 3. ONE shared condition_variable + notify_all()
+//    → every turn wakes ALL threads, only one may run
+//    → 64 threads = 63 useless wakeups per turn
+//
+// 4. Characters go to cout one by one
+//
+// -----------------------------------------------------
+// THIS VERSION
+// -----------------------------------------------------
+//
+// 1. std::barrier → all workers start together, no spinning
+// 2. Each worker RECEIVES its index as an argument
+// 3. One binary_semaphore PER THREAD:
+//        thread i waits on turn[i]
+//        when done it releases turn[(i + 1) % n]
+//    → exactly ONE wakeup per turn
+// 4. The char_count characters of a turn are copied into
+//    one buffer and several turns are flushed together
+//    (only the thread holding the turn touches the buffer,
+//     so order is preserved without a mutex)
+//
+// Usage:
+//   ./rr <string> <char_count> <thread_count> [rounds] [turns_per_flush]
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread roundRobinPrinter.cpp -o rr
+//
+#include <barrier>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class RoundRobinPrinter {
+private:
+    string str;
+    int char_count;
+    int thread_count;
+    int rounds;             // turns per thread
+    int turns_per_flush;    // turns collected before one write
+
+    vector<unique_ptr<binary_semaphore>> turn;   // one wake target per thread
+    barrier<> start;                             // startup rendezvous
+
+    // Touched ONLY by the thread that currently holds the turn
+    size_t next_char = 0;
+    string out;
+    int pending_turns = 0;
+
+public:
+    RoundRobinPrinter(string s, int c_count, int t_count, int r, int flushEvery)
+        : str(move(s)), char_count(c_count), thread_count(t_count), rounds(r),
+          turns_per_flush(flushEvery), start(t_count) {
+        for (int i = 0; i < thread_count; ++i)
+            turn.push_back(make_unique<binary_semaphore>(i == 0 ? 1 : 0));
+        out.reserve((size_t)turns_per_flush * (char_count + 24));
+    }
+
+    void run() {
+        vector<thread> threads;
+        threads.reserve(thread_count);
+        for (int i = 0; i < thread_count; ++i)
+            threads.emplace_back(&RoundRobinPrinter::print_thread, this, i);
+        for (auto& t : threads) t.join();
+        flush();
+    }
+
+private:
+    void print_thread(int index) {
+        // Wait until EVERY worker exists (blocks, does not spin)
+        start.arrive_and_wait();
+
+        int next = (index + 1) % thread_count;
+        for (int r = 0; r < rounds; ++r) {
+            turn[index]->acquire();      // only MY semaphore
+            append_chars(index);
+            turn[next]->release();       // wake exactly ONE thread
+        }
+    }
+
+    // One turn: "ThreadId i : <char_count chars>\n" into the batch
+    void append_chars(int index) {
+        out += "ThreadId ";
+        out += to_string(index);
+        out += " : ";
+        for (int k = 0; k < char_count; ++k) {
+            out += str[next_char];
+            if (++next_char == str.size()) next_char = 0;   // wrap around
+        }
+        out += '\n';
+        if (++pending_turns == turns_per_flush) flush();
+    }
+
+    void flush() {
+        fwrite(out.data(), 1, out.size(), stdout);
+        out.clear();
+        pending_turns = 0;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        cout << "Please provide at least 3 arguments - "
+             << "a string, char count & thread count [rounds] [turns_per_flush]" << endl;
+        return 1;
+    }
+
+    string str = argv[1];
+    int char_count = atoi(argv[2]);
+    int thread_count = atoi(argv[3]);
+    int rounds = argc > 4 ? atoi(argv[4]) : 3;
+    int turns_per_flush = argc > 5 ? atoi(argv[5]) : 64;
+
+    if (str.empty() || char_count <= 0 || thread_count <= 0 || rounds <= 0 ||
+        turns_per_flush <= 0) {
+        cout << "string must be non-empty and all counts positive" << endl;
+        return 1;
+    }
+
+    auto t0 = chrono::steady_clock::now();
+    RoundRobinPrinter p(str, char_count, thread_count, rounds, turns_per_flush);
+    p.run();
+    auto ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    cerr << thread_count * rounds << " turns by " << thread_count << " threads in " << ms
+         << " ms" << endl;
+    return 0;
+}
+
+// -----------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// -----------------------------------------------------
+//
+// 1. Never busy-wait for "everyone is ready" → use a barrier.
+// 2. Pass identity (index) INTO the thread; don't search for it.
+// 3. notify_all on a shared cv = thundering herd.
+//    Per-thread semaphores hand the turn to exactly one thread.
+// 4. Semaphore release/acquire also orders memory, so the
+//    shared buffer needs no extra mutex.
+//
+// ⭐ One-Line Interview Answer
+// “Start the workers on a barrier, give each one its index and
+// its own semaphore, and pass the turn along a ring so every
+// handoff wakes exactly one thread.”
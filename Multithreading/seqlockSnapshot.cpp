@@ -0,0 +1,150 @@
+// ==========================================================
+// TOPIC: Reading X/Y Consistently Without Locks (SeqLock)
+// ==========================================================
+//
+// std::try_lock.cpp reads the X/Y pair like this:
+//
+//     if (std::try_lock(m1, m2) == -1) {
+//         XplusY += X + Y;  ...
+//         m1.unlock(); m2.unlock();
+//     }
+//
+// Every reader takes BOTH mutexes → readers serialise with
+// each other AND stall the writers in incrementXY.
+//
+// With SeqLock<XY> (SeqLock.h):
+//     writer:  xy.update([](XY& p) { ++p.x; ++p.y; });
+//     reader:  XY snap = xy.load();          // no lock, retries on change
+//
+// READ-MOSTLY BENCHMARK
+// - 1 writer keeps incrementing X and Y TOGETHER (so every
+//   consistent snapshot has x == y)
+// - 1, 2, 4, 8 reader threads take snapshots for 300 ms
+// - every snapshot is checked: x != y would be a torn read
+//
+// Compared: std::lock(m1, m2) readers vs SeqLock readers.
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread seqlockSnapshot.cpp -o seqlock
+//
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SeqLock.h"
+
+using namespace std;
+using namespace std::chrono;
+
+struct XY {
+    long long x = 0;
+    long long y = 0;
+};
+
+// ---- The original: two mutexes ----
+struct LockedXY {
+    long long X = 0, Y = 0;
+    std::mutex m1, m2;
+
+    void increment() {
+        std::lock(m1, m2);
+        ++X;
+        ++Y;
+        m1.unlock();
+        m2.unlock();
+    }
+    XY read() {
+        std::lock(m1, m2);
+        XY s{X, Y};
+        m1.unlock();
+        m2.unlock();
+        return s;
+    }
+};
+
+// ---- SeqLock ----
+struct SeqXY {
+    SeqLock<XY> xy;
+    void increment() { xy.update([](XY& p) { ++p.x; ++p.y; }); }
+    XY read() { return xy.load(); }
+};
+
+struct Result {
+    double readsPerSec;
+    double writesPerSec;
+    long long torn;
+};
+
+template <typename Store>
+Result run(int readers, milliseconds runFor) {
+    Store store;
+    atomic<bool> stop{false};
+    atomic<long long> reads{0}, torn{0};
+    long long writes = 0;
+
+    thread writer([&] {
+        volatile unsigned work = 0;
+        while (!stop.load(memory_order_relaxed)) {
+            store.increment();
+            ++writes;
+            for (int i = 0; i < 100; ++i) work = work + i;  // writers also do other work
+        }
+    });
+
+    vector<thread> rs;
+    for (int r = 0; r < readers; ++r)
+        rs.emplace_back([&] {
+            long long n = 0, bad = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                XY s = store.read();
+                bad += (s.x != s.y);
+                ++n;
+            }
+            reads += n;
+            torn += bad;
+        });
+
+    this_thread::sleep_for(runFor);
+    stop = true;
+    writer.join();
+    for (auto& t : rs) t.join();
+
+    double secs = duration<double>(runFor).count();
+    return {reads / secs, writes / secs, torn.load()};
+}
+
+int main() {
+    cout << "hardware threads: " << thread::hardware_concurrency() << endl;
+    const milliseconds runFor(300);
+
+    for (int readers : {1, 2, 4, 8}) {
+        Result locked = run<LockedXY>(readers, runFor);
+        Result seq = run<SeqXY>(readers, runFor);
+        cout << readers << " reader(s):" << endl;
+        cout << "  std::lock(m1,m2): " << locked.readsPerSec / 1e6 << " M reads/s, "
+             << locked.writesPerSec / 1e6 << " M writes/s, torn " << locked.torn << endl;
+        cout << "  SeqLock         : " << seq.readsPerSec / 1e6 << " M reads/s, "
+             << seq.writesPerSec / 1e6 << " M writes/s, torn " << seq.torn << endl;
+    }
+    return 0;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A seqlock reader only READS shared memory: no lock, no
+//    atomic RMW, so readers don't slow each other down.
+// 2. Odd version = write in progress; a changed version =
+//    the snapshot may be torn → retry.
+// 3. The data must be copyable as raw bytes, and copied with
+//    atomic (relaxed) accesses to avoid a C++ data race.
+// 4. Best for SMALL data, FREQUENT reads and RARE(ish) writes
+//    — with constant writes, readers can retry forever.
+//
+// ⭐ One-Line Interview Answer
+// “A seqlock lets readers take a lock-free snapshot by
+// checking a version counter before and after the copy, while
+// writers just bump the version around each update.”
@@ -0,0 +1,406 @@
+// ==========================================================
+// TOPIC: Producer / Consumer between Processes — Zero-Copy Shared-Memory Ring
+// ==========================================================
+//
+// ProducerConsumerproblemUsingThread.cpp / pucerconsumer.cpp:
+//
+//     std::thread t1(producer, 100);      // both sides in ONE process,
+//     std::thread t2(consumer);           // one buffer in one address space
+//
+// and Threads/mutex.cpp's CreateMutex(..., "MUTEX1") names a lock
+// so that OTHER processes can find it.
+//
+// ❌ split into processes the naive way (a pipe, a socket), every
+//    message is copied into the kernel by write() and out again by
+//    read(): two copies and two system calls per message
+//
+// ✅ ShmRing.h: a shared-memory segment with one lane per
+//    producer; the producer builds the message IN the ring
+//    (reserve / commit), the consumer reads it THERE (read /
+//    release); head and tail are shared words, futexes wake a
+//    sleeping side; a crashed producer or consumer is taken over
+//
+// Measured here:
+//   1. GB/s, one producer process → one consumer process, for
+//      256 B, 4 KB and 64 KB messages: a pipe (write / read,
+//      1 MB pipe buffer) vs ShmRing. Both producers fill every
+//      byte, both consumers read every byte and check it
+//   2. 4 producer processes → 1 consumer: every message arrives
+//      once, in order per producer
+//   3. producer crash: a producer dies holding a half-written
+//      message — the consumer sees exactly the messages it had
+//      flushed; a new producer process takes the lane over
+//   4. consumer crash: a consumer dies mid-stream — a new consumer
+//      process takes over; nothing is lost, the messages released
+//      but not yet published are delivered again (counted)
+//   5. misuse: another geometry, a second consumer, an oversized
+//      message — all rejected
+//
+// Both sides run at once only with two or more cores. On one core
+// (this sandbox) they take turns, a lane's worth of messages per
+// switch, so the numbers are one core filling AND checking every
+// byte; with a core per side the ring's work overlaps and
+// memory bandwidth is the limit.
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./shmring [MB per run] [lane MB]
+//
+//   MB per run → MB sent for each message size (default 1024)
+//   lane MB    → ShmRing lane size in MB      (default 8)
+//
+// Build:
+//   g++ -std=c++20 -O2 shmRingIpc.cpp -o shmring
+//
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "ShmRing.h"
+
+using namespace std;
+using namespace std::chrono;
+
+const string kName = "oops_shm_ring_demo";
+
+// ---- the payload: a sequence number, then bytes derived from it ----
+void fill(byte* p, size_t n, uint64_t seq) {
+    if (n >= 8) memcpy(p, &seq, 8);
+    if (n > 8) memset(p + 8, int(seq & 0xff), n - 8);
+}
+
+// Reads every byte; false if the message is not `seq`'s
+bool check(const byte* p, size_t n, uint64_t seq) {
+    uint64_t got = 0;
+    if (n >= 8) memcpy(&got, p, 8);
+    if (n >= 8 && got != seq) return false;
+    uint64_t acc = 0, want = 0;
+    const size_t words = n > 8 ? (n - 8) / 8 : 0;
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t w;
+        memcpy(&w, p + 8 + 8 * i, 8);
+        acc ^= w;
+    }
+    if (words) want = (words & 1) ? 0x0101010101010101ull * (seq & 0xff) : 0;
+    return acc == want;
+}
+
+int waitExit(pid_t pid) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// ---- 1. throughput ----
+double pipeGbps(size_t msg, uint64_t count, bool& ok) {
+    int fds[2];
+    if (pipe(fds) != 0) throw system_error(errno, generic_category(), "pipe");
+    fcntl(fds[1], F_SETPIPE_SZ, 1 << 20);
+    const auto t0 = steady_clock::now();
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        vector<byte> buf(msg);
+        for (uint64_t i = 0; i < count; ++i) {
+            fill(buf.data(), msg, i);
+            for (size_t done = 0; done < msg;) {
+                const ssize_t w = write(fds[1], buf.data() + done, msg - done);
+                if (w <= 0) _exit(1);
+                done += size_t(w);
+            }
+        }
+        _exit(0);
+    }
+    close(fds[1]);
+    vector<byte> buf(msg);
+    for (uint64_t i = 0; i < count; ++i) {
+        for (size_t done = 0; done < msg;) {
+            const ssize_t r = read(fds[0], buf.data() + done, msg - done);
+            if (r <= 0) {
+                ok = false;
+                break;
+            }
+            done += size_t(r);
+        }
+        ok = ok && check(buf.data(), msg, i);
+    }
+    close(fds[0]);
+    ok = ok && waitExit(pid) == 0;
+    return double(msg) * double(count) / duration<double>(steady_clock::now() - t0).count() / 1e9;
+}
+
+double ringGbps(size_t msg, uint64_t count, size_t laneBytes, bool& ok) {
+    ShmRing::remove(kName);
+    ShmRing ring(kName, 1, laneBytes);
+    ShmRing::Consumer consumer(ring);
+    const auto t0 = steady_clock::now();
+    const pid_t pid = fork();
+    if (pid == 0) {
+        ShmRing::Producer producer(ring);
+        for (uint64_t i = 0; i < count; ++i) {
+            fill(producer.reserve(msg).data(), msg, i);
+            producer.commit(msg);
+        }
+        producer.flush();
+        _exit(0);
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+        const ShmRing::Message m = consumer.read();
+        ok = ok && m.bytes.size() == msg && check(m.bytes.data(), msg, i);
+        consumer.release();
+    }
+    ok = ok && waitExit(pid) == 0;
+    return double(msg) * double(count) / duration<double>(steady_clock::now() - t0).count() / 1e9;
+}
+
+// ---- 2. several producer processes ----
+bool manyProducers(unsigned producers, uint64_t perProducer) {
+    ShmRing::remove(kName);
+    ShmRing ring(kName, producers, 1 << 20);
+    ShmRing::Consumer consumer(ring);
+    vector<pid_t> pids;
+    for (unsigned p = 0; p < producers; ++p) {
+        const pid_t pid = fork();
+        if (pid == 0) {
+            ShmRing::Producer producer(ring);
+            mt19937 rng(p + 1);
+            uniform_int_distribution<size_t> size(16, 2048);
+            for (uint64_t i = 0; i < perProducer; ++i) {
+                const size_t n = size(rng);
+                byte* b = producer.reserve(n).data();
+                fill(b, n, (uint64_t(p) << 40) | i);
+                producer.commit(n);
+            }
+            producer.flush();
+            _exit(0);
+        }
+        pids.push_back(pid);
+    }
+    bool ok = true;
+    vector<uint64_t> next(producers, 0);
+    vector<int> laneOf(producers, -1);
+    for (uint64_t k = 0; k < producers * perProducer; ++k) {
+        const ShmRing::Message m = consumer.read();
+        uint64_t seq = 0;
+        memcpy(&seq, m.bytes.data(), 8);
+        const unsigned p = unsigned(seq >> 40);
+        if (p >= producers) return false;
+        if (laneOf[p] < 0) laneOf[p] = int(m.lane);
+        ok = ok && laneOf[p] == int(m.lane) && (seq & ((1ull << 40) - 1)) == next[p]++ &&
+             check(m.bytes.data(), m.bytes.size(), seq);
+        consumer.release();
+    }
+    for (pid_t pid : pids) ok = ok && waitExit(pid) == 0;
+    for (uint64_t n : next) ok = ok && n == perProducer;
+    ShmRing::Message extra;
+    return ok && !consumer.try_read(extra);
+}
+
+// ---- 3. a producer dies mid-message ----
+bool producerCrash(uint64_t flushed, uint64_t after) {
+    ShmRing::remove(kName);
+    ShmRing ring(kName, 1, 1 << 20);
+    ShmRing::Consumer consumer(ring);
+    pid_t pid = fork();
+    if (pid == 0) {
+        ShmRing ours(kName, 1, 1 << 20);            // opened by name, as another program would
+        ShmRing::Producer producer(ours);
+        for (uint64_t i = 0; i < flushed; ++i) {
+            fill(producer.reserve(64).data(), 64, i);
+            producer.commit(64);
+        }
+        producer.flush();
+        fill(producer.reserve(4096).data(), 2048, 999999);   // half written, never committed
+        _exit(0);                                             // no destructors: a crash
+    }
+    bool ok = waitExit(pid) == 0 && ring.consumerAlive();   // the child died, we did not
+    uint64_t got = 0;
+    ShmRing::Message m;
+    while (consumer.try_read(m)) {
+        ok = ok && check(m.bytes.data(), m.bytes.size(), got++);
+        consumer.release();
+    }
+    ok = ok && got == flushed;
+
+    pid = fork();
+    if (pid == 0) {
+        ShmRing ours(kName, 1, 1 << 20);
+        ShmRing::Producer producer(ours);
+        for (uint64_t i = 0; i < after; ++i) {
+            fill(producer.reserve(64).data(), 64, flushed + i);
+            producer.commit(64);
+        }
+        producer.flush();
+        _exit(producer.tookOver() ? 0 : 3);
+    }
+    for (uint64_t i = 0; i < after; ++i) {
+        const ShmRing::Message r = consumer.read();
+        ok = ok && check(r.bytes.data(), r.bytes.size(), flushed + i);
+        consumer.release();
+    }
+    return ok && waitExit(pid) == 0;
+}
+
+// ---- 4. the consumer dies mid-stream ----
+bool consumerCrash(uint64_t total, uint64_t beforeCrash, uint64_t& redelivered) {
+    ShmRing::remove(kName);
+    ShmRing ring(kName, 1, 1 << 20);
+    const pid_t producer = fork();
+    if (producer == 0) {
+        ShmRing::Producer p(ring);
+        for (uint64_t i = 0; i < total; ++i) {
+            fill(p.reserve(64).data(), 64, i);
+            p.commit(64);
+        }
+        p.flush();
+        _exit(0);
+    }
+    const pid_t first = fork();
+    if (first == 0) {
+        ShmRing::Consumer c(ring);
+        uint64_t i = 0;
+        for (; i < beforeCrash; ++i) {
+            const ShmRing::Message m = c.read();
+            if (!check(m.bytes.data(), m.bytes.size(), i)) break;
+            c.release();
+        }
+        _exit(i == beforeCrash ? 0 : 1);                      // no destructors: a crash
+    }
+    bool ok = waitExit(first) == 0;
+    ShmRing::Consumer second(ring);
+    ok = ok && second.tookOver();
+    ShmRing::Message m = second.read();
+    uint64_t seq = 0;
+    memcpy(&seq, m.bytes.data(), 8);
+    ok = ok && seq <= beforeCrash;                            // nothing skipped
+    redelivered = beforeCrash - seq;
+    for (;;) {
+        ok = ok && check(m.bytes.data(), m.bytes.size(), seq);
+        second.release();
+        if (++seq == total) break;
+        m = second.read();
+    }
+    return ok && waitExit(producer) == 0;
+}
+
+// ---- 5. misuse ----
+bool misuse() {
+    ShmRing::remove(kName);
+    ShmRing ring(kName, 2, 1 << 16);
+    bool ok = true;
+    try {
+        ShmRing other(kName, 3, 1 << 16);
+        ok = false;
+    } catch (const invalid_argument&) {
+    }
+    ShmRing::Consumer c(ring);
+    try {
+        ShmRing::Consumer again(ring);
+        ok = false;
+    } catch (const runtime_error&) {
+    }
+    ShmRing::Producer p(ring);
+    try {
+        p.reserve(ring.maxMessage() + 1);
+        ok = false;
+    } catch (const invalid_argument&) {
+    }
+    ShmRing::Message m;
+    ok = ok && !c.try_read(m);
+    try {
+        c.release();
+        ok = false;
+    } catch (const logic_error&) {
+    }
+    // the largest message fits at any offset
+    for (int i = 0; i < 5; ++i) {
+        fill(p.reserve(ring.maxMessage()).data(), ring.maxMessage(), uint64_t(i));
+        p.commit(ring.maxMessage());
+        p.flush();
+        ok = ok && c.try_read(m) && check(m.bytes.data(), m.bytes.size(), uint64_t(i));
+        c.release();
+        fill(p.reserve(100).data(), 100, 7);
+        p.commit(100);
+        p.flush();
+        ok = ok && c.try_read(m) && m.bytes.size() == 100;
+        c.release();
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    const long mbPerRun = argc > 1 ? atol(argv[1]) : 1024;
+    const long laneMb = argc > 2 ? atol(argv[2]) : 8;
+    if (mbPerRun < 1 || laneMb < 1 || laneMb > 1024) {
+        cerr << "usage: shmring [MB per run >= 1] [lane MB 1..1024]" << endl;
+        return 2;
+    }
+    const uint64_t bytes = uint64_t(mbPerRun) << 20;
+    const size_t laneBytes = size_t(laneMb) << 20;
+    cout << mbPerRun << " MB per run, lane " << laneMb << " MB, " << thread::hardware_concurrency() << " core(s)"
+         << endl
+         << endl;
+
+    bool ok = true;
+    printf("  %-10s %12s %12s %9s\n", "message", "pipe", "ShmRing", "speedup");
+    for (size_t msg : {size_t(256), size_t(4096), size_t(65536)}) {
+        const uint64_t count = bytes / msg;
+        bool pipeOk = true, ringOk = true;
+        const double viaPipe = pipeGbps(msg, count, pipeOk);
+        const double viaRing = ringGbps(msg, count, laneBytes, ringOk);
+        ok = ok && pipeOk && ringOk;
+        printf("  %-10zu %8.2f GB/s %7.2f GB/s %8.2fx%s\n", msg, viaPipe, viaRing, viaRing / viaPipe,
+               pipeOk && ringOk ? "" : "   WRONG DATA");
+    }
+
+    const bool many = manyProducers(4, 50000);
+    const bool pCrash = producerCrash(1000, 500);
+    uint64_t redelivered = 0;
+    const bool cCrash = consumerCrash(200000, 70000, redelivered);
+    const bool bad = misuse();
+    ShmRing::remove(kName);
+    printf("\n  4 producer processes × 50000 messages, FIFO per producer: %s\n", many ? "ok" : "FAILED");
+    printf("  producer crash mid-message, lane taken over:             %s\n", pCrash ? "ok" : "FAILED");
+    printf("  consumer crash, taken over, nothing lost:                %s (%llu redelivered)\n",
+           cCrash ? "ok" : "FAILED", (unsigned long long)redelivered);
+    printf("  misuse rejected, largest message at every offset:        %s\n", bad ? "ok" : "FAILED");
+    ok = ok && many && pCrash && cCrash && bad;
+
+    cout << endl << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. Shared memory removes the kernel from the data path: the
+//    producer writes the message where the consumer will read it —
+//    no copy in, no copy out, no system call per message.
+// 2. Keep the protocol SPSC per lane (one writer per index) and
+//    give each producer its own lane: MPSC without a CAS on the
+//    fast path.
+// 3. Futexes on words in the segment let either side sleep and be
+//    woken across processes; the kernel is entered only when
+//    someone actually sleeps.
+// 4. Crash safety comes from publishing indices only after the
+//    bytes are final: a dead producer's half message was never
+//    visible, a dead consumer's head is where the next one starts.
+//
+// ⭐ One-Line Interview Answer
+// “Map one shared segment with a lane per producer, let producers
+// build messages in place and publish a tail, let the consumer read
+// them there and publish a head, sleep on futexes only when empty
+// or full — zero copies, no syscalls per message, and a crashed
+// side can be taken over from the published indices.”
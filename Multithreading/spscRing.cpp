@@ -0,0 +1,203 @@
+// ======================================================
+// TOPIC: Single Producer / Single Consumer Fast Path
+// ======================================================
+//
+// ProducerConsumerproblemUsingThread.cpp:
+//
+//     std::thread t1(producer, 100);        // exactly one producer
+//     std::thread t2(consumer);             // exactly one consumer
+//
+//     unique_lock + cond.wait + push_back + unlock + notify_one
+//
+// ❌ every item: a lock RMW, a predicate check, a notify, and the
+//    mutex, the deque and its size bouncing between the two cores
+// ❌ MPMCQueue.h drops the lock, but still CASes a shared position
+//    and a per-slot sequence — paid for producers that do not exist
+//
+// ✅ SpscRing.h: one writer per index, so no lock and no RMW —
+//    plain stores into the slots, one release store per BATCH of
+//    items, cached copies of the other side's index, blocking
+//    (std::atomic::wait) only when empty or full
+//
+// Measured here (items/s, one producer thread → one consumer
+// thread, pinned to CPUs 0 and 1 when there are two):
+//   1. mutex + condition_variable + deque (the original, no cout)
+//   2. MPMCQueue with one thread per side
+//   3. SpscRing, index published every item (batch 1)
+//   4. SpscRing, batched publication (default 32)
+// Every consumer checks it received each item exactly once; the
+// rings also check FIFO order.
+//
+// The two threads only run side by side with two CPUs; on one CPU
+// they take turns and every number is a time-slicing number.
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./spsc [items] [capacity] [batch]
+//
+//   items     → items sent                       (default 20000000)
+//   capacity  → ring capacity                    (default 1024)
+//   batch     → SpscRing publication batch (row 4, default 32)
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread spscRing.cpp -o spsc
+//
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <pthread.h>
+#include "MPMCQueue.h"
+#include "SpscRing.h"
+
+using namespace std;
+using namespace std::chrono;
+
+const unsigned int maxBufferSize = 50;    // as in the original
+
+struct RunResult {
+    double itemsPerSec = 0;
+    bool ok = false;
+};
+
+void pinTo(unsigned cpu) {
+    if (thread::hardware_concurrency() < 2) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof set, &set);
+}
+
+// produce(i) for i in [0, items), consume() → item; the consumer
+// checks the sum, and the order when `fifo`
+template <typename Produce, typename Consume>
+RunResult run(uint64_t items, bool fifo, Produce produce, Consume consume) {
+    uint64_t sum = 0;
+    bool ordered = true;
+    auto start = steady_clock::now();
+    thread consumer([&] {
+        pinTo(1);
+        uint64_t s = 0;
+        bool o = true;
+        for (uint64_t i = 0; i < items; ++i) {
+            const uint64_t v = consume();
+            o = o && (!fifo || v == i);
+            s += v;
+        }
+        sum = s;
+        ordered = o;
+    });
+    thread producer([&] {
+        pinTo(0);
+        for (uint64_t i = 0; i < items; ++i) produce(i);
+    });
+    producer.join();
+    consumer.join();
+    const double s = duration<double>(steady_clock::now() - start).count();
+    return {double(items) / s, ordered && sum == items * (items - 1) / 2};
+}
+
+RunResult mutexCondvar(uint64_t items) {
+    condition_variable cond;
+    deque<uint64_t> buffer;
+    mutex mu;
+    return run(
+        items, false,
+        [&](uint64_t v) {
+            unique_lock<mutex> locker(mu);
+            cond.wait(locker, [&] { return buffer.size() < maxBufferSize; });
+            buffer.push_back(v);
+            locker.unlock();
+            cond.notify_one();
+        },
+        [&] {
+            unique_lock<mutex> locker(mu);
+            cond.wait(locker, [&] { return buffer.size() > 0; });
+            uint64_t v = buffer.back();
+            buffer.pop_back();
+            locker.unlock();
+            cond.notify_one();
+            return v;
+        });
+}
+
+RunResult mpmc(uint64_t items, size_t capacity) {
+    MPMCQueue<uint64_t> q(capacity);
+    return run(items, true, [&](uint64_t v) { q.push(v); }, [&] { return q.pop(); });
+}
+
+RunResult spsc(uint64_t items, size_t capacity, size_t batch) {
+    SpscRing<uint64_t> ring(capacity, batch);
+    return run(
+        items, true,
+        [&](uint64_t v) {
+            ring.push(v);
+            if (v + 1 == items) ring.flush();        // the last, partial batch
+        },
+        [&] { return ring.pop(); });
+}
+
+int main(int argc, char** argv) {
+    const long long itemsArg = argc > 1 ? atoll(argv[1]) : 20000000;
+    const long long capacity = argc > 2 ? atoll(argv[2]) : 1024;
+    const long long batch = argc > 3 ? atoll(argv[3]) : (long long)SpscRing<uint64_t>::kDefaultBatch;
+    if (itemsArg < 1 || capacity < 1 || batch < 1) {
+        cerr << "usage: spsc [items >= 1] [capacity >= 1] [batch >= 1]" << endl;
+        return 2;
+    }
+    const uint64_t items = uint64_t(itemsArg);
+    const unsigned cpus = thread::hardware_concurrency();
+    cout << items << " items, 1 producer -> 1 consumer, capacity " << capacity << " (" << cpus << " CPUs"
+         << (cpus >= 2 ? ", pinned to 0 and 1" : ", threads take turns") << ")" << endl;
+
+    const RunResult rows[] = {
+        mutexCondvar(items),
+        mpmc(items, size_t(capacity)),
+        spsc(items, size_t(capacity), 1),
+        spsc(items, size_t(capacity), size_t(batch)),
+    };
+    const string names[] = {
+        "mutex + condvar + deque (" + to_string(maxBufferSize) + ")",
+        "MPMCQueue",
+        "SpscRing, batch 1",
+        "SpscRing, batch " + to_string(batch),
+    };
+    bool ok = true;
+    for (int i = 0; i < 4; ++i) {
+        printf("  %-30s %9.1f M items/s %8.1fx\n", names[i].c_str(), rows[i].itemsPerSec / 1e6,
+               rows[i].itemsPerSec / rows[0].itemsPerSec);
+        ok = ok && rows[i].ok;
+    }
+    // Throughput is reported, not checked: rows[i].ok is delivery
+    // (the checksum, and the order for the FIFO queues)
+
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. One producer and one consumer: each index has ONE writer, so
+//    a release store replaces the lock and every RMW.
+// 2. Cache the other side's index; re-read it only when the ring
+//    looks full or empty.
+// 3. Publish in batches: the consumer's cache line is invalidated
+//    once per batch instead of once per item.
+// 4. Block only at the edges (full / empty), and notify only when
+//    the other side is actually asleep.
+//
+// ⭐ One-Line Interview Answer
+// “With exactly one producer and one consumer, a ring where each
+// side owns its index — cached, published in batches, parked with
+// atomic::wait only when empty or full — replaces the mutex and
+// condition variable and moves items an order of magnitude faster.”
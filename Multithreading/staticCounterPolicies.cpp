@@ -0,0 +1,135 @@
+// ==========================================================
+// TOPIC: Fixing `static int s; ++s;` Four Ways (and Measuring)
+// ==========================================================
+//
+// staticVarSafe.cpp: two threads run fun(), each doing ++s
+// 100000 times on ONE `static int s` → lost updates, the
+// result is rarely 200000.
+//
+// ReduceCounter.h offers the fixes behind one API, so fun()
+// is written once and the policy is a template argument:
+//
+//     template <typename Policy> void fun(Counter<Policy>& s, int index);
+//
+// Measured here:
+// 1. staticVarSafe.cpp exactly (2 threads x 100000) — every
+//    correct policy must print 200000
+// 2. scaling, 1..32 threads x 1M increments each:
+//    racy (relaxed load+store: no UB, same lost updates),
+//    AtomicAdd, MutexAdd, Sharded, ThreadLocalReduce
+//    (ThreadLocalReduce's loop folds to one add: no other
+//    thread can see the local, so the compiler may sum it up)
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread staticCounterPolicies.cpp -o counterpolicies
+//
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "ReduceCounter.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// The original race, kept UB-free for the benchmark
+struct Racy {};
+template <typename T>
+class Counter<Racy, T> {
+public:
+    class Handle {
+    public:
+        explicit Handle(Counter& c) : c_(c) {}
+        void add(T v) { c_.s_.store(c_.s_.load(memory_order_relaxed) + v, memory_order_relaxed); }
+
+    private:
+        Counter& c_;
+    };
+    Handle handle() { return Handle(*this); }
+    T value() const { return s_.load(); }
+
+private:
+    atomic<T> s_{0};
+};
+
+template <typename Policy>
+auto handleFor(Counter<Policy>& s, int index) {
+    if constexpr (is_same_v<Policy, ThreadLocalReduce>) return s.handle(index);
+    else return s.handle();
+}
+
+// staticVarSafe.cpp's fun(), policy-agnostic
+template <typename Policy>
+void fun(Counter<Policy>& s, int index, long long count) {
+    auto h = handleFor(s, index);
+    while (count--) h.add(1);
+}
+
+template <typename Policy>
+pair<double, long long> run(int threads, long long perThread) {
+    Counter<Policy> s;
+    vector<thread> pool;
+    auto t0 = steady_clock::now();
+    for (int t = 0; t < threads; ++t) pool.emplace_back([&, t] { fun(s, t, perThread); });
+    for (auto& th : pool) th.join();
+    double ms = duration<double, milli>(steady_clock::now() - t0).count();
+    return {ms, s.value()};
+}
+
+int main() {
+    bool ok = true;
+
+    // ---- 1. staticVarSafe.cpp: 2 threads x 100000 ----
+    cout << "2 threads x 100000 (+1 each):" << endl;
+    auto check = [&](const char* name, long long got, bool mustBeExact) {
+        cout << "  " << setw(18) << left << name << got << (got == 200000 ? "  ✔" : "  ✘") << endl;
+        if (mustBeExact && got != 200000) ok = false;
+    };
+    check("racy", run<Racy>(2, 100000).second, false);
+    check("AtomicAdd", run<AtomicAdd>(2, 100000).second, true);
+    check("MutexAdd", run<MutexAdd>(2, 100000).second, true);
+    check("Sharded", run<Sharded>(2, 100000).second, true);
+    check("ThreadLocalReduce", run<ThreadLocalReduce>(2, 100000).second, true);
+
+    // ---- 2. Scaling ----
+    constexpr long long perThread = 1'000'000;
+    cout << "\nms for N threads x " << perThread << " increments (" << thread::hardware_concurrency()
+         << " hardware threads):" << endl;
+    cout << setw(8) << "threads" << setw(10) << "racy" << setw(12) << "AtomicAdd" << setw(12) << "MutexAdd"
+         << setw(12) << "Sharded" << setw(14) << "ThreadLocal" << endl;
+    for (int threads : {1, 2, 4, 8, 16, 32}) {
+        const long long expected = threads * perThread;
+        auto r = run<Racy>(threads, perThread);
+        auto a = run<AtomicAdd>(threads, perThread);
+        auto m = run<MutexAdd>(threads, perThread);
+        auto s = run<Sharded>(threads, perThread);
+        auto t = run<ThreadLocalReduce>(threads, perThread);
+        cout << fixed << setprecision(1) << setw(8) << threads << setw(10) << r.first << setw(12) << a.first
+             << setw(12) << m.first << setw(12) << s.first << setw(14) << t.first
+             << (r.second == expected ? "" : "   (racy lost updates)") << endl;
+        if (a.second != expected || m.second != expected || s.second != expected || t.second != expected)
+            ok = false;
+    }
+    cout << "correct policies exact: " << (ok ? "yes" : "NO") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. `static` controls lifetime, not synchronisation: ++s on
+//    a shared static is a read-modify-write race.
+// 2. atomic and mutex make it correct by SERIALISING every
+//    increment on one cache line / one lock.
+// 3. If nobody needs the value until the threads finish,
+//    count privately per thread and reduce once at join.
+// 4. Reducing in a FIXED order (thread index) makes even
+//    floating-point sums reproducible.
+//
+// ⭐ One-Line Interview Answer
+// “Don't share the counter: let each thread accumulate
+// locally and combine the partial results in a fixed order
+// after join — correct, deterministic and contention-free.”
@@ -41,10 +41,12 @@
 #include <thread>
 #include <future>
 #include <algorithm>
+#include "Trace.h"     // TRACE_FILE=trace.json ./a.out: findOdd vs main's get() on a timeline
 using namespace std;
 using namespace std::chrono;
 typedef long int ull;
 void findOdd(std::promise<ull>&& OddSumPromise, ull start, ull end) {
+    TRACE_SCOPE("findOdd");
 
     ull OddSum = 0;
 
@@ -0,0 +1,307 @@
+// ==========================================================
+// TOPIC: Cooperative Shutdown — std::jthread + stop_token
+// ==========================================================
+//
+// pucerconsumer.cpp:                     while (1) { signal_to_producer.acquire(); ... }
+// ProducerConsumerproblemUsingThread.cpp: while (true) { cond.wait(locker, ...); ... }
+// Threads/priority.cpp:                  while (true) { ...; Sleep(500); }
+//
+// ❌ none of these loops can end: a thread blocked in acquire() or
+//    wait() never looks at a flag, so shutdown is a kill
+// ❌ the usual patch — a flag plus timed waits polled in a loop —
+//    makes shutdown take up to one poll period, and wakes idle
+//    threads for nothing every period
+//
+// ✅ StopWait.h: the same loops on std::jthread; every blocking
+//    wait takes the thread's stop_token (condition_variable_any's
+//    stop-aware wait, StopSemaphore::acquire, sleepFor), and
+//    request_stop() wakes it at once
+//
+// Measured here:
+//   1. the three loops rebuilt (semaphore ping-pong, bounded
+//      queue, the periodic worker) do their work, then stop
+//   2. shutdown latency — request_stop() to join() returning —
+//      for a thread blocked in each kind of wait, stop-aware vs
+//      flag + polled timed wait; and the original blocking call,
+//      which does not return at all
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./stoptoken [trials] [poll ms]
+//
+//   trials  → shutdowns measured per stop-aware wait     (default 50)
+//   poll ms → period of the polled baseline's timed wait  (default 100)
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread stopTokenShutdown.cpp -o stoptoken
+//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+#include "StopWait.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ---- 1. the three loops, stoppable ----
+
+constexpr int kBuff = 5;
+
+// pucerconsumer.cpp: two binary semaphores hand the buffer back and forth
+struct PingPong {
+    StopSemaphore<1> toProducer{1}, toConsumer{0};
+    int buff[kBuff]{};
+    atomic<long> rounds{0};
+    atomic<bool> corrupt{false};
+
+    void producer(stop_token st) {
+        for (int round = 0; toProducer.acquire(st); ++round) {
+            for (int i = 0; i < kBuff; ++i) buff[i] = i * i + round;
+            toConsumer.release();
+        }
+    }
+    void consumer(stop_token st) {
+        for (int round = 0; toConsumer.acquire(st); ++round) {
+            for (int i = kBuff - 1; i >= 0; --i) {
+                if (buff[i] != i * i + round) corrupt = true;
+                buff[i] = 0;
+            }
+            rounds.fetch_add(1, memory_order_relaxed);
+            toProducer.release();
+        }
+    }
+};
+
+// ProducerConsumerproblemUsingThread.cpp: producer counts val down
+// to 0 and ends; the consumer used to wait forever after that
+struct Buffered {
+    StopQueue<int> queue{50};
+    atomic<long> consumed{0}, sum{0};
+
+    void producer(stop_token st, int val) {
+        while (val && queue.push(st, val)) --val;
+    }
+    void consumer(stop_token st) {
+        while (optional<int> v = queue.pop(st)) {
+            sum.fetch_add(*v, memory_order_relaxed);
+            consumed.fetch_add(1, memory_order_relaxed);
+        }
+    }
+};
+
+// Threads/priority.cpp: MyThreadFunction, work then Sleep(500)
+void myThreadFunction(stop_token st, atomic<long>& ticks) {
+    do ticks.fetch_add(1, memory_order_relaxed);
+    while (sleepFor(st, milliseconds(500)));
+}
+
+// ---- 2. shutdown latency ----
+
+struct Latency {
+    vector<double> us;
+    double median() {
+        sort(us.begin(), us.end());
+        return us.empty() ? 0 : us[us.size() / 2];
+    }
+    double max() const { return us.empty() ? 0 : *max_element(us.begin(), us.end()); }
+};
+
+// `body` runs on a thread until stopped (token or flag); the stop
+// lands at a random point 1..spreadMs ms after the thread started,
+// so a polled wait is caught anywhere in its period
+Latency shutdowns(int trials, const function<void(stop_token, atomic<bool>&)>& body, bool useJthreadStop,
+                  int spreadMs, mt19937& rng) {
+    Latency lat;
+    uniform_int_distribution<int> delay(1, spreadMs);
+    for (int t = 0; t < trials; ++t) {
+        atomic<bool> flag{true};
+        jthread th([&](stop_token st) { body(st, flag); });
+        this_thread::sleep_for(milliseconds(delay(rng)));
+        const auto t0 = steady_clock::now();
+        if (useJthreadStop) th.request_stop();
+        else flag = false;
+        th.join();
+        lat.us.push_back(duration<double, micro>(steady_clock::now() - t0).count());
+    }
+    return lat;
+}
+
+int main(int argc, char** argv) {
+    const int trials = argc > 1 ? atoi(argv[1]) : 50;
+    const int pollMs = argc > 2 ? atoi(argv[2]) : 100;
+    if (trials < 1 || pollMs < 1) {
+        cerr << "usage: stoptoken [trials>=1] [poll ms>=1]" << endl;
+        return 2;
+    }
+    bool ok = true;
+    const milliseconds poll(pollMs);
+
+    // ---- 1. the loops work and then stop ----
+    {
+        PingPong pp;
+        jthread prod([&](stop_token st) { pp.producer(st); });
+        jthread cons([&](stop_token st) { pp.consumer(st); });
+        while (pp.rounds < 20000) this_thread::yield();
+        prod.request_stop(), cons.request_stop();
+        prod.join(), cons.join();
+        const bool good = !pp.corrupt && pp.rounds >= 20000;
+        cout << "semaphore ping-pong:  " << pp.rounds << " rounds, buffer " << (pp.corrupt ? "CORRUPT" : "intact")
+             << ", both threads stopped" << endl;
+        ok = ok && good;
+    }
+    {
+        Buffered b;
+        const int val = 100000;
+        jthread cons([&](stop_token st) { b.consumer(st); });
+        jthread prod([&](stop_token st) { b.producer(st, val); });
+        prod.join();                                        // the producer ends by itself
+        while (b.consumed < val) this_thread::yield();       // queue drained, consumer now blocked in pop
+        cons.request_stop();
+        cons.join();
+        const bool good = b.consumed == val && b.sum == long(val) * (val + 1) / 2;
+        cout << "bounded queue:        " << b.consumed << " items consumed (sum " << (good ? "correct" : "WRONG")
+             << "), idle consumer stopped" << endl;
+        ok = ok && good;
+    }
+    {
+        atomic<long> ticks{0};
+        jthread worker(myThreadFunction, ref(ticks));
+        this_thread::sleep_for(milliseconds(1100));
+        const auto t0 = steady_clock::now();
+        worker.request_stop();
+        worker.join();
+        const double us = duration<double, micro>(steady_clock::now() - t0).count();
+        cout << "periodic worker:      " << ticks << " ticks in 1.1 s, stopped mid-Sleep(500) in " << fixed
+             << setprecision(0) << us << " µs" << endl;
+        cout.unsetf(ios::fixed);
+        ok = ok && ticks >= 2 && ticks <= 3;
+    }
+
+    // ---- 2. latency: blocked thread, request_stop → join ----
+    mt19937 rng(11);
+    const int polled = max(3, min(trials, 10));             // each costs up to a poll period
+    struct Row {
+        string wait;
+        string how;
+        Latency lat;
+        bool stopAware;
+    };
+    vector<Row> rows;
+
+    auto aware = [&](const char* wait, const char* how, auto body) {
+        rows.push_back({wait, how, shutdowns(trials, body, true, 10, rng), true});
+    };
+    auto polledBy = [&](const char* how, int spreadMs, auto body) {
+        rows.push_back({"", how, shutdowns(polled, body, false, spreadMs, rng), false});
+    };
+
+    // semaphore acquire, nobody releases
+    aware("semaphore acquire", "StopSemaphore::acquire(st)", [](stop_token st, atomic<bool>&) {
+        StopSemaphore<1> sem{0};
+        while (sem.acquire(st)) {}
+    });
+    polledBy("flag + try_acquire_for(poll)", pollMs, [&](stop_token, atomic<bool>& running) {
+        binary_semaphore sem{0};
+        while (running)
+            if (sem.try_acquire_for(poll)) {}
+    });
+
+    // condition variable, empty queue
+    aware("queue pop", "StopQueue::pop(st)", [](stop_token st, atomic<bool>&) {
+        StopQueue<int> q{50};
+        while (q.pop(st)) {}
+    });
+    polledBy("flag + cond.wait_for(poll)", pollMs, [&](stop_token, atomic<bool>& running) {
+        mutex m;
+        condition_variable cv;
+        deque<int> q;
+        unique_lock lock(m);
+        while (running) cv.wait_for(lock, poll, [&] { return !q.empty(); });
+    });
+
+    // the periodic worker's sleep
+    aware("Sleep(500)", "sleepFor(st, 500ms)", [](stop_token st, atomic<bool>&) {
+        while (sleepFor(st, milliseconds(500))) {}
+    });
+    polledBy("flag + sleep_for(500ms)", 500, [](stop_token, atomic<bool>& running) {
+        while (running) this_thread::sleep_for(milliseconds(500));
+    });
+
+    cout << endl << "shutdown latency, request_stop() → join() (stop-aware: " << trials << " trials, polled: "
+         << polled << ", poll period " << pollMs << " ms):" << endl;
+    cout << "  " << left << setw(20) << "blocked in" << setw(32) << "wait" << right << setw(12) << "median µs"
+         << setw(12) << "max µs" << endl;
+    double worstAware = 0, bestPolled = 1e300;
+    for (Row& r : rows) {
+        const double med = r.lat.median();
+        cout << "  " << left << setw(20) << r.wait << setw(32) << r.how << right << fixed << setprecision(0)
+             << setw(12) << med << setw(12) << r.lat.max() << endl;
+        if (r.stopAware) worstAware = max(worstAware, med);
+        else bestPolled = min(bestPolled, med);
+    }
+    cout.unsetf(ios::fixed);
+
+    // The original: a plain acquire() sees neither flag nor token
+    {
+        binary_semaphore sem{0};
+        atomic<bool> running{true}, exited{false};
+        thread t([&] {
+            while (running) sem.acquire();
+            exited = true;
+        });
+        this_thread::sleep_for(milliseconds(5));
+        running = false;
+        this_thread::sleep_for(milliseconds(300));
+        const bool stuck = !exited;
+        cout << "  " << left << setw(20) << "semaphore acquire" << setw(32) << "flag + acquire() (original)" << right
+             << setw(24) << (stuck ? "still blocked after 300 ms" : "exited?") << endl;
+        sem.release();                                      // the only way out
+        t.join();
+        ok = ok && stuck;
+    }
+
+    cout << "stop-aware waits: worst median " << setprecision(3) << worstAware << " µs vs " << bestPolled / 1000
+         << " ms polled (" << setprecision(0) << fixed << bestPolled / max(worstAware, 1.0) << "x)" << endl;
+    cout.unsetf(ios::fixed);
+    ok = ok && worstAware < 2000 && worstAware * 10 < bestPolled;
+
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ------------------------------------------------------
+//
+// 1. A stop flag only helps a thread that looks at it; a thread
+//    blocked in acquire() or wait() must be WOKEN, so the wait
+//    itself has to know about the stop request.
+// 2. std::jthread passes a stop_token and its destructor does
+//    request_stop() + join(): no forgotten join, no std::terminate.
+// 3. condition_variable_any::wait(lock, stop_token, pred) registers
+//    a stop callback that notifies the waiter — the wake-up is
+//    immediate, with no polling between requests.
+// 4. Decide what stop means for queued work (here: interrupt waits
+//    only, keep handing out what is already queued) and say so in
+//    the interface.
+//
+// ⭐ One-Line Interview Answer
+// “Run the loops on std::jthread and make every blocking wait take
+// its stop_token — condition_variable_any's stop-aware wait, a
+// stop-aware semaphore, an interruptible sleep — so request_stop()
+// wakes the thread at once and shutdown takes microseconds instead
+// of a poll period or a kill.”
@@ -0,0 +1,119 @@
+// =====================================================
+// TOPIC: Work-Stealing Thread Pool vs std::async
+// =====================================================
+//
+// PROBLEM (see std::async.cpp):
+// std::async(std::launch::async, find_odd, ...) starts a
+// BRAND NEW THREAD for every call.
+//
+// - Thread creation costs tens of microseconds
+// - 10,000 tasks → 10,000 threads created and destroyed
+// - Nothing limits how many threads are alive at once
+//
+// -----------------------------------------------------
+// SOLUTION: ThreadPool (see ThreadPool.h)
+// -----------------------------------------------------
+//
+// - Fixed set of workers, created ONCE
+// - Per-worker deques + random-victim stealing
+// - pool.submit(find_odd, start, end) returns
+//   std::future<ull>, just like std::async
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread threadPoolBenchmark.cpp -o pool
+//
+#include <iostream>
+#include <future>
+#include <chrono>
+#include <vector>
+#include "ThreadPool.h"
+
+using namespace std;
+using namespace std::chrono;
+typedef long int ull;
+
+// Same computation as std::async.cpp, without the per-call cout
+ull find_odd(ull start, ull end) {
+    ull oddSum = 0;
+    for (ull i = start; i <= end; i++) {
+        if (i % 2 != 0) {
+            oddSum += i;
+        }
+    }
+    return oddSum;
+}
+
+int main() {
+    const int tasks = 5000;          // thousands of SHORT tasks
+    const ull chunk = 20000;         // numbers per task
+
+    // -------------------------------------------------
+    // 1. Raw std::async: one thread per task
+    // -------------------------------------------------
+    auto t0 = steady_clock::now();
+    vector<future<ull>> asyncResults;
+    asyncResults.reserve(tasks);
+    for (int i = 0; i < tasks; ++i)
+        asyncResults.push_back(std::async(std::launch::async, find_odd,
+                                          i * chunk, (i + 1) * chunk - 1));
+    ull asyncSum = 0;
+    for (auto& f : asyncResults) asyncSum += f.get();
+    double asyncMs = duration<double, milli>(steady_clock::now() - t0).count();
+
+    // -------------------------------------------------
+    // 2. Work-stealing pool: same call shape
+    // -------------------------------------------------
+    ThreadPool pool;
+    auto t1 = steady_clock::now();
+    vector<future<ull>> poolResults;
+    poolResults.reserve(tasks);
+    for (int i = 0; i < tasks; ++i)
+        poolResults.push_back(pool.submit(find_odd, i * chunk, (i + 1) * chunk - 1));
+    ull poolSum = 0;
+    for (auto& f : poolResults) poolSum += f.get();
+    double poolMs = duration<double, milli>(steady_clock::now() - t1).count();
+
+    cout << "tasks: " << tasks << ", workers: " << pool.size() << endl;
+    cout << "std::async : " << asyncMs << " ms  (oddSum " << asyncSum << ")" << endl;
+    cout << "ThreadPool : " << poolMs << " ms  (oddSum " << poolSum << ")" << endl;
+    cout << "speedup    : " << asyncMs / poolMs << "x" << endl;
+
+    // -------------------------------------------------
+    // 3. Nested submission: tasks spawn sub-tasks that
+    //    land on the worker's OWN deque (stealable)
+    // -------------------------------------------------
+    auto outer = pool.submit([&pool]() {
+        vector<future<ull>> parts;
+        for (int i = 0; i < 8; ++i)
+            parts.push_back(pool.submit(find_odd, i * chunk, (i + 1) * chunk - 1));
+        ull s = 0;
+        for (auto& f : parts) {
+            // help instead of blocking this worker
+            while (f.wait_for(seconds(0)) != future_status::ready)
+                pool.runPendingTask();
+            s += f.get();
+        }
+        return s;
+    });
+    cout << "nested oddSum: " << outer.get() << endl;
+
+    return (asyncSum == poolSum) ? 0 : 1;
+}
+
+// -----------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// -----------------------------------------------------
+//
+// 1. Thread creation is EXPENSIVE; reuse threads for
+//    short tasks.
+// 2. One shared queue becomes a contention point;
+//    per-worker deques avoid that.
+// 3. Owner works LIFO (hot cache), thieves take FIFO
+//    (bigger, older chunks of work).
+// 4. A task that blocks on another task's future must
+//    HELP (run queued tasks) or the pool can deadlock.
+//
+// ⭐ One-Line Interview Answer
+// “A work-stealing pool keeps a fixed set of threads, each
+// with its own task deque, and idle threads steal from
+// random victims so load balances without a global lock.”
@@ -0,0 +1,202 @@
+// ==========================================================
+// EntityFile.h — a binary SoA scene format, used in place from mmap
+// ==========================================================
+//
+// soaGameObjects.cpp keeps its entities as columns — per type,
+// one float array per field:
+//
+//     objects: x[] y[] vx[] vy[]
+//     players: x[] y[] vx[] vy[] health[]
+//     npcs:    x[] y[] vx[] vy[] patrolTimer[]
+//
+// A text dump of the same scene has to be parsed number by
+// number (`in >> type >> x >> y ...`) and pushed into those
+// vectors — seconds for 10^7 entities before the first frame.
+// This format IS the columns, so loading is mmap + a header
+// check:
+//
+//   [header, 256 bytes]
+//   [column 0][pad to 64][column 1][pad to 64] ... [column 14]
+//
+//   header: magic "ENTSOA01", version, an endianness tag, the
+//   file size, entity count per type and the byte offset of each
+//   column (EntityType × EntityField, 3 × 5; objects have no
+//   Extra column: count 0); columns are 64-byte aligned IEEE
+//   floats in the writer's byte order (a reader on the other
+//   order rejects the file)
+//
+//     writeEntityFile("scene.ent", columns);          // any EntityColumns<const float>
+//
+//     EntityFile scene("scene.ent");                  // throws if not a valid file
+//     std::span<const float> x = scene.columns().column(EntityType::Player, EntityField::X);
+//
+//     EntityFile live("scene.ent", MappedFile::Mode::CopyOnWrite);
+//     update(live.mutableColumns());                  // in place; the file is unchanged
+//
+// Validation is O(1) in the size: the header, and every column
+// inside the file and aligned. The floats themselves are not
+// looked at until used — pages come in on first touch.
+//
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include "../Memory_management/MappedFile.h"
+
+enum class EntityType { Object, Player, Npc };
+enum class EntityField { X, Y, Vx, Vy, Extra };     // Extra: health (players), patrol timer (NPCs)
+
+inline constexpr std::size_t kEntityTypes = 3;
+inline constexpr std::size_t kEntityFields = 5;
+inline constexpr std::size_t kEntityColumns = kEntityTypes * kEntityFields;
+
+// 15 column views over whatever owns the floats (vectors, a mapping)
+template <typename Float>
+struct EntityColumns {
+    std::array<std::span<Float>, kEntityColumns> columns{};
+
+    std::span<Float>& column(EntityType t, EntityField f) {
+        return columns[std::size_t(t) * kEntityFields + std::size_t(f)];
+    }
+    std::span<Float> column(EntityType t, EntityField f) const {
+        return columns[std::size_t(t) * kEntityFields + std::size_t(f)];
+    }
+    std::size_t count(EntityType t) const { return column(t, EntityField::X).size(); }
+    std::size_t size() const { return count(EntityType::Object) + count(EntityType::Player) + count(EntityType::Npc); }
+
+    operator EntityColumns<const Float>() const {
+        EntityColumns<const Float> c;
+        for (std::size_t i = 0; i < kEntityColumns; ++i) c.columns[i] = columns[i];
+        return c;
+    }
+};
+
+struct EntityFileHeader {
+    static constexpr char kMagic[8] = {'E', 'N', 'T', 'S', 'O', 'A', '0', '1'};
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::uint32_t kEndianTag = 0x01020304;
+    static constexpr std::size_t kAlign = 64;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianTag;                          // reads 0x04030201 on the other byte order
+    std::uint64_t fileBytes;
+    std::uint64_t counts[kEntityTypes];
+    std::uint64_t offsets[kEntityColumns];            // byte offset of each column
+    std::uint8_t reserved[256 - 8 - 4 - 4 - 8 - 8 * kEntityTypes - 8 * kEntityColumns];
+};
+static_assert(sizeof(EntityFileHeader) == 256, "the header is part of the format");
+static_assert(std::numeric_limits<float>::is_iec559 && sizeof(float) == 4, "columns are IEEE single precision");
+
+namespace entity_file_detail {
+
+inline bool hasExtra(EntityType t) { return t != EntityType::Object; }
+
+inline std::size_t alignUp(std::size_t n) {
+    return (n + EntityFileHeader::kAlign - 1) / EntityFileHeader::kAlign * EntityFileHeader::kAlign;
+}
+
+}  // namespace entity_file_detail
+
+// Writes the columns; every column of a type must have the type's
+// X count (Extra: the same, or 0 for objects). Throws
+// std::invalid_argument on mismatched counts, std::system_error
+// on I/O errors.
+inline void writeEntityFile(const std::string& path, const EntityColumns<const float>& scene) {
+    using namespace entity_file_detail;
+    EntityFileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, EntityFileHeader::kMagic, sizeof(h.magic));
+    h.version = EntityFileHeader::kVersion;
+    h.endianTag = EntityFileHeader::kEndianTag;
+    std::size_t at = sizeof(EntityFileHeader);
+    for (std::size_t t = 0; t < kEntityTypes; ++t) {
+        const EntityType type = EntityType(t);
+        h.counts[t] = scene.count(type);
+        for (std::size_t f = 0; f < kEntityFields; ++f) {
+            const std::size_t expected = EntityField(f) == EntityField::Extra && !hasExtra(type) ? 0 : h.counts[t];
+            if (scene.column(type, EntityField(f)).size() != expected)
+                throw std::invalid_argument("writeEntityFile: column " + std::to_string(t * kEntityFields + f) +
+                                            " has the wrong length");
+            h.offsets[t * kEntityFields + f] = at;
+            at = alignUp(at + expected * sizeof(float));
+        }
+    }
+    h.fileBytes = at;
+
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) throw std::system_error(errno, std::generic_category(), path);
+    static const char zeros[EntityFileHeader::kAlign] = {};
+    bool ok = std::fwrite(&h, sizeof(h), 1, out) == 1;
+    std::size_t written = sizeof(h);
+    for (std::size_t c = 0; ok && c < kEntityColumns; ++c) {
+        ok = std::fwrite(zeros, 1, h.offsets[c] - written, out) == h.offsets[c] - written;
+        const std::span<const float> col = scene.columns[c];
+        ok = ok && (col.empty() || std::fwrite(col.data(), sizeof(float), col.size(), out) == col.size());
+        written = h.offsets[c] + col.size_bytes();
+    }
+    ok = ok && std::fwrite(zeros, 1, h.fileBytes - written, out) == h.fileBytes - written;
+    const int err = errno;
+    if (std::fclose(out) != 0 || !ok) throw std::system_error(ok ? errno : err, std::generic_category(), path);
+}
+
+// A validated scene file, mapped; the columns point into the mapping
+class EntityFile {
+public:
+    // Throws std::system_error (cannot open/map) or
+    // std::runtime_error (not a valid entity file)
+    explicit EntityFile(const std::string& path, MappedFile::Mode mode = MappedFile::Mode::ReadOnly)
+        : file_(path, mode) {
+        using namespace entity_file_detail;
+        const std::span<const std::byte> bytes = file_.bytes();
+        if (bytes.size() < sizeof(EntityFileHeader)) invalid(path, "shorter than the header");
+        EntityFileHeader h;
+        std::memcpy(&h, bytes.data(), sizeof(h));
+        if (std::memcmp(h.magic, EntityFileHeader::kMagic, sizeof(h.magic)) != 0) invalid(path, "bad magic");
+        if (h.version != EntityFileHeader::kVersion) invalid(path, "unsupported version " + std::to_string(h.version));
+        if (h.endianTag != EntityFileHeader::kEndianTag) invalid(path, "written on the other byte order");
+        if (h.fileBytes != bytes.size()) invalid(path, "size does not match the header (truncated?)");
+        // The mapping is page aligned, so file offsets keep their alignment
+        std::byte* base = const_cast<std::byte*>(bytes.data());
+        for (std::size_t t = 0; t < kEntityTypes; ++t)
+            for (std::size_t f = 0; f < kEntityFields; ++f) {
+                const std::size_t c = t * kEntityFields + f;
+                const bool none = EntityField(f) == EntityField::Extra && !hasExtra(EntityType(t));
+                const std::uint64_t n = none ? 0 : h.counts[t];
+                const std::uint64_t offset = h.offsets[c];
+                if (offset % EntityFileHeader::kAlign != 0 || offset < sizeof(EntityFileHeader) ||
+                    offset > bytes.size() || n > (bytes.size() - offset) / sizeof(float))
+                    invalid(path, "column " + std::to_string(c) + " outside the file");
+                columns_.columns[c] = {reinterpret_cast<float*>(base + offset), std::size_t(n)};
+            }
+    }
+
+    EntityColumns<const float> columns() const { return columns_; }
+
+    // CopyOnWrite mappings only
+    EntityColumns<float> mutableColumns() {
+        if (file_.mode() != MappedFile::Mode::CopyOnWrite)
+            throw std::logic_error("EntityFile: mapped read-only; open with MappedFile::Mode::CopyOnWrite");
+        return columns_;
+    }
+
+    const MappedFile& mapping() const { return file_; }
+    std::size_t size() const { return columns_.size(); }
+
+private:
+    [[noreturn]] static void invalid(const std::string& path, const std::string& why) {
+        throw std::runtime_error(path + ": not an entity file: " + why);
+    }
+
+    MappedFile file_;
+    EntityColumns<float> columns_;
+};
@@ -0,0 +1,238 @@
+// ==========================================================
+// MonotonicArena.h — bump allocator with scoped reset
+// ==========================================================
+//
+// arrayObjDynamic.cpp and dynamicArrayOfPointer.cpp do:
+//
+//     Car*  cars = new Car[n];          ... delete[] cars;
+//     Car** ptrs = new Car*[n];
+//     ptrs[i] = new Car(i);             ... delete ptrs[i];
+//
+// Fine once — but done EVERY FRAME it is n calls into malloc
+// and n calls into free, each one touching allocator metadata.
+//
+// MONOTONIC ARENA:
+// - Memory comes from big CHUNKS (64 KB, growing as needed)
+// - allocate = round the cursor up + add the size → O(1)
+// - there is NO per-object free
+// - reset()  = run pending destructors, rewind the cursor → O(1)
+//              for trivially destructible types
+//
+// TYPED API:
+//     Car*  cars = arena.make_array<Car>(n);        // n Cars
+//     Car*  one  = arena.make<Car>(42);             // one Car
+//     Car** ptrs = arena.make_array<Car*>(n);       // n pointers
+//
+// Non-trivial destructors are remembered in a small list that
+// lives inside the arena itself and run (newest first) on reset.
+//
+// SCOPED RESET:
+//     {
+//         MonotonicArena::Scope frame(arena);
+//         ... allocate everything for this frame ...
+//     }   // ← everything allocated in the scope is released
+//
+// After a reset that needed several chunks, they are merged
+// into ONE chunk of the total size, so a steady-state frame
+// touches a single block of memory and never calls malloc.
+//
+// Not thread-safe: one arena per thread (or per frame).
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class MonotonicArena {
+public:
+    static constexpr std::size_t kDefaultChunk = 64 * 1024;
+
+    explicit MonotonicArena(std::size_t initialBytes = kDefaultChunk) {
+        addChunk(initialBytes);
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() {
+        runDestructors(nullptr);
+        for (Chunk& c : chunks_) std::free(c.base);
+    }
+
+    // --------------------------------------------------
+    // Raw allocation
+    // --------------------------------------------------
+    void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+        Chunk* c = &chunks_[current_];
+        std::size_t at = alignUp(c->used, align);
+        if (at + bytes > c->size) {
+            c = &nextChunk(bytes + align);
+            at = alignUp(c->used, align);
+        }
+        c->used = at + bytes;
+        return c->base + at;
+    }
+
+    // --------------------------------------------------
+    // Typed allocation
+    // --------------------------------------------------
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        void* p = allocate(sizeof(T), alignof(T));
+        T* obj = ::new (p) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) pushDestructor(obj, 1);
+        return obj;
+    }
+
+    // n objects, each constructed from args (default-constructed
+    // when args is empty, like new T[n]). Trivial types are left
+    // value-initialized (zero) to match new T[n]().
+    template <typename T, typename... Args>
+    T* make_array(std::size_t n, const Args&... args) {
+        if (n == 0) return nullptr;
+        T* arr = static_cast<T*>(allocate(sizeof(T) * n, alignof(T)));
+        if constexpr (std::is_trivially_default_constructible_v<T> && sizeof...(Args) == 0) {
+            std::uninitialized_value_construct_n(arr, n);
+        } else {
+            std::size_t i = 0;
+            try {
+                for (; i < n; ++i) ::new (arr + i) T(args...);
+            } catch (...) {
+                std::destroy_n(arr, i);
+                throw;
+            }
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) pushDestructor(arr, n);
+        return arr;
+    }
+
+    // --------------------------------------------------
+    // Reset / scopes
+    // --------------------------------------------------
+    struct Marker {
+        std::size_t chunk;
+        std::size_t used;
+        void* dtors;
+    };
+
+    Marker mark() const { return {current_, chunks_[current_].used, dtors_}; }
+
+    // Release everything allocated after m (destructors run newest first)
+    void rewind(const Marker& m) {
+        runDestructors(static_cast<DtorNode*>(m.dtors));
+        for (std::size_t i = m.chunk + 1; i <= current_; ++i) chunks_[i].used = 0;
+        current_ = m.chunk;
+        chunks_[current_].used = m.used;
+    }
+
+    // Release everything; keep the memory for the next frame
+    void reset() {
+        runDestructors(nullptr);
+        if (chunks_.size() > 1) {
+            // Several chunks were needed: replace them with one that fits all
+            std::size_t total = 0;
+            for (Chunk& c : chunks_) {
+                total += c.size;
+                std::free(c.base);
+            }
+            chunks_.clear();
+            addChunk(total);
+        }
+        current_ = 0;
+        chunks_[0].used = 0;
+    }
+
+    class Scope {
+    public:
+        explicit Scope(MonotonicArena& a) : arena_(a), mark_(a.mark()) {}
+        ~Scope() {
+            if (mark_.chunk == 0 && mark_.used == 0 && mark_.dtors == nullptr)
+                arena_.reset();        // outermost scope → full reset (merges chunks)
+            else
+                arena_.rewind(mark_);
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        MonotonicArena& arena_;
+        Marker mark_;
+    };
+
+    // --------------------------------------------------
+    // Statistics
+    // --------------------------------------------------
+    std::size_t bytesUsed() const {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i <= current_; ++i) n += chunks_[i].used;
+        return n;
+    }
+    std::size_t bytesReserved() const {
+        std::size_t n = 0;
+        for (const Chunk& c : chunks_) n += c.size;
+        return n;
+    }
+    std::size_t chunkCount() const { return chunks_.size(); }
+
+private:
+    struct Chunk {
+        std::byte* base;
+        std::size_t size;
+        std::size_t used;
+    };
+
+    // Lives inside the arena, next to the objects it destroys
+    struct DtorNode {
+        void (*destroy)(void*, std::size_t);
+        void* objects;
+        std::size_t count;
+        DtorNode* prev;
+    };
+
+    static std::size_t alignUp(std::size_t v, std::size_t a) { return (v + a - 1) & ~(a - 1); }
+
+    void addChunk(std::size_t bytes) {
+        if (bytes < kDefaultChunk) bytes = kDefaultChunk;
+        void* p = std::malloc(bytes);
+        if (!p) throw std::bad_alloc();
+        chunks_.push_back({static_cast<std::byte*>(p), bytes, 0});
+    }
+
+    // Move to (or create) a chunk with at least `bytes` free
+    Chunk& nextChunk(std::size_t bytes) {
+        while (current_ + 1 < chunks_.size()) {
+            ++current_;
+            if (chunks_[current_].size >= bytes) return chunks_[current_];
+        }
+        std::size_t grow = chunks_.back().size * 2;
+        addChunk(grow > bytes ? grow : bytes);
+        current_ = chunks_.size() - 1;
+        return chunks_[current_];
+    }
+
+    template <typename T>
+    void pushDestructor(T* objects, std::size_t n) {
+        void* p = allocate(sizeof(DtorNode), alignof(DtorNode));
+        dtors_ = ::new (p) DtorNode{
+            [](void* o, std::size_t count) { std::destroy_n(static_cast<T*>(o), count); },
+            objects, n, dtors_};
+    }
+
+    void runDestructors(DtorNode* stopAt) {
+        while (dtors_ != stopAt) {
+            DtorNode* d = dtors_;
+            dtors_ = d->prev;
+            d->destroy(d->objects, d->count);
+        }
+    }
+
+    std::vector<Chunk> chunks_;
+    std::size_t current_ = 0;
+    DtorNode* dtors_ = nullptr;
+};
@@ -0,0 +1,191 @@
+// ==========================================================
+// PolyVector.h — derived objects stored inline, by value
+// ==========================================================
+//
+// poly.cpp's zoo:
+//
+//     vector<unique_ptr<Animal>> zoo;
+//     zoo.emplace_back(make_unique<Dog>());     // one heap node each
+//     for (auto& a : zoo) a->speak();           // load pointer, then object
+//
+// Every animal is its own allocation, wherever malloc put it,
+// so iteration is a dependent load per element into memory the
+// prefetcher cannot predict.
+//
+// poly_vector<Animal, MaxSize> constructs each Dog / Cat IN
+// PLACE in a fixed-size slot (MaxSize bytes, Align-aligned);
+// slots sit back to back in chunks, so a walk is sequential:
+//
+//     poly_vector<Animal, 32> zoo;
+//     zoo.emplace_back<Dog>();
+//     for (Animal& a : zoo) a.speak();          // vtable call, no heap hop
+//
+// - emplace_back<T> checks at compile time that T derives from
+//   Base and fits the slot (size and alignment)
+// - chunks never move: references to elements stay valid across
+//   emplace_back (no relocation, so T need not be movable);
+//   iterators, as with std::vector, may not
+// - iteration is in insertion order
+// - destruction goes through Base's virtual destructor, which
+//   is required (static_assert)
+// - the slot holds nothing but the object: Base must sit at
+//   offset 0 in T (its first base, not virtual), otherwise
+//   emplace_back throws std::invalid_argument. For ordinary
+//   single inheritance the check folds to a constant.
+//
+// Not thread-safe, like std::vector.
+//
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename Base, std::size_t MaxSize, std::size_t Align = alignof(std::max_align_t)>
+class poly_vector {
+    static_assert(std::is_polymorphic_v<Base> && std::has_virtual_destructor_v<Base>,
+                  "poly_vector destroys elements through Base: it needs a virtual destructor");
+    static_assert(std::has_single_bit(Align), "Align must be a power of two");
+
+    struct Slot {
+        alignas(Align) std::byte storage[MaxSize];
+
+        Base* base() { return std::launder(reinterpret_cast<Base*>(storage)); }
+    };
+
+public:
+    // Slots per chunk: a power of two, chunks of roughly 64 KB
+    static constexpr std::size_t kChunkSlots =
+        std::bit_floor(sizeof(Slot) * 64 > 64 * 1024 ? std::size_t(64) : (64 * 1024) / sizeof(Slot));
+
+    template <bool Const>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Base;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const Base&, Base&>;
+        using pointer = std::conditional_t<Const, const Base*, Base*>;
+
+        basic_iterator() = default;
+
+        reference operator*() const { return *slot_->base(); }
+        pointer operator->() const { return slot_->base(); }
+
+        basic_iterator& operator++() {
+            if (++slot_ == chunkEnd_ && *++chunk_) {
+                slot_ = *chunk_;
+                chunkEnd_ = slot_ + kChunkSlots;
+            }
+            return *this;
+        }
+        basic_iterator operator++(int) {
+            basic_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const basic_iterator& a, const basic_iterator& b) { return a.slot_ == b.slot_; }
+
+    private:
+        friend class poly_vector;
+        basic_iterator(Slot* const* chunk, Slot* slot) : chunk_(chunk), slot_(slot), chunkEnd_(*chunk + kChunkSlots) {}
+
+        Slot* const* chunk_ = nullptr;                  // null-terminated chunk list
+        Slot* slot_ = nullptr;
+        Slot* chunkEnd_ = nullptr;
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    poly_vector() { chunks_.push_back(nullptr); }
+    ~poly_vector() {
+        clear();
+        for (Slot* c : chunks_)
+            if (c) ::operator delete(c, std::align_val_t(alignof(Slot)));
+    }
+
+    poly_vector(const poly_vector&) = delete;
+    poly_vector& operator=(const poly_vector&) = delete;
+
+    poly_vector(poly_vector&& other) noexcept : chunks_(std::move(other.chunks_)), size_(other.size_) {
+        other.chunks_.assign(1, nullptr);
+        other.size_ = 0;
+    }
+    poly_vector& operator=(poly_vector&& other) noexcept {
+        if (this != &other) {
+            this->~poly_vector();
+            ::new (this) poly_vector(std::move(other));
+        }
+        return *this;
+    }
+
+    template <typename T, typename... Args>
+    T& emplace_back(Args&&... args) {
+        static_assert(std::is_base_of_v<Base, T>, "poly_vector: T must derive from Base");
+        static_assert(sizeof(T) <= MaxSize, "poly_vector: T does not fit in MaxSize");
+        static_assert(alignof(T) <= Align, "poly_vector: T needs more alignment than Align");
+        Slot& s = slotAt(size_, true);
+        T* obj = ::new (static_cast<void*>(s.storage)) T(std::forward<Args>(args)...);
+        if (static_cast<void*>(static_cast<Base*>(obj)) != s.storage) {
+            obj->~T();
+            throw std::invalid_argument("poly_vector: Base must be at offset 0 in T");
+        }
+        ++size_;
+        return *obj;
+    }
+
+    void pop_back() {
+        std::destroy_at(slotAt(--size_, false).base());
+    }
+
+    // Destroys every element (newest first); chunks are kept
+    void clear() {
+        while (size_) pop_back();
+    }
+
+    Base& operator[](std::size_t i) { return *slotAt(i, false).base(); }
+    const Base& operator[](std::size_t i) const { return (*const_cast<poly_vector*>(this))[i]; }
+    Base& back() { return (*this)[size_ - 1]; }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::size_t capacity() const { return (chunks_.size() - 1) * kChunkSlots; }
+
+    iterator begin() { return size_ ? iterator(chunks_.data(), chunks_[0]) : end(); }
+    iterator end() { return endAt<false>(); }
+    const_iterator begin() const { return size_ ? const_iterator(chunks_.data(), chunks_[0]) : end(); }
+    const_iterator end() const { return endAt<true>(); }
+
+private:
+    Slot& slotAt(std::size_t i, bool grow) {
+        std::size_t c = i / kChunkSlots;
+        if (grow && c + 1 == chunks_.size()) {
+            void* mem = ::operator new(sizeof(Slot) * kChunkSlots, std::align_val_t(alignof(Slot)));
+            chunks_.back() = static_cast<Slot*>(mem);
+            chunks_.push_back(nullptr);         // keep the list null-terminated for iterators
+        }
+        return chunks_[c][i % kChunkSlots];
+    }
+
+    // Position size_: the next chunk's first slot if that chunk is
+    // already allocated, else one past the last chunk's end —
+    // exactly where ++ lands after the last element
+    template <bool Const>
+    basic_iterator<Const> endAt() const {
+        basic_iterator<Const> it;
+        if (size_ == 0) return it;
+        std::size_t c = size_ / kChunkSlots, i = size_ % kChunkSlots;
+        it.slot_ = chunks_[c] ? chunks_[c] + i : chunks_[c - 1] + kChunkSlots;
+        return it;
+    }
+
+    std::vector<Slot*> chunks_;                     // live chunks, then nullptr
+    std::size_t size_ = 0;
+};
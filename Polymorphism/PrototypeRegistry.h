@@ -0,0 +1,215 @@
+// ==========================================================
+// PrototypeRegistry.h — clone prototypes into arenas and pools
+// ==========================================================
+//
+// poly.cpp's covariant clone:
+//
+//     class Fruit { virtual Fruit* clone() { return new Fruit(*this); } };
+//     class Apple : public Fruit {
+//         Apple* clone() override { return new Apple(*this); }
+//     };
+//
+// One malloc per clone and one free per death, and a raw owning
+// pointer. Spawning thousands of objects per frame from a few
+// prototypes spends its time in the allocator.
+//
+// HERE the copy is split from the allocation:
+//
+//     class Fruit : public Clones<Fruit, Prototype<Fruit>> { ... };
+//     class Apple : public Clones<Apple, Fruit> { ... };
+//
+//     Fruit* f = apple.clone_into(arena);        // placement copy
+//     ArenaPtr<Fruit> g = apple.clone_unique(pool);
+//
+// Clones<> writes the three virtuals (size, alignment, copy at
+// an address), so a clone is ONE virtual call plus whatever the
+// arena's allocate costs: a pointer bump for MonotonicArena, a
+// free-list pop for a pool.
+//
+// An ARENA is anything with
+//     void* allocate(std::size_t bytes, std::size_t align);
+// and optionally
+//     void deallocate(void* p, std::size_t bytes, std::size_t align);
+//
+// clone_into returns a raw pointer: the caller runs the
+// destructor (destroyClone) or, for an arena that only frees
+// in bulk, drops it at reset when the type owns nothing.
+// clone_unique returns a unique_ptr whose deleter runs the
+// virtual destructor and hands the block back to the arena's
+// deallocate (if it has one). The arena must outlive it.
+//
+// PrototypeRegistry<Root> keeps named prototypes and spawns by
+// id; sizes are cached at registration, so spawn() makes the
+// one virtual call only.
+//
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+template <typename A>
+concept CloneArena = requires(A& a, std::size_t n) {
+    { a.allocate(n, n) } -> std::convertible_to<void*>;
+};
+
+template <typename A>
+concept ReleasingArena = CloneArena<A> && requires(A& a, void* p, std::size_t n) { a.deallocate(p, n, n); };
+
+namespace prototype_detail {
+
+template <typename A>
+void release(void* arena, void* p, std::size_t bytes, std::size_t align) {
+    static_cast<A*>(arena)->deallocate(p, bytes, align);
+}
+
+}  // namespace prototype_detail
+
+// Runs the virtual destructor, then returns the block to the
+// arena it came from (no-op release for bulk-free arenas)
+template <typename Root>
+struct ArenaDeleter {
+    void* arena = nullptr;
+    void (*release)(void*, void*, std::size_t, std::size_t) = nullptr;
+
+    void operator()(Root* p) const noexcept {
+        std::size_t bytes = p->cloneSize(), align = p->cloneAlign();
+        p->~Root();
+        if (release) release(arena, p, bytes, align);
+    }
+};
+
+template <typename Root>
+using ArenaPtr = std::unique_ptr<Root, ArenaDeleter<Root>>;
+
+template <typename Root>
+void destroyClone(Root* p) noexcept {
+    p->~Root();
+}
+
+template <typename Root>
+class Prototype {
+public:
+    using PrototypeRoot = Root;
+
+    virtual ~Prototype() = default;
+
+    // Written by Clones<>: storage for a copy of the most-derived
+    // object, and the copy itself at mem
+    virtual std::size_t cloneSize() const noexcept = 0;
+    virtual std::size_t cloneAlign() const noexcept = 0;
+    virtual Root* cloneAt(void* mem) const = 0;
+
+    template <CloneArena A>
+    Root* clone_into(A& arena) const {
+        return cloneWith(arena, cloneSize(), cloneAlign());
+    }
+
+    template <CloneArena A>
+    ArenaPtr<Root> clone_unique(A& arena) const {
+        return ArenaPtr<Root>(clone_into(arena), deleterFor(arena));
+    }
+
+    template <CloneArena A>
+    static ArenaDeleter<Root> deleterFor(A& arena) {
+        if constexpr (ReleasingArena<A>)
+            return {&arena, &prototype_detail::release<A>};
+        else
+            return {&arena, nullptr};
+    }
+
+protected:
+    Prototype() = default;
+    Prototype(const Prototype&) = default;
+    Prototype& operator=(const Prototype&) = default;
+
+    template <CloneArena A>
+    Root* cloneWith(A& arena, std::size_t bytes, std::size_t align) const {
+        void* mem = arena.allocate(bytes, align);
+        if constexpr (ReleasingArena<A>) {
+            try {
+                return cloneAt(mem);
+            } catch (...) {
+                arena.deallocate(mem, bytes, align);
+                throw;
+            }
+        } else {
+            return cloneAt(mem);               // a bulk arena reclaims it at reset
+        }
+    }
+
+    template <typename>
+    friend class PrototypeRegistry;
+};
+
+// The three virtuals for a concrete Derived, which inherits Base
+// (Prototype<Root> for the root, else a class already below it)
+template <typename Derived, typename Base>
+class Clones : public Base {
+public:
+    using Root = typename Base::PrototypeRoot;
+    using Base::Base;
+
+    std::size_t cloneSize() const noexcept override { return sizeof(Derived); }
+    std::size_t cloneAlign() const noexcept override { return alignof(Derived); }
+    Root* cloneAt(void* mem) const override { return ::new (mem) Derived(static_cast<const Derived&>(*this)); }
+};
+
+template <typename Root>
+class PrototypeRegistry {
+public:
+    using Id = std::uint32_t;
+
+    Id add(std::string name, std::unique_ptr<Root> prototype) {
+        if (!prototype) throw std::invalid_argument("PrototypeRegistry: null prototype '" + name + "'");
+        for (const Entry& e : entries_)
+            if (e.name == name) throw std::invalid_argument("PrototypeRegistry: duplicate name '" + name + "'");
+        std::size_t bytes = prototype->cloneSize(), align = prototype->cloneAlign();
+        entries_.push_back({std::move(name), std::move(prototype), bytes, align});
+        return static_cast<Id>(entries_.size() - 1);
+    }
+
+    template <typename T, typename... Args>
+    Id emplace(std::string name, Args&&... args) {
+        return add(std::move(name), std::make_unique<T>(std::forward<Args>(args)...));
+    }
+
+    // Setup-time lookup; spawn by the returned id in hot loops
+    Id find(std::string_view name) const {
+        for (std::size_t i = 0; i < entries_.size(); ++i)
+            if (entries_[i].name == name) return static_cast<Id>(i);
+        throw std::invalid_argument("PrototypeRegistry: unknown prototype '" + std::string(name) + "'");
+    }
+
+    const Root& prototype(Id id) const { return *entries_.at(id).prototype; }
+    const std::string& name(Id id) const { return entries_.at(id).name; }
+    std::size_t size() const { return entries_.size(); }
+
+    // Unchecked id: hot path
+    template <CloneArena A>
+    Root* spawn(Id id, A& arena) const {
+        const Entry& e = entries_[id];
+        return e.prototype->cloneWith(arena, e.bytes, e.align);
+    }
+
+    template <CloneArena A>
+    ArenaPtr<Root> spawnOwned(Id id, A& arena) const {
+        return ArenaPtr<Root>(spawn(id, arena), Root::deleterFor(arena));
+    }
+
+private:
+    struct Entry {
+        std::string name;
+        std::unique_ptr<Root> prototype;
+        std::size_t bytes;
+        std::size_t align;
+    };
+    std::vector<Entry> entries_;
+};
@@ -0,0 +1,189 @@
+// ==========================================================
+// SceneArena.h — objects grouped by type, torn down in bulk
+// ==========================================================
+//
+// dynamicArrayOfPointer.cpp / DeleteArraysOfPointer.txt:
+//
+//     for (int i = 0; i < n; i++)
+//         delete cars[i];               // virtual destructor + free, per object
+//     delete[] cars;
+//
+// For a scene of 10^6 mixed objects, shutdown is 10^6 indirect
+// destructor calls whose target changes from one object to the
+// next, each followed by a free() into allocator metadata
+// scattered across the heap.
+//
+// SceneArena owns the objects and tears them down in bulk:
+//
+//     SceneArena scene;
+//     Vehicle* v = scene.make<Car>(...);    // bump, in Car's own runs
+//     ...
+//     scene.teardown();                     // or ~SceneArena
+//
+// - every exact type T gets its own RUNS: objects of one type sit
+//   back to back, so teardown walks each run with a DIRECT,
+//   inlinable p->T::~T() — no vtable load, no misprediction
+// - trivially destructible types get no destructor pass at all
+// - memory is never freed per object: the chunks (1 MB, or one
+//   run's size if larger) go back together at the end
+// - TeardownMode::FastExit also skips every type whose destructor
+//   only releases memory — mark it by specialising
+//   teardown_frees_only_memory<T> — for a shutdown where that
+//   memory is about to go back to the OS anyway. Types with other
+//   side effects (flushing, closing, counting) are still destroyed
+//
+// Destruction order is per type, not per object: types in reverse
+// order of their first make<T>, newest object first within a type.
+// Objects must not need each other in their destructors — the
+// usual contract for a scene torn down as a whole.
+//
+// Not thread-safe; objects are never freed individually.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Opt-in: T's destructor does nothing but release memory
+template <typename T>
+struct teardown_frees_only_memory : std::is_trivially_destructible<T> {};
+
+enum class TeardownMode {
+    Destroy,                 // run every non-trivial destructor
+    FastExit,                // skip teardown_frees_only_memory<T> types
+};
+
+namespace scene_detail {
+
+inline std::size_t nextTypeIndex() {
+    static std::atomic<std::size_t> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+// One small integer per type, process-wide
+template <typename T>
+std::size_t typeIndex() {
+    static const std::size_t index = nextTypeIndex();
+    return index;
+}
+
+// Newest first, with the exact type's destructor called directly
+template <typename T>
+void destroyRun(std::byte* first, std::size_t count) noexcept {
+    T* objects = reinterpret_cast<T*>(first);
+    for (std::size_t i = count; i-- > 0;) std::launder(objects + i)->T::~T();
+}
+
+}  // namespace scene_detail
+
+class SceneArena {
+public:
+    static constexpr std::size_t kChunkBytes = 1 << 20;
+    static constexpr std::size_t kRunBytes = 16 * 1024;
+
+    explicit SceneArena(TeardownMode mode = TeardownMode::Destroy) : mode_(mode) {}
+    SceneArena(const SceneArena&) = delete;
+    SceneArena& operator=(const SceneArena&) = delete;
+    ~SceneArena() { teardown(); }
+
+    void setMode(TeardownMode mode) { mode_ = mode; }
+    TeardownMode mode() const { return mode_; }
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        Bucket& b = bucketFor<T>();
+        if (b.cursor == b.end) newRun(b, sizeof(T), alignof(T));
+        T* obj = ::new (static_cast<void*>(b.cursor)) T(std::forward<Args>(args)...);
+        b.cursor += sizeof(T);
+        ++b.runs.back().count;
+        ++objects_;
+        return obj;
+    }
+
+    // Destroys everything (per the mode) and releases the chunks.
+    // The arena is empty and usable afterwards.
+    void teardown() noexcept {
+        for (std::size_t i = order_.size(); i-- > 0;) {
+            Bucket& b = buckets_[order_[i]];
+            if (b.destroy && !(mode_ == TeardownMode::FastExit && b.freesOnlyMemory))
+                for (std::size_t r = b.runs.size(); r-- > 0;) b.destroy(b.runs[r].first, b.runs[r].count);
+            b = Bucket{};
+        }
+        order_.clear();
+        for (Chunk& c : chunks_) ::operator delete(c.base, std::align_val_t(kChunkAlign));
+        chunks_.clear();
+        objects_ = 0;
+    }
+
+    std::size_t size() const { return objects_; }
+    std::size_t typeCount() const { return order_.size(); }
+    std::size_t chunkCount() const { return chunks_.size(); }
+
+private:
+    static constexpr std::size_t kChunkAlign = 64;
+
+    struct Run {
+        std::byte* first;
+        std::size_t count;
+    };
+
+    struct Bucket {
+        void (*destroy)(std::byte*, std::size_t) noexcept = nullptr;   // null: trivially destructible
+        bool freesOnlyMemory = false;
+        bool used = false;
+        std::vector<Run> runs;
+        std::byte* cursor = nullptr;                    // next object of this type
+        std::byte* end = nullptr;                       // end of the current run
+    };
+
+    struct Chunk {
+        std::byte* base;
+        std::size_t size;
+        std::size_t used;
+    };
+
+    template <typename T>
+    Bucket& bucketFor() {
+        static_assert(alignof(T) <= kChunkAlign, "SceneArena: T needs more than 64-byte alignment");
+        const std::size_t i = scene_detail::typeIndex<T>();
+        if (i >= buckets_.size()) buckets_.resize(i + 1);
+        Bucket& b = buckets_[i];
+        if (!b.used) {
+            b.used = true;
+            if constexpr (!std::is_trivially_destructible_v<T>) b.destroy = &scene_detail::destroyRun<T>;
+            b.freesOnlyMemory = teardown_frees_only_memory<T>::value;
+            order_.push_back(i);
+        }
+        return b;
+    }
+
+    // A run holds a whole number of objects; it is carved from the
+    // newest chunk, or a new one
+    void newRun(Bucket& b, std::size_t size, std::size_t align) {
+        const std::size_t bytes = std::max(kRunBytes / size, std::size_t(1)) * size;
+        std::size_t at = chunks_.empty() ? 0 : (chunks_.back().used + align - 1) & ~(align - 1);
+        if (chunks_.empty() || at + bytes > chunks_.back().size) {
+            const std::size_t chunkBytes = std::max(kChunkBytes, bytes);
+            void* p = ::operator new(chunkBytes, std::align_val_t(kChunkAlign));
+            chunks_.push_back({static_cast<std::byte*>(p), chunkBytes, 0});
+            at = 0;
+        }
+        Chunk& c = chunks_.back();
+        c.used = at + bytes;
+        b.runs.push_back({c.base + at, 0});
+        b.cursor = c.base + at;
+        b.end = b.cursor + bytes;
+    }
+
+    std::vector<Bucket> buckets_;                       // by scene_detail::typeIndex
+    std::vector<std::size_t> order_;                    // bucket indices, by first use
+    std::vector<Chunk> chunks_;
+    std::size_t objects_ = 0;
+    TeardownMode mode_;
+};
@@ -0,0 +1,347 @@
+// ==========================================================
+// Snapshot.h — flat, versioned world checkpoints, mapped back in place
+// ==========================================================
+//
+// entitymanagerPattern.cpp's Entity {id, isAlive} and the
+// GameObject / Player / NPC hierarchy exist only in memory. A
+// checkpoint that walks the objects and writes them field by
+// field (or as text) stalls the frame for the whole world, and
+// loading it back parses and allocates everything again.
+//
+// A snapshot is the world's POD arrays written as they are:
+//
+//   [header 48 B][section table: tag, record size, count, offset]...
+//   [section 0, 64-aligned][section 1, 64-aligned]...
+//
+// - offsets, never pointers: the file means the same at any
+//   address; sections are 64-byte aligned, so a mapped section
+//   IS an array of records (no deserialization, no copy)
+// - versioned: magic "SNAPSHT1", format version, byte-order tag,
+//   file size; a mismatch is refused, not guessed at
+// - records must be trivially copyable (static_assert): the
+//   hierarchy persists its POD state structs, not the objects —
+//   a vtable pointer means nothing in another process
+//
+// FULL AND INCREMENTAL:
+//
+//     snapshot::Writer full(seq);                    // every record
+//     full.add(tag("PLYR"), span(players));
+//     full.write("world.000012.snap");
+//
+//     snapshot::Writer delta(seq + 1, seq);          // relative to seq
+//     delta.addDirty(tag("PLYR"), span(players), dirtyIndices);
+//     delta.write("world.000013.delta");
+//
+//   addDirty writes only the listed records, plus their indices
+//   in a companion section (tag | kIndexBit). Recovery maps the
+//   last full snapshot copy-on-write and applies the deltas in
+//   order (applyDelta); each delta names the sequence it follows,
+//   so a missing or reordered one is an error. Section sizes stay
+//   fixed between full snapshots (a delta cannot grow a section).
+//
+// write() goes to path + ".tmp" and renames it over `path`, so a
+// crash mid-checkpoint leaves the previous file intact;
+// durable = true adds fdatasync before the rename (the stall then
+// includes the disk).
+//
+// Errors: std::system_error for I/O, std::runtime_error for a file
+// that is not a valid snapshot or lacks a section.
+//
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include "../Memory_management/MappedFile.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace snapshot {
+
+inline constexpr std::uint64_t kFull = ~std::uint64_t(0);     // baseSequence of a full snapshot
+inline constexpr std::uint32_t kIndexBit = 0x80000000u;       // companion index section of a delta
+inline constexpr std::size_t kAlign = 64;
+
+// Four-character section tag: tag("PLYR")
+constexpr std::uint32_t tag(const char (&s)[5]) {
+    return (std::uint32_t(std::uint8_t(s[0])) | std::uint32_t(std::uint8_t(s[1])) << 8 |
+            std::uint32_t(std::uint8_t(s[2])) << 16 | std::uint32_t(std::uint8_t(s[3])) << 24) &
+           ~kIndexBit;
+}
+
+struct Header {
+    static constexpr char kMagic[8] = {'S', 'N', 'A', 'P', 'S', 'H', 'T', '1'};
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::uint32_t kEndianTag = 0x01020304;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianTag;
+    std::uint64_t fileBytes;
+    std::uint64_t sequence;                            // this checkpoint
+    std::uint64_t baseSequence;                        // kFull, or the checkpoint it applies to
+    std::uint32_t sectionCount;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(Header) == 48, "the header is part of the format");
+
+struct SectionEntry {
+    std::uint32_t tag;
+    std::uint32_t recordSize;
+    std::uint64_t count;
+    std::uint64_t offset;
+};
+static_assert(sizeof(SectionEntry) == 24, "the section table is part of the format");
+
+namespace detail {
+
+inline std::size_t alignUp(std::size_t n) { return (n + kAlign - 1) / kAlign * kAlign; }
+
+template <typename T>
+constexpr void checkRecord() {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshot records must be trivially copyable (POD state)");
+    static_assert(alignof(T) <= kAlign, "record alignment above the section alignment");
+}
+
+}  // namespace detail
+
+class Writer {
+public:
+    explicit Writer(std::uint64_t sequence, std::uint64_t baseSequence = kFull)
+        : sequence_(sequence), base_(baseSequence) {}
+
+    // Every record; the span must stay valid until write()
+    template <typename T>
+    Writer& add(std::uint32_t tag, std::span<const T> records) {
+        detail::checkRecord<T>();
+        sections_.push_back({tag & ~kIndexBit, std::uint32_t(sizeof(T)), records.size(),
+                             reinterpret_cast<const std::byte*>(records.data())});
+        return *this;
+    }
+    template <typename T>
+    Writer& add(std::uint32_t tag, std::span<T> records) {
+        return add(tag, std::span<const T>(records));
+    }
+
+    // Only records[i] for i in `dirty` (gathered now), and the indices
+    template <typename T>
+    Writer& addDirty(std::uint32_t tag, std::span<const T> records, std::span<const std::uint32_t> dirty) {
+        detail::checkRecord<T>();
+        std::byte* gathered = owned_.emplace_back(std::make_unique<std::byte[]>(dirty.size() * sizeof(T) + 1)).get();
+        std::byte* indices = owned_.emplace_back(std::make_unique<std::byte[]>(dirty.size_bytes() + 1)).get();
+        T* out = reinterpret_cast<T*>(gathered);
+        for (std::size_t k = 0; k < dirty.size(); ++k) {
+            if (dirty[k] >= records.size()) throw std::out_of_range("snapshot::Writer::addDirty: index past the end");
+            std::memcpy(static_cast<void*>(out + k), &records[dirty[k]], sizeof(T));
+        }
+        if (!dirty.empty()) std::memcpy(indices, dirty.data(), dirty.size_bytes());
+        sections_.push_back({tag & ~kIndexBit, std::uint32_t(sizeof(T)), dirty.size(), gathered});
+        sections_.push_back(
+            {(tag & ~kIndexBit) | kIndexBit, std::uint32_t(sizeof(std::uint32_t)), dirty.size(), indices});
+        return *this;
+    }
+    template <typename T>
+    Writer& addDirty(std::uint32_t tag, std::span<T> records, std::span<const std::uint32_t> dirty) {
+        return addDirty(tag, std::span<const T>(records), dirty);
+    }
+
+    // Bytes write() will produce
+    std::size_t fileBytes() const {
+        std::size_t at = detail::alignUp(sizeof(Header) + sections_.size() * sizeof(SectionEntry));
+        for (const Pending& s : sections_) at = detail::alignUp(at + s.count * s.recordSize);
+        return at;
+    }
+
+    // Sections in order through stdio; for positional writes of all
+    // sections at once see Multithreading/AsyncFile.h (tryWriteAt)
+    void write(const std::string& path, bool durable = false) const {
+        Header h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, Header::kMagic, sizeof(h.magic));
+        h.version = Header::kVersion;
+        h.endianTag = Header::kEndianTag;
+        h.sequence = sequence_;
+        h.baseSequence = base_;
+        h.sectionCount = std::uint32_t(sections_.size());
+        h.fileBytes = fileBytes();
+        std::vector<SectionEntry> table;
+        std::size_t at = detail::alignUp(sizeof(Header) + sections_.size() * sizeof(SectionEntry));
+        for (const Pending& s : sections_) {
+            table.push_back({s.tag, s.recordSize, s.count, at});
+            at = detail::alignUp(at + s.count * s.recordSize);
+        }
+
+        const std::string tmp = path + ".tmp";
+        std::FILE* out = std::fopen(tmp.c_str(), "wb");
+        if (!out) throw std::system_error(errno, std::generic_category(), tmp);
+        static const char zeros[kAlign] = {};
+        std::size_t written = 0;
+        auto put = [&](const void* p, std::size_t n) {
+            if (n && std::fwrite(p, 1, n, out) != n) return false;
+            written += n;
+            return true;
+        };
+        bool ok = put(&h, sizeof(h)) && put(table.data(), table.size() * sizeof(SectionEntry));
+        for (std::size_t i = 0; ok && i < sections_.size(); ++i)
+            ok = put(zeros, table[i].offset - written) && put(sections_[i].data, table[i].count * table[i].recordSize);
+        ok = ok && put(zeros, h.fileBytes - written) && std::fflush(out) == 0;
+#ifndef _WIN32
+        ok = ok && (!durable || ::fdatasync(::fileno(out)) == 0);
+#else
+        (void)durable;
+#endif
+        const int err = errno;
+        if (std::fclose(out) != 0 || !ok) {
+            std::remove(tmp.c_str());
+            throw std::system_error(ok ? errno : err, std::generic_category(), tmp);
+        }
+        std::remove(path.c_str());                     // rename() does not replace on Win32
+        if (std::rename(tmp.c_str(), path.c_str()) != 0) throw std::system_error(errno, std::generic_category(), path);
+    }
+
+private:
+    struct Pending {
+        std::uint32_t tag;
+        std::uint32_t recordSize;
+        std::uint64_t count;
+        const std::byte* data;
+    };
+
+    std::uint64_t sequence_, base_;
+    std::vector<Pending> sections_;
+    std::vector<std::unique_ptr<std::byte[]>> owned_;  // addDirty's gathered copies
+};
+
+// A validated snapshot, mapped; sections are views into the mapping
+class View {
+public:
+    explicit View(const std::string& path, MappedFile::Mode mode = MappedFile::Mode::ReadOnly)
+        : path_(path), file_(path, mode) {
+        const std::span<const std::byte> bytes = file_.bytes();
+        if (bytes.size() < sizeof(Header)) invalid("shorter than the header");
+        std::memcpy(&header_, bytes.data(), sizeof(header_));
+        if (std::memcmp(header_.magic, Header::kMagic, sizeof(header_.magic)) != 0) invalid("bad magic");
+        if (header_.version != Header::kVersion) invalid("unsupported version " + std::to_string(header_.version));
+        if (header_.endianTag != Header::kEndianTag) invalid("written on the other byte order");
+        if (header_.fileBytes != bytes.size()) invalid("size does not match the header (truncated?)");
+        if (header_.sectionCount > (bytes.size() - sizeof(Header)) / sizeof(SectionEntry)) invalid("bad section count");
+        table_.resize(header_.sectionCount);
+        std::memcpy(table_.data(), bytes.data() + sizeof(Header), table_.size() * sizeof(SectionEntry));
+        for (const SectionEntry& s : table_)
+            if (s.offset % kAlign != 0 || s.offset > bytes.size() || s.recordSize == 0 ||
+                s.count > (bytes.size() - s.offset) / s.recordSize)
+                invalid("section outside the file");
+    }
+
+    std::uint64_t sequence() const { return header_.sequence; }
+    std::uint64_t baseSequence() const { return header_.baseSequence; }
+    bool isDelta() const { return header_.baseSequence != kFull; }
+    const MappedFile& mapping() const { return file_; }
+
+    bool has(std::uint32_t tag) const { return find(tag) != nullptr; }
+
+    template <typename T>
+    std::span<const T> section(std::uint32_t tag) const {
+        return sectionAs<const T>(tag);
+    }
+
+    // CopyOnWrite mappings: modify in place, the file is unchanged
+    template <typename T>
+    std::span<T> mutableSection(std::uint32_t tag) {
+        if (file_.mode() != MappedFile::Mode::CopyOnWrite)
+            throw std::logic_error("snapshot::View: mapped read-only; open with MappedFile::Mode::CopyOnWrite");
+        return sectionAs<T>(tag);
+    }
+
+private:
+    const SectionEntry* find(std::uint32_t tag) const {
+        for (const SectionEntry& s : table_)
+            if (s.tag == tag) return &s;
+        return nullptr;
+    }
+
+    template <typename T>
+    std::span<T> sectionAs(std::uint32_t tag) const {
+        detail::checkRecord<std::remove_const_t<T>>();
+        const SectionEntry* s = find(tag);
+        if (!s) invalid("no section " + tagName(tag));
+        if (s->recordSize != sizeof(T)) invalid("section " + tagName(tag) + " has records of another size");
+        // The mapping is page aligned and offsets are 64-aligned
+        auto* base = const_cast<std::byte*>(file_.bytes().data()) + s->offset;
+        return {reinterpret_cast<T*>(base), std::size_t(s->count)};
+    }
+
+    static std::string tagName(std::uint32_t tag) {
+        std::string name;
+        for (int i = 0; i < 4; ++i) name += char((tag >> (8 * i)) & 0x7f);
+        return (tag & kIndexBit) ? name + " (indices)" : name;
+    }
+
+    [[noreturn]] void invalid(const std::string& why) const {
+        throw std::runtime_error(path_ + ": not a usable snapshot: " + why);
+    }
+
+    std::string path_;
+    MappedFile file_;
+    Header header_;
+    std::vector<SectionEntry> table_;
+};
+
+// Copies a delta's records for `tag` into `records` (the state at
+// delta.baseSequence()); returns how many were applied
+template <typename T>
+std::size_t applyDelta(std::span<T> records, const View& delta, std::uint32_t tag) {
+    if (!delta.isDelta()) throw std::invalid_argument("snapshot::applyDelta: not a delta");
+    const std::span<const T> changed = delta.section<T>(tag);
+    const std::span<const std::uint32_t> at = delta.section<std::uint32_t>(tag | kIndexBit);
+    if (at.size() != changed.size()) throw std::runtime_error("snapshot::applyDelta: index count mismatch");
+    for (std::size_t k = 0; k < at.size(); ++k) {
+        if (at[k] >= records.size()) throw std::out_of_range("snapshot::applyDelta: index past the section");
+        records[at[k]] = changed[k];
+    }
+    return at.size();
+}
+
+// Dirty-record tracking for one section: mark() is O(1) and
+// idempotent; indices() lists each dirty record once
+class DirtySet {
+public:
+    explicit DirtySet(std::size_t records = 0) : bits_((records + 63) / 64, 0) {}
+
+    void resize(std::size_t records) { bits_.resize((records + 63) / 64, 0); }
+
+    void mark(std::uint32_t i) {
+        std::uint64_t& word = bits_[i / 64];
+        const std::uint64_t bit = std::uint64_t(1) << (i % 64);
+        if (word & bit) return;
+        word |= bit;
+        list_.push_back(i);
+    }
+
+    std::span<const std::uint32_t> indices() const { return list_; }
+    std::size_t size() const { return list_.size(); }
+
+    // After a checkpoint: clears only the marked bits
+    void clear() {
+        for (std::uint32_t i : list_) bits_[i / 64] &= ~(std::uint64_t(1) << (i % 64));
+        list_.clear();
+    }
+
+private:
+    std::vector<std::uint64_t> bits_;
+    std::vector<std::uint32_t> list_;
+};
+
+}  // namespace snapshot
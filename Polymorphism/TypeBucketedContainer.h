@@ -0,0 +1,76 @@
+// ==========================================================
+// TypeBucketedContainer.h — group Base* by dynamic type
+// ==========================================================
+//
+// A mixed array of Base* calls a DIFFERENT override on
+// almost every element:
+//
+//     Car Plane Plane Car Plane Car ...
+//      ↓    ↓     ↓    ↓    ↓    ↓
+//     indirect call whose target keeps changing
+//     → branch mispredicts, i-cache thrashing
+//
+// TypeBucketedContainer<Base, Ts...> keeps ONE bucket per
+// registered derived type. forEach() walks each bucket in a
+// MONOMORPHIC loop and calls the override with a qualified
+// name (obj->T::Update()), which is a DIRECT call the
+// compiler can inline.
+//
+// Objects whose dynamic type is not in Ts... go into a
+// fallback bucket that still uses normal virtual dispatch.
+//
+// The container does NOT own the objects (same as Model*).
+//
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <typeinfo>
+#include <vector>
+
+template <typename Base, typename... Ts>
+class TypeBucketedContainer {
+public:
+    // Put p into the bucket of its EXACT dynamic type
+    void add(Base* p) {
+        if (!(tryAdd<Ts>(p) || ...)) others_.push_back(p);
+    }
+
+    std::size_t size() const {
+        return (std::get<std::vector<Ts*>>(buckets_).size() + ... + others_.size());
+    }
+
+    template <typename T>
+    const std::vector<T*>& bucket() const { return std::get<std::vector<T*>>(buckets_); }
+
+    // f is a generic lambda: f(T* obj) with obj's static type = exact type,
+    // or f(Base* obj) for the fallback bucket
+    template <typename F>
+    void forEach(F&& f) {
+        (forBucket<Ts>(f), ...);
+        for (Base* p : others_) f(p);
+    }
+
+    void clear() {
+        (std::get<std::vector<Ts*>>(buckets_).clear(), ...);
+        others_.clear();
+    }
+
+private:
+    template <typename T>
+    bool tryAdd(Base* p) {
+        // typeid instead of dynamic_cast: a class DERIVED from T
+        // must not land in T's bucket (its override differs)
+        if (typeid(*p) != typeid(T)) return false;
+        std::get<std::vector<T*>>(buckets_).push_back(static_cast<T*>(p));
+        return true;
+    }
+
+    template <typename T, typename F>
+    void forBucket(F& f) {
+        for (T* p : std::get<std::vector<T*>>(buckets_)) f(p);
+    }
+
+    std::tuple<std::vector<Ts*>...> buckets_;
+    std::vector<Base*> others_;
+};
@@ -0,0 +1,128 @@
+// ==========================================================
+// TOPIC: Per-Frame Object Arrays from a Monotonic Arena
+// ==========================================================
+//
+// arrayObjDynamic.cpp       → Car* cars = new Car[n];   delete[] cars;
+// dynamicArrayOfPointer.cpp → Car** cars = new Car*[n];
+//                             cars[i] = new Car(i);     delete cars[i];
+//
+// If those arrays are rebuilt EVERY FRAME, the allocator is
+// hit 1 time (objects) or n + 1 times (pointers) per frame,
+// and freed just as often.
+//
+// With MonotonicArena (MonotonicArena.h):
+//
+//     MonotonicArena::Scope frame(arena);
+//     Car*  cars = arena.make_array<Car>(n);   // bump
+//     Car** ptrs = arena.make_array<Car*>(n);  // bump
+//     ptrs[i] = arena.make<Car>(i);            // bump
+//     // end of scope → everything released in O(1)
+//
+// This file measures per-frame cost at n = 100 000 Cars for
+// all four combinations.
+//
+// Build:
+//   g++ -std=c++20 -O2 carArena.cpp -o cararena
+//
+#include <chrono>
+#include <iostream>
+#include "MonotonicArena.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// Same Car as the examples, minus the cout in the constructor
+class Car {
+public:
+    int id = 0;
+    float speed = 0.0f;
+    float distance = 0.0f;
+
+    Car() = default;
+    explicit Car(int i) : id(i), speed((float)(i % 120)) {}
+
+    void drive() { distance += speed * 0.016f; }
+};
+
+static_assert(is_trivially_destructible_v<Car>, "no destructor list needed for Car");
+
+template <typename F>
+double perFrameUs(int frames, F frame) {
+    double sink = 0;
+    frame(sink);                                   // warm-up (first arena growth)
+    auto t0 = steady_clock::now();
+    for (int f = 0; f < frames; ++f) frame(sink);
+    double us = duration<double, micro>(steady_clock::now() - t0).count() / frames;
+    if (sink < 0) cout << "";                      // keep the work observable
+    return us;
+}
+
+int main() {
+    const int n = 100000;
+    const int frames = 200;
+    MonotonicArena arena;
+
+    // 1. arrayObjDynamic.cpp: new Car[n] / delete[]
+    double heapArray = perFrameUs(frames, [&](double& sink) {
+        Car* cars = new Car[n];
+        for (int i = 0; i < n; ++i) cars[i] = Car(i);
+        for (int i = 0; i < n; ++i) cars[i].drive();
+        sink += cars[n - 1].distance;
+        delete[] cars;
+    });
+
+    // 2. dynamicArrayOfPointer.cpp: new Car*[n] + new Car per slot
+    double heapPointers = perFrameUs(frames, [&](double& sink) {
+        Car** cars = new Car*[n];
+        for (int i = 0; i < n; ++i) cars[i] = new Car(i);
+        for (int i = 0; i < n; ++i) cars[i]->drive();
+        sink += cars[n - 1]->distance;
+        for (int i = 0; i < n; ++i) delete cars[i];
+        delete[] cars;
+    });
+
+    // 3. Arena array of objects
+    double arenaArray = perFrameUs(frames, [&](double& sink) {
+        MonotonicArena::Scope frame(arena);
+        Car* cars = arena.make_array<Car>(n);
+        for (int i = 0; i < n; ++i) cars[i] = Car(i);
+        for (int i = 0; i < n; ++i) cars[i].drive();
+        sink += cars[n - 1].distance;
+    });
+
+    // 4. Arena array of pointers + one arena Car per slot
+    double arenaPointers = perFrameUs(frames, [&](double& sink) {
+        MonotonicArena::Scope frame(arena);
+        Car** cars = arena.make_array<Car*>(n);
+        for (int i = 0; i < n; ++i) cars[i] = arena.make<Car>(i);
+        for (int i = 0; i < n; ++i) cars[i]->drive();
+        sink += cars[n - 1]->distance;
+    });
+
+    cout << n << " Cars per frame, " << frames << " frames" << endl;
+    cout << "new Car[n]           / delete[]   : " << heapArray << " us/frame" << endl;
+    cout << "new Car*[n] + n x new / n x delete: " << heapPointers << " us/frame" << endl;
+    cout << "arena.make_array<Car>(n)          : " << arenaArray << " us/frame" << endl;
+    cout << "arena.make_array<Car*> + n x make : " << arenaPointers << " us/frame" << endl;
+    cout << "arena chunks after reset: " << arena.chunkCount() << ", reserved "
+         << arena.bytesReserved() / 1024 << " KB" << endl;
+    return 0;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A monotonic (bump) arena never frees individual objects;
+//    it releases EVERYTHING at once by rewinding a cursor.
+// 2. Perfect for data with a shared lifetime: one frame,
+//    one request, one parse.
+// 3. Arena-allocated objects are also CONTIGUOUS, so even the
+//    Car** version walks memory in order.
+// 4. Destructors still matter: non-trivial types must be
+//    destroyed before the memory is reused.
+//
+// ⭐ One-Line Interview Answer
+// “When many objects die together, allocate them from a
+// monotonic arena: allocation is a pointer bump and freeing
+// the whole frame is a single reset.”
@@ -0,0 +1,161 @@
+// ==========================================================
+// TOPIC: Where `final` Pays Off — Devirtualized Calls, Measured
+// ==========================================================
+//
+// poly.cpp:
+//
+//     class Car : public Vehicle {
+//         void start() override final { ... }
+//     };
+//     Vehicle* v = new Car();
+//     v->start();                 // final_and_base_call_demo
+//
+// `final` tells the compiler no class overrides Car::start
+// again — but only a call whose STATIC type is Car (or below)
+// can use that. Through Vehicle* it is still a vtable load and
+// an indirect call, unless the optimizer can prove (or guess)
+// the dynamic type.
+//
+// Measured here, one start() per iteration:
+//   1. Vehicle* (dynamic type hidden)        → indirect call
+//   2. Truck*, Truck::start not final        → still indirect
+//                                              (a subclass might override)
+//   3. Car*, Car::start `override final`     → direct call, inlined
+//   4. Bus*, `class Bus final`               → direct call, inlined
+//   5. Vehicle*, but with a type guard: if the vptr says Car,
+//      call through Car& (what speculative devirtualization emits)
+//
+// devirtReport.sh compiles this file and the other Polymorphism
+// examples with the devirtualization flags (GCC: -flto and
+// -fdevirtualize-at-ltrans; Clang: -flto -fwhole-program-vtables
+// -fstrict-vtable-pointers) and lists every call site the
+// compiler devirtualized.
+//
+// Build:
+//   g++ -std=c++20 -O2 devirtBench.cpp -o devirtbench
+//   g++ -std=c++20 -O2 -flto -fdevirtualize-at-ltrans devirtBench.cpp -o devirtbench_lto
+//
+#include <cstdint>
+#include <iostream>
+#include <typeinfo>
+#include "../Benchmarks/MicroBench.h"
+
+using namespace std;
+
+// poly.cpp's Vehicle / Car, with state instead of cout
+class Vehicle {
+public:
+    virtual void start() { ++starts; }
+    virtual ~Vehicle() {}
+    uint64_t starts = 0;
+};
+
+class Car : public Vehicle {
+public:
+    void start() override final { starts += 2; }
+};
+
+class Truck : public Vehicle {
+public:
+    void start() override { starts += 3; }
+};
+
+class Bus final : public Vehicle {
+public:
+    void start() override { starts += 4; }
+};
+
+// The optimizer must not see which type comes back
+__attribute__((noinline)) Vehicle* makeVehicle(int kind) {
+    switch (kind) {
+        case 1: return new Car();
+        case 2: return new Truck();
+        case 3: return new Bus();
+        default: return new Vehicle();
+    }
+}
+
+template <typename T>
+T* hidden(int kind) {
+    Vehicle* v = makeVehicle(kind);
+    doNotOptimize(v);
+    return static_cast<T*>(v);
+}
+
+int main() {
+    Vehicle* viaBase = hidden<Vehicle>(1);
+    Truck* truck = hidden<Truck>(2);
+    Car* car = hidden<Car>(1);
+    Bus* bus = hidden<Bus>(3);
+    Vehicle* guarded = hidden<Vehicle>(1);
+
+    MicroBench bench("start() per iteration");
+    bench
+        .add("Vehicle* -> Car (indirect)",
+             [&](uint64_t n) {
+                 for (uint64_t i = 0; i < n; ++i) {
+                     viaBase->start();
+                     doNotOptimize(viaBase);                     // re-hide it every time
+                 }
+             })
+        .add("Truck*, start() not final",
+             [&](uint64_t n) {
+                 for (uint64_t i = 0; i < n; ++i) {
+                     truck->start();
+                     doNotOptimize(truck);
+                 }
+             })
+        .add("Car*, start() override final",
+             [&](uint64_t n) {
+                 for (uint64_t i = 0; i < n; ++i) {
+                     car->start();
+                     doNotOptimize(car);
+                 }
+             })
+        .add("Bus*, class Bus final",
+             [&](uint64_t n) {
+                 for (uint64_t i = 0; i < n; ++i) {
+                     bus->start();
+                     doNotOptimize(bus);
+                 }
+             })
+        .add("Vehicle* + typeid guard to Car&", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                if (typeid(*guarded) == typeid(Car))
+                    static_cast<Car*>(guarded)->start();            // final: direct
+                else
+                    guarded->start();
+                doNotOptimize(guarded);
+            }
+        });
+    auto r = bench.run();
+
+    // Same work done: each call reached the right override
+    bool ok = viaBase->starts % 2 == 0 && truck->starts % 3 == 0 && car->starts % 2 == 0 && bus->starts % 4 == 0 &&
+              guarded->starts % 2 == 0 && car->starts > 0;
+    cout << "final saves " << r[0].medianNs - r[2].medianNs << " ns per call here; devirtualized / indirect: x"
+         << r[2].medianNs / r[0].medianNs << " (Car*), x" << r[3].medianNs / r[0].medianNs << " (Bus*)" << endl;
+
+    for (Vehicle* v : {viaBase, static_cast<Vehicle*>(truck), static_cast<Vehicle*>(car), static_cast<Vehicle*>(bus), guarded})
+        delete v;
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. `final` only helps calls whose static type is the final
+//    class (or has the final override); Base* calls stay virtual.
+// 2. A devirtualized call is direct, so it can be INLINED — the
+//    real win is the optimization that inlining unlocks.
+// 3. With LTO the compiler sees the whole class hierarchy and
+//    can devirtualize calls whose target is provably unique.
+// 4. Speculative devirtualization is a vptr compare plus a
+//    direct call, with the indirect call as fallback.
+//
+// ⭐ One-Line Interview Answer
+// “Mark leaf classes and overrides final and call through the
+// most-derived type you have: the compiler turns the vtable
+// call into a direct, inlinable one.”
@@ -0,0 +1,132 @@
+#!/usr/bin/env bash
+# ==========================================================
+# devirtReport.sh — which virtual calls did the compiler remove?
+# ==========================================================
+#
+# Compiles the Polymorphism examples with the devirtualization
+# flags and prints, per file and source line:
+#
+#   DIRECT       no indirect call left: the type was proven
+#                (`final`, a known local object, LTO seeing every
+#                override) or the code was inlined away
+#   SPECULATIVE  vptr compare + direct call, indirect fallback
+#   VIRTUAL      still a plain indirect call
+#
+# (GCC: every virtual call in the source is listed from an -O0
+# build, then looked up in the optimized build's GIMPLE dump,
+# -fdump-tree-optimized-lineno. Clang: its -Rpass remarks.)
+#
+# Calls through a `final` class or a `final` override never
+# show up: the front end already emits them as direct calls,
+# even at -O0 (devirtBench.cpp rows 3 and 4).
+#
+# pgoReport.sh classifies the same way after a profile-guided
+# rebuild (indirect-call promotion shows up as SPECULATIVE).
+#
+# Usage (from this directory):
+#   ./devirtReport.sh                       # default file list, all modes
+#   ./devirtReport.sh poly.cpp Vtable.cpp   # chosen files
+#   CXX=clang++ ./devirtReport.sh           # Clang remarks instead
+#
+# Modes:
+#   GCC:   -O2  |  -O2 -flto -fdevirtualize-at-ltrans
+#   Clang: -O2  |  -O2 -flto -fwhole-program-vtables -fstrict-vtable-pointers
+#
+set -u
+
+CXX=${CXX:-g++}
+STD=${STD:--std=c++20}
+here=$(cd "$(dirname "$0")" && pwd)
+
+if [ $# -gt 0 ]; then
+    files=("$@")
+else
+    files=(poly.cpp devirtBench.cpp Vtable.cpp virtualFunc.cpp overrideExample.cpp polyVector.cpp)
+fi
+
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+if "$CXX" --version 2>/dev/null | grep -qi clang; then
+    family=clang
+    modes=("-O2" "-O2 -flto -fwhole-program-vtables -fstrict-vtable-pointers")
+else
+    family=gcc
+    modes=("-O2" "-O2 -flto -fdevirtualize-at-ltrans")
+fi
+
+# Virtual call sites of $base in the dumps given: "line:col<TAB>V|S<TAB>class".
+# V = indirect call left; S = speculative check (the PROF_ =
+# [obj_type_ref] compare; its site is the last located statement)
+sites_in_dumps() {
+    local base=$1
+    shift
+    awk -v base="$base" '
+        match($0, /\[[^]]*:[0-9]+:[0-9]+\]/) {
+            loc = substr($0, RSTART + 1, RLENGTH - 2)
+            n = split(loc, part, ":")
+            file = part[n - 2]; sub(/.*\//, "", file)
+            last = (file == base) ? part[n - 1] ":" part[n] : ""
+        }
+        /OBJ_TYPE_REF\(/ {
+            cls = $0; sub(/.*OBJ_TYPE_REF\([^;]*;\(/, "", cls); sub(/\).*/, "", cls)
+            if ($0 ~ /= \[obj_type_ref\]/) { if (last != "") print last "\tS\t" cls }
+            else if (file == base && last != "") print last "\tV\t" cls
+        }' "$@" | sort -u
+}
+
+# One line per virtual call site in the source (taken from an
+# -O0 build, where every one is still indirect), classified by
+# what is left of it in the optimized build
+report_gcc() {
+    local src=$1 flags=$2 base
+    base=$(basename "$src")
+    (
+        cd "$tmp" || exit 1
+        rm -rf O0 opt
+        mkdir O0 opt
+        # shellcheck disable=SC2086
+        (cd O0 && "$CXX" $STD -O0 -fdump-tree-optimized-lineno -c "$src" -o prog.o) || exit 1
+        # shellcheck disable=SC2086
+        (cd opt && "$CXX" $STD $flags -fdump-tree-optimized-lineno "$src" -o prog) || exit 1
+        sites_in_dumps "$base" O0/*.optimized > all.txt
+        sites_in_dumps "$base" opt/*.optimized > left.txt
+        while IFS=$'\t' read -r site _ cls; do
+            if grep -q "^$site	S" left.txt; then
+                echo "$site SPECULATIVE call through $cls (vptr compare + direct call)"
+            elif grep -q "^$site	V" left.txt; then
+                echo "$site VIRTUAL call through $cls"
+            else
+                echo "$site DIRECT call through $cls (devirtualized, or inlined away)"
+            fi
+        done < all.txt
+    ) | sort -t: -k1,1n -k2,2n -u
+}
+
+report_clang() {
+    local src=$1 flags=$2 base
+    base=$(basename "$src")
+    (
+        cd "$tmp" || exit 1
+        # shellcheck disable=SC2086
+        "$CXX" $STD $flags -Rpass=wholeprogramdevirt -Rpass=inline "$src" -o prog 2> info.txt
+        grep -F "$base:" info.txt | sed -n \
+            -e 's/^[^:]*:\([0-9]*\):[0-9]*: remark: \(.*devirtualized.*\) \[-Rpass=wholeprogramdevirt\]$/\1 DEVIRTUALIZED \2/p' \
+            -e 's/^[^:]*:\([0-9]*\):[0-9]*: remark: \(.*\) inlined into \(.*\) with .*$/\1 INLINED \2 into \3/p'
+    ) | sort -n -u
+}
+
+for mode in "${modes[@]}"; do
+    echo "== $CXX $mode"
+    for f in "${files[@]}"; do
+        src="$here/$f"
+        [ -f "$src" ] || { echo "-- $f: not found"; continue; }
+        echo "-- $f"
+        if [ "$family" = gcc ]; then out=$(report_gcc "$src" "$mode"); else out=$(report_clang "$src" "$mode"); fi
+        if [ -z "$out" ]; then echo "   (no virtual call sites reported)"; continue; fi
+        echo "$out" | sed 's/^/   line /'
+        printf '   => %s direct, %s speculative, %s still virtual\n' \
+            "$(grep -c ' DIRECT \| DEVIRTUALIZED ' <<<"$out")" "$(grep -c ' SPECULATIVE ' <<<"$out")" "$(grep -c ' VIRTUAL ' <<<"$out")"
+    done
+    echo
+done
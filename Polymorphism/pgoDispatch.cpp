@@ -0,0 +1,256 @@
+// ==========================================================
+// TOPIC: Profile-Guided Optimization of Virtual Dispatch
+// ==========================================================
+//
+// Vtable.cpp / poly.cpp:
+//
+//     Model* m1 = new Car();
+//     m1->Draw();                 // vptr -> vtable -> Car::Draw
+//     animals[i]->speak();        // one indirect call per object
+//
+// ❌ the compiler cannot know which override a call site will
+//    reach, so every call is a load, an indirect branch and no
+//    inlining — even when 60% of the scene is Cars
+// ✅ PGO measures it: an instrumented build counts the targets
+//    of each indirect call, and the rebuild PROMOTES a dominant
+//    target — `if (target == &Car::Draw) <Car::Draw inlined>
+//    else <indirect call>` — a predictable compare instead of an
+//    indirect branch, and an inlined body
+//
+// This program is the workload: a scene of Vtable.cpp's Models
+// (Model / Car / Plane: Update + Draw) and poly.cpp's Animals
+// (Animal / Dog / Cat: speak), mixed and shuffled, updated for a
+// number of passes. The mix is read from a scene file:
+//
+//     workloads/mixed_scene_train.txt    what PGO trains on
+//     workloads/mixed_scene_eval.txt     same mix, another scene
+//     workloads/shuffled_scene_eval.txt  the same mix, no grouping
+//     workloads/shifted_scene_eval.txt   Planes and Cats dominate
+//
+// (no argument: the training mix, built in — what build.sh's pgo
+// configuration trains with). pgoReport.sh runs the whole
+// pipeline — instrument, train, rebuild — and reports per call
+// site whether it was promoted, and the speedup on each scene.
+//
+// Measured here: ns per virtual call over the scene (median pass).
+// pgoReport.sh on this machine (GCC 12, -O2): all three hot
+// sites promoted (Update to Model::Update — Car inherits it),
+// 1.2x on the trained mix, 1.0-1.3x (noisy) fully shuffled,
+// 0.85-0.95x on the shifted scene: a stale profile costs.
+//
+// Build:
+//   g++ -std=c++20 -O2 pgoDispatch.cpp -o pgodispatch
+//   (PGO: ./pgoReport.sh, or ../Benchmarks/build.sh --config=o2,pgo --compare pgoDispatch)
+//
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+// Vtable.cpp's hierarchy, with state instead of cout
+namespace vtable {
+
+class Model {
+public:
+    virtual void Update() { updates += 1; }
+    virtual void Draw() { draws += 1; }
+    virtual ~Model() {}
+    uint64_t updates = 0, draws = 0;
+};
+
+class Car : public Model {                   // Update() inherited
+public:
+    void Draw() override { draws += 2; }
+};
+
+class Plane : public Model {
+public:
+    void Update() override { updates += 3; }
+    void Draw() override { draws += 4; }
+};
+
+}  // namespace vtable
+
+// poly.cpp's hierarchy
+namespace poly {
+
+class Animal {
+public:
+    virtual void speak() { sounds += 1; }
+    virtual ~Animal() {}
+    uint64_t sounds = 0;
+};
+
+class Dog : public Animal {
+public:
+    void speak() override { sounds += 2; }
+};
+
+class Cat : public Animal {
+public:
+    void speak() override { sounds += 3; }
+};
+
+}  // namespace poly
+
+// Defaults: workloads/mixed_scene_train.txt
+struct SceneSpec {
+    int objects = 100000;                     // per hierarchy
+    int passes = 20;
+    unsigned seed = 1;
+    int cluster = 8;                          // objects of one type spawned together
+    double model = 15, car = 60, plane = 25;  // weights
+    double animal = 5, dog = 70, cat = 25;
+};
+
+// "key value" lines, '#' comments; see workloads/*.txt
+SceneSpec readScene(const string& path) {
+    ifstream in(path);
+    if (!in) throw invalid_argument("cannot open scene file " + path);
+    SceneSpec s;
+    string line;
+    for (int lineNo = 1; getline(in, line); ++lineNo) {
+        line = line.substr(0, line.find('#'));
+        istringstream fields(line);
+        string key;
+        double value;
+        if (!(fields >> key)) continue;
+        if (!(fields >> value) || value < 0)
+            throw invalid_argument(path + ":" + to_string(lineNo) + ": expected `" + key + " <non-negative number>`");
+        if (key == "objects") s.objects = int(value);
+        else if (key == "passes") s.passes = int(value);
+        else if (key == "seed") s.seed = unsigned(value);
+        else if (key == "cluster") s.cluster = int(value);
+        else if (key == "Model") s.model = value;
+        else if (key == "Car") s.car = value;
+        else if (key == "Plane") s.plane = value;
+        else if (key == "Animal") s.animal = value;
+        else if (key == "Dog") s.dog = value;
+        else if (key == "Cat") s.cat = value;
+        else throw invalid_argument(path + ":" + to_string(lineNo) + ": unknown key `" + key + "`");
+    }
+    if (s.objects <= 0 || s.passes <= 0 || s.cluster <= 0)
+        throw invalid_argument(path + ": objects, passes and cluster must be positive");
+    if (s.model + s.car + s.plane == 0 || s.animal + s.dog + s.cat == 0)
+        throw invalid_argument(path + ": every hierarchy needs a non-zero weight");
+    return s;
+}
+
+// The optimizer must not see which type comes back
+__attribute__((noinline)) vtable::Model* makeModel(int kind) {
+    if (kind == 1) return new vtable::Car();
+    if (kind == 2) return new vtable::Plane();
+    return new vtable::Model();
+}
+
+__attribute__((noinline)) poly::Animal* makeAnimal(int kind) {
+    if (kind == 1) return new poly::Dog();
+    if (kind == 2) return new poly::Cat();
+    return new poly::Animal();
+}
+
+// Kinds 0 / 1 / 2 in proportion to the weights, shuffled in
+// groups of `cluster` objects of one kind
+vector<int> mixKinds(int n, int cluster, double w0, double w1, double w2, mt19937& rng) {
+    const int groups = (n + cluster - 1) / cluster;
+    vector<int> groupKinds(groups);
+    const double total = w0 + w1 + w2;
+    for (int g = 0; g < groups; ++g) {
+        const double at = (g + 0.5) * total / groups;
+        groupKinds[g] = at < w0 ? 0 : at < w0 + w1 ? 1 : 2;
+    }
+    shuffle(groupKinds.begin(), groupKinds.end(), rng);
+    vector<int> kinds(n);
+    for (int i = 0; i < n; ++i) kinds[i] = groupKinds[i / cluster];
+    return kinds;
+}
+
+// The hot loop: three virtual call sites
+void updateScene(const vector<vtable::Model*>& models, const vector<poly::Animal*>& animals) {
+    for (vtable::Model* m : models) {
+        m->Update();
+        m->Draw();
+    }
+    for (poly::Animal* a : animals) a->speak();
+}
+
+int main(int argc, char** argv) {
+    SceneSpec spec;
+    string source = "built-in training mix";
+    try {
+        if (argc > 1) spec = readScene(source = argv[1]);
+    } catch (const invalid_argument& e) {
+        cerr << e.what() << endl;
+        return 2;
+    }
+
+    mt19937 rng(spec.seed);
+    const vector<int> modelKinds = mixKinds(spec.objects, spec.cluster, spec.model, spec.car, spec.plane, rng);
+    const vector<int> animalKinds = mixKinds(spec.objects, spec.cluster, spec.animal, spec.dog, spec.cat, rng);
+    vector<vtable::Model*> models;
+    vector<poly::Animal*> animals;
+    for (int k : modelKinds) models.push_back(makeModel(k));
+    for (int k : animalKinds) animals.push_back(makeAnimal(k));
+
+    vector<double> passNs;
+    for (int p = 0; p < spec.passes; ++p) {
+        auto t0 = steady_clock::now();
+        updateScene(models, animals);
+        passNs.push_back(double(duration_cast<nanoseconds>(steady_clock::now() - t0).count()));
+    }
+    sort(passNs.begin(), passNs.end());
+    const double callsPerPass = 3.0 * spec.objects;
+    const double nsPerCall = passNs[passNs.size() / 2] / callsPerPass;
+
+    // Every call reached its override: per object, per pass,
+    // Model 1+1, Car 1+2, Plane 3+4, Animal 1, Dog 2, Cat 3
+    const uint64_t perModelKind[] = {2, 3, 7}, perAnimalKind[] = {1, 2, 3};
+    uint64_t expected = 0, actual = 0;
+    for (int k : modelKinds) expected += perModelKind[k] * uint64_t(spec.passes);
+    for (int k : animalKinds) expected += perAnimalKind[k] * uint64_t(spec.passes);
+    for (vtable::Model* m : models) actual += m->updates + m->draws;
+    for (poly::Animal* a : animals) actual += a->sounds;
+    bool ok = actual == expected;
+
+    for (vtable::Model* m : models) delete m;
+    for (poly::Animal* a : animals) delete a;
+
+    const double modelWeight = spec.model + spec.car + spec.plane, animalWeight = spec.animal + spec.dog + spec.cat;
+    cout << "scene: " << source << endl;
+    cout << "  " << spec.objects << " Models (Model " << 100 * spec.model / modelWeight << "%, Car "
+         << 100 * spec.car / modelWeight << "%, Plane " << 100 * spec.plane / modelWeight << "%), " << spec.objects
+         << " Animals (Animal " << 100 * spec.animal / animalWeight << "%, Dog " << 100 * spec.dog / animalWeight
+         << "%, Cat " << 100 * spec.cat / animalWeight << "%), " << spec.passes << " passes" << endl;
+    cout << "virtual calls: " << uint64_t(callsPerPass) * uint64_t(spec.passes) << ", " << nsPerCall
+         << " ns/call (median pass)" << endl;
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A virtual call site usually has a dominant target; only
+//    a profile can tell the compiler which one.
+// 2. Indirect-call promotion turns the call into a compare
+//    against that target, a direct (inlinable) call, and the
+//    indirect call as fallback — correct for any type.
+// 3. The gain depends on the training data: a stale profile
+//    promotes the wrong target and the compare is wasted.
+// 4. Commit the training inputs with the code, or the PGO build
+//    cannot be reproduced.
+//
+// ⭐ One-Line Interview Answer
+// “PGO records which override each virtual call actually hits and
+// rebuilds the call as a guarded direct call — profitable as long
+// as the training workload looks like production.”
@@ -0,0 +1,140 @@
+#!/usr/bin/env bash
+# ==========================================================
+# pgoReport.sh — instrument, train, rebuild; what did PGO promote?
+# ==========================================================
+#
+# The profile-guided pipeline for pgoDispatch.cpp (Vtable.cpp's and
+# poly.cpp's hierarchies on a mixed, shuffled scene):
+#
+#   1. baseline   -O2
+#   2. instrument -O2 -fprofile-generate
+#   3. train      run it on every workloads/*_train.txt
+#   4. rebuild    -O2 -fprofile-use
+#
+# then reports
+#
+#   - per virtual call site of the source, what is left of it in
+#     the baseline and in the PGO build (devirtReport.sh's
+#     classification: VIRTUAL, SPECULATIVE = promoted to a guarded
+#     direct call, DIRECT) and the targets PGO promoted it to
+#   - the promotion rate: promoted sites / virtual call sites
+#   - ns per virtual call, baseline vs PGO, on every scene in
+#     workloads/ (best of 3 runs each) and the speedup
+#
+# The training inputs are committed (workloads/), so the profile —
+# and the PGO build — can be reproduced. *_eval.txt scenes are
+# never trained on; shifted_scene_eval.txt has a different mix
+# altogether, to show what a stale profile costs.
+#
+# Usage (from anywhere; GCC only):
+#   ./pgoReport.sh
+#   ./pgoReport.sh workloads/mixed_scene_eval.txt   # chosen scenes to time
+#   CXXFLAGS="-O3 -march=native" ./pgoReport.sh      # another base level
+#
+set -u
+
+CXX=${CXX:-g++}
+STD=${STD:--std=c++20}
+CXXFLAGS=${CXXFLAGS:--O2}
+here=$(cd "$(dirname "$0")" && pwd)
+src=$here/pgoDispatch.cpp
+base=$(basename "$src")
+
+[ $# -gt 0 ] || set -- "$here"/workloads/*.txt
+scenes=()
+for s in "$@"; do
+    [ -f "$s" ] || { echo "no scene file $s" >&2; exit 2; }
+    scenes+=("$(cd "$(dirname "$s")" && pwd)/$(basename "$s")")
+done
+trains=("$here"/workloads/*_train.txt)
+
+if "$CXX" --version 2>/dev/null | grep -qi clang; then
+    echo "pgoReport.sh reads GCC dumps; use Clang's -fprofile-instr-generate / llvm-profdata by hand" >&2
+    exit 2
+fi
+
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+# The site classifier is devirtReport.sh's
+source <(sed -n '/^sites_in_dumps() {/,/^}/p' "$here/devirtReport.sh")
+
+# "line:col<TAB>target" per promoted target: the site of
+# `PROF_n = [obj_type_ref] ...`, the function of `if (PROF_n == f)`
+promotions() {
+    awk -v base="$base" '
+        match($0, /\[[^]]*:[0-9]+:[0-9]+\]/) {
+            loc = substr($0, RSTART + 1, RLENGTH - 2)
+            n = split(loc, part, ":")
+            file = part[n - 2]; sub(/.*\//, "", file)
+            last = (file == base) ? part[n - 1] ":" part[n] : ""
+        }
+        /PROF_[0-9]+ = \[obj_type_ref\]/ { p = $1; sub(/^.*PROF_/, "PROF_", p); site[p] = last }
+        /if \(PROF_[0-9]+ == / {
+            p = $2; sub(/^\(/, "", p); f = $4; sub(/\).*/, "", f)
+            if (site[p] != "") print site[p] "\t" f
+        }' "$@" | c++filt | sort -u
+}
+
+kind() {
+    if grep -q "^$1	S" "$2"; then echo SPECULATIVE
+    elif grep -q "^$1	V" "$2"; then echo VIRTUAL
+    else echo DIRECT
+    fi
+}
+
+cd "$tmp" || exit 1
+mkdir O0 base pgo prof
+echo "== $CXX $STD $CXXFLAGS, profile from: ${trains[*]##*/}"
+# shellcheck disable=SC2086
+(cd O0 && "$CXX" $STD -O0 -fdump-tree-optimized-lineno -c "$src" -o prog.o) || exit 1
+# shellcheck disable=SC2086
+(cd base && "$CXX" $STD $CXXFLAGS -fdump-tree-optimized-lineno "$src" -o prog) || exit 1
+
+# Instrumented and optimized builds need the same output name:
+# the .gcda file is named after it
+# shellcheck disable=SC2086
+(cd pgo && "$CXX" $STD $CXXFLAGS -fprofile-generate="$tmp/prof" -fprofile-update=prefer-atomic "$src" -o prog) || exit 1
+for t in "${trains[@]}"; do
+    pgo/prog "$t" > /dev/null || { echo "training run on $t failed" >&2; exit 1; }
+done
+rm -f pgo/*.optimized
+# shellcheck disable=SC2086
+(cd pgo && "$CXX" $STD $CXXFLAGS -fprofile-use="$tmp/prof" -Wno-missing-profile \
+    -fdump-tree-optimized-lineno-asmname "$src" -o prog) || exit 1
+
+sites_in_dumps "$base" O0/*.optimized > all.txt
+sites_in_dumps "$base" base/*.optimized > base.txt
+sites_in_dumps "$base" pgo/*.optimized > pgo.txt
+promotions pgo/*.optimized > promoted.txt
+
+echo "-- virtual call sites of $base: baseline -> PGO"
+total=0 promoted=0
+while IFS=$'\t' read -r site _ cls; do
+    before=$(kind "$site" base.txt)
+    after=$(kind "$site" pgo.txt)
+    targets=$(grep "^$site	" promoted.txt | cut -f2 | paste -sd' ' -)
+    total=$((total + 1))
+    [ "$after" = SPECULATIVE ] && [ "$before" != SPECULATIVE ] && promoted=$((promoted + 1))
+    printf '   line %-8s %-24s %-11s -> %-11s %s\n' "$site" "$cls" "$before" "$after" "${targets:+promoted to $targets}"
+done < <(sort -t: -k1,1n -k2,2n -u all.txt)
+printf '   => %d of %d virtual call sites promoted by the profile\n' "$promoted" "$total"
+
+best_ns() {
+    local bin=$1 scene=$2 best= ns r
+    for r in 1 2 3; do
+        ns=$("$bin" "$scene" | sed -n 's/.*, \([0-9.]*\) ns\/call.*/\1/p')
+        [ -n "$ns" ] || { echo "?"; return; }
+        if [ -z "$best" ] || awk -v a="$ns" -v b="$best" 'BEGIN { exit !(a < b) }'; then best=$ns; fi
+    done
+    echo "$best"
+}
+
+echo "-- ns per virtual call (best of 3)"
+printf '   %-28s %10s %10s %9s\n' scene baseline PGO speedup
+for s in "${scenes[@]}"; do
+    b=$(best_ns base/prog "$s")
+    p=$(best_ns pgo/prog "$s")
+    printf '   %-28s %10s %10s %9s\n' "$(basename "$s")" "$b" "$p" \
+        "$(awk -v b="$b" -v p="$p" 'BEGIN { if (p + 0 > 0) printf "%.2fx", b / p; else print "-" }')"
+done
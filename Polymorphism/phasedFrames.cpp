@@ -0,0 +1,242 @@
+// ==========================================================
+// TOPIC: Parallel Frame Steps — Phases, Double Buffers, std::barrier
+// ==========================================================
+//
+// Vtable.cpp / soaGameObjects.cpp:
+//
+//     for (int i = 0; i < n; ++i) objects[i]->Update();   // serial, every frame
+//
+// ❌ one core runs the whole frame; the others idle
+// ❌ splitting the loop over threads is a data race as soon as an
+//    update reads ANOTHER object (object i reads i+1 while another
+//    thread is moving it) — and a lock per object costs more than
+//    the update
+//
+// ✅ PhasedFrameLoop.h: read / compute / commit phases separated
+//    by std::barrier, object state double-buffered (read from the
+//    front, write the back, swap at the frame's end), lanes on the
+//    work-stealing ThreadPool — no lock in any phase body
+//
+// The world: n objects on a ring, each pulled towards its two
+// neighbours (a spring chain), damped, bounced off the walls —
+// every update READS the neighbours' positions:
+//   read    force[i] from front x/y of i-1, i, i+1
+//   compute back v/x/y of i from front v/x/y and force[i]
+//   commit  bounce back x/y/v of i off the walls
+//   frame end: swap front and back
+//
+// Measured here:
+//   1. ms per frame for 1, 2, 4 ... lanes, speedup over 1 lane,
+//      each phase's share of the frame, barrier wait per lane
+//   2. every lane count ends with the SAME bits as a plain serial
+//      loop over the same phases (the double buffer makes the
+//      result independent of scheduling)
+//
+// Scaling needs cores: on a machine with fewer cores than lanes
+// the lanes take turns on a core and the frame gets slower, not
+// faster (this sandbox has one).
+//
+// ------------------------------------------------------
+// RUNTIME CONFIGURATION
+// ------------------------------------------------------
+//
+//   ./frames [objects] [frames] [max lanes]
+//
+//   objects   → default 1000000
+//   frames    → per measurement (default 20)
+//   max lanes → 1, 2, 4 ... up to this (default: the core count)
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread phasedFrames.cpp -o frames
+//
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../Multithreading/PhasedFrameLoop.h"
+#include "../Multithreading/ThreadPool.h"
+
+using namespace std;
+using namespace std::chrono;
+
+const float dt = 0.016f;
+const float stiffness = 4.0f;
+const float damping = 0.995f;
+const float wall = 100.0f;
+
+struct State {
+    vector<float> x, y, vx, vy;
+    explicit State(size_t n) : x(n), y(n), vx(n), vy(n) {}
+};
+
+struct World {
+    State a, b;
+    State* front = &a;
+    State* back = &b;
+    vector<float> fx, fy;                   // scratch: written in read, read in compute
+
+    explicit World(size_t n) : a(n), b(n), fx(n), fy(n) {
+        uint64_t s = 0x2545F4914F6CDD1Dull;
+        auto next = [&] {
+            s ^= s << 13;
+            s ^= s >> 7;
+            s ^= s << 17;
+            return float(s >> 40) / float(1 << 24) * 2.0f - 1.0f;
+        };
+        for (size_t i = 0; i < n; ++i) {
+            a.x[i] = next() * wall;
+            a.y[i] = next() * wall;
+            a.vx[i] = next() * 10.0f;
+            a.vy[i] = next() * 10.0f;
+        }
+    }
+    size_t size() const { return fx.size(); }
+
+    // ---- the phases: each writes only [b, e) of its outputs ----
+    void read(size_t b, size_t e) {
+        const State& s = *front;
+        const size_t n = size();
+        for (size_t i = b; i < e; ++i) {
+            const size_t l = i == 0 ? n - 1 : i - 1, r = i + 1 == n ? 0 : i + 1;
+            fx[i] = stiffness * (s.x[l] + s.x[r] - 2.0f * s.x[i]);
+            fy[i] = stiffness * (s.y[l] + s.y[r] - 2.0f * s.y[i]);
+        }
+    }
+    void compute(size_t b, size_t e) {
+        const State& s = *front;
+        State& o = *back;
+        for (size_t i = b; i < e; ++i) {
+            const float speed = std::sqrt(s.vx[i] * s.vx[i] + s.vy[i] * s.vy[i]);
+            const float drag = damping / (1.0f + 0.001f * speed);
+            o.vx[i] = s.vx[i] * drag + fx[i] * dt;
+            o.vy[i] = s.vy[i] * drag + fy[i] * dt;
+            o.x[i] = s.x[i] + o.vx[i] * dt;
+            o.y[i] = s.y[i] + o.vy[i] * dt;
+        }
+    }
+    void commit(size_t b, size_t e) {
+        State& o = *back;
+        for (size_t i = b; i < e; ++i) {
+            if (std::fabs(o.x[i]) > wall) {
+                o.x[i] = std::copysign(wall, o.x[i]);
+                o.vx[i] = -o.vx[i];
+            }
+            if (std::fabs(o.y[i]) > wall) {
+                o.y[i] = std::copysign(wall, o.y[i]);
+                o.vy[i] = -o.vy[i];
+            }
+        }
+    }
+    void swap() { std::swap(front, back); }
+
+    bool sameBits(const World& o) const {
+        const State& s = *front;
+        const State& t = *o.front;
+        auto eq = [](const vector<float>& p, const vector<float>& q) {
+            return memcmp(p.data(), q.data(), p.size() * sizeof(float)) == 0;
+        };
+        return eq(s.x, t.x) && eq(s.y, t.y) && eq(s.vx, t.vx) && eq(s.vy, t.vy);
+    }
+};
+
+int main(int argc, char** argv) {
+    const long objects = argc > 1 ? atol(argv[1]) : 1000000;
+    const long frames = argc > 2 ? atol(argv[2]) : 20;
+    const long cores = long(max(1u, thread::hardware_concurrency()));
+    const long maxLanes = argc > 3 ? atol(argv[3]) : cores;
+    if (objects < 2 || frames < 1 || maxLanes < 1 || maxLanes > 256) {
+        cerr << "usage: frames [objects >= 2] [frames >= 1] [max lanes 1..256]" << endl;
+        return 2;
+    }
+    const size_t n = size_t(objects);
+    cout << n << " objects, " << frames << " frames, " << cores << " core(s)" << endl << endl;
+
+    // ---- the serial reference: the same phases in a plain loop ----
+    World reference(n);
+    const auto t0 = steady_clock::now();
+    for (long f = 0; f < frames; ++f) {
+        reference.read(0, n);
+        reference.compute(0, n);
+        reference.commit(0, n);
+        reference.swap();
+    }
+    const double serialMs = duration<double, milli>(steady_clock::now() - t0).count() / double(frames);
+    printf("  %-6s %10s %9s   %-28s %s\n", "lanes", "ms/frame", "speedup", "read / compute / commit", "barrier wait");
+    printf("  %-6s %10.2f %9s\n", "serial", serialMs, "-");
+
+    bool ok = true;
+    ThreadPool pool(unsigned(maxLanes - 1));
+    double oneLane = 0;
+    for (long lanes = 1; lanes <= maxLanes; lanes *= 2) {
+        World world(n);
+        PhasedFrameLoop loop(pool, unsigned(lanes));
+        loop.addPhase("read", [&](size_t b, size_t e) { world.read(b, e); });
+        loop.addPhase("compute", [&](size_t b, size_t e) { world.compute(b, e); });
+        loop.addPhase("commit", [&](size_t b, size_t e) { world.commit(b, e); });
+        loop.onFrameEnd([&] { world.swap(); });
+        const auto s0 = steady_clock::now();
+        loop.run(n, uint64_t(frames));
+        const double frameMs = duration<double, milli>(steady_clock::now() - s0).count() / double(frames);
+        if (lanes == 1) oneLane = frameMs;
+
+        const PhasedFrameLoop::Stats& st = loop.stats();
+        double phases = 0, wait = 0;
+        for (double m : st.phaseMs) phases += m;
+        for (double w : st.laneWaitMs) wait += w;
+        char split[64];
+        snprintf(split, sizeof split, "%.0f%% / %.0f%% / %.0f%%", 100 * st.phaseMs[0] / phases,
+                 100 * st.phaseMs[1] / phases, 100 * st.phaseMs[2] / phases);
+        printf("  %-6ld %10.2f %8.2fx   %-28s %.0f%% of lane time\n", lanes, frameMs, oneLane / frameMs, split,
+               100 * wait / (double(lanes) * frameMs * double(frames)));
+        ok = ok && st.frames == uint64_t(frames) && world.sameBits(reference);
+    }
+
+    // ---- a throwing phase: the run stops at the frame's end, run() rethrows ----
+    {
+        World world(n);
+        PhasedFrameLoop loop(pool, unsigned(maxLanes));
+        long bodies = 0;
+        loop.addPhase("throws on frame 3", [&](size_t b, size_t) {
+            if (b == 0 && ++bodies == 3) throw runtime_error("frame 3");
+        });
+        bool caught = false;
+        try {
+            loop.run(n, uint64_t(frames) + 3);
+        } catch (const runtime_error&) {
+            caught = true;
+        }
+        ok = ok && caught && loop.stats().frames == 3;
+    }
+
+    cout << endl << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. Split the frame into phases so that, within a phase, nobody
+//    writes what anybody else reads: then the bodies need no
+//    locks, only a barrier between phases.
+// 2. Double buffering gives that for free: read the front, write
+//    the back, swap once per frame — and the result no longer
+//    depends on which thread ran which object.
+// 3. std::barrier's completion runs on one thread while all wait:
+//    the natural place for the swap and other per-frame work.
+// 4. A lane blocked at a barrier holds its thread: never run more
+//    lanes than there are threads to run them (and cores, for it
+//    to be faster).
+//
+// ⭐ One-Line Interview Answer
+// “Run each frame as read / compute / commit phases separated by
+// barriers over a double-buffered state: every phase reads one
+// buffer and writes another, so objects update in parallel on a
+// pool without a single lock and with a deterministic result.”
@@ -0,0 +1,190 @@
+// ==========================================================
+// TOPIC: Allocation-Free Cloning from a Prototype Registry
+// ==========================================================
+//
+// poly.cpp:
+//
+//     virtual Fruit* clone() { return new Fruit(*this); }
+//     Apple* clone() override { return new Apple(*this); }
+//
+// ❌ one operator new per clone, one delete per death
+// ❌ a raw owning pointer from every call
+//
+// ✅ PrototypeRegistry.h: Clones<Derived, Base> supplies the
+//    size and the placement copy; clone_into(arena) puts the
+//    copy wherever the caller's arena says
+// ✅ clone_unique / spawnOwned: unique_ptr whose deleter gives
+//    the block back to the arena (pool) it came from
+//
+// Measured here: spawning Fruit and Apple clones, alternating,
+// in frames of 1024 that die together —
+//   1. poly.cpp's clone(): new + delete per object
+//   2. spawn() into a MonotonicArena, reset per frame
+//   3. spawnOwned() from a SlabPool (free-list pop / push)
+// plus operator new calls per clone, counted by replacing the
+// global operator new in this file.
+//
+// Build:
+//   g++ -std=c++20 -O2 prototypeClone.cpp -o prototypeclone
+//
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "../Benchmarks/MicroBench.h"
+#include "../Concepts/PoolAllocator.h"
+#include "MonotonicArena.h"
+#include "PrototypeRegistry.h"
+
+using namespace std;
+
+// ---- every operator new in the program, counted ----
+static uint64_t newCalls = 0;
+
+void* operator new(size_t n) {
+    ++newCalls;
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// ---- poly.cpp's Fruit / Apple, with a little state ----
+class HeapFruit {
+public:
+    float weight = 150.0f;
+    virtual HeapFruit* clone() { return new HeapFruit(*this); }
+    virtual ~HeapFruit() {}
+};
+
+class HeapApple : public HeapFruit {
+public:
+    int variety = 3;
+    HeapApple* clone() override { return new HeapApple(*this); }
+};
+
+// ---- the same classes on the prototype base ----
+class Fruit : public Clones<Fruit, Prototype<Fruit>> {
+public:
+    float weight = 150.0f;
+};
+
+class Apple : public Clones<Apple, Fruit> {
+public:
+    int variety = 3;
+};
+
+// SlabPool behind the arena interface
+struct SlabArena {
+    void* allocate(size_t bytes, size_t) { return SlabPool::allocate(bytes); }
+    void deallocate(void* p, size_t bytes, size_t) { SlabPool::deallocate(p, bytes); }
+};
+
+constexpr size_t kFrame = 1024;
+
+int main() {
+    PrototypeRegistry<Fruit> registry;
+    const PrototypeRegistry<Fruit>::Id ids[2] = {registry.emplace<Fruit>("fruit"), registry.emplace<Apple>("apple")};
+
+    // ---- correctness: dynamic type, copied state, release ----
+    MonotonicArena arena;
+    SlabArena pool;
+    bool ok = true;
+    {
+        Apple proto;
+        proto.variety = 7;
+        Fruit* viaArena = proto.clone_into(arena);
+        ArenaPtr<Fruit> viaPool = registry.spawnOwned(registry.find("apple"), pool);
+        ok = ok && dynamic_cast<Apple*>(viaArena) && static_cast<Apple*>(viaArena)->variety == 7;
+        ok = ok && dynamic_cast<Apple*>(viaPool.get()) && static_cast<Apple*>(viaPool.get())->variety == 3;
+        destroyClone(viaArena);
+        arena.reset();
+    }
+    try {
+        registry.emplace<Fruit>("fruit");
+        ok = false;
+    } catch (const invalid_argument&) {
+    }
+
+    // ---- throughput ----
+    HeapFruit heapFruit;
+    HeapApple heapApple;
+    HeapFruit* heap[2] = {&heapFruit, &heapApple};
+
+    vector<HeapFruit*> heapLive(kFrame);
+    vector<Fruit*> arenaLive(kFrame);
+    vector<ArenaPtr<Fruit>> poolLive(kFrame);
+
+    auto heapBody = [&](uint64_t n) {
+        for (uint64_t done = 0; done < n;) {
+            size_t m = min<uint64_t>(kFrame, n - done);
+            for (size_t i = 0; i < m; ++i) heapLive[i] = heap[i & 1]->clone();
+            doNotOptimize(heapLive.data());
+            for (size_t i = 0; i < m; ++i) delete heapLive[i];
+            done += m;
+        }
+    };
+    auto arenaBody = [&](uint64_t n) {
+        for (uint64_t done = 0; done < n;) {
+            size_t m = min<uint64_t>(kFrame, n - done);
+            MonotonicArena::Scope frame(arena);
+            for (size_t i = 0; i < m; ++i) arenaLive[i] = registry.spawn(ids[i & 1], arena);
+            doNotOptimize(arenaLive.data());
+            for (size_t i = 0; i < m; ++i) destroyClone(arenaLive[i]);
+            done += m;
+        }
+    };
+    auto poolBody = [&](uint64_t n) {
+        for (uint64_t done = 0; done < n;) {
+            size_t m = min<uint64_t>(kFrame, n - done);
+            for (size_t i = 0; i < m; ++i) poolLive[i] = registry.spawnOwned(ids[i & 1], pool);
+            doNotOptimize(poolLive.data());
+            for (size_t i = 0; i < m; ++i) poolLive[i].reset();
+            done += m;
+        }
+    };
+
+    MicroBench bench("clone + destroy, Fruit/Apple alternating, frames of 1024");
+    bench.add("poly.cpp clone(): new + delete", heapBody)
+        .add("spawn() into MonotonicArena", arenaBody)
+        .add("spawnOwned() from SlabPool", poolBody);
+    auto results = bench.run();
+
+    // ---- operator new calls per clone (after warm-up) ----
+    constexpr uint64_t kCount = 1 << 20;
+    auto callsPerClone = [&](auto& body) {
+        uint64_t before = newCalls;
+        body(kCount);
+        return double(newCalls - before) / kCount;
+    };
+    double heapCalls = callsPerClone(heapBody);
+    double arenaCalls = callsPerClone(arenaBody);
+    double poolCalls = callsPerClone(poolBody);
+    cout << "operator new calls per clone: heap " << heapCalls << ", arena " << arenaCalls << ", pool " << poolCalls
+         << endl;
+
+    ok = ok && heapCalls == 1 && arenaCalls == 0 && poolCalls == 0;
+    cout << "all checks: " << (ok ? "passed" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. Virtual clone() copies the most-derived type; it does not
+//    have to decide where the copy lives.
+// 2. Split it into size + alignment + placement copy, and the
+//    caller chooses the storage: arena, pool or heap.
+// 3. A CRTP helper (Clones<Derived, Base>) writes those
+//    overrides once, so no class can forget or mistype them.
+// 4. unique_ptr with an arena deleter keeps ownership explicit
+//    without going back to new/delete.
+//
+// ⭐ One-Line Interview Answer
+// “Make clone a placement copy into caller-supplied memory —
+// prototypes spawn from arenas or pools with zero malloc calls,
+// and a unique_ptr deleter returns the block.”
@@ -0,0 +1,246 @@
+// ==========================================================
+// TOPIC: Data-Oriented (SoA) Storage vs Arrays of Base Pointers
+// ==========================================================
+//
+// ArrayOfDifferentobj.cpp, dynamicArrayOfPointer.cpp and
+// staticArrayOfPointer.cpp all use this layout:
+//
+//     GameObject** objects = new GameObject*[n];
+//     objects[i] = new Player();        // one heap block each
+//     objects[i]->Update();             // one virtual call each
+//
+// That is flexible, but for MANY objects it is slow:
+// - every element is a pointer → a cache miss per object
+// - every call goes through the vtable → no inlining,
+//   no vectorization
+// - objects of different types are interleaved → the
+//   branch predictor keeps guessing the wrong function
+//
+// ----------------------------------------------------------
+// DATA-ORIENTED DESIGN (Structure of Arrays)
+// ----------------------------------------------------------
+//
+// - Store each TYPE in its own contiguous arrays
+// - Store each FIELD in its own array (x[], y[], vx[] ...)
+// - update/draw = a tight loop per array, no pointers,
+//   no virtual calls → the compiler can vectorize it
+//
+//   AoS + pointers:  [ptr][ptr][ptr] → {x y vx vy hp} ...
+//   SoA:             x : [x0 x1 x2 x3 ...]
+//                    y : [y0 y1 y2 y3 ...]
+//                    hp: [h0 h1 h2 h3 ...]
+//
+// This file runs the SAME simulation on 1M entities in both
+// layouts and reports time and, per frame, the PerfCounters.h
+// events (cache and branch misses, IPC when the kernel exposes a
+// hardware PMU).
+//
+// Build:
+//   g++ -std=c++20 -O2 soaGameObjects.cpp -o soa
+//
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../Benchmarks/PerfCounters.h"
+
+using namespace std;
+using namespace std::chrono;
+
+const float dt = 0.016f;
+
+// ==========================================================
+// 1. CLASSIC LAYOUT: base class + virtual functions
+// ==========================================================
+class GameObject {
+public:
+    float x, y, vx, vy;
+    GameObject(float px, float py, float pvx, float pvy) : x(px), y(py), vx(pvx), vy(pvy) {}
+    virtual ~GameObject() {}
+    virtual void Update() { x += vx * dt; y += vy * dt; }
+    virtual uint32_t Draw() const { return (uint32_t)x ^ (uint32_t)y; }
+};
+
+class Player : public GameObject {
+public:
+    float health = 50.0f;
+    Player(float px, float py, float pvx, float pvy) : GameObject(px, py, pvx, pvy) {}
+    void Update() override {
+        GameObject::Update();
+        health = min(health + 1.0f * dt, 100.0f);      // regenerate
+    }
+    uint32_t Draw() const override { return GameObject::Draw() + (uint32_t)health; }
+};
+
+class NPC : public GameObject {
+public:
+    float patrolTimer = 0.0f;
+    NPC(float px, float py, float pvx, float pvy) : GameObject(px, py, pvx, pvy) {}
+    void Update() override {
+        patrolTimer += dt;
+        if (patrolTimer > 1.0f) {                        // turn around
+            vx = -vx;
+            vy = -vy;
+            patrolTimer = 0.0f;
+        }
+        GameObject::Update();
+    }
+    uint32_t Draw() const override { return GameObject::Draw() * 3u; }
+};
+
+// ==========================================================
+// 2. DATA-ORIENTED LAYOUT: one SoA store per type
+// ==========================================================
+struct TransformArrays {
+    vector<float> x, y, vx, vy;
+
+    size_t size() const { return x.size(); }
+    void push(float px, float py, float pvx, float pvy) {
+        x.push_back(px); y.push_back(py); vx.push_back(pvx); vy.push_back(pvy);
+    }
+    void integrate() {
+        const size_t n = size();
+        float* __restrict px = x.data();
+        float* __restrict py = y.data();
+        const float* __restrict pvx = vx.data();
+        const float* __restrict pvy = vy.data();
+        for (size_t i = 0; i < n; ++i) {
+            px[i] += pvx[i] * dt;
+            py[i] += pvy[i] * dt;
+        }
+    }
+    uint32_t drawChecksum(size_t i) const { return (uint32_t)x[i] ^ (uint32_t)y[i]; }
+};
+
+class GameWorld {
+public:
+    TransformArrays objects;             // plain GameObjects
+    TransformArrays players;
+    vector<float> playerHealth;
+    TransformArrays npcs;
+    vector<float> npcPatrolTimer;
+
+    void addObject(float x, float y, float vx, float vy) { objects.push(x, y, vx, vy); }
+    void addPlayer(float x, float y, float vx, float vy) {
+        players.push(x, y, vx, vy);
+        playerHealth.push_back(50.0f);
+    }
+    void addNPC(float x, float y, float vx, float vy) {
+        npcs.push(x, y, vx, vy);
+        npcPatrolTimer.push_back(0.0f);
+    }
+
+    size_t size() const { return objects.size() + players.size() + npcs.size(); }
+
+    // Each type: ONE tight loop, no virtual call per element
+    // (still one thread; split over cores in phases: phasedFrames.cpp)
+    void Update() {
+        objects.integrate();
+
+        players.integrate();
+        for (float& h : playerHealth) h = min(h + 1.0f * dt, 100.0f);
+
+        // NPC "turn around" must run BEFORE integration (same
+        // order as NPC::Update) and is written branch-free
+        for (size_t i = 0; i < npcs.size(); ++i) {
+            float t = npcPatrolTimer[i] + dt;
+            bool flip = t > 1.0f;
+            float sign = flip ? -1.0f : 1.0f;
+            npcs.vx[i] *= sign;
+            npcs.vy[i] *= sign;
+            npcPatrolTimer[i] = flip ? 0.0f : t;
+        }
+        npcs.integrate();
+    }
+
+    uint32_t Draw() const {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < objects.size(); ++i) sum += objects.drawChecksum(i);
+        for (size_t i = 0; i < players.size(); ++i)
+            sum += players.drawChecksum(i) + (uint32_t)playerHealth[i];
+        for (size_t i = 0; i < npcs.size(); ++i) sum += npcs.drawChecksum(i) * 3u;
+        return sum;
+    }
+};
+
+// ==========================================================
+// Timing + event counts per frame (../Benchmarks/PerfCounters.h)
+// ==========================================================
+template <typename F>
+void measure(const char* name, int frames, PerfTotals& totals, F frame) {
+    auto t0 = steady_clock::now();
+    uint32_t checksum = 0;
+    for (int f = 0; f < frames; ++f) {
+        PerfRegion region(totals, name);                 // one call per frame
+        checksum += frame();
+    }
+    double ms = duration<double, milli>(steady_clock::now() - t0).count();
+    cout << name << ": " << ms / frames << " ms/frame  [checksum " << checksum << "]" << endl;
+}
+
+int main() {
+    const int entities = 1000000;
+    const int frames = 20;
+
+    // Same random entities for both layouts
+    mt19937 rng(42);
+    uniform_real_distribution<float> pos(0.0f, 1000.0f), vel(-5.0f, 5.0f);
+
+    // ---- Layout 1: array of base-class pointers ----
+    // Shuffled, like a list that grew over time with mixed types
+    vector<GameObject*> objects;
+    objects.reserve(entities);
+    GameWorld world;
+
+    for (int i = 0; i < entities; ++i) {
+        float x = pos(rng), y = pos(rng), vx = vel(rng), vy = vel(rng);
+        switch (i % 3) {
+            case 0: objects.push_back(new GameObject(x, y, vx, vy)); world.addObject(x, y, vx, vy); break;
+            case 1: objects.push_back(new Player(x, y, vx, vy));     world.addPlayer(x, y, vx, vy); break;
+            default: objects.push_back(new NPC(x, y, vx, vy));       world.addNPC(x, y, vx, vy); break;
+        }
+    }
+    shuffle(objects.begin(), objects.end(), rng);
+
+    PerfTotals pmu;
+    cout << world.size() << " entities, " << frames << " frames" << endl;
+
+    measure("pointers + virtual", frames, pmu, [&]() {
+        uint32_t sum = 0;
+        for (GameObject* o : objects) o->Update();
+        for (GameObject* o : objects) sum += o->Draw();
+        return sum;
+    });
+
+    measure("SoA per-type loops", frames, pmu, [&]() {
+        world.Update();
+        return world.Draw();
+    });
+
+    // Per frame: cache-misses and branch-misses are the two costs
+    // above ("-" where the machine exposes no hardware PMU)
+    cout << endl;
+    pmu.print(cout);
+
+    for (GameObject* o : objects) delete o;
+    return 0;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. Virtual dispatch is not "slow" per call — the cost is
+//    the pointer chase + lost inlining + lost vectorization.
+// 2. Arrays of POINTERS scatter objects in memory;
+//    arrays of VALUES (per field) stream through the cache.
+// 3. Group objects by TYPE so each loop runs ONE function.
+// 4. Keep polymorphism at the boundary (per array),
+//    not per element.
+//
+// ⭐ One-Line Interview Answer
+// “Data-oriented design stores each type's fields in
+// contiguous arrays, so update loops stream through memory
+// without pointer chasing or a virtual call per object.”
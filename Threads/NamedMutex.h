@@ -0,0 +1,276 @@
+// ======================================================
+// NamedMutex.h — cross-process lock in shared memory, kernel only under contention
+// ======================================================
+//
+// mutex.cpp:
+//
+//     hMutex = CreateMutex(NULL, FALSE, "MUTEX1");
+//     WaitForSingleObject(hMutex, INFINITE);   // kernel call, EVERY time
+//     ...
+//     ReleaseMutex(hMutex);                    // kernel call, EVERY time
+//
+// NamedMutex("MUTEX1") maps a 4-byte lock word into shared memory
+// (shm_open / CreateFileMapping) that every process opening the
+// same name sees:
+//
+//   - lock():   one CAS 0 → my thread id        (no system call)
+//   - busy:     spin briefly (multi-core only), then sleep in the
+//               kernel — futex on the shared word (Linux) or a
+//               named semaphore (Win32; WaitOnAddress does not
+//               work across processes)
+//   - unlock(): exchange → 0; wake one sleeper only if the
+//               WAITERS bit was set
+//
+// WORD: owner thread id in the low 30 bits (the kernel's futex
+// owner format), bit 31 = someone may be sleeping. All-zero
+// memory is a valid unlocked lock, so a freshly created segment
+// needs no initialisation and there is no creator/opener race.
+//
+// OWNER DEATH: sleepers wake every 50 ms and check whether the
+// owning thread still exists. If it died holding the lock, the
+// first one to notice takes it over and lock() returns
+// LockStatus::OwnerDied — the protected data may be half
+// updated, so check/repair it before relying on it (the same
+// contract as pthread's EOWNERDEAD / WAIT_ABANDONED).
+// Detection compares thread ids; an id reused within the 50 ms
+// window goes unnoticed until that thread exits too.
+//
+// Usage:
+//     NamedMutex m("MUTEX1");                  // create or open
+//     { std::lock_guard<NamedMutex> g(m); ... }
+//     NamedMutex::remove("MUTEX1");            // when nobody needs it
+//
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#ifdef _WIN32
+#include <climits>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NAMED_MUTEX_PAUSE() _mm_pause()
+#elif defined(__aarch64__)
+#define NAMED_MUTEX_PAUSE() asm volatile("yield")
+#else
+#define NAMED_MUTEX_PAUSE() ((void)0)
+#endif
+
+enum class LockStatus { Acquired, OwnerDied };
+
+namespace named_mutex_detail {
+
+constexpr std::uint32_t kWaiters = 0x80000000u;   // == FUTEX_WAITERS
+constexpr std::uint32_t kIdMask = 0x3fffffffu;    // == FUTEX_TID_MASK
+
+// One cache line: nothing else in the segment shares it
+struct alignas(64) Shared {
+    std::atomic<std::uint32_t> word;
+};
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "lock word must be lock-free to be shared");
+
+#ifdef _WIN32
+inline std::uint32_t selfId() {
+    thread_local const std::uint32_t id = static_cast<std::uint32_t>(GetCurrentThreadId()) & kIdMask;
+    return id;
+}
+#else
+inline std::uint32_t& cachedSelfId() {
+    thread_local std::uint32_t id = 0;
+    return id;
+}
+
+// gettid() is a system call: cache it per thread. A forked child
+// inherits the cache of the forking thread, so clear it there.
+inline std::uint32_t selfId() {
+    std::uint32_t& id = cachedSelfId();
+    if (id == 0) [[unlikely]] {
+        static const int atfork = pthread_atfork(nullptr, nullptr, [] { cachedSelfId() = 0; });
+        (void)atfork;
+        id = static_cast<std::uint32_t>(syscall(SYS_gettid)) & kIdMask;
+    }
+    return id;
+}
+#endif
+
+inline bool threadAlive(std::uint32_t id) {
+#ifdef _WIN32
+    HANDLE h = OpenThread(SYNCHRONIZE, FALSE, id);
+    if (!h) return GetLastError() != ERROR_INVALID_PARAMETER;   // no such thread
+    bool alive = WaitForSingleObject(h, 0) == WAIT_TIMEOUT;
+    CloseHandle(h);
+    return alive;
+#else
+    // A thread id is also a valid kill() target; signal 0 only checks
+    return kill(static_cast<pid_t>(id), 0) == 0 || errno != ESRCH;
+#endif
+}
+
+}  // namespace named_mutex_detail
+
+class NamedMutex {
+public:
+    // Creates the segment or opens the existing one; throws
+    // std::system_error if the OS refuses
+    explicit NamedMutex(const std::string& name) { open(name); }
+    NamedMutex(const NamedMutex&) = delete;
+    NamedMutex& operator=(const NamedMutex&) = delete;
+    ~NamedMutex() { close(); }
+
+    bool try_lock() {
+        std::uint32_t expected = 0;
+        return word().compare_exchange_strong(expected, named_mutex_detail::selfId(), std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    LockStatus lock() {
+        if (try_lock()) return LockStatus::Acquired;
+        return lockSlow();
+    }
+
+    void unlock() {
+        if (word().exchange(0, std::memory_order_release) & named_mutex_detail::kWaiters) wakeOne();
+    }
+
+    // Deletes the name; processes that have it open keep working
+    static void remove(const std::string& name) {
+#ifdef _WIN32
+        (void)name;                 // Win32 objects vanish with their last handle
+#else
+        shm_unlink(posixName(name).c_str());
+#endif
+    }
+
+private:
+    using Shared = named_mutex_detail::Shared;
+    static constexpr int kSpins = 100;
+    static constexpr long kRecheckMs = 50;
+
+    std::atomic<std::uint32_t>& word() { return shared_->word; }
+
+    LockStatus lockSlow() {
+        using namespace named_mutex_detail;
+        const std::uint32_t self = selfId();
+
+        // Short holds are common: a few reads before sleeping
+        static const bool multiCore = std::thread::hardware_concurrency() > 1;
+        if (multiCore) {
+            for (int i = 0; i < kSpins; ++i) {
+                NAMED_MUTEX_PAUSE();
+                if (word().load(std::memory_order_relaxed) == 0 && try_lock()) return LockStatus::Acquired;
+            }
+        }
+
+        for (;;) {
+            std::uint32_t v = word().load(std::memory_order_relaxed);
+            if ((v & kIdMask) == 0) {
+                // Free. Take it WITH the waiters bit: other sleepers may
+                // exist and unlock() must still wake them
+                if (word().compare_exchange_weak(v, self | kWaiters, std::memory_order_acquire,
+                                                 std::memory_order_relaxed))
+                    return LockStatus::Acquired;
+                continue;
+            }
+            if (!(v & kWaiters) &&
+                !word().compare_exchange_weak(v, v | kWaiters, std::memory_order_relaxed))
+                continue;
+            if (!sleepWhile(v | kWaiters) && !threadAlive(v & kIdMask)) {
+                // Timed out and the owner is gone: take the lock over
+                std::uint32_t held = v | kWaiters;
+                if (word().compare_exchange_strong(held, self | kWaiters, std::memory_order_acquire,
+                                                   std::memory_order_relaxed))
+                    return LockStatus::OwnerDied;
+            }
+        }
+    }
+
+#ifdef _WIN32
+    void open(const std::string& name) {
+        std::string base = "Local\\" + name;
+        mapping_ = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(Shared),
+                                      base.c_str());
+        if (!mapping_) throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), name);
+        shared_ = static_cast<Shared*>(MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(Shared)));
+        sleepers_ = CreateSemaphoreA(nullptr, 0, LONG_MAX, (base + ".wait").c_str());
+        if (!shared_ || !sleepers_) {
+            DWORD err = GetLastError();
+            close();
+            throw std::system_error(static_cast<int>(err), std::system_category(), name);
+        }
+    }
+
+    void close() {
+        if (shared_) UnmapViewOfFile(shared_);
+        if (mapping_) CloseHandle(mapping_);
+        if (sleepers_) CloseHandle(sleepers_);
+        shared_ = nullptr;
+        mapping_ = sleepers_ = nullptr;
+    }
+
+    // false = timed out. A stale permit only causes one extra loop
+    bool sleepWhile(std::uint32_t expected) {
+        if (word().load(std::memory_order_relaxed) != expected) return true;
+        return WaitForSingleObject(sleepers_, kRecheckMs) == WAIT_OBJECT_0;
+    }
+
+    void wakeOne() { ReleaseSemaphore(sleepers_, 1, nullptr); }
+
+    HANDLE mapping_ = nullptr;
+    HANDLE sleepers_ = nullptr;
+#else
+    static std::string posixName(const std::string& name) { return name[0] == '/' ? name : "/" + name; }
+
+    void open(const std::string& name) {
+        int fd = shm_open(posixName(name).c_str(), O_CREAT | O_RDWR, 0600);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), name);
+        // Same size from every process: growing to it zero-fills, i.e. "unlocked"
+        if (ftruncate(fd, sizeof(Shared)) != 0) {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), name);
+        }
+        void* p = mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int err = errno;
+        ::close(fd);                 // the mapping keeps the segment alive
+        if (p == MAP_FAILED) throw std::system_error(err, std::generic_category(), name);
+        shared_ = static_cast<Shared*>(p);
+    }
+
+    void close() {
+        if (shared_) munmap(shared_, sizeof(Shared));
+        shared_ = nullptr;
+    }
+
+    // Shared (non-PRIVATE) futex: the key is the physical page, so
+    // every process mapping the segment waits on the same queue
+    bool sleepWhile(std::uint32_t expected) {
+        timespec ts{0, kRecheckMs * 1000000L};
+        long r = syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word()), FUTEX_WAIT, expected, &ts,
+                         nullptr, 0);
+        return r == 0 || errno != ETIMEDOUT;
+    }
+
+    void wakeOne() {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word()), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+    }
+#endif
+
+    Shared* shared_ = nullptr;
+};
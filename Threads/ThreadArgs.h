@@ -0,0 +1,138 @@
+// ======================================================
+// ThreadArgs.h — typed thread arguments: moved in, never copied, owned by the thread
+// ======================================================
+//
+// passingArgument.cpp:
+//
+//     GameObject* obj = new GameObject();
+//     CreateThread(NULL, 0, BasicThread, (LPVOID)obj, 0, &threadId);
+//     // BasicThread casts param back to GameObject*; nobody deletes it
+//
+// createThread.cpp passes functors and arguments by value, so
+// std::thread copies every lvalue it is given.
+//
+// spawn(f, args...) is std::thread with the ownership rules
+// checked at compile time:
+//   - arguments are MOVED in (rvalues) or explicitly BORROWED
+//     (std::ref / std::cref); a plain lvalue does not compile,
+//     so a large object is never copied by accident
+//   - a T* (non-const) does not compile: it says nothing about
+//     who frees it. Hand over a std::unique_ptr<T> instead
+//   - lvalue scalars (int, enum, double) are fine, copying them
+//     owns nothing
+//   - f is invoked with rvalues, so `void run(GameObject&& g)`
+//     works on the object in place inside std::thread's state —
+//     one heap block (std::thread's own), one move per argument
+//
+// ThreadBlock<T> goes one step further for big payloads: the
+// caller provides the storage (stack, array, arena), T is
+// CONSTRUCTED in it from constructor arguments — no move, no
+// copy, no heap block for T — and the thread receives it as T&&:
+//
+//     ThreadBlock<Frame> block;                  // preallocated
+//     block.start(process, frameId, sensor);     // Frame(frameId, sensor) built in place
+//     block.join();                              // T destroyed by the thread; block reusable
+//
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <new>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace thread_args_detail {
+
+template <typename T>
+struct IsRefWrapper : std::false_type {};
+template <typename T>
+struct IsRefWrapper<std::reference_wrapper<T>> : std::true_type {};
+
+// Raw pointer to a mutable object: ownership unknown
+template <typename D>
+constexpr bool isOwningPointer =
+    std::is_pointer_v<D> && !std::is_const_v<std::remove_pointer_t<D>> &&
+    !std::is_function_v<std::remove_pointer_t<D>>;
+
+// A (forwarded) argument may be handed to a thread
+template <typename A, typename D = std::decay_t<A>>
+constexpr bool transfersOwnership =
+    !std::is_lvalue_reference_v<A> || IsRefWrapper<D>::value || std::is_arithmetic_v<D> ||
+    std::is_enum_v<D> || std::is_pointer_v<D>;   // const pointers: a documented borrow
+
+// The callable: moved in, or a plain function / member pointer
+template <typename F, typename D = std::decay_t<F>>
+constexpr bool transfersCallable =
+    !std::is_lvalue_reference_v<F> || IsRefWrapper<D>::value || std::is_pointer_v<D> ||
+    std::is_member_function_pointer_v<D>;
+
+template <typename F>
+constexpr void checkCallable() {
+    static_assert(transfersCallable<F>, "spawn: std::move the callable, or pass std::ref(callable) to borrow it");
+}
+
+template <typename F, typename... Args>
+constexpr void checkOwnership() {
+    checkCallable<F>();
+    static_assert((transfersOwnership<Args> && ...),
+                  "spawn: an lvalue argument would be copied — std::move it in, or std::ref/std::cref to borrow");
+    static_assert((!isOwningPointer<std::decay_t<Args>> && ...),
+                  "spawn: a raw T* has no owner — pass std::unique_ptr<T> (or std::ref(*p) to borrow)");
+}
+
+}  // namespace thread_args_detail
+
+// std::thread(f, args...) with moves only; f receives rvalues
+template <typename Thread = std::thread, typename F, typename... Args>
+Thread spawn(F&& f, Args&&... args) {
+    thread_args_detail::checkOwnership<F, Args...>();
+    static_assert(std::is_invocable_v<std::decay_t<F>, std::decay_t<Args>...> ||
+                      std::is_invocable_v<std::decay_t<F>, std::stop_token, std::decay_t<Args>...>,
+                  "spawn: f cannot be called with the (moved) arguments");
+    return Thread(std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+// Caller-placed storage for one T plus the thread that consumes it.
+// Not movable: the running thread refers to the block.
+template <typename T>
+class ThreadBlock {
+public:
+    ThreadBlock() = default;
+    ThreadBlock(const ThreadBlock&) = delete;
+    ThreadBlock& operator=(const ThreadBlock&) = delete;
+    ~ThreadBlock() { join(); }
+
+    // Builds T(ctorArgs...) in the block, then runs f(T&&) on a new
+    // thread; T is destroyed on that thread after f returns.
+    // A previous run is joined first.
+    template <typename F, typename... CtorArgs>
+    void start(F&& f, CtorArgs&&... ctorArgs) {
+        thread_args_detail::checkCallable<F>();   // ctorArgs are used up before start() returns
+        static_assert(std::is_invocable_v<std::decay_t<F>&, T&&>, "ThreadBlock: f must accept T&& (or T)");
+        join();
+        T* obj = ::new (static_cast<void*>(storage_)) T(std::forward<CtorArgs>(ctorArgs)...);
+        try {
+            thread_ = std::thread([obj, fn = std::forward<F>(f)]() mutable {
+                struct Destroy {
+                    T* p;
+                    ~Destroy() { p->~T(); }
+                } d{obj};
+                std::invoke(fn, std::move(*obj));
+            });
+        } catch (...) {
+            obj->~T();
+            throw;
+        }
+    }
+
+    bool joinable() const { return thread_.joinable(); }
+    void join() {
+        if (thread_.joinable()) thread_.join();
+    }
+
+private:
+    alignas(T) unsigned char storage_[sizeof(T)];
+    std::thread thread_;
+};
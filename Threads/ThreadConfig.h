@@ -0,0 +1,352 @@
+// ======================================================
+// ThreadConfig.h — portable priority / affinity / NUMA / stack / name for std::thread
+// ======================================================
+//
+// priority.cpp:
+//
+//     hThread = CreateThread(NULL, 0, MyThreadFunction, NULL, 0, &threadId);
+//     SetThreadPriority(hThread, THREAD_PRIORITY_HIGHEST);   // Win32 only
+//
+// ThreadConfig describes the same settings once and maps them to
+// Win32 or pthread/Linux underneath:
+//
+//     ThreadConfig cfg;
+//     cfg.priority = ThreadPriority::Realtime;   // SCHED_FIFO / TIME_CRITICAL
+//     cfg.cores    = {3};                         // pin to core 3
+//     cfg.name     = "audio";
+//     auto t = launchThread<std::jthread>(cfg, MyThreadFunction);
+//
+// MAPPING:
+//   priority   Linux: Idle → SCHED_IDLE, Lowest..Highest → SCHED_OTHER
+//              with a per-thread nice value (10, 5, 0, -5, -10),
+//              Realtime → SCHED_FIFO at `realtimePriority`
+//              Win32: THREAD_PRIORITY_IDLE .. THREAD_PRIORITY_TIME_CRITICAL
+//   cores      pthread_setaffinity_np / SetThreadAffinityMask
+//              (Win32: the first 64 logical processors only)
+//   numaNode   the node's CPUs (/sys/devices/system/node/nodeN/cpulist,
+//              GetNumaNodeProcessorMask) intersected with `cores`,
+//              plus MPOL_PREFERRED memory on Linux
+//   stackSize  only at creation: launchThread() sets glibc's default
+//              thread attribute around the std::thread constructor
+//   name       pthread_setname_np (15 chars) / SetThreadDescription
+//
+// Configuration is best effort: SCHED_FIFO or a negative nice
+// without CAP_SYS_NICE fails with EPERM. Nothing throws; every
+// call returns a ThreadConfigStatus saying what did not apply, and
+// the thread runs anyway with the settings it could get.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum class ThreadPriority { Idle, Lowest, BelowNormal, Normal, AboveNormal, Highest, Realtime };
+
+struct ThreadConfig {
+    ThreadPriority priority = ThreadPriority::Normal;
+    int realtimePriority = 50;      // SCHED_FIFO level 1..99 (Realtime only)
+    std::vector<int> cores;         // empty → may run anywhere
+    int numaNode = -1;              // -1 → no NUMA placement
+    std::size_t stackSize = 0;      // 0 → platform default (launchThread only)
+    std::string name;               // empty → unchanged
+};
+
+// Which settings did NOT apply, and the first OS error seen
+struct ThreadConfigStatus {
+    enum Setting : unsigned { Priority = 1, Affinity = 2, Numa = 4, StackSize = 8, Name = 16 };
+
+    unsigned failed = 0;
+    int error = 0;                  // errno / GetLastError() of the first failure
+
+    bool ok() const { return failed == 0; }
+    bool applied(Setting s) const { return !(failed & s); }
+
+    void fail(Setting s, int err) {
+        if (!failed) error = err;
+        failed |= s;
+    }
+};
+
+namespace thread_config_detail {
+
+// "0-3,8,10-11" → {0,1,2,3,8,10,11}
+inline std::vector<int> parseCpuList(const char* text) {
+    std::vector<int> cpus;
+    while (*text) {
+        char* end;
+        long a = std::strtol(text, &end, 10);
+        if (end == text) break;
+        long b = a;
+        if (*end == '-') b = std::strtol(end + 1, &end, 10);
+        for (long c = a; c <= b; ++c) cpus.push_back(static_cast<int>(c));
+        text = (*end == ',') ? end + 1 : end;
+    }
+    return cpus;
+}
+
+// `cores` restricted to the node (all of the node's CPUs if `cores` is empty)
+inline std::vector<int> restrictToNode(const std::vector<int>& cores, const std::vector<int>& node) {
+    if (cores.empty()) return node;
+    std::vector<int> both;
+    for (int c : cores)
+        for (int n : node)
+            if (c == n) both.push_back(c);
+    return both;
+}
+
+#ifdef _WIN32
+
+inline int winPriority(ThreadPriority p) {
+    switch (p) {
+        case ThreadPriority::Idle: return THREAD_PRIORITY_IDLE;
+        case ThreadPriority::Lowest: return THREAD_PRIORITY_LOWEST;
+        case ThreadPriority::BelowNormal: return THREAD_PRIORITY_BELOW_NORMAL;
+        case ThreadPriority::Normal: return THREAD_PRIORITY_NORMAL;
+        case ThreadPriority::AboveNormal: return THREAD_PRIORITY_ABOVE_NORMAL;
+        case ThreadPriority::Highest: return THREAD_PRIORITY_HIGHEST;
+        case ThreadPriority::Realtime: return THREAD_PRIORITY_TIME_CRITICAL;
+    }
+    return THREAD_PRIORITY_NORMAL;
+}
+
+inline std::vector<int> nodeCpus(int node) {
+    ULONGLONG mask = 0;
+    std::vector<int> cpus;
+    if (!GetNumaNodeProcessorMask(static_cast<UCHAR>(node), &mask)) return cpus;
+    for (int c = 0; c < 64; ++c)
+        if (mask & (1ULL << c)) cpus.push_back(c);
+    return cpus;
+}
+
+inline ThreadConfigStatus apply(HANDLE h, const ThreadConfig& cfg) {
+    ThreadConfigStatus st;
+    if (!SetThreadPriority(h, winPriority(cfg.priority)))
+        st.fail(ThreadConfigStatus::Priority, static_cast<int>(GetLastError()));
+
+    std::vector<int> cores = cfg.cores;
+    if (cfg.numaNode >= 0) {
+        std::vector<int> node = nodeCpus(cfg.numaNode);
+        if (node.empty()) st.fail(ThreadConfigStatus::Numa, static_cast<int>(GetLastError()));
+        else cores = restrictToNode(cores, node);
+    }
+    if (!cores.empty()) {
+        DWORD_PTR mask = 0;
+        for (int c : cores)
+            if (c >= 0 && c < static_cast<int>(sizeof(DWORD_PTR) * 8)) mask |= DWORD_PTR(1) << c;
+        if (!mask || !SetThreadAffinityMask(h, mask))
+            st.fail(ThreadConfigStatus::Affinity, static_cast<int>(GetLastError()));
+    }
+
+    if (!cfg.name.empty()) {
+        std::wstring wide(cfg.name.begin(), cfg.name.end());
+        if (FAILED(SetThreadDescription(h, wide.c_str()))) st.fail(ThreadConfigStatus::Name, 0);
+    }
+    return st;
+}
+
+#else  // pthread / Linux
+
+// Per-thread nice applies to a kernel thread id, so only the
+// thread itself (or someone who knows its tid) can set it
+inline int niceFor(ThreadPriority p) {
+    switch (p) {
+        case ThreadPriority::Lowest: return 10;
+        case ThreadPriority::BelowNormal: return 5;
+        case ThreadPriority::AboveNormal: return -5;
+        case ThreadPriority::Highest: return -10;
+        default: return 0;
+    }
+}
+
+inline std::vector<int> nodeCpus(int node) {
+    char path[64];
+    std::snprintf(path, sizeof path, "/sys/devices/system/node/node%d/cpulist", node);
+    std::vector<int> cpus;
+    if (std::FILE* f = std::fopen(path, "r")) {
+        char text[512] = {};
+        if (std::fgets(text, sizeof text, f)) cpus = parseCpuList(text);
+        std::fclose(f);
+    }
+    return cpus;
+}
+
+// set_mempolicy(MPOL_PREFERRED) without linking libnuma
+inline int preferNodeMemory(int node) {
+#ifdef SYS_set_mempolicy
+    constexpr int kMpolPreferred = 1;
+    unsigned long mask[16] = {};
+    if (node < 0 || node >= static_cast<int>(sizeof(mask) * 8)) return EINVAL;
+    mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+    if (syscall(SYS_set_mempolicy, kMpolPreferred, mask, sizeof(mask) * 8) != 0) return errno;
+    return 0;
+#else
+    (void)node;
+    return ENOSYS;
+#endif
+}
+
+// `self`: the calling thread is `h`, so its tid is known and the
+// nice value (per-thread on Linux) can be applied too
+inline ThreadConfigStatus apply(pthread_t h, const ThreadConfig& cfg, bool self) {
+    ThreadConfigStatus st;
+
+    sched_param sp{};
+    int policy = SCHED_OTHER;
+    if (cfg.priority == ThreadPriority::Idle) {
+#ifdef SCHED_IDLE
+        policy = SCHED_IDLE;
+#endif
+    } else if (cfg.priority == ThreadPriority::Realtime) {
+        policy = SCHED_FIFO;
+        sp.sched_priority = cfg.realtimePriority;
+    }
+    if (int err = pthread_setschedparam(h, policy, &sp)) st.fail(ThreadConfigStatus::Priority, err);
+    else if (policy == SCHED_OTHER) {
+        int nice = niceFor(cfg.priority);
+        if (self) {
+            if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice) != 0)
+                st.fail(ThreadConfigStatus::Priority, errno);
+        } else if (nice != 0) {
+            st.fail(ThreadConfigStatus::Priority, ENOTSUP);   // tid unknown: use launchThread()
+        }
+    }
+
+    std::vector<int> cores = cfg.cores;
+    if (cfg.numaNode >= 0) {
+        std::vector<int> node = nodeCpus(cfg.numaNode);
+        if (node.empty()) st.fail(ThreadConfigStatus::Numa, ENOENT);
+        else {
+            cores = restrictToNode(cores, node);
+            if (self) {
+                if (int err = preferNodeMemory(cfg.numaNode)) st.fail(ThreadConfigStatus::Numa, err);
+            }
+        }
+    }
+    if (!cores.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int c : cores)
+            if (c >= 0 && c < CPU_SETSIZE) CPU_SET(c, &set);
+        if (int err = pthread_setaffinity_np(h, sizeof set, &set)) st.fail(ThreadConfigStatus::Affinity, err);
+    }
+
+    if (!cfg.name.empty()) {
+        std::string name = cfg.name.substr(0, 15);     // kernel limit: 16 bytes with NUL
+        if (int err = pthread_setname_np(h, name.c_str())) st.fail(ThreadConfigStatus::Name, err);
+    }
+    return st;
+}
+
+#endif
+
+}  // namespace thread_config_detail
+
+// Everything except stackSize, applied to the calling thread
+inline ThreadConfigStatus applyToCurrentThread(const ThreadConfig& cfg) {
+#ifdef _WIN32
+    return thread_config_detail::apply(GetCurrentThread(), cfg);
+#else
+    return thread_config_detail::apply(pthread_self(), cfg, true);
+#endif
+}
+
+// An already running std::thread / std::jthread. Via its handle only:
+// on Linux nice levels (Lowest..Highest) and the NUMA memory policy
+// need the thread itself, so prefer launchThread() for those.
+template <typename Thread>
+ThreadConfigStatus applyToThread(Thread& t, const ThreadConfig& cfg) {
+    ThreadConfigStatus st;
+#ifdef _WIN32
+    st = thread_config_detail::apply(static_cast<HANDLE>(t.native_handle()), cfg);
+#else
+    st = thread_config_detail::apply(t.native_handle(), cfg, t.get_id() == std::this_thread::get_id());
+#endif
+    if (cfg.stackSize) st.fail(ThreadConfigStatus::StackSize, 0);   // too late once running
+    return st;
+}
+
+// Starts a std::thread (or std::jthread) that applies `cfg` to itself
+// before running f(args...). If `status` is given, it is filled in
+// before f starts (the creating thread may read it after join, or
+// synchronise on it some other way).
+template <typename Thread = std::thread, typename F, typename... Args>
+Thread launchThread(const ThreadConfig& cfg, ThreadConfigStatus* status, F&& f, Args&&... args) {
+    // `token...` is empty, or the std::stop_token a std::jthread passes
+    // when f accepts one
+    auto body = [cfg, status, fn = std::forward<F>(f), tup = std::make_tuple(std::forward<Args>(args)...)](
+                    auto... token) mutable
+        requires std::is_invocable_v<std::decay_t<F>&, decltype(token)..., std::decay_t<Args>...>
+    {
+        ThreadConfigStatus st = applyToCurrentThread(cfg);
+        if (status) {
+            st.failed |= status->failed;                // StackSize result from the creator
+            if (!status->error) status->error = st.error;
+            status->failed = st.failed;
+        }
+        std::apply([&](auto&... a) { std::invoke(fn, token..., std::move(a)...); }, tup);
+    };
+
+    ThreadConfigStatus stackStatus;
+    if (cfg.stackSize == 0) {
+        if (status) *status = stackStatus;
+        return Thread(std::move(body));
+    }
+
+#if defined(__GLIBC__)
+    // std::thread has no attribute parameter: swap glibc's default
+    // attribute for the constructor (serialised among launchThread
+    // calls; other threads created meanwhile get the same stack size)
+    static std::mutex attrLock;
+    std::lock_guard<std::mutex> g(attrLock);
+    // The process default comes back however the constructor exits
+    // (it throws std::system_error when no thread can be created)
+    struct RestoreDefault {
+        pthread_attr_t old, mine;
+        RestoreDefault() {
+            pthread_getattr_default_np(&old);
+            pthread_attr_init(&mine);
+        }
+        ~RestoreDefault() {
+            pthread_setattr_default_np(&old);
+            pthread_attr_destroy(&mine);
+            pthread_attr_destroy(&old);
+        }
+    } attrs;
+    if (int err = pthread_attr_setstacksize(&attrs.mine, cfg.stackSize))
+        stackStatus.fail(ThreadConfigStatus::StackSize, err);
+    else if (int err2 = pthread_setattr_default_np(&attrs.mine))
+        stackStatus.fail(ThreadConfigStatus::StackSize, err2);
+    if (status) *status = stackStatus;
+    return Thread(std::move(body));
+#else
+    stackStatus.fail(ThreadConfigStatus::StackSize, 0);    // no portable hook for std::thread
+    if (status) *status = stackStatus;
+    return Thread(std::move(body));
+#endif
+}
+
+template <typename Thread = std::thread, typename F, typename... Args>
+Thread launchThread(const ThreadConfig& cfg, F&& f, Args&&... args) {
+    return launchThread<Thread>(cfg, static_cast<ThreadConfigStatus*>(nullptr), std::forward<F>(f),
+                                std::forward<Args>(args)...);
+}
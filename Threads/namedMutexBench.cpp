@@ -0,0 +1,156 @@
+// ==========================================================
+// TOPIC: Named (Cross-Process) Mutex — Kernel Object vs Shared-Memory Word
+// ==========================================================
+//
+// mutex.cpp locks a named kernel mutex:
+//
+//     hMutex = CreateMutex(NULL, FALSE, "MUTEX1");
+//     WaitForSingleObject(hMutex, INFINITE);
+//     ReleaseMutex(hMutex);
+//
+// Correct across processes, but every acquire and release is a
+// system call even when nobody else wants the lock.
+//
+// NamedMutex.h keeps the lock word in shared memory and only
+// enters the kernel when a process has to wait.
+//
+// Measured here (Linux):
+// 1. uncontended lock + unlock, ns per pair:
+//    - SysV semaphore (semop P/V): a named kernel lock, the
+//      closest Linux analogue of CreateMutex/WaitForSingleObject
+//    - pthread mutex, PROCESS_SHARED + ROBUST (glibc, reference)
+//    - NamedMutex
+// 2. two processes (fork) x 1M increments of a counter in
+//    shared memory under NamedMutex → must total exactly 2M
+// 3. owner death: a child locks and exits without unlocking;
+//    the parent's lock() returns LockStatus::OwnerDied
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread namedMutexBench.cpp -o namedmutex
+//
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <pthread.h>
+#include <sys/ipc.h>
+#include <sys/mman.h>
+#include <sys/sem.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "NamedMutex.h"
+
+using namespace std;
+using namespace std::chrono;
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = steady_clock::now();
+    f();
+    return duration<double, milli>(steady_clock::now() - t0).count();
+}
+
+int main() {
+    constexpr int kPairs = 2'000'000;
+    const string name = "oops_named_mutex_demo";
+    NamedMutex::remove(name);
+    NamedMutex m(name);
+
+    // ---- 1. Uncontended cost ----
+    int sem = semget(IPC_PRIVATE, 1, IPC_CREAT | 0600);
+    semctl(sem, 0, SETVAL, 1);
+    sembuf down{0, -1, SEM_UNDO}, up{0, +1, SEM_UNDO};
+    double semMs = timeMs([&] {
+        for (int i = 0; i < kPairs; ++i) {
+            semop(sem, &down, 1);
+            semop(sem, &up, 1);
+        }
+    });
+    semctl(sem, 0, IPC_RMID);
+
+    auto* pm = static_cast<pthread_mutex_t*>(
+        mmap(nullptr, sizeof(pthread_mutex_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(pm, &attr);
+    double pthreadMs = timeMs([&] {
+        for (int i = 0; i < kPairs; ++i) {
+            pthread_mutex_lock(pm);
+            pthread_mutex_unlock(pm);
+        }
+    });
+
+    double namedMs = timeMs([&] {
+        for (int i = 0; i < kPairs; ++i) {
+            m.lock();
+            m.unlock();
+        }
+    });
+
+    auto ns = [&](double ms) { return ms * 1e6 / kPairs; };
+    cout << fixed << setprecision(1) << "uncontended lock + unlock, " << kPairs << " pairs:" << endl;
+    cout << "  SysV semaphore (kernel each call): " << setw(7) << ns(semMs) << " ns" << endl;
+    cout << "  pthread robust, process-shared:    " << setw(7) << ns(pthreadMs) << " ns" << endl;
+    cout << "  NamedMutex:                        " << setw(7) << ns(namedMs) << " ns" << endl;
+
+    // ---- 2. Two processes, one counter ----
+    constexpr long kPerProcess = 1'000'000;
+    auto* counter = static_cast<long*>(
+        mmap(nullptr, sizeof(long), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    *counter = 0;
+    double contendedMs = timeMs([&] {
+        pid_t kids[2];
+        for (pid_t& k : kids) {
+            if ((k = fork()) == 0) {
+                NamedMutex child(name);              // opened by name, like OpenMutex
+                for (long i = 0; i < kPerProcess; ++i) {
+                    lock_guard<NamedMutex> g(child);
+                    ++*counter;
+                }
+                _exit(0);
+            }
+        }
+        for (pid_t k : kids) waitpid(k, nullptr, 0);
+    });
+    cout << "2 processes x " << kPerProcess << " locked increments: " << contendedMs << " ms, counter = "
+         << *counter << (*counter == 2 * kPerProcess ? "  ✔" : "  ✘") << endl;
+
+    // ---- 3. Owner dies holding the lock ----
+    if (pid_t k = fork(); k == 0) {
+        NamedMutex child(name);
+        child.lock();
+        _exit(0);                                  // never unlocks
+    } else {
+        waitpid(k, nullptr, 0);
+    }
+    LockStatus st;
+    double recoverMs = timeMs([&] { st = m.lock(); });
+    m.unlock();
+    cout << "owner died holding it: lock() → "
+         << (st == LockStatus::OwnerDied ? "OwnerDied" : "Acquired") << " after " << recoverMs << " ms" << endl;
+
+    NamedMutex::remove(name);
+    bool ok = *counter == 2 * kPerProcess && st == LockStatus::OwnerDied;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A named kernel mutex costs a system call per acquire and
+//    per release, contended or not.
+// 2. A lock word in SHARED MEMORY can be taken with one CAS by
+//    any process; the kernel is needed only to sleep/wake.
+// 3. futex keys on the physical page, so a non-private futex
+//    works across processes mapping the same segment.
+// 4. Cross-process locks must handle a holder that crashes:
+//    store the owner id and let waiters detect its death.
+//
+// ⭐ One-Line Interview Answer
+// “Put the lock word in shared memory, take it with a CAS and
+// only call the kernel (futex) to wait — uncontended it is as
+// cheap as an in-process lock, and the owner id lets others
+// recover when the holder dies.”
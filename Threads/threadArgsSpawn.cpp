@@ -0,0 +1,164 @@
+// ==========================================================
+// TOPIC: Passing Big Arguments to Threads — Copy, LPVOID, Move, In Place
+// ==========================================================
+//
+// passingArgument.cpp hands a heap GameObject to the thread as
+// (LPVOID)obj and never frees it; createThread.cpp passes
+// callables and arguments by value, so std::thread copies them.
+//
+// ThreadArgs.h:
+//   spawn(f, std::move(obj))    moved into std::thread's own state,
+//                               lvalues / raw T* rejected at compile time
+//   ThreadBlock<T>::start(f, …)  T constructed in caller-provided
+//                               storage, handed to f as T&&
+//
+// Measured here, per spawn + join (the payload is built in
+// every iteration, as a real producer would):
+// - GameObject: 256 KB vector + name (cheap to move)
+//     new + LPVOID-style pointer (deleted by the thread)
+//     std::thread(f, obj)         lvalue → deep copy
+//     spawn(f, std::move(obj))
+// - Frame: 256 KB std::array inside (trivially copyable: a
+//   "move" is a 256 KB memcpy plus a 256 KB heap block)
+//     spawn(f, std::move(frame))
+//     ThreadBlock<Frame>           built in place, no copy
+// Each row also counts operator new calls per spawn.
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread threadArgsSpawn.cpp -o threadargs
+//
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ThreadArgs.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ---- Count every operator new in the program ----
+static atomic<long long> g_allocations{0};
+void* operator new(size_t n) {
+    g_allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+constexpr size_t kFloats = 64 * 1024;           // 256 KB
+
+class GameObject {
+public:
+    explicit GameObject(int id) : name("object-" + to_string(id) + "-with-a-long-name"), positions(kFloats) {
+        for (size_t i = 0; i < positions.size(); i += 1024) positions[i] = static_cast<float>(id + i);
+    }
+    string name;
+    vector<float> positions;
+};
+
+struct Frame {
+    Frame(int id) : id(id) {
+        for (size_t i = 0; i < pixels.size(); i += 4096) pixels[i] = static_cast<char>(id + i);
+    }
+    int id;
+    array<char, kFloats * 4> pixels;
+};
+
+atomic<long long> g_checksum{0};
+
+void run(GameObject&& obj) {                    // BasicThread, typed
+    long long s = 0;
+    for (size_t i = 0; i < obj.positions.size(); i += 1024) s += static_cast<long long>(obj.positions[i]);
+    g_checksum.fetch_add(s + static_cast<long long>(obj.name.size()), memory_order_relaxed);
+}
+
+void process(Frame&& f) {
+    long long s = f.id;
+    for (size_t i = 0; i < f.pixels.size(); i += 4096) s += f.pixels[i];
+    g_checksum.fetch_add(s, memory_order_relaxed);
+}
+
+// BasicThread(LPVOID param) as in passingArgument.cpp, plus the missing delete
+void basicThread(void* param) {
+    GameObject* obj = static_cast<GameObject*>(param);
+    run(std::move(*obj));
+    delete obj;
+}
+
+template <typename Body>
+void row(const char* name, int spawns, Body body) {
+    g_checksum = 0;
+    long long a0 = g_allocations.load();
+    auto t0 = steady_clock::now();
+    for (int i = 0; i < spawns; ++i) body(i);
+    double us = duration<double, micro>(steady_clock::now() - t0).count() / spawns;
+    double allocs = double(g_allocations.load() - a0) / spawns;
+    cout << "  " << setw(30) << left << name << right << fixed << setprecision(1) << setw(8) << us << " µs"
+         << setw(8) << allocs << " new/spawn   (checksum " << g_checksum.load() << ")" << endl;
+}
+
+int main() {
+    constexpr int kSpawns = 2000;
+
+    // Compile-time ownership rules (uncomment to see the errors):
+    //   GameObject g(1);  spawn(run, g);                // lvalue: would copy
+    //   spawn(basicThread, new GameObject(1));          // raw T*: no owner
+    auto owned = spawn([](unique_ptr<GameObject> p) { run(std::move(*p)); }, make_unique<GameObject>(7));
+    owned.join();
+
+    cout << "spawn + join, " << kSpawns << " times:" << endl;
+    row("empty std::thread", kSpawns, [](int) { thread([] {}).join(); });
+
+    cout << "GameObject (256 KB vector):" << endl;
+    row("new + void* (LPVOID style)", kSpawns, [](int i) {
+        GameObject* obj = new GameObject(i);
+        thread(basicThread, static_cast<void*>(obj)).join();
+    });
+    row("std::thread(f, lvalue) copy", kSpawns, [](int i) {
+        GameObject obj(i);
+        thread([](GameObject o) { run(std::move(o)); }, obj).join();
+    });
+    row("spawn(f, std::move(obj))", kSpawns, [](int i) {
+        GameObject obj(i);
+        spawn(run, std::move(obj)).join();
+    });
+
+    cout << "Frame (256 KB std::array):" << endl;
+    row("spawn(f, std::move(frame))", kSpawns, [](int i) {
+        auto frame = make_unique<Frame>(i);          // too big for comfort on the stack
+        spawn(process, std::move(*frame)).join();
+    });
+    static ThreadBlock<Frame> block;                  // preallocated once
+    row("ThreadBlock<Frame> in place", kSpawns, [](int i) {
+        block.start(process, i);
+        block.join();
+    });
+    return 0;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. std::thread DECAY-COPIES its arguments into its own state:
+//    an lvalue argument is a full copy.
+// 2. Passing void* (LPVOID) loses the type and the ownership:
+//    nobody knows who must delete the object.
+// 3. Move in what the thread should own (std::move, unique_ptr)
+//    and borrow explicitly with std::ref — and enforce it with
+//    static_assert so a copy can't slip in.
+// 4. For large trivially-copyable payloads a move IS a copy;
+//    construct them in place in storage the thread consumes.
+//
+// ⭐ One-Line Interview Answer
+// “Give a thread its arguments by move (or in place), never by
+// lvalue or void*: the type system then states who owns the
+// data and no byte is copied on the way.”
@@ -0,0 +1,234 @@
+// ======================================================
+// InstanceRegistry.h — per-class instance counts without a shared counter
+// ======================================================
+//
+// static2.cpp / staticFunc.cpp:
+//
+//     class Player {
+//         static int instances;
+//         Player() { instances++; }        // ⚠ data race across threads
+//     };
+//
+// std::atomic<int> fixes the race but every constructor on
+// every core then writes the SAME cache line.
+//
+// InstanceCounted<T> (CRTP base) instead gives each thread its
+// own SHARD (a cache-line-aligned block with its own counters):
+//   - constructor → ++created in the CURRENT thread's shard
+//   - destructor  → ++destroyed in the CURRENT thread's shard
+//   - each counter has a single writer: a plain load + store,
+//     no locked instruction, no shared line
+//   - T::instanceStats() sums all shards on read (nobody is
+//     stopped; the result is a consistent-enough snapshot
+//     while threads run, exact once they are joined)
+//
+// InstanceCounted<T, true> additionally links every live object
+// into its creating shard's intrusive list (three pointers per
+// object, an almost always uncontended per-shard lock). forEachLive(f) visits
+// them shard by shard, holding one shard lock at a time.
+// The base links an object in BEFORE T's constructor runs and
+// unlinks it AFTER T's destructor, so a walk that overlaps
+// construction or destruction of a T can reach one that is half
+// built or already gone: call forEachLive only while no T is
+// being created or destroyed (threads joined, or the caller's own
+// lock held around both). The lists themselves stay consistent
+// either way.
+//
+// Shards of exited threads are handed to the next new thread,
+// so memory stays bounded by the peak number of threads.
+//
+// Usage:
+//     class Player : public InstanceCounted<Player> { ... };
+//     Player::instanceStats().live
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+struct InstanceStats {
+    std::uint64_t created = 0;
+    std::uint64_t destroyed = 0;
+    std::int64_t live = 0;
+};
+
+namespace instance_detail {
+
+struct LiveHook {
+    LiveHook* prev = nullptr;
+    LiveHook* next = nullptr;
+    struct Shard* shard = nullptr;
+};
+
+struct EmptyHook {};
+
+// Guards a shard's live list. Almost always taken by the owning
+// thread only, so a test-and-set lock (one xchg) beats a mutex.
+class ShardLock {
+public:
+    void lock() noexcept {
+        while (flag_.exchange(true, std::memory_order_acquire)) {
+            while (flag_.load(std::memory_order_relaxed)) std::this_thread::yield();
+        }
+    }
+    void unlock() noexcept { flag_.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<bool> flag_{false};
+};
+
+struct alignas(64) Shard {
+    std::atomic<std::uint64_t> created{0};
+    std::atomic<std::uint64_t> destroyed{0};
+    std::atomic<bool> inUse{false};
+    ShardLock liveLock;
+    LiveHook* liveHead = nullptr;
+    Shard* next = nullptr;                 // registry list, set once before publishing
+};
+
+// Single-writer increment: no lock prefix needed
+// (the shared exit-time shard has many writers → real RMW)
+inline void bump(std::atomic<std::uint64_t>& c, bool shared) {
+    if (shared) [[unlikely]] c.fetch_add(1, std::memory_order_relaxed);
+    else c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+template <typename T>
+class Registry {
+public:
+    // Never destroyed: objects with static storage may still be
+    // created/destroyed during program exit
+    static Registry& get() {
+        static Registry* r = new Registry;
+        return *r;
+    }
+
+    // This thread's shard (acquired on first use, released at thread
+    // exit). During thread exit, after the release, the shared
+    // `late` shard is used with atomic increments instead.
+    Shard& local(bool& shared) {
+        thread_local bool exited = false;
+        shared = exited;
+        if (exited) [[unlikely]] return late_;
+        thread_local Holder h(*this, exited);
+        return *h.shard;
+    }
+
+    template <typename F>
+    void forEachShard(F&& f) {
+        for (Shard* s = head_.load(std::memory_order_acquire); s; s = s->next) f(*s);
+    }
+
+private:
+    struct Holder {
+        Shard* shard;
+        bool& exited;
+        Holder(Registry& r, bool& e) : shard(r.acquire()), exited(e) {}
+        ~Holder() {
+            exited = true;
+            shard->inUse.store(false, std::memory_order_release);
+        }
+    };
+
+    Registry() {
+        late_.inUse.store(true, std::memory_order_relaxed);   // never handed to a thread
+        head_.store(&late_, std::memory_order_relaxed);
+    }
+
+    Shard* acquire() {
+        for (Shard* s = head_.load(std::memory_order_acquire); s; s = s->next) {
+            bool expected = false;
+            if (!s->inUse.load(std::memory_order_relaxed) &&
+                s->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                return s;                       // reuse a shard of an exited thread
+        }
+        Shard* s = new Shard;
+        s->inUse.store(true, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> g(addLock_);
+        s->next = head_.load(std::memory_order_relaxed);
+        head_.store(s, std::memory_order_release);
+        return s;
+    }
+
+    std::mutex addLock_;
+    std::atomic<Shard*> head_{nullptr};
+    Shard late_;
+};
+
+}  // namespace instance_detail
+
+template <typename T, bool TrackLive = false>
+class InstanceCounted {
+    using Registry = instance_detail::Registry<T>;
+    using Hook = std::conditional_t<TrackLive, instance_detail::LiveHook, instance_detail::EmptyHook>;
+
+public:
+    // PrintStaticValues() equivalent: sums every shard, stops nobody
+    static InstanceStats instanceStats() {
+        InstanceStats st;
+        Registry::get().forEachShard([&](instance_detail::Shard& s) {
+            st.created += s.created.load(std::memory_order_relaxed);
+            st.destroyed += s.destroyed.load(std::memory_order_relaxed);
+        });
+        st.live = static_cast<std::int64_t>(st.created - st.destroyed);
+        return st;
+    }
+
+    // f(const T&) for every live object; one shard locked at a time.
+    // Not while other threads create or destroy T (see above)
+    template <typename F>
+    static void forEachLive(F&& f)
+        requires TrackLive
+    {
+        Registry::get().forEachShard([&](instance_detail::Shard& s) {
+            std::lock_guard<instance_detail::ShardLock> g(s.liveLock);
+            for (instance_detail::LiveHook* h = s.liveHead; h; h = h->next)
+                f(static_cast<const T&>(*static_cast<const InstanceCounted*>(fromHook(h))));
+        });
+    }
+
+protected:
+    InstanceCounted() { onCreate(); }
+    InstanceCounted(const InstanceCounted&) { onCreate(); }   // a copy is a new instance
+    InstanceCounted& operator=(const InstanceCounted&) { return *this; }
+    ~InstanceCounted() { onDestroy(); }
+
+private:
+    void onCreate() {
+        bool shared;
+        instance_detail::Shard& s = Registry::get().local(shared);
+        instance_detail::bump(s.created, shared);
+        if constexpr (TrackLive) {
+            hook_.shard = &s;
+            std::lock_guard<instance_detail::ShardLock> g(s.liveLock);
+            hook_.next = s.liveHead;
+            if (s.liveHead) s.liveHead->prev = &hook_;
+            s.liveHead = &hook_;
+        }
+    }
+
+    void onDestroy() {
+        if constexpr (TrackLive) {
+            instance_detail::Shard& owner = *hook_.shard;  // may belong to another thread
+            std::lock_guard<instance_detail::ShardLock> g(owner.liveLock);
+            if (hook_.prev) hook_.prev->next = hook_.next;
+            else owner.liveHead = hook_.next;
+            if (hook_.next) hook_.next->prev = hook_.prev;
+        }
+        bool shared;
+        instance_detail::Shard& s = Registry::get().local(shared);
+        instance_detail::bump(s.destroyed, shared);
+    }
+
+    static const InstanceCounted* fromHook(const instance_detail::LiveHook* h) {
+        return reinterpret_cast<const InstanceCounted*>(reinterpret_cast<const char*>(h) -
+                                                        offsetof(InstanceCounted, hook_));
+    }
+
+    [[no_unique_address]] Hook hook_;
+};
@@ -0,0 +1,173 @@
+// ==========================================================
+// TOPIC: Counting Instances Across Threads (static members)
+// ==========================================================
+//
+// static2.cpp / staticFunc.cpp:
+//
+//     class Player {
+//         static int instances;
+//         Player() { instances++; }
+//         static void PrintStaticValues();
+//     };
+//
+// With several threads creating Players:
+// - static int      → data race, lost increments
+// - std::atomic<int> → correct, but every core fights for
+//                      the one cache line
+//
+// InstanceRegistry.h: per-thread shards, summed on read.
+//
+// Measured here: 32 threads, each creating and destroying
+// Players in a loop, while a reporter thread keeps reading
+// the count (what PrintStaticValues() does):
+// - racy counter (lost updates shown, no UB: relaxed atomic
+//   load + store, the same code a plain ++ compiles to)
+// - std::atomic fetch_add
+// - InstanceCounted<Player>
+// - InstanceCounted<Player, true> (live-object lists)
+//
+// Build:
+//   g++ -std=c++20 -O2 -pthread instanceRegistry.cpp -o instances
+//
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "InstanceRegistry.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// ---- Old: one shared counter ----
+class RacyPlayer {
+public:
+    static atomic<long long> instances;
+    RacyPlayer() { instances.store(instances.load(memory_order_relaxed) + 1, memory_order_relaxed); }
+};
+atomic<long long> RacyPlayer::instances{0};
+
+class AtomicPlayer {
+public:
+    static atomic<long long> instances;
+    AtomicPlayer() { instances.fetch_add(1, memory_order_relaxed); }
+};
+atomic<long long> AtomicPlayer::instances{0};
+
+// ---- New: sharded ----
+class Player : public InstanceCounted<Player> {
+public:
+    static void PrintStaticValues() {
+        InstanceStats s = instanceStats();
+        cout << "Instances = " << s.live << " live (" << s.created << " created)" << endl;
+    }
+};
+
+class TrackedPlayer : public InstanceCounted<TrackedPlayer, true> {
+public:
+    explicit TrackedPlayer(int id) : id(id) {}
+    int id;
+};
+
+struct BurstResult {
+    double ms;
+    int reports;
+};
+
+// `perThread` make(i) calls on each of `threads` threads, while a
+// reporter thread keeps calling report() until they finish
+template <typename Make, typename Report>
+BurstResult createBurst(int threads, long long perThread, Make make, Report report) {
+    atomic<int> ready{0};
+    atomic<bool> go{false}, done{false};
+    vector<thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&] {
+            ready.fetch_add(1);
+            while (!go.load()) this_thread::yield();
+            for (long long i = 0; i < perThread; ++i) make(i);
+        });
+    }
+    int reports = 0;
+    thread reporter([&] {
+        while (!go.load()) this_thread::yield();
+        while (!done.load()) {
+            report();
+            ++reports;
+            this_thread::sleep_for(milliseconds(20));
+        }
+    });
+    while (ready.load() < threads) this_thread::yield();
+    auto t0 = steady_clock::now();
+    go = true;
+    for (auto& th : pool) th.join();
+    double ms = duration<double, milli>(steady_clock::now() - t0).count();
+    done = true;
+    reporter.join();
+    return {ms, reports};
+}
+
+int main() {
+    // ---- Same use as staticFunc.cpp ----
+    Player* player1 = new Player();
+    player1->PrintStaticValues();
+    Player::PrintStaticValues();
+    delete player1;
+
+    constexpr int kThreads = 32;
+    constexpr long long kPerThread = 1'000'000;
+    const long long expected = kThreads * kPerThread;
+
+    volatile long long seen = 0;                 // what the reporter read
+    auto racy = createBurst(kThreads, kPerThread, [](long long) { RacyPlayer p; (void)p; },
+                            [&] { seen = RacyPlayer::instances.load(memory_order_relaxed); });
+    auto atomicRun = createBurst(kThreads, kPerThread, [](long long) { AtomicPlayer p; (void)p; },
+                                 [&] { seen = AtomicPlayer::instances.load(memory_order_relaxed); });
+    auto shard = createBurst(kThreads, kPerThread, [](long long) { Player p; (void)p; },
+                             [&] { seen = Player::instanceStats().live; });
+    auto tracked = createBurst(
+        kThreads, kPerThread, [](long long i) { TrackedPlayer p(static_cast<int>(i)); (void)p; },
+        [&] { seen = TrackedPlayer::instanceStats().live; });
+
+    // Live lists: keep a few objects alive, then walk them
+    vector<TrackedPlayer> kept;
+    kept.reserve(5);
+    for (int i = 0; i < 5; ++i) kept.emplace_back(100 + i);
+    long long liveIds = 0;
+    TrackedPlayer::forEachLive([&](const TrackedPlayer& tp) { liveIds += tp.id; });
+
+    InstanceStats ps = Player::instanceStats();
+    InstanceStats ts = TrackedPlayer::instanceStats();
+    cout << "\n" << kThreads << " threads x " << kPerThread << " creations (" << thread::hardware_concurrency()
+         << " hardware threads):" << endl;
+    cout << "racy static counter:   " << racy.ms << " ms, counted " << RacyPlayer::instances.load() << " / "
+         << expected << endl;
+    cout << "atomic fetch_add:      " << atomicRun.ms << " ms, counted " << AtomicPlayer::instances.load()
+         << " / " << expected << endl;
+    cout << "InstanceCounted:       " << shard.ms << " ms, counted " << ps.created - 1 << " / " << expected
+         << " (" << shard.reports << " reports during the run)" << endl;
+    cout << "InstanceCounted+lists: " << tracked.ms << " ms, counted " << ts.created - 5 << " / " << expected
+         << ", live now " << ts.live << " (ids sum " << liveIds << ")" << endl;
+    Player::PrintStaticValues();
+    bool ok = ps.created - 1 == static_cast<uint64_t>(expected) && ps.live == 0 && ts.live == 5 &&
+              liveIds == 510;
+    return ok ? 0 : 1;
+}
+
+// ----------------------------------------------------------
+// IMPORTANT INTERVIEW POINTS
+// ----------------------------------------------------------
+//
+// 1. A static data member is ONE variable shared by all
+//    threads: `instances++` from several threads is a race.
+// 2. std::atomic makes it correct but serialises every core
+//    on one cache line.
+// 3. Shard the counter per thread (single writer, no locked
+//    instruction) and sum the shards when someone reads.
+// 4. Readers never stop writers; totals are exact once the
+//    writers have been joined.
+//
+// ⭐ One-Line Interview Answer
+// “Replace a shared static counter with per-thread shards that
+// each thread bumps without atomics RMW, and aggregate them on
+// read — correct like an atomic, but with no shared cache line.”